@@ -16,12 +16,16 @@
 NAMESPACE_BEGIN(CryptoPP)
 
 Fortuna_Base::Fortuna_Base() :
+m_PoolIndex(0),
+m_LastReseed(0),
 m_Key(0),
 m_Counter(0),
 m_ReseedCounter(0),
-m_PoolIndex(0),
-m_ReseedTimer(TimerBase::MILLISECONDS)
+m_Generation(0)
 {
+	m_ReseedInterval=m_ReseedTimer.TicksPerSecond()*NUMBER_MILLISECONDS_BETWEEN_RESEEDS/1000;
+	for(byte i=0;i<NUM_POOLS;++i)
+		m_PoolProcessedData[i]=0;
 }
 
 void Fortuna_Base::Initialize()
@@ -30,7 +34,6 @@ void Fortuna_Base::Initialize()
 	m_Counter.resize(GetCipher()->BlockSize()),
 	memset(m_Key,0,m_Key.SizeInBytes());
 	memset(m_Counter,0,m_Counter.SizeInBytes());
-	m_ReseedTimer.StartTimer();
 	for(byte i=0;i<NUM_POOLS;++i)
 		GetPoolHash(i)->Restart();
 
@@ -58,24 +61,75 @@ void Fortuna_Base::IncorporateEntropySmall(const byte* Input,byte length,byte So
 	if(!length || length>MAX_EVENT_SIZE)
 		throw(InvalidArgument("Event length was invalid"));
 
+	const byte Pool=NextPool(Input,length);
+	if(!EnqueueEvent(Pool,Input,length,SourceNumber))
+	{
+		// the queue is full, hash everything that waits and the new event right away
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::lock_guard<std::recursive_mutex> Guard(m_PoolMutex[m_PoolIndex]);
+		std::lock_guard<std::mutex> Guard(m_PoolMutex[Pool]);
 #endif
+		DrainPool(Pool);
+		HashEvent(Pool,Input,length,SourceNumber);
+	}
+	// counted only after the event can be harvested
+	m_PoolProcessedData[Pool]+=length+sizeof(length)+sizeof(SourceNumber);
+}
 
-	GetPoolHash(m_PoolIndex)->Update(&SourceNumber,sizeof(SourceNumber));
-	GetPoolHash(m_PoolIndex)->Update(&length,sizeof(length));
-	GetPoolHash(m_PoolIndex)->Update(Input,length);
-	m_PoolProcessedData[m_PoolIndex]+=length+sizeof(length)+sizeof(SourceNumber);
-
+byte Fortuna_Base::NextPool(const byte* Input,byte length)
+{
 #if defined(USE_RANDOMIZED_POOLING)
-	RANDOM_POOLING_HASH().CalculateTruncatedDigest(&m_PoolIndex,sizeof(m_PoolIndex),Input,length);
-	m_PoolIndex%=NUM_POOLS;
+	byte Pool;
+	RANDOM_POOLING_HASH().CalculateTruncatedDigest(&Pool,sizeof(Pool),Input,length);
+	return Pool%NUM_POOLS;
 #else
-	m_PoolIndex++;
-	m_PoolIndex%=NUM_POOLS;
+	return static_cast<byte>(m_PoolIndex++%NUM_POOLS);
 #endif
 }
 
+bool Fortuna_Base::EnqueueEvent(byte Pool,const byte* Input,byte length,byte SourceNumber)
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	for(unsigned int i=0;i<EVENTS_PER_POOL_QUEUE;++i)
+	{
+		PendingEvent& Event=m_PendingEvents[Pool][i];
+		byte Expected=EVENT_FREE;
+		if(Event.State.load(std::memory_order_relaxed)==EVENT_FREE
+			&& Event.State.compare_exchange_strong(Expected,EVENT_WRITING,std::memory_order_acquire))
+		{
+			Event.SourceNumber=SourceNumber;
+			Event.Length=length;
+			memcpy(Event.Data,Input,length);
+			Event.State.store(EVENT_READY,std::memory_order_release);
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+void Fortuna_Base::DrainPool(byte Pool)
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	for(unsigned int i=0;i<EVENTS_PER_POOL_QUEUE;++i)
+	{
+		PendingEvent& Event=m_PendingEvents[Pool][i];
+		if(Event.State.load(std::memory_order_acquire)==EVENT_READY)
+		{
+			HashEvent(Pool,Event.Data,Event.Length,Event.SourceNumber);
+			memset_z(Event.Data,0,sizeof(Event.Data));
+			Event.State.store(EVENT_FREE,std::memory_order_release);
+		}
+	}
+#endif
+}
+
+void Fortuna_Base::HashEvent(byte Pool,const byte* Input,byte length,byte SourceNumber)
+{
+	GetPoolHash(Pool)->Update(&SourceNumber,sizeof(SourceNumber));
+	GetPoolHash(Pool)->Update(&length,sizeof(length));
+	GetPoolHash(Pool)->Update(Input,length);
+}
+
 size_t Fortuna_Base::MaxGenerateSize() const
 {
 	if(GetCipher()->BlockSize()>=sizeof(size_t)) // triggers for BLOCKSIZE >= 64 (x64)
@@ -112,51 +166,114 @@ void Fortuna_Base::GenerateSmallBlock(byte* output,size_t size)
 {
 	if(size > MaxGenerateSize())
 		throw(InvalidArgument("requested too much random data at once!"));
-	// reseed if neccessary
+
+	if(m_ReseedCounter==0 || ReseedIsDue())
+		ReseedFromPools();
+
+	Generator& Gen=LockGenerator();
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	{
-	std::lock_guard<std::recursive_mutex> GuardReseed(m_ReseedCounterMutex);
+	std::lock_guard<std::mutex> Guard(Gen.Mutex,std::adopt_lock);
+#endif
+	if(Gen.Generation!=m_Generation || !Gen.Cipher.get())
+		RekeyGenerator(Gen);
+
+	// output data here, then rekey so the output can't be recomputed from the generator state
+	GenerateBlocks(*Gen.Cipher,Gen.Counter,output,size);
+	SecByteBlock NewKey(GetCipher()->MaxKeyLength());
+	GenerateBlocks(*Gen.Cipher,Gen.Counter,NewKey,NewKey.size());
+	Gen.Cipher->SetKey(NewKey,NewKey.size());
+}
+
+bool Fortuna_Base::ReseedIsDue()
+{
+	return m_PoolProcessedData[0]>=MIN_POOL_SIZE
+		&& (m_ReseedCounter==0 || m_ReseedTimer.GetCurrentTimerValue()-m_LastReseed>=m_ReseedInterval);
+}
+
+void Fortuna_Base::ReseedFromPools()
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	std::lock_guard<std::mutex> GuardReseed(m_ReseedCounterMutex);
 #endif
-	if(m_PoolProcessedData[0]>=MIN_POOL_SIZE
-		&& (m_ReseedCounter==0 || m_ReseedTimer.ElapsedTime()>=NUMBER_MILLISECONDS_BETWEEN_RESEEDS)) // check timing
+	// another thread may have reseeded while this one waited for the lock
+	if(!ReseedIsDue())
 	{
-		m_ReseedCounter++;
+		if(m_ReseedCounter==0)
+			throw(InvalidState(AlgorithmName())); // some entropy need to be available
+		return;
+	}
+
+	const word64 ReseedCounter=m_ReseedCounter+1;
 
-		// harvest some hashes...
-		SecByteBlock HarvestedData;
+	// harvest some hashes...
+	SecByteBlock HarvestedData;
 
-		for(byte i=0;i<NUM_POOLS;++i)
+	for(byte i=0;i<NUM_POOLS;++i)
+	{
+		if(ReseedCounter%(1ull<<i)==0)
 		{
-			if(m_ReseedCounter%(1ull<<i)==0)
-			{
-				HarvestedData.Grow(HarvestedData.size()+GetPoolHash(i)->DigestSize());
+			HarvestedData.Grow(HarvestedData.size()+GetPoolHash(i)->DigestSize());
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-				std::lock_guard<std::recursive_mutex> Guard(m_PoolMutex[i]);
+			std::lock_guard<std::mutex> Guard(m_PoolMutex[i]);
 #endif
-				GetPoolHash(i)->Final(&HarvestedData[HarvestedData.size()-GetPoolHash(i)->DigestSize()]);
-				GetPoolHash(i)->Restart();
-			}
-			else
-			{
-				// if m_ReseedCounter%(1ull<i)!=0 then m_ReseedCounter%(1ull<j)!=0 for any j: j>i
-				break;
-			}
+			const word64 Harvested=m_PoolProcessedData[i];
+			DrainPool(i);
+			GetPoolHash(i)->Final(&HarvestedData[HarvestedData.size()-GetPoolHash(i)->DigestSize()]);
+			GetPoolHash(i)->Restart();
+			m_PoolProcessedData[i]-=Harvested;
+		}
+		else
+		{
+			// if m_ReseedCounter%(1ull<i)!=0 then m_ReseedCounter%(1ull<j)!=0 for any j: j>i
+			break;
 		}
-
-		Reseed(HarvestedData,HarvestedData.size());
 	}
-	else
-		if(m_ReseedCounter==0)
-			throw(InvalidState(AlgorithmName()));
-	// some entropy need to be available
+
+	Reseed(HarvestedData,HarvestedData.size());
+	m_ReseedCounter=ReseedCounter;
+}
+
+Fortuna_Base::Generator& Fortuna_Base::LockGenerator()
+{
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	} // reseed mtx
+	// every thread starts looking at its own generator and takes the first free one
+	const word64 ThreadHash=word64(std::hash<std::thread::id>()(std::this_thread::get_id()))*W64LIT(0x9E3779B97F4A7C15);
+	const unsigned int Home=static_cast<unsigned int>(ThreadHash>>32)%NUM_GENERATORS;
+	for(unsigned int i=0;i<NUM_GENERATORS;++i)
+	{
+		Generator& Gen=m_Generators[(Home+i)%NUM_GENERATORS];
+		if(Gen.Mutex.try_lock())
+			return Gen;
+	}
+	m_Generators[Home].Mutex.lock();
+	return m_Generators[Home];
+#else
+	return m_Generators[0];
 #endif
+}
+
+void Fortuna_Base::RekeyGenerator(Generator& Gen)
+{
+	SecByteBlock NewKey(GetCipher()->MaxKeyLength());
+	{
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::lock_guard<std::recursive_mutex> Guard(m_GeneratorMutex);
+		std::lock_guard<std::mutex> Guard(m_GeneratorMutex);
 #endif
+		GenerateCentral(NewKey,NewKey.size());
+		Gen.Generation=m_Generation;
+	}
+
+	if(!Gen.Cipher.get())
+		Gen.Cipher.reset(GetNewCipher());
+	Gen.Cipher->SetKey(NewKey,NewKey.size());
+	// every key is new, so the counter can start over
+	Gen.Counter.New(GetCipher()->BlockSize());
+	memset(Gen.Counter,0,Gen.Counter.size());
+	IncrementCounterByOneLE(Gen.Counter,static_cast<unsigned int>(Gen.Counter.size()));
+}
 
-	// output data here
+void Fortuna_Base::GenerateCentral(byte* output,size_t size)
+{
 	bool CounterIsAllZero=true;
 	for(size_t i=0;i<m_Counter.size();++i)
 	{
@@ -172,43 +289,33 @@ void Fortuna_Base::GenerateSmallBlock(byte* output,size_t size)
 	simple_ptr<BlockCipher> CipherInstance(GetNewCipher());
 	CipherInstance.m_p->SetKey(m_Key,m_Key.SizeInBytes());
 
+	GenerateBlocks(*CipherInstance.m_p,m_Counter,output,size);
+
+	//rekey
+	GenerateBlocks(*CipherInstance.m_p,m_Counter,m_Key,m_Key.size());
+}
+
+void Fortuna_Base::GenerateBlocks(BlockCipher& Cipher,byte* Counter,byte* output,size_t size) const
+{
+	const unsigned int BlockSize=Cipher.BlockSize();
 	while(size>0)
 	{
-		if(size>=GetCipher()->BlockSize())
+		if(size>=BlockSize)
 		{
-			CipherInstance.m_p->ProcessBlock(m_Counter,output);
-			IncrementCounterByOneLE(m_Counter,static_cast<unsigned int>(m_Counter.size()));
-			output+=GetCipher()->BlockSize();
-			size-=GetCipher()->BlockSize();
+			Cipher.ProcessBlock(Counter,output);
+			IncrementCounterByOneLE(Counter,BlockSize);
+			output+=BlockSize;
+			size-=BlockSize;
 		}
 		else // size < BLOCKSIZE
 		{
-			SecByteBlock Buffer(GetCipher()->BlockSize());
-			CipherInstance.m_p->ProcessBlock(m_Counter,Buffer);
+			SecByteBlock Buffer(BlockSize);
+			Cipher.ProcessBlock(Counter,Buffer);
 			memcpy(output,Buffer,size);
-			IncrementCounterByOneLE(m_Counter,static_cast<unsigned int>(m_Counter.size()));
+			IncrementCounterByOneLE(Counter,BlockSize);
 			size=0;
 		}
 	}
-
-	//rekey
-	SecByteBlock NewKey(GetCipher()->MaxKeyLength());
-	for(size_t i=0;i<NewKey.size();i+=GetCipher()->BlockSize())
-	{
-		if((NewKey.size()-i)>=GetCipher()->BlockSize())
-		{
-			CipherInstance.m_p->ProcessBlock(m_Counter,NewKey+i);
-			IncrementCounterByOneLE(m_Counter,static_cast<unsigned int>(m_Counter.size()));
-		}
-		else
-		{
-			SecByteBlock Buffer(GetCipher()->BlockSize());
-			CipherInstance.m_p->ProcessBlock(m_Counter,Buffer);
-			memcpy(NewKey+i,Buffer,NewKey.size()-i);
-			IncrementCounterByOneLE(m_Counter,static_cast<unsigned int>(m_Counter.size()));
-		}
-	}
-	memcpy(m_Key,NewKey,m_Key.SizeInBytes());
 }
 
 void Fortuna_Base::Reseed(const byte* NewSeed,size_t seedlen)
@@ -219,7 +326,7 @@ void Fortuna_Base::Reseed(const byte* NewSeed,size_t seedlen)
 	simple_ptr<HashTransformation> Reseeder(GetNewReseedHash());
 
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::lock_guard<std::recursive_mutex> Guard(m_GeneratorMutex);
+	std::lock_guard<std::mutex> Guard(m_GeneratorMutex);
 #endif
 
 	Reseeder.m_p->Restart();
@@ -228,7 +335,8 @@ void Fortuna_Base::Reseed(const byte* NewSeed,size_t seedlen)
 	Reseeder.m_p->TruncatedFinal(m_Key,m_Key.size());
 	IncrementCounterByOneLE(m_Counter,static_cast<unsigned int>(m_Counter.size()));
 
-	m_ReseedTimer.StartTimer();
+	m_LastReseed=m_ReseedTimer.GetCurrentTimerValue();
+	m_Generation++;
 }
 
 AutoSeededFortuna_Base::AutoSeededFortuna_Base(bool AllowSlowPoll,bool AllowMultithreading) :
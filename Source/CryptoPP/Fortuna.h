@@ -11,6 +11,7 @@
 #include "dhash.h"
 #include "hrtimer.h"
 #include "misc.h"
+#include "smartptr.h"
 #include "config.h"
 
 #ifdef CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
@@ -26,6 +27,12 @@
 
 NAMESPACE_BEGIN(CryptoPP)
 
+//! Fortuna with a central generator and several generators that serve the requests
+/*! Every request runs on one of NUM_GENERATORS generators with their own lock, key and counter.
+	A generator takes its key from the central generator and fetches a new one after every reseed,
+	so many threads can draw random data without queueing on a single lock.
+	Entropy events are put into a small queue of their pool without taking a lock and get hashed
+	into the pool when it is harvested or the queue is full. */
 class CRYPTOPP_NO_VTABLE Fortuna_Base : public RandomNumberGenerator, public NotCopyable
 {
 public:
@@ -33,6 +40,12 @@ public:
 	CRYPTOPP_CONSTANT(MAX_EVENT_SIZE = 32) // should be a power of 2
 	CRYPTOPP_CONSTANT(NUM_POOLS = 32)
 	CRYPTOPP_CONSTANT(NUMBER_MILLISECONDS_BETWEEN_RESEEDS = 100)
+	CRYPTOPP_CONSTANT(EVENTS_PER_POOL_QUEUE = 8)
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	CRYPTOPP_CONSTANT(NUM_GENERATORS = 16)
+#else
+	CRYPTOPP_CONSTANT(NUM_GENERATORS = 1)
+#endif
 public:
 	Fortuna_Base();
 
@@ -48,6 +61,9 @@ public:
 	// calls GenerateSmallBlock() multiple times to gather the data
 	void GenerateBlock(byte* output,size_t size);
 
+	// number of times the pools were harvested so far
+	word64 GetReseedCount() const {return m_ReseedCounter;}
+
 	virtual void GenerateSeedFile(byte* output,size_t length) {GenerateBlock(output,length);}
 	// create a new seed file after you've used the old one
 	virtual void ReadSeedFile(const byte* input,size_t length) {Reseed(input,length);}
@@ -64,17 +80,69 @@ protected:
 	// can't modify state here
 	virtual const BlockCipher* GetCipher() const =0;
 private:
+	//! one of the generators requests are spread over
+	struct Generator
+	{
+		Generator() : Generation(0) {}
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+		std::mutex Mutex;
+#endif
+		member_ptr<BlockCipher> Cipher;
+		SecByteBlock Counter;
+		// value of m_Generation the key was taken at, 0 if there is no key yet
+		word64 Generation;
+	};
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	enum {EVENT_FREE, EVENT_WRITING, EVENT_READY};
+	//! an entropy event that waits to be hashed into its pool
+	struct PendingEvent
+	{
+		PendingEvent() : State(EVENT_FREE) {}
+		std::atomic<byte> State;
+		byte SourceNumber;
+		byte Length;
+		byte Data[MAX_EVENT_SIZE];
+	};
+	typedef std::atomic<word64> SharedCounter;
+#else
+	typedef word64 SharedCounter;
+#endif
+
+	byte NextPool(const byte* Input,byte length);
+	// returns false if the queue of the pool is full
+	bool EnqueueEvent(byte Pool,const byte* Input,byte length,byte SourceNumber);
+	// caller has to hold the lock of the pool
+	void DrainPool(byte Pool);
+	void HashEvent(byte Pool,const byte* Input,byte length,byte SourceNumber);
+	bool ReseedIsDue();
+	void ReseedFromPools();
+	// returns a generator with its lock held
+	Generator& LockGenerator();
+	void RekeyGenerator(Generator& Gen);
+	// the original Fortuna generator, caller has to hold m_GeneratorMutex
+	void GenerateCentral(byte* output,size_t size);
+	void GenerateBlocks(BlockCipher& Cipher,byte* Counter,byte* output,size_t size) const;
+
 #if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::recursive_mutex m_PoolMutex[NUM_POOLS];
-	std::recursive_mutex m_GeneratorMutex;
-	std::recursive_mutex m_ReseedCounterMutex;
+	std::mutex m_PoolMutex[NUM_POOLS];
+	std::mutex m_GeneratorMutex;
+	std::mutex m_ReseedCounterMutex;
+	PendingEvent m_PendingEvents[NUM_POOLS][EVENTS_PER_POOL_QUEUE];
+	std::atomic<unsigned int> m_PoolIndex;
+	std::atomic<TimerWord> m_LastReseed;
+#else
+	unsigned int m_PoolIndex;
+	TimerWord m_LastReseed;
 #endif
 	SecByteBlock m_Key;
 	SecByteBlock m_Counter;
-	byte m_PoolIndex;
-	word64 m_ReseedCounter;
-	FixedSizeSecBlock<word64,NUM_POOLS> m_PoolProcessedData;
-	ThreadUserTimer m_ReseedTimer;
+	SharedCounter m_ReseedCounter;
+	// increased by every reseed, tells the generators to fetch a new key
+	SharedCounter m_Generation;
+	SharedCounter m_PoolProcessedData[NUM_POOLS];
+	Generator m_Generators[NUM_GENERATORS];
+	Timer m_ReseedTimer;
+	TimerWord m_ReseedInterval;
 };
 
 // note: digestsize of reseed hash must be longer than max keylength of the cipher
@@ -4,6 +4,7 @@
 #include "pch.h"
 #include "Threefish.h"
 #include "misc.h"
+#include "cpu.h"
 
 #define KeyScheduleConst 0x1BD11BDAA9FC1A22L
 
@@ -180,6 +181,475 @@ void Threefish_1024::Dec::ProcessAndXorBlockWithTweak(const byte *inBlock, const
 		xorbuf(outBlock,xorBlock,BLOCKSIZE);
 }
 
+// Batched processing: the add-rotate-xor chain of one block leaves most execution units idle,
+// so several blocks go through the rounds together, each with its own tweak.
+// Every MIX and key injection is written out for all lanes, X[l][i] is word i of the block in lane l.
+// Threefish-1024 has enough independent words on its own, more lanes only spill registers.
+
+#define TF_MIX(l,a,b,r) X[l][a]+=X[l][b]; X[l][b]=rotlFixed(X[l][b],r)^X[l][a];
+#define TF_UNMIX(l,a,b,r) X[l][b]=rotrFixed(X[l][b]^X[l][a],r); X[l][a]-=X[l][b];
+
+#define TF_LANES1(M,a,b,r) M(0,a,b,r)
+#define TF_LANES2(M,a,b,r) M(0,a,b,r) M(1,a,b,r)
+#define TF_LANES4(M,a,b,r) M(0,a,b,r) M(1,a,b,r) M(2,a,b,r) M(3,a,b,r)
+#define TF_LANES1_KEY(M,s) M(0,s)
+#define TF_LANES2_KEY(M,s) M(0,s) M(1,s)
+#define TF_LANES4_KEY(M,s) M(0,s) M(1,s) M(2,s) M(3,s)
+
+#define TF256_ROUNDS_A(L,M) \
+	L(M,0,1,14) L(M,2,3,16) L(M,0,3,52) L(M,2,1,57) \
+	L(M,0,1,23) L(M,2,3,40) L(M,0,3,5) L(M,2,1,37)
+#define TF256_ROUNDS_B(L,M) \
+	L(M,0,1,25) L(M,2,3,33) L(M,0,3,46) L(M,2,1,12) \
+	L(M,0,1,58) L(M,2,3,22) L(M,0,3,32) L(M,2,1,32)
+#define TF256_UNROUNDS_A(L,M) \
+	L(M,2,1,37) L(M,0,3,5) L(M,2,3,40) L(M,0,1,23) \
+	L(M,2,1,57) L(M,0,3,52) L(M,2,3,16) L(M,0,1,14)
+#define TF256_UNROUNDS_B(L,M) \
+	L(M,2,1,32) L(M,0,3,32) L(M,2,3,22) L(M,0,1,58) \
+	L(M,2,1,12) L(M,0,3,46) L(M,2,3,33) L(M,0,1,25)
+
+#define TF512_ROUNDS_A(L,M) \
+	L(M,0,1,46) L(M,2,3,36) L(M,4,5,19) L(M,6,7,37) \
+	L(M,2,1,33) L(M,4,7,27) L(M,6,5,14) L(M,0,3,42) \
+	L(M,4,1,17) L(M,6,3,49) L(M,0,5,36) L(M,2,7,39) \
+	L(M,6,1,44) L(M,0,7,9) L(M,2,5,54) L(M,4,3,56)
+#define TF512_ROUNDS_B(L,M) \
+	L(M,0,1,39) L(M,2,3,30) L(M,4,5,34) L(M,6,7,24) \
+	L(M,2,1,13) L(M,4,7,50) L(M,6,5,10) L(M,0,3,17) \
+	L(M,4,1,25) L(M,6,3,29) L(M,0,5,39) L(M,2,7,43) \
+	L(M,6,1,8) L(M,0,7,35) L(M,2,5,56) L(M,4,3,22)
+#define TF512_UNROUNDS_A(L,M) \
+	L(M,4,3,56) L(M,2,5,54) L(M,0,7,9) L(M,6,1,44) \
+	L(M,2,7,39) L(M,0,5,36) L(M,6,3,49) L(M,4,1,17) \
+	L(M,0,3,42) L(M,6,5,14) L(M,4,7,27) L(M,2,1,33) \
+	L(M,6,7,37) L(M,4,5,19) L(M,2,3,36) L(M,0,1,46)
+#define TF512_UNROUNDS_B(L,M) \
+	L(M,4,3,22) L(M,2,5,56) L(M,0,7,35) L(M,6,1,8) \
+	L(M,2,7,43) L(M,0,5,39) L(M,6,3,29) L(M,4,1,25) \
+	L(M,0,3,17) L(M,6,5,10) L(M,4,7,50) L(M,2,1,13) \
+	L(M,6,7,24) L(M,4,5,34) L(M,2,3,30) L(M,0,1,39)
+
+#define TF1024_ROUNDS_A(L,M) \
+	L(M,0,1,24) L(M,2,3,13) L(M,4,5,8) L(M,6,7,47) \
+	L(M,8,9,8) L(M,10,11,17) L(M,12,13,22) L(M,14,15,37) \
+	L(M,0,9,38) L(M,2,13,19) L(M,6,11,10) L(M,4,15,55) \
+	L(M,10,7,49) L(M,12,3,18) L(M,14,5,23) L(M,8,1,52) \
+	L(M,0,7,33) L(M,2,5,4) L(M,4,3,51) L(M,6,1,13) \
+	L(M,12,15,34) L(M,14,13,41) L(M,8,11,59) L(M,10,9,17) \
+	L(M,0,15,5) L(M,2,11,20) L(M,6,13,48) L(M,4,9,41) \
+	L(M,14,1,47) L(M,8,5,28) L(M,10,3,16) L(M,12,7,25)
+#define TF1024_ROUNDS_B(L,M) \
+	L(M,0,1,41) L(M,2,3,9) L(M,4,5,37) L(M,6,7,31) \
+	L(M,8,9,12) L(M,10,11,47) L(M,12,13,44) L(M,14,15,30) \
+	L(M,0,9,16) L(M,2,13,34) L(M,6,11,56) L(M,4,15,51) \
+	L(M,10,7,4) L(M,12,3,53) L(M,14,5,42) L(M,8,1,41) \
+	L(M,0,7,31) L(M,2,5,44) L(M,4,3,47) L(M,6,1,46) \
+	L(M,12,15,19) L(M,14,13,42) L(M,8,11,44) L(M,10,9,25) \
+	L(M,0,15,9) L(M,2,11,48) L(M,6,13,35) L(M,4,9,52) \
+	L(M,14,1,23) L(M,8,5,31) L(M,10,3,37) L(M,12,7,20)
+#define TF1024_UNROUNDS_A(L,M) \
+	L(M,12,7,25) L(M,10,3,16) L(M,8,5,28) L(M,14,1,47) \
+	L(M,4,9,41) L(M,6,13,48) L(M,2,11,20) L(M,0,15,5) \
+	L(M,10,9,17) L(M,8,11,59) L(M,14,13,41) L(M,12,15,34) \
+	L(M,6,1,13) L(M,4,3,51) L(M,2,5,4) L(M,0,7,33) \
+	L(M,8,1,52) L(M,14,5,23) L(M,12,3,18) L(M,10,7,49) \
+	L(M,4,15,55) L(M,6,11,10) L(M,2,13,19) L(M,0,9,38) \
+	L(M,14,15,37) L(M,12,13,22) L(M,10,11,17) L(M,8,9,8) \
+	L(M,6,7,47) L(M,4,5,8) L(M,2,3,13) L(M,0,1,24)
+#define TF1024_UNROUNDS_B(L,M) \
+	L(M,12,7,20) L(M,10,3,37) L(M,8,5,31) L(M,14,1,23) \
+	L(M,4,9,52) L(M,6,13,35) L(M,2,11,48) L(M,0,15,9) \
+	L(M,10,9,25) L(M,8,11,44) L(M,14,13,42) L(M,12,15,19) \
+	L(M,6,1,46) L(M,4,3,47) L(M,2,5,44) L(M,0,7,31) \
+	L(M,8,1,41) L(M,14,5,42) L(M,12,3,53) L(M,10,7,4) \
+	L(M,4,15,51) L(M,6,11,56) L(M,2,13,34) L(M,0,9,16) \
+	L(M,14,15,30) L(M,12,13,44) L(M,10,11,47) L(M,8,9,12) \
+	L(M,6,7,31) L(M,4,5,37) L(M,2,3,9) L(M,0,1,41)
+#define TF256_INJECT(l,s) \
+	X[l][0]+=k[((s)+0)%5]; X[l][1]+=k[((s)+1)%5]+t[l][(s)%3]; X[l][2]+=k[((s)+2)%5]+t[l][((s)+1)%3]; X[l][3]+=k[((s)+3)%5]+(s);
+#define TF256_EJECT(l,s) \
+	X[l][0]-=k[((s)+0)%5]; X[l][1]-=(k[((s)+1)%5]+t[l][(s)%3]); X[l][2]-=(k[((s)+2)%5]+t[l][((s)+1)%3]); X[l][3]-=(k[((s)+3)%5]+(s));
+#define TF512_INJECT(l,s) \
+	X[l][0]+=k[((s)+0)%9]; X[l][1]+=k[((s)+1)%9]; X[l][2]+=k[((s)+2)%9]; X[l][3]+=k[((s)+3)%9]; \
+	X[l][4]+=k[((s)+4)%9]; X[l][5]+=k[((s)+5)%9]+t[l][(s)%3]; X[l][6]+=k[((s)+6)%9]+t[l][((s)+1)%3]; X[l][7]+=k[((s)+7)%9]+(s);
+#define TF512_EJECT(l,s) \
+	X[l][0]-=k[((s)+0)%9]; X[l][1]-=k[((s)+1)%9]; X[l][2]-=k[((s)+2)%9]; X[l][3]-=k[((s)+3)%9]; \
+	X[l][4]-=k[((s)+4)%9]; X[l][5]-=(k[((s)+5)%9]+t[l][(s)%3]); X[l][6]-=(k[((s)+6)%9]+t[l][((s)+1)%3]); X[l][7]-=(k[((s)+7)%9]+(s));
+#define TF1024_INJECT(l,s) \
+	X[l][0]+=k[((s)+0)%17]; X[l][1]+=k[((s)+1)%17]; X[l][2]+=k[((s)+2)%17]; X[l][3]+=k[((s)+3)%17]; \
+	X[l][4]+=k[((s)+4)%17]; X[l][5]+=k[((s)+5)%17]; X[l][6]+=k[((s)+6)%17]; X[l][7]+=k[((s)+7)%17]; \
+	X[l][8]+=k[((s)+8)%17]; X[l][9]+=k[((s)+9)%17]; X[l][10]+=k[((s)+10)%17]; X[l][11]+=k[((s)+11)%17]; \
+	X[l][12]+=k[((s)+12)%17]; X[l][13]+=k[((s)+13)%17]+t[l][(s)%3]; X[l][14]+=k[((s)+14)%17]+t[l][((s)+1)%3]; X[l][15]+=k[((s)+15)%17]+(s);
+#define TF1024_EJECT(l,s) \
+	X[l][0]-=k[((s)+0)%17]; X[l][1]-=k[((s)+1)%17]; X[l][2]-=k[((s)+2)%17]; X[l][3]-=k[((s)+3)%17]; \
+	X[l][4]-=k[((s)+4)%17]; X[l][5]-=k[((s)+5)%17]; X[l][6]-=k[((s)+6)%17]; X[l][7]-=k[((s)+7)%17]; \
+	X[l][8]-=k[((s)+8)%17]; X[l][9]-=k[((s)+9)%17]; X[l][10]-=k[((s)+10)%17]; X[l][11]-=k[((s)+11)%17]; \
+	X[l][12]-=k[((s)+12)%17]; X[l][13]-=(k[((s)+13)%17]+t[l][(s)%3]); X[l][14]-=(k[((s)+14)%17]+t[l][((s)+1)%3]); X[l][15]-=(k[((s)+15)%17]+(s));
+
+#define TF_8_ROUNDS(N,L,LK,MIX,INJECT,s) \
+	TF##N##_ROUNDS_A(L,MIX) LK(INJECT,(s)+1) TF##N##_ROUNDS_B(L,MIX) LK(INJECT,(s)+2)
+#define TF_8_UNROUNDS(N,L,LK,UNMIX,EJECT,s) \
+	LK(EJECT,(s)+2) TF##N##_UNROUNDS_B(L,UNMIX) LK(EJECT,(s)+1) TF##N##_UNROUNDS_A(L,UNMIX)
+
+//! Key is the expanded key, Tweaks holds the three tweak words of every lane, Blocks the words of all lanes
+typedef void (*ThreefishLanesFunction)(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks);
+
+static void Threefish256_EncryptLanes(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	word64 k[5],t[4][3],X[4][4];
+	memcpy(k,Key,sizeof(k));
+	memcpy(t,Tweaks,sizeof(t));
+	memcpy(X,Blocks,sizeof(X));
+
+	TF_LANES4_KEY(TF256_INJECT,0)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,0)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,2)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,4)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,6)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,8)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,10)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,12)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,14)
+	TF_8_ROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_MIX,TF256_INJECT,16)
+
+	memcpy(Blocks,X,sizeof(X));
+}
+
+static void Threefish256_DecryptLanes(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	word64 k[5],t[4][3],X[4][4];
+	memcpy(k,Key,sizeof(k));
+	memcpy(t,Tweaks,sizeof(t));
+	memcpy(X,Blocks,sizeof(X));
+
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,16)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,14)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,12)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,10)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,8)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,6)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,4)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,2)
+	TF_8_UNROUNDS(256,TF_LANES4,TF_LANES4_KEY,TF_UNMIX,TF256_EJECT,0)
+	TF_LANES4_KEY(TF256_EJECT,0)
+
+	memcpy(Blocks,X,sizeof(X));
+}
+
+static void Threefish512_EncryptLanes(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	word64 k[9],t[2][3],X[2][8];
+	memcpy(k,Key,sizeof(k));
+	memcpy(t,Tweaks,sizeof(t));
+	memcpy(X,Blocks,sizeof(X));
+
+	TF_LANES2_KEY(TF512_INJECT,0)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,0)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,2)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,4)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,6)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,8)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,10)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,12)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,14)
+	TF_8_ROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_MIX,TF512_INJECT,16)
+
+	memcpy(Blocks,X,sizeof(X));
+}
+
+static void Threefish512_DecryptLanes(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	word64 k[9],t[2][3],X[2][8];
+	memcpy(k,Key,sizeof(k));
+	memcpy(t,Tweaks,sizeof(t));
+	memcpy(X,Blocks,sizeof(X));
+
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,16)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,14)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,12)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,10)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,8)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,6)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,4)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,2)
+	TF_8_UNROUNDS(512,TF_LANES2,TF_LANES2_KEY,TF_UNMIX,TF512_EJECT,0)
+	TF_LANES2_KEY(TF512_EJECT,0)
+
+	memcpy(Blocks,X,sizeof(X));
+}
+
+static void Threefish1024_EncryptLanes(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	word64 k[17],t[1][3],X[1][16];
+	memcpy(k,Key,sizeof(k));
+	memcpy(t,Tweaks,sizeof(t));
+	memcpy(X,Blocks,sizeof(X));
+
+	TF_LANES1_KEY(TF1024_INJECT,0)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,0)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,2)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,4)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,6)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,8)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,10)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,12)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,14)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,16)
+	TF_8_ROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_MIX,TF1024_INJECT,18)
+
+	memcpy(Blocks,X,sizeof(X));
+}
+
+static void Threefish1024_DecryptLanes(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	word64 k[17],t[1][3],X[1][16];
+	memcpy(k,Key,sizeof(k));
+	memcpy(t,Tweaks,sizeof(t));
+	memcpy(X,Blocks,sizeof(X));
+
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,18)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,16)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,14)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,12)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,10)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,8)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,6)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,4)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,2)
+	TF_8_UNROUNDS(1024,TF_LANES1,TF_LANES1_KEY,TF_UNMIX,TF1024_EJECT,0)
+	TF_LANES1_KEY(TF1024_EJECT,0)
+
+	memcpy(Blocks,X,sizeof(X));
+}
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+// Threefish-256 has exactly four words, so with the blocks transposed register i holds word i of all four lanes.
+// There is no 64-bit rotate before AVX-512, it takes two shifts and an or.
+#define TF_AVX2_ROTL(x,r) _mm256_or_si256(_mm256_slli_epi64((x),(r)),_mm256_srli_epi64((x),64-(r)))
+#define TF_AVX2_MIX(l,a,b,r) X##a=_mm256_add_epi64(X##a,X##b); X##b=_mm256_xor_si256(TF_AVX2_ROTL(X##b,r),X##a);
+#define TF_AVX2_UNMIX(l,a,b,r) X##b=TF_AVX2_ROTL(_mm256_xor_si256(X##b,X##a),64-(r)); X##a=_mm256_sub_epi64(X##a,X##b);
+#define TF_AVX2_LANES(M,a,b,r) M(0,a,b,r)
+#define TF_AVX2_LANES_KEY(M,s) M(0,s)
+
+#define TF256_AVX2_INJECT(l,s) \
+	X0=_mm256_add_epi64(X0,K[((s)+0)%5]); X1=_mm256_add_epi64(X1,_mm256_add_epi64(K[((s)+1)%5],T[(s)%3])); \
+	X2=_mm256_add_epi64(X2,_mm256_add_epi64(K[((s)+2)%5],T[((s)+1)%3])); \
+	X3=_mm256_add_epi64(X3,_mm256_add_epi64(K[((s)+3)%5],_mm256_set1_epi64x(s)));
+#define TF256_AVX2_EJECT(l,s) \
+	X0=_mm256_sub_epi64(X0,K[((s)+0)%5]); X1=_mm256_sub_epi64(X1,_mm256_add_epi64(K[((s)+1)%5],T[(s)%3])); \
+	X2=_mm256_sub_epi64(X2,_mm256_add_epi64(K[((s)+2)%5],T[((s)+1)%3])); \
+	X3=_mm256_sub_epi64(X3,_mm256_add_epi64(K[((s)+3)%5],_mm256_set1_epi64x(s)));
+
+// turns four blocks into four registers of words and back, the transformation is its own inverse
+#define TF_AVX2_TRANSPOSE(a,b,c,d) { \
+	const __m256i t0=_mm256_unpacklo_epi64(a,b), t1=_mm256_unpackhi_epi64(a,b); \
+	const __m256i t2=_mm256_unpacklo_epi64(c,d), t3=_mm256_unpackhi_epi64(c,d); \
+	a=_mm256_permute2x128_si256(t0,t2,0x20); b=_mm256_permute2x128_si256(t1,t3,0x20); \
+	c=_mm256_permute2x128_si256(t0,t2,0x31); d=_mm256_permute2x128_si256(t1,t3,0x31); }
+
+#define TF256_AVX2_SETUP \
+	__m256i K[5],T[3]; \
+	for(unsigned int i=0;i<5;++i) \
+		K[i]=_mm256_set1_epi64x(Key[i]); \
+	for(unsigned int i=0;i<3;++i) \
+		T[i]=_mm256_setr_epi64x(Tweaks[0][i],Tweaks[1][i],Tweaks[2][i],Tweaks[3][i]); \
+	__m256i X0=_mm256_loadu_si256((const __m256i*)(Blocks+0)); \
+	__m256i X1=_mm256_loadu_si256((const __m256i*)(Blocks+4)); \
+	__m256i X2=_mm256_loadu_si256((const __m256i*)(Blocks+8)); \
+	__m256i X3=_mm256_loadu_si256((const __m256i*)(Blocks+12)); \
+	TF_AVX2_TRANSPOSE(X0,X1,X2,X3)
+
+#define TF256_AVX2_STORE \
+	TF_AVX2_TRANSPOSE(X0,X1,X2,X3) \
+	_mm256_storeu_si256((__m256i*)(Blocks+0),X0); \
+	_mm256_storeu_si256((__m256i*)(Blocks+4),X1); \
+	_mm256_storeu_si256((__m256i*)(Blocks+8),X2); \
+	_mm256_storeu_si256((__m256i*)(Blocks+12),X3);
+
+static void Threefish256_EncryptLanesAVX2(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	TF256_AVX2_SETUP
+
+	TF256_AVX2_INJECT(0,0)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,0)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,2)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,4)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,6)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,8)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,10)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,12)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,14)
+	TF_8_ROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_MIX,TF256_AVX2_INJECT,16)
+
+	TF256_AVX2_STORE
+}
+
+static void Threefish256_DecryptLanesAVX2(const word64 *Key, const word64 (*Tweaks)[3], word64 *Blocks)
+{
+	TF256_AVX2_SETUP
+
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,16)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,14)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,12)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,10)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,8)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,6)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,4)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,2)
+	TF_8_UNROUNDS(256,TF_AVX2_LANES,TF_AVX2_LANES_KEY,TF_AVX2_UNMIX,TF256_AVX2_EJECT,0)
+	TF256_AVX2_EJECT(0,0)
+
+	TF256_AVX2_STORE
+}
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+// gathers LANES blocks with their tweaks for Lanes(), lanes without input run on zeros
+// the tweaks come from the array Tweaks or, if it is NULL, from the little endian counter Counter
+template <unsigned int WORDS, unsigned int LANES>
+static size_t Threefish_AdvancedProcessBlocks(ThreefishLanesFunction Lanes, const word64 *Key,
+	const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags,
+	const byte *Tweaks, size_t TweakLength, byte *Counter, word64 Increment)
+{
+	const size_t blockSize = 8*WORDS;
+	const size_t inIncrement = (flags & BlockTransformation::BT_InBlockIsCounter) ? 0 : blockSize;
+	const size_t xorIncrement = xorBlocks ? blockSize : 0;
+
+	FixedSizeSecBlock<word64,LANES*WORDS> Blocks;
+	FixedSizeSecBlock<word64,LANES*3> Tweak;
+	word64 Counter0=0,Counter1=0;
+	if(Counter)
+	{
+		Counter0=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,Counter);
+		Counter1=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,Counter+8);
+	}
+
+	while(length>=blockSize)
+	{
+		const unsigned int Count = static_cast<unsigned int>(STDMIN<size_t>(LANES,length/blockSize));
+
+		for(unsigned int l=0;l<Count;++l)
+		{
+			if(flags & BlockTransformation::BT_XorInput)
+			{
+				xorbuf(outBlocks+l*blockSize,xorBlocks+l*xorIncrement,inBlocks+l*inIncrement,blockSize);
+				GetUserKey(LITTLE_ENDIAN_ORDER,Blocks+l*WORDS,WORDS,outBlocks+l*blockSize,blockSize);
+			}
+			else
+				GetUserKey(LITTLE_ENDIAN_ORDER,Blocks+l*WORDS,WORDS,inBlocks+l*inIncrement,blockSize);
+			if(flags & BlockTransformation::BT_InBlockIsCounter)
+				const_cast<byte *>(inBlocks)[blockSize-1]++;
+
+			if(Counter)
+			{
+				Tweak[3*l]=Counter0;
+				Tweak[3*l+1]=Counter1;
+				Counter0+=Increment;
+				Counter1+=(Counter0<Increment);
+			}
+			else
+			{
+				Tweak[3*l]=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,Tweaks);
+				Tweak[3*l+1]=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,Tweaks+8);
+				Tweaks+=TweakLength;
+			}
+			Tweak[3*l+2]=Tweak[3*l]^Tweak[3*l+1];
+		}
+		if(Count<LANES)
+		{
+			memset(Blocks+Count*WORDS,0,(LANES-Count)*WORDS*sizeof(word64));
+			memset(Tweak+Count*3,0,(LANES-Count)*3*sizeof(word64));
+		}
+
+		Lanes(Key,(const word64 (*)[3])Tweak.data(),Blocks);
+
+		for(unsigned int l=0;l<Count;++l)
+		{
+			byte *out = outBlocks+l*blockSize;
+			for(unsigned int i=0;i<WORDS;++i)
+				PutWord(false,LITTLE_ENDIAN_ORDER,out+8*i,Blocks[l*WORDS+i]);
+			if(xorBlocks && !(flags & BlockTransformation::BT_XorInput))
+				xorbuf(out,xorBlocks+l*xorIncrement,blockSize);
+		}
+
+		inBlocks += Count*inIncrement;
+		xorBlocks += Count*xorIncrement;
+		outBlocks += Count*blockSize;
+		length -= Count*blockSize;
+	}
+
+	if(Counter)
+	{
+		PutWord(false,LITTLE_ENDIAN_ORDER,Counter,Counter0);
+		PutWord(false,LITTLE_ENDIAN_ORDER,Counter+8,Counter1);
+	}
+	return length;
+}
+
+static ThreefishLanesFunction Threefish256_GetLanesFunction(bool Encryption)
+{
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	if(HasAVX2())
+		return Encryption ? &Threefish256_EncryptLanesAVX2 : &Threefish256_DecryptLanesAVX2;
+#endif
+	return Encryption ? &Threefish256_EncryptLanes : &Threefish256_DecryptLanes;
+}
+
+// blocks that depend on each other can't share the rounds
+#define THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags) ((flags) & (BT_DontIncrementInOutPointers|BT_ReverseDirection))
+
+size_t Threefish_256::Base::AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const
+{
+	AssertValidTweakLength(TweakLength);
+	if(THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags))
+		return TweakableBlockCipher::AdvancedProcessBlocksWithTweaks(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength);
+	return Threefish_AdvancedProcessBlocks<4,4>(Threefish256_GetLanesFunction(IsForwardTransformation()),m_key,inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,NULL,0);
+}
+
+size_t Threefish_256::Base::AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement) const
+{
+	AssertValidTweakLength(TweakLength);
+	if(THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags))
+		return TweakableBlockCipher::AdvancedProcessBlocksWithTweakCounter(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,TweakIncrement);
+	return Threefish_AdvancedProcessBlocks<4,4>(Threefish256_GetLanesFunction(IsForwardTransformation()),m_key,inBlocks,xorBlocks,outBlocks,length,flags,NULL,TweakLength,Tweak,TweakIncrement);
+}
+
+size_t Threefish_512::Base::AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const
+{
+	AssertValidTweakLength(TweakLength);
+	if(THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags))
+		return TweakableBlockCipher::AdvancedProcessBlocksWithTweaks(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength);
+	return Threefish_AdvancedProcessBlocks<8,2>(IsForwardTransformation() ? &Threefish512_EncryptLanes : &Threefish512_DecryptLanes,
+		m_key,inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,NULL,0);
+}
+
+size_t Threefish_512::Base::AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement) const
+{
+	AssertValidTweakLength(TweakLength);
+	if(THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags))
+		return TweakableBlockCipher::AdvancedProcessBlocksWithTweakCounter(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,TweakIncrement);
+	return Threefish_AdvancedProcessBlocks<8,2>(IsForwardTransformation() ? &Threefish512_EncryptLanes : &Threefish512_DecryptLanes,
+		m_key,inBlocks,xorBlocks,outBlocks,length,flags,NULL,TweakLength,Tweak,TweakIncrement);
+}
+
+size_t Threefish_1024::Base::AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const
+{
+	AssertValidTweakLength(TweakLength);
+	if(THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags))
+		return TweakableBlockCipher::AdvancedProcessBlocksWithTweaks(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength);
+	return Threefish_AdvancedProcessBlocks<16,1>(IsForwardTransformation() ? &Threefish1024_EncryptLanes : &Threefish1024_DecryptLanes,
+		m_key,inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,NULL,0);
+}
+
+size_t Threefish_1024::Base::AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement) const
+{
+	AssertValidTweakLength(TweakLength);
+	if(THREEFISH_NEEDS_SEQUENTIAL_PROCESSING(flags))
+		return TweakableBlockCipher::AdvancedProcessBlocksWithTweakCounter(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,TweakIncrement);
+	return Threefish_AdvancedProcessBlocks<16,1>(IsForwardTransformation() ? &Threefish1024_EncryptLanes : &Threefish1024_DecryptLanes,
+		m_key,inBlocks,xorBlocks,outBlocks,length,flags,NULL,TweakLength,Tweak,TweakIncrement);
+}
+
 #ifdef CRYPTOPP_USE_DYNAMIC_THREEFISH
 
 void Threefish::Base::UncheckedSetKey(const byte *userKey, unsigned int length, const NameValuePairs &)
@@ -219,6 +689,22 @@ void Threefish::Base::ProcessAndXorBlockWithTweak(const byte *inBlock, const byt
 		throw(CryptoPP::InvalidState(this->GetAlgorithm().AlgorithmName()));
 }
 
+size_t Threefish::Base::AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const
+{
+	if(m_Instance.get())
+		return m_Instance->AdvancedProcessBlocksWithTweaks(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength);
+	else
+		throw(CryptoPP::InvalidState(this->GetAlgorithm().AlgorithmName()));
+}
+
+size_t Threefish::Base::AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement) const
+{
+	if(m_Instance.get())
+		return m_Instance->AdvancedProcessBlocksWithTweakCounter(inBlocks,xorBlocks,outBlocks,length,flags,Tweak,TweakLength,TweakIncrement);
+	else
+		throw(CryptoPP::InvalidState(this->GetAlgorithm().AlgorithmName()));
+}
+
 unsigned int Threefish::Base::BlockSize() const
 {
 	if(m_Instance.get())
@@ -37,6 +37,11 @@ class Threefish_256 : public Threefish256_Info, public TweakableBlockCipherDocum
 	public:
 		void UncheckedSetKey(const byte *userKey, unsigned int length, const NameValuePairs &params);
 
+		//! processes 4 blocks at a time, with AVX2 in one register per word
+		size_t AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const;
+		size_t AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement=1) const;
+		unsigned int OptimalNumberOfParallelBlocks() const {return 4;}
+
 	protected:
 		FixedSizeSecBlock<word64, 5> m_key;
 	};
@@ -64,6 +69,11 @@ class Threefish_512 : public Threefish512_Info, public TweakableBlockCipherDocum
 	public:
 		void UncheckedSetKey(const byte *userKey, unsigned int length, const NameValuePairs &params);
 
+		//! processes 2 blocks at a time
+		size_t AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const;
+		size_t AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement=1) const;
+		unsigned int OptimalNumberOfParallelBlocks() const {return 2;}
+
 	protected:
 		FixedSizeSecBlock<word64, 9> m_key;
 	};
@@ -91,6 +101,11 @@ class Threefish_1024 : public Threefish1024_Info, public TweakableBlockCipherDoc
 	public:
 		void UncheckedSetKey(const byte *userKey, unsigned int length, const NameValuePairs &params);
 
+		//! the rounds of a single block already keep the CPU busy, only the per block overhead is saved
+		size_t AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const;
+		size_t AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement=1) const;
+		unsigned int OptimalNumberOfParallelBlocks() const {return 1;}
+
 	protected:
 		FixedSizeSecBlock<word64, 17> m_key;
 	};
@@ -122,6 +137,8 @@ class Threefish : public Threefish_Info, public TweakableBlockCipherDocumentatio
 	public:
 		void UncheckedSetKey(const byte *userKey, unsigned int length, const NameValuePairs &params);
 		void ProcessAndXorBlockWithTweak(const byte *inBlock, const byte *xorBlock, byte *outBlock,const byte* Tweak,const size_t TweakLength) const;
+		size_t AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const;
+		size_t AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement=1) const;
 		size_t GetValidKeyLength(size_t n)const;
 		unsigned int BlockSize() const;
 	protected:
@@ -210,13 +210,15 @@ struct WindowSlider
 		: exp(expIn), windowModulus(Integer::One()), windowSize(windowSizeIn), windowBegin(0), fastNegate(fastNegate), firstTime(true), finished(false)
 	{
 		if (windowSize == 0)
-		{
-			unsigned int expLen = exp.BitCount();
-			windowSize = expLen <= 17 ? 1 : (expLen <= 24 ? 2 : (expLen <= 70 ? 3 : (expLen <= 197 ? 4 : (expLen <= 539 ? 5 : (expLen <= 1434 ? 6 : 7)))));
-		}
+			windowSize = DefaultWindowSize(exp.BitCount());
 		windowModulus <<= windowSize;
 	}
 
+	static unsigned int DefaultWindowSize(unsigned int expLen)
+	{
+		return expLen <= 17 ? 1 : (expLen <= 24 ? 2 : (expLen <= 70 ? 3 : (expLen <= 197 ? 4 : (expLen <= 539 ? 5 : (expLen <= 1434 ? 6 : 7)))));
+	}
+
 	void FindNextWindow()
 	{
 		unsigned int expLen = exp.WordCount() * WORD_BITS;
@@ -252,6 +254,213 @@ struct WindowSlider
 	bool fastNegate, negateNext, firstTime, finished;
 };
 
+// one window of a scalar for interleaved multiplication, contributes (negate ? -value : value) << position
+struct MultiScalarWindow
+{
+	unsigned int position;
+	word32 value;
+	bool negate;
+};
+
+// appends the sliding windows of k, lowest first, and returns the largest window value
+inline word32 SlidingWindows(std::vector<MultiScalarWindow> &windows, const Integer &k, bool fastNegate)
+{
+	WindowSlider slider(k, fastNegate);
+	word32 maxValue = 0;
+	for (slider.FindNextWindow(); !slider.finished; slider.FindNextWindow())
+	{
+		MultiScalarWindow w = {slider.windowBegin, slider.expWindow, slider.negateNext};
+		windows.push_back(w);
+		maxValue = STDMAX(maxValue, slider.expWindow);
+	}
+	return maxValue;
+}
+
+// returns the window size for bucket (Pippenger) multiplication of count scalars with the given
+// bit length, or 0 if interleaved sliding windows (Straus) need fewer additions
+inline unsigned int MultiScalarBucketWindowSize(size_t count, unsigned int bits, bool fastNegate)
+{
+	// both methods double bits times, so only additions are counted
+	const unsigned int w = WindowSlider::DefaultWindowSize(bits);
+	const lword strausCost = lword(count) * (bits/(w+1) + (lword(1) << (w-1)));
+
+	unsigned int bestWindow = 0;
+	lword bestCost = strausCost;
+	for (unsigned int c=2; c<=16; c++)
+	{
+		const lword windowCount = (bits+c-1)/c + fastNegate;
+		const lword bucketCount = fastNegate ? (lword(1) << (c-1)) : (lword(1) << c) - 1;
+		const lword cost = windowCount * (count + 2*bucketCount);
+		if (cost < bestCost)
+		{
+			bestWindow = c;
+			bestCost = cost;
+		}
+	}
+	return bestWindow;
+}
+
+// splits k into windowCount base 2^c digits, lowest first, each in [-2^(c-1), 2^(c-1)] if signed
+// and in [0, 2^c) otherwise
+inline void BucketDigits(int *digits, const Integer &k, unsigned int c, unsigned int windowCount, bool fastNegate)
+{
+	const int half = 1 << (c-1);
+	int carry = 0;
+	for (unsigned int j=0; j<windowCount; j++)
+	{
+		int d = int(k.GetBits(j*c, c)) + carry;
+		carry = 0;
+		if (fastNegate && d > half)
+		{
+			d -= 2*half;
+			carry = 1;
+		}
+		digits[j] = d;
+	}
+}
+
+template <class T>
+T AbstractGroup<T>::MultiScalarMultiply(const Element *points, const Integer *scalars, size_t count) const
+{
+	std::vector<Element> bases(points, points+count);
+	std::vector<Integer> exponents(scalars, scalars+count);
+	unsigned int bits = 0;
+	size_t i;
+
+	for (i=0; i<count; i++)
+	{
+		if (exponents[i].IsNegative())
+		{
+			bases[i] = Inverse(bases[i]);
+			exponents[i].SetPositive();
+		}
+		bits = STDMAX(bits, exponents[i].BitCount());
+	}
+
+	if (bits == 0)
+		return Identity();
+	if (count == 1)
+		return ScalarMultiply(bases[0], exponents[0]);
+	if (count == 2)
+		return CascadeScalarMultiply(bases[0], exponents[0], bases[1], exponents[1]);
+
+	const bool fastNegate = InversionIsFast();
+	const unsigned int c = MultiScalarBucketWindowSize(count, bits, fastNegate);
+	Element result = Identity();
+
+	if (c == 0)
+	{
+		// Straus: tables of odd multiples, one shared chain of doublings
+		std::vector<std::vector<MultiScalarWindow> > windows(count);
+		std::vector<std::vector<Element> > tables(count);
+		std::vector<size_t> next(count);
+		unsigned int top = 0;
+
+		for (i=0; i<count; i++)
+		{
+			word32 maxValue = SlidingWindows(windows[i], exponents[i], fastNegate);
+			next[i] = windows[i].size();
+			if (windows[i].empty())
+				continue;
+			top = STDMAX(top, windows[i].back().position);
+
+			std::vector<Element> &table = tables[i];
+			table.resize(maxValue/2+1);
+			table[0] = bases[i];
+			if (table.size() > 1)
+			{
+				const Element twice = Double(bases[i]);
+				for (size_t j=1; j<table.size(); j++)
+					table[j] = Add(table[j-1], twice);
+			}
+		}
+
+		bool started = false;
+		for (unsigned int position = top+1; position-- > 0; )
+		{
+			if (started)
+				result = Double(result);
+			for (i=0; i<count; i++)
+			{
+				if (next[i] == 0 || windows[i][next[i]-1].position != position)
+					continue;
+				const MultiScalarWindow &w = windows[i][--next[i]];
+				const Element &e = tables[i][w.value/2];
+				if (!started)
+					result = w.negate ? Inverse(e) : e;
+				else if (w.negate)
+					Accumulate(result, Inverse(e));
+				else
+					Accumulate(result, e);
+				started = true;
+			}
+		}
+	}
+	else
+	{
+		// Pippenger: per window, add each point into the bucket of its digit, then sum the
+		// buckets weighted by their index with two running sums
+		const unsigned int windowCount = (bits+c-1)/c + fastNegate;
+		const size_t bucketCount = fastNegate ? (size_t(1) << (c-1)) : (size_t(1) << c) - 1;
+		std::vector<int> digits(count*windowCount);
+		std::vector<Element> buckets(bucketCount);
+		std::vector<bool> filled(bucketCount);
+		bool started = false;
+
+		for (i=0; i<count; i++)
+			BucketDigits(&digits[i*windowCount], exponents[i], c, windowCount, fastNegate);
+
+		for (unsigned int j=windowCount; j-- > 0; )
+		{
+			if (started)
+				for (unsigned int s=0; s<c; s++)
+					result = Double(result);
+
+			std::fill(filled.begin(), filled.end(), false);
+			for (i=0; i<count; i++)
+			{
+				const int d = digits[i*windowCount+j];
+				if (d == 0)
+					continue;
+				const size_t b = (d < 0 ? -d : d) - 1;
+				if (!filled[b])
+				{
+					buckets[b] = d < 0 ? Inverse(bases[i]) : bases[i];
+					filled[b] = true;
+				}
+				else if (d < 0)
+					Accumulate(buckets[b], Inverse(bases[i]));
+				else
+					Accumulate(buckets[b], bases[i]);
+			}
+
+			Element sum, total;
+			bool haveSum = false, haveTotal = false;
+			for (size_t b=bucketCount; b-- > 0; )
+			{
+				if (filled[b])
+				{
+					sum = haveSum ? Add(sum, buckets[b]) : buckets[b];
+					haveSum = true;
+				}
+				if (haveSum)
+				{
+					total = haveTotal ? Add(total, sum) : sum;
+					haveTotal = true;
+				}
+			}
+
+			if (haveTotal)
+			{
+				result = started ? Add(result, total) : total;
+				started = true;
+			}
+		}
+	}
+
+	return result;
+}
+
 template <class T>
 void AbstractGroup<T>::SimultaneousMultiply(T *results, const T &base, const Integer *expBegin, unsigned int expCount) const
 {
@@ -326,6 +535,11 @@ template <class T> T AbstractRing<T>::CascadeExponentiate(const Element &x, cons
 	return MultiplicativeGroup().AbstractGroup<T>::CascadeScalarMultiply(x, e1, y, e2);
 }
 
+template <class T> T AbstractRing<T>::MultiExponentiate(const Element *bases, const Integer *exponents, size_t count) const
+{
+	return MultiplicativeGroup().AbstractGroup<T>::MultiScalarMultiply(bases, exponents, count);
+}
+
 template <class Element, class Iterator> Element GeneralCascadeExponentiation(const AbstractRing<Element> &ring, Iterator begin, Iterator end)
 {
 	return GeneralCascadeMultiplication<Element>(ring.MultiplicativeGroup(), begin, end);
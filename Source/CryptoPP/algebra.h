@@ -38,6 +38,12 @@ public:
 	virtual Element CascadeScalarMultiply(const Element &x, const Integer &e1, const Element &y, const Integer &e2) const;
 
 	virtual void SimultaneousMultiply(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const;
+
+	//! returns the sum of scalars[i]*points[i] for i < count
+	/*! Interleaves sliding windows of all scalars over one chain of doublings (Straus) for few
+		terms, and sorts points into buckets per window (Pippenger) for many terms. Negative
+		scalars are allowed. */
+	virtual Element MultiScalarMultiply(const Element *points, const Integer *scalars, size_t count) const;
 };
 
 //! Abstract Ring
@@ -63,6 +69,9 @@ public:
 
 	virtual void SimultaneousExponentiate(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const;
 
+	//! returns the product of bases[i]^exponents[i] for i < count, see AbstractGroup::MultiScalarMultiply()
+	virtual Element MultiExponentiate(const Element *bases, const Integer *exponents, size_t count) const;
+
 	virtual const AbstractGroup<T>& MultiplicativeGroup() const
 		{return m_mg;}
 
@@ -106,6 +115,9 @@ private:
 		void SimultaneousMultiply(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const
 			{GetRing().SimultaneousExponentiate(results, base, exponents, exponentsCount);}
 
+		Element MultiScalarMultiply(const Element *points, const Integer *scalars, size_t count) const
+			{return GetRing().MultiExponentiate(points, scalars, count);}
+
 		const AbstractRing<T> *m_pRing;
 	};
 
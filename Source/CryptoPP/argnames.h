@@ -24,6 +24,7 @@ CRYPTOPP_DEFINE_NAME_STRING(KeySize)			//!< int, in bits
 CRYPTOPP_DEFINE_NAME_STRING(ModulusSize)		//!< int, in bits
 CRYPTOPP_DEFINE_NAME_STRING(SubgroupOrderSize)	//!< int, in bits
 CRYPTOPP_DEFINE_NAME_STRING(PrivateExponentSize)//!< int, in bits
+CRYPTOPP_DEFINE_NAME_STRING(NumberOfPrimes)		//!< int
 CRYPTOPP_DEFINE_NAME_STRING(Modulus)			//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(PublicExponent)		//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(PrivateExponent)	//!< Integer
@@ -39,6 +40,8 @@ CRYPTOPP_DEFINE_NAME_STRING(Prime2)				//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(ModPrime1PrivateExponent)	//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(ModPrime2PrivateExponent)	//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(MultiplicativeInverseOfPrime2ModPrime1)	//!< Integer
+CRYPTOPP_DEFINE_NAME_STRING(OtherPrimeInfos)	//!< std::vector<RSAOtherPrimeInfo>
+CRYPTOPP_DEFINE_NAME_STRING(ParallelCRT)		//!< bool
 CRYPTOPP_DEFINE_NAME_STRING(QuadraticResidueModPrime1)	//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(QuadraticResidueModPrime2)	//!< Integer
 CRYPTOPP_DEFINE_NAME_STRING(PutMessage)			//!< bool
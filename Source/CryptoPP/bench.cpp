@@ -11,6 +11,10 @@
 #include "modes.h"
 #include "factory.h"
 #include "cpu.h"
+#include "blake2b.h"
+#include "blake2s.h"
+#include "threadpool.h"
+#include "hrtimer.h"
 
 #include <time.h>
 #include <math.h>
@@ -20,14 +24,6 @@
 USING_NAMESPACE(CryptoPP)
 USING_NAMESPACE(std)
 
-#ifdef CLOCKS_PER_SEC
-const double CLOCK_TICKS_PER_SECOND = (double)CLOCKS_PER_SEC;
-#elif defined(CLK_TCK)
-const double CLOCK_TICKS_PER_SECOND = (double)CLK_TCK;
-#else
-const double CLOCK_TICKS_PER_SECOND = 1000000.0;
-#endif
-
 double logtotal = 0, g_allocatedTime, g_hertz;
 unsigned int logcount = 0;
 
@@ -76,7 +72,8 @@ void BenchMark(const char *name, BlockTransformation &cipher, double timeTotal)
 	const int BUF_SIZE = RoundUpToMultipleOf(2048U, cipher.OptimalNumberOfParallelBlocks() * cipher.BlockSize());
 	AlignedSecByteBlock buf(BUF_SIZE);
 	const int nBlocks = BUF_SIZE / cipher.BlockSize();
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 
 	unsigned long i=0, blocks=1;
 	double timeTaken;
@@ -85,7 +82,7 @@ void BenchMark(const char *name, BlockTransformation &cipher, double timeTotal)
 		blocks *= 2;
 		for (; i<blocks; i++)
 			cipher.ProcessAndXorMultipleBlocks(buf, NULL, buf, nBlocks);
-		timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND;
+		timeTaken = timer.ElapsedTimeAsDouble();
 	}
 	while (timeTaken < 2.0/3*timeTotal);
 
@@ -98,7 +95,8 @@ void BenchMark(const char *name, StreamTransformation &cipher, double timeTotal)
 	const int BUF_SIZE=RoundUpToMultipleOf(2048U, cipher.OptimalBlockSize());
 	AlignedSecByteBlock buf(BUF_SIZE);
 	GlobalRNG().GenerateBlock(buf, BUF_SIZE);
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 
 	unsigned long i=0, blocks=1;
 	double timeTaken;
@@ -107,7 +105,7 @@ void BenchMark(const char *name, StreamTransformation &cipher, double timeTotal)
 		blocks *= 2;
 		for (; i<blocks; i++)
 			cipher.ProcessString(buf, BUF_SIZE);
-		timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND;
+		timeTaken = timer.ElapsedTimeAsDouble();
 	}
 	while (timeTaken < 2.0/3*timeTotal);
 
@@ -127,7 +125,8 @@ void BenchMark(const char *name, HashTransformation &ht, double timeTotal)
 	const int BUF_SIZE=2048U;
 	AlignedSecByteBlock buf(BUF_SIZE);
 	GlobalRNG().GenerateBlock(buf, BUF_SIZE);
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 
 	unsigned long i=0, blocks=1;
 	double timeTaken;
@@ -136,19 +135,42 @@ void BenchMark(const char *name, HashTransformation &ht, double timeTotal)
 		blocks *= 2;
 		for (; i<blocks; i++)
 			ht.Update(buf, BUF_SIZE);
-		timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND;
+		timeTaken = timer.ElapsedTimeAsDouble();
 	}
 	while (timeTaken < 2.0/3*timeTotal);
 
 	OutputResultBytes(name, double(blocks) * BUF_SIZE, timeTaken);
 }
 
+// hashes whole messages of the given length, so per message overhead and thread pool hand-off show up
+void BenchMarkMessageSize(HashTransformation &ht, const byte *buf, size_t length, double timeTotal)
+{
+	SecByteBlock digest(ht.DigestSize());
+	Timer timer;
+	timer.StartTimer();
+
+	unsigned long i=0, messages=1;
+	double timeTaken;
+	do
+	{
+		messages *= 2;
+		for (; i<messages; i++)
+			ht.CalculateDigest(digest, buf, length);
+		timeTaken = timer.ElapsedTimeAsDouble();
+	}
+	while (timeTaken < 2.0/3*timeTotal);
+
+	std::string name = ht.AlgorithmName() + " (" + IntToString(length) + " bytes)";
+	OutputResultBytes(name.c_str(), double(messages) * length, timeTaken);
+}
+
 void BenchMark(const char *name, BufferedTransformation &bt, double timeTotal)
 {
 	const int BUF_SIZE=2048U;
 	AlignedSecByteBlock buf(BUF_SIZE);
 	GlobalRNG().GenerateBlock(buf, BUF_SIZE);
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 
 	unsigned long i=0, blocks=1;
 	double timeTaken;
@@ -157,7 +179,7 @@ void BenchMark(const char *name, BufferedTransformation &bt, double timeTotal)
 		blocks *= 2;
 		for (; i<blocks; i++)
 			bt.Put(buf, BUF_SIZE);
-		timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND;
+		timeTaken = timer.ElapsedTimeAsDouble();
 	}
 	while (timeTaken < 2.0/3*timeTotal);
 
@@ -167,13 +189,14 @@ void BenchMark(const char *name, BufferedTransformation &bt, double timeTotal)
 void BenchMarkKeying(SimpleKeyingInterface &c, size_t keyLength, const NameValuePairs &params)
 {
 	unsigned long iterations = 0;
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	double timeTaken;
 	do
 	{
 		for (unsigned int i=0; i<1024; i++)
 			c.SetKey(key, keyLength, params);
-		timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND;
+		timeTaken = timer.ElapsedTimeAsDouble();
 		iterations += 1024;
 	}
 	while (timeTaken < g_allocatedTime);
@@ -254,6 +277,8 @@ void BenchmarkAll(double t, double hertz)
 	}
 	BenchMarkByName2<AuthenticatedSymmetricCipher, AuthenticatedSymmetricCipher>("AES/CCM");
 	BenchMarkByName2<AuthenticatedSymmetricCipher, AuthenticatedSymmetricCipher>("AES/EAX");
+	BenchMarkByName2<AuthenticatedSymmetricCipher, AuthenticatedSymmetricCipher>("AES/OCB");
+	BenchMarkByName2<AuthenticatedSymmetricCipher, AuthenticatedSymmetricCipher>("ChaCha20/Poly1305");
 
 	cout << "\n<TBODY style=\"background: white\">";
 #if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
@@ -271,6 +296,7 @@ void BenchmarkAll(double t, double hertz)
 	BenchMarkByName<MessageAuthenticationCode>("Two-Track-MAC");
 	BenchMarkByName<MessageAuthenticationCode>("CMAC(AES)");
 	BenchMarkByName<MessageAuthenticationCode>("DMAC(AES)");
+	BenchMarkByName<MessageAuthenticationCode>("Poly1305");
 
 	cout << "\n<TBODY style=\"background: yellow\">";
 	BenchMarkByNameKeyLess<HashTransformation>("CRC32");
@@ -296,6 +322,9 @@ void BenchmarkAll(double t, double hertz)
 	BenchMarkByName<SymmetricCipher>("Salsa20");
 	BenchMarkByName<SymmetricCipher>("Salsa20", 0, "Salsa20/12", MakeParameters(Name::Rounds(), 12));
 	BenchMarkByName<SymmetricCipher>("Salsa20", 0, "Salsa20/8", MakeParameters(Name::Rounds(), 8));
+	BenchMarkByName<SymmetricCipher>("ChaCha20");
+	BenchMarkByName<SymmetricCipher>("ChaCha20", 0, "ChaCha20/12", MakeParameters(Name::Rounds(), 12));
+	BenchMarkByName<SymmetricCipher>("ChaCha20", 0, "ChaCha20/8", MakeParameters(Name::Rounds(), 8));
 	BenchMarkByName<SymmetricCipher>("Sosemanuk");
 	BenchMarkByName<SymmetricCipher>("MARC4");
 	BenchMarkByName<SymmetricCipher>("SEAL-3.0-LE");
@@ -311,6 +340,8 @@ void BenchmarkAll(double t, double hertz)
 	BenchMarkByName<SymmetricCipher>("AES/OFB", 16);
 	BenchMarkByName<SymmetricCipher>("AES/CFB", 16);
 	BenchMarkByName<SymmetricCipher>("AES/ECB", 16);
+	BenchMarkByName<SymmetricCipher>("AES/XTS", 32, "AES/XTS (128-bit key)");
+	BenchMarkByName<SymmetricCipher>("AES/XTS", 64, "AES/XTS (256-bit key)");
 	BenchMarkByName<SymmetricCipher>("Camellia/CTR", 16);
 	BenchMarkByName<SymmetricCipher>("Camellia/CTR", 32);
 	BenchMarkByName<SymmetricCipher>("Twofish/CTR");
@@ -341,3 +372,35 @@ void BenchmarkAll(double t, double hertz)
 	cout << "\nTest ended at " << asctime(localtime(&endTime));
 #endif
 }
+
+void BenchmarkMessageSizes(double t, double hertz)
+{
+	logtotal = 0;
+	logcount = 0;
+	g_allocatedTime = t;
+	g_hertz = hertz;
+
+	const char *cpb = g_hertz ? "<TH>Cycles Per Byte" : "";
+	cout << "Worker threads available to the library: " << ThreadPool::GetGlobalPool().GetNumberThreads() << "\n";
+	cout << "Inputs of at least " << ThreadPool::GetGlobalPool().GetParallelThreshold() << " bytes are hashed in parallel.\n";
+
+	const size_t MAX_MESSAGE_SIZE = 16*1024*1024;
+	AlignedSecByteBlock buf(MAX_MESSAGE_SIZE);
+	GlobalRNG().GenerateBlock(buf, buf.size());
+
+	BLAKE2b blake2b(64);
+	BLAKE2bp blake2bp(64);
+	BLAKE2s blake2s(32);
+	BLAKE2sp blake2sp(32);
+	HashTransformation *const hashes[] = {&blake2b, &blake2bp, &blake2s, &blake2sp};
+
+	cout << "<TABLE border=1><COLGROUP><COL align=left><COL align=right><COL align=right>" << endl;
+	cout << "<THEAD><TR><TH>Algorithm<TH>MiB/Second" << cpb << endl;
+	for (unsigned int i=0; i<sizeof(hashes)/sizeof(hashes[0]); i++)
+	{
+		cout << "\n<TBODY style=\"background: " << (i%2 ? "white" : "yellow") << "\">";
+		for (size_t length=64; length<=MAX_MESSAGE_SIZE; length*=4)
+			BenchMarkMessageSize(*hashes[i], buf, length, t);
+	}
+	cout << "</TABLE>" << endl;
+}
@@ -2,10 +2,37 @@
 #define CRYPTOPP_BENCH_H
 
 #include "cryptlib.h"
+#include <string>
+#include <iosfwd>
 
-extern const double CLOCK_TICKS_PER_SECOND;
+//! settings of a machine readable benchmark run, see BenchmarkReport()
+struct BenchmarkSettings
+{
+	enum Format {CSV, JSON};
+
+	BenchmarkSettings()
+		: format(JSON), timePerMeasurement(0.25), warmUpTime(0.05), repetitions(7)
+		, minMessageSize(16), maxMessageSize(64*1024*1024), hertz(0) {}
+
+	Format format;
+	//! seconds spent in the timed samples of one measurement, split evenly between the repetitions
+	double timePerMeasurement;
+	//! seconds the operation runs untimed before each measurement
+	double warmUpTime;
+	//! number of timed samples, the reported percentiles are taken over these
+	unsigned int repetitions;
+	//! the message sizes go from minMessageSize to maxMessageSize in steps of 4
+	size_t minMessageSize, maxMessageSize;
+	//! CPU frequency, only used for cycle counts if there is no cycle counter
+	double hertz;
+	//! if not empty, only algorithms whose name contains this string are run
+	std::string filter;
+};
 
 void BenchmarkAll(double t, double hertz);
 void BenchmarkAll2(double t, double hertz);
+void BenchmarkMessageSizes(double t, double hertz);
+//! runs every registered hash, MAC, cipher, KDF, RNG and public key scheme and writes one record per measurement
+void BenchmarkReport(const BenchmarkSettings &settings, std::ostream &out);
 
 #endif
@@ -18,9 +18,11 @@
 #include "mqv.h"
 #include "xtrcrypt.h"
 #include "esign.h"
+#include "xed25519.h"
 #include "pssr.h"
 #include "oids.h"
 #include "randpool.h"
+#include "hrtimer.h"
 
 #include <time.h>
 #include <math.h>
@@ -38,10 +40,11 @@ void BenchMarkEncryption(const char *name, PK_Encryptor &key, double timeTotal,
 	SecByteBlock plaintext(len), ciphertext(key.CiphertextLength(len));
 	GlobalRNG().GenerateBlock(plaintext, len);
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i++)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i++)
 		key.Encrypt(GlobalRNG(), plaintext, len, ciphertext);
 
 	OutputResultOperations(name, "Encryption", pc, i, timeTaken);
@@ -61,10 +64,11 @@ void BenchMarkDecryption(const char *name, PK_Decryptor &priv, PK_Encryptor &pub
 	GlobalRNG().GenerateBlock(plaintext, len);
 	pub.Encrypt(GlobalRNG(), plaintext, len, ciphertext);
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i++)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i++)
 		priv.Decrypt(GlobalRNG(), ciphertext, ciphertext.size(), plaintext);
 
 	OutputResultOperations(name, "Decryption", false, i, timeTaken);
@@ -76,10 +80,11 @@ void BenchMarkSigning(const char *name, PK_Signer &key, double timeTotal, bool p
 	AlignedSecByteBlock message(len), signature(key.SignatureLength());
 	GlobalRNG().GenerateBlock(message, len);
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i++)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i++)
 		key.SignMessage(GlobalRNG(), message, len, signature);
 
 	OutputResultOperations(name, "Signature", pc, i, timeTaken);
@@ -98,10 +103,11 @@ void BenchMarkVerification(const char *name, const PK_Signer &priv, PK_Verifier
 	GlobalRNG().GenerateBlock(message, len);
 	priv.SignMessage(GlobalRNG(), message, len, signature);
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i++)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i++)
 		pub.VerifyMessage(message, len, signature, signature.size());
 
 	OutputResultOperations(name, "Verification", pc, i, timeTaken);
@@ -117,10 +123,11 @@ void BenchMarkKeyGen(const char *name, SimpleKeyAgreementDomain &d, double timeT
 {
 	SecByteBlock priv(d.PrivateKeyLength()), pub(d.PublicKeyLength());
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i++)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i++)
 		d.GenerateKeyPair(GlobalRNG(), priv, pub);
 
 	OutputResultOperations(name, "Key-Pair Generation", pc, i, timeTaken);
@@ -136,10 +143,11 @@ void BenchMarkKeyGen(const char *name, AuthenticatedKeyAgreementDomain &d, doubl
 {
 	SecByteBlock priv(d.EphemeralPrivateKeyLength()), pub(d.EphemeralPublicKeyLength());
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i++)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i++)
 		d.GenerateEphemeralKeyPair(GlobalRNG(), priv, pub);
 
 	OutputResultOperations(name, "Key-Pair Generation", pc, i, timeTaken);
@@ -159,10 +167,11 @@ void BenchMarkAgreement(const char *name, SimpleKeyAgreementDomain &d, double ti
 	d.GenerateKeyPair(GlobalRNG(), priv2, pub2);
 	SecByteBlock val(d.AgreedValueLength());
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i+=2)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i+=2)
 	{
 		d.Agree(val, priv1, pub2);
 		d.Agree(val, priv2, pub1);
@@ -183,10 +192,11 @@ void BenchMarkAgreement(const char *name, AuthenticatedKeyAgreementDomain &d, do
 	d.GenerateEphemeralKeyPair(GlobalRNG(), epriv2, epub2);
 	SecByteBlock val(d.AgreedValueLength());
 
-	clock_t start = clock();
+	Timer timer;
+	timer.StartTimer();
 	unsigned int i;
 	double timeTaken;
-	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = double(clock() - start) / CLOCK_TICKS_PER_SECOND, i+=2)
+	for (timeTaken=(double)0, i=0; timeTaken < timeTotal; timeTaken = timer.ElapsedTimeAsDouble(), i+=2)
 	{
 		d.Agree(val, spriv1, epriv1, spub2, epub2);
 		d.Agree(val, spriv2, epriv2, spub1, epub1);
@@ -296,6 +306,18 @@ void BenchmarkAll2(double t, double hertz)
 	}
 
 	cout << "<TBODY style=\"background: yellow\">" << endl;
+	{
+		x25519 x;
+		ed25519::Signer spriv(GlobalRNG());
+		ed25519::Verifier spub(spriv);
+
+		BenchMarkKeyGen("X25519", x, t);
+		BenchMarkAgreement("X25519", x, t);
+		BenchMarkSigning("Ed25519", spriv, t);
+		BenchMarkVerification("Ed25519", spriv, spub, t);
+	}
+
+	cout << "<TBODY style=\"background: white\">" << endl;
 	{
 		ECIES<EC2N>::Decryptor cpriv(GlobalRNG(), ASN1::sect233r1());
 		ECIES<EC2N>::Encryptor cpub(cpriv);
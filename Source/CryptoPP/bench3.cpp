@@ -0,0 +1,759 @@
+// bench3.cpp - machine readable benchmarks with warm-up, repetitions and message size sweeps
+
+#define _CRT_SECURE_NO_DEPRECATE
+
+#include "bench.h"
+#include "validate.h"
+#include "factory.h"
+#include "hrtimer.h"
+#include "threadpool.h"
+#include "files.h"
+#include "hex.h"
+#include "blake2b.h"
+#include "blake2s.h"
+#include "skein.h"
+#include "scrypt.h"
+#include "pwdbased.h"
+#include "Fortuna.h"
+#include "randpool.h"
+#include "rsa.h"
+#include "rw.h"
+#include "nr.h"
+#include "dsa.h"
+#include "esign.h"
+#include "dh.h"
+#include "eccrypto.h"
+#include "ecp.h"
+#include "ec2n.h"
+#include "oids.h"
+#include "pssr.h"
+
+#include <algorithm>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+#include <thread>
+#endif
+
+#if (CRYPTOPP_BOOL_X86 || CRYPTOPP_BOOL_X64) && (defined(_MSC_VER) || defined(__GNUC__))
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif
+#	define CRYPTOPP_BENCH_CYCLE_COUNTER
+#endif
+
+USING_NAMESPACE(CryptoPP)
+USING_NAMESPACE(std)
+
+namespace
+{
+
+// the time stamp counter runs at the nominal frequency, which matches core cycles unless turbo or power saving kicks in
+inline word64 CycleCount()
+{
+#ifdef CRYPTOPP_BENCH_CYCLE_COUNTER
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+//! one timed operation, Run() processes a message of length bytes
+class BenchmarkOperation
+{
+public:
+	virtual ~BenchmarkOperation() {}
+	virtual void Run(size_t length) =0;
+};
+
+//! the samples of one operation at one message size, all per operation and sorted
+struct Measurement
+{
+	std::string category, algorithm, operation;
+	size_t length;
+	bool throughput;	// false if the work doesn't scale with length, like key setup or public key operations
+	word64 iterations;
+	std::vector<double> seconds, cycles;
+};
+
+double Percentile(const std::vector<double> &sorted, double p)
+{
+	return sorted[size_t(p * (sorted.size()-1) + 0.5)];
+}
+
+class BenchmarkWriter
+{
+public:
+	BenchmarkWriter(const BenchmarkSettings &settings, std::ostream &out);
+	void Write(const Measurement &m);
+	void Finish();
+
+private:
+	void Field(const char *name, const std::string &value);
+	void Field(const char *name, double value, bool available=true);
+
+	const BenchmarkSettings &m_settings;
+	std::ostream &m_out;
+	bool m_firstRecord, m_firstField;
+};
+
+BenchmarkWriter::BenchmarkWriter(const BenchmarkSettings &settings, std::ostream &out)
+	: m_settings(settings), m_out(out), m_firstRecord(true), m_firstField(true)
+{
+	if (m_settings.format == BenchmarkSettings::CSV)
+	{
+		m_out << "category,algorithm,operation,bytes,iterations,samples,min_ns,median_ns,p90_ns,max_ns,mib_per_second,cycles_per_byte,cycles_per_operation" << endl;
+		return;
+	}
+
+	Timer timer;
+	m_out << "{\n\"timer_ticks_per_second\": " << timer.TicksPerSecond();
+#ifdef CRYPTOPP_BENCH_CYCLE_COUNTER
+	m_out << ",\n\"cycle_counter\": \"rdtsc\"";
+#else
+	m_out << ",\n\"cycle_counter\": " << (m_settings.hertz ? "\"hertz\"" : "null");
+#endif
+	m_out << ",\n\"hertz\": " << m_settings.hertz;
+	m_out << ",\n\"threads\": " << ThreadPool::GetGlobalPool().GetNumberThreads();
+	m_out << ",\n\"warm_up_seconds\": " << m_settings.warmUpTime;
+	m_out << ",\n\"seconds_per_measurement\": " << m_settings.timePerMeasurement;
+	m_out << ",\n\"repetitions\": " << m_settings.repetitions;
+	m_out << ",\n\"results\": [";
+}
+
+void BenchmarkWriter::Field(const char *name, const std::string &value)
+{
+	if (m_settings.format == BenchmarkSettings::CSV)
+	{
+		// algorithm names may contain commas, quotes are doubled
+		std::string quoted = "\"";
+		for (size_t i=0; i<value.size(); i++)
+			quoted += value[i] == '"' ? std::string("\"\"") : std::string(1, value[i]);
+		m_out << (m_firstField ? "" : ",") << quoted << "\"";
+	}
+	else
+	{
+		std::string escaped;
+		for (size_t i=0; i<value.size(); i++)
+		{
+			if (value[i] == '"' || value[i] == '\\')
+				escaped += '\\';
+			escaped += value[i];
+		}
+		m_out << (m_firstField ? "" : ", ") << "\"" << name << "\": \"" << escaped << "\"";
+	}
+	m_firstField = false;
+}
+
+void BenchmarkWriter::Field(const char *name, double value, bool available)
+{
+	m_out << (m_firstField ? "" : (m_settings.format == BenchmarkSettings::CSV ? "," : ", "));
+	if (m_settings.format == BenchmarkSettings::JSON)
+		m_out << "\"" << name << "\": ";
+	if (available)
+		m_out << setprecision(10) << value;
+	else if (m_settings.format == BenchmarkSettings::JSON)
+		m_out << "null";
+	m_firstField = false;
+}
+
+void BenchmarkWriter::Write(const Measurement &m)
+{
+	if (m_settings.format == BenchmarkSettings::JSON)
+		m_out << (m_firstRecord ? "\n{" : ",\n{");
+	m_firstRecord = false;
+	m_firstField = true;
+
+	const double median = Percentile(m.seconds, 0.5);
+	const bool haveCycles = !m.cycles.empty();
+	const double medianCycles = haveCycles ? Percentile(m.cycles, 0.5) : 0;
+
+	Field("category", m.category);
+	Field("algorithm", m.algorithm);
+	Field("operation", m.operation);
+	Field("bytes", (double)m.length);
+	Field("iterations", (double)m.iterations);
+	Field("samples", (double)m.seconds.size());
+	Field("min_ns", 1e9 * m.seconds.front());
+	Field("median_ns", 1e9 * median);
+	Field("p90_ns", 1e9 * Percentile(m.seconds, 0.9));
+	Field("max_ns", 1e9 * m.seconds.back());
+	Field("mib_per_second", m.length / median / (1024*1024), m.throughput && median > 0);
+	Field("cycles_per_byte", medianCycles / m.length, m.throughput && haveCycles);
+	Field("cycles_per_operation", medianCycles, haveCycles);
+
+	m_out << (m_settings.format == BenchmarkSettings::JSON ? "}" : "\n");
+	m_out.flush();
+}
+
+void BenchmarkWriter::Finish()
+{
+	if (m_settings.format == BenchmarkSettings::JSON)
+		m_out << "\n]\n}" << endl;
+}
+
+class BenchmarkRunner
+{
+public:
+	BenchmarkRunner(const BenchmarkSettings &settings, BenchmarkWriter &writer);
+
+	bool Selected(const std::string &algorithm) const
+		{return m_settings.filter.empty() || algorithm.find(m_settings.filter) != std::string::npos;}
+	void Measure(const std::string &category, const std::string &algorithm, const std::string &operation, BenchmarkOperation &op, size_t length, bool throughput);
+	//! measures all message sizes of the sweep that are a multiple of granularity
+	void Sweep(const std::string &category, const std::string &algorithm, const std::string &operation, BenchmarkOperation &op, size_t granularity=1);
+
+	byte * Buffer() {return m_buffer;}
+	const byte * Key() const {return m_key;}
+
+private:
+	const BenchmarkSettings &m_settings;
+	BenchmarkWriter &m_writer;
+	AlignedSecByteBlock m_buffer;
+	SecByteBlock m_key;
+};
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings &settings, BenchmarkWriter &writer)
+	: m_settings(settings), m_writer(writer), m_buffer(settings.maxMessageSize), m_key(256)
+{
+	GlobalRNG().GenerateBlock(m_buffer, m_buffer.size());
+	GlobalRNG().GenerateBlock(m_key, m_key.size());
+}
+
+void BenchmarkRunner::Measure(const std::string &category, const std::string &algorithm, const std::string &operation, BenchmarkOperation &op, size_t length, bool throughput)
+{
+	Timer timer;
+	const double ticksPerSecond = (double)timer.TicksPerSecond();
+
+	// the warm-up also tells how many runs fit into one sample
+	word64 runs = 0;
+	TimerWord start = timer.GetCurrentTimerValue(), now;
+	do
+	{
+		op.Run(length);
+		runs++;
+		now = timer.GetCurrentTimerValue();
+	}
+	while (now <= start || double(now - start) / ticksPerSecond < m_settings.warmUpTime);
+
+	Measurement m;
+	m.category = category;
+	m.algorithm = algorithm;
+	m.operation = operation;
+	m.length = length;
+	m.throughput = throughput;
+	m.iterations = STDMAX(word64(1), word64(m_settings.timePerMeasurement / m_settings.repetitions * runs * ticksPerSecond / double(now - start)));
+
+	for (unsigned int i=0; i<m_settings.repetitions; i++)
+	{
+		const word64 cycleStart = CycleCount();
+		start = timer.GetCurrentTimerValue();
+		for (word64 j=0; j<m.iterations; j++)
+			op.Run(length);
+		now = timer.GetCurrentTimerValue();
+		const double cycles = double(CycleCount() - cycleStart);
+
+		const double seconds = double(now - start) / ticksPerSecond / m.iterations;
+		m.seconds.push_back(seconds);
+#ifdef CRYPTOPP_BENCH_CYCLE_COUNTER
+		m.cycles.push_back(cycles / m.iterations);
+#else
+		if (m_settings.hertz)
+			m.cycles.push_back(seconds * m_settings.hertz);
+#endif
+	}
+	std::sort(m.seconds.begin(), m.seconds.end());
+	std::sort(m.cycles.begin(), m.cycles.end());
+
+	m_writer.Write(m);
+}
+
+void BenchmarkRunner::Sweep(const std::string &category, const std::string &algorithm, const std::string &operation, BenchmarkOperation &op, size_t granularity)
+{
+	for (size_t length=m_settings.minMessageSize; length<=m_settings.maxMessageSize; length*=4)
+	{
+		if (length % granularity == 0)
+			Measure(category, algorithm, operation, op, length, true);
+		if (length > m_settings.maxMessageSize/4)
+			break;
+	}
+}
+
+class HashOperation : public BenchmarkOperation
+{
+public:
+	HashOperation(HashTransformation &ht, const byte *buf) : m_ht(ht), m_buf(buf), m_digest(ht.DigestSize()) {}
+	void Run(size_t length) {m_ht.CalculateDigest(m_digest, m_buf, length);}
+private:
+	HashTransformation &m_ht;
+	const byte *m_buf;
+	SecByteBlock m_digest;
+};
+
+class CipherOperation : public BenchmarkOperation
+{
+public:
+	CipherOperation(StreamTransformation &cipher, byte *buf) : m_cipher(cipher), m_buf(buf) {}
+	void Run(size_t length) {m_cipher.ProcessString(m_buf, length);}
+private:
+	StreamTransformation &m_cipher;
+	byte *m_buf;
+};
+
+//! encrypts and authenticates whole messages, including resynchronization and the tag
+class AuthenticatedCipherOperation : public BenchmarkOperation
+{
+public:
+	AuthenticatedCipherOperation(AuthenticatedSymmetricCipher &cipher, byte *buf, const byte *iv)
+		: m_cipher(cipher), m_buf(buf), m_iv(iv), m_tag(cipher.DigestSize()) {}
+	void Run(size_t length)
+	{
+		m_cipher.Resynchronize(m_iv, m_cipher.IVSize());
+		if (m_cipher.NeedsPrespecifiedDataLengths())
+			m_cipher.SpecifyDataLengths(0, length, 0);
+		m_cipher.ProcessString(m_buf, length);
+		m_cipher.TruncatedFinal(m_tag, m_tag.size());
+	}
+private:
+	AuthenticatedSymmetricCipher &m_cipher;
+	byte *m_buf;
+	const byte *m_iv;
+	SecByteBlock m_tag;
+};
+
+class KeyingOperation : public BenchmarkOperation
+{
+public:
+	KeyingOperation(SimpleKeyingInterface &object, const byte *key, size_t keyLength)
+		: m_object(object), m_key(key), m_keyLength(keyLength)
+		, m_params(MakeParameters(Name::IV(), ConstByteArrayParameter(key, object.IVSize()), false)) {}
+	void Run(size_t) {m_object.SetKey(m_key, m_keyLength, m_params);}
+private:
+	SimpleKeyingInterface &m_object;
+	const byte *m_key;
+	size_t m_keyLength;
+	AlgorithmParameters m_params;
+};
+
+class RandomOperation : public BenchmarkOperation
+{
+public:
+	RandomOperation(RandomNumberGenerator &rng, byte *buf) : m_rng(rng), m_buf(buf) {}
+	void Run(size_t length) {m_rng.GenerateBlock(m_buf, length);}
+private:
+	RandomNumberGenerator &m_rng;
+	byte *m_buf;
+};
+
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+//! threads that draw small nonces from one shared generator, Run() splits length bytes evenly between them
+class ContendedRandomOperation : public BenchmarkOperation
+{
+public:
+	ContendedRandomOperation(RandomNumberGenerator &rng, unsigned int threads, size_t nonceSize)
+		: m_rng(rng), m_threads(threads), m_nonceSize(nonceSize) {}
+	void Run(size_t length)
+	{
+		std::vector<std::thread> threads;
+		for (unsigned int i=0; i<m_threads; i++)
+			threads.push_back(std::thread(&ContendedRandomOperation::Worker, this, length/m_threads/m_nonceSize));
+		for (unsigned int i=0; i<m_threads; i++)
+			threads[i].join();
+	}
+private:
+	void Worker(size_t nonces)
+	{
+		SecByteBlock nonce(m_nonceSize);
+		for (size_t i=0; i<nonces; i++)
+			m_rng.GenerateBlock(nonce, nonce.size());
+	}
+	RandomNumberGenerator &m_rng;
+	unsigned int m_threads;
+	size_t m_nonceSize;
+};
+#endif
+
+//! derives length bytes from an 8 byte password and a 16 byte salt
+class KeyDerivationOperation : public BenchmarkOperation
+{
+public:
+	KeyDerivationOperation(const PasswordBasedKeyDerivationFunction &kdf, const byte *key, word64 tCost, word64 mCost)
+		: m_kdf(kdf), m_key(key), m_tCost(tCost), m_mCost(mCost) {}
+	void Run(size_t length)
+	{
+		SecByteBlock derived(length);
+		m_kdf.DeriveKey(derived, length, m_key, 8, m_key+8, 16, m_tCost, m_mCost);
+	}
+private:
+	const PasswordBasedKeyDerivationFunction &m_kdf;
+	const byte *m_key;
+	word64 m_tCost, m_mCost;
+};
+
+class SignOperation : public BenchmarkOperation
+{
+public:
+	SignOperation(const PK_Signer &signer, const byte *message) : m_signer(signer), m_message(message), m_signature(signer.SignatureLength()) {}
+	void Run(size_t length) {m_signer.SignMessage(GlobalRNG(), m_message, length, m_signature);}
+private:
+	const PK_Signer &m_signer;
+	const byte *m_message;
+	SecByteBlock m_signature;
+};
+
+class VerifyOperation : public BenchmarkOperation
+{
+public:
+	VerifyOperation(const PK_Signer &signer, const PK_Verifier &verifier, const byte *message, size_t length)
+		: m_verifier(verifier), m_message(message), m_signature(signer.SignatureLength())
+		{m_signature.resize(signer.SignMessage(GlobalRNG(), message, length, m_signature));}
+	void Run(size_t length)
+	{
+		if (!m_verifier.VerifyMessage(m_message, length, m_signature, m_signature.size()))
+			throw Exception(Exception::OTHER_ERROR, m_verifier.AlgorithmName() + ": benchmark signature did not verify");
+	}
+private:
+	const PK_Verifier &m_verifier;
+	const byte *m_message;
+	SecByteBlock m_signature;
+};
+
+class EncryptOperation : public BenchmarkOperation
+{
+public:
+	EncryptOperation(const PK_Encryptor &encryptor, const byte *message) : m_encryptor(encryptor), m_message(message) {}
+	void Run(size_t length)
+	{
+		m_ciphertext.resize(m_encryptor.CiphertextLength(length));
+		m_encryptor.Encrypt(GlobalRNG(), m_message, length, m_ciphertext);
+	}
+private:
+	const PK_Encryptor &m_encryptor;
+	const byte *m_message;
+	SecByteBlock m_ciphertext;
+};
+
+class DecryptOperation : public BenchmarkOperation
+{
+public:
+	DecryptOperation(const PK_Decryptor &decryptor, const PK_Encryptor &encryptor, const byte *message, size_t length)
+		: m_decryptor(decryptor), m_ciphertext(encryptor.CiphertextLength(length)), m_plaintext(length)
+		{encryptor.Encrypt(GlobalRNG(), message, length, m_ciphertext);}
+	void Run(size_t)
+	{
+		if (!m_decryptor.Decrypt(GlobalRNG(), m_ciphertext, m_ciphertext.size(), m_plaintext).isValidCoding)
+			throw Exception(Exception::OTHER_ERROR, m_decryptor.AlgorithmName() + ": benchmark ciphertext did not decrypt");
+	}
+private:
+	const PK_Decryptor &m_decryptor;
+	SecByteBlock m_ciphertext, m_plaintext;
+};
+
+class KeyPairOperation : public BenchmarkOperation
+{
+public:
+	KeyPairOperation(const SimpleKeyAgreementDomain &domain)
+		: m_domain(domain), m_private(domain.PrivateKeyLength()), m_public(domain.PublicKeyLength()) {}
+	void Run(size_t) {m_domain.GenerateKeyPair(GlobalRNG(), m_private, m_public);}
+private:
+	const SimpleKeyAgreementDomain &m_domain;
+	SecByteBlock m_private, m_public;
+};
+
+class AgreeOperation : public BenchmarkOperation
+{
+public:
+	AgreeOperation(const SimpleKeyAgreementDomain &domain)
+		: m_domain(domain), m_private(domain.PrivateKeyLength()), m_public(domain.PublicKeyLength()), m_value(domain.AgreedValueLength())
+	{
+		// m_public ends up holding the other party's key
+		SecByteBlock otherPrivate(domain.PrivateKeyLength());
+		domain.GenerateKeyPair(GlobalRNG(), m_private, m_public);
+		domain.GenerateKeyPair(GlobalRNG(), otherPrivate, m_public);
+	}
+	void Run(size_t) {m_domain.Agree(m_value, m_private, m_public);}
+private:
+	const SimpleKeyAgreementDomain &m_domain;
+	SecByteBlock m_private, m_public, m_value;
+};
+
+// public key operations work on this many bytes
+static const size_t PK_MESSAGE_LENGTH = 16;
+
+void BenchmarkHash(BenchmarkRunner &runner, const char *category, const std::string &name, HashTransformation &ht)
+{
+	HashOperation op(ht, runner.Buffer());
+	runner.Sweep(category, name, "digest", op);
+}
+
+void BenchmarkKeying(BenchmarkRunner &runner, const char *category, const std::string &name, SimpleKeyingInterface &object)
+{
+	KeyingOperation op(object, runner.Key(), object.DefaultKeyLength());
+	runner.Measure(category, name, "key setup", op, object.DefaultKeyLength(), false);
+}
+
+void BenchmarkSigner(BenchmarkRunner &runner, const std::string &name, const PK_Signer &signer, const PK_Verifier &verifier)
+{
+	if (!runner.Selected(name))
+		return;
+	SignOperation sign(signer, runner.Buffer());
+	runner.Measure("public key", name, "sign", sign, PK_MESSAGE_LENGTH, false);
+	VerifyOperation verify(signer, verifier, runner.Buffer(), PK_MESSAGE_LENGTH);
+	runner.Measure("public key", name, "verify", verify, PK_MESSAGE_LENGTH, false);
+}
+
+void BenchmarkEncryptor(BenchmarkRunner &runner, const std::string &name, const PK_Decryptor &decryptor, const PK_Encryptor &encryptor)
+{
+	if (!runner.Selected(name))
+		return;
+	EncryptOperation encrypt(encryptor, runner.Buffer());
+	runner.Measure("public key", name, "encrypt", encrypt, PK_MESSAGE_LENGTH, false);
+	DecryptOperation decrypt(decryptor, encryptor, runner.Buffer(), PK_MESSAGE_LENGTH);
+	runner.Measure("public key", name, "decrypt", decrypt, PK_MESSAGE_LENGTH, false);
+}
+
+void BenchmarkAgreement(BenchmarkRunner &runner, const std::string &name, const SimpleKeyAgreementDomain &domain)
+{
+	if (!runner.Selected(name))
+		return;
+	KeyPairOperation keyPair(domain);
+	runner.Measure("public key", name, "key pair generation", keyPair, domain.PublicKeyLength(), false);
+	AgreeOperation agree(domain);
+	runner.Measure("public key", name, "key agreement", agree, domain.AgreedValueLength(), false);
+}
+
+//VC60 workaround: compiler bug triggered without the extra dummy parameters
+template <class SCHEME>
+void BenchmarkEncryptionScheme(BenchmarkRunner &runner, const char *filename, const char *name, SCHEME *x=NULL)
+{
+	if (!runner.Selected(name))
+		return;
+	FileSource f(filename, true, new HexDecoder());
+	typename SCHEME::Decryptor priv(f);
+	typename SCHEME::Encryptor pub(priv);
+	BenchmarkEncryptor(runner, name, priv, pub);
+}
+
+//VC60 workaround: compiler bug triggered without the extra dummy parameters
+template <class SCHEME>
+void BenchmarkSignatureScheme(BenchmarkRunner &runner, const char *filename, const char *name, SCHEME *x=NULL)
+{
+	if (!runner.Selected(name))
+		return;
+	FileSource f(filename, true, new HexDecoder());
+	typename SCHEME::Signer priv(f);
+	typename SCHEME::Verifier pub(priv);
+	BenchmarkSigner(runner, name, priv, pub);
+}
+
+//VC60 workaround: compiler bug triggered without the extra dummy parameters
+template <class EC>
+void BenchmarkEllipticCurve(BenchmarkRunner &runner, const OID &curve, const char *name, EC *x=NULL)
+{
+	if (!runner.Selected(std::string("ECIES ") + name) && !runner.Selected(std::string("ECDSA ") + name) && !runner.Selected(std::string("ECDH ") + name))
+		return;
+	typename ECIES<EC>::Decryptor cpriv(GlobalRNG(), curve);
+	typename ECIES<EC>::Encryptor cpub(cpriv);
+	typename ECDSA<EC, SHA256>::Signer spriv(cpriv);
+	typename ECDSA<EC, SHA256>::Verifier spub(spriv);
+	typename ECDH<EC>::Domain ecdh(curve);
+
+	BenchmarkEncryptor(runner, std::string("ECIES ") + name, cpriv, cpub);
+	BenchmarkSigner(runner, std::string("ECDSA ") + name, spriv, spub);
+	BenchmarkAgreement(runner, std::string("ECDH ") + name, ecdh);
+}
+
+//! runs f and reports an algorithm that throws instead of aborting the whole run
+template <class F>
+void Guarded(const std::string &name, F f, BenchmarkRunner &runner)
+{
+	try
+	{
+		f(runner, name);
+	}
+	catch (const Exception &e)
+	{
+		cerr << "skipped " << name << ": " << e.what() << endl;
+	}
+}
+
+void RegisteredHash(BenchmarkRunner &runner, const std::string &name)
+{
+	std::auto_ptr<HashTransformation> ht(ObjectFactoryRegistry<HashTransformation>::Registry().CreateObject(name.c_str()));
+	BenchmarkHash(runner, "hash", name, *ht);
+}
+
+void RegisteredMAC(BenchmarkRunner &runner, const std::string &name)
+{
+	std::auto_ptr<MessageAuthenticationCode> mac(ObjectFactoryRegistry<MessageAuthenticationCode>::Registry().CreateObject(name.c_str()));
+	BenchmarkKeying(runner, "mac", name, *mac);
+	BenchmarkHash(runner, "mac", name, *mac);
+}
+
+void RegisteredCipher(BenchmarkRunner &runner, const std::string &name)
+{
+	std::auto_ptr<SymmetricCipher> cipher(ObjectFactoryRegistry<SymmetricCipher, ENCRYPTION>::Registry().CreateObject(name.c_str()));
+	BenchmarkKeying(runner, "cipher", name, *cipher);
+	CipherOperation op(*cipher, runner.Buffer());
+	runner.Sweep("cipher", name, "encrypt", op, cipher->MandatoryBlockSize());
+}
+
+void RegisteredAuthenticatedCipher(BenchmarkRunner &runner, const std::string &name)
+{
+	std::auto_ptr<AuthenticatedSymmetricCipher> cipher(ObjectFactoryRegistry<AuthenticatedSymmetricCipher, ENCRYPTION>::Registry().CreateObject(name.c_str()));
+	BenchmarkKeying(runner, "authenticated cipher", name, *cipher);
+	AuthenticatedCipherOperation op(*cipher, runner.Buffer(), runner.Key());
+	runner.Sweep("authenticated cipher", name, "encrypt and authenticate", op, cipher->MandatoryBlockSize());
+}
+
+template <class ABSTRACT, int instance>
+void BenchmarkRegistry(BenchmarkRunner &runner, void (*f)(BenchmarkRunner &, const std::string &), ABSTRACT *x=NULL)
+{
+	const std::vector<std::string> names = ObjectFactoryRegistry<ABSTRACT, instance>::Registry().GetFactoryNames();
+	for (size_t i=0; i<names.size(); i++)
+		if (runner.Selected(names[i]))
+			Guarded(names[i], f, runner);
+}
+
+// the fork's algorithms that have no default constructor and thus aren't in the factory registry
+void UnregisteredHashes(BenchmarkRunner &runner, const std::string &)
+{
+	BLAKE2b blake2b(64);
+	BLAKE2bp blake2bp(64);
+	BLAKE2s blake2s(32);
+	BLAKE2sp blake2sp(32);
+	Skein skein256(32, 32), skein1024(128, 128);
+	SkeinTree skeinTree(64, 7, 2, 255, 64);
+	HashTransformation *const hashes[] = {&blake2b, &blake2bp, &blake2s, &blake2sp, &skein256, &skein1024, &skeinTree};
+
+	for (unsigned int i=0; i<sizeof(hashes)/sizeof(hashes[0]); i++)
+		if (runner.Selected(hashes[i]->AlgorithmName()))
+			BenchmarkHash(runner, "hash", hashes[i]->AlgorithmName(), *hashes[i]);
+
+	BLAKE2bMAC blake2bMAC(64, runner.Key(), 64);
+	BLAKE2sMAC blake2sMAC(32, runner.Key(), 32);
+	SkeinMAC skeinMAC(runner.Key(), 64, 64);
+	HashTransformation *const macs[] = {&blake2bMAC, &blake2sMAC, &skeinMAC};
+
+	for (unsigned int i=0; i<sizeof(macs)/sizeof(macs[0]); i++)
+		if (runner.Selected(macs[i]->AlgorithmName()))
+			BenchmarkHash(runner, "mac", macs[i]->AlgorithmName(), *macs[i]);
+}
+
+void KeyDerivationFunctions(BenchmarkRunner &runner, const std::string &)
+{
+	PKCS5_PBKDF2_HMAC<SHA1> pbkdf2sha1;
+	PKCS5_PBKDF2_HMAC<SHA256> pbkdf2sha256;
+	scrypt<SHA256> scryptsha256;
+
+	struct {const char *name, *operation; const PasswordBasedKeyDerivationFunction *kdf; word64 tCost, mCost;} const kdfs[] = {
+		{"PBKDF2-HMAC(SHA-1)", "derive (1000 iterations)", &pbkdf2sha1, 1000, 0},
+		{"PBKDF2-HMAC(SHA-256)", "derive (1000 iterations)", &pbkdf2sha256, 1000, 0},
+		{"scrypt(SHA-256)", "derive (N=2^14, r=8, p=1)", &scryptsha256, 1, 14},
+		{"scrypt(SHA-256)", "derive (N=2^14, r=8, p=4)", &scryptsha256, 4, 14},
+	};
+
+	for (unsigned int i=0; i<sizeof(kdfs)/sizeof(kdfs[0]); i++)
+	{
+		if (!runner.Selected(kdfs[i].name))
+			continue;
+		KeyDerivationOperation op(*kdfs[i].kdf, runner.Key(), kdfs[i].tCost, kdfs[i].mCost);
+		runner.Measure("kdf", kdfs[i].name, kdfs[i].operation, op, 32, false);
+	}
+}
+
+void RandomNumberGenerators(BenchmarkRunner &runner, const std::string &)
+{
+	OriginalFortuna fortuna;
+	RandomPool randomPool;
+	// Fortuna needs 64 bytes in its first pool before it produces output
+	for (unsigned int i=0; i<2*Fortuna_Base::NUM_POOLS; i++)
+		fortuna.IncorporateEntropy(runner.Key()+i%8*32, 32);
+	randomPool.IncorporateEntropy(runner.Key(), 32);
+
+	if (runner.Selected("Fortuna"))
+	{
+		RandomOperation op(fortuna, runner.Buffer());
+		runner.Sweep("rng", "Fortuna", "generate", op);
+	}
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	// aggregate throughput of many threads asking one generator for 16 byte nonces
+	if (runner.Selected("Fortuna"))
+	{
+		const size_t nonceSize = 16, noncesPerThread = 1024;
+		for (unsigned int threads=1; threads<=128; threads*=2)
+		{
+			ContendedRandomOperation op(fortuna, threads, nonceSize);
+			runner.Measure("rng", "Fortuna", "nonces on " + IntToString(threads) + " threads", op, threads*noncesPerThread*nonceSize, true);
+		}
+	}
+#endif
+	if (runner.Selected("RandomPool"))
+	{
+		RandomOperation op(randomPool, runner.Buffer());
+		runner.Sweep("rng", "RandomPool", "generate", op);
+	}
+}
+
+void PublicKeySchemes(BenchmarkRunner &runner, const std::string &)
+{
+	BenchmarkEncryptionScheme<RSAES<OAEP<SHA> > >(runner, "TestData/rsa1024.dat", "RSA 1024");
+	BenchmarkEncryptionScheme<RSAES<OAEP<SHA> > >(runner, "TestData/rsa2048.dat", "RSA 2048");
+	BenchmarkEncryptionScheme<DLIES<> >(runner, "TestData/dlie1024.dat", "DLIES 1024");
+	BenchmarkEncryptionScheme<DLIES<> >(runner, "TestData/dlie2048.dat", "DLIES 2048");
+
+	BenchmarkSignatureScheme<RSASS<PSSR, SHA> >(runner, "TestData/rsa1024.dat", "RSA-PSS 1024");
+	BenchmarkSignatureScheme<RSASS<PSSR, SHA> >(runner, "TestData/rsa2048.dat", "RSA-PSS 2048");
+	BenchmarkSignatureScheme<RWSS<PSSR, SHA> >(runner, "TestData/rw1024.dat", "RW 1024");
+	BenchmarkSignatureScheme<RWSS<PSSR, SHA> >(runner, "TestData/rw2048.dat", "RW 2048");
+	BenchmarkSignatureScheme<NR<SHA> >(runner, "TestData/nr1024.dat", "NR 1024");
+	BenchmarkSignatureScheme<NR<SHA> >(runner, "TestData/nr2048.dat", "NR 2048");
+	BenchmarkSignatureScheme<DSA>(runner, "TestData/dsa1024.dat", "DSA 1024");
+	BenchmarkSignatureScheme<ESIGN<SHA> >(runner, "TestData/esig1023.dat", "ESIGN 1023");
+	BenchmarkSignatureScheme<ESIGN<SHA> >(runner, "TestData/esig2046.dat", "ESIGN 2046");
+
+	if (runner.Selected("DH 1024"))
+	{
+		FileSource f("TestData/dh1024.dat", true, new HexDecoder());
+		DH dh(f);
+		BenchmarkAgreement(runner, "DH 1024", dh);
+	}
+	if (runner.Selected("DH 2048"))
+	{
+		FileSource f("TestData/dh2048.dat", true, new HexDecoder());
+		DH dh(f);
+		BenchmarkAgreement(runner, "DH 2048", dh);
+	}
+
+	BenchmarkEllipticCurve<ECP>(runner, ASN1::secp256r1(), "P-256");
+	BenchmarkEllipticCurve<ECP>(runner, ASN1::secp384r1(), "P-384");
+	BenchmarkEllipticCurve<ECP>(runner, ASN1::secp256k1(), "secp256k1");
+	BenchmarkEllipticCurve<EC2N>(runner, ASN1::sect233r1(), "sect233r1");
+}
+
+}
+
+void BenchmarkReport(const BenchmarkSettings &settings, std::ostream &out)
+{
+	if (settings.repetitions == 0)
+		throw InvalidArgument("BenchmarkReport: at least one repetition is needed");
+	if (settings.minMessageSize == 0 || settings.minMessageSize > settings.maxMessageSize)
+		throw InvalidArgument("BenchmarkReport: invalid range of message sizes");
+
+	BenchmarkWriter writer(settings, out);
+	BenchmarkRunner runner(settings, writer);
+
+	BenchmarkRegistry<HashTransformation, 0>(runner, &RegisteredHash);
+	BenchmarkRegistry<MessageAuthenticationCode, 0>(runner, &RegisteredMAC);
+	Guarded("BLAKE2 and Skein", &UnregisteredHashes, runner);
+	BenchmarkRegistry<SymmetricCipher, ENCRYPTION>(runner, &RegisteredCipher);
+	BenchmarkRegistry<AuthenticatedSymmetricCipher, ENCRYPTION>(runner, &RegisteredAuthenticatedCipher);
+	Guarded("key derivation functions", &KeyDerivationFunctions, runner);
+	Guarded("random number generators", &RandomNumberGenerators, runner);
+	Guarded("public key schemes", &PublicKeySchemes, runner);
+
+	writer.Finish();
+}
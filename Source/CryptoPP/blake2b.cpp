@@ -5,165 +5,7 @@
 #include "pch.h"
 #include "blake2b.h"
 #include "cpu.h"
-#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-#include <thread>
-#endif
-
-#if CRYPTOPP_BOOL_X86
-#define DISABLE_SSE_LOCALLY
-#endif
-
-#if defined(_MSC_VER) && CRYPTOPP_BOOL_X86
-#define _mm_set_epi64x(x,y) _mm_setr_epi32(((int*)(&(x)))[0],((int*)(&(x)))[1],((int*)(&(y)))[0],((int*)(&(y)))[1])
-//#define _mm_set_epi64x(x,y) _mm_set_epi32(((int*)(&(y)))[0],((int*)(&(y)))[1],((int*)(&(x)))[0],((int*)(&(x)))[1])
-#endif
-
-#define LOAD_MSG_0_1(b0, b1) b0 = _mm_set_epi64x(m2, m0); b1 = _mm_set_epi64x(m6, m4)
-#define LOAD_MSG_0_2(b0, b1) b0 = _mm_set_epi64x(m3, m1); b1 = _mm_set_epi64x(m7, m5)
-#define LOAD_MSG_0_3(b0, b1) b0 = _mm_set_epi64x(m10, m8); b1 = _mm_set_epi64x(m14, m12)
-#define LOAD_MSG_0_4(b0, b1) b0 = _mm_set_epi64x(m11, m9); b1 = _mm_set_epi64x(m15, m13)
-#define LOAD_MSG_1_1(b0, b1) b0 = _mm_set_epi64x(m4, m14); b1 = _mm_set_epi64x(m13, m9)
-#define LOAD_MSG_1_2(b0, b1) b0 = _mm_set_epi64x(m8, m10); b1 = _mm_set_epi64x(m6, m15)
-#define LOAD_MSG_1_3(b0, b1) b0 = _mm_set_epi64x(m0, m1); b1 = _mm_set_epi64x(m5, m11)
-#define LOAD_MSG_1_4(b0, b1) b0 = _mm_set_epi64x(m2, m12); b1 = _mm_set_epi64x(m3, m7)
-#define LOAD_MSG_2_1(b0, b1) b0 = _mm_set_epi64x(m12, m11); b1 = _mm_set_epi64x(m15, m5)
-#define LOAD_MSG_2_2(b0, b1) b0 = _mm_set_epi64x(m0, m8); b1 = _mm_set_epi64x(m13, m2)
-#define LOAD_MSG_2_3(b0, b1) b0 = _mm_set_epi64x(m3, m10); b1 = _mm_set_epi64x(m9, m7)
-#define LOAD_MSG_2_4(b0, b1) b0 = _mm_set_epi64x(m6, m14); b1 = _mm_set_epi64x(m4, m1)
-#define LOAD_MSG_3_1(b0, b1) b0 = _mm_set_epi64x(m3, m7); b1 = _mm_set_epi64x(m11, m13)
-#define LOAD_MSG_3_2(b0, b1) b0 = _mm_set_epi64x(m1, m9); b1 = _mm_set_epi64x(m14, m12)
-#define LOAD_MSG_3_3(b0, b1) b0 = _mm_set_epi64x(m5, m2); b1 = _mm_set_epi64x(m15, m4)
-#define LOAD_MSG_3_4(b0, b1) b0 = _mm_set_epi64x(m10, m6); b1 = _mm_set_epi64x(m8, m0)
-#define LOAD_MSG_4_1(b0, b1) b0 = _mm_set_epi64x(m5, m9); b1 = _mm_set_epi64x(m10, m2)
-#define LOAD_MSG_4_2(b0, b1) b0 = _mm_set_epi64x(m7, m0); b1 = _mm_set_epi64x(m15, m4)
-#define LOAD_MSG_4_3(b0, b1) b0 = _mm_set_epi64x(m11, m14); b1 = _mm_set_epi64x(m3, m6)
-#define LOAD_MSG_4_4(b0, b1) b0 = _mm_set_epi64x(m12, m1); b1 = _mm_set_epi64x(m13, m8)
-#define LOAD_MSG_5_1(b0, b1) b0 = _mm_set_epi64x(m6, m2); b1 = _mm_set_epi64x(m8, m0)
-#define LOAD_MSG_5_2(b0, b1) b0 = _mm_set_epi64x(m10, m12); b1 = _mm_set_epi64x(m3, m11)
-#define LOAD_MSG_5_3(b0, b1) b0 = _mm_set_epi64x(m7, m4); b1 = _mm_set_epi64x(m1, m15)
-#define LOAD_MSG_5_4(b0, b1) b0 = _mm_set_epi64x(m5, m13); b1 = _mm_set_epi64x(m9, m14)
-#define LOAD_MSG_6_1(b0, b1) b0 = _mm_set_epi64x(m1, m12); b1 = _mm_set_epi64x(m4, m14)
-#define LOAD_MSG_6_2(b0, b1) b0 = _mm_set_epi64x(m15, m5); b1 = _mm_set_epi64x(m10, m13)
-#define LOAD_MSG_6_3(b0, b1) b0 = _mm_set_epi64x(m6, m0); b1 = _mm_set_epi64x(m8, m9)
-#define LOAD_MSG_6_4(b0, b1) b0 = _mm_set_epi64x(m3, m7); b1 = _mm_set_epi64x(m11, m2)
-#define LOAD_MSG_7_1(b0, b1) b0 = _mm_set_epi64x(m7, m13); b1 = _mm_set_epi64x(m3, m12)
-#define LOAD_MSG_7_2(b0, b1) b0 = _mm_set_epi64x(m14, m11); b1 = _mm_set_epi64x(m9, m1)
-#define LOAD_MSG_7_3(b0, b1) b0 = _mm_set_epi64x(m15, m5); b1 = _mm_set_epi64x(m2, m8)
-#define LOAD_MSG_7_4(b0, b1) b0 = _mm_set_epi64x(m4, m0); b1 = _mm_set_epi64x(m10, m6)
-#define LOAD_MSG_8_1(b0, b1) b0 = _mm_set_epi64x(m14, m6); b1 = _mm_set_epi64x(m0, m11)
-#define LOAD_MSG_8_2(b0, b1) b0 = _mm_set_epi64x(m9, m15); b1 = _mm_set_epi64x(m8, m3)
-#define LOAD_MSG_8_3(b0, b1) b0 = _mm_set_epi64x(m13, m12); b1 = _mm_set_epi64x(m10, m1)
-#define LOAD_MSG_8_4(b0, b1) b0 = _mm_set_epi64x(m7, m2); b1 = _mm_set_epi64x(m5, m4)
-#define LOAD_MSG_9_1(b0, b1) b0 = _mm_set_epi64x(m8, m10); b1 = _mm_set_epi64x(m1, m7)
-#define LOAD_MSG_9_2(b0, b1) b0 = _mm_set_epi64x(m4, m2); b1 = _mm_set_epi64x(m5, m6)
-#define LOAD_MSG_9_3(b0, b1) b0 = _mm_set_epi64x(m9, m15); b1 = _mm_set_epi64x(m13, m3)
-#define LOAD_MSG_9_4(b0, b1) b0 = _mm_set_epi64x(m14, m11); b1 = _mm_set_epi64x(m0, m12)
-#define LOAD_MSG_10_1(b0, b1) b0 = _mm_set_epi64x(m2, m0); b1 = _mm_set_epi64x(m6, m4)
-#define LOAD_MSG_10_2(b0, b1) b0 = _mm_set_epi64x(m3, m1); b1 = _mm_set_epi64x(m7, m5)
-#define LOAD_MSG_10_3(b0, b1) b0 = _mm_set_epi64x(m10, m8); b1 = _mm_set_epi64x(m14, m12)
-#define LOAD_MSG_10_4(b0, b1) b0 = _mm_set_epi64x(m11, m9); b1 = _mm_set_epi64x(m15, m13)
-#define LOAD_MSG_11_1(b0, b1) b0 = _mm_set_epi64x(m4, m14); b1 = _mm_set_epi64x(m13, m9)
-#define LOAD_MSG_11_2(b0, b1) b0 = _mm_set_epi64x(m8, m10); b1 = _mm_set_epi64x(m6, m15)
-#define LOAD_MSG_11_3(b0, b1) b0 = _mm_set_epi64x(m0, m1); b1 = _mm_set_epi64x(m5, m11)
-#define LOAD_MSG_11_4(b0, b1) b0 = _mm_set_epi64x(m2, m12); b1 = _mm_set_epi64x(m3, m7)
-
-#define LOAD(p)  _mm_load_si128( (__m128i *)(p) )
-#define STORE(p,r) _mm_store_si128((__m128i *)(p), r)
-
-#define LOADU(p)  _mm_loadu_si128( (__m128i *)(p) )
-#define STOREU(p,r) _mm_storeu_si128((__m128i *)(p), r)
-
-#define TOF(reg) _mm_castsi128_ps((reg))
-#define TOI(reg) _mm_castps_si128((reg))
-
-#define LIKELY(x) __builtin_expect((x),1)
-
-#define _mm_roti_epi64(x, c) \
-	(-(c) == 32) ? _mm_shuffle_epi32((x), _MM_SHUFFLE(2,3,0,1))  \
-	: (-(c) == 24) ? _mm_shuffle_epi8((x), r24) \
-	: (-(c) == 16) ? _mm_shuffle_epi8((x), r16) \
-	: (-(c) == 63) ? _mm_xor_si128(_mm_srli_epi64((x), -(c)), _mm_add_epi64((x), (x)))  \
-	: _mm_xor_si128(_mm_srli_epi64((x), -(c)), _mm_slli_epi64((x), 64-(-(c))))
-
-#define DIAGONALIZE(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h) \
-  t0 = _mm_alignr_epi8(row2h, row2l, 8); \
-  t1 = _mm_alignr_epi8(row2l, row2h, 8); \
-  row2l = t0; \
-  row2h = t1; \
-  \
-  t0 = row3l; \
-  row3l = row3h; \
-  row3h = t0;    \
-  \
-  t0 = _mm_alignr_epi8(row4h, row4l, 8); \
-  t1 = _mm_alignr_epi8(row4l, row4h, 8); \
-  row4l = t1; \
-  row4h = t0;
-
-#define UNDIAGONALIZE(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h) \
-  t0 = _mm_alignr_epi8(row2l, row2h, 8); \
-  t1 = _mm_alignr_epi8(row2h, row2l, 8); \
-  row2l = t0; \
-  row2h = t1; \
-  \
-  t0 = row3l; \
-  row3l = row3h; \
-  row3h = t0; \
-  \
-  t0 = _mm_alignr_epi8(row4l, row4h, 8); \
-  t1 = _mm_alignr_epi8(row4h, row4l, 8); \
-  row4l = t1; \
-  row4h = t0;
-
-#define G1(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h,b0,b1) \
-  row1l = _mm_add_epi64(_mm_add_epi64(row1l, b0), row2l); \
-  row1h = _mm_add_epi64(_mm_add_epi64(row1h, b1), row2h); \
-  \
-  row4l = _mm_xor_si128(row4l, row1l); \
-  row4h = _mm_xor_si128(row4h, row1h); \
-  \
-  row4l = _mm_roti_epi64(row4l, -32); \
-  row4h = _mm_roti_epi64(row4h, -32); \
-  \
-  row3l = _mm_add_epi64(row3l, row4l); \
-  row3h = _mm_add_epi64(row3h, row4h); \
-  \
-  row2l = _mm_xor_si128(row2l, row3l); \
-  row2h = _mm_xor_si128(row2h, row3h); \
-  \
-  row2l = _mm_roti_epi64(row2l, -24); \
-  row2h = _mm_roti_epi64(row2h, -24); \
- 
-#define G2(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h,b0,b1) \
-  row1l = _mm_add_epi64(_mm_add_epi64(row1l, b0), row2l); \
-  row1h = _mm_add_epi64(_mm_add_epi64(row1h, b1), row2h); \
-  \
-  row4l = _mm_xor_si128(row4l, row1l); \
-  row4h = _mm_xor_si128(row4h, row1h); \
-  \
-  row4l = _mm_roti_epi64(row4l, -16); \
-  row4h = _mm_roti_epi64(row4h, -16); \
-  \
-  row3l = _mm_add_epi64(row3l, row4l); \
-  row3h = _mm_add_epi64(row3h, row4h); \
-  \
-  row2l = _mm_xor_si128(row2l, row3l); \
-  row2h = _mm_xor_si128(row2h, row3h); \
-  \
-  row2l = _mm_roti_epi64(row2l, -63); \
-  row2h = _mm_roti_epi64(row2h, -63); \
-
-#define ROUND(r) \
-  LOAD_MSG_ ##r ##_1(b0, b1); \
-  G1(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h,b0,b1); \
-  LOAD_MSG_ ##r ##_2(b0, b1); \
-  G2(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h,b0,b1); \
-  DIAGONALIZE(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h); \
-  LOAD_MSG_ ##r ##_3(b0, b1); \
-  G1(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h,b0,b1); \
-  LOAD_MSG_ ##r ##_4(b0, b1); \
-  G2(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h,b0,b1); \
-  UNDIAGONALIZE(row1l,row2l,row3l,row4l,row1h,row2h,row3h,row4h);
+#include "threadpool.h"
 
 NAMESPACE_BEGIN(CryptoPP)
 
@@ -191,8 +33,497 @@ static const byte blake2b_sigma[12][16] =
   { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
 };
 
+static void BLAKE2b_CompressReference(word64 *h, const word64 *t, const word64 *f, const byte* block)
+{
+  word64 m[16];
+  word64 v[16];
+  int i;
+
+  for( i = 0; i < 16; ++i )
+	  m[i] = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, block + i * sizeof( m[i] ));
+
+  for( i = 0; i < 8; ++i )
+	v[i] = h[i];
+
+  v[ 8] = blake2b_IV[0];
+  v[ 9] = blake2b_IV[1];
+  v[10] = blake2b_IV[2];
+  v[11] = blake2b_IV[3];
+  v[12] = t[0] ^ blake2b_IV[4];
+  v[13] = t[1] ^ blake2b_IV[5];
+  v[14] = f[0] ^ blake2b_IV[6];
+  v[15] = f[1] ^ blake2b_IV[7];
+#define GREF(r,i,a,b,c,d) \
+  do { \
+	a = a + b + m[blake2b_sigma[r][2*i+0]]; \
+	d = rotrFixed<word64>(d ^ a, 32); \
+	c = c + d; \
+	b = rotrFixed<word64>(b ^ c, 24); \
+	a = a + b + m[blake2b_sigma[r][2*i+1]]; \
+	d = rotrFixed<word64>(d ^ a, 16); \
+	c = c + d; \
+	b = rotrFixed<word64>(b ^ c, 63); \
+  } while(0)
+#define ROUNDREF(r)  \
+  do { \
+	GREF(r,0,v[ 0],v[ 4],v[ 8],v[12]); \
+	GREF(r,1,v[ 1],v[ 5],v[ 9],v[13]); \
+	GREF(r,2,v[ 2],v[ 6],v[10],v[14]); \
+	GREF(r,3,v[ 3],v[ 7],v[11],v[15]); \
+	GREF(r,4,v[ 0],v[ 5],v[10],v[15]); \
+	GREF(r,5,v[ 1],v[ 6],v[11],v[12]); \
+	GREF(r,6,v[ 2],v[ 7],v[ 8],v[13]); \
+	GREF(r,7,v[ 3],v[ 4],v[ 9],v[14]); \
+  } while(0)
+  ROUNDREF( 0 );
+  ROUNDREF( 1 );
+  ROUNDREF( 2 );
+  ROUNDREF( 3 );
+  ROUNDREF( 4 );
+  ROUNDREF( 5 );
+  ROUNDREF( 6 );
+  ROUNDREF( 7 );
+  ROUNDREF( 8 );
+  ROUNDREF( 9 );
+  ROUNDREF( 10 );
+  ROUNDREF( 11 );
+#undef ROUNDREF
+#undef GREF
+
+  for( i = 0; i < 8; ++i )
+	h[i] = h[i] ^ v[i] ^ v[i + 8];
+}
+
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+// The message is held in eight registers of two words each, m[i] = (m_2i,m_2i+1).
+// The loaders pick the words A and B out of them and return (m_A,m_B).
+struct BLAKE2b_LoaderSSSE3
+{
+	template <unsigned int A, unsigned int B>
+	static inline __m128i Load(const __m128i *m)
+	{
+		return _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(m[A/2]), _mm_castsi128_pd(m[B/2]), (A%2) | ((B%2)<<1)));
+	}
+};
+
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+// stays in the integer domain, shufpd costs a bypass delay on most cores
+struct BLAKE2b_LoaderSSE41
+{
+	template <unsigned int A, unsigned int B>
+	static inline __m128i Load(const __m128i *m)
+	{
+		if (A%2 == 0 && B%2 == 0)
+			return _mm_unpacklo_epi64(m[A/2], m[B/2]);
+		if (A%2 == 1 && B%2 == 1)
+			return _mm_unpackhi_epi64(m[A/2], m[B/2]);
+		if (A%2 == 0)
+			return _mm_blend_epi16(m[A/2], m[B/2], 0xF0);
+		return _mm_alignr_epi8(m[B/2], m[A/2], 8);
+	}
+};
+#endif
+
+#define BLAKE2B_ROTR32(x) _mm_shuffle_epi32((x), _MM_SHUFFLE(2,3,0,1))
+#define BLAKE2B_ROTR24(x) _mm_shuffle_epi8((x), r24)
+#define BLAKE2B_ROTR16(x) _mm_shuffle_epi8((x), r16)
+#define BLAKE2B_ROTR63(x) _mm_xor_si128(_mm_srli_epi64((x), 63), _mm_add_epi64((x), (x)))
+
+#define BLAKE2B_G(b0,b1,R1,R2) \
+  row1l = _mm_add_epi64(_mm_add_epi64(row1l, b0), row2l); \
+  row1h = _mm_add_epi64(_mm_add_epi64(row1h, b1), row2h); \
+  row4l = _mm_xor_si128(row4l, row1l); \
+  row4h = _mm_xor_si128(row4h, row1h); \
+  row4l = R1(row4l); \
+  row4h = R1(row4h); \
+  row3l = _mm_add_epi64(row3l, row4l); \
+  row3h = _mm_add_epi64(row3h, row4h); \
+  row2l = _mm_xor_si128(row2l, row3l); \
+  row2h = _mm_xor_si128(row2h, row3h); \
+  row2l = R2(row2l); \
+  row2h = R2(row2h);
+
+// row2 is the last result of G and everything else waits for it, so rows 1, 3 and 4 are rotated instead.
+// Lane i then works on the diagonal starting in column i-1, which the message order accounts for.
+#define BLAKE2B_DIAGONALIZE() \
+  t0 = _mm_alignr_epi8(row1l, row1h, 8); \
+  t1 = _mm_alignr_epi8(row1h, row1l, 8); \
+  row1l = t0; \
+  row1h = t1; \
+  t0 = row4l; \
+  row4l = row4h; \
+  row4h = t0; \
+  t0 = _mm_alignr_epi8(row3h, row3l, 8); \
+  t1 = _mm_alignr_epi8(row3l, row3h, 8); \
+  row3l = t0; \
+  row3h = t1;
+
+#define BLAKE2B_UNDIAGONALIZE() \
+  t0 = _mm_alignr_epi8(row1h, row1l, 8); \
+  t1 = _mm_alignr_epi8(row1l, row1h, 8); \
+  row1l = t0; \
+  row1h = t1; \
+  t0 = row4l; \
+  row4l = row4h; \
+  row4h = t0; \
+  t0 = _mm_alignr_epi8(row3l, row3h, 8); \
+  t1 = _mm_alignr_epi8(row3h, row3l, 8); \
+  row3l = t0; \
+  row3h = t1;
+
+#define BLAKE2B_ROUND(s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12,s13,s14,s15) \
+  b0 = LOADER::template Load<s0,s2>(m); \
+  b1 = LOADER::template Load<s4,s6>(m); \
+  BLAKE2B_G(b0, b1, BLAKE2B_ROTR32, BLAKE2B_ROTR24) \
+  b0 = LOADER::template Load<s1,s3>(m); \
+  b1 = LOADER::template Load<s5,s7>(m); \
+  BLAKE2B_G(b0, b1, BLAKE2B_ROTR16, BLAKE2B_ROTR63) \
+  BLAKE2B_DIAGONALIZE() \
+  b0 = LOADER::template Load<s14,s8>(m); \
+  b1 = LOADER::template Load<s10,s12>(m); \
+  BLAKE2B_G(b0, b1, BLAKE2B_ROTR32, BLAKE2B_ROTR24) \
+  b0 = LOADER::template Load<s15,s9>(m); \
+  b1 = LOADER::template Load<s11,s13>(m); \
+  BLAKE2B_G(b0, b1, BLAKE2B_ROTR16, BLAKE2B_ROTR63) \
+  BLAKE2B_UNDIAGONALIZE()
+
+template <class LOADER>
+static void BLAKE2b_CompressSSE(word64 *h, const word64 *t, const word64 *f, const byte* block)
+{
+  __m128i row1l, row1h;
+  __m128i row2l, row2h;
+  __m128i row3l, row3h;
+  __m128i row4l, row4h;
+  __m128i b0, b1;
+  __m128i t0, t1;
+  __m128i m[8];
+  const __m128i r16 = _mm_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
+  const __m128i r24 = _mm_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
+
+  for( int i = 0; i < 8; ++i )
+	m[i] = _mm_loadu_si128( (const __m128i *)(block + 16*i) );
+
+  row1l = _mm_loadu_si128( (const __m128i *)&h[0] );
+  row1h = _mm_loadu_si128( (const __m128i *)&h[2] );
+  row2l = _mm_loadu_si128( (const __m128i *)&h[4] );
+  row2h = _mm_loadu_si128( (const __m128i *)&h[6] );
+  row3l = _mm_loadu_si128( (const __m128i *)&blake2b_IV[0] );
+  row3h = _mm_loadu_si128( (const __m128i *)&blake2b_IV[2] );
+  row4l = _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&blake2b_IV[4] ), _mm_loadu_si128( (const __m128i *)t ) );
+  row4h = _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&blake2b_IV[6] ), _mm_loadu_si128( (const __m128i *)f ) );
+
+  BLAKE2B_ROUND(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)
+  BLAKE2B_ROUND(14,10,4,8,9,15,13,6,1,12,0,2,11,7,5,3)
+  BLAKE2B_ROUND(11,8,12,0,5,2,15,13,10,14,3,6,7,1,9,4)
+  BLAKE2B_ROUND(7,9,3,1,13,12,11,14,2,6,5,10,4,0,15,8)
+  BLAKE2B_ROUND(9,0,5,7,2,4,10,15,14,1,11,12,6,8,3,13)
+  BLAKE2B_ROUND(2,12,6,10,0,11,8,3,4,13,7,5,15,14,1,9)
+  BLAKE2B_ROUND(12,5,1,15,14,13,4,10,0,7,6,3,9,2,8,11)
+  BLAKE2B_ROUND(13,11,7,14,12,1,3,9,5,0,15,4,8,6,2,10)
+  BLAKE2B_ROUND(6,15,14,9,11,3,0,8,12,2,13,7,1,4,10,5)
+  BLAKE2B_ROUND(10,2,8,4,7,6,1,5,15,11,9,14,3,12,13,0)
+  BLAKE2B_ROUND(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)
+  BLAKE2B_ROUND(14,10,4,8,9,15,13,6,1,12,0,2,11,7,5,3)
+
+  row1l = _mm_xor_si128( row3l, row1l );
+  row1h = _mm_xor_si128( row3h, row1h );
+  _mm_storeu_si128( (__m128i *)&h[0], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[0] ), row1l ) );
+  _mm_storeu_si128( (__m128i *)&h[2], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[2] ), row1h ) );
+  row2l = _mm_xor_si128( row4l, row2l );
+  row2h = _mm_xor_si128( row4h, row2h );
+  _mm_storeu_si128( (__m128i *)&h[4], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[4] ), row2l ) );
+  _mm_storeu_si128( (__m128i *)&h[6], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[6] ), row2h ) );
+}
+
+#undef BLAKE2B_ROUND
+#undef BLAKE2B_UNDIAGONALIZE
+#undef BLAKE2B_DIAGONALIZE
+#undef BLAKE2B_G
+#undef BLAKE2B_ROTR63
+#undef BLAKE2B_ROTR16
+#undef BLAKE2B_ROTR24
+#undef BLAKE2B_ROTR32
+#endif // CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+// A whole row of the state fits into one register, the diagonal step becomes three lane permutations.
+#define BLAKE2B_ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2,3,0,1))
+#define BLAKE2B_ROTR24(x) _mm256_shuffle_epi8((x), r24)
+#define BLAKE2B_ROTR16(x) _mm256_shuffle_epi8((x), r16)
+#define BLAKE2B_ROTR63(x) _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+#define BLAKE2B_LOAD(a,b,c,d) \
+  b0 = _mm256_inserti128_si256(_mm256_castsi128_si256(BLAKE2b_LoaderSSE41::Load<a,b>(m)), BLAKE2b_LoaderSSE41::Load<c,d>(m), 1);
+
+#define BLAKE2B_G(b,R1,R2) \
+  row1 = _mm256_add_epi64(_mm256_add_epi64(row1, b), row2); \
+  row4 = R1(_mm256_xor_si256(row4, row1)); \
+  row3 = _mm256_add_epi64(row3, row4); \
+  row2 = R2(_mm256_xor_si256(row2, row3));
+
+// rotated the same way as in BLAKE2b_CompressSSE()
+#define BLAKE2B_DIAGONALIZE() \
+  row1 = _mm256_permute4x64_epi64(row1, _MM_SHUFFLE(2,1,0,3)); \
+  row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(1,0,3,2)); \
+  row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(0,3,2,1));
+
+#define BLAKE2B_UNDIAGONALIZE() \
+  row1 = _mm256_permute4x64_epi64(row1, _MM_SHUFFLE(0,3,2,1)); \
+  row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(1,0,3,2)); \
+  row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(2,1,0,3));
+
+#define BLAKE2B_ROUND(s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12,s13,s14,s15) \
+  BLAKE2B_LOAD(s0,s2,s4,s6) \
+  BLAKE2B_G(b0, BLAKE2B_ROTR32, BLAKE2B_ROTR24) \
+  BLAKE2B_LOAD(s1,s3,s5,s7) \
+  BLAKE2B_G(b0, BLAKE2B_ROTR16, BLAKE2B_ROTR63) \
+  BLAKE2B_DIAGONALIZE() \
+  BLAKE2B_LOAD(s14,s8,s10,s12) \
+  BLAKE2B_G(b0, BLAKE2B_ROTR32, BLAKE2B_ROTR24) \
+  BLAKE2B_LOAD(s15,s9,s11,s13) \
+  BLAKE2B_G(b0, BLAKE2B_ROTR16, BLAKE2B_ROTR63) \
+  BLAKE2B_UNDIAGONALIZE()
+
+static void BLAKE2b_CompressAVX2(word64 *h, const word64 *t, const word64 *f, const byte* block)
+{
+  __m256i row1, row2, row3, row4;
+  __m256i b0;
+  __m128i m[8];
+  const __m256i r16 = _mm256_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
+  const __m256i r24 = _mm256_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
+
+  for( int i = 0; i < 8; ++i )
+	m[i] = _mm_loadu_si128( (const __m128i *)(block + 16*i) );
+
+  row1 = _mm256_loadu_si256( (const __m256i *)&h[0] );
+  row2 = _mm256_loadu_si256( (const __m256i *)&h[4] );
+  row3 = _mm256_loadu_si256( (const __m256i *)&blake2b_IV[0] );
+  row4 = _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *)&blake2b_IV[4] ),
+	_mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( (const __m128i *)t ) ), _mm_loadu_si128( (const __m128i *)f ), 1 ) );
+
+  BLAKE2B_ROUND(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)
+  BLAKE2B_ROUND(14,10,4,8,9,15,13,6,1,12,0,2,11,7,5,3)
+  BLAKE2B_ROUND(11,8,12,0,5,2,15,13,10,14,3,6,7,1,9,4)
+  BLAKE2B_ROUND(7,9,3,1,13,12,11,14,2,6,5,10,4,0,15,8)
+  BLAKE2B_ROUND(9,0,5,7,2,4,10,15,14,1,11,12,6,8,3,13)
+  BLAKE2B_ROUND(2,12,6,10,0,11,8,3,4,13,7,5,15,14,1,9)
+  BLAKE2B_ROUND(12,5,1,15,14,13,4,10,0,7,6,3,9,2,8,11)
+  BLAKE2B_ROUND(13,11,7,14,12,1,3,9,5,0,15,4,8,6,2,10)
+  BLAKE2B_ROUND(6,15,14,9,11,3,0,8,12,2,13,7,1,4,10,5)
+  BLAKE2B_ROUND(10,2,8,4,7,6,1,5,15,11,9,14,3,12,13,0)
+  BLAKE2B_ROUND(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)
+  BLAKE2B_ROUND(14,10,4,8,9,15,13,6,1,12,0,2,11,7,5,3)
+
+  row1 = _mm256_xor_si256( row1, row3 );
+  row2 = _mm256_xor_si256( row2, row4 );
+  _mm256_storeu_si256( (__m256i *)&h[0], _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *)&h[0] ), row1 ) );
+  _mm256_storeu_si256( (__m256i *)&h[4], _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *)&h[4] ), row2 ) );
+  _mm256_zeroupper();
+}
+
+#undef BLAKE2B_ROUND
+#undef BLAKE2B_UNDIAGONALIZE
+#undef BLAKE2B_DIAGONALIZE
+#undef BLAKE2B_G
+#undef BLAKE2B_LOAD
+#undef BLAKE2B_ROTR63
+#undef BLAKE2B_ROTR16
+#undef BLAKE2B_ROTR24
+#undef BLAKE2B_ROTR32
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+// Lane i of every register belongs to leaf i of a BLAKE2bp tree, so G only needs vertical operations
+// and the message words come straight out of a 4x4 transpose of the interleaved leaf blocks.
+#define BLAKE2B_ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2,3,0,1))
+#define BLAKE2B_ROTR24(x) _mm256_shuffle_epi8((x), r24)
+#define BLAKE2B_ROTR16(x) _mm256_shuffle_epi8((x), r16)
+#define BLAKE2B_ROTR63(x) _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+#define BLAKE2B_G(r,i,a,b,c,d) \
+  a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_sigma[r][2*i+0]]); \
+  d = BLAKE2B_ROTR32(_mm256_xor_si256(d, a)); \
+  c = _mm256_add_epi64(c, d); \
+  b = BLAKE2B_ROTR24(_mm256_xor_si256(b, c)); \
+  a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_sigma[r][2*i+1]]); \
+  d = BLAKE2B_ROTR16(_mm256_xor_si256(d, a)); \
+  c = _mm256_add_epi64(c, d); \
+  b = BLAKE2B_ROTR63(_mm256_xor_si256(b, c));
+
+#define BLAKE2B_ROUND(r) \
+  BLAKE2B_G(r,0,v[ 0],v[ 4],v[ 8],v[12]) \
+  BLAKE2B_G(r,1,v[ 1],v[ 5],v[ 9],v[13]) \
+  BLAKE2B_G(r,2,v[ 2],v[ 6],v[10],v[14]) \
+  BLAKE2B_G(r,3,v[ 3],v[ 7],v[11],v[15]) \
+  BLAKE2B_G(r,4,v[ 0],v[ 5],v[10],v[15]) \
+  BLAKE2B_G(r,5,v[ 1],v[ 6],v[11],v[12]) \
+  BLAKE2B_G(r,6,v[ 2],v[ 7],v[ 8],v[13]) \
+  BLAKE2B_G(r,7,v[ 3],v[ 4],v[ 9],v[14])
+
+// turns four rows of four words into four columns, it is its own inverse
+static inline void BLAKE2b_Transpose4x4(__m256i &a, __m256i &b, __m256i &c, __m256i &d)
+{
+  const __m256i t0 = _mm256_unpacklo_epi64(a, b);
+  const __m256i t1 = _mm256_unpackhi_epi64(a, b);
+  const __m256i t2 = _mm256_unpacklo_epi64(c, d);
+  const __m256i t3 = _mm256_unpackhi_epi64(c, d);
+  a = _mm256_permute2x128_si256(t0, t2, 0x20);
+  b = _mm256_permute2x128_si256(t1, t3, 0x20);
+  c = _mm256_permute2x128_si256(t0, t2, 0x31);
+  d = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+// Compresses Stripes consecutive stripes of four blocks, block i of a stripe goes into the state h[i],t[i].
+// None of the blocks may be the last one of its leaf, so the finalization flags are always clear.
+static void BLAKE2b_CompressLanesAVX2(word64 *const h[4], word64 *const t[4], const byte *input, size_t Stripes)
+{
+  __m256i v[16], m[16], hv[8];
+  const __m256i r16 = _mm256_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
+  const __m256i r24 = _mm256_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
+  word64 t0[4], t1[4];
+
+  for( int j = 0; j < 8; j += 4 )
+  {
+	for( int i = 0; i < 4; ++i )
+	  hv[j+i] = _mm256_loadu_si256( (const __m256i *)&h[i][j] );
+	BLAKE2b_Transpose4x4( hv[j+0], hv[j+1], hv[j+2], hv[j+3] );
+  }
+  for( int i = 0; i < 4; ++i )
+  {
+	t0[i] = t[i][0];
+	t1[i] = t[i][1];
+  }
+
+  for( ; Stripes; --Stripes, input += 4*BLAKE2b::BLOCKSIZE )
+  {
+	for( int j = 0; j < 16; j += 4 )
+	{
+	  for( int i = 0; i < 4; ++i )
+		m[j+i] = _mm256_loadu_si256( (const __m256i *)(input + i*BLAKE2b::BLOCKSIZE + 8*j) );
+	  BLAKE2b_Transpose4x4( m[j+0], m[j+1], m[j+2], m[j+3] );
+	}
+
+	for( int i = 0; i < 4; ++i )
+	{
+	  t0[i] += BLAKE2b::BLOCKSIZE;
+	  t1[i] += ( t0[i] < BLAKE2b::BLOCKSIZE );
+	}
+
+	for( int i = 0; i < 8; ++i )
+	{
+	  v[i] = hv[i];
+	  v[i+8] = _mm256_set1_epi64x( blake2b_IV[i] );
+	}
+	v[12] = _mm256_xor_si256( v[12], _mm256_loadu_si256( (const __m256i *)t0 ) );
+	v[13] = _mm256_xor_si256( v[13], _mm256_loadu_si256( (const __m256i *)t1 ) );
+
+	BLAKE2B_ROUND( 0 );
+	BLAKE2B_ROUND( 1 );
+	BLAKE2B_ROUND( 2 );
+	BLAKE2B_ROUND( 3 );
+	BLAKE2B_ROUND( 4 );
+	BLAKE2B_ROUND( 5 );
+	BLAKE2B_ROUND( 6 );
+	BLAKE2B_ROUND( 7 );
+	BLAKE2B_ROUND( 8 );
+	BLAKE2B_ROUND( 9 );
+	BLAKE2B_ROUND( 10 );
+	BLAKE2B_ROUND( 11 );
+
+	for( int i = 0; i < 8; ++i )
+	  hv[i] = _mm256_xor_si256( hv[i], _mm256_xor_si256( v[i], v[i+8] ) );
+  }
+
+  for( int j = 0; j < 8; j += 4 )
+  {
+	BLAKE2b_Transpose4x4( hv[j+0], hv[j+1], hv[j+2], hv[j+3] );
+	for( int i = 0; i < 4; ++i )
+	  _mm256_storeu_si256( (__m256i *)&h[i][j], hv[j+i] );
+  }
+  for( int i = 0; i < 4; ++i )
+  {
+	t[i][0] = t0[i];
+	t[i][1] = t1[i];
+  }
+  _mm256_zeroupper();
+}
+
+#undef BLAKE2B_ROUND
+#undef BLAKE2B_G
+#undef BLAKE2B_ROTR63
+#undef BLAKE2B_ROTR16
+#undef BLAKE2B_ROTR24
+#undef BLAKE2B_ROTR32
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+static void BLAKE2b_Compress(BLAKE2b::Implementation Impl, word64 *h, const word64 *t, const word64 *f, const byte* block)
+{
+	switch(Impl)
+	{
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	case BLAKE2b::AVX2_IMPLEMENTATION:
+		BLAKE2b_CompressAVX2(h,t,f,block);
+		break;
+#endif
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+	case BLAKE2b::SSE41_IMPLEMENTATION:
+		BLAKE2b_CompressSSE<BLAKE2b_LoaderSSE41>(h,t,f,block);
+		break;
+#endif
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+	case BLAKE2b::SSSE3_IMPLEMENTATION:
+		BLAKE2b_CompressSSE<BLAKE2b_LoaderSSSE3>(h,t,f,block);
+		break;
+#endif
+	default:
+		BLAKE2b_CompressReference(h,t,f,block);
+	}
+}
+
+bool BLAKE2b::IsImplementationAvailable(Implementation Impl)
+{
+	switch(Impl)
+	{
+	case REFERENCE_IMPLEMENTATION:
+		return true;
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+	case SSSE3_IMPLEMENTATION:
+		return HasSSSE3();
+#endif
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+	case SSE41_IMPLEMENTATION:
+		return HasSSE41();
+#endif
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	case AVX2_IMPLEMENTATION:
+		return HasAVX2();
+#endif
+	default:
+		return false;
+	}
+}
+
+BLAKE2b::Implementation BLAKE2b::GetBestImplementation()
+{
+	if(IsImplementationAvailable(AVX2_IMPLEMENTATION))
+		return AVX2_IMPLEMENTATION;
+	if(IsImplementationAvailable(SSE41_IMPLEMENTATION))
+		return SSE41_IMPLEMENTATION;
+	if(IsImplementationAvailable(SSSE3_IMPLEMENTATION))
+		return SSSE3_IMPLEMENTATION;
+	return REFERENCE_IMPLEMENTATION;
+}
+
+void BLAKE2b::SetImplementation(Implementation Impl)
+{
+	if(!IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2b: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+}
+
 BLAKE2b::BLAKE2b(unsigned int Digestsize) :
-	m_Digestsize(Digestsize)
+	m_Digestsize(Digestsize),
+	m_Implementation(GetBestImplementation())
 {
 	if(Digestsize>64 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
@@ -244,158 +575,42 @@ void BLAKE2b::TruncatedFinal(byte *digest, size_t digestSize)
 
 void BLAKE2b::Compress(const byte* block)
 {
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-if(HasSSSE3() && HasSSE2())
-{
-  __m128i row1l, row1h;
-  __m128i row2l, row2h;
-  __m128i row3l, row3h;
-  __m128i row4l, row4h;
-  __m128i b0, b1;
-  __m128i t0, t1;
-  const __m128i r16 = _mm_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
-  const __m128i r24 = _mm_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
-
-  const word64  m0 = ( ( word64 * )block )[ 0];
-  const word64  m1 = ( ( word64 * )block )[ 1];
-  const word64  m2 = ( ( word64 * )block )[ 2];
-  const word64  m3 = ( ( word64 * )block )[ 3];
-  const word64  m4 = ( ( word64 * )block )[ 4];
-  const word64  m5 = ( ( word64 * )block )[ 5];
-  const word64  m6 = ( ( word64 * )block )[ 6];
-  const word64  m7 = ( ( word64 * )block )[ 7];
-  const word64  m8 = ( ( word64 * )block )[ 8];
-  const word64  m9 = ( ( word64 * )block )[ 9];
-  const word64 m10 = ( ( word64 * )block )[10];
-  const word64 m11 = ( ( word64 * )block )[11];
-  const word64 m12 = ( ( word64 * )block )[12];
-  const word64 m13 = ( ( word64 * )block )[13];
-  const word64 m14 = ( ( word64 * )block )[14];
-  const word64 m15 = ( ( word64 * )block )[15];
-
-  row1l = LOADU( &m_h[0] );
-  row1h = LOADU( &m_h[2] );
-  row2l = LOADU( &m_h[4] );
-  row2h = LOADU( &m_h[6] );
-  row3l = LOADU( &blake2b_IV[0] );
-  row3h = LOADU( &blake2b_IV[2] );
-  row4l = _mm_xor_si128( LOADU( &blake2b_IV[4] ), LOADU( &m_t[0] ) );
-  row4h = _mm_xor_si128( LOADU( &blake2b_IV[6] ), LOADU( &m_f[0] ) );
-  ROUND( 0 );
-  ROUND( 1 );
-  ROUND( 2 );
-  ROUND( 3 );
-  ROUND( 4 );
-  ROUND( 5 );
-  ROUND( 6 );
-  ROUND( 7 );
-  ROUND( 8 );
-  ROUND( 9 );
-  ROUND( 10 );
-  ROUND( 11 );
-  row1l = _mm_xor_si128( row3l, row1l );
-  row1h = _mm_xor_si128( row3h, row1h );
-  STOREU( &m_h[0], _mm_xor_si128( LOADU( &m_h[0] ), row1l ) );
-  STOREU( &m_h[2], _mm_xor_si128( LOADU( &m_h[2] ), row1h ) );
-  row2l = _mm_xor_si128( row4l, row2l );
-  row2h = _mm_xor_si128( row4h, row2h );
-  STOREU( &m_h[4], _mm_xor_si128( LOADU( &m_h[4] ), row2l ) );
-  STOREU( &m_h[6], _mm_xor_si128( LOADU( &m_h[6] ), row2h ) );
-}
-else
-{
-#endif
-  uint64_t m[16];
-  uint64_t v[16];
-  int i;
-
-  for( i = 0; i < 16; ++i )
-	  m[i] = ConditionalByteReverse(LITTLE_ENDIAN_ORDER,*((word64*) (block + i * sizeof( m[i] ))) );
-
-  for( i = 0; i < 8; ++i )
-	v[i] = m_h[i];
-
-  v[ 8] = blake2b_IV[0];
-  v[ 9] = blake2b_IV[1];
-  v[10] = blake2b_IV[2];
-  v[11] = blake2b_IV[3];
-  v[12] = m_t[0] ^ blake2b_IV[4];
-  v[13] = m_t[1] ^ blake2b_IV[5];
-  v[14] = m_f[0] ^ blake2b_IV[6];
-  v[15] = m_f[1] ^ blake2b_IV[7];
-#define GREF(r,i,a,b,c,d) \
-  do { \
-	a = a + b + m[blake2b_sigma[r][2*i+0]]; \
-	d = rotrFixed<word64>(d ^ a, 32); \
-	c = c + d; \
-	b = rotrFixed<word64>(b ^ c, 24); \
-	a = a + b + m[blake2b_sigma[r][2*i+1]]; \
-	d = rotrFixed<word64>(d ^ a, 16); \
-	c = c + d; \
-	b = rotrFixed<word64>(b ^ c, 63); \
-  } while(0)
-#define ROUNDREF(r)  \
-  do { \
-	GREF(r,0,v[ 0],v[ 4],v[ 8],v[12]); \
-	GREF(r,1,v[ 1],v[ 5],v[ 9],v[13]); \
-	GREF(r,2,v[ 2],v[ 6],v[10],v[14]); \
-	GREF(r,3,v[ 3],v[ 7],v[11],v[15]); \
-	GREF(r,4,v[ 0],v[ 5],v[10],v[15]); \
-	GREF(r,5,v[ 1],v[ 6],v[11],v[12]); \
-	GREF(r,6,v[ 2],v[ 7],v[ 8],v[13]); \
-	GREF(r,7,v[ 3],v[ 4],v[ 9],v[14]); \
-  } while(0)
-  ROUNDREF( 0 );
-  ROUNDREF( 1 );
-  ROUNDREF( 2 );
-  ROUNDREF( 3 );
-  ROUNDREF( 4 );
-  ROUNDREF( 5 );
-  ROUNDREF( 6 );
-  ROUNDREF( 7 );
-  ROUNDREF( 8 );
-  ROUNDREF( 9 );
-  ROUNDREF( 10 );
-  ROUNDREF( 11 );
-
-  for( i = 0; i < 8; ++i )
-	m_h[i] = m_h[i] ^ v[i] ^ v[i + 8];
-
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-}
-#endif
+	BLAKE2b_Compress(m_Implementation,m_h,m_t,m_f,block);
 }
 
 void BLAKE2b::Update(const byte *input, size_t length)
 {
-	while( length > 0 )
+	// the last block may only be compressed by TruncatedFinal(), so it always stays in the buffer
+	if( m_buflen + length > BLOCKSIZE )
 	{
-		size_t left = m_buflen;
-		size_t fill = 2 * BLOCKSIZE - left;
-
-		if( length > fill )
+		if( m_buflen )
 		{
-			memcpy( m_buf + left, input, fill ); // Fill buffer
-			m_buflen += fill;
+			const size_t fill = BLOCKSIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
 			IncrementCounter( BLOCKSIZE );
-			Compress( m_buf.BytePtr() ); // Compress
-			memcpy( m_buf, m_buf + BLOCKSIZE, BLOCKSIZE ); // Shift buffer left
-			m_buflen -= BLOCKSIZE;
+			Compress( m_buf );
+			m_buflen = 0;
 			input += fill;
 			length -= fill;
 		}
-		else // inlen <= fill
+
+		// compress straight from the input
+		while( length > BLOCKSIZE )
 		{
-			memcpy( m_buf + left, input, length );
-			m_buflen += length; // Be lazy, do not compress
-			input += length;
-			length -= length;
+			IncrementCounter( BLOCKSIZE );
+			Compress( input );
+			input += BLOCKSIZE;
+			length -= BLOCKSIZE;
 		}
 	}
+
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 BLAKE2bMAC::BLAKE2bMAC(unsigned int Digestsize,const byte* Key,unsigned int Keylength) :
-	m_Digestsize(Digestsize)
+	m_Digestsize(Digestsize),
+	m_Implementation(BLAKE2b::GetBestImplementation())
 {
 	if(Digestsize>64 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
@@ -456,132 +671,44 @@ void BLAKE2bMAC::TruncatedFinal(byte *digest, size_t digestSize)
 
 void BLAKE2bMAC::Compress(const byte* block)
 {
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-if(HasSSSE3() && HasSSE2())
-{
-  __m128i row1l, row1h;
-  __m128i row2l, row2h;
-  __m128i row3l, row3h;
-  __m128i row4l, row4h;
-  __m128i b0, b1;
-  __m128i t0, t1;
-  const __m128i r16 = _mm_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
-  const __m128i r24 = _mm_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
-
-  const word64  m0 = ( ( word64 * )block )[ 0];
-  const word64  m1 = ( ( word64 * )block )[ 1];
-  const word64  m2 = ( ( word64 * )block )[ 2];
-  const word64  m3 = ( ( word64 * )block )[ 3];
-  const word64  m4 = ( ( word64 * )block )[ 4];
-  const word64  m5 = ( ( word64 * )block )[ 5];
-  const word64  m6 = ( ( word64 * )block )[ 6];
-  const word64  m7 = ( ( word64 * )block )[ 7];
-  const word64  m8 = ( ( word64 * )block )[ 8];
-  const word64  m9 = ( ( word64 * )block )[ 9];
-  const word64 m10 = ( ( word64 * )block )[10];
-  const word64 m11 = ( ( word64 * )block )[11];
-  const word64 m12 = ( ( word64 * )block )[12];
-  const word64 m13 = ( ( word64 * )block )[13];
-  const word64 m14 = ( ( word64 * )block )[14];
-  const word64 m15 = ( ( word64 * )block )[15];
-
-  row1l = LOADU( &m_h[0] );
-  row1h = LOADU( &m_h[2] );
-  row2l = LOADU( &m_h[4] );
-  row2h = LOADU( &m_h[6] );
-  row3l = LOADU( &blake2b_IV[0] );
-  row3h = LOADU( &blake2b_IV[2] );
-  row4l = _mm_xor_si128( LOADU( &blake2b_IV[4] ), LOADU( &m_t[0] ) );
-  row4h = _mm_xor_si128( LOADU( &blake2b_IV[6] ), LOADU( &m_f[0] ) );
-  ROUND( 0 );
-  ROUND( 1 );
-  ROUND( 2 );
-  ROUND( 3 );
-  ROUND( 4 );
-  ROUND( 5 );
-  ROUND( 6 );
-  ROUND( 7 );
-  ROUND( 8 );
-  ROUND( 9 );
-  ROUND( 10 );
-  ROUND( 11 );
-  row1l = _mm_xor_si128( row3l, row1l );
-  row1h = _mm_xor_si128( row3h, row1h );
-  STOREU( &m_h[0], _mm_xor_si128( LOADU( &m_h[0] ), row1l ) );
-  STOREU( &m_h[2], _mm_xor_si128( LOADU( &m_h[2] ), row1h ) );
-  row2l = _mm_xor_si128( row4l, row2l );
-  row2h = _mm_xor_si128( row4h, row2h );
-  STOREU( &m_h[4], _mm_xor_si128( LOADU( &m_h[4] ), row2l ) );
-  STOREU( &m_h[6], _mm_xor_si128( LOADU( &m_h[6] ), row2h ) );
+	BLAKE2b_Compress(m_Implementation,m_h,m_t,m_f,block);
 }
-else
-{
-#endif
-  uint64_t m[16];
-  uint64_t v[16];
-  int i;
-
-  for( i = 0; i < 16; ++i )
-	  m[i] = ConditionalByteReverse(LITTLE_ENDIAN_ORDER,*((word64*) (block + i * sizeof( m[i] ))) );
-
-  for( i = 0; i < 8; ++i )
-	v[i] = m_h[i];
-
-  v[ 8] = blake2b_IV[0];
-  v[ 9] = blake2b_IV[1];
-  v[10] = blake2b_IV[2];
-  v[11] = blake2b_IV[3];
-  v[12] = m_t[0] ^ blake2b_IV[4];
-  v[13] = m_t[1] ^ blake2b_IV[5];
-  v[14] = m_f[0] ^ blake2b_IV[6];
-  v[15] = m_f[1] ^ blake2b_IV[7];
-  ROUNDREF( 0 );
-  ROUNDREF( 1 );
-  ROUNDREF( 2 );
-  ROUNDREF( 3 );
-  ROUNDREF( 4 );
-  ROUNDREF( 5 );
-  ROUNDREF( 6 );
-  ROUNDREF( 7 );
-  ROUNDREF( 8 );
-  ROUNDREF( 9 );
-  ROUNDREF( 10 );
-  ROUNDREF( 11 );
 
-  for( i = 0; i < 8; ++i )
-	m_h[i] = m_h[i] ^ v[i] ^ v[i + 8];
-
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-}
-#endif
+void BLAKE2bMAC::SetImplementation(BLAKE2b::Implementation Impl)
+{
+	if(!BLAKE2b::IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2b-MAC: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
 }
 
 void BLAKE2bMAC::Update(const byte *input, size_t length)
 {
-	while( length > 0 )
+	// the last block may only be compressed by TruncatedFinal(), so it always stays in the buffer
+	if( m_buflen + length > BLOCKSIZE )
 	{
-		size_t left = m_buflen;
-		size_t fill = 2 * BLOCKSIZE - left;
-
-		if( length > fill )
+		if( m_buflen )
 		{
-			memcpy( m_buf + left, input, fill ); // Fill buffer
-			m_buflen += fill;
+			const size_t fill = BLOCKSIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
 			IncrementCounter( BLOCKSIZE );
-			Compress( m_buf.BytePtr() ); // Compress
-			memcpy( m_buf, m_buf + BLOCKSIZE, BLOCKSIZE ); // Shift buffer left
-			m_buflen -= BLOCKSIZE;
+			Compress( m_buf );
+			m_buflen = 0;
 			input += fill;
 			length -= fill;
 		}
-		else // inlen <= fill
+
+		// compress straight from the input
+		while( length > BLOCKSIZE )
 		{
-			memcpy( m_buf + left, input, length );
-			m_buflen += length; // Be lazy, do not compress
-			input += length;
-			length -= length;
+			IncrementCounter( BLOCKSIZE );
+			Compress( input );
+			input += BLOCKSIZE;
+			length -= BLOCKSIZE;
 		}
 	}
+
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 BLAKE2bp::BLAKE2bRoot::BLAKE2bRoot(unsigned int DigestSize) :
@@ -645,58 +772,76 @@ void BLAKE2bp::BLAKE2bLeaf::Restart()
 		m_h.BytePtr()[i] = IVPtr[i] ^ ParamsPtr[i];
 }
 
+void BLAKE2bp::BLAKE2bLeaf::FlushBuffer()
+{
+	if( m_buflen )
+	{
+		IncrementCounter( m_buflen );
+		Compress( m_buf );
+		m_buflen = 0;
+	}
+}
+
 BLAKE2bp::BLAKE2bp(unsigned int Digestsize):
-	m_Root(Digestsize),m_Digestsize(Digestsize),m_buflen(0)
+	m_Root(Digestsize),m_Digestsize(Digestsize),m_buflen(0),
+	m_Implementation(BLAKE2b::GetBestImplementation())
 {
 	if(Digestsize>64 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
 
 	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
 		m_Leaves.push_back(BLAKE2bLeaf(Digestsize,i==(PARALLELISM_DEGREE-1),i));
+
+	Restart();
 }
 
 void BLAKE2bp::Restart()
 {
+	m_buflen=0;
 	m_Root.Restart();
 	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
 		m_Leaves.at(i).Restart();
 }
 
-void BLAKE2bp::Update(const byte *input, size_t length)
+void BLAKE2bp::SetImplementation(BLAKE2b::Implementation Impl)
 {
-	size_t left = m_buflen;
-	size_t fill = m_buf.SizeInBytes() - left;
+	if(!BLAKE2b::IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2bp: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+	m_Root.SetImplementation(Impl);
+	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		m_Leaves.at(i).SetImplementation(Impl);
+}
 
-	if( left && length >= fill )
+void BLAKE2bp::Update(const byte *input, size_t length)
+{
+	// a stripe is compressed only once every leaf has got input behind it
+	while( m_buflen && m_buflen + length > MAX_BUFFERED )
 	{
-		memcpy( m_buf + left, input, fill );
-
-		for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
-			m_Leaves.at(i).Update( m_buf + i * BLOCKSIZE, BLOCKSIZE );
+		if( m_buflen < STRIPESIZE )
+		{
+			const size_t fill = STRIPESIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
+			m_buflen = STRIPESIZE;
+			input += fill;
+			length -= fill;
+		}
 
-		input += fill;
-		length -= fill;
-		left = 0;
+		CompressStripes( m_buf, 1 );
+		m_buflen -= STRIPESIZE;
+		memmove( m_buf, m_buf + STRIPESIZE, m_buflen );
 	}
 
-#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::vector<std::thread> ThreadVector(PARALLELISM_DEGREE);
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadVector.at(i)=std::thread(&BLAKE2bp::ThreadUpdate,this,i,input,length);
-	for(std::vector<std::thread>::iterator it=ThreadVector.begin();it!=ThreadVector.end();++it)
-		it->join();
-#else
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadUpdate(i,input,length);
-#endif
-
-	input += length - length % ( PARALLELISM_DEGREE * BLOCKSIZE );
-	length %= PARALLELISM_DEGREE * BLOCKSIZE;
-
-	if( length > 0 )
-		memcpy( m_buf + left, input, length );
+	if( !m_buflen && length > MAX_BUFFERED )
+	{
+		const size_t Stripes = ( length - MAX_BUFFERED + STRIPESIZE - 1 ) / STRIPESIZE;
+		CompressStripes( input, Stripes );
+		input += Stripes * STRIPESIZE;
+		length -= Stripes * STRIPESIZE;
+	}
 
-	m_buflen = left + length;
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 void BLAKE2bp::TruncatedFinal(byte *digest, size_t digestSize)
@@ -705,15 +850,8 @@ void BLAKE2bp::TruncatedFinal(byte *digest, size_t digestSize)
 
 	for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
 	{
-		if( m_buflen > i * BLOCKSIZE )
-		{
-			size_t left = m_buflen - i * BLOCKSIZE;
-
-			if( left > BLOCKSIZE )
-				left = BLOCKSIZE;
-
-			m_Leaves.at(i).Update(  m_buf + i * BLOCKSIZE, left );
-		}
+		for( size_t Offset = i * BLOCKSIZE; Offset < m_buflen; Offset += STRIPESIZE )
+			m_Leaves.at(i).Update( m_buf + Offset, STDMIN<size_t>( BLOCKSIZE, m_buflen - Offset ) );
 
 		m_Leaves.at(i).Final( hash[i] );
 	}
@@ -726,6 +864,30 @@ void BLAKE2bp::TruncatedFinal(byte *digest, size_t digestSize)
 	Restart();
 }
 
+void BLAKE2bp::CompressStripes(const byte* input, size_t Stripes)
+{
+	// threads win on long inputs, otherwise all leaves run in the lanes of one register set
+	ThreadPool &Pool = ThreadPool::GetGlobalPool();
+	if(Pool.ShouldParallelize(Stripes*STRIPESIZE))
+		Pool.ParallelFor(PARALLELISM_DEGREE,this,&BLAKE2bp::ThreadUpdate,input,Stripes*STRIPESIZE);
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	else if(m_Implementation==BLAKE2b::AVX2_IMPLEMENTATION)
+	{
+		word64 *h[PARALLELISM_DEGREE], *t[PARALLELISM_DEGREE];
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		{
+			m_Leaves.at(i).FlushBuffer();
+			h[i]=m_Leaves.at(i).GetChainingValue();
+			t[i]=m_Leaves.at(i).GetCounter();
+		}
+		BLAKE2b_CompressLanesAVX2(h,t,input,Stripes);
+	}
+#endif
+	else
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+			ThreadUpdate(i,input,Stripes*STRIPESIZE);
+}
+
 void BLAKE2bp::ThreadUpdate(unsigned int ID,const byte* input, size_t length)
 {
 	uint64_t inlen__ = length;
@@ -808,8 +970,19 @@ void BLAKE2bpMAC::BLAKE2bMACLeaf::Restart()
 	Update(m_Key,BLOCKSIZE);
 }
 
+void BLAKE2bpMAC::BLAKE2bMACLeaf::FlushBuffer()
+{
+	if( m_buflen )
+	{
+		IncrementCounter( m_buflen );
+		Compress( m_buf );
+		m_buflen = 0;
+	}
+}
+
 BLAKE2bpMAC::BLAKE2bpMAC(unsigned int Digestsize,const byte* Key,unsigned int Keylength):
-	m_Root(Digestsize,Keylength),m_Digestsize(Digestsize),m_buflen(0)
+	m_Root(Digestsize,Keylength),m_Digestsize(Digestsize),m_buflen(0),
+	m_Implementation(BLAKE2b::GetBestImplementation())
 {
 	if(Digestsize>64 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
@@ -822,46 +995,51 @@ BLAKE2bpMAC::BLAKE2bpMAC(unsigned int Digestsize,const byte* Key,unsigned int Ke
 
 void BLAKE2bpMAC::Restart()
 {
+	m_buflen=0;
 	m_Root.Restart();
 	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
 		m_Leaves.at(i).Restart();
 }
 
-void BLAKE2bpMAC::Update(const byte *input, size_t length)
+void BLAKE2bpMAC::SetImplementation(BLAKE2b::Implementation Impl)
 {
-	size_t left = m_buflen;
-	size_t fill = m_buf.SizeInBytes() - left;
+	if(!BLAKE2b::IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2bpMAC: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+	m_Root.SetImplementation(Impl);
+	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		m_Leaves.at(i).SetImplementation(Impl);
+}
 
-	if( left && length >= fill )
+void BLAKE2bpMAC::Update(const byte *input, size_t length)
+{
+	// a stripe is compressed only once every leaf has got input behind it
+	while( m_buflen && m_buflen + length > MAX_BUFFERED )
 	{
-		memcpy( m_buf + left, input, fill );
-
-		for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
-			m_Leaves.at(i).Update( m_buf + i * BLOCKSIZE, BLOCKSIZE );
+		if( m_buflen < STRIPESIZE )
+		{
+			const size_t fill = STRIPESIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
+			m_buflen = STRIPESIZE;
+			input += fill;
+			length -= fill;
+		}
 
-		input += fill;
-		length -= fill;
-		left = 0;
+		CompressStripes( m_buf, 1 );
+		m_buflen -= STRIPESIZE;
+		memmove( m_buf, m_buf + STRIPESIZE, m_buflen );
 	}
 
-#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::vector<std::thread> ThreadVector(PARALLELISM_DEGREE);
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadVector.at(i)=std::thread(&BLAKE2bpMAC::ThreadUpdate,this,i,input,length);
-	for(std::vector<std::thread>::iterator it=ThreadVector.begin();it!=ThreadVector.end();++it)
-		it->join();
-#else
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadUpdate(i,input,length);
-#endif
-
-	input += length - length % ( PARALLELISM_DEGREE * BLOCKSIZE );
-	length %= PARALLELISM_DEGREE * BLOCKSIZE;
-
-	if( length > 0 )
-		memcpy( m_buf + left, input, length );
+	if( !m_buflen && length > MAX_BUFFERED )
+	{
+		const size_t Stripes = ( length - MAX_BUFFERED + STRIPESIZE - 1 ) / STRIPESIZE;
+		CompressStripes( input, Stripes );
+		input += Stripes * STRIPESIZE;
+		length -= Stripes * STRIPESIZE;
+	}
 
-	m_buflen = left + length;
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 void BLAKE2bpMAC::TruncatedFinal(byte *digest, size_t digestSize)
@@ -870,15 +1048,8 @@ void BLAKE2bpMAC::TruncatedFinal(byte *digest, size_t digestSize)
 
 	for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
 	{
-		if( m_buflen > i * BLOCKSIZE )
-		{
-			size_t left = m_buflen - i * BLOCKSIZE;
-
-			if( left > BLOCKSIZE )
-				left = BLOCKSIZE;
-
-			m_Leaves.at(i).Update(  m_buf + i * BLOCKSIZE, left );
-		}
+		for( size_t Offset = i * BLOCKSIZE; Offset < m_buflen; Offset += STRIPESIZE )
+			m_Leaves.at(i).Update( m_buf + Offset, STDMIN<size_t>( BLOCKSIZE, m_buflen - Offset ) );
 
 		m_Leaves.at(i).Final( hash[i] );
 	}
@@ -891,6 +1062,30 @@ void BLAKE2bpMAC::TruncatedFinal(byte *digest, size_t digestSize)
 	Restart();
 }
 
+void BLAKE2bpMAC::CompressStripes(const byte* input, size_t Stripes)
+{
+	// threads win on long inputs, otherwise all leaves run in the lanes of one register set
+	ThreadPool &Pool = ThreadPool::GetGlobalPool();
+	if(Pool.ShouldParallelize(Stripes*STRIPESIZE))
+		Pool.ParallelFor(PARALLELISM_DEGREE,this,&BLAKE2bpMAC::ThreadUpdate,input,Stripes*STRIPESIZE);
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	else if(m_Implementation==BLAKE2b::AVX2_IMPLEMENTATION)
+	{
+		word64 *h[PARALLELISM_DEGREE], *t[PARALLELISM_DEGREE];
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		{
+			m_Leaves.at(i).FlushBuffer();
+			h[i]=m_Leaves.at(i).GetChainingValue();
+			t[i]=m_Leaves.at(i).GetCounter();
+		}
+		BLAKE2b_CompressLanesAVX2(h,t,input,Stripes);
+	}
+#endif
+	else
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+			ThreadUpdate(i,input,Stripes*STRIPESIZE);
+}
+
 void BLAKE2bpMAC::ThreadUpdate(unsigned int ID,const byte* input, size_t length)
 {
 	uint64_t inlen__ = length;
@@ -17,10 +17,19 @@ class BLAKE2b : public HashTransformation
 public:
 	CRYPTOPP_CONSTANT(BLOCKSIZE = 128)
 	CRYPTOPP_CONSTANT(MAX_DIGEST_SIZE = 64)
+
+	//! implementations of the compression function, the constructor picks the fastest one the CPU supports
+	enum Implementation {REFERENCE_IMPLEMENTATION, SSSE3_IMPLEMENTATION, SSE41_IMPLEMENTATION, AVX2_IMPLEMENTATION};
+	static bool IsImplementationAvailable(Implementation Impl);
+	static Implementation GetBestImplementation();
 public:
 	BLAKE2b(unsigned int Digestsize);
 	unsigned int DigestSize() const {return m_Digestsize;}
 
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(Implementation Impl);
+	Implementation GetImplementation() const {return m_Implementation;}
+
 	unsigned int BlockSize() const {return BLOCKSIZE;}
 	std::string AlgorithmName() const {return "BLAKE2b-" + IntToString(m_Digestsize*8);}
 
@@ -38,7 +47,8 @@ protected:
 	size_t   m_buflen;
 	byte  m_last_node;
 	byte m_Digestsize;
-private:
+	Implementation m_Implementation;
+
 	inline void IncrementCounter(word64 inc)
 	{
 		m_t[0] += inc;
@@ -81,6 +91,10 @@ public:
 		m_Keylen=len;
 	}
 
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(BLAKE2b::Implementation Impl);
+	BLAKE2b::Implementation GetImplementation() const {return m_Implementation;}
+
 	void Update(const byte *input, size_t length);
 	void Restart();
 	void TruncatedFinal(byte *digest, size_t digestSize);
@@ -97,7 +111,8 @@ protected:
 	size_t   m_buflen;
 	byte  m_last_node;
 	byte m_Digestsize;
-private:
+	BLAKE2b::Implementation m_Implementation;
+
 	inline void IncrementCounter(word64 inc)
 	{
 		m_t[0] += inc;
@@ -125,6 +140,11 @@ class BLAKE2bp : public HashTransformation
 	public:
 		BLAKE2bLeaf(unsigned int DigestSize,bool IsLastNode,word64 Offset);
 		void Restart();
+
+		//! compresses a held back block, only valid if more input follows
+		void FlushBuffer();
+		word64 *GetChainingValue() {return m_h;}
+		word64 *GetCounter() {return m_t;}
 	private:
 		bool m_IsLastNode;
 		word64 m_Offset;
@@ -137,6 +157,11 @@ public:
 	BLAKE2bp(unsigned int Digestsize);
 	unsigned int DigestSize() const {return m_Digestsize;}
 
+	//! AVX2_IMPLEMENTATION hashes all leaves at once on the calling thread, one leaf per lane
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(BLAKE2b::Implementation Impl);
+	BLAKE2b::Implementation GetImplementation() const {return m_Implementation;}
+
 	unsigned int BlockSize() const {return BLOCKSIZE;}
 	std::string AlgorithmName() const {return "BLAKE2bp-" + IntToString(m_Digestsize*8);}
 
@@ -147,13 +172,20 @@ public:
 	unsigned int OptimalBlockSize() const {return BlockSize();}
 	unsigned int OptimalDataAlignment() const {return GetAlignmentOf<word64>();}
 private:
-	FixedSizeSecBlock<byte,PARALLELISM_DEGREE*BLOCKSIZE> m_buf;
+	// a stripe gives every leaf one block, the last block of a leaf may only be compressed
+	// by TruncatedFinal(), so up to a stripe and all but one block of the next one are held back
+	CRYPTOPP_CONSTANT(STRIPESIZE = PARALLELISM_DEGREE*BLOCKSIZE)
+	CRYPTOPP_CONSTANT(MAX_BUFFERED = 2*STRIPESIZE-BLOCKSIZE)
+
+	FixedSizeSecBlock<byte,MAX_BUFFERED> m_buf;
 	BLAKE2bRoot m_Root;
 	std::vector<BLAKE2bLeaf> m_Leaves;
 	size_t m_buflen;
 	byte m_Digestsize;
+	BLAKE2b::Implementation m_Implementation;
 private:
 	void ThreadUpdate(unsigned int ID,const byte* input, size_t length);
+	void CompressStripes(const byte* input, size_t Stripes);
 };
 
 class BLAKE2bpMAC :  public VariableKeyLength<64,1,64>, public MessageAuthenticationCode
@@ -171,6 +203,11 @@ class BLAKE2bpMAC :  public VariableKeyLength<64,1,64>, public MessageAuthentica
 	public:
 		BLAKE2bMACLeaf(unsigned int DigestSize,const byte* Key,unsigned int keylen,bool IsLastNode,word64 Offset);
 		void Restart();
+
+		//! compresses a held back block, only valid if more input follows
+		void FlushBuffer();
+		word64 *GetChainingValue() {return m_h;}
+		word64 *GetCounter() {return m_t;}
 	private:
 		bool m_IsLastNode;
 		word64 m_Offset;
@@ -201,6 +238,11 @@ public:
 			m_Leaves.at(i).SetKey(userkey,len,Pairs);
 	}
 
+	//! AVX2_IMPLEMENTATION hashes all leaves at once on the calling thread, one leaf per lane
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(BLAKE2b::Implementation Impl);
+	BLAKE2b::Implementation GetImplementation() const {return m_Implementation;}
+
 	void Update(const byte *input, size_t length);
 	void Restart();
 	void TruncatedFinal(byte *digest, size_t digestSize);
@@ -208,13 +250,20 @@ public:
 	unsigned int OptimalBlockSize() const {return BlockSize();}
 	unsigned int OptimalDataAlignment() const {return GetAlignmentOf<word64>();}
 private:
-	FixedSizeSecBlock<byte,PARALLELISM_DEGREE*BLOCKSIZE> m_buf;
+	// a stripe gives every leaf one block, the last block of a leaf may only be compressed
+	// by TruncatedFinal(), so up to a stripe and all but one block of the next one are held back
+	CRYPTOPP_CONSTANT(STRIPESIZE = PARALLELISM_DEGREE*BLOCKSIZE)
+	CRYPTOPP_CONSTANT(MAX_BUFFERED = 2*STRIPESIZE-BLOCKSIZE)
+
+	FixedSizeSecBlock<byte,MAX_BUFFERED> m_buf;
 	BLAKE2bMACRoot m_Root;
 	std::vector<BLAKE2bMACLeaf> m_Leaves;
 	size_t m_buflen;
 	byte m_Digestsize;
+	BLAKE2b::Implementation m_Implementation;
 private:
 	void ThreadUpdate(unsigned int ID,const byte* input, size_t length);
+	void CompressStripes(const byte* input, size_t Stripes);
 };
 
 
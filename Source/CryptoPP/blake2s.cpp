@@ -5,105 +5,7 @@
 #include "pch.h"
 #include "blake2s.h"
 #include "cpu.h"
-#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-#include <thread>
-#endif
-
-#define DISABLE_SSE_LOCALLY
-// for testing purposes:
-// NOTE: to get test-vector compliant results enable the  following:
-//#define CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE 0
-
-#define LOAD_MSG_0_1(buf) buf = _mm_set_epi32(m6,m4,m2,m0)
-#define LOAD_MSG_0_2(buf) buf = _mm_set_epi32(m7,m5,m3,m1)
-#define LOAD_MSG_0_3(buf) buf = _mm_set_epi32(m14,m12,m10,m8)
-#define LOAD_MSG_0_4(buf) buf = _mm_set_epi32(m15,m13,m11,m9)
-#define LOAD_MSG_1_1(buf) buf = _mm_set_epi32(m13,m9,m4,m14)
-#define LOAD_MSG_1_2(buf) buf = _mm_set_epi32(m6,m15,m8,m10)
-#define LOAD_MSG_1_3(buf) buf = _mm_set_epi32(m5,m11,m0,m1)
-#define LOAD_MSG_1_4(buf) buf = _mm_set_epi32(m3,m7,m2,m12)
-#define LOAD_MSG_2_1(buf) buf = _mm_set_epi32(m15,m5,m12,m11)
-#define LOAD_MSG_2_2(buf) buf = _mm_set_epi32(m13,m2,m0,m8)
-#define LOAD_MSG_2_3(buf) buf = _mm_set_epi32(m9,m7,m3,m10)
-#define LOAD_MSG_2_4(buf) buf = _mm_set_epi32(m4,m1,m6,m14)
-#define LOAD_MSG_3_1(buf) buf = _mm_set_epi32(m11,m13,m3,m7)
-#define LOAD_MSG_3_2(buf) buf = _mm_set_epi32(m14,m12,m1,m9)
-#define LOAD_MSG_3_3(buf) buf = _mm_set_epi32(m15,m4,m5,m2)
-#define LOAD_MSG_3_4(buf) buf = _mm_set_epi32(m8,m0,m10,m6)
-#define LOAD_MSG_4_1(buf) buf = _mm_set_epi32(m10,m2,m5,m9)
-#define LOAD_MSG_4_2(buf) buf = _mm_set_epi32(m15,m4,m7,m0)
-#define LOAD_MSG_4_3(buf) buf = _mm_set_epi32(m3,m6,m11,m14)
-#define LOAD_MSG_4_4(buf) buf = _mm_set_epi32(m13,m8,m12,m1)
-#define LOAD_MSG_5_1(buf) buf = _mm_set_epi32(m8,m0,m6,m2)
-#define LOAD_MSG_5_2(buf) buf = _mm_set_epi32(m3,m11,m10,m12)
-#define LOAD_MSG_5_3(buf) buf = _mm_set_epi32(m1,m15,m7,m4)
-#define LOAD_MSG_5_4(buf) buf = _mm_set_epi32(m9,m14,m5,m13)
-#define LOAD_MSG_6_1(buf) buf = _mm_set_epi32(m4,m14,m1,m12)
-#define LOAD_MSG_6_2(buf) buf = _mm_set_epi32(m10,m13,m15,m5)
-#define LOAD_MSG_6_3(buf) buf = _mm_set_epi32(m8,m9,m6,m0)
-#define LOAD_MSG_6_4(buf) buf = _mm_set_epi32(m11,m2,m3,m7)
-#define LOAD_MSG_7_1(buf) buf = _mm_set_epi32(m3,m12,m7,m13)
-#define LOAD_MSG_7_2(buf) buf = _mm_set_epi32(m9,m1,m14,m11)
-#define LOAD_MSG_7_3(buf) buf = _mm_set_epi32(m2,m8,m15,m5)
-#define LOAD_MSG_7_4(buf) buf = _mm_set_epi32(m10,m6,m4,m0)
-#define LOAD_MSG_8_1(buf) buf = _mm_set_epi32(m0,m11,m14,m6)
-#define LOAD_MSG_8_2(buf) buf = _mm_set_epi32(m8,m3,m9,m15)
-#define LOAD_MSG_8_3(buf) buf = _mm_set_epi32(m10,m1,m13,m12)
-#define LOAD_MSG_8_4(buf) buf = _mm_set_epi32(m5,m4,m7,m2)
-#define LOAD_MSG_9_1(buf) buf = _mm_set_epi32(m1,m7,m8,m10)
-#define LOAD_MSG_9_2(buf) buf = _mm_set_epi32(m5,m6,m4,m2)
-#define LOAD_MSG_9_3(buf) buf = _mm_set_epi32(m13,m3,m9,m15)
-#define LOAD_MSG_9_4(buf) buf = _mm_set_epi32(m0,m12,m14,m11)
-
-#define LOAD(p)  _mm_load_si128( (__m128i *)(p) )
-#define STORE(p,r) _mm_store_si128((__m128i *)(p), r)
-
-#define LOADU(p)  _mm_loadu_si128( (__m128i *)(p) )
-#define STOREU(p,r) _mm_storeu_si128((__m128i *)(p), r)
-
-#define _mm_roti_epi32(r, c) ( \
-				(8==-(c)) ? _mm_shuffle_epi8(r,r8) \
-			  : (16==-(c)) ? _mm_shuffle_epi8(r,r16) \
-			  : _mm_xor_si128(_mm_srli_epi32( (r), -(c) ),_mm_slli_epi32( (r), 32-(-(c)) )) )
-
-#define G1(row1,row2,row3,row4,buf) \
-  row1 = _mm_add_epi32( _mm_add_epi32( row1, buf), row2 ); \
-  row4 = _mm_xor_si128( row4, row1 ); \
-  row4 = _mm_roti_epi32(row4, -16); \
-  row3 = _mm_add_epi32( row3, row4 );   \
-  row2 = _mm_xor_si128( row2, row3 ); \
-  row2 = _mm_roti_epi32(row2, -12);
-
-#define G2(row1,row2,row3,row4,buf) \
-  row1 = _mm_add_epi32( _mm_add_epi32( row1, buf), row2 ); \
-  row4 = _mm_xor_si128( row4, row1 ); \
-  row4 = _mm_roti_epi32(row4, -8); \
-  row3 = _mm_add_epi32( row3, row4 );   \
-  row2 = _mm_xor_si128( row2, row3 ); \
-  row2 = _mm_roti_epi32(row2, -7);
-
-#define DIAGONALIZE(row1,row2,row3,row4) \
-  row4 = _mm_shuffle_epi32( row4, _MM_SHUFFLE(2,1,0,3) ); \
-  row3 = _mm_shuffle_epi32( row3, _MM_SHUFFLE(1,0,3,2) ); \
-  row2 = _mm_shuffle_epi32( row2, _MM_SHUFFLE(0,3,2,1) );
-
-#define UNDIAGONALIZE(row1,row2,row3,row4) \
-  row4 = _mm_shuffle_epi32( row4, _MM_SHUFFLE(0,3,2,1) ); \
-  row3 = _mm_shuffle_epi32( row3, _MM_SHUFFLE(1,0,3,2) ); \
-  row2 = _mm_shuffle_epi32( row2, _MM_SHUFFLE(2,1,0,3) );
-
-#define ROUND(r)  \
-  LOAD_MSG_ ##r ##_1(buf1); \
-  G1(row1,row2,row3,row4,buf1); \
-  LOAD_MSG_ ##r ##_2(buf2); \
-  G2(row1,row2,row3,row4,buf2); \
-  DIAGONALIZE(row1,row2,row3,row4); \
-  LOAD_MSG_ ##r ##_3(buf3); \
-  G1(row1,row2,row3,row4,buf3); \
-  LOAD_MSG_ ##r ##_4(buf4); \
-  G2(row1,row2,row3,row4,buf4); \
-  UNDIAGONALIZE(row1,row2,row3,row4); \
-
+#include "threadpool.h"
 
 NAMESPACE_BEGIN(CryptoPP)
 
@@ -127,8 +29,429 @@ CRYPTOPP_ALIGN_DATA(64) static const uint32_t blake2s_IV[8] =
   0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
 };
 
+static void BLAKE2s_CompressReference(word32 *h, const word32 *t, const word32 *f, const byte* block)
+{
+  word32 m[16];
+  word32 v[16];
+
+  for( size_t i = 0; i < 16; ++i )
+	  m[i] = GetWord<word32>(false, LITTLE_ENDIAN_ORDER, block + i * sizeof( m[i] ));
+
+  for( size_t i = 0; i < 8; ++i )
+	v[i] = h[i];
+
+  v[ 8] = blake2s_IV[0];
+  v[ 9] = blake2s_IV[1];
+  v[10] = blake2s_IV[2];
+  v[11] = blake2s_IV[3];
+  v[12] = t[0] ^ blake2s_IV[4];
+  v[13] = t[1] ^ blake2s_IV[5];
+  v[14] = f[0] ^ blake2s_IV[6];
+  v[15] = f[1] ^ blake2s_IV[7];
+#define GREF(r,i,a,b,c,d) \
+  do { \
+	a = a + b + m[blake2s_sigma[r][2*i+0]]; \
+	d = rotrFixed<word32>(d ^ a, 16); \
+	c = c + d; \
+	b = rotrFixed<word32>(b ^ c, 12); \
+	a = a + b + m[blake2s_sigma[r][2*i+1]]; \
+	d = rotrFixed<word32>(d ^ a, 8); \
+	c = c + d; \
+	b = rotrFixed<word32>(b ^ c, 7); \
+  } while(0)
+#define ROUNDREF(r)  \
+  do { \
+	GREF(r,0,v[ 0],v[ 4],v[ 8],v[12]); \
+	GREF(r,1,v[ 1],v[ 5],v[ 9],v[13]); \
+	GREF(r,2,v[ 2],v[ 6],v[10],v[14]); \
+	GREF(r,3,v[ 3],v[ 7],v[11],v[15]); \
+	GREF(r,4,v[ 0],v[ 5],v[10],v[15]); \
+	GREF(r,5,v[ 1],v[ 6],v[11],v[12]); \
+	GREF(r,6,v[ 2],v[ 7],v[ 8],v[13]); \
+	GREF(r,7,v[ 3],v[ 4],v[ 9],v[14]); \
+  } while(0)
+  ROUNDREF( 0 );
+  ROUNDREF( 1 );
+  ROUNDREF( 2 );
+  ROUNDREF( 3 );
+  ROUNDREF( 4 );
+  ROUNDREF( 5 );
+  ROUNDREF( 6 );
+  ROUNDREF( 7 );
+  ROUNDREF( 8 );
+  ROUNDREF( 9 );
+#undef GREF
+#undef ROUNDREF
+
+  for( size_t i = 0; i < 8; ++i )
+	h[i] = h[i] ^ v[i] ^ v[i + 8];
+}
+
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+// The loaders return (m_A,m_B,m_C,m_D), w is the message as words and m the message in four registers.
+struct BLAKE2s_LoaderSSSE3
+{
+	template <unsigned int A, unsigned int B, unsigned int C, unsigned int D>
+	static inline __m128i Load(const __m128i *, const word32 *w)
+	{
+		return _mm_setr_epi32(w[A], w[B], w[C], w[D]);
+	}
+};
+
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+// moves the words into their lanes inside each source register and blends the registers together
+struct BLAKE2s_LoaderSSE41
+{
+	template <unsigned int A, unsigned int B, unsigned int C, unsigned int D>
+	static inline __m128i Load(const __m128i *m, const word32 *)
+	{
+#define BLAKE2S_LANES(R) ((A/4==(R) ? 0x03 : 0) | (B/4==(R) ? 0x0C : 0) | (C/4==(R) ? 0x30 : 0) | (D/4==(R) ? 0xC0 : 0))
+		__m128i r = _mm_shuffle_epi32(m[A/4], _MM_SHUFFLE(D%4,C%4,B%4,A%4));
+		if (B/4 != A/4)
+			r = _mm_blend_epi16(r, _mm_shuffle_epi32(m[B/4], _MM_SHUFFLE(D%4,C%4,B%4,A%4)), BLAKE2S_LANES(B/4));
+		if (C/4 != A/4 && C/4 != B/4)
+			r = _mm_blend_epi16(r, _mm_shuffle_epi32(m[C/4], _MM_SHUFFLE(D%4,C%4,B%4,A%4)), BLAKE2S_LANES(C/4));
+		if (D/4 != A/4 && D/4 != B/4 && D/4 != C/4)
+			r = _mm_blend_epi16(r, _mm_shuffle_epi32(m[D/4], _MM_SHUFFLE(D%4,C%4,B%4,A%4)), BLAKE2S_LANES(D/4));
+#undef BLAKE2S_LANES
+		return r;
+	}
+};
+#endif
+
+#define BLAKE2S_ROTR16(x) _mm_shuffle_epi8((x), r16)
+#define BLAKE2S_ROTR12(x) _mm_xor_si128(_mm_srli_epi32((x), 12), _mm_slli_epi32((x), 20))
+#define BLAKE2S_ROTR8(x) _mm_shuffle_epi8((x), r8)
+#define BLAKE2S_ROTR7(x) _mm_xor_si128(_mm_srli_epi32((x), 7), _mm_slli_epi32((x), 25))
+
+#define BLAKE2S_G(b,R1,R2) \
+  row1 = _mm_add_epi32(_mm_add_epi32(row1, b), row2); \
+  row4 = R1(_mm_xor_si128(row4, row1)); \
+  row3 = _mm_add_epi32(row3, row4); \
+  row2 = R2(_mm_xor_si128(row2, row3));
+
+// row2 is the last result of G and everything else waits for it, so rows 1, 3 and 4 are rotated instead.
+// Lane i then works on the diagonal starting in column i-1, which the message order accounts for.
+#define BLAKE2S_DIAGONALIZE() \
+  row1 = _mm_shuffle_epi32(row1, _MM_SHUFFLE(2,1,0,3)); \
+  row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(1,0,3,2)); \
+  row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(0,3,2,1));
+
+#define BLAKE2S_UNDIAGONALIZE() \
+  row1 = _mm_shuffle_epi32(row1, _MM_SHUFFLE(0,3,2,1)); \
+  row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(1,0,3,2)); \
+  row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(2,1,0,3));
+
+#define BLAKE2S_ROUND(s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12,s13,s14,s15) \
+  b = LOADER::template Load<s0,s2,s4,s6>(m, w); \
+  BLAKE2S_G(b, BLAKE2S_ROTR16, BLAKE2S_ROTR12) \
+  b = LOADER::template Load<s1,s3,s5,s7>(m, w); \
+  BLAKE2S_G(b, BLAKE2S_ROTR8, BLAKE2S_ROTR7) \
+  BLAKE2S_DIAGONALIZE() \
+  b = LOADER::template Load<s14,s8,s10,s12>(m, w); \
+  BLAKE2S_G(b, BLAKE2S_ROTR16, BLAKE2S_ROTR12) \
+  b = LOADER::template Load<s15,s9,s11,s13>(m, w); \
+  BLAKE2S_G(b, BLAKE2S_ROTR8, BLAKE2S_ROTR7) \
+  BLAKE2S_UNDIAGONALIZE()
+
+template <class LOADER>
+static void BLAKE2s_CompressSSE(word32 *h, const word32 *t, const word32 *f, const byte* block)
+{
+  __m128i row1, row2, row3, row4;
+  __m128i b;
+  __m128i m[4];
+  word32 w[16];
+  const __m128i r8 = _mm_setr_epi8( 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 );
+  const __m128i r16 = _mm_setr_epi8( 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 );
+
+  for( int i = 0; i < 4; ++i )
+  {
+	m[i] = _mm_loadu_si128( (const __m128i *)(block + 16*i) );
+	_mm_storeu_si128( (__m128i *)(w + 4*i), m[i] );
+  }
+
+  row1 = _mm_loadu_si128( (const __m128i *)&h[0] );
+  row2 = _mm_loadu_si128( (const __m128i *)&h[4] );
+  row3 = _mm_loadu_si128( (const __m128i *)&blake2s_IV[0] );
+  row4 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&blake2s_IV[4] ), _mm_setr_epi32( t[0], t[1], f[0], f[1] ) );
+
+  BLAKE2S_ROUND(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)
+  BLAKE2S_ROUND(14,10,4,8,9,15,13,6,1,12,0,2,11,7,5,3)
+  BLAKE2S_ROUND(11,8,12,0,5,2,15,13,10,14,3,6,7,1,9,4)
+  BLAKE2S_ROUND(7,9,3,1,13,12,11,14,2,6,5,10,4,0,15,8)
+  BLAKE2S_ROUND(9,0,5,7,2,4,10,15,14,1,11,12,6,8,3,13)
+  BLAKE2S_ROUND(2,12,6,10,0,11,8,3,4,13,7,5,15,14,1,9)
+  BLAKE2S_ROUND(12,5,1,15,14,13,4,10,0,7,6,3,9,2,8,11)
+  BLAKE2S_ROUND(13,11,7,14,12,1,3,9,5,0,15,4,8,6,2,10)
+  BLAKE2S_ROUND(6,15,14,9,11,3,0,8,12,2,13,7,1,4,10,5)
+  BLAKE2S_ROUND(10,2,8,4,7,6,1,5,15,11,9,14,3,12,13,0)
+
+  _mm_storeu_si128( (__m128i *)&h[0], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[0] ), _mm_xor_si128( row1, row3 ) ) );
+  _mm_storeu_si128( (__m128i *)&h[4], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[4] ), _mm_xor_si128( row2, row4 ) ) );
+}
+
+#undef BLAKE2S_ROUND
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+// The message fits into two registers, so two message vectors are assembled at once with two vpermd and a vpblendd.
+template <unsigned int A0, unsigned int A1, unsigned int A2, unsigned int A3, unsigned int A4, unsigned int A5, unsigned int A6, unsigned int A7>
+static inline __m256i BLAKE2s_LoadAVX2(__m256i mlo, __m256i mhi)
+{
+	const __m256i idx = _mm256_setr_epi32(A0%8, A1%8, A2%8, A3%8, A4%8, A5%8, A6%8, A7%8);
+	return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(mlo, idx), _mm256_permutevar8x32_epi32(mhi, idx),
+		(A0/8) | ((A1/8)<<1) | ((A2/8)<<2) | ((A3/8)<<3) | ((A4/8)<<4) | ((A5/8)<<5) | ((A6/8)<<6) | ((A7/8)<<7));
+}
+
+#define BLAKE2S_ROUND(s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12,s13,s14,s15) \
+  b = BLAKE2s_LoadAVX2<s0,s2,s4,s6,s1,s3,s5,s7>(mlo, mhi); \
+  BLAKE2S_G(_mm256_castsi256_si128(b), BLAKE2S_ROTR16, BLAKE2S_ROTR12) \
+  BLAKE2S_G(_mm256_extracti128_si256(b, 1), BLAKE2S_ROTR8, BLAKE2S_ROTR7) \
+  BLAKE2S_DIAGONALIZE() \
+  b = BLAKE2s_LoadAVX2<s14,s8,s10,s12,s15,s9,s11,s13>(mlo, mhi); \
+  BLAKE2S_G(_mm256_castsi256_si128(b), BLAKE2S_ROTR16, BLAKE2S_ROTR12) \
+  BLAKE2S_G(_mm256_extracti128_si256(b, 1), BLAKE2S_ROTR8, BLAKE2S_ROTR7) \
+  BLAKE2S_UNDIAGONALIZE()
+
+static void BLAKE2s_CompressAVX2(word32 *h, const word32 *t, const word32 *f, const byte* block)
+{
+  __m128i row1, row2, row3, row4;
+  __m256i b;
+  const __m256i mlo = _mm256_loadu_si256( (const __m256i *)block );
+  const __m256i mhi = _mm256_loadu_si256( (const __m256i *)(block + 32) );
+  const __m128i r8 = _mm_setr_epi8( 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 );
+  const __m128i r16 = _mm_setr_epi8( 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 );
+
+  row1 = _mm_loadu_si128( (const __m128i *)&h[0] );
+  row2 = _mm_loadu_si128( (const __m128i *)&h[4] );
+  row3 = _mm_loadu_si128( (const __m128i *)&blake2s_IV[0] );
+  row4 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&blake2s_IV[4] ), _mm_setr_epi32( t[0], t[1], f[0], f[1] ) );
+
+  BLAKE2S_ROUND(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)
+  BLAKE2S_ROUND(14,10,4,8,9,15,13,6,1,12,0,2,11,7,5,3)
+  BLAKE2S_ROUND(11,8,12,0,5,2,15,13,10,14,3,6,7,1,9,4)
+  BLAKE2S_ROUND(7,9,3,1,13,12,11,14,2,6,5,10,4,0,15,8)
+  BLAKE2S_ROUND(9,0,5,7,2,4,10,15,14,1,11,12,6,8,3,13)
+  BLAKE2S_ROUND(2,12,6,10,0,11,8,3,4,13,7,5,15,14,1,9)
+  BLAKE2S_ROUND(12,5,1,15,14,13,4,10,0,7,6,3,9,2,8,11)
+  BLAKE2S_ROUND(13,11,7,14,12,1,3,9,5,0,15,4,8,6,2,10)
+  BLAKE2S_ROUND(6,15,14,9,11,3,0,8,12,2,13,7,1,4,10,5)
+  BLAKE2S_ROUND(10,2,8,4,7,6,1,5,15,11,9,14,3,12,13,0)
+
+  _mm_storeu_si128( (__m128i *)&h[0], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[0] ), _mm_xor_si128( row1, row3 ) ) );
+  _mm_storeu_si128( (__m128i *)&h[4], _mm_xor_si128( _mm_loadu_si128( (const __m128i *)&h[4] ), _mm_xor_si128( row2, row4 ) ) );
+  _mm256_zeroupper();
+}
+
+#undef BLAKE2S_ROUND
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+#undef BLAKE2S_UNDIAGONALIZE
+#undef BLAKE2S_DIAGONALIZE
+#undef BLAKE2S_G
+#undef BLAKE2S_ROTR7
+#undef BLAKE2S_ROTR8
+#undef BLAKE2S_ROTR12
+#undef BLAKE2S_ROTR16
+#endif // CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+// Lane i of every register belongs to leaf i of a BLAKE2sp tree, so G only needs vertical operations
+// and the message words come straight out of an 8x8 transpose of the interleaved leaf blocks.
+#define BLAKE2S_ROTR16(x) _mm256_shuffle_epi8((x), r16)
+#define BLAKE2S_ROTR12(x) _mm256_xor_si256(_mm256_srli_epi32((x), 12), _mm256_slli_epi32((x), 20))
+#define BLAKE2S_ROTR8(x) _mm256_shuffle_epi8((x), r8)
+#define BLAKE2S_ROTR7(x) _mm256_xor_si256(_mm256_srli_epi32((x), 7), _mm256_slli_epi32((x), 25))
+
+#define BLAKE2S_G(r,i,a,b,c,d) \
+  a = _mm256_add_epi32(_mm256_add_epi32(a, b), m[blake2s_sigma[r][2*i+0]]); \
+  d = BLAKE2S_ROTR16(_mm256_xor_si256(d, a)); \
+  c = _mm256_add_epi32(c, d); \
+  b = BLAKE2S_ROTR12(_mm256_xor_si256(b, c)); \
+  a = _mm256_add_epi32(_mm256_add_epi32(a, b), m[blake2s_sigma[r][2*i+1]]); \
+  d = BLAKE2S_ROTR8(_mm256_xor_si256(d, a)); \
+  c = _mm256_add_epi32(c, d); \
+  b = BLAKE2S_ROTR7(_mm256_xor_si256(b, c));
+
+#define BLAKE2S_ROUND(r) \
+  BLAKE2S_G(r,0,v[ 0],v[ 4],v[ 8],v[12]) \
+  BLAKE2S_G(r,1,v[ 1],v[ 5],v[ 9],v[13]) \
+  BLAKE2S_G(r,2,v[ 2],v[ 6],v[10],v[14]) \
+  BLAKE2S_G(r,3,v[ 3],v[ 7],v[11],v[15]) \
+  BLAKE2S_G(r,4,v[ 0],v[ 5],v[10],v[15]) \
+  BLAKE2S_G(r,5,v[ 1],v[ 6],v[11],v[12]) \
+  BLAKE2S_G(r,6,v[ 2],v[ 7],v[ 8],v[13]) \
+  BLAKE2S_G(r,7,v[ 3],v[ 4],v[ 9],v[14])
+
+// turns eight rows of eight words into eight columns, it is its own inverse
+static inline void BLAKE2s_Transpose8x8(__m256i *x)
+{
+  const __m256i t0 = _mm256_unpacklo_epi32(x[0], x[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(x[0], x[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(x[2], x[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(x[2], x[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(x[4], x[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(x[4], x[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(x[6], x[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(x[6], x[7]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  x[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  x[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  x[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  x[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  x[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  x[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  x[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  x[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// Compresses Stripes consecutive stripes of eight blocks, block i of a stripe goes into the state h[i],t[i].
+// None of the blocks may be the last one of its leaf, so the finalization flags are always clear.
+static void BLAKE2s_CompressLanesAVX2(word32 *const h[8], word32 *const t[8], const byte *input, size_t Stripes)
+{
+  __m256i v[16], m[16], hv[8];
+  const __m256i r8 = _mm256_setr_epi8( 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 );
+  const __m256i r16 = _mm256_setr_epi8( 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 );
+  word32 t0[8], t1[8];
+
+  for( int i = 0; i < 8; ++i )
+  {
+	hv[i] = _mm256_loadu_si256( (const __m256i *)h[i] );
+	t0[i] = t[i][0];
+	t1[i] = t[i][1];
+  }
+  BLAKE2s_Transpose8x8( hv );
+
+  for( ; Stripes; --Stripes, input += 8*BLAKE2s::BLOCKSIZE )
+  {
+	for( int j = 0; j < 16; j += 8 )
+	{
+	  for( int i = 0; i < 8; ++i )
+		m[j+i] = _mm256_loadu_si256( (const __m256i *)(input + i*BLAKE2s::BLOCKSIZE + 4*j) );
+	  BLAKE2s_Transpose8x8( m + j );
+	}
+
+	for( int i = 0; i < 8; ++i )
+	{
+	  t0[i] += BLAKE2s::BLOCKSIZE;
+	  t1[i] += ( t0[i] < BLAKE2s::BLOCKSIZE );
+	}
+
+	for( int i = 0; i < 8; ++i )
+	{
+	  v[i] = hv[i];
+	  v[i+8] = _mm256_set1_epi32( blake2s_IV[i] );
+	}
+	v[12] = _mm256_xor_si256( v[12], _mm256_loadu_si256( (const __m256i *)t0 ) );
+	v[13] = _mm256_xor_si256( v[13], _mm256_loadu_si256( (const __m256i *)t1 ) );
+
+	BLAKE2S_ROUND( 0 );
+	BLAKE2S_ROUND( 1 );
+	BLAKE2S_ROUND( 2 );
+	BLAKE2S_ROUND( 3 );
+	BLAKE2S_ROUND( 4 );
+	BLAKE2S_ROUND( 5 );
+	BLAKE2S_ROUND( 6 );
+	BLAKE2S_ROUND( 7 );
+	BLAKE2S_ROUND( 8 );
+	BLAKE2S_ROUND( 9 );
+
+	for( int i = 0; i < 8; ++i )
+	  hv[i] = _mm256_xor_si256( hv[i], _mm256_xor_si256( v[i], v[i+8] ) );
+  }
+
+  BLAKE2s_Transpose8x8( hv );
+  for( int i = 0; i < 8; ++i )
+  {
+	_mm256_storeu_si256( (__m256i *)h[i], hv[i] );
+	t[i][0] = t0[i];
+	t[i][1] = t1[i];
+  }
+  _mm256_zeroupper();
+}
+
+#undef BLAKE2S_ROUND
+#undef BLAKE2S_G
+#undef BLAKE2S_ROTR7
+#undef BLAKE2S_ROTR8
+#undef BLAKE2S_ROTR12
+#undef BLAKE2S_ROTR16
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+static void BLAKE2s_Compress(BLAKE2s::Implementation Impl, word32 *h, const word32 *t, const word32 *f, const byte* block)
+{
+	switch(Impl)
+	{
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	case BLAKE2s::AVX2_IMPLEMENTATION:
+		BLAKE2s_CompressAVX2(h,t,f,block);
+		break;
+#endif
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+	case BLAKE2s::SSE41_IMPLEMENTATION:
+		BLAKE2s_CompressSSE<BLAKE2s_LoaderSSE41>(h,t,f,block);
+		break;
+#endif
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+	case BLAKE2s::SSSE3_IMPLEMENTATION:
+		BLAKE2s_CompressSSE<BLAKE2s_LoaderSSSE3>(h,t,f,block);
+		break;
+#endif
+	default:
+		BLAKE2s_CompressReference(h,t,f,block);
+	}
+}
+
+bool BLAKE2s::IsImplementationAvailable(Implementation Impl)
+{
+	switch(Impl)
+	{
+	case REFERENCE_IMPLEMENTATION:
+		return true;
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+	case SSSE3_IMPLEMENTATION:
+		return HasSSSE3();
+#endif
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+	case SSE41_IMPLEMENTATION:
+		return HasSSE41();
+#endif
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	case AVX2_IMPLEMENTATION:
+		return HasAVX2();
+#endif
+	default:
+		return false;
+	}
+}
+
+BLAKE2s::Implementation BLAKE2s::GetBestImplementation()
+{
+	if(IsImplementationAvailable(AVX2_IMPLEMENTATION))
+		return AVX2_IMPLEMENTATION;
+	if(IsImplementationAvailable(SSE41_IMPLEMENTATION))
+		return SSE41_IMPLEMENTATION;
+	if(IsImplementationAvailable(SSSE3_IMPLEMENTATION))
+		return SSSE3_IMPLEMENTATION;
+	return REFERENCE_IMPLEMENTATION;
+}
+
+void BLAKE2s::SetImplementation(Implementation Impl)
+{
+	if(!IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2s: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+}
+
 BLAKE2s::BLAKE2s(unsigned int Digestsize) :
-	m_Digestsize(Digestsize)
+	m_Digestsize(Digestsize),
+	m_Implementation(GetBestImplementation())
 {
 	if(Digestsize>32 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
@@ -160,30 +483,32 @@ void BLAKE2s::Restart()
 
 void BLAKE2s::Update(const byte *input, size_t length)
 {
-	while( length > 0 )
+	// the last block may only be compressed by TruncatedFinal(), so it always stays in the buffer
+	if( m_buflen + length > BLOCKSIZE )
 	{
-		size_t left = m_buflen;
-		size_t fill = 2 * BLOCKSIZE - left;
-
-		if( length > fill )
+		if( m_buflen )
 		{
-			memcpy( m_buf + left, input, fill ); // Fill buffer
-			m_buflen += fill;
+			const size_t fill = BLOCKSIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
 			IncrementCounter( BLOCKSIZE );
-			Compress( m_buf ); // Compress
-			memcpy( m_buf, m_buf + BLOCKSIZE, BLOCKSIZE ); // Shift buffer left
-			m_buflen -= BLOCKSIZE;
+			Compress( m_buf );
+			m_buflen = 0;
 			input += fill;
 			length -= fill;
 		}
-		else // inlen <= fill
+
+		// compress straight from the input
+		while( length > BLOCKSIZE )
 		{
-			memcpy( m_buf + left, input, length );
-			m_buflen += length; // Be lazy, do not compress
-			input += length;
-			length -= length;
+			IncrementCounter( BLOCKSIZE );
+			Compress( input );
+			input += BLOCKSIZE;
+			length -= BLOCKSIZE;
 		}
 	}
+
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 void BLAKE2s::TruncatedFinal(byte *digest, size_t digestSize)
@@ -214,112 +539,12 @@ void BLAKE2s::TruncatedFinal(byte *digest, size_t digestSize)
 
 void BLAKE2s::Compress(const byte* block)
 {
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-if(HasSSSE3() && HasSSE2())
-{
-	__m128i row1, row2, row3, row4;
-	__m128i buf1, buf2, buf3, buf4;
-	__m128i ff0, ff1;
-	const __m128i r8 = _mm_set_epi8( 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1 );
-	const __m128i r16 = _mm_set_epi8( 13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2 );
-	const word32  m0 = ( ( word32 * )block )[ 0];
-	const word32  m1 = ( ( word32 * )block )[ 1];
-	const word32  m2 = ( ( word32 * )block )[ 2];
-	const word32  m3 = ( ( word32 * )block )[ 3];
-	const word32  m4 = ( ( word32 * )block )[ 4];
-	const word32  m5 = ( ( word32 * )block )[ 5];
-	const word32  m6 = ( ( word32 * )block )[ 6];
-	const word32  m7 = ( ( word32 * )block )[ 7];
-	const word32  m8 = ( ( word32 * )block )[ 8];
-	const word32  m9 = ( ( word32 * )block )[ 9];
-	const word32 m10 = ( ( word32 * )block )[10];
-	const word32 m11 = ( ( word32 * )block )[11];
-	const word32 m12 = ( ( word32 * )block )[12];
-	const word32 m13 = ( ( word32 * )block )[13];
-	const word32 m14 = ( ( word32 * )block )[14];
-	const word32 m15 = ( ( word32 * )block )[15];
-	row1 = ff0 = LOADU( &m_h[0] );
-	row2 = ff1 = LOADU( &m_h[4] );
-	row3 = _mm_setr_epi32( 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A );
-	row4 = _mm_xor_si128( _mm_setr_epi32( 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 ), LOADU( &m_t[0] ) );
-	ROUND( 0 );
-	ROUND( 1 );
-	ROUND( 2 );
-	ROUND( 3 );
-	ROUND( 4 );
-	ROUND( 5 );
-	ROUND( 6 );
-	ROUND( 7 );
-	ROUND( 8 );
-	ROUND( 9 );
-	STOREU( &m_h[0], _mm_xor_si128( ff0, _mm_xor_si128( row1, row3 ) ) );
-	STOREU( &m_h[4], _mm_xor_si128( ff1, _mm_xor_si128( row2, row4 ) ) );
-}
-else
-{
-#endif
-  word32 m[16];
-  word32 v[16];
-
-  for( size_t i = 0; i < 16; ++i )
-	  m[i] = ConditionalByteReverse<word32>(LITTLE_ENDIAN_ORDER,*((word32*)( block + i * sizeof( m[i] ) )));
-
-  for( size_t i = 0; i < 8; ++i )
-	v[i] = m_h[i];
-
-  v[ 8] = blake2s_IV[0];
-  v[ 9] = blake2s_IV[1];
-  v[10] = blake2s_IV[2];
-  v[11] = blake2s_IV[3];
-  v[12] = m_t[0] ^ blake2s_IV[4];
-  v[13] = m_t[1] ^ blake2s_IV[5];
-  v[14] = m_f[0] ^ blake2s_IV[6];
-  v[15] = m_f[1] ^ blake2s_IV[7];
-#define GREF(r,i,a,b,c,d) \
-  do { \
-	a = a + b + m[blake2s_sigma[r][2*i+0]]; \
-	d = rotrFixed<word32>(d ^ a, 16); \
-	c = c + d; \
-	b = rotrFixed<word32>(b ^ c, 12); \
-	a = a + b + m[blake2s_sigma[r][2*i+1]]; \
-	d = rotrFixed<word32>(d ^ a, 8); \
-	c = c + d; \
-	b = rotrFixed<word32>(b ^ c, 7); \
-  } while(0)
-#define ROUNDREF(r)  \
-  do { \
-	GREF(r,0,v[ 0],v[ 4],v[ 8],v[12]); \
-	GREF(r,1,v[ 1],v[ 5],v[ 9],v[13]); \
-	GREF(r,2,v[ 2],v[ 6],v[10],v[14]); \
-	GREF(r,3,v[ 3],v[ 7],v[11],v[15]); \
-	GREF(r,4,v[ 0],v[ 5],v[10],v[15]); \
-	GREF(r,5,v[ 1],v[ 6],v[11],v[12]); \
-	GREF(r,6,v[ 2],v[ 7],v[ 8],v[13]); \
-	GREF(r,7,v[ 3],v[ 4],v[ 9],v[14]); \
-  } while(0)
-  ROUNDREF( 0 );
-  ROUNDREF( 1 );
-  ROUNDREF( 2 );
-  ROUNDREF( 3 );
-  ROUNDREF( 4 );
-  ROUNDREF( 5 );
-  ROUNDREF( 6 );
-  ROUNDREF( 7 );
-  ROUNDREF( 8 );
-  ROUNDREF( 9 );
-
-  for( size_t i = 0; i < 8; ++i )
-	m_h[i] = m_h[i] ^ v[i] ^ v[i + 8];
-
-#undef GREF
-#undef ROUNDREF
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-}
-#endif
+	BLAKE2s_Compress(m_Implementation,m_h,m_t,m_f,block);
 }
 
 BLAKE2sMAC::BLAKE2sMAC(unsigned int Digestsize,const byte* Key,unsigned int Keylength) :
-	m_Digestsize(Digestsize)
+	m_Digestsize(Digestsize),
+	m_Implementation(BLAKE2s::GetBestImplementation())
 {
 	if(Digestsize>32 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
@@ -356,32 +581,41 @@ void BLAKE2sMAC::Restart()
 	Update(m_Key,BLOCKSIZE);
 }
 
+void BLAKE2sMAC::SetImplementation(BLAKE2s::Implementation Impl)
+{
+	if(!BLAKE2s::IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2s-MAC: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+}
+
 void BLAKE2sMAC::Update(const byte *input, size_t length)
 {
-	while( length > 0 )
+	// the last block may only be compressed by TruncatedFinal(), so it always stays in the buffer
+	if( m_buflen + length > BLOCKSIZE )
 	{
-		size_t left = m_buflen;
-		size_t fill = 2 * BLOCKSIZE - left;
-
-		if( length > fill )
+		if( m_buflen )
 		{
-			memcpy( m_buf + left, input, fill ); // Fill buffer
-			m_buflen += fill;
+			const size_t fill = BLOCKSIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
 			IncrementCounter( BLOCKSIZE );
-			Compress( m_buf ); // Compress
-			memcpy( m_buf, m_buf + BLOCKSIZE, BLOCKSIZE ); // Shift buffer left
-			m_buflen -= BLOCKSIZE;
+			Compress( m_buf );
+			m_buflen = 0;
 			input += fill;
 			length -= fill;
 		}
-		else // inlen <= fill
+
+		// compress straight from the input
+		while( length > BLOCKSIZE )
 		{
-			memcpy( m_buf + left, input, length );
-			m_buflen += length; // Be lazy, do not compress
-			input += length;
-			length -= length;
+			IncrementCounter( BLOCKSIZE );
+			Compress( input );
+			input += BLOCKSIZE;
+			length -= BLOCKSIZE;
 		}
 	}
+
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 void BLAKE2sMAC::TruncatedFinal(byte *digest, size_t digestSize)
@@ -412,108 +646,7 @@ void BLAKE2sMAC::TruncatedFinal(byte *digest, size_t digestSize)
 
 void BLAKE2sMAC::Compress(const byte* block)
 {
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-if(HasSSSE3() && HasSSE2())
-{
-	__m128i row1, row2, row3, row4;
-	__m128i buf1, buf2, buf3, buf4;
-	__m128i ff0, ff1;
-	const __m128i r8 = _mm_set_epi8( 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1 );
-	const __m128i r16 = _mm_set_epi8( 13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2 );
-	const word32  m0 = ( ( word32 * )block )[ 0];
-	const word32  m1 = ( ( word32 * )block )[ 1];
-	const word32  m2 = ( ( word32 * )block )[ 2];
-	const word32  m3 = ( ( word32 * )block )[ 3];
-	const word32  m4 = ( ( word32 * )block )[ 4];
-	const word32  m5 = ( ( word32 * )block )[ 5];
-	const word32  m6 = ( ( word32 * )block )[ 6];
-	const word32  m7 = ( ( word32 * )block )[ 7];
-	const word32  m8 = ( ( word32 * )block )[ 8];
-	const word32  m9 = ( ( word32 * )block )[ 9];
-	const word32 m10 = ( ( word32 * )block )[10];
-	const word32 m11 = ( ( word32 * )block )[11];
-	const word32 m12 = ( ( word32 * )block )[12];
-	const word32 m13 = ( ( word32 * )block )[13];
-	const word32 m14 = ( ( word32 * )block )[14];
-	const word32 m15 = ( ( word32 * )block )[15];
-	row1 = ff0 = LOADU( &m_h[0] );
-	row2 = ff1 = LOADU( &m_h[4] );
-	row3 = _mm_setr_epi32( 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A );
-	row4 = _mm_xor_si128( _mm_setr_epi32( 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 ), LOADU( &m_t[0] ) );
-	ROUND( 0 );
-	ROUND( 1 );
-	ROUND( 2 );
-	ROUND( 3 );
-	ROUND( 4 );
-	ROUND( 5 );
-	ROUND( 6 );
-	ROUND( 7 );
-	ROUND( 8 );
-	ROUND( 9 );
-	STOREU( &m_h[0], _mm_xor_si128( ff0, _mm_xor_si128( row1, row3 ) ) );
-	STOREU( &m_h[4], _mm_xor_si128( ff1, _mm_xor_si128( row2, row4 ) ) );
-}
-else
-{
-#endif
-  word32 m[16];
-  word32 v[16];
-
-  for( size_t i = 0; i < 16; ++i )
-	  m[i] = ConditionalByteReverse<word32>(LITTLE_ENDIAN_ORDER,*((word32*)( block + i * sizeof( m[i] ) )));
-
-  for( size_t i = 0; i < 8; ++i )
-	v[i] = m_h[i];
-
-  v[ 8] = blake2s_IV[0];
-  v[ 9] = blake2s_IV[1];
-  v[10] = blake2s_IV[2];
-  v[11] = blake2s_IV[3];
-  v[12] = m_t[0] ^ blake2s_IV[4];
-  v[13] = m_t[1] ^ blake2s_IV[5];
-  v[14] = m_f[0] ^ blake2s_IV[6];
-  v[15] = m_f[1] ^ blake2s_IV[7];
-#define GREF(r,i,a,b,c,d) \
-  do { \
-	a = a + b + m[blake2s_sigma[r][2*i+0]]; \
-	d = rotrFixed<word32>(d ^ a, 16); \
-	c = c + d; \
-	b = rotrFixed<word32>(b ^ c, 12); \
-	a = a + b + m[blake2s_sigma[r][2*i+1]]; \
-	d = rotrFixed<word32>(d ^ a, 8); \
-	c = c + d; \
-	b = rotrFixed<word32>(b ^ c, 7); \
-  } while(0)
-#define ROUNDREF(r)  \
-  do { \
-	GREF(r,0,v[ 0],v[ 4],v[ 8],v[12]); \
-	GREF(r,1,v[ 1],v[ 5],v[ 9],v[13]); \
-	GREF(r,2,v[ 2],v[ 6],v[10],v[14]); \
-	GREF(r,3,v[ 3],v[ 7],v[11],v[15]); \
-	GREF(r,4,v[ 0],v[ 5],v[10],v[15]); \
-	GREF(r,5,v[ 1],v[ 6],v[11],v[12]); \
-	GREF(r,6,v[ 2],v[ 7],v[ 8],v[13]); \
-	GREF(r,7,v[ 3],v[ 4],v[ 9],v[14]); \
-  } while(0)
-  ROUNDREF( 0 );
-  ROUNDREF( 1 );
-  ROUNDREF( 2 );
-  ROUNDREF( 3 );
-  ROUNDREF( 4 );
-  ROUNDREF( 5 );
-  ROUNDREF( 6 );
-  ROUNDREF( 7 );
-  ROUNDREF( 8 );
-  ROUNDREF( 9 );
-
-  for( size_t i = 0; i < 8; ++i )
-	m_h[i] = m_h[i] ^ v[i] ^ v[i + 8];
-
-#undef GREF
-#undef ROUNDREF
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-}
-#endif
+	BLAKE2s_Compress(m_Implementation,m_h,m_t,m_f,block);
 }
 
 BLAKE2sp::BLAKE2sRoot::BLAKE2sRoot(unsigned int DigestSize) :
@@ -535,8 +668,8 @@ void BLAKE2sp::BLAKE2sRoot::Restart()
 	Params[0]=m_Digestsize;
 	Params[2]=PARALLELISM_DEGREE; //fanout
 	Params[3]=2; //depth
-	Params[16]=1; // node_depth
-	Params[17]=MAX_DIGEST_SIZE; // inner length
+	Params[14]=1; // node_depth
+	Params[15]=MAX_DIGEST_SIZE; // inner length
 
 	const byte* IVPtr = (const byte*) blake2s_IV;
 	const byte* ParamsPtr = Params;
@@ -567,8 +700,8 @@ void BLAKE2sp::BLAKE2sLeaf::Restart()
 	Params[0]=m_Digestsize;
 	Params[2]=PARALLELISM_DEGREE; //fanout
 	Params[3]=2; //depth
-	*((word64*)(&Params[8]))=m_Offset; // node_depth
-	Params[17]=MAX_DIGEST_SIZE; // inner length
+	*((word32*)(&Params[8]))=(word32)m_Offset; // offset
+	Params[15]=MAX_DIGEST_SIZE; // inner length
 
 	const byte* IVPtr = (const byte*) blake2s_IV;
 	const byte* ParamsPtr = Params;
@@ -577,58 +710,76 @@ void BLAKE2sp::BLAKE2sLeaf::Restart()
 		m_h.BytePtr()[i] = IVPtr[i] ^ ParamsPtr[i];
 }
 
+void BLAKE2sp::BLAKE2sLeaf::FlushBuffer()
+{
+	if( m_buflen )
+	{
+		IncrementCounter( m_buflen );
+		Compress( m_buf );
+		m_buflen = 0;
+	}
+}
+
 BLAKE2sp::BLAKE2sp(unsigned int Digestsize):
-	m_Root(Digestsize),m_Digestsize(Digestsize),m_buflen(0)
+	m_Root(Digestsize),m_Digestsize(Digestsize),m_buflen(0),
+	m_Implementation(BLAKE2s::GetBestImplementation())
 {
 	if(Digestsize>32 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
 
 	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
 		m_Leaves.push_back(BLAKE2sLeaf(Digestsize,i==(PARALLELISM_DEGREE-1),i));
+
+	Restart();
 }
 
 void BLAKE2sp::Restart()
 {
+	m_buflen=0;
 	m_Root.Restart();
 	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
 		m_Leaves.at(i).Restart();
 }
 
-void BLAKE2sp::Update(const byte *input, size_t length)
+void BLAKE2sp::SetImplementation(BLAKE2s::Implementation Impl)
 {
-	size_t left = m_buflen;
-	size_t fill = m_buf.SizeInBytes() - left;
+	if(!BLAKE2s::IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2sp: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+	m_Root.SetImplementation(Impl);
+	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		m_Leaves.at(i).SetImplementation(Impl);
+}
 
-	if( left && length >= fill )
+void BLAKE2sp::Update(const byte *input, size_t length)
+{
+	// a stripe is compressed only once every leaf has got input behind it
+	while( m_buflen && m_buflen + length > MAX_BUFFERED )
 	{
-		memcpy( m_buf + left, input, fill );
-
-		for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
-			m_Leaves.at(i).Update( m_buf + i * BLOCKSIZE, BLOCKSIZE );
+		if( m_buflen < STRIPESIZE )
+		{
+			const size_t fill = STRIPESIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
+			m_buflen = STRIPESIZE;
+			input += fill;
+			length -= fill;
+		}
 
-		input += fill;
-		length -= fill;
-		left = 0;
+		CompressStripes( m_buf, 1 );
+		m_buflen -= STRIPESIZE;
+		memmove( m_buf, m_buf + STRIPESIZE, m_buflen );
 	}
 
-#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::vector<std::thread> ThreadVector(PARALLELISM_DEGREE);
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadVector.at(i)=std::thread(&BLAKE2sp::ThreadUpdate,this,i,input,length);
-	for(std::vector<std::thread>::iterator it=ThreadVector.begin();it!=ThreadVector.end();++it)
-		it->join();
-#else
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadUpdate(i,input,length);
-#endif
-
-	input += length - length % ( PARALLELISM_DEGREE * BLOCKSIZE );
-	length %= PARALLELISM_DEGREE * BLOCKSIZE;
-
-	if( length > 0 )
-		memcpy( m_buf + left, input, length );
+	if( !m_buflen && length > MAX_BUFFERED )
+	{
+		const size_t Stripes = ( length - MAX_BUFFERED + STRIPESIZE - 1 ) / STRIPESIZE;
+		CompressStripes( input, Stripes );
+		input += Stripes * STRIPESIZE;
+		length -= Stripes * STRIPESIZE;
+	}
 
-	m_buflen = left + length;
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 void BLAKE2sp::TruncatedFinal(byte *digest, size_t digestSize)
@@ -637,15 +788,8 @@ void BLAKE2sp::TruncatedFinal(byte *digest, size_t digestSize)
 
 	for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
 	{
-		if( m_buflen > i * BLOCKSIZE )
-		{
-			size_t left = m_buflen - i * BLOCKSIZE;
-
-			if( left > BLOCKSIZE )
-				left = BLOCKSIZE;
-
-			m_Leaves.at(i).Update(  m_buf + i * BLOCKSIZE, left );
-		}
+		for( size_t Offset = i * BLOCKSIZE; Offset < m_buflen; Offset += STRIPESIZE )
+			m_Leaves.at(i).Update( m_buf + Offset, STDMIN<size_t>( BLOCKSIZE, m_buflen - Offset ) );
 
 		m_Leaves.at(i).Final( hash[i] );
 	}
@@ -658,6 +802,30 @@ void BLAKE2sp::TruncatedFinal(byte *digest, size_t digestSize)
 	Restart();
 }
 
+void BLAKE2sp::CompressStripes(const byte* input, size_t Stripes)
+{
+	// threads win on long inputs, otherwise all leaves run in the lanes of one register set
+	ThreadPool &Pool = ThreadPool::GetGlobalPool();
+	if(Pool.ShouldParallelize(Stripes*STRIPESIZE))
+		Pool.ParallelFor(PARALLELISM_DEGREE,this,&BLAKE2sp::ThreadUpdate,input,Stripes*STRIPESIZE);
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	else if(m_Implementation==BLAKE2s::AVX2_IMPLEMENTATION)
+	{
+		word32 *h[PARALLELISM_DEGREE], *t[PARALLELISM_DEGREE];
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		{
+			m_Leaves.at(i).FlushBuffer();
+			h[i]=m_Leaves.at(i).GetChainingValue();
+			t[i]=m_Leaves.at(i).GetCounter();
+		}
+		BLAKE2s_CompressLanesAVX2(h,t,input,Stripes);
+	}
+#endif
+	else
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+			ThreadUpdate(i,input,Stripes*STRIPESIZE);
+}
+
 void BLAKE2sp::ThreadUpdate(unsigned int ID,const byte* input, size_t length)
 {
 	uint64_t inlen__ = length;
@@ -740,8 +908,19 @@ void BLAKE2spMAC::BLAKE2sMACLeaf::Restart()
 	Update(m_Key,BLOCKSIZE);
 }
 
+void BLAKE2spMAC::BLAKE2sMACLeaf::FlushBuffer()
+{
+	if( m_buflen )
+	{
+		IncrementCounter( m_buflen );
+		Compress( m_buf );
+		m_buflen = 0;
+	}
+}
+
 BLAKE2spMAC::BLAKE2spMAC(unsigned int Digestsize,const byte* Key,unsigned int Keylength):
-	m_Root(Digestsize,Keylength),m_Digestsize(Digestsize),m_buflen(0)
+	m_Root(Digestsize,Keylength),m_Digestsize(Digestsize),m_buflen(0),
+	m_Implementation(BLAKE2s::GetBestImplementation())
 {
 	if(Digestsize>32 || !Digestsize)
 		throw(InvalidArgument("invalid Digestsize!"));
@@ -754,46 +933,51 @@ BLAKE2spMAC::BLAKE2spMAC(unsigned int Digestsize,const byte* Key,unsigned int Ke
 
 void BLAKE2spMAC::Restart()
 {
+	m_buflen=0;
 	m_Root.Restart();
 	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
 		m_Leaves.at(i).Restart();
 }
 
-void BLAKE2spMAC::Update(const byte *input, size_t length)
+void BLAKE2spMAC::SetImplementation(BLAKE2s::Implementation Impl)
 {
-	size_t left = m_buflen;
-	size_t fill = m_buf.SizeInBytes() - left;
+	if(!BLAKE2s::IsImplementationAvailable(Impl))
+		throw(InvalidArgument("BLAKE2spMAC: the requested implementation isn't available on this CPU"));
+	m_Implementation=Impl;
+	m_Root.SetImplementation(Impl);
+	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		m_Leaves.at(i).SetImplementation(Impl);
+}
 
-	if( left && length >= fill )
+void BLAKE2spMAC::Update(const byte *input, size_t length)
+{
+	// a stripe is compressed only once every leaf has got input behind it
+	while( m_buflen && m_buflen + length > MAX_BUFFERED )
 	{
-		memcpy( m_buf + left, input, fill );
-
-		for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
-			m_Leaves.at(i).Update( m_buf + i * BLOCKSIZE, BLOCKSIZE );
+		if( m_buflen < STRIPESIZE )
+		{
+			const size_t fill = STRIPESIZE - m_buflen;
+			memcpy( m_buf + m_buflen, input, fill );
+			m_buflen = STRIPESIZE;
+			input += fill;
+			length -= fill;
+		}
 
-		input += fill;
-		length -= fill;
-		left = 0;
+		CompressStripes( m_buf, 1 );
+		m_buflen -= STRIPESIZE;
+		memmove( m_buf, m_buf + STRIPESIZE, m_buflen );
 	}
 
-#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
-	std::vector<std::thread> ThreadVector(PARALLELISM_DEGREE);
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadVector.at(i)=std::thread(&BLAKE2spMAC::ThreadUpdate,this,i,input,length);
-	for(std::vector<std::thread>::iterator it=ThreadVector.begin();it!=ThreadVector.end();++it)
-		it->join();
-#else
-	for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
-		ThreadUpdate(i,input,length);
-#endif
-
-	input += length - length % ( PARALLELISM_DEGREE * BLOCKSIZE );
-	length %= PARALLELISM_DEGREE * BLOCKSIZE;
-
-	if( length > 0 )
-		memcpy( m_buf + left, input, length );
+	if( !m_buflen && length > MAX_BUFFERED )
+	{
+		const size_t Stripes = ( length - MAX_BUFFERED + STRIPESIZE - 1 ) / STRIPESIZE;
+		CompressStripes( input, Stripes );
+		input += Stripes * STRIPESIZE;
+		length -= Stripes * STRIPESIZE;
+	}
 
-	m_buflen = left + length;
+	memcpy( m_buf + m_buflen, input, length );
+	m_buflen += length;
 }
 
 void BLAKE2spMAC::TruncatedFinal(byte *digest, size_t digestSize)
@@ -802,15 +986,8 @@ void BLAKE2spMAC::TruncatedFinal(byte *digest, size_t digestSize)
 
 	for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
 	{
-		if( m_buflen > i * BLOCKSIZE )
-		{
-			size_t left = m_buflen - i * BLOCKSIZE;
-
-			if( left > BLOCKSIZE )
-				left = BLOCKSIZE;
-
-			m_Leaves.at(i).Update(  m_buf + i * BLOCKSIZE, left );
-		}
+		for( size_t Offset = i * BLOCKSIZE; Offset < m_buflen; Offset += STRIPESIZE )
+			m_Leaves.at(i).Update( m_buf + Offset, STDMIN<size_t>( BLOCKSIZE, m_buflen - Offset ) );
 
 		m_Leaves.at(i).Final( hash[i] );
 	}
@@ -823,6 +1000,30 @@ void BLAKE2spMAC::TruncatedFinal(byte *digest, size_t digestSize)
 	Restart();
 }
 
+void BLAKE2spMAC::CompressStripes(const byte* input, size_t Stripes)
+{
+	// threads win on long inputs, otherwise all leaves run in the lanes of one register set
+	ThreadPool &Pool = ThreadPool::GetGlobalPool();
+	if(Pool.ShouldParallelize(Stripes*STRIPESIZE))
+		Pool.ParallelFor(PARALLELISM_DEGREE,this,&BLAKE2spMAC::ThreadUpdate,input,Stripes*STRIPESIZE);
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	else if(m_Implementation==BLAKE2s::AVX2_IMPLEMENTATION)
+	{
+		word32 *h[PARALLELISM_DEGREE], *t[PARALLELISM_DEGREE];
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+		{
+			m_Leaves.at(i).FlushBuffer();
+			h[i]=m_Leaves.at(i).GetChainingValue();
+			t[i]=m_Leaves.at(i).GetCounter();
+		}
+		BLAKE2s_CompressLanesAVX2(h,t,input,Stripes);
+	}
+#endif
+	else
+		for(unsigned int i=0;i<PARALLELISM_DEGREE;++i)
+			ThreadUpdate(i,input,Stripes*STRIPESIZE);
+}
+
 void BLAKE2spMAC::ThreadUpdate(unsigned int ID,const byte* input, size_t length)
 {
 	uint64_t inlen__ = length;
@@ -17,9 +17,18 @@ class BLAKE2s : public HashTransformation
 public:
 	CRYPTOPP_CONSTANT(BLOCKSIZE = 64)
 	CRYPTOPP_CONSTANT(MAX_DIGEST_SIZE = 32)
+
+	//! implementations of the compression function, the constructor picks the fastest one the CPU supports
+	enum Implementation {REFERENCE_IMPLEMENTATION, SSSE3_IMPLEMENTATION, SSE41_IMPLEMENTATION, AVX2_IMPLEMENTATION};
+	static bool IsImplementationAvailable(Implementation Impl);
+	static Implementation GetBestImplementation();
 public:
 	BLAKE2s(unsigned int Digestsize);
 
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(Implementation Impl);
+	Implementation GetImplementation() const {return m_Implementation;}
+
 	unsigned int BlockSize() const {return BLOCKSIZE;}
 	unsigned int DigestSize() const {return static_cast<unsigned int>(m_Digestsize);}
 	std::string AlgorithmName() const {return "BLAKE2s-" + IntToString(m_Digestsize*8);}
@@ -38,7 +47,8 @@ protected:
 	size_t   m_buflen;
 	byte  m_last_node;
 	byte m_Digestsize;
-private:
+	Implementation m_Implementation;
+
 	inline void IncrementCounter(word64 inc)
 	{
 		uint64_t t = ( ( uint64_t )m_t[1] << 32 ) | m_t[0];
@@ -84,6 +94,10 @@ public:
 		m_Keylen=len;
 	}
 
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(BLAKE2s::Implementation Impl);
+	BLAKE2s::Implementation GetImplementation() const {return m_Implementation;}
+
 	void Update(const byte *input, size_t length);
 	void Restart();
 	void TruncatedFinal(byte *digest, size_t digestSize);
@@ -100,7 +114,8 @@ protected:
 	size_t   m_buflen;
 	byte  m_last_node;
 	byte m_Digestsize;
-private:
+	BLAKE2s::Implementation m_Implementation;
+
 	inline void IncrementCounter(word64 inc)
 	{
 		uint64_t t = ( ( uint64_t )m_t[1] << 32 ) | m_t[0];
@@ -130,6 +145,11 @@ class BLAKE2sp : public HashTransformation
 	public:
 		BLAKE2sLeaf(unsigned int DigestSize,bool IsLastNode,word64 Offset);
 		void Restart();
+
+		//! compresses a held back block, only valid if more input follows
+		void FlushBuffer();
+		word32 *GetChainingValue() {return m_h;}
+		word32 *GetCounter() {return m_t;}
 	private:
 		bool m_IsLastNode;
 		word64 m_Offset;
@@ -142,6 +162,11 @@ public:
 	BLAKE2sp(unsigned int Digestsize);
 	unsigned int DigestSize() const {return m_Digestsize;}
 
+	//! AVX2_IMPLEMENTATION hashes all leaves at once on the calling thread, one leaf per lane
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(BLAKE2s::Implementation Impl);
+	BLAKE2s::Implementation GetImplementation() const {return m_Implementation;}
+
 	unsigned int BlockSize() const {return BLOCKSIZE;}
 	std::string AlgorithmName() const {return "BLAKE2sp-" + IntToString(m_Digestsize*8);}
 
@@ -152,13 +177,20 @@ public:
 	unsigned int OptimalBlockSize() const {return BlockSize();}
 	unsigned int OptimalDataAlignment() const {return GetAlignmentOf<word64>();}
 private:
-	FixedSizeSecBlock<byte,PARALLELISM_DEGREE*BLOCKSIZE> m_buf;
+	// a stripe gives every leaf one block, the last block of a leaf may only be compressed
+	// by TruncatedFinal(), so up to a stripe and all but one block of the next one are held back
+	CRYPTOPP_CONSTANT(STRIPESIZE = PARALLELISM_DEGREE*BLOCKSIZE)
+	CRYPTOPP_CONSTANT(MAX_BUFFERED = 2*STRIPESIZE-BLOCKSIZE)
+
+	FixedSizeSecBlock<byte,MAX_BUFFERED> m_buf;
 	BLAKE2sRoot m_Root;
 	std::vector<BLAKE2sLeaf> m_Leaves;
 	size_t m_buflen;
 	byte m_Digestsize;
+	BLAKE2s::Implementation m_Implementation;
 private:
 	void ThreadUpdate(unsigned int ID,const byte* input, size_t length);
+	void CompressStripes(const byte* input, size_t Stripes);
 };
 
 class BLAKE2spMAC :  public VariableKeyLength<32,1,32>, public MessageAuthenticationCode
@@ -176,6 +208,11 @@ class BLAKE2spMAC :  public VariableKeyLength<32,1,32>, public MessageAuthentica
 	public:
 		BLAKE2sMACLeaf(unsigned int DigestSize,const byte* Key,unsigned int keylen,bool IsLastNode,word32 Offset);
 		void Restart();
+
+		//! compresses a held back block, only valid if more input follows
+		void FlushBuffer();
+		word32 *GetChainingValue() {return m_h;}
+		word32 *GetCounter() {return m_t;}
 	private:
 		bool m_IsLastNode;
 		word32 m_Offset;
@@ -206,6 +243,11 @@ public:
 			m_Leaves.at(i).SetKey(userkey,len,Pairs);
 	}
 
+	//! AVX2_IMPLEMENTATION hashes all leaves at once on the calling thread, one leaf per lane
+	//! throws InvalidArgument if the CPU doesn't support Impl
+	void SetImplementation(BLAKE2s::Implementation Impl);
+	BLAKE2s::Implementation GetImplementation() const {return m_Implementation;}
+
 	void Update(const byte *input, size_t length);
 	void Restart();
 	void TruncatedFinal(byte *digest, size_t digestSize);
@@ -213,13 +255,20 @@ public:
 	unsigned int OptimalBlockSize() const {return BlockSize();}
 	unsigned int OptimalDataAlignment() const {return GetAlignmentOf<word64>();}
 private:
-	FixedSizeSecBlock<byte,PARALLELISM_DEGREE*BLOCKSIZE> m_buf;
+	// a stripe gives every leaf one block, the last block of a leaf may only be compressed
+	// by TruncatedFinal(), so up to a stripe and all but one block of the next one are held back
+	CRYPTOPP_CONSTANT(STRIPESIZE = PARALLELISM_DEGREE*BLOCKSIZE)
+	CRYPTOPP_CONSTANT(MAX_BUFFERED = 2*STRIPESIZE-BLOCKSIZE)
+
+	FixedSizeSecBlock<byte,MAX_BUFFERED> m_buf;
 	BLAKE2sMACRoot m_Root;
 	std::vector<BLAKE2sMACLeaf> m_Leaves;
 	size_t m_buflen;
 	byte m_Digestsize;
+	BLAKE2s::Implementation m_Implementation;
 private:
 	void ThreadUpdate(unsigned int ID,const byte* input, size_t length);
+	void CompressStripes(const byte* input, size_t Stripes);
 };
 
 NAMESPACE_END
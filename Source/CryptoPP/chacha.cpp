@@ -0,0 +1,366 @@
+// chacha.cpp - ChaCha20 with SSE2 and AVX2 multi-block keystream generation
+
+#include "pch.h"
+#include "chacha.h"
+#include "misc.h"
+#include "argnames.h"
+#include "cpu.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+void ChaCha20_TestInstantiations()
+{
+	ChaCha20::Encryption x;
+	ChaCha20IETF::Encryption y;
+}
+
+void ChaCha20_Policy::CipherSetKey(const NameValuePairs &params, const byte *key, size_t length)
+{
+	m_rounds = params.GetIntValueWithDefault(Name::Rounds(), 20);
+
+	if (!(m_rounds == 8 || m_rounds == 12 || m_rounds == 20))
+		throw InvalidRounds(ChaCha20::StaticAlgorithmName(), m_rounds);
+
+	// "expand 16-byte k" or "expand 32-byte k"
+	m_state[0] = 0x61707865;
+	m_state[1] = (length == 16) ? 0x3120646e : 0x3320646e;
+	m_state[2] = (length == 16) ? 0x79622d36 : 0x79622d32;
+	m_state[3] = 0x6b206574;
+
+	GetBlock<word32, LittleEndian> get1(key);
+	get1(m_state[4])(m_state[5])(m_state[6])(m_state[7]);
+	GetBlock<word32, LittleEndian> get2(key + length - 16);
+	get2(m_state[8])(m_state[9])(m_state[10])(m_state[11]);
+}
+
+void ChaCha20_Policy::CipherResynchronize(byte *keystreamBuffer, const byte *IV, size_t length)
+{
+	assert(length==8);
+	GetBlock<word32, LittleEndian> get(IV);
+	get(m_state[14])(m_state[15]);
+	m_state[12] = m_state[13] = 0;
+}
+
+void ChaCha20_Policy::SeekToIteration(lword iterationCount)
+{
+	m_state[12] = (word32)iterationCount;
+	m_state[13] = (word32)SafeRightShift<32>(iterationCount);
+}
+
+#if CRYPTOPP_BOOL_X86 || CRYPTOPP_BOOL_X64
+unsigned int ChaCha20_Policy::GetOptimalBlockSize() const
+{
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	if (HasAVX2())
+		return 8*BYTES_PER_ITERATION;
+	else
+#endif
+#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+	if (HasSSE2())
+		return 4*BYTES_PER_ITERATION;
+	else
+#endif
+		return BYTES_PER_ITERATION;
+}
+#endif
+
+#define CHACHA_QUARTER_ROUND(a, b, c, d)	\
+	a += b; d = rotlFixed(d ^ a, 16);	\
+	c += d; b = rotlFixed(b ^ c, 12);	\
+	a += b; d = rotlFixed(d ^ a, 8);	\
+	c += d; b = rotlFixed(b ^ c, 7);
+
+// Lane i of every vector register belongs to block i of the batch, so a quarter round on the
+// registers is four or eight quarter rounds at once and the counter is the only word that differs.
+// The rotations are the only operations without a vertical instruction, SSE2 gets 16 from word
+// shuffles and AVX2 gets 8 and 16 from byte shuffles.
+
+#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+#define CHACHA_ROTL_SSE2(x, n) _mm_or_si128(_mm_slli_epi32((x), n), _mm_srli_epi32((x), 32-n))
+#define CHACHA_ROTL16_SSE2(x) _mm_shufflehi_epi16(_mm_shufflelo_epi16((x), _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1))
+
+#define CHACHA_QUARTER_ROUND_SSE2(a, b, c, d) \
+	a = _mm_add_epi32(a, b); d = CHACHA_ROTL16_SSE2(_mm_xor_si128(d, a)); \
+	c = _mm_add_epi32(c, d); b = CHACHA_ROTL_SSE2(_mm_xor_si128(b, c), 12); \
+	a = _mm_add_epi32(a, b); d = CHACHA_ROTL_SSE2(_mm_xor_si128(d, a), 8); \
+	c = _mm_add_epi32(c, d); b = CHACHA_ROTL_SSE2(_mm_xor_si128(b, c), 7);
+
+// word j of four blocks in x[j..j+3] becomes words j to j+3 of block i in x[i]
+static inline void ChaCha20_Transpose4x4(__m128i *x)
+{
+	const __m128i t0 = _mm_unpacklo_epi32(x[0], x[1]);
+	const __m128i t1 = _mm_unpackhi_epi32(x[0], x[1]);
+	const __m128i t2 = _mm_unpacklo_epi32(x[2], x[3]);
+	const __m128i t3 = _mm_unpackhi_epi32(x[2], x[3]);
+	x[0] = _mm_unpacklo_epi64(t0, t2);
+	x[1] = _mm_unpackhi_epi64(t0, t2);
+	x[2] = _mm_unpacklo_epi64(t1, t3);
+	x[3] = _mm_unpackhi_epi64(t1, t3);
+}
+
+// Writes Batches times four blocks of keystream, xored with input unless it is NULL, and advances the counter in state.
+static void ChaCha20_OperateKeystreamSSE2(word32 *state, int rounds, byte *output, const byte *input, size_t Batches)
+{
+	__m128i v[16], s[16];
+	for( int i = 0; i < 16; ++i )
+	  s[i] = _mm_set1_epi32( state[i] );
+
+	for( ; Batches; --Batches, output += 256, input = input ? input + 256 : NULL )
+	{
+	  const word64 Counter = state[12] | ( word64( state[13] ) << 32 );
+	  s[12] = _mm_setr_epi32( word32( Counter ), word32( Counter+1 ), word32( Counter+2 ), word32( Counter+3 ) );
+	  s[13] = _mm_setr_epi32( word32( Counter>>32 ), word32( (Counter+1)>>32 ), word32( (Counter+2)>>32 ), word32( (Counter+3)>>32 ) );
+
+	  for( int i = 0; i < 16; ++i )
+		v[i] = s[i];
+
+	  for( int i = rounds; i > 0; i -= 2 )
+	  {
+		CHACHA_QUARTER_ROUND_SSE2( v[0], v[4], v[ 8], v[12] )
+		CHACHA_QUARTER_ROUND_SSE2( v[1], v[5], v[ 9], v[13] )
+		CHACHA_QUARTER_ROUND_SSE2( v[2], v[6], v[10], v[14] )
+		CHACHA_QUARTER_ROUND_SSE2( v[3], v[7], v[11], v[15] )
+
+		CHACHA_QUARTER_ROUND_SSE2( v[0], v[5], v[10], v[15] )
+		CHACHA_QUARTER_ROUND_SSE2( v[1], v[6], v[11], v[12] )
+		CHACHA_QUARTER_ROUND_SSE2( v[2], v[7], v[ 8], v[13] )
+		CHACHA_QUARTER_ROUND_SSE2( v[3], v[4], v[ 9], v[14] )
+	  }
+
+	  for( int i = 0; i < 16; ++i )
+		v[i] = _mm_add_epi32( v[i], s[i] );
+
+	  for( int j = 0; j < 16; j += 4 )
+	  {
+		ChaCha20_Transpose4x4( v + j );
+		for( int i = 0; i < 4; ++i )
+		{
+		  __m128i t = v[j+i];
+		  if( input )
+			t = _mm_xor_si128( t, _mm_loadu_si128( (const __m128i *)(input + 64*i + 4*j) ) );
+		  _mm_storeu_si128( (__m128i *)(output + 64*i + 4*j), t );
+		}
+	  }
+
+	  state[12] = word32( Counter+4 );
+	  state[13] = word32( (Counter+4)>>32 );
+	}
+}
+
+#undef CHACHA_QUARTER_ROUND_SSE2
+#undef CHACHA_ROTL16_SSE2
+#undef CHACHA_ROTL_SSE2
+#endif // CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+#define CHACHA_ROTL_AVX2(x, n) _mm256_or_si256(_mm256_slli_epi32((x), n), _mm256_srli_epi32((x), 32-n))
+
+#define CHACHA_QUARTER_ROUND_AVX2(a, b, c, d) \
+	a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), r16); \
+	c = _mm256_add_epi32(c, d); b = CHACHA_ROTL_AVX2(_mm256_xor_si256(b, c), 12); \
+	a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), r8); \
+	c = _mm256_add_epi32(c, d); b = CHACHA_ROTL_AVX2(_mm256_xor_si256(b, c), 7);
+
+// word j of eight blocks in x[j..j+7] becomes words j to j+7 of block i in x[i]
+static inline void ChaCha20_Transpose8x8(__m256i *x)
+{
+	const __m256i t0 = _mm256_unpacklo_epi32(x[0], x[1]);
+	const __m256i t1 = _mm256_unpackhi_epi32(x[0], x[1]);
+	const __m256i t2 = _mm256_unpacklo_epi32(x[2], x[3]);
+	const __m256i t3 = _mm256_unpackhi_epi32(x[2], x[3]);
+	const __m256i t4 = _mm256_unpacklo_epi32(x[4], x[5]);
+	const __m256i t5 = _mm256_unpackhi_epi32(x[4], x[5]);
+	const __m256i t6 = _mm256_unpacklo_epi32(x[6], x[7]);
+	const __m256i t7 = _mm256_unpackhi_epi32(x[6], x[7]);
+	const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+	const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+	const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+	const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+	const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+	const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+	const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+	const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+	x[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+	x[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+	x[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+	x[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+	x[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+	x[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+	x[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+	x[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// Writes Batches times eight blocks of keystream, xored with input unless it is NULL, and advances the counter in state.
+static void ChaCha20_OperateKeystreamAVX2(word32 *state, int rounds, byte *output, const byte *input, size_t Batches)
+{
+	__m256i v[16], s[16];
+	const __m256i r8 = _mm256_setr_epi8( 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14 );
+	const __m256i r16 = _mm256_setr_epi8( 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 );
+	for( int i = 0; i < 16; ++i )
+	  s[i] = _mm256_set1_epi32( state[i] );
+
+	for( ; Batches; --Batches, output += 512, input = input ? input + 512 : NULL )
+	{
+	  const word64 Counter = state[12] | ( word64( state[13] ) << 32 );
+	  word32 CounterLo[8], CounterHi[8];
+	  for( int i = 0; i < 8; ++i )
+	  {
+		CounterLo[i] = word32( Counter+i );
+		CounterHi[i] = word32( (Counter+i)>>32 );
+	  }
+	  s[12] = _mm256_loadu_si256( (const __m256i *)CounterLo );
+	  s[13] = _mm256_loadu_si256( (const __m256i *)CounterHi );
+
+	  for( int i = 0; i < 16; ++i )
+		v[i] = s[i];
+
+	  for( int i = rounds; i > 0; i -= 2 )
+	  {
+		CHACHA_QUARTER_ROUND_AVX2( v[0], v[4], v[ 8], v[12] )
+		CHACHA_QUARTER_ROUND_AVX2( v[1], v[5], v[ 9], v[13] )
+		CHACHA_QUARTER_ROUND_AVX2( v[2], v[6], v[10], v[14] )
+		CHACHA_QUARTER_ROUND_AVX2( v[3], v[7], v[11], v[15] )
+
+		CHACHA_QUARTER_ROUND_AVX2( v[0], v[5], v[10], v[15] )
+		CHACHA_QUARTER_ROUND_AVX2( v[1], v[6], v[11], v[12] )
+		CHACHA_QUARTER_ROUND_AVX2( v[2], v[7], v[ 8], v[13] )
+		CHACHA_QUARTER_ROUND_AVX2( v[3], v[4], v[ 9], v[14] )
+	  }
+
+	  for( int i = 0; i < 16; ++i )
+		v[i] = _mm256_add_epi32( v[i], s[i] );
+
+	  for( int j = 0; j < 16; j += 8 )
+	  {
+		ChaCha20_Transpose8x8( v + j );
+		for( int i = 0; i < 8; ++i )
+		{
+		  __m256i t = v[j+i];
+		  if( input )
+			t = _mm256_xor_si256( t, _mm256_loadu_si256( (const __m256i *)(input + 64*i + 4*j) ) );
+		  _mm256_storeu_si256( (__m256i *)(output + 64*i + 4*j), t );
+		}
+	  }
+
+	  state[12] = word32( Counter+8 );
+	  state[13] = word32( (Counter+8)>>32 );
+	}
+	_mm256_zeroupper();
+}
+
+#undef CHACHA_QUARTER_ROUND_AVX2
+#undef CHACHA_ROTL_AVX2
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+void ChaCha20_Policy::OperateKeystream(KeystreamOperation operation, byte *output, const byte *input, size_t iterationCount)
+{
+	if (operation & INPUT_NULL)
+		input = NULL;
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	if (HasAVX2() && iterationCount >= 8)
+	{
+		const size_t batches = iterationCount / 8;
+		ChaCha20_OperateKeystreamAVX2(m_state, m_rounds, output, input, batches);
+		output += batches*8*BYTES_PER_ITERATION;
+		if (input)
+			input += batches*8*BYTES_PER_ITERATION;
+		iterationCount %= 8;
+	}
+#endif
+#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+	if (HasSSE2() && iterationCount >= 4)
+	{
+		const size_t batches = iterationCount / 4;
+		ChaCha20_OperateKeystreamSSE2(m_state, m_rounds, output, input, batches);
+		output += batches*4*BYTES_PER_ITERATION;
+		if (input)
+			input += batches*4*BYTES_PER_ITERATION;
+		iterationCount %= 4;
+	}
+#endif
+
+	word32 x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
+
+	while (iterationCount--)
+	{
+		x0 = m_state[0];	x1 = m_state[1];	x2 = m_state[2];	x3 = m_state[3];
+		x4 = m_state[4];	x5 = m_state[5];	x6 = m_state[6];	x7 = m_state[7];
+		x8 = m_state[8];	x9 = m_state[9];	x10 = m_state[10];	x11 = m_state[11];
+		x12 = m_state[12];	x13 = m_state[13];	x14 = m_state[14];	x15 = m_state[15];
+
+		for (int i=m_rounds; i>0; i-=2)
+		{
+			CHACHA_QUARTER_ROUND(x0, x4, x8, x12)
+			CHACHA_QUARTER_ROUND(x1, x5, x9, x13)
+			CHACHA_QUARTER_ROUND(x2, x6, x10, x14)
+			CHACHA_QUARTER_ROUND(x3, x7, x11, x15)
+
+			CHACHA_QUARTER_ROUND(x0, x5, x10, x15)
+			CHACHA_QUARTER_ROUND(x1, x6, x11, x12)
+			CHACHA_QUARTER_ROUND(x2, x7, x8, x13)
+			CHACHA_QUARTER_ROUND(x3, x4, x9, x14)
+		}
+
+		#define CHACHA_OUTPUT(x)	{\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 0, x0 + m_state[0]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 1, x1 + m_state[1]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 2, x2 + m_state[2]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 3, x3 + m_state[3]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 4, x4 + m_state[4]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 5, x5 + m_state[5]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 6, x6 + m_state[6]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 7, x7 + m_state[7]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 8, x8 + m_state[8]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 9, x9 + m_state[9]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 10, x10 + m_state[10]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 11, x11 + m_state[11]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 12, x12 + m_state[12]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 13, x13 + m_state[13]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 14, x14 + m_state[14]);\
+			CRYPTOPP_KEYSTREAM_OUTPUT_WORD(x, LITTLE_ENDIAN_ORDER, 15, x15 + m_state[15]);}
+
+#ifndef CRYPTOPP_DOXYGEN_PROCESSING
+		CRYPTOPP_KEYSTREAM_OUTPUT_SWITCH(CHACHA_OUTPUT, BYTES_PER_ITERATION);
+#endif
+
+		if (++m_state[12] == 0)
+			++m_state[13];
+	}
+}
+
+void ChaCha20IETF_Policy::OperateKeystream(KeystreamOperation operation, byte *output, const byte *input, size_t iterationCount)
+{
+	if (m_counterExhausted || iterationCount > (W64LIT(1)<<32) - m_state[12])
+		throw InvalidArgument(std::string(ChaCha20IETF::StaticAlgorithmName()) + ": the 32-bit block counter is exhausted, a new nonce is needed");
+
+	ChaCha20_Policy::OperateKeystream(operation, output, input, iterationCount);
+
+	// the last block carried into word 13
+	if (m_state[13] != m_nonce0)
+	{
+		m_state[13] = m_nonce0;
+		m_counterExhausted = true;
+	}
+}
+
+void ChaCha20IETF_Policy::CipherResynchronize(byte *keystreamBuffer, const byte *IV, size_t length)
+{
+	assert(length==12);
+	GetBlock<word32, LittleEndian> get(IV);
+	get(m_state[13])(m_state[14])(m_state[15]);
+	m_state[12] = 0;
+	m_nonce0 = m_state[13];
+	m_counterExhausted = false;
+}
+
+void ChaCha20IETF_Policy::SeekToIteration(lword iterationCount)
+{
+	if (iterationCount >> 32)
+		throw InvalidArgument(std::string(ChaCha20IETF::StaticAlgorithmName()) + ": the 32-bit block counter can not reach " + IntToString(iterationCount));
+	m_state[12] = (word32)iterationCount;
+	m_state[13] = m_nonce0;
+	m_counterExhausted = false;
+}
+
+NAMESPACE_END
@@ -0,0 +1,67 @@
+#ifndef CRYPTOPP_CHACHA_H
+#define CRYPTOPP_CHACHA_H
+
+#include "strciphr.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! _
+struct ChaCha20_Info : public VariableKeyLength<32, 16, 32, 16, SimpleKeyingInterface::UNIQUE_IV, 8>
+{
+	static const char *StaticAlgorithmName() {return "ChaCha20";}
+};
+
+//! words 12 and 13 of the state are a 64-bit block counter, words 14 and 15 the nonce
+class CRYPTOPP_NO_VTABLE ChaCha20_Policy : public AdditiveCipherConcretePolicy<word32, 16>, public ChaCha20_Info
+{
+protected:
+	void CipherSetKey(const NameValuePairs &params, const byte *key, size_t length);
+	//! runs 8 blocks at a time with AVX2 or 4 with SSE2, the rest one at a time
+	void OperateKeystream(KeystreamOperation operation, byte *output, const byte *input, size_t iterationCount);
+	void CipherResynchronize(byte *keystreamBuffer, const byte *IV, size_t length);
+	bool CipherIsRandomAccess() const {return true;}
+	void SeekToIteration(lword iterationCount);
+#if CRYPTOPP_BOOL_X86 || CRYPTOPP_BOOL_X64
+	unsigned int GetOptimalBlockSize() const;
+#endif
+
+	FixedSizeAlignedSecBlock<word32, 16> m_state;
+	int m_rounds;
+};
+
+/// <a href="http://cr.yp.to/chacha.html">ChaCha20</a> with the original 64-bit nonce and 64-bit block counter, variable rounds: 8, 12 or 20 (default 20)
+struct ChaCha20 : public ChaCha20_Info, public SymmetricCipherDocumentation
+{
+	typedef SymmetricCipherFinal<ConcretePolicyHolder<ChaCha20_Policy, AdditiveCipherTemplate<> >, ChaCha20_Info> Encryption;
+	typedef Encryption Decryption;
+};
+
+//! _
+struct ChaCha20IETF_Info : public FixedKeyLength<32, SimpleKeyingInterface::UNIQUE_IV, 12>
+{
+	static const char *StaticAlgorithmName() {return "ChaCha20IETF";}
+};
+
+//! word 12 of the state is a 32-bit block counter, words 13 to 15 the nonce
+class CRYPTOPP_NO_VTABLE ChaCha20IETF_Policy : public ChaCha20_Policy
+{
+protected:
+	//! throws instead of letting the 32-bit counter wrap into the nonce
+	void OperateKeystream(KeystreamOperation operation, byte *output, const byte *input, size_t iterationCount);
+	void CipherResynchronize(byte *keystreamBuffer, const byte *IV, size_t length);
+	void SeekToIteration(lword iterationCount);
+
+	word32 m_nonce0;
+	bool m_counterExhausted;
+};
+
+/// <a href="http://tools.ietf.org/html/rfc7539">ChaCha20</a> with the 96-bit nonce and 32-bit block counter of RFC 7539, variable rounds: 8, 12 or 20 (default 20)
+struct ChaCha20IETF : public ChaCha20IETF_Info, public SymmetricCipherDocumentation
+{
+	typedef SymmetricCipherFinal<ConcretePolicyHolder<ChaCha20IETF_Policy, AdditiveCipherTemplate<> >, ChaCha20IETF_Info> Encryption;
+	typedef Encryption Decryption;
+};
+
+NAMESPACE_END
+
+#endif
@@ -0,0 +1,53 @@
+// chachapoly.cpp - the ChaCha20 and Poly1305 AEAD construction from RFC 7539
+
+#include "pch.h"
+#include "chachapoly.h"
+#include "misc.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+void ChaCha20Poly1305_Base::SetKeyWithoutResync(const byte *userKey, size_t keylength, const NameValuePairs &params)
+{
+	// the nonce comes with Resync()
+	const byte iv[12] = {0};
+	m_cipher.SetKeyWithIV(userKey, keylength, iv, sizeof(iv));
+}
+
+void ChaCha20Poly1305_Base::Resync(const byte *iv, size_t len)
+{
+	// the one-time Poly1305 key is the start of block 0, the message starts at block 1
+	FixedSizeSecBlock<byte, 32> key;
+	m_cipher.Resynchronize(iv, (int)len);
+	m_cipher.GenerateBlock(key, key.size());
+	m_cipher.Seek(64);
+	m_mac.SetKey(key, key.size());
+}
+
+size_t ChaCha20Poly1305_Base::AuthenticateBlocks(const byte *data, size_t len)
+{
+	m_mac.Update(data, len);
+	return 0;
+}
+
+void ChaCha20Poly1305_Base::AuthenticateLastHeaderBlock()
+{
+	const byte zeros[16] = {0};
+	m_mac.Update(zeros, size_t(0-m_totalHeaderLength) % 16);
+}
+
+void ChaCha20Poly1305_Base::AuthenticateLastConfidentialBlock()
+{
+	const byte zeros[16] = {0};
+	m_mac.Update(zeros, size_t(0-m_totalMessageLength) % 16);
+}
+
+void ChaCha20Poly1305_Base::AuthenticateLastFooterBlock(byte *mac, size_t macSize)
+{
+	byte lengths[16];
+	PutWord(false, LITTLE_ENDIAN_ORDER, lengths, word64(m_totalHeaderLength));
+	PutWord(false, LITTLE_ENDIAN_ORDER, lengths + 8, word64(m_totalMessageLength));
+	m_mac.Update(lengths, sizeof(lengths));
+	m_mac.TruncatedFinal(mac, macSize);
+}
+
+NAMESPACE_END
@@ -0,0 +1,82 @@
+#ifndef CRYPTOPP_CHACHAPOLY_H
+#define CRYPTOPP_CHACHAPOLY_H
+
+#include "authenc.h"
+#include "chacha.h"
+#include "poly1305.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! .
+class CRYPTOPP_NO_VTABLE ChaCha20Poly1305_Base : public AuthenticatedSymmetricCipherBase
+{
+public:
+	// AuthenticatedSymmetricCipher
+	std::string AlgorithmName() const
+		{return std::string("ChaCha20/Poly1305");}
+	size_t MinKeyLength() const
+		{return 32;}
+	size_t MaxKeyLength() const
+		{return 32;}
+	size_t DefaultKeyLength() const
+		{return 32;}
+	size_t GetValidKeyLength(size_t n) const
+		{return 32;}
+	bool IsValidKeyLength(size_t n) const
+		{return n == 32;}
+	unsigned int OptimalDataAlignment() const
+		{return GetSymmetricCipher().OptimalDataAlignment();}
+	IV_Requirement IVRequirement() const
+		{return UNIQUE_IV;}
+	unsigned int IVSize() const
+		{return 12;}
+	unsigned int MinIVLength() const
+		{return 12;}
+	unsigned int MaxIVLength() const
+		{return 12;}
+	unsigned int DigestSize() const
+		{return 16;}
+	lword MaxHeaderLength() const
+		{return LWORD_MAX;}
+	lword MaxMessageLength() const
+		{return W64LIT(274877906880);}	// 2^32-1 blocks of 64 bytes after the one for the Poly1305 key
+
+protected:
+	// AuthenticatedSymmetricCipherBase
+	bool AuthenticationIsOnPlaintext() const
+		{return false;}
+	unsigned int AuthenticationBlockSize() const
+		{return 1;}
+	void SetKeyWithoutResync(const byte *userKey, size_t keylength, const NameValuePairs &params);
+	void Resync(const byte *iv, size_t len);
+	size_t AuthenticateBlocks(const byte *data, size_t len);
+	void AuthenticateLastHeaderBlock();
+	void AuthenticateLastConfidentialBlock();
+	void AuthenticateLastFooterBlock(byte *mac, size_t macSize);
+	SymmetricCipher & AccessSymmetricCipher() {return m_cipher;}
+
+	ChaCha20IETF::Encryption m_cipher;
+	Poly1305 m_mac;
+};
+
+//! .
+template <bool T_IsEncryption>
+class ChaCha20Poly1305_Final : public ChaCha20Poly1305_Base
+{
+public:
+	static std::string StaticAlgorithmName()
+		{return std::string("ChaCha20/Poly1305");}
+	bool IsForwardTransformation() const
+		{return T_IsEncryption;}
+};
+
+//! <a href="http://tools.ietf.org/html/rfc7539">ChaCha20 and Poly1305</a>, the AEAD construction from RFC 7539
+struct ChaCha20Poly1305 : public AuthenticatedSymmetricCipherDocumentation
+{
+	typedef ChaCha20Poly1305_Final<true> Encryption;
+	typedef ChaCha20Poly1305_Final<false> Decryption;
+};
+
+NAMESPACE_END
+
+#endif
@@ -296,6 +296,37 @@ NAMESPACE_END
 	#define CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE 0
 #endif
 
+// GCC only allows these intrinsics when the instruction set is enabled for the whole translation unit
+#if !defined(CRYPTOPP_DISABLE_SSSE3) && CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && (_MSC_VER >= 1500 || __INTEL_COMPILER >= 1110 || defined(__SSSE3__))
+	#define CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE 1
+#else
+	#define CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE 0
+#endif
+
+#if !defined(CRYPTOPP_DISABLE_SSE4) && CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE && (_MSC_VER >= 1500 || __INTEL_COMPILER >= 1110 || defined(__SSE4_1__))
+	#define CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE 1
+#else
+	#define CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE 0
+#endif
+
+#if !defined(CRYPTOPP_DISABLE_AVX2) && CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE && (_MSC_VER >= 1700 || __INTEL_COMPILER >= 1300 || defined(__AVX2__))
+	#define CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE 1
+#else
+	#define CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE 0
+#endif
+
+#if !defined(CRYPTOPP_DISABLE_AVX512) && CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE && (_MSC_VER >= 1910 || __INTEL_COMPILER >= 1800 || defined(__AVX512F__))
+	#define CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE 1
+#else
+	#define CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE 0
+#endif
+
+#if !defined(CRYPTOPP_DISABLE_VAES) && CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE && CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE && (_MSC_VER >= 1920 || __INTEL_COMPILER >= 1800 || defined(__VAES__))
+	#define CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE 1
+#else
+	#define CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE 0
+#endif
+
 #if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE || CRYPTOPP_BOOL_SSE2_ASM_AVAILABLE || defined(CRYPTOPP_X64_MASM_AVAILABLE)
 	#define CRYPTOPP_BOOL_ALIGN16_ENABLED 1
 #else
@@ -356,7 +387,7 @@ NAMESPACE_END
 //#define CRYPTOPP_DISABLE_INTERNAL_MULTITHREADING
 // thread support requires the following headers:
 // <thread>,<mutex>,<atomic>,<memory> with their classes: std::thread, std::mutex, std::atomic, std::shared_ptr (thread-safe)
-#if !defined(CRYPTOPP_DISABLE_INTERNAL_MULTITHREADING) && !defined(CRYPTOPP_DISABLE_CPP11) && ((_MSC_VER >= 1700) ) // list other compilers
+#if !defined(CRYPTOPP_DISABLE_INTERNAL_MULTITHREADING) && !defined(CRYPTOPP_DISABLE_CPP11) && ((_MSC_VER >= 1700) || (__cplusplus >= 201103L)) // list other compilers
 #define CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED 1
 #else
 #define CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED 0
@@ -17,6 +17,10 @@
 #include <emmintrin.h>
 #endif
 
+#if defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219
+#include <immintrin.h>
+#endif
+
 NAMESPACE_BEGIN(CryptoPP)
 
 #ifdef CRYPTOPP_CPUID_AVAILABLE
@@ -25,7 +29,7 @@ NAMESPACE_BEGIN(CryptoPP)
 
 bool CpuId(word32 input, word32 *output)
 {
-	__cpuid((int *)output, input);
+	__cpuidex((int *)output, input, 0);
 	return true;
 }
 
@@ -57,6 +61,7 @@ bool CpuId(word32 input, word32 *output)
 		__asm
 		{
 			mov eax, input
+			xor ecx, ecx
 			cpuid
 			mov edi, output
 			mov [edi], eax
@@ -89,7 +94,7 @@ bool CpuId(word32 input, word32 *output)
 			"pushq %%rbx; cpuid; mov %%ebx, %%edi; popq %%rbx"
 #endif
 			: "=a" (output[0]), "=D" (output[1]), "=c" (output[2]), "=d" (output[3])
-			: "a" (input)
+			: "a" (input), "2" (0)
 		);
 	}
 
@@ -142,8 +147,33 @@ static bool TrySSE2()
 #endif
 }
 
+// returns XCR0, which tells whether the OS saves the YMM registers on context switches
+static word64 XGetBV()
+{
+#if defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219
+	return _xgetbv(0);
+#elif defined(CRYPTOPP_MS_STYLE_INLINE_ASSEMBLY)
+	word32 a, d;
+	__asm
+	{
+		xor ecx, ecx
+		_emit 0x0f
+		_emit 0x01
+		_emit 0xd0
+		mov a, eax
+		mov d, edx
+	}
+	return ((word64)d << 32) | a;
+#else
+	word32 a, d;
+	__asm __volatile (".byte 0x0f, 0x01, 0xd0" : "=a" (a), "=d" (d) : "c" (0));
+	return ((word64)d << 32) | a;
+#endif
+}
+
 bool g_x86DetectionDone = false;
-bool g_hasISSE = false, g_hasSSE2 = false, g_hasSSSE3 = false, g_hasMMX = false, g_hasAESNI = false, g_hasCLMUL = false, g_isP4 = false;
+bool g_hasISSE = false, g_hasSSE2 = false, g_hasSSSE3 = false, g_hasSSE41 = false, g_hasAVX2 = false, g_hasVAES = false, g_hasAVX512 = false, g_hasMMX = false, g_hasAESNI = false, g_hasCLMUL = false, g_isP4 = false;
+bool g_hasRDRAND = false, g_hasRDSEED = false, g_hasBMI2 = false, g_hasADX = false;
 word32 g_cacheLineSize = CRYPTOPP_L1_CACHE_LINE_SIZE;
 
 void DetectX86Features()
@@ -158,10 +188,27 @@ void DetectX86Features()
 	if ((cpuid1[3] & (1 << 26)) != 0)
 		g_hasSSE2 = TrySSE2();
 	g_hasSSSE3 = g_hasSSE2 && (cpuid1[2] & (1<<9));
+	g_hasSSE41 = g_hasSSSE3 && (cpuid1[2] & (1<<19));
 	g_hasAESNI = g_hasSSE2 && (cpuid1[2] & (1<<25));
 	g_hasCLMUL = g_hasSSE2 && (cpuid1[2] & (1<<1));
-	g_hasRDRAND = g_hasSSE2 && (cpuid[2] & (1<<30));
-	g_hasRDSEED = g_hasSSE2 && (cpuid[1] & (1<<18));
+	g_hasRDRAND = g_hasSSE2 && (cpuid1[2] & (1<<30));
+
+	if (cpuid[0] >= 7)
+	{
+		word32 cpuid7[4];
+		CpuId(7, cpuid7);
+		g_hasRDSEED = g_hasSSE2 && (cpuid7[1] & (1<<18));
+		g_hasBMI2 = (cpuid7[1] & (1<<8)) != 0;
+		g_hasADX = (cpuid7[1] & (1<<19)) != 0;
+		// AVX2 needs OSXSAVE and the OS saving both XMM and YMM state
+		if (g_hasSSE41 && (cpuid1[2] & (1<<27)) && (cpuid1[2] & (1<<28)) && (XGetBV() & 6) == 6)
+		{
+			g_hasAVX2 = (cpuid7[1] & (1<<5)) != 0;
+			g_hasVAES = g_hasAVX2 && g_hasAESNI && (cpuid7[2] & (1<<9));
+			// AVX-512 also needs the OS saving the opmask and both halves of the ZMM registers
+			g_hasAVX512 = g_hasAVX2 && (cpuid7[1] & (1<<16)) && (XGetBV() & 0xe6) == 0xe6;
+		}
+	}
 
 	if ((cpuid1[3] & (1 << 25)) != 0)
 		g_hasISSE = true;
@@ -94,6 +94,16 @@ _mm_aesdeclast_si128 (__m128i a, __m128i b)
 #endif
 #endif
 
+#if CRYPTOPP_BOOL_SSSE3_INTRINSICS_AVAILABLE
+#include <tmmintrin.h>
+#endif
+#if CRYPTOPP_BOOL_SSE41_INTRINSICS_AVAILABLE
+#include <smmintrin.h>
+#endif
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+#include <immintrin.h>
+#endif
+
 NAMESPACE_BEGIN(CryptoPP)
 
 #if CRYPTOPP_BOOL_X86 || CRYPTOPP_BOOL_X64
@@ -103,11 +113,17 @@ NAMESPACE_BEGIN(CryptoPP)
 // these should not be used directly
 extern CRYPTOPP_DLL bool g_x86DetectionDone;
 extern CRYPTOPP_DLL bool g_hasSSSE3;
+extern CRYPTOPP_DLL bool g_hasSSE41;
+extern CRYPTOPP_DLL bool g_hasAVX2;
+extern CRYPTOPP_DLL bool g_hasVAES;
+extern CRYPTOPP_DLL bool g_hasAVX512;
 extern CRYPTOPP_DLL bool g_hasAESNI;
 extern CRYPTOPP_DLL bool g_hasCLMUL;
 extern CRYPTOPP_DLL bool g_isP4;
 extern CRYPTOPP_DLL bool g_hasRDRAND;
 extern CRYPTOPP_DLL bool g_hasRDSEED;
+extern CRYPTOPP_DLL bool g_hasBMI2;
+extern CRYPTOPP_DLL bool g_hasADX;
 extern CRYPTOPP_DLL word32 g_cacheLineSize;
 CRYPTOPP_DLL void CRYPTOPP_API DetectX86Features();
 CRYPTOPP_DLL bool CRYPTOPP_API CpuId(word32 input, word32 *output);
@@ -152,6 +168,37 @@ inline bool HasSSSE3()
 	return g_hasSSSE3;
 }
 
+inline bool HasSSE41()
+{
+	if (!g_x86DetectionDone)
+		DetectX86Features();
+	return g_hasSSE41;
+}
+
+//! also checks that the OS preserves the YMM registers
+inline bool HasAVX2()
+{
+	if (!g_x86DetectionDone)
+		DetectX86Features();
+	return g_hasAVX2;
+}
+
+//! AES instructions on YMM registers, and on ZMM registers if HasAVX512() is also true
+inline bool HasVAES()
+{
+	if (!g_x86DetectionDone)
+		DetectX86Features();
+	return g_hasVAES;
+}
+
+//! AVX-512 Foundation, also checks that the OS preserves the ZMM registers
+inline bool HasAVX512()
+{
+	if (!g_x86DetectionDone)
+		DetectX86Features();
+	return g_hasAVX512;
+}
+
 inline bool HasAESNI()
 {
 	if (!g_x86DetectionDone)
@@ -180,6 +227,22 @@ inline bool HasRDSEED()
 	return g_hasRDSEED;
 }
 
+//! MULX, which leaves the flags alone
+inline bool HasBMI2()
+{
+	if (!g_x86DetectionDone)
+		DetectX86Features();
+	return g_hasBMI2;
+}
+
+//! ADCX and ADOX, two independent carry chains
+inline bool HasADX()
+{
+	if (!g_x86DetectionDone)
+		DetectX86Features();
+	return g_hasADX;
+}
+
 inline bool IsP4()
 {
 	if (!g_x86DetectionDone)
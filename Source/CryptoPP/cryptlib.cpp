@@ -190,6 +190,87 @@ void TweakableBlockCipher::ProcessAndXorBlock(const byte *inBlock, const byte *x
 	ProcessAndXorBlockWithTweak(inBlock,xorBlock,outBlock,FakeTweak,FakeTweakLength);
 }
 
+size_t TweakableBlockCipher::AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const
+{
+	size_t blockSize = BlockSize();
+	size_t inIncrement = (flags & (BT_InBlockIsCounter|BT_DontIncrementInOutPointers)) ? 0 : blockSize;
+	size_t xorIncrement = xorBlocks ? blockSize : 0;
+	size_t outIncrement = (flags & BT_DontIncrementInOutPointers) ? 0 : blockSize;
+	size_t tweakIncrement = TweakLength;
+
+	if (flags & BT_ReverseDirection)
+	{
+		assert(length % blockSize == 0);
+		inBlocks += length - blockSize;
+		xorBlocks += length - blockSize;
+		outBlocks += length - blockSize;
+		Tweak += (length / blockSize - 1) * TweakLength;
+		inIncrement = 0-inIncrement;
+		xorIncrement = 0-xorIncrement;
+		outIncrement = 0-outIncrement;
+		tweakIncrement = 0-tweakIncrement;
+	}
+
+	while (length >= blockSize)
+	{
+		if (flags & BT_XorInput)
+		{
+			xorbuf(outBlocks, xorBlocks, inBlocks, blockSize);
+			ProcessAndXorBlockWithTweak(outBlocks, NULL, outBlocks, Tweak, TweakLength);
+		}
+		else
+			ProcessAndXorBlockWithTweak(inBlocks, xorBlocks, outBlocks, Tweak, TweakLength);
+		if (flags & BT_InBlockIsCounter)
+			const_cast<byte *>(inBlocks)[blockSize-1]++;
+		inBlocks += inIncrement;
+		outBlocks += outIncrement;
+		xorBlocks += xorIncrement;
+		Tweak += tweakIncrement;
+		length -= blockSize;
+	}
+
+	return length;
+}
+
+size_t TweakableBlockCipher::AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement) const
+{
+	size_t blockSize = BlockSize();
+	size_t inIncrement = (flags & (BT_InBlockIsCounter|BT_DontIncrementInOutPointers)) ? 0 : blockSize;
+	size_t xorIncrement = xorBlocks ? blockSize : 0;
+	size_t outIncrement = (flags & BT_DontIncrementInOutPointers) ? 0 : blockSize;
+
+	// blocks are taken in order, the counter can't run backwards
+	assert(!(flags & BT_ReverseDirection));
+
+	while (length >= blockSize)
+	{
+		if (flags & BT_XorInput)
+		{
+			xorbuf(outBlocks, xorBlocks, inBlocks, blockSize);
+			ProcessAndXorBlockWithTweak(outBlocks, NULL, outBlocks, Tweak, TweakLength);
+		}
+		else
+			ProcessAndXorBlockWithTweak(inBlocks, xorBlocks, outBlocks, Tweak, TweakLength);
+		if (flags & BT_InBlockIsCounter)
+			const_cast<byte *>(inBlocks)[blockSize-1]++;
+
+		word64 carry = TweakIncrement;
+		for (size_t i = 0; carry && i < TweakLength; i++)
+		{
+			const word64 sum = (carry & 0xff) + Tweak[i];
+			Tweak[i] = byte(sum);
+			carry = (carry >> 8) + (sum >> 8);
+		}
+
+		inBlocks += inIncrement;
+		outBlocks += outIncrement;
+		xorBlocks += xorIncrement;
+		length -= blockSize;
+	}
+
+	return length;
+}
+
 unsigned int BlockTransformation::OptimalDataAlignment() const
 {
 	return GetAlignmentOf<word32>();
@@ -819,6 +900,14 @@ DecodingResult PK_Verifier::RecoverMessage(byte *recoveredMessage,
 	return RecoverAndRestart(recoveredMessage, *m);
 }
 
+std::vector<bool> PK_Verifier::VerifyBatch(const SignedMessage *items, size_t count, bool parallel) const
+{
+	std::vector<bool> valid(count);
+	for (size_t i=0; i<count; i++)
+		valid[i] = VerifyMessage(items[i].message, items[i].messageLength, items[i].signature, items[i].signatureLength);
+	return valid;
+}
+
 void SimpleKeyAgreementDomain::GenerateKeyPair(RandomNumberGenerator &rng, byte *privateKey, byte *publicKey) const
 {
 	GeneratePrivateKey(rng, privateKey);
@@ -643,6 +643,13 @@ public:
 
 	//! encrypt or decrypt inBlock, xor with xorBlock, and write to outBlock
 	virtual void ProcessAndXorBlock(const byte *inBlock, const byte *xorBlock, byte *outBlock) const;
+
+	//! same as AdvancedProcessBlocks(), but the i-th block is processed with the tweak at Tweaks+i*TweakLength
+	virtual size_t AdvancedProcessBlocksWithTweaks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, const byte *Tweak, size_t TweakLength) const;
+
+	//! same as AdvancedProcessBlocks(), but Tweak is a little endian counter that is increased by TweakIncrement after every block
+	/*! on return Tweak holds the tweak for the block after the last one processed */
+	virtual size_t AdvancedProcessBlocksWithTweakCounter(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags, byte *Tweak, size_t TweakLength, word64 TweakIncrement=1) const;
 protected:
 	const Algorithm & GetAlgorithm() const {return *this;}
 };
@@ -1460,6 +1467,25 @@ public:
 	virtual DecodingResult RecoverMessage(byte *recoveredMessage, 
 		const byte *nonrecoverableMessage, size_t nonrecoverableMessageLength, 
 		const byte *signature, size_t signatureLength) const;
+
+	//! a message and its signature, input to VerifyBatch()
+	struct SignedMessage
+	{
+		SignedMessage() : message(NULL), messageLength(0), signature(NULL), signatureLength(0) {}
+		SignedMessage(const byte *message, size_t messageLength, const byte *signature, size_t signatureLength)
+			: message(message), messageLength(messageLength), signature(signature), signatureLength(signatureLength) {}
+
+		const byte *message;
+		size_t messageLength;
+		const byte *signature;
+		size_t signatureLength;
+	};
+
+	//! check count signatures made with this key, element i of the result tells whether items[i] is valid
+	/*! Implementations keep per-key state, such as Montgomery parameters and precomputed
+		tables, for the whole batch. With parallel set, the batch may be split over
+		ThreadPool::GetGlobalPool(). The default calls VerifyMessage() for every item. */
+	virtual std::vector<bool> VerifyBatch(const SignedMessage *items, size_t count, bool parallel=false) const;
 };
 
 //! interface for domains of simple key agreement protocols
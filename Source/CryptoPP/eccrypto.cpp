@@ -41,6 +41,26 @@ static inline Integer ConvertToInteger(const Integer &x)
 	return x;
 }
 
+static inline bool HasFixedWidthArithmetic(const EC2N &)
+{
+	return false;
+}
+
+static inline bool HasFixedWidthArithmetic(const ECP &ec)
+{
+	return ec.HasFixedWidthArithmetic();
+}
+
+static inline bool FixedBaseMultiply(const EC2N &, EC2N::Point &, const EC2N::Point &, const Integer &)
+{
+	return false;
+}
+
+static inline bool FixedBaseMultiply(const ECP &ec, ECP::Point &result, const ECP::Point &G, const Integer &k)
+{
+	return ec.FixedBaseMultiply(result, G, k);
+}
+
 static bool CheckMOVCondition(const Integer &q, const Integer &r)
 {
 	// see "Updated standards for validating elliptic curves", http://eprint.iacr.org/2007/343
@@ -809,6 +829,21 @@ bool DL_GroupParameters_EC<EC>::ValidateElement(unsigned int level, const Elemen
 	return pass;
 }
 
+template <class EC>
+CPP_TYPENAME DL_GroupParameters_EC<EC>::Element DL_GroupParameters_EC<EC>::ExponentiateBase(const Integer &exponent) const
+{
+	// the compiled in comb tables of the named curves need no precomputation per key
+	Element result;
+	if (FixedBaseMultiply(GetCurve(), result, this->GetSubgroupGenerator(), exponent))
+		return result;
+
+	// the fixed width arithmetic is constant time and faster than the generic precomputation
+	if (HasFixedWidthArithmetic(GetCurve()))
+		return GetCurve().ScalarMultiply(this->GetSubgroupGenerator(), exponent);
+	else
+		return DL_GroupParametersImpl<EcPrecomputation<EC> >::ExponentiateBase(exponent);
+}
+
 template <class EC>
 void DL_GroupParameters_EC<EC>::SimultaneousExponentiate(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const
 {
@@ -835,6 +870,22 @@ OID DL_GroupParameters_EC<EC>::GetAlgorithmID() const
 
 // ******************************************************************
 
+template <class EC>
+CPP_TYPENAME DL_PublicKey_EC<EC>::Element DL_PublicKey_EC<EC>::CascadeExponentiateBaseAndPublicElement(const Integer &baseExp, const Integer &publicExp) const
+{
+	const DL_GroupParameters_EC<EC> &params = this->GetGroupParameters();
+	if (HasFixedWidthArithmetic(params.GetCurve()))
+		return params.GetCurve().CascadeScalarMultiply(params.GetSubgroupGenerator(), baseExp, this->GetPublicElement(), publicExp);
+	else
+		return DL_PublicKeyImpl<DL_GroupParameters_EC<EC> >::CascadeExponentiateBaseAndPublicElement(baseExp, publicExp);
+}
+
+template <class EC>
+bool DL_PublicKey_EC<EC>::UsesPrecomputation() const
+{
+	return !HasFixedWidthArithmetic(this->GetGroupParameters().GetCurve());
+}
+
 template <class EC>
 void DL_PublicKey_EC<EC>::BERDecodePublicKey(BufferedTransformation &bt, bool parametersPresent, size_t size)
 {
@@ -93,6 +93,7 @@ public:
 	Integer ConvertElementToInteger(const Element &element) const;
 	Integer GetMaxExponent() const {return GetSubgroupOrder()-1;}
 	bool IsIdentity(const Element &element) const {return element.identity;}
+	Element ExponentiateBase(const Integer &exponent) const;
 	void SimultaneousExponentiate(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const;
 	static std::string CRYPTOPP_API StaticAlgorithmNamePrefix() {return "EC";}
 
@@ -150,6 +151,11 @@ public:
 	void Initialize(const EC &ec, const Element &G, const Integer &n, const Element &Q)
 		{this->AccessGroupParameters().Initialize(ec, G, n); this->SetPublicElement(Q);}
 
+	// DL_PublicKey
+	Element CascadeExponentiateBaseAndPublicElement(const Integer &baseExp, const Integer &publicExp) const;
+	//! false for curves with fixed width arithmetic, which never look at the precomputed tables
+	bool UsesPrecomputation() const;
+
 	// X509PublicKey
 	void BERDecodePublicKey(BufferedTransformation &bt, bool parametersPresent, size_t size);
 	void DEREncodePublicKey(BufferedTransformation &bt) const;
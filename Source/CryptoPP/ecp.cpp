@@ -31,6 +31,8 @@ ECP::ECP(const ECP &ecp, bool convertToMontgomeryRepresentation)
 		m_fieldPtr.reset(new MontgomeryRepresentation(ecp.GetField().GetModulus()));
 		m_a = GetField().ConvertIn(ecp.m_a);
 		m_b = GetField().ConvertIn(ecp.m_b);
+		m_nistCurve = NULL;
+		m_combTable = NULL;
 	}
 	else
 		operator=(ecp);
@@ -42,6 +44,8 @@ ECP::ECP(BufferedTransformation &bt)
 	BERSequenceDecoder seq(bt);
 	GetField().BERDecodeElement(seq, m_a);
 	GetField().BERDecodeElement(seq, m_b);
+	m_nistCurve = NISTPrimeCurve::Find(GetField().GetModulus(), m_a, m_b);
+	m_combTable = ECPCombTable::Find(GetField().GetModulus(), m_a, m_b);
 	// skip optional seed
 	if (!seq.EndReached())
 	{
@@ -348,9 +352,140 @@ struct ZIterator
 	std::vector<ProjectivePoint>::iterator it;
 };
 
+// Jacobian coordinates (X/Z^2, Y/Z^3), Z = 0 for the point at infinity, formulas from
+// the Explicit-Formulas Database (dbl-2007-bl, madd-2007-bl, add-2007-bl)
+class JacobianArithmetic
+{
+public:
+	JacobianArithmetic(const ModularArithmetic &mr, const Integer &m_a)
+		: mr(mr), m_a(m_a) {}
+
+	void Double(ProjectivePoint &P) const
+	{
+		if (P.z.IsZero())
+			return;
+		Integer XX = mr.Square(P.x);
+		Integer YY = mr.Square(P.y);
+		Integer YYYY = mr.Square(YY);
+		Integer ZZ = mr.Square(P.z);
+		Integer S = mr.Square(mr.Add(P.x, YY));
+		mr.Reduce(S, XX);
+		mr.Reduce(S, YYYY);
+		S = mr.Double(S);
+		Integer M = mr.Multiply(m_a, mr.Square(ZZ));
+		mr.Accumulate(M, mr.Add(mr.Double(XX), XX));
+		P.z = mr.Square(mr.Add(P.y, P.z));
+		mr.Reduce(P.z, YY);
+		mr.Reduce(P.z, ZZ);
+		P.x = mr.Square(M);
+		mr.Reduce(P.x, mr.Double(S));
+		P.y = mr.Multiply(M, mr.Subtract(S, P.x));
+		YYYY = mr.Double(mr.Double(mr.Double(YYYY)));
+		mr.Reduce(P.y, YYYY);
+	}
+
+	// adds the affine point Q or its inverse
+	void AddMixed(ProjectivePoint &P, const ECPPoint &Q, bool negate=false) const
+	{
+		if (Q.identity)
+			return;
+		const Integer Y2 = negate ? mr.Inverse(Q.y) : Q.y;
+		if (P.z.IsZero())
+		{
+			P = ProjectivePoint(Q.x, Y2, mr.MultiplicativeIdentity());
+			return;
+		}
+		Integer Z1Z1 = mr.Square(P.z);
+		Integer H = mr.Multiply(Q.x, Z1Z1);
+		mr.Reduce(H, P.x);
+		Integer r = mr.Multiply(Y2, mr.Multiply(P.z, Z1Z1));
+		mr.Reduce(r, P.y);
+		if (H.IsZero())
+		{
+			if (r.IsZero())
+				Double(P);
+			else
+				P.z = mr.Identity();
+			return;
+		}
+		r = mr.Double(r);
+		Integer HH = mr.Square(H);
+		Integer I = mr.Double(mr.Double(HH));
+		Integer J = mr.Multiply(H, I);
+		Integer V = mr.Multiply(P.x, I);
+		P.z = mr.Square(mr.Add(P.z, H));
+		mr.Reduce(P.z, Z1Z1);
+		mr.Reduce(P.z, HH);
+		P.x = mr.Square(r);
+		mr.Reduce(P.x, J);
+		mr.Reduce(P.x, mr.Double(V));
+		J = mr.Double(mr.Multiply(P.y, J));
+		P.y = mr.Multiply(r, mr.Subtract(V, P.x));
+		mr.Reduce(P.y, J);
+	}
+
+	void Add(ProjectivePoint &P, const ProjectivePoint &Q) const
+	{
+		if (Q.z.IsZero())
+			return;
+		if (P.z.IsZero())
+		{
+			P = Q;
+			return;
+		}
+		Integer Z1Z1 = mr.Square(P.z);
+		Integer Z2Z2 = mr.Square(Q.z);
+		Integer U1 = mr.Multiply(P.x, Z2Z2);
+		Integer S1 = mr.Multiply(P.y, mr.Multiply(Q.z, Z2Z2));
+		Integer H = mr.Multiply(Q.x, Z1Z1);
+		mr.Reduce(H, U1);
+		Integer r = mr.Multiply(Q.y, mr.Multiply(P.z, Z1Z1));
+		mr.Reduce(r, S1);
+		if (H.IsZero())
+		{
+			if (r.IsZero())
+				Double(P);
+			else
+				P.z = mr.Identity();
+			return;
+		}
+		r = mr.Double(r);
+		Integer I = mr.Square(mr.Double(H));
+		Integer J = mr.Multiply(H, I);
+		Integer V = mr.Multiply(U1, I);
+		P.z = mr.Square(mr.Add(P.z, Q.z));
+		mr.Reduce(P.z, Z1Z1);
+		mr.Reduce(P.z, Z2Z2);
+		P.z = mr.Multiply(P.z, H);
+		P.x = mr.Square(r);
+		mr.Reduce(P.x, J);
+		mr.Reduce(P.x, mr.Double(V));
+		J = mr.Double(mr.Multiply(S1, J));
+		P.y = mr.Multiply(r, mr.Subtract(V, P.x));
+		mr.Reduce(P.y, J);
+	}
+
+	ECPPoint ToAffine(const ProjectivePoint &P) const
+	{
+		if (P.z.IsZero())
+			return ECPPoint();
+		Integer z = mr.MultiplicativeInverse(P.z);
+		Integer zz = mr.Square(z);
+		Integer x = mr.Multiply(P.x, zz);
+		z = mr.Multiply(zz, z);
+		return ECPPoint(x, mr.Multiply(P.y, z));
+	}
+
+private:
+	const ModularArithmetic &mr;
+	const Integer &m_a;
+};
+
 ECP::Point ECP::ScalarMultiply(const Point &P, const Integer &k) const
 {
 	Element result;
+	if (m_nistCurve && m_nistCurve->ScalarMultiply(result, P, k))
+		return result;
 	if (k.BitCount() <= 5)
 		AbstractGroup<ECPPoint>::SimultaneousMultiply(&result, P, &k, 1);
 	else
@@ -360,6 +495,13 @@ ECP::Point ECP::ScalarMultiply(const Point &P, const Integer &k) const
 
 void ECP::SimultaneousMultiply(ECP::Point *results, const ECP::Point &P, const Integer *expBegin, unsigned int expCount) const
 {
+	if (m_nistCurve && expCount && m_nistCurve->ScalarMultiply(results[0], P, expBegin[0]))
+	{
+		for (unsigned int i=1; i<expCount; i++)
+			m_nistCurve->ScalarMultiply(results[i], P, expBegin[i]);
+		return;
+	}
+
 	if (!GetField().IsMontgomeryRepresentation())
 	{
 		ECP ecpmr(*this, true);
@@ -458,6 +600,10 @@ void ECP::SimultaneousMultiply(ECP::Point *results, const ECP::Point &P, const I
 
 ECP::Point ECP::CascadeScalarMultiply(const Point &P, const Integer &k1, const Point &Q, const Integer &k2) const
 {
+	Point result;
+	if (m_nistCurve && m_nistCurve->CascadeScalarMultiply(result, P, k1, Q, k2))
+		return result;
+
 	if (!GetField().IsMontgomeryRepresentation())
 	{
 		ECP ecpmr(*this, true);
@@ -468,6 +614,275 @@ ECP::Point ECP::CascadeScalarMultiply(const Point &P, const Integer &k1, const P
 		return AbstractGroup<Point>::CascadeScalarMultiply(P, k1, Q, k2);
 }
 
+ECP::Point ECP::MultiScalarMultiply(const Point *points, const Integer *scalars, size_t count) const
+{
+	if (count <= 2)
+		return AbstractGroup<Point>::MultiScalarMultiply(points, scalars, count);
+
+	if (!GetField().IsMontgomeryRepresentation())
+	{
+		ECP ecpmr(*this, true);
+		const ModularArithmetic &mr = ecpmr.GetField();
+		std::vector<Point> converted(count);
+		for (size_t i=0; i<count; i++)
+			converted[i] = ToMontgomery(mr, points[i]);
+		return FromMontgomery(mr, ecpmr.MultiScalarMultiply(&converted[0], scalars, count));
+	}
+
+	const ModularArithmetic &mr = GetField();
+	const JacobianArithmetic ja(mr, m_a);
+	std::vector<Point> bases;
+	std::vector<Integer> exponents;
+	unsigned int bits = 0;
+	size_t i;
+
+	bases.reserve(count);
+	exponents.reserve(count);
+	for (i=0; i<count; i++)
+	{
+		if (points[i].identity || scalars[i].IsZero())
+			continue;
+		bases.push_back(points[i]);
+		exponents.push_back(scalars[i]);
+		if (exponents.back().IsNegative())
+		{
+			bases.back().y = mr.Inverse(bases.back().y);
+			exponents.back().SetPositive();
+		}
+		bits = STDMAX(bits, exponents.back().BitCount());
+	}
+
+	count = bases.size();
+	if (count <= 2)
+		return AbstractGroup<Point>::MultiScalarMultiply(count ? &bases[0] : NULL, count ? &exponents[0] : NULL, count);
+
+	const unsigned int c = MultiScalarBucketWindowSize(count, bits, true);
+	ProjectivePoint result(mr.MultiplicativeIdentity(), mr.MultiplicativeIdentity(), mr.Identity());
+
+	if (c == 0)
+	{
+		// Straus, with the tables of odd multiples built in Jacobian coordinates and
+		// converted to affine with one inversion so the main loop can use mixed additions
+		std::vector<std::vector<MultiScalarWindow> > windows(count);
+		std::vector<size_t> tableBegin(count+1), next(count);
+		std::vector<ProjectivePoint> tables;
+		unsigned int top = 0;
+
+		for (i=0; i<count; i++)
+		{
+			word32 maxValue = SlidingWindows(windows[i], exponents[i], true);
+			next[i] = windows[i].size();
+			tableBegin[i] = tables.size();
+			top = STDMAX(top, windows[i].back().position);
+
+			tables.push_back(ProjectivePoint(bases[i].x, bases[i].y, mr.MultiplicativeIdentity()));
+			if (maxValue > 1)
+			{
+				ProjectivePoint twice = tables.back();
+				ja.Double(twice);
+				ProjectivePoint T = tables.back();
+				for (word32 j=1; j<=maxValue/2; j++)
+				{
+					ja.Add(T, twice);
+					tables.push_back(T);
+				}
+			}
+		}
+		tableBegin[count] = tables.size();
+
+		ParallelInvert(mr, ZIterator(tables.begin()), ZIterator(tables.end()));
+		std::vector<Point> affine(tables.size());
+		for (i=0; i<tables.size(); i++)
+		{
+			ProjectivePoint &T = tables[i];
+			if (T.z.NotZero())
+			{
+				T.y = mr.Multiply(T.y, T.z);
+				T.z = mr.Square(T.z);
+				affine[i].identity = false;
+				affine[i].x = mr.Multiply(T.x, T.z);
+				affine[i].y = mr.Multiply(T.y, T.z);
+			}
+		}
+
+		for (unsigned int position = top+1; position-- > 0; )
+		{
+			ja.Double(result);
+			for (i=0; i<count; i++)
+			{
+				if (next[i] == 0 || windows[i][next[i]-1].position != position)
+					continue;
+				const MultiScalarWindow &w = windows[i][--next[i]];
+				ja.AddMixed(result, affine[tableBegin[i] + w.value/2], w.negate);
+			}
+		}
+	}
+	else
+	{
+		// Pippenger, with mixed additions into the buckets
+		const unsigned int windowCount = (bits+c-1)/c + 1;
+		const size_t bucketCount = size_t(1) << (c-1);
+		const ProjectivePoint empty(mr.MultiplicativeIdentity(), mr.MultiplicativeIdentity(), mr.Identity());
+		std::vector<int> digits(count*windowCount);
+		std::vector<ProjectivePoint> buckets(bucketCount);
+
+		for (i=0; i<count; i++)
+			BucketDigits(&digits[i*windowCount], exponents[i], c, windowCount, true);
+
+		for (unsigned int j=windowCount; j-- > 0; )
+		{
+			for (unsigned int s=0; s<c; s++)
+				ja.Double(result);
+
+			std::fill(buckets.begin(), buckets.end(), empty);
+			for (i=0; i<count; i++)
+			{
+				const int d = digits[i*windowCount+j];
+				if (d != 0)
+					ja.AddMixed(buckets[(d < 0 ? -d : d) - 1], bases[i], d < 0);
+			}
+
+			ProjectivePoint sum = empty, total = empty;
+			for (size_t b=bucketCount; b-- > 0; )
+			{
+				ja.Add(sum, buckets[b]);
+				ja.Add(total, sum);
+			}
+			ja.Add(result, total);
+		}
+	}
+
+	return ja.ToAffine(result);
+}
+
+// ********************************************************
+
+const ECPCombTable * ECPCombTable::Find(const Integer &p, const Integer &a, const Integer &b)
+{
+	for (unsigned int i=0; i<g_ecpCombTableCount; i++)
+	{
+		const ECPCombTable &table = g_ecpCombTables[i];
+		if (Equal(p, table.GetModulus(), table.words) && Equal(a, table.GetA(), table.words) && Equal(b, table.GetB(), table.words))
+			return &table;
+	}
+	return NULL;
+}
+
+bool ECPCombTable::Equal(const Integer &x, const word64 *w, unsigned int n)
+{
+	if (x.IsNegative() || x.ByteCount() > 8*n)
+		return false;
+	for (unsigned int i=0; i<8*n; i++)
+		if (x.GetByte(i) != byte(w[i/8] >> (8*(i%8))))
+			return false;
+	return true;
+}
+
+Integer ECPCombTable::ToInteger(const word64 *w, unsigned int n)
+{
+	SecByteBlock buf(8*n);
+	for (unsigned int i=0; i<8*n; i++)
+		buf[8*n-1-i] = byte(w[i/8] >> (8*(i%8)));
+	return Integer(buf, buf.size());
+}
+
+// Montgomery form copies of the comb tables for curves without fixed width arithmetic,
+// each converted on first use and shared by all curves with the same table. The words
+// can't be emitted in Montgomery form by ecct, since the Montgomery radix depends on WORD_BITS.
+class ECPCombCache
+{
+public:
+	struct Entry
+	{
+		Entry(const ECPCombTable &table)
+		{
+			const unsigned int n = table.words;
+			curve = ECP(ECP(ECPCombTable::ToInteger(table.GetModulus(), n), ECPCombTable::ToInteger(table.GetA(), n), ECPCombTable::ToInteger(table.GetB(), n)), true);
+			order = ECPCombTable::ToInteger(table.GetSubgroupOrder(), n);
+			const ModularArithmetic &mr = curve.GetField();
+			points.reserve(ECPCombTable::COMBS*ECPCombTable::ENTRIES);
+			for (unsigned int c=0; c<ECPCombTable::COMBS; c++)
+				for (unsigned int j=1; j<=ECPCombTable::ENTRIES; j++)
+				{
+					const word64 *P = table.GetPoint(c, j);
+					points.push_back(ToMontgomery(mr, ECPPoint(ECPCombTable::ToInteger(P, n), ECPCombTable::ToInteger(P+n, n))));
+				}
+		}
+
+		ECP curve;
+		Integer order;
+		std::vector<ECPPoint> points;
+	};
+
+	ECPCombCache() : m_entries(g_ecpCombTableCount) {}
+	~ECPCombCache()
+	{
+		for (unsigned int i=0; i<m_entries.size(); i++)
+			delete m_entries[i];
+	}
+
+	// like Singleton::Ref(), a race may build an entry twice, and then one copy is deleted
+	const Entry & Get(const ECPCombTable &table) const
+	{
+		Entry * volatile &slot = m_entries[&table - g_ecpCombTables];
+		Entry *p = slot;
+		if (p)
+			return *p;
+
+		Entry *newEntry = new Entry(table);
+		p = slot;
+		if (p)
+		{
+			delete newEntry;
+			return *p;
+		}
+
+		slot = newEntry;
+		return *newEntry;
+	}
+
+private:
+	mutable std::vector<Entry *> m_entries;
+};
+
+bool ECP::HasFixedBaseTable(const Point &G) const
+{
+	return m_combTable && !G.identity
+		&& ECPCombTable::Equal(G.x, m_combTable->GetGeneratorX(), m_combTable->words)
+		&& ECPCombTable::Equal(G.y, m_combTable->GetGeneratorY(), m_combTable->words);
+}
+
+bool ECP::FixedBaseMultiply(Point &result, const Point &G, const Integer &k) const
+{
+	if (!HasFixedBaseTable(G))
+		return false;
+	if (m_nistCurve)
+		return m_nistCurve->MultiplyBase(result, *m_combTable, k);
+
+	const ECPCombCache::Entry &entry = Singleton<ECPCombCache>().Ref().Get(*m_combTable);
+	const ModularArithmetic &mr = entry.curve.GetField();
+	const JacobianArithmetic ja(mr, entry.curve.GetA());
+	const Integer e = (k.IsNegative() || k >= entry.order) ? k % entry.order : k;
+	const unsigned int spacing = m_combTable->spacing;
+	ProjectivePoint R(mr.MultiplicativeIdentity(), mr.MultiplicativeIdentity(), mr.Identity());
+
+	for (unsigned int column = spacing; column-- > 0; )
+	{
+		ja.Double(R);
+		for (unsigned int c=0; c<ECPCombTable::COMBS; c++)
+		{
+			unsigned int j = 0;
+			for (unsigned int i=0; i<ECPCombTable::TEETH; i++)
+				j |= unsigned(e.GetBit((c*ECPCombTable::TEETH+i)*spacing + column)) << i;
+			if (j)
+				ja.AddMixed(R, entry.points[c*ECPCombTable::ENTRIES + j-1]);
+		}
+	}
+
+	result = FromMontgomery(mr, ja.ToAffine(R));
+	return true;
+}
+
 NAMESPACE_END
 
 #endif
@@ -5,6 +5,8 @@
 #include "eprecomp.h"
 #include "smartptr.h"
 #include "pubkey.h"
+#include "ecpnist.h"
+#include "ecpcomb.h"
 
 NAMESPACE_BEGIN(CryptoPP)
 
@@ -34,10 +36,11 @@ public:
 	typedef Integer FieldElement;
 	typedef ECPPoint Point;
 
-	ECP() {}
+	ECP() : m_nistCurve(NULL), m_combTable(NULL) {}
 	ECP(const ECP &ecp, bool convertToMontgomeryRepresentation = false);
 	ECP(const Integer &modulus, const FieldElement &a, const FieldElement &b)
-		: m_fieldPtr(new Field(modulus)), m_a(a.IsNegative() ? modulus+a : a), m_b(b) {}
+		: m_fieldPtr(new Field(modulus)), m_a(a.IsNegative() ? modulus+a : a), m_b(b)
+		, m_nistCurve(NISTPrimeCurve::Find(modulus, m_a, m_b)), m_combTable(ECPCombTable::Find(modulus, m_a, m_b)) {}
 	// construct from BER encoded parameters
 	// this constructor will decode and extract the the fields fieldID and curve of the sequence ECParameters
 	ECP(BufferedTransformation &bt);
@@ -54,6 +57,7 @@ public:
 	Point ScalarMultiply(const Point &P, const Integer &k) const;
 	Point CascadeScalarMultiply(const Point &P, const Integer &k1, const Point &Q, const Integer &k2) const;
 	void SimultaneousMultiply(Point *results, const Point &base, const Integer *exponents, unsigned int exponentsCount) const;
+	Point MultiScalarMultiply(const Point *points, const Integer *scalars, size_t count) const;
 
 	Point Multiply(const Integer &k, const Point &P) const
 		{return ScalarMultiply(P, k);}
@@ -78,6 +82,12 @@ public:
 	const Field & GetField() const {return *m_fieldPtr;}
 	const FieldElement & GetA() const {return m_a;}
 	const FieldElement & GetB() const {return m_b;}
+	//! returns whether scalar multiplications use the fixed width P-256 or P-384 arithmetic
+	bool HasFixedWidthArithmetic() const {return m_nistCurve != NULL;}
+	//! returns whether the generator G has a compiled in comb table, see ecpcomb.h
+	bool HasFixedBaseTable(const Point &G) const;
+	//! computes k*G with the compiled in comb table, returns false if G has none
+	bool FixedBaseMultiply(Point &result, const Point &G, const Integer &k) const;
 
 	bool operator==(const ECP &rhs) const
 		{return GetField() == rhs.GetField() && m_a == rhs.m_a && m_b == rhs.m_b;}
@@ -85,6 +95,8 @@ public:
 private:
 	clonable_ptr<Field> m_fieldPtr;
 	FieldElement m_a, m_b;
+	const NISTPrimeCurve *m_nistCurve;	// only set for curves in the standard representation
+	const ECPCombTable *m_combTable;	// likewise
 	mutable Point m_R;
 };
 
@@ -0,0 +1,48 @@
+#ifndef CRYPTOPP_ECPCOMB_H
+#define CRYPTOPP_ECPCOMB_H
+
+// the tables are in ecpcombtab.cpp, which is written by "cryptest ecct"
+
+#include "integer.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! compiled in fixed base comb table for the generator of a named prime curve
+/*! The subgroup order has at most TEETH*COMBS*spacing bits. Split an exponent into
+	TEETH*COMBS blocks of spacing bits, block m starting at bit m*spacing. Entry j-1 of comb c
+	is the sum of 2^((c*TEETH+i)*spacing) G over the bits i set in j, for 0 < j < 2^TEETH.
+	k*G is then reached with spacing doublings, each followed by one addition per comb.
+	Numbers are stored in 64-bit words, least significant first, points in affine x, y. */
+struct ECPCombTable
+{
+	enum {TEETH = 5, COMBS = 2, ENTRIES = (1 << TEETH) - 1};
+
+	const char *name;
+	unsigned int words;			// words per field element
+	unsigned int spacing;		// columns of each comb
+	const word64 *curve;		// p, a, b, x and y of the generator, subgroup order
+	const word64 *points;		// COMBS*ENTRIES points
+
+	const word64 * GetModulus() const {return curve;}
+	const word64 * GetA() const {return curve+words;}
+	const word64 * GetB() const {return curve+2*words;}
+	const word64 * GetGeneratorX() const {return curve+3*words;}
+	const word64 * GetGeneratorY() const {return curve+4*words;}
+	const word64 * GetSubgroupOrder() const {return curve+5*words;}
+	//! returns entry j-1 of comb c
+	const word64 * GetPoint(unsigned int c, unsigned int j) const {return points+2*words*(c*ENTRIES+j-1);}
+
+	//! returns the table for y^2 = x^3 + ax + b over GF(p), NULL if there is none
+	static const ECPCombTable * Find(const Integer &p, const Integer &a, const Integer &b);
+	//! returns whether x equals the number in the n words at w
+	static bool Equal(const Integer &x, const word64 *w, unsigned int n);
+	//! returns the number in the n words at w
+	static Integer ToInteger(const word64 *w, unsigned int n);
+};
+
+extern const ECPCombTable g_ecpCombTables[];
+extern const unsigned int g_ecpCombTableCount;
+
+NAMESPACE_END
+
+#endif
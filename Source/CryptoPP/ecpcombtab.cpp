@@ -0,0 +1,1491 @@
+// ecpcombtab.cpp - generator comb tables for named prime curves, see ecpcomb.h
+// written by "cryptest ecct ecpcombtab.cpp", do not edit
+
+#include "pch.h"
+
+#ifndef CRYPTOPP_IMPORTS
+
+#include "ecpcomb.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+static const word64 s_secp256r1Curve[] = {
+	W64LIT(0xffffffffffffffff), W64LIT(0x00000000ffffffff), W64LIT(0x0000000000000000), W64LIT(0xffffffff00000001),
+	W64LIT(0xfffffffffffffffc), W64LIT(0x00000000ffffffff), W64LIT(0x0000000000000000), W64LIT(0xffffffff00000001),
+	W64LIT(0x3bce3c3e27d2604b), W64LIT(0x651d06b0cc53b0f6), W64LIT(0xb3ebbd55769886bc), W64LIT(0x5ac635d8aa3a93e7),
+	W64LIT(0xf4a13945d898c296), W64LIT(0x77037d812deb33a0), W64LIT(0xf8bce6e563a440f2), W64LIT(0x6b17d1f2e12c4247),
+	W64LIT(0xcbb6406837bf51f5), W64LIT(0x2bce33576b315ece), W64LIT(0x8ee7eb4a7c0f9e16), W64LIT(0x4fe342e2fe1a7f9b),
+	W64LIT(0xf3b9cac2fc632551), W64LIT(0xbce6faada7179e84), W64LIT(0xffffffffffffffff), W64LIT(0xffffffff00000000),
+};
+
+static const word64 s_secp256r1Points[] = {
+	W64LIT(0xf4a13945d898c296), W64LIT(0x77037d812deb33a0), W64LIT(0xf8bce6e563a440f2), W64LIT(0x6b17d1f2e12c4247),
+	W64LIT(0xcbb6406837bf51f5), W64LIT(0x2bce33576b315ece), W64LIT(0x8ee7eb4a7c0f9e16), W64LIT(0x4fe342e2fe1a7f9b),
+	W64LIT(0xfa42e8729cf5250e), W64LIT(0x7bd24be788828675), W64LIT(0xde9ec29566d715ea), W64LIT(0xfcc8ca2e4e502d2e),
+	W64LIT(0x602e0fbf730fd4a2), W64LIT(0x9046bc05c03b2120), W64LIT(0xf6b9880a8b34da5c), W64LIT(0x30b57bcceef8bd04),
+	W64LIT(0xe32701e2825c702a), W64LIT(0x72fa8c04e4346a5a), W64LIT(0xeaedb84e95f15118), W64LIT(0x56be40ba4ec0f047),
+	W64LIT(0x89de6b694f2aae94), W64LIT(0x469a2f78430beb81), W64LIT(0x1dfe7ce1517e9954), W64LIT(0x1562f3045019fc91),
+	W64LIT(0xeea6bc92071e5c83), W64LIT(0x8bd27f198542a0be), W64LIT(0x20a845b72a58e5b1), W64LIT(0x54ccc9415026d73f),
+	W64LIT(0xcfd08ef7140916a1), W64LIT(0x929e0bcc5d8ee496), W64LIT(0x3a8f8715dad2bf22), W64LIT(0x1c433f45b4514532),
+	W64LIT(0xf7d24bb704bac870), W64LIT(0x593a09a03a23c6ab), W64LIT(0xdfcc2358f94c9d1d), W64LIT(0x3cfa0f87297bed02),
+	W64LIT(0xce98a30b40f26940), W64LIT(0x62121c0d0248a8af), W64LIT(0xa758aa808309af9b), W64LIT(0xe4e3769470be12c6),
+	W64LIT(0x6c85538ca3bcaabb), W64LIT(0xc0eb0a7cf946342c), W64LIT(0x7d6b1657684a7e37), W64LIT(0xb38cc3d5fd9ec5ad),
+	W64LIT(0xd94e6ecc3e8dca16), W64LIT(0x1a40ba21d9ad7e01), W64LIT(0xed26f7d28c5440f7), W64LIT(0x5eb5cf522fbafd41),
+	W64LIT(0x49bfcf955b343db9), W64LIT(0x2c766f5f04ce2eb1), W64LIT(0x20fe151f8e95c2af), W64LIT(0xec244b2e7e0d6ca2),
+	W64LIT(0xb9967511687ae015), W64LIT(0x335270c2c444b75d), W64LIT(0x9391f2d5a80da94c), W64LIT(0xd3e94721106b8296),
+	W64LIT(0x1ee45f92ed69f1d5), W64LIT(0x46543768ce5e1244), W64LIT(0xf0c6a4169281bf87), W64LIT(0x3fb5909a93dfe46a),
+	W64LIT(0x13d4fefe99a56cc5), W64LIT(0x25d35688fd0562b0), W64LIT(0x704a4e3a3bdf7754), W64LIT(0x549991ac0be8809f),
+	W64LIT(0x547053ca2c5368b2), W64LIT(0x981730b8766b72d4), W64LIT(0x2e96f57f5527d467), W64LIT(0x6c702cad3b5e2eb8),
+	W64LIT(0x739bd50fc05f6953), W64LIT(0x2af2ba25315b01bb), W64LIT(0x2eab48f7d15b2d82), W64LIT(0xff64f59492c79db7),
+	W64LIT(0x0a4a536b697fd082), W64LIT(0xff9e1ec20ec96def), W64LIT(0x5db0c8957a36308d), W64LIT(0x6bf056bcca15e223),
+	W64LIT(0xef1e988b45d04bfa), W64LIT(0xb55b753a659c7d8a), W64LIT(0x7d9d0ed5415cca2e), W64LIT(0xe969b016750db66f),
+	W64LIT(0x612cb4e754fc6a03), W64LIT(0x301f7472cac7f6f8), W64LIT(0x032480a7944ee42d), W64LIT(0x046ec1e2cdf5b886),
+	W64LIT(0x9762789813b2b8a3), W64LIT(0xf62df70cfdf28c0f), W64LIT(0x30049d407d53a084), W64LIT(0xddf8d65c4176ee31),
+	W64LIT(0x98ffbb24d3700176), W64LIT(0x441b81b1e9745ccd), W64LIT(0x69ce8c9a51d5d133), W64LIT(0x399b77d903e20f32),
+	W64LIT(0xbacb586f9cc13e6b), W64LIT(0xbd6257183a0fffde), W64LIT(0x8c638a1f15c4a11d), W64LIT(0x84ad3cb2fec9fdb8),
+	W64LIT(0xede5684dd4f071cd), W64LIT(0x4c4a88f0dc9401c5), W64LIT(0x48b59d472d9a285f), W64LIT(0x464389ff1ba86cb6),
+	W64LIT(0xafcb874e272d292e), W64LIT(0x6df0e597615fe66e), W64LIT(0x937595876b2a3ccc), W64LIT(0x5802efe1c6410163),
+	W64LIT(0x6c5fa88ba33b76b7), W64LIT(0xf6b8a9fda8c6536b), W64LIT(0xb8a775ecc24d7ee2), W64LIT(0x4d0fe1ef34a3bc8c),
+	W64LIT(0xabd419869a726ede), W64LIT(0x93a25307e18bde10), W64LIT(0xa71a2fbe5bd982f9), W64LIT(0xc1c04a695f3a9a18),
+	W64LIT(0x2a92a905521d0449), W64LIT(0xfa4c20bb33004991), W64LIT(0x6d1bedd86755cc1d), W64LIT(0xa9eeaf81887d001e),
+	W64LIT(0x6304b390fb5bf5a4), W64LIT(0xcc8399da896b716d), W64LIT(0xcc003b44b8abb96c), W64LIT(0x5a2e4b3183ec1e29),
+	W64LIT(0xc739a5ea3ecca7e0), W64LIT(0xa7d2c98f6743333e), W64LIT(0x0fef6335224d9428), W64LIT(0x7ef2ee3c5c792a0c),
+	W64LIT(0x302b22dd552ac094), W64LIT(0x81b21450dfbd3d20), W64LIT(0xa4f67f51d5e609db), W64LIT(0xafb6862730acc011),
+	W64LIT(0xdd37e3ff86ef7d7d), W64LIT(0xf6d77c27088b86db), W64LIT(0x28fe9a4f254c5491), W64LIT(0xd66903376df0fd5e),
+	W64LIT(0x9ff04992addad596), W64LIT(0xf3d1a7af9e4373f9), W64LIT(0xa13e9578df074167), W64LIT(0x20e2a53ce6d13d22),
+	W64LIT(0xf37210b9e0d55531), W64LIT(0x8230d5cbcaa03585), W64LIT(0x2fa457085b992ddf), W64LIT(0x16a5b9be0cd20bb3),
+	W64LIT(0x69ea11a5b5e3c335), W64LIT(0xa3fffe877bf478fe), W64LIT(0x7da556f6b4092a35), W64LIT(0xbd3f9bf6119009fd),
+	W64LIT(0x3617683f2a02fd11), W64LIT(0x3df1e27406808433), W64LIT(0xd8f68f41fd5f5b6f), W64LIT(0x398657777d166050),
+	W64LIT(0x408bfafb2fbeb0af), W64LIT(0xf39f5db6abb4ccf1), W64LIT(0x07737bfc2d2a0394), W64LIT(0x817b3528ecfeed78),
+	W64LIT(0xd7b86aeeb0879605), W64LIT(0xa424ec2dbe3c7265), W64LIT(0x276203c212f01e9e), W64LIT(0xb666fac5b77e46e9),
+	W64LIT(0xf431bb1a3bf0c52d), W64LIT(0xef46a44a726cd8b6), W64LIT(0xeb5abc19ee3de5a9), W64LIT(0x38aaa38090246904),
+	W64LIT(0xaebfd735525d6abf), W64LIT(0xc302f8f496bea25a), W64LIT(0xdb82b3ea544920a4), W64LIT(0x621c75d102eadb2e),
+	W64LIT(0x8939dc4c9ef485f0), W64LIT(0x225d03d857c46d63), W64LIT(0x4fdac96f522d7f70), W64LIT(0xd7c4a4feb4fa649d),
+	W64LIT(0x1c04741c68db97f8), W64LIT(0xf01465f3916ba563), W64LIT(0x253d4a6245a9ee46), W64LIT(0x6ab0cf74caea37b6),
+	W64LIT(0x47c935cafdb26724), W64LIT(0x2ff5321efac63219), W64LIT(0x43611b632e403564), W64LIT(0x5f03e32699102724),
+	W64LIT(0xc8502dfb71c6231a), W64LIT(0x3e58da1d70771946), W64LIT(0xe5f30a69f636b341), W64LIT(0xedaacf1658452ad1),
+	W64LIT(0xac51b682d43b0c4c), W64LIT(0x8117b89d6de9eb5a), W64LIT(0xbfe73404a9c685cd), W64LIT(0xc52f474b4521bbdd),
+	W64LIT(0x23873617c8c53128), W64LIT(0x3208434359bfe7aa), W64LIT(0x93849f79fe8e934c), W64LIT(0xb1f4a3f1a6846047),
+	W64LIT(0x78852427c7757c2c), W64LIT(0x2192f0d00ce810dc), W64LIT(0x94e41ac5b2239cd5), W64LIT(0x6560a9b1c2a8a16f),
+	W64LIT(0x6f43723e54ea5129), W64LIT(0x1aa8d0f3878d080e), W64LIT(0x65b1c3291bc273f2), W64LIT(0x642d9430b2a7b855),
+	W64LIT(0x88075e6b3d8c2957), W64LIT(0x7413eeeb716aabc4), W64LIT(0x024387b7caeab802), W64LIT(0xa7a0ba01cf6e8aa1),
+	W64LIT(0xac6a2b7653d0d49f), W64LIT(0x097521fe65d37d66), W64LIT(0xe6902f481fd4b69a), W64LIT(0x1b6e5e13701ba5d4),
+	W64LIT(0x852b7d4d48427c72), W64LIT(0xe13739c5438fcd12), W64LIT(0x1ff6a1bf3138c26b), W64LIT(0x0b914b7f3bc125a8),
+	W64LIT(0x7fe64d546d8910f2), W64LIT(0xbfc22c442561cfd5), W64LIT(0x75101d0e7ed6a265), W64LIT(0x6ffd07cff1fc9baf),
+	W64LIT(0xbed21a23f309fd75), W64LIT(0x88038b7f14b6a1f8), W64LIT(0x22f4c927119bd57a), W64LIT(0xe80f9ae1b5e66acf),
+	W64LIT(0x125d50fb5a9ac374), W64LIT(0xa7909996ed129135), W64LIT(0x32e262dae10c1fca), W64LIT(0x0007e8a9911b6a4f),
+	W64LIT(0xbccb12935f03b4e8), W64LIT(0x187a7859b67d1b4a), W64LIT(0x16325ead2766352f), W64LIT(0x7da75302786bec3b),
+	W64LIT(0x9898c0fe9003ae75), W64LIT(0x6ec9b21cf431f975), W64LIT(0x73c92c16ae6eef9f), W64LIT(0x4839224120c77e5a),
+	W64LIT(0x5724e3e7a33c2297), W64LIT(0x80913225e74a01ef), W64LIT(0xf59190a3fc05c31f), W64LIT(0x1c9e1c5fdc0f2806),
+	W64LIT(0xbe8b3c8588b2723d), W64LIT(0x7d2b0938bbbce521), W64LIT(0xeabfd44666a57ad8), W64LIT(0x5032839b9936f70a),
+	W64LIT(0x060a9f958c1713a2), W64LIT(0x21b44d4bba507b3f), W64LIT(0xe6223e2dc4b22b32), W64LIT(0x37e162549b814b91),
+	W64LIT(0xe67efd700669a0ee), W64LIT(0x7851c07713c9f5b2), W64LIT(0xfd91b9d88c80a58f), W64LIT(0x51cc95137bb31c39),
+	W64LIT(0x7064f298c59363ee), W64LIT(0x9f1d385232638720), W64LIT(0x266426ca6e132aa1), W64LIT(0xe673ee1d92cc6508),
+	W64LIT(0xf6f1d3ac4d771f0c), W64LIT(0xacad16e63be0aea8), W64LIT(0x18e63add579547f0), W64LIT(0x2890d721e57e1961),
+	W64LIT(0x0a5728ecb5890d78), W64LIT(0x7dc0e7f77ef54069), W64LIT(0xaf77e1d1416752ec), W64LIT(0x69b5b8159ddc032a),
+	W64LIT(0x9c762ef1943e832a), W64LIT(0x07e50ab01786df70), W64LIT(0x90f573a82589f18e), W64LIT(0x0d2bf28ba7c2a51a),
+	W64LIT(0x48263af15b20d37c), W64LIT(0x27ec9db960551446), W64LIT(0x7087a10a94b4e7ed), W64LIT(0x0cac3f4313bd00ac),
+	W64LIT(0x44f3f1c8db123e69), W64LIT(0x44d623accf01eb43), W64LIT(0xcf0af377d2024506), W64LIT(0xa3228d6a4411295f),
+	W64LIT(0x4efca186416f05d5), W64LIT(0x37838e545ff0eead), W64LIT(0x091bcf79d6bfc1e1), W64LIT(0xa085d05bdbca1412),
+	W64LIT(0xc5f483aaa556ed7a), W64LIT(0xf6bada2932f50e57), W64LIT(0x154a04034f63c34a), W64LIT(0x9a6cabe1f8c78b4f),
+	W64LIT(0x2521483ea054a72e), W64LIT(0xfeb87eafd1220716), W64LIT(0x1de544fb7d555740), W64LIT(0xed9f5029fad50045),
+	W64LIT(0xa7298065f4490024), W64LIT(0xb2615f6fb16af773), W64LIT(0xc2f8433ce90fad59), W64LIT(0x19f3f6a979ad793e),
+	W64LIT(0xc7408f9027ef1682), W64LIT(0xb38df04f239f4cf7), W64LIT(0x44d6741944a37e80), W64LIT(0x2915ae393e1f1d9b),
+	W64LIT(0xe4a73cea35e389d5), W64LIT(0xe796fee0ee49aab0), W64LIT(0x03b67577dce36195), W64LIT(0x3f208d977fef1356),
+	W64LIT(0xe8fc5af637f2c3e1), W64LIT(0x6942b7d19c441180), W64LIT(0x5f1b03fe78a0fd99), W64LIT(0x96faea32ca72748b),
+	W64LIT(0xcdaa3646957cf5cc), W64LIT(0xec89248b55907514), W64LIT(0xd5f3ee08d7fae8e1), W64LIT(0x760feb95e2198b45),
+	W64LIT(0x952117ff4d64958a), W64LIT(0x0c911aa9526473bc), W64LIT(0xdb96a6aeb2d79b4b), W64LIT(0x5f25613bbe47d506),
+	W64LIT(0x320f09c3839bb85f), W64LIT(0x0101fb06a050e62c), W64LIT(0x557582c99ad53458), W64LIT(0x55d5398d1666432b),
+	W64LIT(0xf7f631184fed936f), W64LIT(0xd90d6a7f1833d9e1), W64LIT(0x059c6a9e8ebaa72a), W64LIT(0x576e229049ff8e2d),
+	W64LIT(0x41ca5737e3e0cd44), W64LIT(0x1370ced8ba3ff4ea), W64LIT(0x834ba01ac2a1821d), W64LIT(0xc136448726da7464),
+	W64LIT(0x4a9eef921888d9b4), W64LIT(0x881d0e034a0df88b), W64LIT(0x2f4eb7667f1b88aa), W64LIT(0xc94ddf18ca39af1b),
+	W64LIT(0xb4a196fb6471aaa0), W64LIT(0xdcbab6501b6b9730), W64LIT(0x7afccc8a295b57d2), W64LIT(0xee2280f44e33a65d),
+	W64LIT(0xc47a0803890fcd12), W64LIT(0x4e98a98d82604f6b), W64LIT(0x0d598f06ed5fbbd2), W64LIT(0xce46ec91a6a1eb84),
+	W64LIT(0x1357c50f38e69272), W64LIT(0x92945ff5ddbf433b), W64LIT(0x8b1150cd2807c2b7), W64LIT(0xb7d69f5b40934032),
+	W64LIT(0x30554a2f135c56bc), W64LIT(0x97f570cac7153a3e), W64LIT(0xb8922c0450f8a1ab), W64LIT(0x91673c45d9e09c54),
+	W64LIT(0x302b477503372910), W64LIT(0xb907ed6d94cbdd5e), W64LIT(0x66eee21a1126675b), W64LIT(0x630f25f4bf5337a1),
+	W64LIT(0x648e1da9046ffcec), W64LIT(0x79faad3d755249cf), W64LIT(0x0d15e345af68972b), W64LIT(0x0d54e71f0e09d448),
+	W64LIT(0x3195d4afbfba88cc), W64LIT(0x235dda08cd875982), W64LIT(0x7cb8a149d9360efb), W64LIT(0x55dbaeea51ebfc73),
+	W64LIT(0xad087c8636ddcac3), W64LIT(0x78143f78cf186b36), W64LIT(0xa5dcc061593a4ba7), W64LIT(0x118bd46e6a73beac),
+	W64LIT(0x46b124f338c4cd05), W64LIT(0xef9b53c1de500c02), W64LIT(0x4b5abb57f14f34ea), W64LIT(0x6e2625da4df95e93),
+	W64LIT(0xa820637d4995ec98), W64LIT(0xdb082c13393c763c), W64LIT(0x4b0f3623d9bef910), W64LIT(0x6481101cc114be61),
+	W64LIT(0x2e3853359b572160), W64LIT(0xd284aa51fccf197b), W64LIT(0xb684b4d272f0afdf), W64LIT(0x024070f4226c1e89),
+	W64LIT(0xa94fdde45bc530f5), W64LIT(0x85ce9d59e8504596), W64LIT(0xf734f9c3781438a5), W64LIT(0x0c97cb9245e86432),
+	W64LIT(0xbe5cc18760a81cad), W64LIT(0x822c3c1cb43b223b), W64LIT(0x37151ef349506cf4), W64LIT(0x8bfbee24c6e52618),
+	W64LIT(0x6986b9515ff0013e), W64LIT(0x8d9fc8ecacfd2376), W64LIT(0x0cfd289fe71be151), W64LIT(0xd75127caa3409b59),
+	W64LIT(0x6885535346302b92), W64LIT(0xeabfa335fa607527), W64LIT(0x627d691a9e5afdc9), W64LIT(0x0382d67ba1c3063c),
+	W64LIT(0x74f0626e05101429), W64LIT(0x372dec058e731b99), W64LIT(0x3d1ac1db4617f507), W64LIT(0xf5a257d366df1d88),
+	W64LIT(0x42a1061346a3e090), W64LIT(0x3d2bb5be2af0a073), W64LIT(0xc2cade2ff06a5153), W64LIT(0xd8d941291c8291f3),
+	W64LIT(0x479396872d7faef4), W64LIT(0xe802be1f0509fc34), W64LIT(0x545dfa471db101ad), W64LIT(0x9641ec8907eb7a09),
+	W64LIT(0xc0851cabf7efb3e9), W64LIT(0x18893c70ea671ee3), W64LIT(0xbb336df21514b9d3), W64LIT(0x32c2eb2a3ae2f165),
+	W64LIT(0xfa497951022a39cd), W64LIT(0xe49ccab0d9c06a0f), W64LIT(0x5b66231b336820d5), W64LIT(0xda5bf44b2a778931),
+	W64LIT(0x26673b3b721fd25c), W64LIT(0x507daff55c391a0b), W64LIT(0x0d3d49baa4389916), W64LIT(0xafa99c48a12488c9),
+	W64LIT(0x5888c3d1bac80f67), W64LIT(0xe213a99261b1bee5), W64LIT(0xd946eac6329ead9c), W64LIT(0xb739983c41cc176c),
+	W64LIT(0xfcc5d86f603122ca), W64LIT(0xec3cd6890c86e4ce), W64LIT(0x9939c538245626d9), W64LIT(0x5a3b59543967278c),
+	W64LIT(0x3d00d228858a9502), W64LIT(0x9213d6862550cd4c), W64LIT(0x349a897feb49d3a7), W64LIT(0x029c981c5aee7a22),
+	W64LIT(0x89fbc00bbbf4bf64), W64LIT(0xabd67dd62fe9b608), W64LIT(0x3d1100d9cb7270a3), W64LIT(0x571581ba58d63bde),
+	W64LIT(0xbc18ff8bf042b755), W64LIT(0x8b8b88ca1b8ffa4b), W64LIT(0xb261b0ff5d98520e), W64LIT(0x961276f9ad4fe9dc),
+	W64LIT(0xe6fd7072673f2b7d), W64LIT(0x8a6196c0c7305bad), W64LIT(0x7ab4466976e7a740), W64LIT(0xce7bba24d2c9bcab),
+	W64LIT(0xb8f0b355e77c9992), W64LIT(0x22175cc0d88998ac), W64LIT(0x35b00edbd750b4f4), W64LIT(0xd4e96db15e41acb2),
+	W64LIT(0x5f0a758ed74be367), W64LIT(0x9092aeef39fa3f60), W64LIT(0x42dd7b8091dd5194), W64LIT(0x77de00e9c421e4e1),
+	W64LIT(0x026e79302e54f3e0), W64LIT(0xda20b71a3a0ed1ac), W64LIT(0x5dccff1a68710e1a), W64LIT(0x5508a4abec79d370),
+	W64LIT(0xea9ab08e90eca15d), W64LIT(0x33ca3df4144bf79d), W64LIT(0x63da923f6e6d3e83), W64LIT(0xe5c845df528fd586),
+	W64LIT(0x1ad6982268abe09f), W64LIT(0x2884864dc1b918e3), W64LIT(0x86b596a4aa29d418), W64LIT(0xbeed8f2116bd077c),
+	W64LIT(0x955af3d2d0917ec3), W64LIT(0x8421120e6e6bae13), W64LIT(0xe6557305882801fd), W64LIT(0x7f3a797b510cede6),
+	W64LIT(0xb9aec691f850e021), W64LIT(0x35126765986aae8a), W64LIT(0x5aab3601135e3b39), W64LIT(0x03d9858e25690122),
+	W64LIT(0xc8aca71a57aae3b2), W64LIT(0x5f53607c69352585), W64LIT(0x2e0c9e269abc6b25), W64LIT(0x0ec5a89bdc9c5a51),
+	W64LIT(0x17a2453a88212d39), W64LIT(0x3b9eb348a03636ea), W64LIT(0xe9101aa29e10babc), W64LIT(0x58e3f246663b0892),
+	W64LIT(0x1e36de330e7426b1), W64LIT(0xb66b8911646d85b7), W64LIT(0x3f6041c546166e60), W64LIT(0x512dfd479af473f2),
+	W64LIT(0x18139080340fd69c), W64LIT(0x8e6c3137b36f5562), W64LIT(0x5fbf5a10e4ff2f25), W64LIT(0x229e471ac0067003),
+	W64LIT(0xd76f150357f6ed46), W64LIT(0x6478a4566dc72659), W64LIT(0x1c088f86c6a9eb64), W64LIT(0x7f33a49f381c32d1),
+	W64LIT(0xa14bc534b05f9da4), W64LIT(0x277a98b0615e01d4), W64LIT(0x02cd53dfcf44cb4d), W64LIT(0xc23a27a21278dc63),
+	W64LIT(0x073fb19a64c18acf), W64LIT(0x4a6883c1e0c9b993), W64LIT(0x95c4e274a6015901), W64LIT(0xef383dcfebfdd080),
+	W64LIT(0xe98df0f843f3ac43), W64LIT(0xf71f3b028ee77974), W64LIT(0x6732c2c888252b11), W64LIT(0x1e335ca5171f0ded),
+	W64LIT(0x5c4b7fbff3cb330e), W64LIT(0x0e2741f490da5502), W64LIT(0x98322ea16bf7a522), W64LIT(0xa35c6a90bf57077a),
+	W64LIT(0x051927051a626f0f), W64LIT(0x8de0747835a70769), W64LIT(0x7d909f95195630ac), W64LIT(0x1bfcdf02e4b5e675),
+};
+
+static const word64 s_secp384r1Curve[] = {
+	W64LIT(0x00000000ffffffff), W64LIT(0xffffffff00000000), W64LIT(0xfffffffffffffffe), W64LIT(0xffffffffffffffff),
+	W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0x00000000fffffffc), W64LIT(0xffffffff00000000), W64LIT(0xfffffffffffffffe), W64LIT(0xffffffffffffffff),
+	W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0x2a85c8edd3ec2aef), W64LIT(0xc656398d8a2ed19d), W64LIT(0x0314088f5013875a), W64LIT(0x181d9c6efe814112),
+	W64LIT(0x988e056be3f82d19), W64LIT(0xb3312fa7e23ee7e4),
+	W64LIT(0x3a545e3872760ab7), W64LIT(0x5502f25dbf55296c), W64LIT(0x59f741e082542a38), W64LIT(0x6e1d3b628ba79b98),
+	W64LIT(0x8eb1c71ef320ad74), W64LIT(0xaa87ca22be8b0537),
+	W64LIT(0x7a431d7c90ea0e5f), W64LIT(0x0a60b1ce1d7e819d), W64LIT(0xe9da3113b5f0b8c0), W64LIT(0xf8f41dbd289a147c),
+	W64LIT(0x5d9e98bf9292dc29), W64LIT(0x3617de4a96262c6f),
+	W64LIT(0xecec196accc52973), W64LIT(0x581a0db248b0a77a), W64LIT(0xc7634d81f4372ddf), W64LIT(0xffffffffffffffff),
+	W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+};
+
+static const word64 s_secp384r1Points[] = {
+	W64LIT(0x3a545e3872760ab7), W64LIT(0x5502f25dbf55296c), W64LIT(0x59f741e082542a38), W64LIT(0x6e1d3b628ba79b98),
+	W64LIT(0x8eb1c71ef320ad74), W64LIT(0xaa87ca22be8b0537),
+	W64LIT(0x7a431d7c90ea0e5f), W64LIT(0x0a60b1ce1d7e819d), W64LIT(0xe9da3113b5f0b8c0), W64LIT(0xf8f41dbd289a147c),
+	W64LIT(0x5d9e98bf9292dc29), W64LIT(0x3617de4a96262c6f),
+	W64LIT(0xcbd89c74ee69fc0f), W64LIT(0xceaa5177777bd97c), W64LIT(0xe113574a03955391), W64LIT(0x98bb969c1b6fcf81),
+	W64LIT(0xd1c6bce564591d15), W64LIT(0x1ec28025ba330842),
+	W64LIT(0xfd1e4b9e34829dc8), W64LIT(0x1b0007d15b2aadde), W64LIT(0x391dee1c25ecf474), W64LIT(0xd41ee6ec70ba0b4d),
+	W64LIT(0xe3c9e311a942b396), W64LIT(0x7bbc02cdba9a279c),
+	W64LIT(0xdb8086a4f66637f5), W64LIT(0x55cf72f57704f3b9), W64LIT(0xeb4a6c2832a6990b), W64LIT(0x57c6f4e6911db9e3),
+	W64LIT(0x503b5599c9f59c20), W64LIT(0x31fb52bcd920a08f),
+	W64LIT(0xb4e217be26cfe2fe), W64LIT(0x54358fe7a00c158b), W64LIT(0x37194153be896d26), W64LIT(0x9a27068a39f80172),
+	W64LIT(0xeaf1fef99993a5d3), W64LIT(0xed3ee1589296ccd4),
+	W64LIT(0x63c86b9043ad5051), W64LIT(0x3e5a44a7037db034), W64LIT(0x464719634f6bbc3e), W64LIT(0xbcbee39a6d59f0c5),
+	W64LIT(0x89b81c4f6a8ece33), W64LIT(0x79d29243dcde4107),
+	W64LIT(0xce4e0ce5928f3240), W64LIT(0xb32dd9da7579045d), W64LIT(0x24c45a58ec1346f4), W64LIT(0x4204b65694918c2e),
+	W64LIT(0xe225dcce675bbb07), W64LIT(0x99a5cf1bd320b877),
+	W64LIT(0x3ed4e32aa7d9380d), W64LIT(0x396354f9877f918c), W64LIT(0x70955cafbd840bcc), W64LIT(0x3431cc25255eacfb),
+	W64LIT(0x4db66f1bae87ba46), W64LIT(0x07f514bf94bc480b),
+	W64LIT(0x52b1b62a3dd78ff1), W64LIT(0xf0dfdac758022f46), W64LIT(0xf818ebc452f6bac5), W64LIT(0x54ecc52ced2c79ab),
+	W64LIT(0x5d107bed3f0e64a6), W64LIT(0x90848d10a74d518b),
+	W64LIT(0xa81a8c48e8b1c294), W64LIT(0xbe3b9f887e98ec77), W64LIT(0x1b8baf73966268f8), W64LIT(0x27e24c03c7cb8572),
+	W64LIT(0x088caf80e2d07be3), W64LIT(0x90fea81f1ab8a70f),
+	W64LIT(0x98a210bab87be8f5), W64LIT(0xd16d0cad9e211036), W64LIT(0x7e16a6264fb73498), W64LIT(0x5d56b1431ac70f38),
+	W64LIT(0x4249c172244689ee), W64LIT(0x0dfaf4f57fc65a6a),
+	W64LIT(0x98ee74634014a5b0), W64LIT(0x58cee641dc36ee23), W64LIT(0x338314b79d8a7b66), W64LIT(0xaae9eb73e7f3fc4e),
+	W64LIT(0x3f861f51241028d3), W64LIT(0x59d238eadb4e162e),
+	W64LIT(0x4d495ecec4a59deb), W64LIT(0x3ed4efd4262be0c9), W64LIT(0xfc4336945ed70a74), W64LIT(0xd76bec67d35460a4),
+	W64LIT(0xcb5cb04a6df24e5f), W64LIT(0x00bf97febefe7017),
+	W64LIT(0x61f246f15d80df16), W64LIT(0x282c3a338e87308b), W64LIT(0x0df0a00e089c502c), W64LIT(0x9f92bc778c637292),
+	W64LIT(0xb92542956c78bda4), W64LIT(0xd4fb4faf93aafe25),
+	W64LIT(0x6d4f49077dbf2133), W64LIT(0x496473960d783e12), W64LIT(0x30ee099eb6c179c2), W64LIT(0xaeed6fabd9f6fcdc),
+	W64LIT(0x269eacb5636724d3), W64LIT(0xb6224913af108fb9),
+	W64LIT(0x088d66b3c366994e), W64LIT(0x89a35f66cff068fd), W64LIT(0x1c1fd77b8110e5d1), W64LIT(0x8e6be3a50f24fa70),
+	W64LIT(0x0f6c418e2fc10d36), W64LIT(0x3a03d9b3467dd55e),
+	W64LIT(0xaf9b2f397530b712), W64LIT(0xc8647675924711f1), W64LIT(0x80c606e28c1fbc04), W64LIT(0xbd4fe8487079ec35),
+	W64LIT(0x64bbee4655ce2c91), W64LIT(0x5b5c81fcf4fb4c4b),
+	W64LIT(0x40adf57cb33ab156), W64LIT(0x5ad499f3c3cb2891), W64LIT(0x7420794e7c7fb275), W64LIT(0xcab80c22ae380f4a),
+	W64LIT(0x91d4394542a8f8f2), W64LIT(0xd60d871fe460de06),
+	W64LIT(0xb713c319fe676195), W64LIT(0x7a1e0414bdee917f), W64LIT(0x10aa8b14b033a319), W64LIT(0xa1d8c9ba29cfd427),
+	W64LIT(0xbce788a021d7a7f5), W64LIT(0x9c2b6ba5e4fc0458),
+	W64LIT(0xf3e8e8557adc8563), W64LIT(0x0e076d2fc0688b84), W64LIT(0x74407601a803569b), W64LIT(0x1286ea01508b3d0b),
+	W64LIT(0xf49944b7432fcff8), W64LIT(0x6f2045dbd6925c77),
+	W64LIT(0x182c2386677bb469), W64LIT(0x4812bdc9d15b065e), W64LIT(0xa28c08e68f2b57cd), W64LIT(0x9e99ac3330f3c9d0),
+	W64LIT(0x64052479651802e7), W64LIT(0x6060bc485d80b52f),
+	W64LIT(0xfd78ca57e919214e), W64LIT(0x16453e6250b49f10), W64LIT(0x3a787101fdcd57e3), W64LIT(0x9d64f846221bd7d7),
+	W64LIT(0x1dd7cc939fe1e20b), W64LIT(0x75e8d61466f8e384),
+	W64LIT(0xe3b664bfcbf5afe9), W64LIT(0xe6f4e6d26f1e2a23), W64LIT(0x72a5fa989d896e31), W64LIT(0xd52dffa04366769c),
+	W64LIT(0x17934f9fae97d7d3), W64LIT(0x4e18366b73d78631),
+	W64LIT(0x875824b29985d9fb), W64LIT(0x6c7784ba46826c09), W64LIT(0xb6fad1fd0244922e), W64LIT(0x94a6f8fbb87a6ea7),
+	W64LIT(0x95fdf14069d5e91c), W64LIT(0x00ef8cf6c76a83ff),
+	W64LIT(0xa0a1e77f31caba4f), W64LIT(0x00c37c31f377e1b6), W64LIT(0x471c61b2fd380c3f), W64LIT(0x854477d91719f389),
+	W64LIT(0x706e43770c02370e), W64LIT(0x9134441ca11fc671),
+	W64LIT(0x4caf5c7737621de3), W64LIT(0xa88dc671ee7708db), W64LIT(0x100ae731adfa43f6), W64LIT(0x109b1e2a5dd06ed8),
+	W64LIT(0xbbdbe06de76967b3), W64LIT(0xb4694adba9884189),
+	W64LIT(0x53a787bbfc28f624), W64LIT(0x7c85be18e1092463), W64LIT(0xe38bf2298af89d4b), W64LIT(0xfcecc998619c6c35),
+	W64LIT(0x9f8f19b3ad115a28), W64LIT(0x4e8a11a2856ca1c4),
+	W64LIT(0x68d529b9b5926c2a), W64LIT(0x83247fb457a30518), W64LIT(0xc680e252d180932d), W64LIT(0x8febd69a59591dc5),
+	W64LIT(0x27ff68392ad92421), W64LIT(0x2a4c5c3cd9940da1),
+	W64LIT(0xcd0a7583f636c08c), W64LIT(0x2665a64c2b3b561d), W64LIT(0x40f48e442619bd9c), W64LIT(0x9c10d6fc97306168),
+	W64LIT(0x82a1d45b0ba162aa), W64LIT(0x585ddad9cce6163c),
+	W64LIT(0x98163d1791f22d45), W64LIT(0xdb56b796c56e9558), W64LIT(0x84d529756d0f4d11), W64LIT(0x0e7c0d8fd2000d91),
+	W64LIT(0xdd83eadfe0e16028), W64LIT(0xd15fdfb4eccf825f),
+	W64LIT(0x183b44e192b01ea6), W64LIT(0x7414770c01ae050c), W64LIT(0xf339b53dd705d880), W64LIT(0xab2344ebfaa8f031),
+	W64LIT(0x04ae4be665ab7f33), W64LIT(0x1bbea6c38ab95c34),
+	W64LIT(0xcc650cdc1e1e6c79), W64LIT(0xd5ae875d1562b7d5), W64LIT(0x652cf2c8afb94d4e), W64LIT(0x4a9d8ae79856bdc7),
+	W64LIT(0x80e1b080be8f3fff), W64LIT(0x0f4f432c9bb0b3f5),
+	W64LIT(0x5c2405696bfd1abc), W64LIT(0xc2059b49a36de353), W64LIT(0x4f8157d1a53aaca0), W64LIT(0x3034162ec63311c8),
+	W64LIT(0xef8e8f8c441bec88), W64LIT(0xc78ef19109b6d189),
+	W64LIT(0xd5c7f047a489f7bf), W64LIT(0x49a2af5091438bf6), W64LIT(0x6aaa1811e4602baa), W64LIT(0x17a4f535285e2cc2),
+	W64LIT(0x1ecd00116ce27a92), W64LIT(0x94169ec8057d33ef),
+	W64LIT(0x43a71ad55d813ba0), W64LIT(0x195598ac354057d8), W64LIT(0x8949426e20573bee), W64LIT(0x73a8e034ff2fe3a6),
+	W64LIT(0xf44d96ec859f322d), W64LIT(0x8aeeff627dbef59a),
+	W64LIT(0xda50068459211c0a), W64LIT(0x9f0bbb31c01c9978), W64LIT(0x2449c47ed509bd31), W64LIT(0x1a89e55018ef274f),
+	W64LIT(0x5965c52ba10d3ec8), W64LIT(0x437adfd8a34b2c0a),
+	W64LIT(0x03cc8e48a76d4a5b), W64LIT(0x41cf2fa2fd3b0d4e), W64LIT(0x1309b8d1aa93a9e8), W64LIT(0xe6594df4d5894362),
+	W64LIT(0x50e46fbd38af14d5), W64LIT(0x6dcf75e5b9c63b98),
+	W64LIT(0xf892c6560ec655c3), W64LIT(0xd38f0887380dc09b), W64LIT(0x588b5a6aa08b4263), W64LIT(0x2df0f08dee510538),
+	W64LIT(0x6cc88ff6e0fa458f), W64LIT(0x43ccff5e2ff5684d),
+	W64LIT(0x8fef54cc029ea2d1), W64LIT(0x21f31f7c8703e243), W64LIT(0x6c538c94c945d2f3), W64LIT(0xd6d2086b00f0fc32),
+	W64LIT(0xe9f12c81caa4fb1c), W64LIT(0x8b10cd3a3c942643),
+	W64LIT(0x06b9cbe5271a72fd), W64LIT(0x6858660d8f6fced7), W64LIT(0x155d6ca19177e087), W64LIT(0x831e016ebd334f38),
+	W64LIT(0xd673d487c3d826aa), W64LIT(0xe3ffb7269f544b1a),
+	W64LIT(0x4ac6e69458a7c088), W64LIT(0x3911fd331a3b3331), W64LIT(0xa9d4eb6232126da8), W64LIT(0xb63767850f05eb8a),
+	W64LIT(0xd47cb267ee5669c2), W64LIT(0xe3c7362d7d0c619d),
+	W64LIT(0x2bdc755880b22c87), W64LIT(0xf66c85d05967205f), W64LIT(0x7366a50510bbefa6), W64LIT(0xdda15872e2ad0f39),
+	W64LIT(0x6f537ae8009ba6be), W64LIT(0xc8c0c1d979f9e421),
+	W64LIT(0x286b49a512870d40), W64LIT(0x76ea7ca805acab90), W64LIT(0xf95caa8f6bacad99), W64LIT(0x4cef9fd3093dab71),
+	W64LIT(0x37bb76a4ca44774a), W64LIT(0x6ccd480a28bb7f1d),
+	W64LIT(0xdfbaa94d588c3af9), W64LIT(0x8a3ec82dfc0324bf), W64LIT(0x30606737a89490fb), W64LIT(0x89d716e21ed11547),
+	W64LIT(0x80a3cbd02e1baa7f), W64LIT(0xfcbe113579ed856a),
+	W64LIT(0x90c8e4361a9aad48), W64LIT(0x90580aceee4baa03), W64LIT(0xe14749651f6099fb), W64LIT(0x05e09a14a21fbd0f),
+	W64LIT(0x5143af0e0cd0e894), W64LIT(0x92675b3f347bb351),
+	W64LIT(0xe6d398f0a1815d15), W64LIT(0x0ba75ee0e7741b13), W64LIT(0x43d592678cf78a40), W64LIT(0x33e20a068126c86a),
+	W64LIT(0xfe7de35e225ac056), W64LIT(0xfb6110d6c5341e8f),
+	W64LIT(0xe49110c554128e80), W64LIT(0x347982f8cb7873af), W64LIT(0xe1b6f02ee40a0f5e), W64LIT(0x0b938562aa40f9ed),
+	W64LIT(0xe7d203bd667cf91b), W64LIT(0xe7d77e7e30451e7f),
+	W64LIT(0x49da15b4ee880376), W64LIT(0x87a48ecbfdd83198), W64LIT(0x7fb7d1f08a67994e), W64LIT(0x2a9d118a50a256ed),
+	W64LIT(0x5fc7a4e5cf501908), W64LIT(0xf6764bb0422ba7aa),
+	W64LIT(0xd95d5dd22e7ef00b), W64LIT(0x2be0ffdd7dd02bf2), W64LIT(0xed338c040fcc434f), W64LIT(0xe76aa8fb031055b8),
+	W64LIT(0x003cd7cbe7801e81), W64LIT(0xcb0f56b1ad30538f),
+	W64LIT(0x007384eebc119f86), W64LIT(0xfcf2b3b95973eec4), W64LIT(0x645d8e57bcff8c67), W64LIT(0x954e73c33f3b4862),
+	W64LIT(0xb3adde6094bbc0da), W64LIT(0x0e82327c354a1dd2),
+	W64LIT(0xec91409fe853eb02), W64LIT(0x90813e99569cd51f), W64LIT(0xcdab23cb2500a07d), W64LIT(0x5837151570f4fefb),
+	W64LIT(0x7bccfd5f186ba630), W64LIT(0xe4fa4b5bf74b7a30),
+	W64LIT(0xafd273d4e5fe7eb1), W64LIT(0x14ef9812b5e1f8ad), W64LIT(0x57040fffaedefb29), W64LIT(0x1f34bac6e66fccb2),
+	W64LIT(0x6b438a04d56a8c9d), W64LIT(0xd1dd13abb6b7a0ab),
+	W64LIT(0x01f7ccb8a5d5e741), W64LIT(0x49eb94654480ee59), W64LIT(0xcb79eb8a496d9677), W64LIT(0x4d2a17688bf83396),
+	W64LIT(0x571fe8d9d24efe5c), W64LIT(0x79b2b2e201510c8b),
+	W64LIT(0x75cceacad65951e8), W64LIT(0xb605ce25f217a652), W64LIT(0xfa23a6a6044d277b), W64LIT(0x5647be2010adf17d),
+	W64LIT(0xe372b47b3138eb4b), W64LIT(0xa23698d6ad144159),
+	W64LIT(0xa75db9bb9190f271), W64LIT(0x0855a530577f3372), W64LIT(0xc8eb5a836214e500), W64LIT(0xae387d11be91bfc7),
+	W64LIT(0x14c65290031017c4), W64LIT(0xc9a82e011fe444ce),
+	W64LIT(0xed93627d4f6242f6), W64LIT(0x311c49a898f8168d), W64LIT(0x02c234893a489c2a), W64LIT(0x5b1c07a79086115f),
+	W64LIT(0x1d0726e0888361f1), W64LIT(0x66f950dbce47587d),
+	W64LIT(0xa711b4b5b685f0be), W64LIT(0xe408bfbb99b46772), W64LIT(0x51d93852d76ad612), W64LIT(0x4d73592b5902529b),
+	W64LIT(0x8e0cc7593d1eebbe), W64LIT(0x003ff108b3203be8),
+	W64LIT(0xb94ff57ec81540d4), W64LIT(0x0096ed9ec78aa705), W64LIT(0xfe67ee1f0a9a7291), W64LIT(0xd4052ad848208d33),
+	W64LIT(0x27e37b7318c53e78), W64LIT(0x47c8811744da57cc),
+	W64LIT(0x5bbbd01a6ac25d85), W64LIT(0x78445dcbd47d2b83), W64LIT(0x59f1dba50a621238), W64LIT(0x3979eefe4ef44469),
+	W64LIT(0x832375ba47cf61f4), W64LIT(0x32ca80293eba7035),
+	W64LIT(0x8f3011c542521efa), W64LIT(0x75f7c631195b41dc), W64LIT(0xdd5a294bc65d1967), W64LIT(0x89b00a95e7aded6b),
+	W64LIT(0x41247cb68e979338), W64LIT(0x85a4479fef526881),
+	W64LIT(0x16bfe6339b1e3a0f), W64LIT(0xe38cf2f98771a560), W64LIT(0xd0a6710edea05eb0), W64LIT(0x1070acd78b2b5dd2),
+	W64LIT(0xf836faeaca79a910), W64LIT(0x208ca698c216e528),
+	W64LIT(0xaefea69f3d36263b), W64LIT(0x00ed9abb9fef7208), W64LIT(0x3291757f84bd8434), W64LIT(0x2a8f69989374df94),
+	W64LIT(0x1d2f03cf2e93f34c), W64LIT(0x9c9368184eadad3f),
+	W64LIT(0x916baaff916cde09), W64LIT(0x8317497dd62df5b0), W64LIT(0xf5d41e423a0958b0), W64LIT(0x8d7d6d6a7f1317ea),
+	W64LIT(0x0a41b8aa3d48973d), W64LIT(0x953b874302848605),
+	W64LIT(0xec3fa50130d96b56), W64LIT(0x7cbf458247497265), W64LIT(0xd759a88ae250b41c), W64LIT(0xe40eb4d885a752cb),
+	W64LIT(0x599e5b75ccb7732a), W64LIT(0xa2e41ceb2dd3d73b),
+	W64LIT(0x3c29d7a82247d827), W64LIT(0x038ab2f29cb90c44), W64LIT(0x4ebecc3dd1cdc8b2), W64LIT(0xa5bb57aa04ec0991),
+	W64LIT(0xe5fc6441d0a8808b), W64LIT(0x25fa5fe3c6ed4fc9),
+	W64LIT(0x04e91d870002309e), W64LIT(0x7437b31737cd88fc), W64LIT(0x661889281fe1404c), W64LIT(0x882b40e6418d08bc),
+	W64LIT(0x63cb430144e2fca9), W64LIT(0x9bd758d59961832e),
+	W64LIT(0x5b522ae6fec07279), W64LIT(0x55b0bc645bf675a3), W64LIT(0x88e36d08b8228839), W64LIT(0x192c8fb6be7b3940),
+	W64LIT(0x290eb978cc5ea7ca), W64LIT(0x9870fe7257f14716),
+	W64LIT(0x6e3c3520b9f7f75e), W64LIT(0xf9f6c4ddeb0c25a4), W64LIT(0xc12836744d956605), W64LIT(0x8164788c2ae22bf9),
+	W64LIT(0xf48a2ace281e4f3b), W64LIT(0xe5b0f9a33e952f7a),
+	W64LIT(0x64de88ef0327c326), W64LIT(0xf6c18ce12fbd403f), W64LIT(0x3e6c13c0caf49231), W64LIT(0xc4274920cd5a51f7),
+	W64LIT(0x8deb1878c0a30f18), W64LIT(0x5109da19cbe51ad3),
+	W64LIT(0xaccd18e6f9e44a7d), W64LIT(0x506bd9723c094f69), W64LIT(0x69a85d5a753676d8), W64LIT(0x7cf893ced770e86c),
+	W64LIT(0x8f8355d69af19d4f), W64LIT(0xaf262401d6115849),
+	W64LIT(0xf211e4960492b45f), W64LIT(0x62109cba1d4bbd7c), W64LIT(0x1dd1aeb8e6a82ede), W64LIT(0x17f7e1268b23d16a),
+	W64LIT(0x2301712de0918cd0), W64LIT(0x81d0884e2a49955b),
+	W64LIT(0x7346755a840c8af0), W64LIT(0x35a7548ecc6489b0), W64LIT(0xf03dfd809d87075e), W64LIT(0xcd89f366ff7611d2),
+	W64LIT(0x47a801f9d3a89a98), W64LIT(0xd3f29871f1e91ad2),
+	W64LIT(0x58b6863fe827c40e), W64LIT(0x2ef0f7cfa25931be), W64LIT(0x82b55c514548a172), W64LIT(0x07e42d941a9a4085),
+	W64LIT(0xf1559bf27e5d465e), W64LIT(0xc87f4f6c64a530a2),
+	W64LIT(0x9ebf45df0453fd3a), W64LIT(0x474783daf25bb023), W64LIT(0x4c39d19968112fca), W64LIT(0x19a85797e32f1eee),
+	W64LIT(0x0a2b65f65df937db), W64LIT(0x73be358a985bc776),
+	W64LIT(0x84fa91145b88d309), W64LIT(0x0e31a07e9a909c3e), W64LIT(0xba587dfe95671481), W64LIT(0xf9ef2c02a2ebbf17),
+	W64LIT(0xe8070be288f3992c), W64LIT(0x8c68558d871ea8fb),
+	W64LIT(0x09da59b0d9a0d716), W64LIT(0xe90f22663ba58128), W64LIT(0xe867df85f30671a0), W64LIT(0x4bf10cfbaba22d8c),
+	W64LIT(0x017faf5418406ee8), W64LIT(0x4cbf6414b97c0053),
+	W64LIT(0x516090d9b0228bd2), W64LIT(0x2599843f80745095), W64LIT(0x2fe0520728a501be), W64LIT(0xbffe106afea4fa16),
+	W64LIT(0xf83a3767e03baebb), W64LIT(0x71b00e3d8ec66837),
+	W64LIT(0xa23d20040054a768), W64LIT(0x104a688623f97826), W64LIT(0x13694b8ac1561135), W64LIT(0xe0e7dc3a2f01b7c1),
+	W64LIT(0x582b7184116499b9), W64LIT(0x6b086a6080255e88),
+	W64LIT(0xb9e0dda215d9a68c), W64LIT(0x4839ad31deb8c576), W64LIT(0xbddaeecc9d185376), W64LIT(0x7119da93d8b801e2),
+	W64LIT(0x9fcc3f18ef1b0a0f), W64LIT(0x521397753a067812),
+	W64LIT(0x3c4ac5636b06fe02), W64LIT(0x832f561f782655b8), W64LIT(0x71f4864a5744debe), W64LIT(0x80e0063495385c6c),
+	W64LIT(0x6cd832ea90ae9ac7), W64LIT(0x23929957d8b646cc),
+	W64LIT(0x1da618e668d09ae3), W64LIT(0x9ed7286d23ba1432), W64LIT(0xf5dc0706093ae0d4), W64LIT(0x848c2a25b82b9915),
+	W64LIT(0xb67a3270bc0af655), W64LIT(0x008ac947f779f9b9),
+	W64LIT(0x84a448e5bf8052cb), W64LIT(0x671cfe52fb545ca3), W64LIT(0x176be2b06d0f4a3f), W64LIT(0x367276f8aa1a14f0),
+	W64LIT(0x06dab6ba72746a49), W64LIT(0x736e95ba7beb750f),
+	W64LIT(0xdca02e27376f9253), W64LIT(0x4431df21bdc5c9b3), W64LIT(0x59b87f94aef869e8), W64LIT(0x7669cc796f5305c5),
+	W64LIT(0xbe4cf2435ba08184), W64LIT(0x38c9e98ad0ca154b),
+	W64LIT(0xf3cd04f9db2a40fe), W64LIT(0xe80e3d3e8ed9c7ce), W64LIT(0xe8bb9e6092565e14), W64LIT(0xd4dad2268ea0844d),
+	W64LIT(0x5def6b9a52335439), W64LIT(0x7fbb8aaa29b2f547),
+	W64LIT(0x4f4cc3f6e0ede7a5), W64LIT(0xa38dc654b5b2ab9b), W64LIT(0xbc983c0fd973164c), W64LIT(0xad61c59d3a5cacd7),
+	W64LIT(0x67bfe0d4896b02b1), W64LIT(0x7b70d99d1434a056),
+	W64LIT(0xc15e5f90f9121816), W64LIT(0x91647a0e9451a07e), W64LIT(0x9d9e138db01b25b3), W64LIT(0x27420bbad162b2a3),
+	W64LIT(0x549f4b552e9de246), W64LIT(0x1d9bfef25269b907),
+	W64LIT(0xe847913b43627a4b), W64LIT(0x9c8cefb09ed8efdb), W64LIT(0x95ef10144cd54907), W64LIT(0x6b338c06ad9b976f),
+	W64LIT(0x283dd3d24e811355), W64LIT(0x1512d1965daec1e7),
+	W64LIT(0x15ff9a9bb568cd4e), W64LIT(0x9e8b6bf650bc5d74), W64LIT(0x7d949f8d605ec41d), W64LIT(0x22f899c03c3c5d6f),
+	W64LIT(0x539d03708bb63bed), W64LIT(0xb390263c456365ae),
+	W64LIT(0xccd200ce482bd4c3), W64LIT(0x0411843a1400317e), W64LIT(0x9bd2c04c9e9c7488), W64LIT(0xcd69685b9bc33c82),
+	W64LIT(0x805eb5c450669a51), W64LIT(0x582198d23710888b),
+	W64LIT(0x4afdc53e27d47126), W64LIT(0xc694272913906e2a), W64LIT(0xf6e6ba1d3f12cf21), W64LIT(0x8ff5035eb05e0c41),
+	W64LIT(0x6563cc716f7d675f), W64LIT(0x628f7897bb9e1e52),
+	W64LIT(0xff3b41412d6cb72e), W64LIT(0x0c5888ec14348bad), W64LIT(0xa880aeb1667b3292), W64LIT(0x6812235773d276f6),
+	W64LIT(0xa7851f8e553b106a), W64LIT(0x2d942a34115c8678),
+	W64LIT(0xb2e776310cbfc247), W64LIT(0xed26c0a007ac9315), W64LIT(0xc33e2121a8254ada), W64LIT(0xa8c05c2e29ded690),
+	W64LIT(0x9d65d4608e70e87e), W64LIT(0x616104d52b20930e),
+	W64LIT(0xf7689f7905c44088), W64LIT(0xfff1f5fc5c8786a6), W64LIT(0x81261f40a2db534c), W64LIT(0x8193cd894e8fddc0),
+	W64LIT(0x3a837b7ac32efcfd), W64LIT(0x08413cc0c6d78382),
+	W64LIT(0x87d55b0da54db0b3), W64LIT(0xd45394d21aa70e57), W64LIT(0x4b6911960fcc7b4a), W64LIT(0xa0cccdb0a1463950),
+	W64LIT(0xde09ed86fa1f6460), W64LIT(0x6deaef7e19a1ad61),
+	W64LIT(0xf307d2d4ff99a1c6), W64LIT(0x3a21df7a0cf3e615), W64LIT(0xbe3155bc598d8195), W64LIT(0xfd502a562836aaa7),
+	W64LIT(0x78228bff4ce3594d), W64LIT(0x8075a873d7c4c90f),
+	W64LIT(0x899901f17266f660), W64LIT(0x4d852ad4700a8e79), W64LIT(0x71fd15df3b8813d6), W64LIT(0x3cb9a2c931fed428),
+	W64LIT(0x70bffe4e3d608efe), W64LIT(0xc9eb99745f63c3b4),
+	W64LIT(0xe1b8bfdc5f1243aa), W64LIT(0x10fde5c72c3b8d21), W64LIT(0x14546eed6a373961), W64LIT(0x82d8995db243a6c3),
+	W64LIT(0x36df6f5adc847458), W64LIT(0x43e00f489f27904a),
+	W64LIT(0xcf16dd4ebfa6457a), W64LIT(0xe44ea7b1582630c1), W64LIT(0x02b6dba75d1e086b), W64LIT(0x8517f7da0258cdfd),
+	W64LIT(0x7f43d1f3ec554bbc), W64LIT(0x196037a64b4831f3),
+	W64LIT(0x6d2d8202a4b3e1a5), W64LIT(0x29b289df47c32ba5), W64LIT(0xe59228d85f470026), W64LIT(0xafccc28ecfc3b339),
+	W64LIT(0xe0bb8c73e2644cbc), W64LIT(0x467f8672d03f8419),
+	W64LIT(0x0310c519bfedd719), W64LIT(0xfcc5dab1fdf85239), W64LIT(0xdd128784c51b2d9f), W64LIT(0x755ecf70008c6750),
+	W64LIT(0x10f9bf55bdb0d624), W64LIT(0xeacf03ee2a31994d),
+	W64LIT(0x992fafd72469acf4), W64LIT(0x59e436802a74d135), W64LIT(0xb4eae8520b6d2bd2), W64LIT(0xc9dd754a3ea7f56f),
+	W64LIT(0x5cbef11eb4942b58), W64LIT(0xe35712b60aa68717),
+	W64LIT(0x1c4698473851752a), W64LIT(0x9fecdf734be4f955), W64LIT(0x96d9fe1a9b881e18), W64LIT(0xa35b6d1bfc053403),
+	W64LIT(0xd3cd59bf6b50345e), W64LIT(0x4847b682de67bc91),
+	W64LIT(0xadd5b34d3f222e39), W64LIT(0x6a0c403de3cf9a9a), W64LIT(0xb134c23b799b54fe), W64LIT(0xec78ebce932048b6),
+	W64LIT(0xfa0606cb95c82097), W64LIT(0x2dbc23fedfc08c5f),
+	W64LIT(0xf5228178ea455623), W64LIT(0x6db96158fac24b9b), W64LIT(0x27807fa875f69897), W64LIT(0x878429eb7af68704),
+	W64LIT(0x910ea7a90c9a498a), W64LIT(0x041c946912dc40c9),
+	W64LIT(0x8181fa5530753939), W64LIT(0x4dc81d3009d39cde), W64LIT(0x0eeace8cb649cf26), W64LIT(0x48194779e9ef0470),
+	W64LIT(0x1867552ab71c7f06), W64LIT(0x2f32b5d9f66fe3cb),
+	W64LIT(0xee53963a6774df01), W64LIT(0xb68f4f5096fd0a41), W64LIT(0x55ed90adfcb32f0b), W64LIT(0x4a5330eea3fb2397),
+	W64LIT(0xcd49e0a1f0d14656), W64LIT(0x32a75b669eb10e79),
+	W64LIT(0x1afbabc8c1190a53), W64LIT(0x2249bc0212020c8b), W64LIT(0xf6dd7183b0cf0696), W64LIT(0x6ea684b2a11c3c04),
+	W64LIT(0x1c5ddff470825a01), W64LIT(0x63543c29574eea22),
+	W64LIT(0x476d7d051beb75ff), W64LIT(0x173ef5821e02fb30), W64LIT(0x17ef19dab61a3050), W64LIT(0x3e7522a22d4fc9f6),
+	W64LIT(0xc3b52ad512e3d98b), W64LIT(0x3ebe4d9b1544b4ab),
+	W64LIT(0xf5dd0339790b018f), W64LIT(0x19e8ac6b51041a55), W64LIT(0x7469aefec3d13900), W64LIT(0x09bf87d9966e5f49),
+	W64LIT(0xfdf0795924f3448a), W64LIT(0xa3e056562a60dcae),
+	W64LIT(0xf0b5907f80adb0f5), W64LIT(0x8fef9c8bd5085724), W64LIT(0xed681654f65b7e8b), W64LIT(0x8f614423e30343df),
+	W64LIT(0x6b80131099760764), W64LIT(0x535046faa3bb7eee),
+	W64LIT(0xc82697bfbaf9435c), W64LIT(0x1d400384aeb6211f), W64LIT(0x952e6b8ea69d4056), W64LIT(0x0ca505c4e936ee94),
+	W64LIT(0x2b3dc775158945f4), W64LIT(0x813120e2eb3693d9),
+	W64LIT(0xf95c189d187032bd), W64LIT(0x9c03626ba630b6ef), W64LIT(0x14703dd349355fc7), W64LIT(0xfb0e8dc8f6444376),
+	W64LIT(0xc758ead87763d5cf), W64LIT(0x17599a0a4b533ea7),
+	W64LIT(0x9403d41dc1ab66b3), W64LIT(0x82172fc5feebdd6a), W64LIT(0xbcaf439097280231), W64LIT(0x66cb3950d61cfb43),
+	W64LIT(0xdfbb42669429ae5f), W64LIT(0xa7d590690f9bf0d1),
+	W64LIT(0x62f3c5ae60cc5503), W64LIT(0x1d0a3a3f0c01aa81), W64LIT(0xb2c6c399baee4f89), W64LIT(0xe0a9738791ebb314),
+	W64LIT(0xed0ffce73b238131), W64LIT(0x21c8ec67811f1788),
+	W64LIT(0xe1284fb6b1a51b4b), W64LIT(0xfc6878b4409bb395), W64LIT(0x0db4fa18bc25774d), W64LIT(0x43384ec99b198f70),
+	W64LIT(0xbafb4214f2de6018), W64LIT(0xd2a0fb9fb36aa1f3),
+	W64LIT(0x0a547bc0a59289b2), W64LIT(0x00eff5fa39b684b0), W64LIT(0xa216c243c6509fd8), W64LIT(0x270586bc8f8be90c),
+	W64LIT(0xb0a62c5989e36317), W64LIT(0xef24b84719ae20a8),
+	W64LIT(0x7e6ab56157b6c5da), W64LIT(0x4b8ce923fc79b4cb), W64LIT(0xf2e95031a9f95d7d), W64LIT(0x7929f74aba5adfed),
+	W64LIT(0xa9e1825cc5e90c7f), W64LIT(0xda5cc30aa4d866bf),
+	W64LIT(0x58a37685cab67493), W64LIT(0x0b1bbd26f32cdf32), W64LIT(0x3e3896c20e89b286), W64LIT(0xb77997e28674ee59),
+	W64LIT(0x12f5136aec4dc09c), W64LIT(0x2f6c8af61e839aa4),
+	W64LIT(0xb8aa61f12f0d0d89), W64LIT(0xf78640d55cbab8bc), W64LIT(0xaad91ee1a2ee632c), W64LIT(0xd09c639719905c9d),
+	W64LIT(0x513f02f0a2c3aa5e), W64LIT(0x6b4c6a7d1adc76e3),
+	W64LIT(0xde3cfa4370d9bc82), W64LIT(0x46329acd387b717f), W64LIT(0xa0c1bfcca2a38171), W64LIT(0x487f69a9cf6679a3),
+	W64LIT(0xbc25c85f1c722671), W64LIT(0x9a6ad47437fff88a),
+	W64LIT(0x377d912afa8a837a), W64LIT(0x220c3912b167d72e), W64LIT(0xdf0591ed6f266dd2), W64LIT(0x55c60e0900fc9861),
+	W64LIT(0xfe27ae1a99abd464), W64LIT(0xf143f504e7cabd97),
+	W64LIT(0x6e578b6f28b8d7b6), W64LIT(0x88cc38ddacf1a724), W64LIT(0xc819ca78061c3219), W64LIT(0x6c744c37058f6b3b),
+	W64LIT(0x93443fcd13a36d95), W64LIT(0x2bb7bd35115df054),
+	W64LIT(0xfca9a4b8a7e5f70f), W64LIT(0x677decdb7d2271db), W64LIT(0x30b99ab4543346c7), W64LIT(0x1d51faf06227b675),
+	W64LIT(0x9ccdc0437db2c760), W64LIT(0xf958f71d915db325),
+};
+
+static const word64 s_secp521r1Curve[] = {
+	W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0x00000000000001ff),
+	W64LIT(0xfffffffffffffffc), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0x00000000000001ff),
+	W64LIT(0xef451fd46b503f00), W64LIT(0x3573df883d2c34f1), W64LIT(0x1652c0bd3bb1bf07), W64LIT(0x56193951ec7e937b),
+	W64LIT(0xb8b489918ef109e1), W64LIT(0xa2da725b99b315f3), W64LIT(0x929a21a0b68540ee), W64LIT(0x953eb9618e1c9a1f),
+	W64LIT(0x0000000000000051),
+	W64LIT(0xf97e7e31c2e5bd66), W64LIT(0x3348b3c1856a429b), W64LIT(0xfe1dc127a2ffa8de), W64LIT(0xa14b5e77efe75928),
+	W64LIT(0xf828af606b4d3dba), W64LIT(0x9c648139053fb521), W64LIT(0x9e3ecb662395b442), W64LIT(0x858e06b70404e9cd),
+	W64LIT(0x00000000000000c6),
+	W64LIT(0x88be94769fd16650), W64LIT(0x353c7086a272c240), W64LIT(0xc550b9013fad0761), W64LIT(0x97ee72995ef42640),
+	W64LIT(0x17afbd17273e662c), W64LIT(0x98f54449579b4468), W64LIT(0x5c8a5fb42c7d1bd9), W64LIT(0x39296a789a3bc004),
+	W64LIT(0x0000000000000118),
+	W64LIT(0xbb6fb71e91386409), W64LIT(0x3bb5c9b8899c47ae), W64LIT(0x7fcc0148f709a5d0), W64LIT(0x51868783bf2f966b),
+	W64LIT(0xfffffffffffffffa), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff),
+	W64LIT(0x00000000000001ff),
+};
+
+static const word64 s_secp521r1Points[] = {
+	W64LIT(0xf97e7e31c2e5bd66), W64LIT(0x3348b3c1856a429b), W64LIT(0xfe1dc127a2ffa8de), W64LIT(0xa14b5e77efe75928),
+	W64LIT(0xf828af606b4d3dba), W64LIT(0x9c648139053fb521), W64LIT(0x9e3ecb662395b442), W64LIT(0x858e06b70404e9cd),
+	W64LIT(0x00000000000000c6),
+	W64LIT(0x88be94769fd16650), W64LIT(0x353c7086a272c240), W64LIT(0xc550b9013fad0761), W64LIT(0x97ee72995ef42640),
+	W64LIT(0x17afbd17273e662c), W64LIT(0x98f54449579b4468), W64LIT(0x5c8a5fb42c7d1bd9), W64LIT(0x39296a789a3bc004),
+	W64LIT(0x0000000000000118),
+	W64LIT(0xb19a5828676a875a), W64LIT(0x40729f28c83a4911), W64LIT(0x511949b1c6dce05b), W64LIT(0x25914c8c3fcf0490),
+	W64LIT(0xc49490de0c6c2742), W64LIT(0x3b21feefdf6cd770), W64LIT(0x012d2802dd1a82a2), W64LIT(0x72f5a0b76453439d),
+	W64LIT(0x0000000000000020),
+	W64LIT(0x3e85d07d9b58e26d), W64LIT(0x56527bdd1c50af24), W64LIT(0x564b56587df377d0), W64LIT(0xf5b0335865e97a30),
+	W64LIT(0x2b22d6e96b31bc52), W64LIT(0x8ad449abcccd4bba), W64LIT(0x84b8b888f7c162a2), W64LIT(0x3b647f0e4d56f29b),
+	W64LIT(0x00000000000001fb),
+	W64LIT(0x1d4408efb6e356fb), W64LIT(0x9aea805f0d5c2895), W64LIT(0x565817b5be66ecbf), W64LIT(0x44aff73830f7bd94),
+	W64LIT(0x943f248931292f65), W64LIT(0xde4b6ee4fc8a1f91), W64LIT(0xa1c62b7cac30cd57), W64LIT(0x54c5bb5305f3077a),
+	W64LIT(0x0000000000000084),
+	W64LIT(0x5b86d6971a862cfb), W64LIT(0x47e1a85e21a49e56), W64LIT(0x45b5e3474333f2ab), W64LIT(0xac20df05c309733b),
+	W64LIT(0xf10776f689fa0f99), W64LIT(0xc1e74976b3b4ccc8), W64LIT(0x4589bb6ef294b300), W64LIT(0xc41b930b95b3874c),
+	W64LIT(0x0000000000000055),
+	W64LIT(0xc06a64ce981fd289), W64LIT(0xb8dc2603d11fcd02), W64LIT(0xea27a922770d2eb2), W64LIT(0x83c64076da8f19ed),
+	W64LIT(0x9f6d1b650ae6a311), W64LIT(0x977277bf73fa8721), W64LIT(0x7115ef98cc0292d8), W64LIT(0x93237ae7d2e0c67e),
+	W64LIT(0x0000000000000069),
+	W64LIT(0x83481b595c151734), W64LIT(0xba00bd740ac1576e), W64LIT(0x48f33272f178d4f2), W64LIT(0xe09fde3816492d95),
+	W64LIT(0x876124dbb9dfce3f), W64LIT(0x27e7b1e503fe728f), W64LIT(0x79347e4604f98f99), W64LIT(0x63ec8c5d48dcf0ee),
+	W64LIT(0x0000000000000149),
+	W64LIT(0x0303cc01d4ce0cda), W64LIT(0x5849826efe08eeab), W64LIT(0x14922a1713537534), W64LIT(0x796f40fdd57d6a82),
+	W64LIT(0x5806899969bd564e), W64LIT(0x23fed1c8cdb0f1df), W64LIT(0x0a30ff0f65bca377), W64LIT(0x190c614b71607321),
+	W64LIT(0x0000000000000113),
+	W64LIT(0x6149128c6e6a83a7), W64LIT(0xcdd2ef65dcc2e0cd), W64LIT(0x115c42b468610121), W64LIT(0xb3fdad5d7dfb78c3),
+	W64LIT(0x2e16ce2521edf0bf), W64LIT(0x5155fcf792ae1e95), W64LIT(0xf10f0ccfdff79345), W64LIT(0x90d5832eb7f8417f),
+	W64LIT(0x00000000000000e4),
+	W64LIT(0x8d7317e8b75da2bb), W64LIT(0x6c60038e81e5d5c9), W64LIT(0x4ab058f0b9d48a0b), W64LIT(0xe90e156e4eca1cd0),
+	W64LIT(0x6d5b904e81cd0da4), W64LIT(0xd8344731faaccc3f), W64LIT(0xe96ba7f2fc24f6f3), W64LIT(0x3ad51d5fd161444a),
+	W64LIT(0x00000000000001f8),
+	W64LIT(0x51279d66be4ca896), W64LIT(0x2e49d501eb5b6253), W64LIT(0x7daced30c99b28dc), W64LIT(0x2f4d3ef6ef94c84e),
+	W64LIT(0x52dc6b5daa4ca282), W64LIT(0x8dca17d737e37253), W64LIT(0x709a47fe07f6d080), W64LIT(0xd0a4d635e4a778ff),
+	W64LIT(0x0000000000000052),
+	W64LIT(0xb1298e289f4dd83c), W64LIT(0x8dcca8caae8a75ad), W64LIT(0x928c6d0919a13385), W64LIT(0x79398480a8ba7682),
+	W64LIT(0x3e9ccb113fe6cc5b), W64LIT(0x62ac771c5885a242), W64LIT(0x6514bb33c36adc65), W64LIT(0x3234d613fecd22dd),
+	W64LIT(0x0000000000000139),
+	W64LIT(0xc89111bc5bee8ca8), W64LIT(0x90bbbe91bcb89121), W64LIT(0xa3c165e9f59fedfd), W64LIT(0xf3fd593f07228f90),
+	W64LIT(0x2022a3ab238bb703), W64LIT(0xa97dcd78ebc45a00), W64LIT(0x325270d091ce860a), W64LIT(0x2cb1ab2bd3f141b6),
+	W64LIT(0x0000000000000012),
+	W64LIT(0x08136cbf025189d4), W64LIT(0xa1c389cbc1b25a05), W64LIT(0xbecdade76e9ed11d), W64LIT(0x6557006ba7f3f38a),
+	W64LIT(0x96d6c877bc852dbd), W64LIT(0x3a0afe4bc53efd4f), W64LIT(0xc7f58410febe4737), W64LIT(0x86deba3b84e35e2f),
+	W64LIT(0x000000000000015b),
+	W64LIT(0x96256db24dfa7da8), W64LIT(0x379735573dccf202), W64LIT(0x2e0b263e8fcc1274), W64LIT(0x14870fe89ee7b82e),
+	W64LIT(0xcb8f9ba5425ca276), W64LIT(0x683c748e7d876e79), W64LIT(0x48e990d5de2f2cfe), W64LIT(0x2ecc8f1f48547013),
+	W64LIT(0x000000000000018f),
+	W64LIT(0x68ab5d2f09975a81), W64LIT(0x7acd8fa6fdc6c774), W64LIT(0x1fb3cf53727a6887), W64LIT(0x82b8cdb20ee80fd2),
+	W64LIT(0x6945e6a52878d127), W64LIT(0xe93b98f1e4c494c6), W64LIT(0xa3af831938f656f9), W64LIT(0x4a3877ef6fc6a007),
+	W64LIT(0x00000000000001b2),
+	W64LIT(0xd95bf20973a5c071), W64LIT(0x4fa40d5a46b53ee5), W64LIT(0x9bf0674eed28ce97), W64LIT(0x51423d1fa0b52fcc),
+	W64LIT(0x5711b965092ccaeb), W64LIT(0x045fcaf04ad60d22), W64LIT(0x9db711fb1359c654), W64LIT(0x60afa70c53431c72),
+	W64LIT(0x0000000000000166),
+	W64LIT(0x9dea3d3bdfae82d4), W64LIT(0xdc0adcf10fd1a066), W64LIT(0x8b34b6ec45eb29ed), W64LIT(0x69be805704b908df),
+	W64LIT(0xef0410a9c233831d), W64LIT(0xd0e723587bb36226), W64LIT(0x657b474bf1138358), W64LIT(0xbe0f6ef556c43421),
+	W64LIT(0x00000000000000f0),
+	W64LIT(0x1dc4541ae47364d0), W64LIT(0xe9dc26020d39b3fc), W64LIT(0x39536f54bf7949b7), W64LIT(0xe6d725ea7a5644d2),
+	W64LIT(0xdf0944858c34de16), W64LIT(0x071f11fdf0f1a37d), W64LIT(0x8f85606506f63f0a), W64LIT(0x9a3a964f5a6a909f),
+	W64LIT(0x00000000000000b9),
+	W64LIT(0xd627b9f43cb45628), W64LIT(0xe9f1b5eeac1f9f0e), W64LIT(0x629131db9cfb62a2), W64LIT(0x244592ea6574a7a5),
+	W64LIT(0xa924b9db3df1c026), W64LIT(0x0a27b7c7633908ee), W64LIT(0xc5f09d5d9acb84da), W64LIT(0xa84943321ad1203d),
+	W64LIT(0x00000000000000fc),
+	W64LIT(0x026570b2dbdac4f9), W64LIT(0x48bfd01aed0cf0ff), W64LIT(0x474dc48fafaf45f4), W64LIT(0xc3d6ca58f5e8aab4),
+	W64LIT(0xa598c2e762c85ad6), W64LIT(0xac1e490d28191619), W64LIT(0xe20f4b81659eaf2e), W64LIT(0x96ae1d8922dc1ca4),
+	W64LIT(0x000000000000011b),
+	W64LIT(0x11d3a594be7612da), W64LIT(0xdb97aac221d03ac5), W64LIT(0x373f8b6a119e3147), W64LIT(0x46ee765419f44b22),
+	W64LIT(0x10f109e17a53c9c0), W64LIT(0x2618bd7cdfd41834), W64LIT(0x31171a784f3d7aa0), W64LIT(0xcd9414594fe91a42),
+	W64LIT(0x00000000000000fe),
+	W64LIT(0xbfbb1708e23032f4), W64LIT(0x06a1407f7ecec755), W64LIT(0xe0c12bffa874918d), W64LIT(0x19c1e39bc2e0ec7d),
+	W64LIT(0x7cae2449bbe984e2), W64LIT(0x3b8a71d0c490b98a), W64LIT(0xd211f45dffef9087), W64LIT(0xfc02686dcd14a7d4),
+	W64LIT(0x00000000000000df),
+	W64LIT(0x80734a3bd47abb75), W64LIT(0xc21e3d3e5ab91f07), W64LIT(0xd3660482783c9fee), W64LIT(0x949d308e82a39ac0),
+	W64LIT(0x5f4977b1502ed56b), W64LIT(0x211060cb553805e2), W64LIT(0x03eca72956caee87), W64LIT(0x46da029c22c42ba1),
+	W64LIT(0x00000000000000c8),
+	W64LIT(0x7a3f46d48744620d), W64LIT(0x1b73e1de3574b2c7), W64LIT(0xe06ad93a9691af64), W64LIT(0xdc8fa8e75a5f90ff),
+	W64LIT(0xac428a45eeb4aad3), W64LIT(0xaf4c00ec8f7d1ff6), W64LIT(0xb6a8b17cf478865d), W64LIT(0x3e5472839544b3f5),
+	W64LIT(0x00000000000000d8),
+	W64LIT(0x6869b4211b05c1c6), W64LIT(0xa3da997f20bc3d8d), W64LIT(0xeb55c4ac4c428d31), W64LIT(0x2c4aa046a282d41d),
+	W64LIT(0x0dbe4dfe11734193), W64LIT(0x9c2a442f2877c679), W64LIT(0x5aeb1c5ca8d385ba), W64LIT(0x791f0a8346401506),
+	W64LIT(0x0000000000000059),
+	W64LIT(0xddda462d2ea95d99), W64LIT(0x0e9356f2c6c28d8a), W64LIT(0x5c813667344aaf3d), W64LIT(0x6b019d7a0cce0663),
+	W64LIT(0x3c9a515f97c75f5f), W64LIT(0xdc716567442fdf22), W64LIT(0x484b43d58ca4fd28), W64LIT(0x473e74deab1ae5de),
+	W64LIT(0x00000000000000fc),
+	W64LIT(0xc10e8166e96fda3c), W64LIT(0x18ab768a87f01026), W64LIT(0x3b7501ec020be528), W64LIT(0x9e692ee50c8bf560),
+	W64LIT(0xb0e174dad2b13913), W64LIT(0x125f4770a7e4fe44), W64LIT(0x65d4fb94156bd54a), W64LIT(0x05c4572cde32fcb6),
+	W64LIT(0x0000000000000059),
+	W64LIT(0xd802dc81cebdb96f), W64LIT(0x3bd101b6e59af03f), W64LIT(0x1fb44353448ce3ab), W64LIT(0xdcdbf870c1151534),
+	W64LIT(0x1a25e9e5c6067e1a), W64LIT(0x6253b0c1fd269820), W64LIT(0x466e3fa4d9674a9d), W64LIT(0xfd45488cf5fb34cd),
+	W64LIT(0x000000000000004e),
+	W64LIT(0x2bad7686d90119ae), W64LIT(0x8dcd64f0464b230c), W64LIT(0x1d1eeb94dad19cb1), W64LIT(0x3b47038986f0eb48),
+	W64LIT(0x42abb37d2c50f380), W64LIT(0xfabbcebba7a99eb1), W64LIT(0xfeed69dd33fb0b08), W64LIT(0x8de8b50e31dc2b1e),
+	W64LIT(0x0000000000000057),
+	W64LIT(0xe10dc8a6054ed7a9), W64LIT(0x7094fc36cf39bec8), W64LIT(0x487789a825848527), W64LIT(0x8786eaa339974124),
+	W64LIT(0x47a0d6b0a6e3e5ab), W64LIT(0x54ed0b21e981e517), W64LIT(0x85cf17eae768123b), W64LIT(0xd9a933b0636e78c6),
+	W64LIT(0x0000000000000127),
+	W64LIT(0x8ef4c70cc23fcffd), W64LIT(0xa9e62fcc3899a59d), W64LIT(0xc9ec0c89a3ef76f1), W64LIT(0xec00c92fe4cf1d94),
+	W64LIT(0xdc2bd72e7d29627b), W64LIT(0xa88d1299eda482b0), W64LIT(0x346b2d4fe8316190), W64LIT(0x67562e28a0152c3b),
+	W64LIT(0x000000000000016c),
+	W64LIT(0xe5de0a39e5e86e00), W64LIT(0x631618ac07da7fa7), W64LIT(0x13bc8a0b87bbe30c), W64LIT(0x47d1ee9930a1c608),
+	W64LIT(0xfc93eb66f4b79cb6), W64LIT(0x70508abae14850bb), W64LIT(0xe448adbf586feba7), W64LIT(0xaf24da8c2542fdae),
+	W64LIT(0x000000000000014f),
+	W64LIT(0xe5c5e029be877cd2), W64LIT(0xe77479d365590edf), W64LIT(0xaa8587bc6fc6d808), W64LIT(0x303d9132b045a2d7),
+	W64LIT(0xfff1f630d5439ec6), W64LIT(0xddf0755cc63b995a), W64LIT(0x900de4aae34c9e95), W64LIT(0x254ae66dd379caf7),
+	W64LIT(0x00000000000000ff),
+	W64LIT(0xd5ec1551513365d7), W64LIT(0x464cf52fe50e1450), W64LIT(0x6efc6305f50abb24), W64LIT(0x3716765aa771d829),
+	W64LIT(0xb6a108e4744c0da2), W64LIT(0x54fe187633385f57), W64LIT(0xb5dc04926719d3d4), W64LIT(0xc9d6f7cb6d801493),
+	W64LIT(0x0000000000000089),
+	W64LIT(0x4c6969a4c854df32), W64LIT(0xe75251f0c07dfb7f), W64LIT(0x2df8b07240cfeb8f), W64LIT(0xdd269ede51d368f8),
+	W64LIT(0xd2b3d6e0f80966eb), W64LIT(0xaff15bf0b2977873), W64LIT(0x480145b77c5cfcd4), W64LIT(0xc5fb61b19b7de3df),
+	W64LIT(0x0000000000000096),
+	W64LIT(0x40cbf8f5e02177f7), W64LIT(0x2784a544e4f2fc38), W64LIT(0x5a78c444aa301ddd), W64LIT(0xb9269fb064f02b47),
+	W64LIT(0xec5369e0defa615c), W64LIT(0x90717a688917bafc), W64LIT(0x59c12f4b991b5419), W64LIT(0xe97bd18bd39f7fe7),
+	W64LIT(0x000000000000019c),
+	W64LIT(0xabd57c3130be3f3b), W64LIT(0x5ed5b904c7a686f1), W64LIT(0x21bc5cd097cf15ce), W64LIT(0x0ed876958c53a622),
+	W64LIT(0xd79c35fea35fb716), W64LIT(0xb292fe5b564d593a), W64LIT(0x7be449e64aefe764), W64LIT(0xf84632f860b8875e),
+	W64LIT(0x00000000000000c7),
+	W64LIT(0x622ca196ab4906b1), W64LIT(0xf2029f622bc36aee), W64LIT(0xdb03419724700ebc), W64LIT(0x9c0e21b279e26342),
+	W64LIT(0x358b7c2648fc9631), W64LIT(0xec5bca80fdf1c7ee), W64LIT(0x89054a3461825005), W64LIT(0xb83d2636eb98ddce),
+	W64LIT(0x00000000000001a1),
+	W64LIT(0xf1475bb2a392f9ff), W64LIT(0xc980a16efbe2a6c7), W64LIT(0x6b5b9248f336f468), W64LIT(0xf82c2b709fd728cb),
+	W64LIT(0x56a8b061774efa63), W64LIT(0x211390c48dfd5d7f), W64LIT(0x2d2b92d9e7d765f1), W64LIT(0x6b914b6686ee944c),
+	W64LIT(0x00000000000001ce),
+	W64LIT(0x978e095bd45a9c99), W64LIT(0x0ef208c73c2456f3), W64LIT(0x8c7d684fc9bc30b8), W64LIT(0x064e48aaa389f964),
+	W64LIT(0xfeb897b335a4fdd6), W64LIT(0x85a39aa24f62300c), W64LIT(0x031586b090f667fe), W64LIT(0x7d72f2eda2cc0d21),
+	W64LIT(0x00000000000000e2),
+	W64LIT(0x32bd281f94e68e44), W64LIT(0x3c2f16e2cad0f9cf), W64LIT(0x0e55718f8e5d4dd6), W64LIT(0xcc8d3c6152d0bc7f),
+	W64LIT(0x6f2432d75c74d01f), W64LIT(0x6f7dac36cfc7aa33), W64LIT(0x2b4bb15b778e28b6), W64LIT(0x77c495dbe8810a5b),
+	W64LIT(0x00000000000000c5),
+	W64LIT(0x97c0910434cc823a), W64LIT(0x61f6a415e5282cbd), W64LIT(0x81a07bd0c71cfdeb), W64LIT(0x0ba55de31782ba89),
+	W64LIT(0x9d8ae8ac418f9bf6), W64LIT(0x8409863b4fbbd3af), W64LIT(0xe0359ae2a90a4965), W64LIT(0xf97dd5610dc7ac38),
+	W64LIT(0x0000000000000104),
+	W64LIT(0x47993c13f2bde76e), W64LIT(0x8decdd349b912773), W64LIT(0xe18ab92dd620fb42), W64LIT(0x41231e1e3b33549a),
+	W64LIT(0xdb85e93e02d4e920), W64LIT(0x774ef64f61f7fd3f), W64LIT(0xd4042d07d8c4ba30), W64LIT(0x147636979be01143),
+	W64LIT(0x000000000000008c),
+	W64LIT(0x79b773197d33966d), W64LIT(0x5dd97b38d0b1997b), W64LIT(0xb0fe2af1769e6717), W64LIT(0x41ce31857ec2b1a4),
+	W64LIT(0x3871cf206877a862), W64LIT(0x157442eabec05fac), W64LIT(0xde2df55185cae2f3), W64LIT(0x660358cda5f50a14),
+	W64LIT(0x00000000000001e8),
+	W64LIT(0x3fde9e779a57e567), W64LIT(0x352bb63b837d331f), W64LIT(0xee538013ce9486ee), W64LIT(0x054828243309889d),
+	W64LIT(0xcf7cb5341b756257), W64LIT(0x496c80042b0f0d14), W64LIT(0xe77edce958f0b91a), W64LIT(0xf8e1030b89f40e18),
+	W64LIT(0x0000000000000137),
+	W64LIT(0x18897d9006277670), W64LIT(0x5eee691995c2d3bb), W64LIT(0x65a2a1023b277280), W64LIT(0x8ed935bcb9573aa5),
+	W64LIT(0xec432f5b741251bb), W64LIT(0xb5e230ae04671b3b), W64LIT(0x5f6f64c05677b48a), W64LIT(0xbabc8d5bc1578502),
+	W64LIT(0x0000000000000151),
+	W64LIT(0x5cf81f08c33c7825), W64LIT(0x02324fb39c1e606c), W64LIT(0xc33263f10cffd944), W64LIT(0x49a739641d6bb8d1),
+	W64LIT(0xcc9668100e79b392), W64LIT(0xc377ceadb30ba3fe), W64LIT(0x99f86c2f4ae60ce0), W64LIT(0x9fcefefed01fabb1),
+	W64LIT(0x0000000000000001),
+	W64LIT(0x0e987f2525abe43f), W64LIT(0xbcee7baaba92a56e), W64LIT(0x02c82eca0c25fbaf), W64LIT(0x24b323b182d1b503),
+	W64LIT(0xe638dd8bb1c861a2), W64LIT(0xf3ca33abf02390dd), W64LIT(0x00938302fca18ddc), W64LIT(0x3efa354abc1166d6),
+	W64LIT(0x0000000000000037),
+	W64LIT(0x5589d86990eaf1ed), W64LIT(0xb84a16dd4c7659f6), W64LIT(0x7b88945a791e5115), W64LIT(0xafb365e2bb651ea8),
+	W64LIT(0xe18f02dffbf54b1f), W64LIT(0x199f7e7d911190c6), W64LIT(0x76bf82cee72ae571), W64LIT(0x83a2e4e1139582ac),
+	W64LIT(0x0000000000000071),
+	W64LIT(0x1fac403d45debfe4), W64LIT(0x702e47e5a342d722), W64LIT(0x048beaee8f6d96d2), W64LIT(0x6951bd7819ca087c),
+	W64LIT(0x1c497373626875e4), W64LIT(0x879b8b5f4305c847), W64LIT(0xaf5207ddf8f7e7a9), W64LIT(0xb6ddbee04e61adc5),
+	W64LIT(0x000000000000019f),
+	W64LIT(0x9073e70390f2dae8), W64LIT(0x2c32fc735f5f224c), W64LIT(0xf9358b261fc34d8e), W64LIT(0x8f4763b2c6935b20),
+	W64LIT(0x14b20ae8b68f1dbe), W64LIT(0xe9314622202bf9ad), W64LIT(0x80d864f1670b0c97), W64LIT(0x78bbc6f9acfeacad),
+	W64LIT(0x0000000000000191),
+	W64LIT(0x63e6568691198a18), W64LIT(0x5d8b9f3748349603), W64LIT(0x1e17ca76dbf19a07), W64LIT(0x52945edd83ab0a72),
+	W64LIT(0x989688ba0ce3d10f), W64LIT(0xb4dbbec0be4b06b0), W64LIT(0x59b3bd36473556c9), W64LIT(0xc7475a43cd529c8c),
+	W64LIT(0x0000000000000033),
+	W64LIT(0xa7c39d7f483b885f), W64LIT(0xa7c92239cdf02be1), W64LIT(0x2899044b54a2c741), W64LIT(0x06ef34467b1d4528),
+	W64LIT(0xeaa61ff3875e5108), W64LIT(0x2454de00c6df1ef3), W64LIT(0xc2c564867e8d8a87), W64LIT(0xf694f039c4e06fdb),
+	W64LIT(0x000000000000015c),
+	W64LIT(0x437797144c071231), W64LIT(0x595f7b8b513305a5), W64LIT(0xc827d12bec347305), W64LIT(0x3b31a5d791ba78ac),
+	W64LIT(0xd250c68227fc7918), W64LIT(0x2ce926fd75960e91), W64LIT(0xe5ee2f0018b1bb16), W64LIT(0xe43e87b2ef6ea4da),
+	W64LIT(0x0000000000000122),
+	W64LIT(0x2868ac38981552d7), W64LIT(0x8bbc400f14065305), W64LIT(0x161ec3a690e79543), W64LIT(0x61a015b59f6767dc),
+	W64LIT(0x6379e995bc422f67), W64LIT(0x354257179b7f401d), W64LIT(0xd91a707c6b2ee349), W64LIT(0x15dbce9635eb349b),
+	W64LIT(0x00000000000001f7),
+	W64LIT(0x44975f9aed9f5183), W64LIT(0x5e159e42fea5a905), W64LIT(0x7998f11896a22b50), W64LIT(0xfa16c20139ab2af8),
+	W64LIT(0x2a33479fac4b27d9), W64LIT(0x4167291fb3ffbf31), W64LIT(0x9040f14cde7e7db4), W64LIT(0x152a5fc1e5e085d4),
+	W64LIT(0x00000000000000e8),
+	W64LIT(0x68a4190e6934bc36), W64LIT(0x4f2e504c335b8486), W64LIT(0xe6fe2d7e587cf9d0), W64LIT(0xa76931409f756d73),
+	W64LIT(0x14fcaeef83d50774), W64LIT(0x5487aaf6ac606245), W64LIT(0xd4601e8d7949c789), W64LIT(0x17c113a83c5ce0c0),
+	W64LIT(0x0000000000000016),
+	W64LIT(0x3f493a602f19069a), W64LIT(0x7439f5e26bd06996), W64LIT(0xc55d61d13eb30057), W64LIT(0x80080fe5df418a0d),
+	W64LIT(0x643f8a2801a3b8fd), W64LIT(0x79f3ca3271aac158), W64LIT(0xba9e8a0dd103a7a5), W64LIT(0xacf6fb4fd2bf2470),
+	W64LIT(0x00000000000000d9),
+	W64LIT(0x06d7634253ae4089), W64LIT(0xe6459e9586c60b28), W64LIT(0x892cdde92ea8c30b), W64LIT(0x7baa234adce6b6c9),
+	W64LIT(0xa34d6aff0461b942), W64LIT(0xbd4ded57a6fe92a0), W64LIT(0x42b7901f0c3eed6b), W64LIT(0xa3753c825aa4b214),
+	W64LIT(0x0000000000000011),
+	W64LIT(0x256483b2459b2510), W64LIT(0xa3021fe5b69c6995), W64LIT(0x18e29e4b0608df27), W64LIT(0x8147950768dc0af6),
+	W64LIT(0x300371842f870bdd), W64LIT(0x09814795c7aa0252), W64LIT(0xe39e6b4bd5ef4417), W64LIT(0xddbfda39a240412e),
+	W64LIT(0x00000000000000d4),
+	W64LIT(0x225256fdb79711e5), W64LIT(0xbdcf3433a6a843b7), W64LIT(0xbd3d4548414a71ab), W64LIT(0x2e13fd39e29e7606),
+	W64LIT(0x194b6e92e07f29c4), W64LIT(0xd6f5e492b68fd0d2), W64LIT(0x3ac649985de0ae9b), W64LIT(0x10e5afe94e5ba961),
+	W64LIT(0x00000000000001f7),
+	W64LIT(0x27df3c4b8ec9ccff), W64LIT(0xdb2913722a7b0a2b), W64LIT(0x1ca89222f045afde), W64LIT(0xa666763c69c99247),
+	W64LIT(0xd8d9f6b199033177), W64LIT(0x10b696f690eca082), W64LIT(0x41991d660d180f50), W64LIT(0x7cee7f9b82d6f6bc),
+	W64LIT(0x00000000000001df),
+	W64LIT(0xc43876449d2224b8), W64LIT(0x80c92ac5563094e8), W64LIT(0xef919bdbf6d0542e), W64LIT(0xc71a882d5c40a787),
+	W64LIT(0xdb3851be0880c1b1), W64LIT(0x4f72ff0c287cae73), W64LIT(0x0a628f172bf3efe6), W64LIT(0x29db69240150e4a7),
+	W64LIT(0x0000000000000175),
+	W64LIT(0x7983f80acc367287), W64LIT(0xfe2c8f3dc4633183), W64LIT(0x41b0e222ae89f8c9), W64LIT(0x93fdd59beb58ac1e),
+	W64LIT(0x5ee164c797538725), W64LIT(0xb8e3b75b7591fb4e), W64LIT(0xa2d0fa2e355a6a6c), W64LIT(0x391a05540405f33a),
+	W64LIT(0x00000000000000e6),
+	W64LIT(0xc4e95f91d3c21303), W64LIT(0x1d081667507ab363), W64LIT(0x2d0d08ec54bfa44b), W64LIT(0x1b3355130134a552),
+	W64LIT(0xf4b9be3a4e134ee7), W64LIT(0x98cf7bf37868ba98), W64LIT(0xd4946eab65b218a6), W64LIT(0xd9ce9d4f1099f31a),
+	W64LIT(0x000000000000003d),
+	W64LIT(0x894b56e8d5a0e6e0), W64LIT(0xe335e6489e4c68b9), W64LIT(0x0a7869466fd96f82), W64LIT(0x2ef6aa5a492145e6),
+	W64LIT(0x58ed4c80de5012e0), W64LIT(0x26941e6e12b958ba), W64LIT(0x4a1d1067c02482c7), W64LIT(0xcc7ac7b0246bb28a),
+	W64LIT(0x0000000000000196),
+	W64LIT(0x55417ffa525abf32), W64LIT(0x1ff40e1678067dfc), W64LIT(0x431a0ae12795ea6a), W64LIT(0xc3de691cef54c597),
+	W64LIT(0x60a0c51b95f9d2bb), W64LIT(0x30840ca982772f1a), W64LIT(0xddaf460496eb0344), W64LIT(0x03a9f6f48615d783),
+	W64LIT(0x0000000000000035),
+	W64LIT(0x74598cb233edcfa4), W64LIT(0xbb866bc9de9dccde), W64LIT(0x0c4831162a673bb2), W64LIT(0x3eddd388fee306a7),
+	W64LIT(0x8785a002c80eb5b9), W64LIT(0xe2bd81f71937371f), W64LIT(0x501648595684a105), W64LIT(0xf0f3fdde1f26e0db),
+	W64LIT(0x0000000000000119),
+	W64LIT(0xbf89ad887c3c8162), W64LIT(0xe58416ced1c7d9de), W64LIT(0x32d95903a8be6602), W64LIT(0x15472d52e81c9d96),
+	W64LIT(0x94ec396e30135b96), W64LIT(0xad54bb6d1afc1aad), W64LIT(0xdc73e4525b70ae01), W64LIT(0xd57f0416e967c072),
+	W64LIT(0x0000000000000044),
+	W64LIT(0xc2374e88e75f620d), W64LIT(0x76a906523954d8ab), W64LIT(0x2fcb5daff417c7f5), W64LIT(0x41ef11455bb65626),
+	W64LIT(0xba526e56c19b0730), W64LIT(0x5d0268ce6145c45e), W64LIT(0x3f2f82b80d6a6cbd), W64LIT(0x2f9bcadcfe45e7b9),
+	W64LIT(0x0000000000000173),
+	W64LIT(0xb19ab1185d1df560), W64LIT(0x75f9daa359c37d59), W64LIT(0xd58a67c124d7cb86), W64LIT(0x1b9a2373be7dca65),
+	W64LIT(0xe28942f076b81a39), W64LIT(0x2a8e42906797efbf), W64LIT(0x1cddb4dc8b806c08), W64LIT(0x790ece1ccc8297a3),
+	W64LIT(0x000000000000002f),
+	W64LIT(0xdb217f860d70a819), W64LIT(0xeaa76d2a11023e8d), W64LIT(0x543c55a71d5d298d), W64LIT(0xa67f1eef9070f595),
+	W64LIT(0xba941ff064673e5b), W64LIT(0xe994a2f24a9a3db1), W64LIT(0x44c1bb3badb80b71), W64LIT(0x617f209f494720fb),
+	W64LIT(0x000000000000010d),
+	W64LIT(0xbc388b29efff9cc9), W64LIT(0x4a308a63b71fc6e5), W64LIT(0x298473e13545a88f), W64LIT(0x3bd9e1e28dd33b18),
+	W64LIT(0xeba7cbd4e159519d), W64LIT(0x57ab635fc7bb8fe4), W64LIT(0xbf8d899ecd9e47de), W64LIT(0x2279f8ce4da880be),
+	W64LIT(0x000000000000014d),
+	W64LIT(0x4d309b7a9c625ec1), W64LIT(0x31fbc402212537e3), W64LIT(0x4077628456788032), W64LIT(0xe2e09beb1cbf0c85),
+	W64LIT(0x913885a024ffc24b), W64LIT(0x4cdcd2c056b265e4), W64LIT(0xf242c2dc259a2179), W64LIT(0xfc4a6a384c98f545),
+	W64LIT(0x00000000000001bf),
+	W64LIT(0x7d6e42404e1080a4), W64LIT(0x5cf6c427e1adb078), W64LIT(0xe74ec6033d594e28), W64LIT(0xc0185404bdf853f2),
+	W64LIT(0x287d94dec3335717), W64LIT(0xf735656ac3179807), W64LIT(0xd356f2bf604e93f7), W64LIT(0xb1fdc2f2cbe27815),
+	W64LIT(0x0000000000000151),
+	W64LIT(0x7b17e356da1d3ea1), W64LIT(0x0ed57d7ea7af9610), W64LIT(0x4a6ac3e53ae89c0e), W64LIT(0xc8f722b85f82b4a3),
+	W64LIT(0x453d5a4a7f0850fa), W64LIT(0xd6f79d237b3ac4a3), W64LIT(0xe1c9dfc20dbae800), W64LIT(0x56e4f0f5c4b9258e),
+	W64LIT(0x00000000000001ca),
+	W64LIT(0xc7de77e131752de8), W64LIT(0xf35fc723ba64df55), W64LIT(0x24ffd503a81b220a), W64LIT(0xfa67b73e93578fca),
+	W64LIT(0xb22cdb5374969400), W64LIT(0xe85fb3fe1b2b7d1e), W64LIT(0x888d548ee2bfb9fb), W64LIT(0xb563081908e01162),
+	W64LIT(0x000000000000006b),
+	W64LIT(0x1ec394acbff5f49b), W64LIT(0x9c83f45f8af956d9), W64LIT(0xba74f23fdf893bb0), W64LIT(0x73baf65d45a7cf13),
+	W64LIT(0x6eab2247a0763e86), W64LIT(0x97400e6d4140c7b3), W64LIT(0x38295c4842bdab45), W64LIT(0x988832ff02cd897d),
+	W64LIT(0x00000000000000f9),
+	W64LIT(0x5f42054135da448a), W64LIT(0x9318ef62066a90be), W64LIT(0x21b3ce3b82fe4b18), W64LIT(0x3442eb039b55ca2a),
+	W64LIT(0x114494d2f165abac), W64LIT(0x8f556373ab815ae4), W64LIT(0xf9a8c005de8e0f34), W64LIT(0x28ffa49b5821c9ad),
+	W64LIT(0x00000000000000a8),
+	W64LIT(0xafb501cdb8a9478b), W64LIT(0x7200dd631617d197), W64LIT(0x39b8433b8fd2d128), W64LIT(0x17d0f74fa369c4bf),
+	W64LIT(0xd521d2e193fa84ad), W64LIT(0x55aa019c50702310), W64LIT(0x997a2b3a4728ccc4), W64LIT(0xcb99b219c3e6e217),
+	W64LIT(0x0000000000000136),
+	W64LIT(0xb730b23d732881ba), W64LIT(0xbd073b36766b43f1), W64LIT(0x7a384fe662d3f423), W64LIT(0x33b925cae9d1242f),
+	W64LIT(0x0ca73071d0318479), W64LIT(0x69ee382b10d81c0c), W64LIT(0x54b03ec186cd5f80), W64LIT(0x842d372fedf94514),
+	W64LIT(0x00000000000000a9),
+	W64LIT(0x44a4be71a3efbd4d), W64LIT(0x66d2523c034f785f), W64LIT(0x9bde302e0bd93333), W64LIT(0xe262b7903a53187a),
+	W64LIT(0xab1b1334d593b947), W64LIT(0xf9156af3c8565376), W64LIT(0xcbc2c0e0d8460fb9), W64LIT(0xcf01316877c79e9c),
+	W64LIT(0x00000000000000ed),
+	W64LIT(0x6831d7f8564313c7), W64LIT(0xca0c1ffa30940c65), W64LIT(0x549b2ace9f8a9fe7), W64LIT(0xb2e3b4f9ae4b09d1),
+	W64LIT(0xfae4dac99b17c47e), W64LIT(0x4106643da44830d2), W64LIT(0xed0f710af9be8d7b), W64LIT(0x708099c5d11891f0),
+	W64LIT(0x0000000000000179),
+	W64LIT(0x23d52c6c6c58670c), W64LIT(0xfe8f21adc50a6680), W64LIT(0xd88be6392446441d), W64LIT(0x3d4a5560a7a42571),
+	W64LIT(0x5a7dbe9f11bcaa3b), W64LIT(0x1effa3a765b34274), W64LIT(0xdef68443d74cc197), W64LIT(0x7ff43f3dac98a8ce),
+	W64LIT(0x0000000000000005),
+	W64LIT(0x79816a6fa19bada5), W64LIT(0x98f2106755f8890a), W64LIT(0x3f3ea45d9c57ea1f), W64LIT(0x478b34b322851683),
+	W64LIT(0x582db3e72b646176), W64LIT(0x42b0f34366cd5cc0), W64LIT(0x7dfdaddb84915506), W64LIT(0x3eb638ac22f5c469),
+	W64LIT(0x0000000000000110),
+	W64LIT(0x89292a1b8df5ec4e), W64LIT(0x7527546af48c92a5), W64LIT(0x571341fcf07deb65), W64LIT(0xd410e28eae17e0e5),
+	W64LIT(0xb26d187ea92d67d6), W64LIT(0x2ef7d5abb121ae96), W64LIT(0xe3886c32bb177938), W64LIT(0xe50447342ca5d1a6),
+	W64LIT(0x000000000000008b),
+	W64LIT(0xf62b14268f2a04be), W64LIT(0x7f97b05385a183e7), W64LIT(0x4fad00f70c1976c2), W64LIT(0xe45d6be86a4c4a76),
+	W64LIT(0xe760db2a40817929), W64LIT(0x8b70c8b1c6e09ed6), W64LIT(0xac65b639258afa31), W64LIT(0xe7056bffa6da688d),
+	W64LIT(0x0000000000000015),
+	W64LIT(0x1be4f5f93f178bf6), W64LIT(0xad0ccec07ede6c16), W64LIT(0xf7d286955eae48d5), W64LIT(0xd7b67edf2b86c624),
+	W64LIT(0xec3c9266996a9355), W64LIT(0xe6e1e95d4053330c), W64LIT(0xe019e08674fe7d22), W64LIT(0xf3647ded10c1f41b),
+	W64LIT(0x0000000000000024),
+	W64LIT(0x2bf43c35e34b9dc8), W64LIT(0x0c01155c3a8e920b), W64LIT(0x64cc98acd92cddc6), W64LIT(0x35f604128f260ddf),
+	W64LIT(0xfe1201ba361457fe), W64LIT(0xea6f5cb2a9aa54c1), W64LIT(0x8230bdedc53ac4f0), W64LIT(0x92c3693cf366acdb),
+	W64LIT(0x000000000000002e),
+	W64LIT(0x366a493c939e7a58), W64LIT(0xf90ad5d1e5a1566b), W64LIT(0xe7a8bdffdd1b40c5), W64LIT(0x00b9bda8e7ac0868),
+	W64LIT(0x0d0ce6affa76aeb4), W64LIT(0x561cece085d13dfe), W64LIT(0x6cbec84ad0afab94), W64LIT(0x7c2990d4693b8cf0),
+	W64LIT(0x0000000000000089),
+	W64LIT(0x2fafc73f189a0360), W64LIT(0xe08428f1a68509e8), W64LIT(0x4700e3eb3a2af597), W64LIT(0x143c0bf14b298188),
+	W64LIT(0x9fb03775f0b9b8f6), W64LIT(0x7c9e5a3a2653d193), W64LIT(0x41109c62d1f8ab93), W64LIT(0x8ad7cb71434536b8),
+	W64LIT(0x0000000000000073),
+	W64LIT(0x82c43b2daa844edd), W64LIT(0xad5be7ac3cafb62d), W64LIT(0x8dd99c5b4a5b4b0c), W64LIT(0x2a11dc4131c113aa),
+	W64LIT(0xe62332e93390e968), W64LIT(0xa912cdea4b073b39), W64LIT(0xbb0b8141bc11cb2c), W64LIT(0x504272d1c9dca239),
+	W64LIT(0x000000000000007f),
+	W64LIT(0xe552a04a94c22c36), W64LIT(0xde5fa5c26f9e6297), W64LIT(0x1ffdb66ab452828f), W64LIT(0x24771bd016267372),
+	W64LIT(0x84cd50ac9c34cfe1), W64LIT(0x6d70e86ee622a0eb), W64LIT(0x975ec554b2d24f67), W64LIT(0xa0dbabb31d9db38d),
+	W64LIT(0x0000000000000030),
+	W64LIT(0xbfd41780affe402a), W64LIT(0xe5c5c813d9e04366), W64LIT(0xe1887e7c8d1e290a), W64LIT(0xf96aeb47bbc07ff2),
+	W64LIT(0x7228265cef6adff7), W64LIT(0x0571710847e0f7db), W64LIT(0x3323b89753339ec7), W64LIT(0x1a2052519a2426de),
+	W64LIT(0x000000000000006a),
+	W64LIT(0xd477d07733dca8cc), W64LIT(0x8935d044d13f699c), W64LIT(0xfb097f212e92b833), W64LIT(0xf5f53fa2419b56ab),
+	W64LIT(0xdec7f4bae0f175cf), W64LIT(0x629fb05acfc34dde), W64LIT(0x305bdad23dfb7bf2), W64LIT(0xccdf4cf9dc30e1f9),
+	W64LIT(0x0000000000000190),
+	W64LIT(0x4552311e453a115d), W64LIT(0x143d23a7c11fee54), W64LIT(0x80efa23f42a28d07), W64LIT(0x9a3551f22384aa48),
+	W64LIT(0x7e51fc0ff406b55c), W64LIT(0xf72fe5cfc960a7d0), W64LIT(0x86b7e9823f758ace), W64LIT(0x79950dc3b6af0e74),
+	W64LIT(0x00000000000000fa),
+	W64LIT(0x0c104b6891b7a42b), W64LIT(0x059b8e379376d113), W64LIT(0x3a965ff1d008f97f), W64LIT(0xe8fff59d8d9425c2),
+	W64LIT(0x2e70d12d8f7f5f4b), W64LIT(0x0db4ab861a212720), W64LIT(0x142247fe5941fb93), W64LIT(0xbdcc543eae64eb3d),
+	W64LIT(0x0000000000000012),
+	W64LIT(0x3b71f091603d5698), W64LIT(0xffb5d2a0170f5d2c), W64LIT(0x607e124f1fd33437), W64LIT(0x7bd2ebfc06583d96),
+	W64LIT(0x84241d110c1f432d), W64LIT(0x0ed2cddb8a6ba576), W64LIT(0x265da44a91dc47e3), W64LIT(0x2102b5d4fce378da),
+	W64LIT(0x00000000000001ef),
+	W64LIT(0x37fc357729a135f1), W64LIT(0x6801e7ecf0b7fee5), W64LIT(0x2108f1a864d812e3), W64LIT(0x1a434b4b40e15783),
+	W64LIT(0x5c7c39c47e4d05f5), W64LIT(0xa2d2b197dfc24630), W64LIT(0x8fc9af2e9c574535), W64LIT(0xd9425acaf173f20c),
+	W64LIT(0x0000000000000005),
+	W64LIT(0xd363a9372fc8b709), W64LIT(0x524aaa5d3a437d6f), W64LIT(0x48775ae3a4940210), W64LIT(0x740e3b495460c5fa),
+	W64LIT(0xa2a875f4bdc86411), W64LIT(0x2ead157b68d2efe6), W64LIT(0x05423a91aea36a27), W64LIT(0x4f7d8955f2a5e845),
+	W64LIT(0x00000000000001e3),
+	W64LIT(0x47df3ff232436a36), W64LIT(0xd2abfebdeb65b884), W64LIT(0x2b6a967cfe5f98ca), W64LIT(0x0e51bacdb7d9deaa),
+	W64LIT(0xb9e43b561ecd8b64), W64LIT(0x50f926b58cf02a2b), W64LIT(0x0436e7a99e40da70), W64LIT(0x358c113cca742ce2),
+	W64LIT(0x000000000000004c),
+	W64LIT(0x0d4c266c38f08f19), W64LIT(0x14cf8d387fa7c5ca), W64LIT(0xd23eb2cf56263251), W64LIT(0xa4101a114951562a),
+	W64LIT(0xa771c64a360a204c), W64LIT(0xab654ac11fd6de0b), W64LIT(0x559a2c25bb98a94a), W64LIT(0x8aff56f614525eb2),
+	W64LIT(0x00000000000000d5),
+	W64LIT(0x310fbb4408ead548), W64LIT(0x62c67ca65b8eab0c), W64LIT(0x5b27db848cd56307), W64LIT(0xb6a1ade32fe3047f),
+	W64LIT(0x84eb80272789e93d), W64LIT(0x03b0dbc6fd2f981d), W64LIT(0x4a574866da8c85dd), W64LIT(0xcff6c637d89aa8aa),
+	W64LIT(0x000000000000002f),
+	W64LIT(0x4fa03bb20b615c7b), W64LIT(0xac6cb79f9ddaa93b), W64LIT(0xc1741c47e48fca26), W64LIT(0x6e8b5eef649391d4),
+	W64LIT(0x9badb868a05f4e29), W64LIT(0x84ef518482ff651f), W64LIT(0xad8c7a3f8be9ad52), W64LIT(0xefa52c01f424dee4),
+	W64LIT(0x00000000000000a5),
+	W64LIT(0xd996af7751eb951e), W64LIT(0x52041be08a1a2df7), W64LIT(0xff9c810aa3f1482d), W64LIT(0xe26673d593febf78),
+	W64LIT(0x94525ad01b252406), W64LIT(0x22e4818246bbdd27), W64LIT(0xfb1aea6a8db8e225), W64LIT(0x1ad23b7a07cf96cf),
+	W64LIT(0x0000000000000045),
+	W64LIT(0x2351c63158f9f62e), W64LIT(0x719d2e7e55a83d7c), W64LIT(0x98dc46ccf0da82eb), W64LIT(0x264e6b3c85530b2c),
+	W64LIT(0xd75d3dd0e53579a0), W64LIT(0xb64bf0746e7f991e), W64LIT(0x8fb537224f47e961), W64LIT(0xf290d405160ed726),
+	W64LIT(0x0000000000000035),
+	W64LIT(0x3f363ed581babbe3), W64LIT(0xd643ab9a98edd3d7), W64LIT(0x1bfd75f756818f7f), W64LIT(0x3cabc1867b1436cb),
+	W64LIT(0x8edfb72dc793accc), W64LIT(0xa7f74dd0b0603ad0), W64LIT(0x565f60da2e71df76), W64LIT(0x94b480a87823b32a),
+	W64LIT(0x00000000000000ed),
+	W64LIT(0x73df6f44f9d095e5), W64LIT(0xaf95c85fb9b3df1c), W64LIT(0x9523f447a4403205), W64LIT(0x699d1d59385a974a),
+	W64LIT(0x41b070cdb57f0d6f), W64LIT(0x17fed46814f5cf39), W64LIT(0x5fe3a7846c720d3e), W64LIT(0xcef875aca3621a23),
+	W64LIT(0x00000000000001ef),
+	W64LIT(0xc5241e0a285c54fd), W64LIT(0x0fd64167729fd7cb), W64LIT(0xd9b24e3b4051b863), W64LIT(0x98b877151ac84a13),
+	W64LIT(0x59e3e47038264deb), W64LIT(0x2678053520215aad), W64LIT(0x3a48bd924253643e), W64LIT(0x190b3ec9646331bd),
+	W64LIT(0x0000000000000065),
+	W64LIT(0xc002dc29196e9438), W64LIT(0x1599f851c930e02d), W64LIT(0x3dd0bc4869c4be2f), W64LIT(0x3968429d8651c9b4),
+	W64LIT(0xbc96ce5452608c8e), W64LIT(0x0388f4e5d231f00a), W64LIT(0xb74f2419b83312a2), W64LIT(0xb039b5c0625531d2),
+	W64LIT(0x0000000000000087),
+	W64LIT(0xf53137c85d0dc224), W64LIT(0xbeba7ccd3e8cda48), W64LIT(0x2332cdf40945b3de), W64LIT(0xdf4ec286a2e74f77),
+	W64LIT(0xfa1714977de856bd), W64LIT(0x1da30ca43b2c658f), W64LIT(0xeb46d8fa02d9ce6e), W64LIT(0x10ca5e890f4807d6),
+	W64LIT(0x000000000000010c),
+	W64LIT(0xf3a0def073126131), W64LIT(0x24fc2a2b253bbe98), W64LIT(0x010480a826432498), W64LIT(0x9daa4bdebd8324b3),
+	W64LIT(0xc6697eff6d49e170), W64LIT(0x6d9baabc02071300), W64LIT(0x411b3319fd517711), W64LIT(0xecc676955163b9a2),
+	W64LIT(0x00000000000000ee),
+	W64LIT(0x3576a47311b1d17f), W64LIT(0x6bb0e7ae33047ee7), W64LIT(0xea4d296269b34b5f), W64LIT(0x8fff59dc9b261544),
+	W64LIT(0x015c6b30ae498ad5), W64LIT(0x1a43db629501b64a), W64LIT(0xa7fed727e071f636), W64LIT(0x78e99bbf871401e5),
+	W64LIT(0x000000000000018b),
+	W64LIT(0x622bd05456d1473c), W64LIT(0xd939b49050f3b496), W64LIT(0xc736778c03bc0ce3), W64LIT(0xe03c725b5e73a934),
+	W64LIT(0xf6fcb2804ef26872), W64LIT(0xdc7c7ddb13703b00), W64LIT(0x2757322d7bbfcefa), W64LIT(0x3b3021966a3c54ca),
+	W64LIT(0x00000000000001f4),
+	W64LIT(0x1251def7e650f267), W64LIT(0xb9ac4faa6c45341b), W64LIT(0x86cb15150fc6b530), W64LIT(0x1b27f20066be655d),
+	W64LIT(0x6bb3916459f0c78e), W64LIT(0x95e505e13396324c), W64LIT(0xafa8dfeb1fe3fe95), W64LIT(0x3376de731a1401c8),
+	W64LIT(0x00000000000000e9),
+	W64LIT(0xcd096667acffa8b1), W64LIT(0x29577d72ac4e6399), W64LIT(0xc3e20b551f510eee), W64LIT(0xe305235decf547d2),
+	W64LIT(0x74c724ce805e89f3), W64LIT(0xcc05c6474227d606), W64LIT(0xe9a903052db52516), W64LIT(0x3ca1eaabd81ee73a),
+	W64LIT(0x000000000000015b),
+	W64LIT(0x6da58b5a8bf7cff0), W64LIT(0x4dad236ec052a841), W64LIT(0x31270f40234b09a2), W64LIT(0x4803bd2d99f64707),
+	W64LIT(0xafd40d10a097f172), W64LIT(0x561a6d44ccde9c55), W64LIT(0xe1e5119718ed91c3), W64LIT(0x4fe8588cfa8b734c),
+	W64LIT(0x000000000000011b),
+	W64LIT(0xfa3248493cee88a6), W64LIT(0x936c6e64b903dd11), W64LIT(0x3eee8252566883da), W64LIT(0x7a4428e367adbe74),
+	W64LIT(0xb3dabda51c03ff53), W64LIT(0x3890d26afed404ff), W64LIT(0x1ffc1a9564958bb7), W64LIT(0x2c28614c0ca6e303),
+	W64LIT(0x0000000000000123),
+	W64LIT(0xef3fbe68362820b5), W64LIT(0x09e1ea9cd96e3767), W64LIT(0x198aa81b9f854421), W64LIT(0x14b48a57cdd60866),
+	W64LIT(0x87f706a655fffb82), W64LIT(0xf7015c81ebf83284), W64LIT(0x23a2e279295877b4), W64LIT(0x06e4be92d6dba340),
+	W64LIT(0x00000000000001c2),
+	W64LIT(0x2f298108977bee11), W64LIT(0x3009d53080c001ee), W64LIT(0x255611d90ac57bd8), W64LIT(0xd61930bd0fd6965d),
+	W64LIT(0xacb7b6a0310003c2), W64LIT(0x0688996c5dfaa8de), W64LIT(0xf65b691faae1c4e7), W64LIT(0x6c935c1df81e4851),
+	W64LIT(0x000000000000014b),
+	W64LIT(0x2c836f76f8226d70), W64LIT(0x6bad10f38924f1fe), W64LIT(0x5df3795cb1cfe61e), W64LIT(0x48cf2fef6bafa4a1),
+	W64LIT(0xc8d6adcdf7f55a4e), W64LIT(0x83e302da407549d3), W64LIT(0x5dda340806e0f4b0), W64LIT(0x303263b99638ae2f),
+	W64LIT(0x0000000000000118),
+	W64LIT(0xa4c6085e0e37ac4e), W64LIT(0x5f954f69a6c5b807), W64LIT(0x9e2fe25c4beaca57), W64LIT(0x37990b4e1bad1e46),
+	W64LIT(0x6f4d7feb04a86876), W64LIT(0xfba42029ffadc604), W64LIT(0x7aa805f950784104), W64LIT(0x084f5ba2adca2a69),
+	W64LIT(0x000000000000012b),
+};
+
+static const word64 s_brainpoolP256r1Curve[] = {
+	W64LIT(0x2013481d1f6e5377), W64LIT(0x6e3bf623d5262028), W64LIT(0x3e660a909d838d72), W64LIT(0xa9fb57dba1eea9bc),
+	W64LIT(0xe94a4b44f330b5d9), W64LIT(0xfb8055c126dc5c6c), W64LIT(0xeef67530417affe7), W64LIT(0x7d5a0975fc2c3057),
+	W64LIT(0x6bccdc18ff8c07b6), W64LIT(0x958416295cf7e1ce), W64LIT(0xf330b5d9bbd77cbf), W64LIT(0x26dc5c6ce94a4b44),
+	W64LIT(0x3a4453bd9ace3262), W64LIT(0xb9de27e1e3bd23c2), W64LIT(0x2c4b482ffc81b7af), W64LIT(0x8bd2aeb9cb7e57cb),
+	W64LIT(0x5c1d54c72f046997), W64LIT(0xc27745132ded8e54), W64LIT(0x97f8461a14611dc9), W64LIT(0x547ef835c3dac4fd),
+	W64LIT(0x901e0e82974856a7), W64LIT(0x8c397aa3b561a6f7), W64LIT(0x3e660a909d838d71), W64LIT(0xa9fb57dba1eea9bc),
+};
+
+static const word64 s_brainpoolP256r1Points[] = {
+	W64LIT(0x3a4453bd9ace3262), W64LIT(0xb9de27e1e3bd23c2), W64LIT(0x2c4b482ffc81b7af), W64LIT(0x8bd2aeb9cb7e57cb),
+	W64LIT(0x5c1d54c72f046997), W64LIT(0xc27745132ded8e54), W64LIT(0x97f8461a14611dc9), W64LIT(0x547ef835c3dac4fd),
+	W64LIT(0x3e06c8e2025727f0), W64LIT(0x5c53691abf9e7c6b), W64LIT(0x029f4f198ba06332), W64LIT(0x3aba78cf27c41988),
+	W64LIT(0x5879bcd58c7068bd), W64LIT(0x1403139e0e6ded8d), W64LIT(0xbb5492d571937c0e), W64LIT(0x432a9707661b499e),
+	W64LIT(0x4b566b2317f166ed), W64LIT(0x22242fd48af23d27), W64LIT(0x32f8c090e0be5963), W64LIT(0x849134ea536499b3),
+	W64LIT(0xb4fe77a158c822a9), W64LIT(0x94ff29b0e3f6da2f), W64LIT(0xf0908db194d6aca3), W64LIT(0x0142c66b3e49a80a),
+	W64LIT(0x9098fd60d628e067), W64LIT(0xa2bf345b214ad884), W64LIT(0x1a4402867964824f), W64LIT(0x26c9c3f5b1a26fc3),
+	W64LIT(0x60e55723e1d2a90b), W64LIT(0x9c0c68a31d2afeb5), W64LIT(0x1aa5062b14a6e420), W64LIT(0x06251bf4119b3a8f),
+	W64LIT(0xa5e38cc952eda23c), W64LIT(0xd17a933f87c4c972), W64LIT(0xcb08763e61531296), W64LIT(0x8076c308f4748c09),
+	W64LIT(0x38c4eeeda609dd05), W64LIT(0x6e2bb7a54bbed974), W64LIT(0xab24380aca122042), W64LIT(0x23b72e7a90717200),
+	W64LIT(0x6cc16bc52e4059be), W64LIT(0x7a2a8e930dd6c95a), W64LIT(0x962cec5d2092bac5), W64LIT(0x72499211d9e2877f),
+	W64LIT(0xf60309586fa58574), W64LIT(0xefeb93b3b560d198), W64LIT(0xde0beef4fa1bc9b9), W64LIT(0x7e1f752bbe95c6ba),
+	W64LIT(0x4e28b47f127f0afd), W64LIT(0x6bcacca59f97f017), W64LIT(0x9b72ec2c8b2ec67f), W64LIT(0x2b1725ef55503379),
+	W64LIT(0x6d326eb37100be17), W64LIT(0xdd80336be2572bba), W64LIT(0x1d6258cfbc3ade9a), W64LIT(0x8968c3f78eb1a630),
+	W64LIT(0x69f82f9b116ce1f2), W64LIT(0x5ec5c9a22304c096), W64LIT(0xe77a426ee3de1273), W64LIT(0x3a294b12c936af3d),
+	W64LIT(0x990504243acd15b6), W64LIT(0x27a13f790533becf), W64LIT(0xcc9e89f29360c439), W64LIT(0x97e386770e1b56a4),
+	W64LIT(0x98703354bf7e515c), W64LIT(0x3a96d7259dbf4a96), W64LIT(0x70114d3bb95483d0), W64LIT(0x4c24143c382f5d8f),
+	W64LIT(0x12ca2e4599cee521), W64LIT(0xe6e9e86ecec84af8), W64LIT(0xb0a7e26604d87536), W64LIT(0x28eddbce91de1a21),
+	W64LIT(0xdd96694799380957), W64LIT(0x3b72825035a39d95), W64LIT(0xd7cbf75b65476b12), W64LIT(0x4d81fbfd8969bb15),
+	W64LIT(0x28f82a5ca0168833), W64LIT(0xae61f1b7095bc86c), W64LIT(0xaeee583eecf522cb), W64LIT(0x66528389ae1f10cf),
+	W64LIT(0xf1b19c85ef443b6e), W64LIT(0x7c87f1b7d35099ea), W64LIT(0x6142489c6fd9efc8), W64LIT(0x91c4c6b40af7f73f),
+	W64LIT(0xa1c7067632ec27c6), W64LIT(0x8feba188f45f146b), W64LIT(0x4047457170b5242c), W64LIT(0x9a301c22be9102c5),
+	W64LIT(0x6eaf7badc6519a44), W64LIT(0x7be684fcc3583d29), W64LIT(0x1743ae18bcb1a3d9), W64LIT(0x4e439b1b2659ea09),
+	W64LIT(0xc277184c8d2fa7e8), W64LIT(0xc4fffbf14c19528d), W64LIT(0x6d998512d777f8e2), W64LIT(0x31dedde5495f72f0),
+	W64LIT(0x13ef957c9460b296), W64LIT(0x997f6b9cda52c73b), W64LIT(0x0089f17d5c1eb866), W64LIT(0x13c84dad7353e694),
+	W64LIT(0x206422891ee96eb8), W64LIT(0xcf6206c078ee8e8b), W64LIT(0x55a425969831ae93), W64LIT(0x5a841fe171dd55f8),
+	W64LIT(0xadf9869226dc363d), W64LIT(0xaf3a8b5a7f8ae7bd), W64LIT(0x634366758f58c058), W64LIT(0x815a3c584a88eae7),
+	W64LIT(0xcf6d007096cfd6dc), W64LIT(0x4a4c474019346be4), W64LIT(0xd72f88029e441a05), W64LIT(0x60f5cef1e92bc2ac),
+	W64LIT(0x2a4f6bce783a4ae4), W64LIT(0xa732803bcc689b82), W64LIT(0xc4a76b8122f70cea), W64LIT(0x3f9fe5d17d7e1128),
+	W64LIT(0xb936ee26dd22bb8a), W64LIT(0x0ed2bbbe9251f097), W64LIT(0x76b6f40aacf8d902), W64LIT(0x19b70d9eb6239aa4),
+	W64LIT(0x6de422fabb5b211e), W64LIT(0xe16346e3c1ef77f5), W64LIT(0x16ea2871dacad983), W64LIT(0x3fb7c371bd22aaad),
+	W64LIT(0x3c2ce3075ed212b3), W64LIT(0x5b300084204ff1c2), W64LIT(0xe42cb1bcc32446b0), W64LIT(0x671bdd3bc7117a19),
+	W64LIT(0x17512a1093a1662c), W64LIT(0x93b6b0bc12111088), W64LIT(0x9ca305840ad7583c), W64LIT(0x36df0bd361958ef7),
+	W64LIT(0x1b70875e0f1292f9), W64LIT(0xc4cffb3aeb9be938), W64LIT(0xb606d345f7b992dc), W64LIT(0x18576cc5e1652882),
+	W64LIT(0xa7cba894b1a4af85), W64LIT(0x359e51619ff8e6f1), W64LIT(0x81061ad583c9f196), W64LIT(0x8645854126ccbf61),
+	W64LIT(0x21346f32e8d9c31c), W64LIT(0x1528eccf34b8cbe0), W64LIT(0xc850377c15eec65d), W64LIT(0x89ac7ccc59b61c8b),
+	W64LIT(0xeb8aea45b02f1455), W64LIT(0x746e5151593a8372), W64LIT(0x8f6bfde6c7685851), W64LIT(0x141333df00c5f5d6),
+	W64LIT(0x50e269d7d6e98b44), W64LIT(0xc5c4e16aef790daa), W64LIT(0x918578266a6b649c), W64LIT(0x1e2306ce07e56dc7),
+	W64LIT(0x164f057d3b25946e), W64LIT(0xc691cbb0aa61bd91), W64LIT(0x830707745893b49c), W64LIT(0x775b24229a7d338c),
+	W64LIT(0xb096de9fe221e715), W64LIT(0xaa5c933857d486a1), W64LIT(0x98529a48e04bc88f), W64LIT(0x2bcd79617d83b0f2),
+	W64LIT(0x5c389e8101770e28), W64LIT(0xc0df2b91a5d5f071), W64LIT(0x2dde98d625b6eed8), W64LIT(0x47b5eb396355a17b),
+	W64LIT(0xa37fed13e3b8d6b6), W64LIT(0x0219cdb836aee86c), W64LIT(0xe856467b7a8382f9), W64LIT(0x3099ac5a1546604e),
+	W64LIT(0x891acd330e6f49c2), W64LIT(0xa02829ac57284108), W64LIT(0xf228a9398f20d493), W64LIT(0x34eeeeb8bf089722),
+	W64LIT(0x4980b09e82020d9a), W64LIT(0x113ce7dbbcc22ce3), W64LIT(0xd077c6463176235e), W64LIT(0x414f39978e940e63),
+	W64LIT(0xa5e3ed0163f966b5), W64LIT(0x87e72d1fe1f52bf4), W64LIT(0x3abd04a55de94228), W64LIT(0x4c4d56512288a1be),
+	W64LIT(0xafb1f87a227587c4), W64LIT(0xea3934ea08f33b31), W64LIT(0x1f04e17f59b2d5f9), W64LIT(0x24d2bb827eb37532),
+	W64LIT(0x6b05e7ea4eff4ff2), W64LIT(0x7e95ff2004807bb1), W64LIT(0xf4d8cff358f34019), W64LIT(0x5a292bdafcc30a0c),
+	W64LIT(0x3c329a0c1d5d7324), W64LIT(0x8d047582dd61db34), W64LIT(0x057b7e3c3b772cd8), W64LIT(0x5caa3e932ea545a9),
+	W64LIT(0x1cd58035905ef1d4), W64LIT(0x58cfcdd15aae17fa), W64LIT(0x8b4efe42c229f1f9), W64LIT(0x590da08ed4e1a409),
+	W64LIT(0x75414ebe50967e74), W64LIT(0x69a1df03190c33f6), W64LIT(0x2e9cf56334b71e81), W64LIT(0xa8e0b4ddcb32d65d),
+	W64LIT(0x80b4319b0983de2a), W64LIT(0xee1f82fcf99b6ff8), W64LIT(0xecbf67cc4601f96b), W64LIT(0x1328d72ef9f57ce3),
+	W64LIT(0xf0a2f96f2bea5bd4), W64LIT(0x219619730a13c2de), W64LIT(0x44af0d72d4ed7bf9), W64LIT(0x82872457fe6ffd97),
+	W64LIT(0x581b8b592df054f5), W64LIT(0x20cd95ca30a0a914), W64LIT(0xa684da070bc90e27), W64LIT(0x7014925d51d95577),
+	W64LIT(0x4e5b381d26be670d), W64LIT(0x8ce1b684b1f1cda5), W64LIT(0xb810e561228b3e1d), W64LIT(0x80afce4ca1ad7926),
+	W64LIT(0x2232fa6966d40c06), W64LIT(0x93be2c7f4c6eaa8a), W64LIT(0xd072637e2faea3e9), W64LIT(0x1171d7e228b07b2e),
+	W64LIT(0xa83c0cec1fa6924a), W64LIT(0x951ccaafad843b9a), W64LIT(0xa5c30e1a5cce0436), W64LIT(0x4820b40b1389e34c),
+	W64LIT(0x0877229c950576b9), W64LIT(0xa1aae3f0059c5ef1), W64LIT(0x3cc23bf70f924eb3), W64LIT(0x13bf5384db26e583),
+	W64LIT(0x5a56d6cbcf43cb83), W64LIT(0xcdb362c9793d8db5), W64LIT(0x57b93f96aba76187), W64LIT(0x24cd037ef937cc99),
+	W64LIT(0x3f92362e376f2b2f), W64LIT(0x48d279122a680e29), W64LIT(0x22364fdf99ed4258), W64LIT(0x3b1f0725c6522628),
+	W64LIT(0x455c80b0083304e4), W64LIT(0xbfdb6c29c732fb17), W64LIT(0x36c8b236a3b214e7), W64LIT(0x40040417c2e9253d),
+	W64LIT(0xbab3d91a34a6c2c8), W64LIT(0x7036a8af53244675), W64LIT(0xa089a69a6ca8a932), W64LIT(0x4d31e2922b4d6d5b),
+	W64LIT(0x0cce2f7ea907e2ff), W64LIT(0xb5a3e89320108a79), W64LIT(0x3ef3b39fb774567f), W64LIT(0x6fd04e078fc7d25b),
+	W64LIT(0xe5f8c8a00f519f1e), W64LIT(0x7c8ba1649ea19392), W64LIT(0xa997e7282b0b9b36), W64LIT(0x3f74716c12536fb0),
+	W64LIT(0xcdf4a92ffee5a8b2), W64LIT(0xb6781db5a4521d06), W64LIT(0x0430ce665f4b768e), W64LIT(0x5cca50c7c263467d),
+	W64LIT(0xf1d5604d1acd08d7), W64LIT(0x4357dcea764fe49c), W64LIT(0x9ebea2b2fe7a261a), W64LIT(0x293cf8a497ef2f57),
+	W64LIT(0xead15fb40e6f6890), W64LIT(0x6673ace19aa783d1), W64LIT(0x6e46cb834d0cb23d), W64LIT(0x65f147bd9a9666c4),
+	W64LIT(0xaee186a04452f888), W64LIT(0x2c51d0a72d951748), W64LIT(0xa9b0eb003be47008), W64LIT(0x87db873edd0f1246),
+	W64LIT(0xab7fad49730ad8ec), W64LIT(0xf5d6ce6840d19516), W64LIT(0x06a57ef9992a3afd), W64LIT(0x72ce95b4bcc8ce43),
+	W64LIT(0xbec7a6e3cc039125), W64LIT(0xd8bda26567d6e68e), W64LIT(0xa999c28d4a8c3b38), W64LIT(0x0e9210ee4f75a7c9),
+	W64LIT(0x503a1e1db9d9bcf5), W64LIT(0x659422602ca4769a), W64LIT(0x017e4e01a5fc5f43), W64LIT(0x4a670945169b0b4b),
+	W64LIT(0xba07fbc516331311), W64LIT(0x58ca76a9f1f94cd1), W64LIT(0x94a3e94eaeb47f48), W64LIT(0x3fc9deaa34f49105),
+	W64LIT(0xf97700b455334807), W64LIT(0x333209ec389d3a95), W64LIT(0x15455d6690a38725), W64LIT(0x7b0c2ddd5a485bca),
+	W64LIT(0x3506289f20320d6c), W64LIT(0xdaa9d9f5df184d44), W64LIT(0x22ff82ce428f4d7a), W64LIT(0x2a181201395677f2),
+	W64LIT(0x27395e0916ae479a), W64LIT(0x59f1373ee85f01ae), W64LIT(0x81809530f71f2f86), W64LIT(0x4e59904bfb31764b),
+	W64LIT(0x7ebe34abec14a6a6), W64LIT(0x46d25a1d3c8bdce3), W64LIT(0x37f2b58ff507a3f5), W64LIT(0x8f73473c1ecd5c93),
+	W64LIT(0x66fecf34b502e8a3), W64LIT(0xf9921930ab6d30d3), W64LIT(0xc18ea59e347c0d60), W64LIT(0x00eef9573fe17457),
+	W64LIT(0xbfc294aade475db7), W64LIT(0x83d104ff7e3a306b), W64LIT(0x5e80cfa4d042e4a7), W64LIT(0x6bf119f2033947c9),
+	W64LIT(0xbc1062bb6183ee7c), W64LIT(0xbfbe7629eac85455), W64LIT(0x5004eac9e02b39f6), W64LIT(0x59e0fee5474b8d71),
+	W64LIT(0x997da5e61ca57c70), W64LIT(0x62b4410863396e35), W64LIT(0xba7e40e5d15297f5), W64LIT(0x5c5cd2479abaa1ee),
+	W64LIT(0xb2c28940fd657269), W64LIT(0xa851da99faddcfca), W64LIT(0x5df14e69ddb9caf6), W64LIT(0x2de7c8313d7336b7),
+	W64LIT(0x3bc526124fe9fc9b), W64LIT(0x1eed441fb18eda1f), W64LIT(0x9a3cd22d6046be72), W64LIT(0xa9ceac2a98190a59),
+	W64LIT(0xd009ff9a0c757c81), W64LIT(0x90302400614887cb), W64LIT(0xf6021c226bdc04f4), W64LIT(0x1c58bbe2290aa2c2),
+	W64LIT(0xf909f7c20ffa2d10), W64LIT(0x7d85556ba337edca), W64LIT(0x231748e43dea8481), W64LIT(0x517cf2208521fc90),
+	W64LIT(0xdd2f961f05603215), W64LIT(0x3683821c2fcc96c5), W64LIT(0x762c231d68a11186), W64LIT(0x3010110cd56c10aa),
+	W64LIT(0x47e9251c43d55761), W64LIT(0xd20a24889702f167), W64LIT(0x865c7d5118089da2), W64LIT(0x2628610511737ffe),
+	W64LIT(0xb5fdf342f65c2cda), W64LIT(0x11c0e4644518077a), W64LIT(0x672efb7f0c71b1ac), W64LIT(0x4d1bce8950a169f1),
+	W64LIT(0x2d67ba94379cbd52), W64LIT(0x479151a413c269b4), W64LIT(0x971fac1cd2336269), W64LIT(0xa08eb4f433113cc7),
+	W64LIT(0x989ee19051aaeff9), W64LIT(0x55571e7ac26d8099), W64LIT(0x93367bc5ac918164), W64LIT(0x2e25f4f4564840ec),
+	W64LIT(0xdfda3d254df4d146), W64LIT(0xd111300fa2572015), W64LIT(0x30d7400685dc9c30), W64LIT(0x4955434fcb9beb61),
+	W64LIT(0xb37d29453ef87dfe), W64LIT(0x2c2fc6bef4b0d708), W64LIT(0x84301515c5b6c36a), W64LIT(0x0874ae6709c9e7cf),
+	W64LIT(0xa5d752f5ae84574c), W64LIT(0xd679609fbdc863ec), W64LIT(0x0f53f6ef913581ad), W64LIT(0x078b2ba3c04e2de6),
+	W64LIT(0x53d32ba3948b74ee), W64LIT(0xa5edffda80e8de2e), W64LIT(0x647699cd820620d3), W64LIT(0x16a888ddd1d17be4),
+	W64LIT(0x5a3458d9955a5b14), W64LIT(0xe3460bdd4702e339), W64LIT(0x03458d9d3f8a63c2), W64LIT(0x88d47c459f197ce5),
+	W64LIT(0x306763d53dcfece8), W64LIT(0x313c9ecbeb4f4777), W64LIT(0x841866b2d6644c21), W64LIT(0x68eb70bf92d9a71c),
+	W64LIT(0xd64d297b5c4fbaf2), W64LIT(0xc830da93de467dac), W64LIT(0x700f607aa9a9501a), W64LIT(0x02fd1e6a7febfdca),
+	W64LIT(0x41b11f57d7154d73), W64LIT(0xf0b7cdd7420a7d99), W64LIT(0x9f81811dd14ef6ff), W64LIT(0x9f6055f42efd333f),
+	W64LIT(0x176b327502bbfa16), W64LIT(0x74afac95e660db7b), W64LIT(0xfc3aaadc35e52230), W64LIT(0x56b12786f38d8b66),
+	W64LIT(0xa9cee89d1ab60133), W64LIT(0x4fd6a42c063be48a), W64LIT(0x8640476a0531becb), W64LIT(0x9b422c392c1d872e),
+	W64LIT(0x1b0f2f2ead55b09d), W64LIT(0x3c647464c7421acf), W64LIT(0xf0b66cffc1be896c), W64LIT(0x54c3d48f6acb2de8),
+	W64LIT(0xa5286a86bc60efb9), W64LIT(0x520e0cfd9770619f), W64LIT(0xa03320be8ded4844), W64LIT(0x5598c600f2bc3b04),
+	W64LIT(0xd61b2c2125cf6d1f), W64LIT(0xc213fae1a6b5cde4), W64LIT(0xa6d2b7995befb7a6), W64LIT(0x8c7dd2a8daaccc47),
+	W64LIT(0x54c36dd923f06000), W64LIT(0xba295c0f820e947a), W64LIT(0xa68d6e1827326ba1), W64LIT(0x17d94f7f04534d9c),
+	W64LIT(0xfee6c3647d9c6633), W64LIT(0x834d7e43db11c981), W64LIT(0xa8e44a845f947acc), W64LIT(0xa54349007be2e451),
+	W64LIT(0xc84f905219304429), W64LIT(0x74789607a77008fb), W64LIT(0x33630c3397dfb696), W64LIT(0x3ad5a630d79c4351),
+	W64LIT(0x434ec871db331caf), W64LIT(0x9296df473d8fa45a), W64LIT(0x5316ba0e236ce2b5), W64LIT(0x2963a31cdb41877a),
+	W64LIT(0x73c25a9034d4429d), W64LIT(0x746f250d5b7af9c1), W64LIT(0xfeb1d87856df74d8), W64LIT(0x5ecdebfc54f4c312),
+	W64LIT(0x8d71d1a451b76887), W64LIT(0x0d04ea1c376bbd93), W64LIT(0xe2edabd9f3115027), W64LIT(0x0a9770893030bf38),
+	W64LIT(0x6ec6b7146e578db1), W64LIT(0xba0f7c82dc7dcd81), W64LIT(0xb4a115db80dda0b3), W64LIT(0x9d3b6e0778d4ce0e),
+	W64LIT(0xa7be13789b538e1f), W64LIT(0xf0783174b8e633dd), W64LIT(0x5a170030a2b3bc84), W64LIT(0xa73553e47df52e50),
+	W64LIT(0x245d3e5d3fb719ef), W64LIT(0xcb620642478627fd), W64LIT(0xc535423ff201f3ed), W64LIT(0x567dbd22f34ae39e),
+	W64LIT(0x0b45a55793a7d1ee), W64LIT(0x83234d65123aac85), W64LIT(0x90cb0fdda3a04b76), W64LIT(0x1b79f7b90c7bcdb7),
+	W64LIT(0xe0af09982228cf1e), W64LIT(0xd5a8ad5f45aef6ba), W64LIT(0x8e1582751aaa66cf), W64LIT(0x06d5e39871edcfe1),
+	W64LIT(0xfeffb1dfa895578e), W64LIT(0x92fceebe9e875f78), W64LIT(0x8feac39f40f7dd3f), W64LIT(0x6f22090c897e252c),
+	W64LIT(0x0d86d99b6f4687dd), W64LIT(0x0169a7e3c7c71d7c), W64LIT(0x6d70931c3d1e464e), W64LIT(0x406bf62ef189bb97),
+	W64LIT(0xe6d8bc270c735baa), W64LIT(0x351a864f04c128fa), W64LIT(0xd6f6e2274ba08fc8), W64LIT(0x1a8c5c1ef02a53cd),
+	W64LIT(0xc16149ffc61cd7fb), W64LIT(0x8de9b7b4e5c0be88), W64LIT(0xfda32a2bd16034fd), W64LIT(0x18b1606d91236def),
+	W64LIT(0x856ea4eab1cfcdca), W64LIT(0xcd2e976ca6e4d689), W64LIT(0xe0663842fd0685e6), W64LIT(0x46c6c666862359b2),
+	W64LIT(0xadafc96e403641fc), W64LIT(0x07121f263375047f), W64LIT(0xb1f1066fadc50504), W64LIT(0x6e15dc2f99f8a047),
+	W64LIT(0xbf9569f79f3bdafa), W64LIT(0xb8a025da944a5acf), W64LIT(0xd5de331e9d579250), W64LIT(0x27fa2d8808477d6a),
+	W64LIT(0x8ea6793296c7acd5), W64LIT(0x847b4a0197c2bf2b), W64LIT(0x798dbed49725152f), W64LIT(0x193760aacfad4af0),
+	W64LIT(0x9786fd3572ce8a27), W64LIT(0x5cdaab8480a4f0d9), W64LIT(0x01d912a96c327b7a), W64LIT(0x601595da3040b54b),
+	W64LIT(0x1e9c8177ae268f0a), W64LIT(0x9130ead102df9c31), W64LIT(0x2c80dff6e18e61bc), W64LIT(0xa6a197d09ddb6014),
+	W64LIT(0x30841a596cd2f9e9), W64LIT(0xc970bed990a052cd), W64LIT(0xfd6c51343e98ca6f), W64LIT(0x27a8a9e940caa27a),
+	W64LIT(0x9e57b84ceb308555), W64LIT(0xf8e34b0b510d5943), W64LIT(0xaef9d2e38a99f157), W64LIT(0x81ba78ef2a73c04f),
+};
+
+static const word64 s_brainpoolP384r1Curve[] = {
+	W64LIT(0x874700133107ec53), W64LIT(0xacd3a729901d1a71), W64LIT(0x12b1da197fb71123), W64LIT(0x152f7109ed5456b4),
+	W64LIT(0x0f5d6f7e50e641df), W64LIT(0x8cb91e82a3386d28),
+	W64LIT(0x04a8c7dd22ce2826), W64LIT(0x8aa5814a503ad4eb), W64LIT(0x139165efba91f90f), W64LIT(0xc2bea28e4fb22787),
+	W64LIT(0x3c72080ace05afa0), W64LIT(0x7bc382c63d8c150c),
+	W64LIT(0x3ab78696fa504c11), W64LIT(0x7cb4390295dbc994), W64LIT(0x2e880ea53eeb62d5), W64LIT(0x2fb77de107dcd2a6),
+	W64LIT(0x8b39b55416f0447c), W64LIT(0x04a8c7dd22ce2826),
+	W64LIT(0xef87b2e247d4af1e), W64LIT(0xe826e03436d646aa), W64LIT(0xdb7fcafe0cbd10e8), W64LIT(0x8847a3e77ef14fe3),
+	W64LIT(0xa2a63a81b7c13f6b), W64LIT(0x1d1c64f068cf45ff),
+	W64LIT(0x42820341263c5315), W64LIT(0x0e46462177918111), W64LIT(0xe19c054ff9912928), W64LIT(0x62b70b29feec5864),
+	W64LIT(0x5cb1eb8e95cfd552), W64LIT(0x8abe1d7520f9c2a4),
+	W64LIT(0x3b883202e9046565), W64LIT(0xcf3ab6af6b7fc310), W64LIT(0x1f166e6cac0425a7), W64LIT(0x152f7109ed5456b3),
+	W64LIT(0x0f5d6f7e50e641df), W64LIT(0x8cb91e82a3386d28),
+};
+
+static const word64 s_brainpoolP384r1Points[] = {
+	W64LIT(0xef87b2e247d4af1e), W64LIT(0xe826e03436d646aa), W64LIT(0xdb7fcafe0cbd10e8), W64LIT(0x8847a3e77ef14fe3),
+	W64LIT(0xa2a63a81b7c13f6b), W64LIT(0x1d1c64f068cf45ff),
+	W64LIT(0x42820341263c5315), W64LIT(0x0e46462177918111), W64LIT(0xe19c054ff9912928), W64LIT(0x62b70b29feec5864),
+	W64LIT(0x5cb1eb8e95cfd552), W64LIT(0x8abe1d7520f9c2a4),
+	W64LIT(0x68d4d148ee8a2912), W64LIT(0x9cc7f9e1e3f9b053), W64LIT(0x64f33bed97d48026), W64LIT(0x5c49cc799a3b7efc),
+	W64LIT(0x1e356a94d07a1f2c), W64LIT(0x1d6cf452e0a84305),
+	W64LIT(0x81f9d9af5963d9b7), W64LIT(0xc6e36151601d06ba), W64LIT(0x9c4e60bcf1273218), W64LIT(0xad4895f0d3d256a2),
+	W64LIT(0x402a557301b40e41), W64LIT(0x08daf99a86754e5a),
+	W64LIT(0xd93b7a98c89442aa), W64LIT(0x2865213299ae9a5f), W64LIT(0xc0f1b172b5fa6406), W64LIT(0xbab9fafee6f9f399),
+	W64LIT(0x8f18e570303c9a5e), W64LIT(0x35b7396b34487f4f),
+	W64LIT(0x72a55edd1439fc89), W64LIT(0x1bcf80035c67a101), W64LIT(0xf4cf7a8925978a9d), W64LIT(0xe67e761120dbe303),
+	W64LIT(0x9da07be34fc7bf97), W64LIT(0x21caf7e75d7a3764),
+	W64LIT(0x668e076b1a889300), W64LIT(0x9f99bd1c22aeebc3), W64LIT(0x1e82d7373d442057), W64LIT(0x69f8fa9364ffa570),
+	W64LIT(0xd7c78a0c6aed1b09), W64LIT(0x01033403331b32f7),
+	W64LIT(0x7a9897fb863b17c6), W64LIT(0xaa3e68cbafa5792e), W64LIT(0x470d3ea12f9ba3f5), W64LIT(0xc98a6c99da09aca3),
+	W64LIT(0x4ac5762039aa3cb2), W64LIT(0x526601584116d3f2),
+	W64LIT(0xe386124ac0df349b), W64LIT(0xdddca44869c164ae), W64LIT(0x0dc99a6cbdefb32e), W64LIT(0xd7d8f7502abb0fa1),
+	W64LIT(0xdf277f25e11f5cf7), W64LIT(0x46bb86c17d1be2b5),
+	W64LIT(0xb84b02114aa0cd58), W64LIT(0x381364deb1f0d01f), W64LIT(0x508ebada0f75d1be), W64LIT(0x0f81b2bac32ab93a),
+	W64LIT(0xc5131637b69b5c92), W64LIT(0x25a635a5417a4a3c),
+	W64LIT(0xa9e7a469fa8d772e), W64LIT(0xc8e4b740f7dd1de3), W64LIT(0x1c31436d3cf8cf5a), W64LIT(0x8d35216c6e853090),
+	W64LIT(0x3ab153f042b4223f), W64LIT(0x7c0eee5817c5fd3e),
+	W64LIT(0x036bce409b4abf1d), W64LIT(0xb1550ed89fa95c58), W64LIT(0x9a327f800bcae2f7), W64LIT(0x84f170df974a4af7),
+	W64LIT(0xf355f334881cca8b), W64LIT(0x77765f3718cca4b2),
+	W64LIT(0x5757dfe25364fbc4), W64LIT(0x31ba70228243c727), W64LIT(0xf9dac68bee980116), W64LIT(0x2b72a5d0d8a55b26),
+	W64LIT(0x6c2d25c72feeda20), W64LIT(0x5fa77399d4c9eb93),
+	W64LIT(0xbfc370fc58079726), W64LIT(0x8d3e906768584983), W64LIT(0xf7842b021035e7f4), W64LIT(0xfc06b095260b3623),
+	W64LIT(0xe626f06d8d0f53a2), W64LIT(0x2dd8c87d9e9424e0),
+	W64LIT(0x65b44c91f1e4016a), W64LIT(0x2fe48ddddc49770a), W64LIT(0x0e5711d869cb2726), W64LIT(0x9b8e94f7af20c4f7),
+	W64LIT(0x5634ae5c6cb61b10), W64LIT(0x66ef52464e585637),
+	W64LIT(0x0d5904d1309b4b51), W64LIT(0xaa3639bd22c9b4e3), W64LIT(0x0fe6239f02c1fcc3), W64LIT(0xe23b29d4fc958f3f),
+	W64LIT(0x64931fa67e8c7194), W64LIT(0x20cbbb1c4055a3d2),
+	W64LIT(0x3825e48f8da8cf3c), W64LIT(0x24f873412e1638c9), W64LIT(0xdc7c7233d2ab1fc2), W64LIT(0xff03c73f57555177),
+	W64LIT(0xbd5f32087ba99ad0), W64LIT(0x4c71021326aad8a6),
+	W64LIT(0x88c549bece296895), W64LIT(0x201196006ef713e2), W64LIT(0xfa195be172d1e764), W64LIT(0x9f91e704fe362218),
+	W64LIT(0xefcd18b194f4e916), W64LIT(0x6cb93dd8245a3ffa),
+	W64LIT(0x2fbb7a0b2ccdd218), W64LIT(0x01b8261f34485169), W64LIT(0xe94536474aa71035), W64LIT(0x372ab3c4e2d5a968),
+	W64LIT(0x6240f80a662e6f79), W64LIT(0x44bfe3b331319df8),
+	W64LIT(0x1aaec1cd637a8289), W64LIT(0x0d2978be2800db88), W64LIT(0xfd1aa52a53852de7), W64LIT(0x609a5b6e55d95850),
+	W64LIT(0xce9d019ab05ad229), W64LIT(0x7f4be2470ae0fa8c),
+	W64LIT(0x44e66be8553a94df), W64LIT(0xf277d40eb42f36a9), W64LIT(0x6fef0d17df3db652), W64LIT(0xd1d46ae9150e649a),
+	W64LIT(0xe8f316efff2ac0b9), W64LIT(0x1005d8363aeef83e),
+	W64LIT(0x49354ef1c0c1d849), W64LIT(0x05225a63d1633bd7), W64LIT(0xcea6f88d52d68678), W64LIT(0x3cb473e99da152ef),
+	W64LIT(0x0aa0af1c13626680), W64LIT(0x0b19d4006fc792d8),
+	W64LIT(0xa356d49b3abb9ed5), W64LIT(0x0811728440dc40f0), W64LIT(0xaeb7a5b6b3d7e089), W64LIT(0xb572c0e89316522b),
+	W64LIT(0xc0378de9cae46a61), W64LIT(0x18ccaa055c3bc3da),
+	W64LIT(0x03efa65bc5097ac5), W64LIT(0x8e4dea34561d6c92), W64LIT(0x74880dc24928adc4), W64LIT(0x24c796f468e92bb3),
+	W64LIT(0x5f53296ce3162e5c), W64LIT(0x33039e5a1a83aebb),
+	W64LIT(0x06b25f3f9450330d), W64LIT(0x34060d72099b798d), W64LIT(0x7a06c161f9f77618), W64LIT(0x7a860d11ab7741e0),
+	W64LIT(0x7d07d933140cb749), W64LIT(0x1bf6224e4daadbe0),
+	W64LIT(0x5110760e2d845987), W64LIT(0x972ed6cd06c84780), W64LIT(0xfea15fd9a26eb643), W64LIT(0x1548f917853447fe),
+	W64LIT(0xbca90f15bb7514e0), W64LIT(0x69e274ae9059fdd5),
+	W64LIT(0x6b5eb8bdcaf633a4), W64LIT(0x82d0ce3ebf7d73da), W64LIT(0x2ebb003d70ce0585), W64LIT(0x0518d2a4597cefb4),
+	W64LIT(0xf03aa86a075a2dd0), W64LIT(0x7d3b5e7115976763),
+	W64LIT(0x3c4b1def481aaf9a), W64LIT(0xf084b3dfa173f4b5), W64LIT(0xae7c3f6f0677953e), W64LIT(0x29a404238a76654b),
+	W64LIT(0xc82e5c625e4cdd3c), W64LIT(0x5355b437829de08d),
+	W64LIT(0x6db768145c124143), W64LIT(0xec2d16b537699830), W64LIT(0x3c41b577258f01bf), W64LIT(0x54613aa57076b8aa),
+	W64LIT(0x0387803ffcae1360), W64LIT(0x646c793597790928),
+	W64LIT(0xc2b825d864e9da9e), W64LIT(0x7ae1595ec51993db), W64LIT(0x2edcb3a7061aabdb), W64LIT(0x1e53c1c6e4d89f76),
+	W64LIT(0xaae6b61c90d38852), W64LIT(0x8b7b1d7b827d23a9),
+	W64LIT(0xa1434ef96e3f7b81), W64LIT(0x6977eb3f6c7dde1e), W64LIT(0x28033f1da1fc55a9), W64LIT(0xf02136486ebe8852),
+	W64LIT(0x5aa680e7e026a988), W64LIT(0x519aad48064a6c1d),
+	W64LIT(0xb4439b13a202b8b4), W64LIT(0x664c5579f68de790), W64LIT(0x66ef2ad3bca6808b), W64LIT(0x52c1fe4b58e815e5),
+	W64LIT(0x263c613b8c8cee1e), W64LIT(0x5a29417bf92ae662),
+	W64LIT(0x1f71456a2723cc3e), W64LIT(0x6d7b471fde9441d0), W64LIT(0x78e80ed4d7d0c264), W64LIT(0xd1f0f24642878876),
+	W64LIT(0x5b7c117b0bc7810c), W64LIT(0x78852e780a76d41a),
+	W64LIT(0xbec64002433ba480), W64LIT(0xa07c26c0076ac972), W64LIT(0x2f779aed32f25862), W64LIT(0xbe170c7166ac1174),
+	W64LIT(0x913a4671da86b11e), W64LIT(0x7f5ffff3539b8dce),
+	W64LIT(0x12fba428851d9309), W64LIT(0xeea16832686adc91), W64LIT(0x65e0640476c69fd9), W64LIT(0xa15ca93f0fef4e67),
+	W64LIT(0xb4411ac02a3bd57d), W64LIT(0x1900af61affc5181),
+	W64LIT(0x1d12756a719c381a), W64LIT(0x138883522ff1d6ab), W64LIT(0x3d7ef70418963f7b), W64LIT(0xce9119a122fb15ea),
+	W64LIT(0x5ff3d6224bca6895), W64LIT(0x1641d8ec0cdee382),
+	W64LIT(0xca8444bbcab7ea36), W64LIT(0x91f824281284f21b), W64LIT(0xd5a901bbc0cb7232), W64LIT(0x0265998804272552),
+	W64LIT(0xc5ec5e25ab9faaf4), W64LIT(0x0fa53b0e270acca6),
+	W64LIT(0xbefa776266eae0a8), W64LIT(0x4bb49f099465916a), W64LIT(0xdaca0b4c15573f41), W64LIT(0x515b649ce61cb830),
+	W64LIT(0x0b130eb8e5fd0229), W64LIT(0x155e8d77c7a29a33),
+	W64LIT(0x3ddff07f8a15b75a), W64LIT(0x12ea27e03500ec98), W64LIT(0x2fb022fc696df98a), W64LIT(0x99fc3690cc55cf4b),
+	W64LIT(0xb549b644cf0f5cc4), W64LIT(0x8471b0046e1a1fba),
+	W64LIT(0xb2abecf7a8f6ac72), W64LIT(0x2544edc93bdde670), W64LIT(0x09ce5a2f6a8fee44), W64LIT(0x6d3cfc1133b3a584),
+	W64LIT(0x191544883866e083), W64LIT(0x63ed96025aee1a77),
+	W64LIT(0x358914cd37f34c83), W64LIT(0xb92850eec8c22f35), W64LIT(0xbd512f5def462ce2), W64LIT(0xdcaf81679968224b),
+	W64LIT(0x68a84372861f9ad3), W64LIT(0x1903cfd459bb0893),
+	W64LIT(0xdc9961025e2bff72), W64LIT(0x0d610ad7837bf6be), W64LIT(0x25d887df6d87bdf3), W64LIT(0xd7409c9741bcf625),
+	W64LIT(0x24e524511eb0a5d1), W64LIT(0x585f67ef7bd6f6e9),
+	W64LIT(0x1e4d3e1afe3aa42a), W64LIT(0xdfda04ff36e556e2), W64LIT(0x2e9db2d7394111c8), W64LIT(0x127fd1a63fb843c4),
+	W64LIT(0x20a292c630bd35e6), W64LIT(0x7931b2d02d6ae23d),
+	W64LIT(0x8dca539bea37cc48), W64LIT(0xa7ae087ea9ca6273), W64LIT(0x3d8f34bcdd4746b0), W64LIT(0xfdaad29616549f81),
+	W64LIT(0x47d83d8b0d066a04), W64LIT(0x14e72da65fb059ef),
+	W64LIT(0xdbbe994f6b0104f3), W64LIT(0x82a5fb37d568603d), W64LIT(0x9640e7c7d993655f), W64LIT(0x6f4d5304d33f787c),
+	W64LIT(0x759cdc55a7fc3050), W64LIT(0x60c9aa232461b578),
+	W64LIT(0x3984e0b4b52658a2), W64LIT(0xc1452737a09cd5af), W64LIT(0x68301e765faf8e51), W64LIT(0xe1859abe1179fb03),
+	W64LIT(0xa1b3501fe7406821), W64LIT(0x4b4704eb4c34de01),
+	W64LIT(0x49b1f39c79812876), W64LIT(0xbb5389c9e431d1f7), W64LIT(0x4aa53080c5338b25), W64LIT(0x5cb7c186d2a761c7),
+	W64LIT(0x8c0fc304edbfdd5c), W64LIT(0x2110c3ff13f6d19d),
+	W64LIT(0xaab68b75a78c3577), W64LIT(0x3365a4c379174d97), W64LIT(0x923d6c3b24894766), W64LIT(0xbd7af1aeb4f8a882),
+	W64LIT(0xfdcad464403c7bd9), W64LIT(0x8233012905feed2a),
+	W64LIT(0x7864afdfcc184495), W64LIT(0xfd7c202893c44edc), W64LIT(0x93ad3d94971a9685), W64LIT(0x8fc6b94a215afe1d),
+	W64LIT(0x64dd91761ed6bce8), W64LIT(0x463420b3d6fac6e2),
+	W64LIT(0x3adb128c406b5622), W64LIT(0xa8f5d0e8eb03880a), W64LIT(0x9f5b8d4cde848adc), W64LIT(0x0628b1f6ce815e8a),
+	W64LIT(0xb784e71821838020), W64LIT(0x67ebe0af6be134a4),
+	W64LIT(0x30b27ce1b679afe5), W64LIT(0xf01e0a69aa682120), W64LIT(0xd86af191fdd1ef79), W64LIT(0x909f6e6ff6478ee1),
+	W64LIT(0x50d91dffa29777a4), W64LIT(0x2032961fee4d86b2),
+	W64LIT(0x1e3022eb2adf0ffa), W64LIT(0x57f7ad871b5a47a6), W64LIT(0x0ee98f4d85032eb3), W64LIT(0xde33e8a03234db8e),
+	W64LIT(0x50fb252db17a2ef1), W64LIT(0x208e716971ae5a02),
+	W64LIT(0x450a58ab9af8e08e), W64LIT(0x1461448ae01e46e6), W64LIT(0x8591817d99bc6beb), W64LIT(0xbf2f3d88c38157f6),
+	W64LIT(0xa0f163708abbc3e9), W64LIT(0x077889e6c84d49b6),
+	W64LIT(0x349d0ac9e07bbba2), W64LIT(0x86cf6c32d75c80f2), W64LIT(0x5115de7369af24e2), W64LIT(0x88dd56d116420888),
+	W64LIT(0x0380d2de42fef153), W64LIT(0x8090594b80895345),
+	W64LIT(0xe4c5bb2d119bb242), W64LIT(0xd77cf1fae34187bb), W64LIT(0xffa2cb46b7f2a810), W64LIT(0x5ea34be9d16f6628),
+	W64LIT(0xfb2cad0ec245e31d), W64LIT(0x18dbddc18051817c),
+	W64LIT(0x155ea9ea0dc2e094), W64LIT(0xacd0b917f404f730), W64LIT(0x3eaae4cfeed2dc95), W64LIT(0x4f73ee1b6401cfc4),
+	W64LIT(0xb9521b2b922e5870), W64LIT(0x747bb59e3dd6a0ec),
+	W64LIT(0x16c5a341435cc926), W64LIT(0x00c6f4948cce07e9), W64LIT(0x75a141258fd71da3), W64LIT(0x9e7896f26ffcbb6e),
+	W64LIT(0x59610ac3da13d66b), W64LIT(0x7b604c60b81a3676),
+	W64LIT(0x00eb7927206ce284), W64LIT(0xd3c058a6d9a3a80c), W64LIT(0xb7adaf49c223d82a), W64LIT(0xd3a2670022ee1670),
+	W64LIT(0x73416ef731598ecd), W64LIT(0x10999730fd6aef4e),
+	W64LIT(0xc4eaa175e9ac96e8), W64LIT(0xbc31c81d0f8f0315), W64LIT(0x178af38c3b14c664), W64LIT(0x02a1f462ac3a78bc),
+	W64LIT(0x9485e8d1babcc696), W64LIT(0x79e2478b6082e6bd),
+	W64LIT(0x9436b7a6ee823737), W64LIT(0x0e664a7cce2a3984), W64LIT(0x06badad2b1e11880), W64LIT(0xae8dcb2b4e19c518),
+	W64LIT(0x9601a5acd15e4fbc), W64LIT(0x878ea3e59ba7f9e7),
+	W64LIT(0x0c4937496caea3d9), W64LIT(0x6d0f61d98c39c48e), W64LIT(0x6470ca84af0e1908), W64LIT(0x19f1d92c5ad33b21),
+	W64LIT(0x5252b3a7bfd688ad), W64LIT(0x74e2011ac8a3f190),
+	W64LIT(0x9547162ff4951aba), W64LIT(0xee09fa2a7db2f473), W64LIT(0x1bbb6764c18a63a1), W64LIT(0xf381c15e91c81b14),
+	W64LIT(0xac297ead0f21cc05), W64LIT(0x63b1f18050556d10),
+	W64LIT(0xca2a6b90016076b6), W64LIT(0xaadaf852f2c325e3), W64LIT(0x695821e460c9dfc8), W64LIT(0x7286e19266a17cbb),
+	W64LIT(0xe63667eba609dc58), W64LIT(0x3f34f90fca7310b1),
+	W64LIT(0xc7b1fb5f33a2f662), W64LIT(0x424fd66ce3d52e90), W64LIT(0x80a361ba0ad866e6), W64LIT(0x80c9b4a1a2bb7532),
+	W64LIT(0x7b6a4211a6413210), W64LIT(0x57aac92a2e0d1326),
+	W64LIT(0x4860c5d255a91ef1), W64LIT(0x8841e482971f0cce), W64LIT(0x76689b68b4ab7d55), W64LIT(0x53385fa73987fe4a),
+	W64LIT(0xe75a6545e3022c04), W64LIT(0x6c5365a51bf17ac6),
+	W64LIT(0x01831262aa918e1a), W64LIT(0x635683c62bdc96a5), W64LIT(0xa91eb8b901d11d03), W64LIT(0xff4bdf99c8250d0f),
+	W64LIT(0xae3e8f30fd29a52d), W64LIT(0x1d48013732ef384c),
+	W64LIT(0x01ba4da845c9e8b4), W64LIT(0xdfb7e3052d1c3375), W64LIT(0x4d52023359d65708), W64LIT(0x6e71a856aef3aa73),
+	W64LIT(0xd6eb6b95a091737d), W64LIT(0x22b1ca8eef778fd6),
+	W64LIT(0x2012dab796a4f32c), W64LIT(0xd0385cd93dd58191), W64LIT(0x16843b46d8dc4f89), W64LIT(0x9b86b60f2adaae79),
+	W64LIT(0x6fc935173543f4f1), W64LIT(0x20697466e8ba1c0b),
+	W64LIT(0xa8e33aa9150bb436), W64LIT(0x655cfc6851f24fcd), W64LIT(0xc4e31b9a29ad84d3), W64LIT(0x29b3583fe49c16f2),
+	W64LIT(0xdf41799afc0f5352), W64LIT(0x5e83a75325440195),
+	W64LIT(0x0268875615395400), W64LIT(0x7d183f28ad5f2209), W64LIT(0x9a20a1fe8a30ea9f), W64LIT(0xf5bbdfb624626921),
+	W64LIT(0x98f89c829919b434), W64LIT(0x17e34152f91ffea1),
+	W64LIT(0x088ec0343b406b9e), W64LIT(0xfff84d8f99e4065b), W64LIT(0xfce2436b94dd267d), W64LIT(0x42406c12f8fb0070),
+	W64LIT(0xc2c8c08e430f047d), W64LIT(0x2627dc9fccdcffae),
+	W64LIT(0xfa1c9cdd597d994c), W64LIT(0x3e1f6579aa063e5e), W64LIT(0x366b2ec7fd6e5c11), W64LIT(0x80d1fff8ca9b219e),
+	W64LIT(0xec5af6789e95ebc5), W64LIT(0x83f85358930d2733),
+	W64LIT(0xd86ac7305f7c599e), W64LIT(0xb3f7d54c20f43f65), W64LIT(0x9249b5d56179bca0), W64LIT(0xcfd6d5b9ffe61f8e),
+	W64LIT(0x197441a0ea49df7e), W64LIT(0x547a170ee92b6b81),
+	W64LIT(0x30b9ab4bf25b70e9), W64LIT(0x0c428c18e26d809a), W64LIT(0x62ca2ffd5ed2fea5), W64LIT(0x803197fbf25141e0),
+	W64LIT(0xe1cb1babb249b176), W64LIT(0x2b0f2b4f97457703),
+	W64LIT(0x160e1eae725351cb), W64LIT(0x8e1b7da0507bd8a1), W64LIT(0xdc3c5bb02efeac6f), W64LIT(0x581e6c563c039177),
+	W64LIT(0x5dbb5c6e70ce1a4f), W64LIT(0x8050fe229e22aedf),
+	W64LIT(0xe9f57fe39908f1b0), W64LIT(0xe1dba331c937ad82), W64LIT(0x635951a7fbce1831), W64LIT(0xbe6c92493e18ac60),
+	W64LIT(0xe8a87b33f40b6987), W64LIT(0x7782ad9d1d0f619f),
+	W64LIT(0xbb3bddba0ea4e2c0), W64LIT(0xef4a19d00d59053f), W64LIT(0xa750a2b91476deb8), W64LIT(0x329034d39b884634),
+	W64LIT(0x77027cf3c3b95018), W64LIT(0x7d7511cce22bbf38),
+	W64LIT(0x8bbecfab6030280a), W64LIT(0x5474ff3d5634f523), W64LIT(0x3b350768899bff41), W64LIT(0x6f0b83421b7764b4),
+	W64LIT(0x7c3e5398434d9d05), W64LIT(0x3ce7655c3d76aafa),
+	W64LIT(0x1fad52d8ef2d3e27), W64LIT(0x16a5decce1588a65), W64LIT(0x5968a06dac493372), W64LIT(0x7a817f386a42441b),
+	W64LIT(0xf985b6ca44081f9d), W64LIT(0x07571b261395f73d),
+	W64LIT(0x5d821614f4072264), W64LIT(0x602d6fe613e71d04), W64LIT(0x39e3b0284b2d6b5e), W64LIT(0xcf809d53be6c02e7),
+	W64LIT(0x706591bf6aa1fcae), W64LIT(0x06c739785b27c2f0),
+	W64LIT(0x80bdff1750138de8), W64LIT(0xb331decefd1526e7), W64LIT(0x7a0405e607036016), W64LIT(0xafb40c6890193b6b),
+	W64LIT(0x1c2f2137566c57a0), W64LIT(0x649eea9006b7c08a),
+	W64LIT(0x1cc07e22238bb3b4), W64LIT(0xf854e2e49663ed9f), W64LIT(0x64cc8eaf9a075d11), W64LIT(0x7e58537f07818efe),
+	W64LIT(0xf3af4a889735ac9c), W64LIT(0x19d621d766ec0212),
+	W64LIT(0x143d95877db55b58), W64LIT(0xba0b3c8ba2f69934), W64LIT(0x5700ae6fe867c5cf), W64LIT(0x3adf9837dfc26392),
+	W64LIT(0x2c420624cc350c23), W64LIT(0x83913f7e4db0329e),
+	W64LIT(0x049c4d365870927e), W64LIT(0xbe103c2b0ea2313b), W64LIT(0xb6b5c30ed01719c0), W64LIT(0x6c677bad9fd81bea),
+	W64LIT(0xbb815ee71d9a1046), W64LIT(0x178c279d48aa7a0e),
+	W64LIT(0x25f47f2c5861cf76), W64LIT(0x48b0ebc04ae564f4), W64LIT(0x5e029743184d0d66), W64LIT(0x6ef3cb9d5f35fb2b),
+	W64LIT(0xa9ff98993207cc6a), W64LIT(0x778296a205a2a276),
+	W64LIT(0xacfbb25480babf17), W64LIT(0x39d2fb319a8d8700), W64LIT(0xdcbda131f19c9fd3), W64LIT(0x074f2a3217a7a73a),
+	W64LIT(0xccc142e18d6ea0eb), W64LIT(0x658a413e67179188),
+	W64LIT(0xa868d6c0cfb729e2), W64LIT(0x0831f97ba9039c01), W64LIT(0x97aa410b0c910f67), W64LIT(0x8bde91b43a6997e4),
+	W64LIT(0x254d87e231a37c96), W64LIT(0x5b0de86c85b28248),
+	W64LIT(0x8346bf76ec3f6f64), W64LIT(0x1cacbc6ee2877bc5), W64LIT(0xa9adca7f6adbb380), W64LIT(0x23d176d3b61c0865),
+	W64LIT(0xe6e9d0b731c70eb0), W64LIT(0x68bbe695f48d1242),
+	W64LIT(0xdd4c7b61ffc9f0f4), W64LIT(0x03fcccf07c791f47), W64LIT(0xe9fa81ffa477a2d1), W64LIT(0x46d47c90224f366a),
+	W64LIT(0xcbbbdac60ba501e9), W64LIT(0x1dbb8aa1c6ad7d87),
+	W64LIT(0x9cc250a64f73d7b0), W64LIT(0xbfd4e885f765946f), W64LIT(0x614fa79c00a60ec2), W64LIT(0x482e980f5545a0aa),
+	W64LIT(0x1a68e9229a9d3728), W64LIT(0x88854aa2656f4ad2),
+	W64LIT(0x6efb3dd23a973064), W64LIT(0xce41fe9709f554df), W64LIT(0x5a5ede27070ee097), W64LIT(0x9f37fd2c891b5095),
+	W64LIT(0x5e4631a89b4dc99d), W64LIT(0x04803939526f2a8f),
+	W64LIT(0x18462954db5a8ed7), W64LIT(0x071560ad4b149e76), W64LIT(0x9131afa74cb46bff), W64LIT(0xe4504d3407356e7d),
+	W64LIT(0x9e27191e5e861b3d), W64LIT(0x7e7ff359509603a7),
+	W64LIT(0x5d2e47bf18d8d81a), W64LIT(0x7f5f2b25231332d4), W64LIT(0x3833a4423b3695d5), W64LIT(0x9e9d0487f1ef7616),
+	W64LIT(0x4faada7d7de755e7), W64LIT(0x4411423b3127b48f),
+	W64LIT(0x88a4529da32e45d1), W64LIT(0xca711ee2783b82f0), W64LIT(0xf6334001a78d93ed), W64LIT(0xd0162e22a3f104c9),
+	W64LIT(0xf1fc4abcb475ff30), W64LIT(0x5f5a19367938f782),
+	W64LIT(0x46fec84081fc8af2), W64LIT(0x7b9eb1e8fe180a2b), W64LIT(0x6075870c39bc146b), W64LIT(0x3c66ec4e19d960bd),
+	W64LIT(0x2be1b74bed54d872), W64LIT(0x59f7756960555bad),
+	W64LIT(0xda4e95374fb9659e), W64LIT(0xb8a988377fdaf9c9), W64LIT(0xd98b4aa2f4636bd1), W64LIT(0xed591edfa4642dfe),
+	W64LIT(0x7be05935060c460c), W64LIT(0x4fda3e5455c21730),
+	W64LIT(0x179528222d43a7f4), W64LIT(0x63ba3e3c5e2ea3e0), W64LIT(0x905fc9daffab00b0), W64LIT(0x6ab24e72d64fd87a),
+	W64LIT(0x35f12c8e845ee8dd), W64LIT(0x0d980a7fd08111c8),
+	W64LIT(0x1488ec5e06b4e98c), W64LIT(0xdfd3a030dff437a3), W64LIT(0x5c4071a9b34505f5), W64LIT(0x7454a794446ed55d),
+	W64LIT(0xc36ab271b6d1930a), W64LIT(0x8876af4c95a10cbe),
+	W64LIT(0xde3ae6b66d52595b), W64LIT(0xdb458baf8fa3f130), W64LIT(0x4b19f0dcbd3a0aeb), W64LIT(0x4cc127e173622532),
+	W64LIT(0x34e2569a2e86c7b1), W64LIT(0x01947470eae4bfd8),
+	W64LIT(0x6e472af36abff126), W64LIT(0x43baf37e0adb3965), W64LIT(0x2a1431c733333415), W64LIT(0xdfe492788ca12f08),
+	W64LIT(0xc74eb9f12caab7ba), W64LIT(0x7291f0764258ac56),
+	W64LIT(0xa095a942b330b454), W64LIT(0x787fe43aac9f3f6d), W64LIT(0x3013b693d367da29), W64LIT(0xe6a731590981fbda),
+	W64LIT(0xdae2b97f2d24f89a), W64LIT(0x3746816692748dfb),
+	W64LIT(0x1a3c069547be7353), W64LIT(0x21552fc259e2e09e), W64LIT(0x2f43b730628ed322), W64LIT(0x4a1dcea633fa5aa8),
+	W64LIT(0x0e54f84f55e2f40c), W64LIT(0x5ec178ec3a72c798),
+	W64LIT(0xa4802faedd8b6552), W64LIT(0xd0db1586b30cb9ca), W64LIT(0x4c203c3615840fc4), W64LIT(0x12544c13c69b4207),
+	W64LIT(0x623efdd41db5cbdd), W64LIT(0x56eaa4f3c6b86ea3),
+	W64LIT(0xc9785a033586004b), W64LIT(0x41767640d834dd91), W64LIT(0x111a1f804b9a8693), W64LIT(0xbe2d82f4763292e9),
+	W64LIT(0xf5aadf0f6a9631c1), W64LIT(0x43b9c9fc96f8c597),
+	W64LIT(0x912771b5920ea58f), W64LIT(0xc35609391035d431), W64LIT(0x0c260fd00ddd2773), W64LIT(0x5ca4e3855c9fbccd),
+	W64LIT(0x85a7ba628bb8a936), W64LIT(0x042ac2206c4af3c2),
+	W64LIT(0x269c91670423261c), W64LIT(0x82a01ebd3c89617a), W64LIT(0xb9ff0bf3787cf2bd), W64LIT(0xb3fed0a4115ce857),
+	W64LIT(0xafde977f6bdb7571), W64LIT(0x5dccca61e51301a4),
+	W64LIT(0x91af6f337c7b047a), W64LIT(0x71ab493b59cb31c7), W64LIT(0xfcdc6226087ce5bd), W64LIT(0x3b608070fd50fd06),
+	W64LIT(0xdbf630b9c1d4279d), W64LIT(0x4a43c9ebba3fa41f),
+	W64LIT(0xf9afe18f9e62f924), W64LIT(0xdb94a7589d45f2fd), W64LIT(0x7da66eb52d40bbae), W64LIT(0x3f6ad5189713b388),
+	W64LIT(0x09cfce283ff9d4fc), W64LIT(0x6659050124fd4d6b),
+	W64LIT(0xb2d44caff8096060), W64LIT(0x0624f85897fad4b8), W64LIT(0x8238ae9b896772da), W64LIT(0x54ef7f656d59d699),
+	W64LIT(0x494a3ee39e131028), W64LIT(0x10fcba121cc84694),
+	W64LIT(0x7f6378cae0153a9c), W64LIT(0x89ce6e12184e0f3e), W64LIT(0x1f12c104b41c3016), W64LIT(0x90f48fa3c6a6566d),
+	W64LIT(0x6e22345e1ab95ebd), W64LIT(0x548a870123e15027),
+	W64LIT(0xea42fb56b3535700), W64LIT(0x0921da030ea50406), W64LIT(0x14c2e5c125001823), W64LIT(0xa74e5c79cebe8644),
+	W64LIT(0x218fdaf28dc67947), W64LIT(0x424f04148395038b),
+	W64LIT(0x7d6b2d5b3ebeae6b), W64LIT(0x14463c6e84cf944d), W64LIT(0x4139ea49ed4e0d88), W64LIT(0x23eb032f51978413),
+	W64LIT(0x7985b712196670c9), W64LIT(0x29840d89c7e2deb7),
+	W64LIT(0xb054d5029f3bc9d2), W64LIT(0xde37ac07b7d282d5), W64LIT(0x411c72528e90ae11), W64LIT(0x7e89720773a6dc0a),
+	W64LIT(0x0e2f0daf55d0e567), W64LIT(0x52ca93a1ec06033e),
+	W64LIT(0x82720cabcfb97bb9), W64LIT(0x71a64cfa8d5c768d), W64LIT(0x5e7f57de19658a51), W64LIT(0x1d244e8f47630f94),
+	W64LIT(0x99486a874ef6a12a), W64LIT(0x3dc7bfb6318278dc),
+	W64LIT(0x5f4c778bd7f404cd), W64LIT(0x9bfc6c2620ea03db), W64LIT(0x93828a2f51f12e62), W64LIT(0xc7231a84499a364c),
+	W64LIT(0x2c098ad82558edbf), W64LIT(0x79b1a3570ada866f),
+	W64LIT(0x47a1b977f27f8a89), W64LIT(0x3e73b80934ef3881), W64LIT(0xeb913722b34fbd87), W64LIT(0x5f77af3671b7b136),
+	W64LIT(0x59b59a8cfaadf35e), W64LIT(0x7e523f11840a967b),
+	W64LIT(0xe56535d7314cc3f9), W64LIT(0xd5e075c5d5ffc95b), W64LIT(0x0a7c7a60d8c643f2), W64LIT(0x3ce0a5abb035842b),
+	W64LIT(0xa555e1a76a7f1175), W64LIT(0x7bb904686ff1cc71),
+	W64LIT(0x2e402aa1f7fc27c4), W64LIT(0xab79e1e2b01e0714), W64LIT(0x3f7f1f9f89112036), W64LIT(0xfbb999e0f5ea4096),
+	W64LIT(0x5ab0e692567dd305), W64LIT(0x35a770187f8235df),
+	W64LIT(0x99e44395866c9176), W64LIT(0xa1b263f1fe9bbbe4), W64LIT(0x0242574245137ecd), W64LIT(0x671f133361733857),
+	W64LIT(0x2b188792bd22f64f), W64LIT(0x1e50641ac135344b),
+	W64LIT(0x9044f78481c1bf92), W64LIT(0xb732d29cfc483117), W64LIT(0xcc2b353a2d2882cc), W64LIT(0xebfbafeb5ea37511),
+	W64LIT(0x27e0b605e02f6682), W64LIT(0x237fb5757cea4a8f),
+	W64LIT(0xb7c2e3344f82bf5b), W64LIT(0xd79d71e5bba3992b), W64LIT(0xe7bbde84dd389724), W64LIT(0xc614367a33fb6ab2),
+	W64LIT(0xfb187d30b99004ae), W64LIT(0x4920dc4dc842d350),
+	W64LIT(0x82359e27279e31d6), W64LIT(0x6266ef973d456f02), W64LIT(0x5d449faed8741da6), W64LIT(0x02cf6225c556cd47),
+	W64LIT(0x3590e6adcbf46f4d), W64LIT(0x126e084253716dd8),
+	W64LIT(0x0905e5f4ee896807), W64LIT(0x346113a129e1c81b), W64LIT(0x7f770ff40e52181e), W64LIT(0xe0bfb8033d5a6a68),
+	W64LIT(0xd98b3047b2381ebc), W64LIT(0x8aba6f134cb5f5c6),
+	W64LIT(0x10ab030ffb9bad0b), W64LIT(0x0a56236c96e62353), W64LIT(0xc1cb4d88c68f1372), W64LIT(0x5730af0ea52063da),
+	W64LIT(0x8ff7daa1d6f113b1), W64LIT(0x0f48dd0fe3ba404b),
+};
+
+static const word64 s_brainpoolP512r1Curve[] = {
+	W64LIT(0x28aa6056583a48f3), W64LIT(0x2881ff2f2d82c685), W64LIT(0xaecda12ae6a380e6), W64LIT(0x7d4d9b009bc66842),
+	W64LIT(0xd6639cca70330871), W64LIT(0xcb308db3b3c9d20e), W64LIT(0x3fd4e6ae33c9fc07), W64LIT(0xaadd9db8dbe9c48b),
+	W64LIT(0xe7c1ac4d77fc94ca), W64LIT(0x7f1117a72bf2c7b9), W64LIT(0x0a2ef1c98b9ac8b5), W64LIT(0x2ded5d5aa8253aa1),
+	W64LIT(0xa83441caea9863bc), W64LIT(0x94cbdd8d3df91610), W64LIT(0xe2327145ac234cc5), W64LIT(0x7830a3318b603b89),
+	W64LIT(0x2809bd638016f723), W64LIT(0x984050b75ebae5dd), W64LIT(0x77fc94cadc083e67), W64LIT(0x2bf2c7b9e7c1ac4d),
+	W64LIT(0x8b9ac8b57f1117a7), W64LIT(0xa8253aa10a2ef1c9), W64LIT(0xea9863bc2ded5d5a), W64LIT(0x3df91610a83441ca),
+	W64LIT(0x8b352209bcb9f822), W64LIT(0x7c6d5047406a5e68), W64LIT(0x50d1687b93b97d5f), W64LIT(0xff3b1f78e2d0d48d),
+	W64LIT(0xb43b62eef4d0098e), W64LIT(0x85ed9f70b5d916c1), W64LIT(0x5a21322e9c4c6a93), W64LIT(0x81aee4bdd82ed964),
+	W64LIT(0x78cd1e0f3ad80892), W64LIT(0xd1ca2b2fa8f05406), W64LIT(0x5bca4bd88a2763ae), W64LIT(0xb2dcde494a5f485e),
+	W64LIT(0xa000c55b881f8111), W64LIT(0xf209f70024a57b1a), W64LIT(0xc0eabfa9cf7822fd), W64LIT(0x7dde385d566332ec),
+	W64LIT(0xb58796829ca90069), W64LIT(0x1db1d381085ddadd), W64LIT(0x418661197fac1047), W64LIT(0x553e5c414ca92619),
+	W64LIT(0xd6639cca70330870), W64LIT(0xcb308db3b3c9d20e), W64LIT(0x3fd4e6ae33c9fc07), W64LIT(0xaadd9db8dbe9c48b),
+};
+
+static const word64 s_brainpoolP512r1Points[] = {
+	W64LIT(0x8b352209bcb9f822), W64LIT(0x7c6d5047406a5e68), W64LIT(0x50d1687b93b97d5f), W64LIT(0xff3b1f78e2d0d48d),
+	W64LIT(0xb43b62eef4d0098e), W64LIT(0x85ed9f70b5d916c1), W64LIT(0x5a21322e9c4c6a93), W64LIT(0x81aee4bdd82ed964),
+	W64LIT(0x78cd1e0f3ad80892), W64LIT(0xd1ca2b2fa8f05406), W64LIT(0x5bca4bd88a2763ae), W64LIT(0xb2dcde494a5f485e),
+	W64LIT(0xa000c55b881f8111), W64LIT(0xf209f70024a57b1a), W64LIT(0xc0eabfa9cf7822fd), W64LIT(0x7dde385d566332ec),
+	W64LIT(0xe2a4c71875b8b844), W64LIT(0xcf43f1ad454ec668), W64LIT(0x3bed6b385416350b), W64LIT(0x176252fa18b24f98),
+	W64LIT(0x6e085397a7c2ce0b), W64LIT(0x241a88e484a59b5f), W64LIT(0x6479b0c83de34ec5), W64LIT(0x6a096c3bbcada0fd),
+	W64LIT(0x790976de560b6388), W64LIT(0x0e5611c90e60bcf1), W64LIT(0x9c117c7a0c58a298), W64LIT(0x81924d1aa7551785),
+	W64LIT(0xf6e2a0d7ffd05fe8), W64LIT(0x9e964b4fee6c1cb8), W64LIT(0xff2f05e38bbdd414), W64LIT(0x4b6bcc9c0b0300c9),
+	W64LIT(0x115ab44ffc4574e9), W64LIT(0xda0724c835c97ba1), W64LIT(0x25b9920646a91bbf), W64LIT(0x88cca355124c86ed),
+	W64LIT(0xf001a686499d108d), W64LIT(0xaa73bdbcd82dbae6), W64LIT(0x65339154dc91a0d5), W64LIT(0x7573ce80d174d143),
+	W64LIT(0x4ada391c847eba7a), W64LIT(0x15fe3184921326c6), W64LIT(0x3b3069fddc81efbc), W64LIT(0xe80a4f94bc530c51),
+	W64LIT(0x42adfdd8bb75e57d), W64LIT(0x82895fd3c2658587), W64LIT(0x6215ea1510801a69), W64LIT(0x67df24c7a009b47d),
+	W64LIT(0xcab7a7a9ecf3684f), W64LIT(0x81a84c6df5674083), W64LIT(0xec0083b2675ed9d1), W64LIT(0x22d5e07661528eec),
+	W64LIT(0x7e6a4db3f29b81ab), W64LIT(0xba3b5d9d00586acf), W64LIT(0xac05daf108f32631), W64LIT(0x4ab58c44b3547147),
+	W64LIT(0x5229f8ff7ded851b), W64LIT(0x75919d55ce0f2971), W64LIT(0xc3c08c19bce65862), W64LIT(0x8c8d8db173f540dc),
+	W64LIT(0xdb9e34dd3f1e4cad), W64LIT(0xee586b081b4224d8), W64LIT(0x9fdcc585cae4f524), W64LIT(0x8bcef468a5aadea6),
+	W64LIT(0x9fb64ab05e6601e6), W64LIT(0x851d01f9b4714dbb), W64LIT(0xd23145dac093b460), W64LIT(0x4986b41cc4084113),
+	W64LIT(0xd55ccd9371eead1e), W64LIT(0xb9f69ef491b81732), W64LIT(0x2017c9369484f2f3), W64LIT(0x924b7db3eb2a3bf1),
+	W64LIT(0xdf3b58c43b3c0c8a), W64LIT(0x9f350d25a2d21c0e), W64LIT(0xdd8232fa1f6a60ae), W64LIT(0x30b780613f38af2b),
+	W64LIT(0x0bfe679c8be44440), W64LIT(0xf572831a67743ab8), W64LIT(0x3472d61ce81fd4ad), W64LIT(0x59305e56c1bd0ab5),
+	W64LIT(0x5edd05d180a840b9), W64LIT(0x660f7036a0805039), W64LIT(0x37706598bd686032), W64LIT(0xf936e0c8019f6c2b),
+	W64LIT(0x244ab02f4d760953), W64LIT(0x76a7aaefa399d019), W64LIT(0x68bad1ae1e1152ce), W64LIT(0x21d19149f366069e),
+	W64LIT(0x5eb514c8386c77bd), W64LIT(0x5c0e60e18251f64d), W64LIT(0x970f7268a2e1f784), W64LIT(0xef7cbbe55fe22ef3),
+	W64LIT(0xe6055f6dbd5fe008), W64LIT(0x07ee114a0b9a8e27), W64LIT(0xdaad7f287ebeec3f), W64LIT(0x3653ea367c90a11f),
+	W64LIT(0x2664a39a61efae2e), W64LIT(0xd59d686337d9bbdc), W64LIT(0x8d33d0a3702db3e0), W64LIT(0x2c986a2639c3b545),
+	W64LIT(0xcac8c0ffd900692a), W64LIT(0xc9ec3c313fc0a74d), W64LIT(0x75bc60b2b484a3e6), W64LIT(0x6b5467de9da456d0),
+	W64LIT(0xeade13716d3b5f82), W64LIT(0x1e12d36c62c19d37), W64LIT(0x40a5c55f4d58d0a1), W64LIT(0xc1bf234c456f4d7f),
+	W64LIT(0xba490d380ef3c81f), W64LIT(0x2f182181dd341d38), W64LIT(0x8b9c8e89a7804992), W64LIT(0x084591a543882f3d),
+	W64LIT(0x1dd1507272045111), W64LIT(0x9ee62525f8ad206e), W64LIT(0xe213dd849cf873d7), W64LIT(0xaa89cc181ae9978d),
+	W64LIT(0x0267cf32decaf020), W64LIT(0x6fed86165fba8839), W64LIT(0xe129e2e455943cf1), W64LIT(0x0299b77aea02e82c),
+	W64LIT(0xf0b693ec8461ac93), W64LIT(0xabda0693654759fa), W64LIT(0x4ea827144139d233), W64LIT(0x0d87f1e79719809c),
+	W64LIT(0xad8c178d8d34a565), W64LIT(0x895cc678eb4a25a9), W64LIT(0xcbfba7215ae10bb9), W64LIT(0x955b6129e088eebb),
+	W64LIT(0x7850ea60ee2976f2), W64LIT(0x0f794fbc5b7be1de), W64LIT(0x2f17e9741c321c90), W64LIT(0x7c8e3c9954eac6ea),
+	W64LIT(0x0e17bfca5b5d6029), W64LIT(0x2cbcaecfb6028879), W64LIT(0x4c6cd5c05b2e6e42), W64LIT(0x9a3d84352b05108d),
+	W64LIT(0x06c41bcad5ade1cb), W64LIT(0x945a2e8a2fba4721), W64LIT(0xb12060bcbd1c9965), W64LIT(0x24c63cb8be4be6ce),
+	W64LIT(0xc20319079557e621), W64LIT(0x87c731eafc9ccc7f), W64LIT(0x88898da9b5535ad0), W64LIT(0x23d00d08a76f43bd),
+	W64LIT(0x228c1619f4ae57fe), W64LIT(0x05984954878cb3e8), W64LIT(0x89e1ba3de715ac80), W64LIT(0x5a03285ecc9c85de),
+	W64LIT(0x066a029b7bf3b472), W64LIT(0xcf5d84f133672f08), W64LIT(0x998d6444b55a3262), W64LIT(0x78a2e92d59ab790e),
+	W64LIT(0x400fbfd982ace6e8), W64LIT(0x0283e39774c50628), W64LIT(0x2b64a98731a31831), W64LIT(0x6dfdc443a6856293),
+	W64LIT(0x3cee92ee1346283f), W64LIT(0xaf0fb8ce8f6770ee), W64LIT(0xa8eb0be0fee9a97f), W64LIT(0x0e9f9ef7b69724b1),
+	W64LIT(0xb76629a167d54676), W64LIT(0x64bb8181e4186058), W64LIT(0x49f86e0ca7980569), W64LIT(0x263acfa5a1cd2026),
+	W64LIT(0x39acc525fbb95ef2), W64LIT(0xaf1c8e85eac52b36), W64LIT(0xd5696d0f428eef7e), W64LIT(0x89767c390729f855),
+	W64LIT(0xe30abd782332de11), W64LIT(0x3b51fa6398b171ff), W64LIT(0xde5c205417295884), W64LIT(0x2f67dde1b754230a),
+	W64LIT(0xcf3a52bdd2dbba9c), W64LIT(0x80de20f186535356), W64LIT(0xdda86838f043314b), W64LIT(0x58bd2b8957f8b66f),
+	W64LIT(0x2bfa79d74577f41c), W64LIT(0x24caab103e290a16), W64LIT(0xfa03436d5caa8b21), W64LIT(0xe877d1f26f171ff3),
+	W64LIT(0x8dbd5057c775af13), W64LIT(0x22e9ab4bd1aaf399), W64LIT(0xd70bab535e3179f1), W64LIT(0x4cbba39a92b4f2c6),
+	W64LIT(0x6a74343c85b8aa3f), W64LIT(0x25e3ed005e2156ec), W64LIT(0x2dbfaa1e265b4fa2), W64LIT(0x0066f70aba691506),
+	W64LIT(0xc3dc755afb566220), W64LIT(0xa40ebda5d852506a), W64LIT(0xf06d26864b944ed9), W64LIT(0x84496b2b18ce1f64),
+	W64LIT(0x0e4e3dee7d5fda7a), W64LIT(0xba6985f8df052a80), W64LIT(0x3bdae7ef41cb0da2), W64LIT(0xb54ad51166b3a2da),
+	W64LIT(0x9b202e2f91305d03), W64LIT(0x10bc68ec66103d53), W64LIT(0xd9775116aa32ab81), W64LIT(0x6de8a8c0b3d512db),
+	W64LIT(0x3a6bfa54bb5b8791), W64LIT(0xecad4932573702e6), W64LIT(0xaa2a268cebe4e4bc), W64LIT(0x0e2b44af43cbd4a6),
+	W64LIT(0x081d2cae4125af4a), W64LIT(0x4d1eb7e58b92f054), W64LIT(0x98aa9035400f1add), W64LIT(0x31834c0fe753c4cb),
+	W64LIT(0x87732277e9c98e7f), W64LIT(0xc10be7fe0290890d), W64LIT(0x176c31554ccc3ecd), W64LIT(0x8d1216ce31edf6bb),
+	W64LIT(0x610824129e7186c2), W64LIT(0x592a56d89343316c), W64LIT(0x743ad51f65b4c0a1), W64LIT(0x1348f9b6db037896),
+	W64LIT(0xa55227d5b9d9122f), W64LIT(0x6b0cb95c2290cee1), W64LIT(0xc25727a6189f39de), W64LIT(0xc81055f968350b50),
+	W64LIT(0x8b1a2c87e65aad09), W64LIT(0xa58b05e27ae98c58), W64LIT(0x82f65a37e109298f), W64LIT(0x516f09eef97e8dfc),
+	W64LIT(0xeeb056ba04d0e2a2), W64LIT(0xf8171e8c8ae17fc3), W64LIT(0x16aa674d64840bfd), W64LIT(0xff2bb6155b731254),
+	W64LIT(0xf5b70a663a80ad59), W64LIT(0x5416967feb06d9b3), W64LIT(0xaacce06df6b01137), W64LIT(0x4a6cba26088ee79a),
+	W64LIT(0xb2e805174585c9f5), W64LIT(0x1440e8917d8998f6), W64LIT(0x0a4115d9f8f99915), W64LIT(0x65e698fefdbafc45),
+	W64LIT(0xbf5c5d26265383ad), W64LIT(0x2fa7ebf7aca5111b), W64LIT(0xb206b89197f9bb86), W64LIT(0x629cdeaee6d3b52d),
+	W64LIT(0x184c543f3d811bac), W64LIT(0xd0176c561a34581e), W64LIT(0xdfc8884bd69b0229), W64LIT(0x403c9c2b2e481d0c),
+	W64LIT(0x3f307953047e8805), W64LIT(0x05300f98bfa977e2), W64LIT(0x2705c0e61a7efe82), W64LIT(0x38a590c83de47822),
+	W64LIT(0x351aea2197d5b881), W64LIT(0x92502f89e8c4908b), W64LIT(0x7ac35c2dd1f5e828), W64LIT(0x61431a49b21fba8a),
+	W64LIT(0xccfb3668dda718ee), W64LIT(0xa386903b58885e1d), W64LIT(0xdc19feec90f81fa3), W64LIT(0x8dfa25826f4e8435),
+	W64LIT(0x1fa7cbfb8db740e7), W64LIT(0xd9e857e2e8403386), W64LIT(0x4eabbd347d8a3eed), W64LIT(0x61ed5edfb1cc0d79),
+	W64LIT(0x3079406ee9324caf), W64LIT(0xf2770691bc8c01a5), W64LIT(0x2b50d200912cd47c), W64LIT(0x9fe1ff9b143979cf),
+	W64LIT(0x9f18067f22b3f371), W64LIT(0x3e5f676b199ce792), W64LIT(0x05c2f36efce3e0bd), W64LIT(0x199a24a726e89d74),
+	W64LIT(0x2991301054afc244), W64LIT(0x626f73cd42a2dc6b), W64LIT(0x41d304979d737304), W64LIT(0x50a10f103e6c2b02),
+	W64LIT(0x6127790ad91fb482), W64LIT(0xa858e9e0dac2827b), W64LIT(0x4e993a07f3bbf272), W64LIT(0xc4e0f8a28ec42d55),
+	W64LIT(0x9cde69a027ee8dc3), W64LIT(0xd44699d05ffd7545), W64LIT(0x1551b42019d9f35f), W64LIT(0x4547a68d0974771a),
+	W64LIT(0x81ed9316d552e821), W64LIT(0x6670a2f85f80ea7d), W64LIT(0x5f3e14ab922aa3a8), W64LIT(0x57cbb2b98cbf7365),
+	W64LIT(0x8fe958e328866dcd), W64LIT(0x12b889d75f9357a3), W64LIT(0x964edc0f13f3f991), W64LIT(0x94d73bc43d6a4259),
+	W64LIT(0x8b24ba7dff173590), W64LIT(0xb8e3a240eea5e2db), W64LIT(0x6b2a7fdb600e4743), W64LIT(0x0be4a4a63aa21b03),
+	W64LIT(0x191dc249f4106855), W64LIT(0x3bc3b34830690065), W64LIT(0xe968f666160b3969), W64LIT(0xa1df6bcf551a2e65),
+	W64LIT(0x259ce51f96e63232), W64LIT(0x4a869b546ae4deab), W64LIT(0x6b692c88fedab6b5), W64LIT(0xe1df4b56211d60d3),
+	W64LIT(0xdcd0126726ff8b07), W64LIT(0x099b27343e781b5c), W64LIT(0x7f855b0d6eaf26b1), W64LIT(0x6b9392edbe212a55),
+	W64LIT(0x7304b67c28377f22), W64LIT(0x07897d3efd90009b), W64LIT(0xd5cdae5654655a8d), W64LIT(0x0b11d8d821f94c3b),
+	W64LIT(0xf5ade489205ad509), W64LIT(0xf2bae4aee8c11eff), W64LIT(0x17ac6094eb3bb35b), W64LIT(0x9d625ed3f2163e7d),
+	W64LIT(0x79e4d11e37178149), W64LIT(0xdeaa584c94666db7), W64LIT(0x33c9dc187e850647), W64LIT(0xb7422b1ab9c44c3d),
+	W64LIT(0x9da483a33e273ce3), W64LIT(0x22281b43a9e820b6), W64LIT(0x27b62ae171825dd4), W64LIT(0x21f7f2696d441bfc),
+	W64LIT(0xdf617299712b1a1b), W64LIT(0x12654339b598a929), W64LIT(0x4f97df3810ac9fbb), W64LIT(0x598e12de2732cfe1),
+	W64LIT(0xa90b0d1676b1e754), W64LIT(0xc128819f4635ef95), W64LIT(0x26d46890bcb9cbfe), W64LIT(0x1038fcab5c38cb67),
+	W64LIT(0x446496da9af61f35), W64LIT(0x47fcc1dc143c623f), W64LIT(0xf31edebd7bee8841), W64LIT(0x111097ca8671abe5),
+	W64LIT(0x42064b73d7c954b0), W64LIT(0x8719e312303cde6c), W64LIT(0x99a5778a3b00c30a), W64LIT(0x14c61c525fa1501e),
+	W64LIT(0x9c1096757c6c3c31), W64LIT(0x369f747b104bc9d0), W64LIT(0x88494cc5e1d7c1b9), W64LIT(0x6ef8351d0f9a06bb),
+	W64LIT(0x1ea013837f9178cc), W64LIT(0x279c5c609054ed69), W64LIT(0x07bfe7dab29c1f0b), W64LIT(0x374351e7f66ec7c3),
+	W64LIT(0xd8ade1c09d0680b5), W64LIT(0x0dc01da5cb239023), W64LIT(0x7bf2f55e4952774d), W64LIT(0x978edf686d6cc650),
+	W64LIT(0xb94e0edc5010fc73), W64LIT(0x9509f7f958f007e3), W64LIT(0xa8554a948cd95335), W64LIT(0x85b7ddaccd721e6d),
+	W64LIT(0x86003ad404fba351), W64LIT(0x64d2120912ab4de5), W64LIT(0x00d54fac6c48d0f2), W64LIT(0xe63796ba9ac23a91),
+	W64LIT(0xb45dbc24b298f5a8), W64LIT(0x97d05a17a7878cf1), W64LIT(0xa1bff94d4b0c4b3a), W64LIT(0x64fffaf23fcf52bc),
+	W64LIT(0x44f819c6766fb40b), W64LIT(0x00c794c856b1abc2), W64LIT(0x780b7b33c5d147b5), W64LIT(0x2a62dd2c0065fd43),
+	W64LIT(0xb4ecb58c023c73b5), W64LIT(0xee7cd207645b3479), W64LIT(0x1bcdcbae18298087), W64LIT(0x0632230a885f6967),
+	W64LIT(0xd8b912698be518aa), W64LIT(0x072a82ce88b5fadb), W64LIT(0xabf55670f37c88aa), W64LIT(0x2074a8d7bc5330b0),
+	W64LIT(0x8f60dc6f072d3633), W64LIT(0xb38bf3e71af1a994), W64LIT(0xdb0983f412af9e2a), W64LIT(0x991561d6d0b29130),
+	W64LIT(0x43caedf910685b94), W64LIT(0x616a153f1873f224), W64LIT(0xf8a0688f2440f05b), W64LIT(0x2b85eb4bd0578438),
+	W64LIT(0x15d9ecd1d44e50fa), W64LIT(0x12136b02538118b0), W64LIT(0xc16ea93813bb2e2d), W64LIT(0x8bf784e4319f73e0),
+	W64LIT(0x601d67adf74d4537), W64LIT(0x373416278073d47d), W64LIT(0x29039800468302e9), W64LIT(0xc277c4ba7a2f1449),
+	W64LIT(0x3bda00eb2938da5b), W64LIT(0x7f96d7c6aae06d44), W64LIT(0x361fe924c16dfda3), W64LIT(0x4132239600431971),
+	W64LIT(0x4ac28f47808d8020), W64LIT(0xd6d0c64f92c716a3), W64LIT(0x773559ac3b078333), W64LIT(0x2b4e0e99ae2126e0),
+	W64LIT(0x4bb26730edf2cc19), W64LIT(0x04ee07523b88e8ec), W64LIT(0x643fbef24852823f), W64LIT(0x9e35a65ba70e9bc7),
+	W64LIT(0xf0e2d1b4ced7d90f), W64LIT(0xf8ca23c913cd3218), W64LIT(0xf42149c5627294c5), W64LIT(0xa32b4636a9a49888),
+	W64LIT(0xa01bf6f9468e7a2b), W64LIT(0xe295bdb7723cb527), W64LIT(0x48400e3dcdca3a40), W64LIT(0x56f3136deccd3106),
+	W64LIT(0xcbf4a0f0f031d89b), W64LIT(0x61746451e1923e20), W64LIT(0x261c18f87fe502f3), W64LIT(0x1b7a6397c8e45872),
+	W64LIT(0xbc8c4513d40c72f1), W64LIT(0x69ddda241bfd033f), W64LIT(0xadf5f61d87c5d316), W64LIT(0x75077588efb4a17c),
+	W64LIT(0x644f72177e8babcd), W64LIT(0x637e111ab6e00c00), W64LIT(0x04bb0eb46d3ae478), W64LIT(0xd701062142fb1bc9),
+	W64LIT(0x149697e36759b11c), W64LIT(0xfab1c05c9e67b8d1), W64LIT(0xaf7bf2688bd4430c), W64LIT(0x458cf580b8996a6d),
+	W64LIT(0x6c6e12012f2b52c6), W64LIT(0xd1db9a0c5dea7d2c), W64LIT(0x55737131876c4a1d), W64LIT(0x7cf9f4bb03193c82),
+	W64LIT(0x845ab1f681e0b006), W64LIT(0xb030b4c3ff15a434), W64LIT(0xa0e50b0687562b53), W64LIT(0x09e3d74b1871ab97),
+	W64LIT(0x184b5a3595fbb1a9), W64LIT(0x155eb1f604251cd0), W64LIT(0x5ac58503724c42d1), W64LIT(0xc3b4e90e2fd5c500),
+	W64LIT(0x4c2f1449f25e1088), W64LIT(0xbff7f7e8c7706c59), W64LIT(0x44758a838427ccc8), W64LIT(0x4425d6d1e4cd93fa),
+	W64LIT(0x4de53302148c506f), W64LIT(0x47700524f30a3a2f), W64LIT(0x436f6c3f4792e000), W64LIT(0x6bbbf1444609a2ac),
+	W64LIT(0x4ed156bd383d6802), W64LIT(0x33cc792b7e613e15), W64LIT(0x9565e27af4ba8502), W64LIT(0x594fa947c3bcb2ab),
+	W64LIT(0xa8d34dbf62645650), W64LIT(0xabefdee356f67af7), W64LIT(0x36cbf964f7d32761), W64LIT(0x76a6d7283c3a3deb),
+	W64LIT(0xdc5821f6ea14d72d), W64LIT(0x3d8029501b532bf9), W64LIT(0x51a3445c2ace841b), W64LIT(0x48832a4694fd9f07),
+	W64LIT(0xa6e007c3441e6da8), W64LIT(0x2adf7d5ed5e76b49), W64LIT(0xa3dd945cc507b131), W64LIT(0xeb6b3bdb390723c2),
+	W64LIT(0x1966f0f3cf000edc), W64LIT(0x9ffb6b6b88b41cb5), W64LIT(0x03e6e506db5dcc23), W64LIT(0x535b111e9cc2ba98),
+	W64LIT(0x9dabf35347857aba), W64LIT(0x9c7c87658b60802f), W64LIT(0xa499ef8c65b7dd6e), W64LIT(0xe4dbfeee6a5b033b),
+	W64LIT(0x1108ea704097b2de), W64LIT(0x557c0c477b943d5b), W64LIT(0xcc7af9db973f18d8), W64LIT(0x5644124d38c633a7),
+	W64LIT(0xb4966fac2937a596), W64LIT(0x1c7e056a005fde5d), W64LIT(0xf6c1478d11967783), W64LIT(0x15c7423122a1a897),
+	W64LIT(0x1c6aa0e6d6d0e6a2), W64LIT(0x7a77c4f0149890ca), W64LIT(0x0a74359b45be2756), W64LIT(0x5735edde988e9c2a),
+	W64LIT(0x77938ec01aceb14c), W64LIT(0x162174fb7212122b), W64LIT(0x8a4ce12698f214f3), W64LIT(0x5d1a98b14287c3f8),
+	W64LIT(0x0505b53afaab2e39), W64LIT(0xa2c3e3d5a37dc76e), W64LIT(0xe8ad30f93768a7da), W64LIT(0xa4d971bd9376f770),
+	W64LIT(0x22c7c018bb522faa), W64LIT(0x221de2da10f001c2), W64LIT(0x996791afa386208c), W64LIT(0xb6591065457a3c05),
+	W64LIT(0x7994c77984a865e7), W64LIT(0x3859fe76f6e52fe0), W64LIT(0x57b80f735785e71f), W64LIT(0x12d89155af7b0906),
+	W64LIT(0xb6e5caf1d8bed2e7), W64LIT(0xb108d1bbcdb4b130), W64LIT(0x22cd879d57c13d72), W64LIT(0x025c842c0d4d0839),
+	W64LIT(0x5728ec9935891a32), W64LIT(0xbb9ab74c1cbc84b1), W64LIT(0xec171cc0112b5eba), W64LIT(0x62c48397217529b4),
+	W64LIT(0xe1b06dfbb5228657), W64LIT(0x87fb782516c3894c), W64LIT(0x69c2b31712b85e90), W64LIT(0x911aea040dd0d2b9),
+	W64LIT(0xbe6228aceccb489d), W64LIT(0x3d2729170e7518e9), W64LIT(0x1fef285bb13b996b), W64LIT(0x793230715d171c5f),
+	W64LIT(0x7efb2c4a080e0e38), W64LIT(0x719942274362d180), W64LIT(0x7e35cbf4b4ba4554), W64LIT(0x645c10fca67f9106),
+	W64LIT(0xb60682007b896819), W64LIT(0x0da2cdf70b16584a), W64LIT(0x100e8f7e2fb4e7eb), W64LIT(0x58bc3cb18e50237b),
+	W64LIT(0x521434b34000e36a), W64LIT(0x022cf86919bea181), W64LIT(0x6d90516fd89975e2), W64LIT(0xb6b0ff8a1885e2d9),
+	W64LIT(0xd9f72b4bcb922526), W64LIT(0xfdd9269e8e352f78), W64LIT(0xe95467d273ee27bf), W64LIT(0x720b95862a92e709),
+	W64LIT(0x8e220cdced22246f), W64LIT(0x536e15cc7b69f802), W64LIT(0xe24a11b073ef3387), W64LIT(0x036dba8567d6bbed),
+	W64LIT(0x67b0701c6e2a70a2), W64LIT(0x526f95d3c777fdf2), W64LIT(0x866b744443ed72a7), W64LIT(0x29346ad0e24d7d1b),
+	W64LIT(0x260919f226aefe0e), W64LIT(0x842add83cc8e87f1), W64LIT(0xf8f7d8b85f0bc1b2), W64LIT(0x665a6653fb947982),
+	W64LIT(0x91a4d78b01a65c01), W64LIT(0x25e5e53456318c64), W64LIT(0x79036e1746271757), W64LIT(0x8200396b11e2befd),
+	W64LIT(0x0247750541569832), W64LIT(0x8a52e54193181e88), W64LIT(0x62846587bf7dbd62), W64LIT(0xccb902421dcb0124),
+	W64LIT(0x26f9de4d12784234), W64LIT(0xe4ab3b4644cbb1c6), W64LIT(0xd610a29590b49081), W64LIT(0x31d95a8daa1ff6c8),
+	W64LIT(0x7b0705e53fd0bcf5), W64LIT(0x97d6057dcb1ca2bd), W64LIT(0x161287c455234d20), W64LIT(0x8465d3f9056d5d59),
+	W64LIT(0x4d27da06f595b798), W64LIT(0x00d8b1b690103584), W64LIT(0x746fa8790d792290), W64LIT(0x47ae2b1c7b3043e5),
+	W64LIT(0x9dfef989802f3fdf), W64LIT(0xd0539e8f850ab4fa), W64LIT(0x0537c028bf1caabe), W64LIT(0xce83912a26618558),
+	W64LIT(0xcfad99a8b2ca72a6), W64LIT(0x7eaa45c4c3ab328a), W64LIT(0xc5ca4911986f6fe4), W64LIT(0x1b4ee621a6bbbcc0),
+	W64LIT(0x34cbb757941dd731), W64LIT(0x0b3c29a312da96cd), W64LIT(0xb231c49408ed69c2), W64LIT(0xfaeb2f25de54dc44),
+	W64LIT(0xfc40e58c6d6b4e34), W64LIT(0x1e37609d1a46d731), W64LIT(0xbdd9c274a07d2144), W64LIT(0x945e0770277c7f8a),
+	W64LIT(0x9165f49b797c8883), W64LIT(0xa01c220aec6bd8a9), W64LIT(0x889c8511e9dff3bb), W64LIT(0x04c06c8bd36efbe7),
+	W64LIT(0xa5b4f4371c5338ee), W64LIT(0x10ae9039ab810d3b), W64LIT(0x4461a35fae721951), W64LIT(0x55b9cbea536f319b),
+	W64LIT(0x1e97e80040893e85), W64LIT(0xc60b0a4341938ee8), W64LIT(0xcd27eadd12db8044), W64LIT(0x5fd89371fd407aba),
+	W64LIT(0xc298c13dd1340b66), W64LIT(0x137d95d5077c2ee6), W64LIT(0xba684c3f3fc709c9), W64LIT(0x51687e96cbfd5738),
+	W64LIT(0x26f9161861e542f8), W64LIT(0xcb8f30ad4e2bb6b8), W64LIT(0x6781df887ecbbebf), W64LIT(0xc87bed150851f477),
+	W64LIT(0xba2e75c6abdd2852), W64LIT(0x07cf0fda5da48be5), W64LIT(0x0b894ef59539659b), W64LIT(0x83b4fb48a0e827bb),
+	W64LIT(0x4348fcd8a3483c65), W64LIT(0x671d8e1aa51d2f59), W64LIT(0xfd904e08dcb387d3), W64LIT(0xbca6a25359043fe6),
+	W64LIT(0xcf1067cd60a0f014), W64LIT(0xf32208e82375d07f), W64LIT(0x89b847a40059cff7), W64LIT(0x777204a744c1a6d0),
+	W64LIT(0x82fa3c6cae2545aa), W64LIT(0xb8b3122299d5462b), W64LIT(0xa65e0d9c8aaa0c68), W64LIT(0x8a2c176610ec8353),
+	W64LIT(0xf02619b4a5989554), W64LIT(0x9a3716dd4a8b6e14), W64LIT(0x7f35a53ef0c75d54), W64LIT(0x43184d3134d6ec7d),
+	W64LIT(0xe9419f77dead3b9d), W64LIT(0xe7a1a3ad9b5a0f22), W64LIT(0xa4b6d13d6f02606b), W64LIT(0x9ff96525afd13ba3),
+	W64LIT(0x20f2b6a0d1dde061), W64LIT(0xac6845e72dbfc632), W64LIT(0x2c87a8a94a925693), W64LIT(0x15dd6c0b06cf1462),
+	W64LIT(0x0bf80cae76e2a5a9), W64LIT(0x7ee9879a152ff184), W64LIT(0x82ba8615961cbe56), W64LIT(0xacda3db03c7cbb14),
+	W64LIT(0xa50aaf359fd826e2), W64LIT(0xef375e9506a1f71d), W64LIT(0xcca4274668b60755), W64LIT(0x2906b61faa6bdbd8),
+	W64LIT(0xc8be2eeac07a5936), W64LIT(0x407b83e74fd85fa7), W64LIT(0x12789de1595d2f47), W64LIT(0xce1c13ea155cd209),
+	W64LIT(0x6ea5df0d85b69383), W64LIT(0xfc8744cd34f18675), W64LIT(0x28c28c890f8faec2), W64LIT(0x59d0f7d3d984494a),
+	W64LIT(0x3ab199191ebd5ad0), W64LIT(0xb48914e543e9cbac), W64LIT(0x11960a0eb44c35a5), W64LIT(0xd44370a5855c8e50),
+	W64LIT(0xfa58bc9866062967), W64LIT(0x949ce1aa9b8fd5d3), W64LIT(0x2cc276a7d3908912), W64LIT(0x692e8b9696475a04),
+	W64LIT(0x653b72545147119b), W64LIT(0x53a2d82a2227e231), W64LIT(0x8d7b48fae26cc678), W64LIT(0x0975d4c3253171ff),
+	W64LIT(0xa0a1330a9a4898c3), W64LIT(0xf7519111047919b7), W64LIT(0x6d355147d317a173), W64LIT(0x8e908d9031b08916),
+	W64LIT(0x3cf4b1f12458c3af), W64LIT(0x55236a1b893ad031), W64LIT(0x0375796796509db2), W64LIT(0xf849f2d80f6dfbb3),
+	W64LIT(0xcd78d0ea64798e9b), W64LIT(0x86a53eb41ea8be6d), W64LIT(0x0938c852b68bc755), W64LIT(0x18b6dde3bb5e3eb4),
+	W64LIT(0x8adadffe61ffecae), W64LIT(0x3a13d3ddc8d4dc88), W64LIT(0xfc9f9fe4b2f7bf4d), W64LIT(0xd388e67012e25953),
+	W64LIT(0x824e94e75ba111c4), W64LIT(0xdd5111d3bdd658f9), W64LIT(0x833940a1c38e3ed8), W64LIT(0x295c09353653784d),
+	W64LIT(0xb7016c7c616a8078), W64LIT(0x397a2fa23baabd14), W64LIT(0x478ff9a77f77186c), W64LIT(0x0f0687781f1fde2d),
+	W64LIT(0x46cd9cee57be9871), W64LIT(0xab1773c160316c77), W64LIT(0xd7f833b8b8565bba), W64LIT(0xa490840debbe1f1f),
+	W64LIT(0x43c42ace4ae63da6), W64LIT(0xdccc6820305d2ee3), W64LIT(0x9188fd950d0386e7), W64LIT(0xfca3c0b869b4ff32),
+	W64LIT(0xcbf8a1fb3111c978), W64LIT(0xd66dfb5256838367), W64LIT(0x42bb8396b5ad75d3), W64LIT(0x50126aacfd348142),
+	W64LIT(0x3858fb05e5e550d6), W64LIT(0x9ee5a94bfc45cc80), W64LIT(0xfdcb09686fbd6680), W64LIT(0x61542068deed3209),
+	W64LIT(0x45ad2b0a70ade3f9), W64LIT(0xbb1ec8e4e1816062), W64LIT(0xf027ad883750df1e), W64LIT(0x4305e5bf2b4f4958),
+	W64LIT(0xce91628fdab16d57), W64LIT(0x205da7ce697ec16e), W64LIT(0x3c70105bd66602f8), W64LIT(0xc77229394c279bab),
+	W64LIT(0x5e92d17d170c0b01), W64LIT(0x6a39fc7335a09aa5), W64LIT(0x442113c8c7fd8e5b), W64LIT(0x0920f6855a876238),
+	W64LIT(0x509f73701e5e572c), W64LIT(0xc2f0afeeb9880dba), W64LIT(0xb334e70246cbba86), W64LIT(0x7ff98ba4972a5b02),
+	W64LIT(0xcc3c4bf435939392), W64LIT(0xb2197bb1e6689500), W64LIT(0x254fa966b041ea26), W64LIT(0x80638d81f3676fc3),
+	W64LIT(0xc99000f6dd7e3265), W64LIT(0x4a9cfd3c383d3ed6), W64LIT(0x4e267bfdd6628b00), W64LIT(0x022ca2def3e478af),
+	W64LIT(0x530de5b5c3314c75), W64LIT(0xc5364becdc7c40ad), W64LIT(0xd31dc3b36584765e), W64LIT(0x88f4c33864facb61),
+	W64LIT(0x4d52fb74c30d4004), W64LIT(0x6a95fc8bbabab6a3), W64LIT(0x70e04d65ed2491a2), W64LIT(0x892ec50b62397356),
+	W64LIT(0x91dbc741d7c368ac), W64LIT(0xba1052981f50fe47), W64LIT(0x6f2263196cb58a45), W64LIT(0x9ef0ad6d411810b5),
+	W64LIT(0x8eeef29b1f61c8ce), W64LIT(0xf83f49facd957a9b), W64LIT(0x412a42d708849c8d), W64LIT(0x6b1608ea66d8cef4),
+	W64LIT(0x28238d8f01a4f416), W64LIT(0xb389e8234aab4fdb), W64LIT(0xcd0a69dc141f0b1f), W64LIT(0x4c119601699b9973),
+	W64LIT(0x888ec9c2aeb92962), W64LIT(0xb7ec13d90d9b54cc), W64LIT(0xe302b090e88d6713), W64LIT(0xe09c41fc6fc5fd34),
+	W64LIT(0x4e5a422fb59a55ab), W64LIT(0x27f323114ac124c8), W64LIT(0x2655a7f183518c3f), W64LIT(0xa54327271d02d533),
+	W64LIT(0x18673edba26b7dbb), W64LIT(0xe3b4b0229ec116a8), W64LIT(0xc9bc39ba3f5f58fe), W64LIT(0xd7a6bb44995135b0),
+	W64LIT(0x5dc38853e8f51345), W64LIT(0x25964f1f859c4d7a), W64LIT(0x637dc99cb70d2946), W64LIT(0x13c9c3d3e5964a3a),
+	W64LIT(0x6cbc7954fa4a939a), W64LIT(0x05877fc624b21a39), W64LIT(0x73a1cc2e936fbe93), W64LIT(0x0a46774cd88face1),
+	W64LIT(0xc5b35a8353867475), W64LIT(0xfe093478577b7f5b), W64LIT(0xa045e9061dbcce20), W64LIT(0x93c39b6e8da527fa),
+	W64LIT(0x182948d22c5647de), W64LIT(0xe8d3944f6d97ce08), W64LIT(0x2b75e0c6fd467348), W64LIT(0xd78b11448fbbaa80),
+	W64LIT(0x8e9a6c01783c19e3), W64LIT(0xc5ebe8ccf5628a9b), W64LIT(0xb420170f110699c1), W64LIT(0x9ab9afc72a04cf20),
+	W64LIT(0x2db2e926a6892223), W64LIT(0x6d5d133130cf82a0), W64LIT(0xebfd6ee23c8bbaef), W64LIT(0x2ff0019c2badb8b5),
+	W64LIT(0xce5e6afc6a89ad11), W64LIT(0x0f81db8010f38c25), W64LIT(0xddcb000bf947d397), W64LIT(0x85166aa25b834b2d),
+	W64LIT(0x11bcec171b15672d), W64LIT(0xa0305c9a85fa8ca2), W64LIT(0x8ffcbe302474160d), W64LIT(0x576bf97adca7aacc),
+	W64LIT(0x8bc1b95d87a4377a), W64LIT(0xbb7781ceeade8f06), W64LIT(0xa08ad7a0e8ee35ac), W64LIT(0x90e7b3103fd97eef),
+	W64LIT(0xe6b5966e27b11d70), W64LIT(0x07a14036363ef42b), W64LIT(0x9184cf6cbf4cdb39), W64LIT(0x42fa5cc9c4c1cb4f),
+	W64LIT(0x2dcbe020abd72831), W64LIT(0x1edc26bcf9f47533), W64LIT(0x60e269db80268d64), W64LIT(0x65e11619777a5bc9),
+	W64LIT(0xa398dcd1c3227536), W64LIT(0x0f6df7546f3ccaeb), W64LIT(0x0d96e8c5894f204b), W64LIT(0xafe31f03aecfdcdc),
+	W64LIT(0xdac03ad5c85d4fd0), W64LIT(0x1a6f43e032b9fc36), W64LIT(0x4d13491c78a912a4), W64LIT(0x6da3a61f11d33dd1),
+	W64LIT(0x3738f89b977b1a7b), W64LIT(0xa6a28ab15c2382f7), W64LIT(0xb291bd78eff16e2b), W64LIT(0x03fe312622c15b0f),
+	W64LIT(0x93b7191a108e9e6e), W64LIT(0x4aa695e9ac0159cc), W64LIT(0xd11b3ede3d8aabf1), W64LIT(0xa29ea9ba657c37d6),
+	W64LIT(0xcb9f0590a7db8842), W64LIT(0xb5f5823b8a9bfd8b), W64LIT(0x164fcb9137eb1fc3), W64LIT(0xb9a8c357accac40c),
+	W64LIT(0xbb813ec37985cd39), W64LIT(0x786708d7e1008bd3), W64LIT(0x4940f48eb6c0ed05), W64LIT(0x42e06c56378d89a5),
+	W64LIT(0x58c3352cdf11cc5b), W64LIT(0x60923759969aba4d), W64LIT(0x481943e0c66638ca), W64LIT(0xf9bfdb1c9295d970),
+	W64LIT(0xc73f007e38e0067e), W64LIT(0x98bb7d008e6a5944), W64LIT(0x1e3af19d2b767947), W64LIT(0x7720a136a80f985d),
+	W64LIT(0xb8e78406e5c8662a), W64LIT(0x248ade556b618332), W64LIT(0xe9bd5d122fadc63f), W64LIT(0x331fe936a0b0be6b),
+	W64LIT(0x26096461324f982a), W64LIT(0x33643e685144ffe4), W64LIT(0x746d4622f33e86fa), W64LIT(0x970b5e54c5df9af2),
+	W64LIT(0xc007d6d38759aa8e), W64LIT(0x7e783e5c2ae24a3b), W64LIT(0x2a4c05260085190d), W64LIT(0x5cdbb589a582ef77),
+	W64LIT(0x3dde3638e6520fa9), W64LIT(0x95c922d76e41ecd9), W64LIT(0xd1188d67be708fa6), W64LIT(0x08f65c2428fd509e),
+	W64LIT(0xbe823a0863017b94), W64LIT(0xdc80ec540174ec5b), W64LIT(0xce9097e3250d12e9), W64LIT(0xc0573709c4b52483),
+	W64LIT(0xf902b12b0115ef78), W64LIT(0xe8b352e744008608), W64LIT(0xe9dbb14f8d438b59), W64LIT(0x8706c72f211da18e),
+	W64LIT(0xf99480fe0f611f06), W64LIT(0xfc2d666bf88bec4a), W64LIT(0xedeacb8e524bdee4), W64LIT(0xda4ffeffbe078178),
+	W64LIT(0x1b78e70279ca244f), W64LIT(0x71dd9bd011339821), W64LIT(0x684d95b0eb8072a9), W64LIT(0x9d52ea6752e13793),
+	W64LIT(0xcf322b2ec154c7df), W64LIT(0x29868aa42a74b5a1), W64LIT(0x7e9d59c1552cf00f), W64LIT(0x9cf642918bb61f95),
+	W64LIT(0x69a23e954bf512e7), W64LIT(0x7adfc70e3a6ad36c), W64LIT(0x13a35caae765be6c), W64LIT(0x6e009876b7b0a39f),
+	W64LIT(0x4de32e222e50bba5), W64LIT(0xb0c598c9b4d711ef), W64LIT(0xd1e0f0fc4c7b5937), W64LIT(0x0f173ba5b9070981),
+	W64LIT(0x7e8324c6aaeb9761), W64LIT(0x8dea6066f03b7da8), W64LIT(0x81893d16f8adb1b9), W64LIT(0xa20952513eb91449),
+	W64LIT(0x2441c13802b371c1), W64LIT(0xc1b1b4b832d1ed95), W64LIT(0x6b29649cf5379f05), W64LIT(0xbb75dc80436ef4b2),
+	W64LIT(0x399854a16eab6cb1), W64LIT(0x57482cb688b4b863), W64LIT(0x43581b0ef3fcde8c), W64LIT(0x27fc086a14c6c09e),
+	W64LIT(0x51b24532efc1b279), W64LIT(0x1a7344669db4beb1), W64LIT(0x996756139a018037), W64LIT(0xb299965f71bf2389),
+	W64LIT(0x3fd358e5116b5ad2), W64LIT(0x14b4ce674cff76a9), W64LIT(0x93d94b5954723177), W64LIT(0xa491cb447734200f),
+	W64LIT(0x0df3da7f30a65913), W64LIT(0xcce4af529cc3ad7f), W64LIT(0x2a9f9786511340e6), W64LIT(0xdc92140c5425a08c),
+	W64LIT(0xc9ebde7e7865896b), W64LIT(0x6ccafe37e8ace1e7), W64LIT(0x45689e1b2e53e503), W64LIT(0x2a7d81bce1cd9d58),
+	W64LIT(0x98a28eb96d0c4f69), W64LIT(0x6c6e15722c22939d), W64LIT(0x1977b9524a615c85), W64LIT(0xf9f4a4ce9e3ae3e0),
+	W64LIT(0x20dc919e77b17cac), W64LIT(0xf41e6cfc80b6a748), W64LIT(0x12f1f95768203e5c), W64LIT(0x5d2d4b1a29da9297),
+	W64LIT(0x1f66720d230348c5), W64LIT(0x5c802e347d4155c1), W64LIT(0x4102b551207845e3), W64LIT(0xe33ced3ec97f80f6),
+	W64LIT(0xedfe36f2df23b759), W64LIT(0xc4996de1a433740d), W64LIT(0x1ea1af5777712c2e), W64LIT(0x0b2cb40c19dfe5c4),
+	W64LIT(0x34a3a04abca9f89b), W64LIT(0x51b9437724c1e97e), W64LIT(0x434240240d8e6c5c), W64LIT(0x73988ac61d903c78),
+	W64LIT(0x876e55c65a9c6a6d), W64LIT(0xfb1cff8a1464943f), W64LIT(0x8101fd8915c3b69d), W64LIT(0x82669fe4aec70edf),
+	W64LIT(0x3bb034fdae4da22b), W64LIT(0x14f31dd7d5c68a7d), W64LIT(0x050455b802cdebb3), W64LIT(0x3f6310bdcc925057),
+	W64LIT(0xde02d8704f95af68), W64LIT(0x9c6bfcce5352e13a), W64LIT(0x78079bb9984158ca), W64LIT(0x94fc0cf4cf3ccbfb),
+	W64LIT(0x54314d944614b2e5), W64LIT(0xcdd31b225d97f1a2), W64LIT(0x0739b18af634d72f), W64LIT(0x65732a4149d92c88),
+	W64LIT(0x93b66b137682005b), W64LIT(0x8a38e595fef0ad1c), W64LIT(0xebd0d87ffd702c7f), W64LIT(0x76667c4428a0a7a2),
+	W64LIT(0x83c304ed62d407b3), W64LIT(0x909991129793effa), W64LIT(0x6c3c32f2701e84a4), W64LIT(0x5e9e6a5fa25e281b),
+	W64LIT(0x6be499736a85ce86), W64LIT(0xb3fb68301da4597b), W64LIT(0xacd9907fe88bc5c9), W64LIT(0x6943f89b4ffa79c6),
+	W64LIT(0xe86f8d0d35bbd50d), W64LIT(0x77a73764c4f0e34d), W64LIT(0x444e1d6a040467a1), W64LIT(0x11de8d31364be5c6),
+	W64LIT(0xde872e3d6ecc6cf3), W64LIT(0xbab7d10cba891cea), W64LIT(0xbbc396b087c1ca90), W64LIT(0x6d35f6b1ada98927),
+	W64LIT(0x4bef16d3882fe621), W64LIT(0xe0a410b6fffed3ab), W64LIT(0x535b5e9a976e18d9), W64LIT(0xa5ed79a67000a6d2),
+	W64LIT(0x37a528035156f822), W64LIT(0x58565763d7e90c9b), W64LIT(0x6749af6875332367), W64LIT(0x03762901c78e0919),
+	W64LIT(0xde257a204ef0d999), W64LIT(0x6b56caf6bdddb797), W64LIT(0x359ca4ebe72bd1b5), W64LIT(0x10a604c5a6ed390e),
+	W64LIT(0x018a292ff834b1b0), W64LIT(0xef8f28f78c306f98), W64LIT(0xd48cea8f520c58b8), W64LIT(0x124474ac3530aefe),
+	W64LIT(0x6784ba1b92ed7fe4), W64LIT(0xb1fcc2d211cde085), W64LIT(0x07aebef461dca773), W64LIT(0xb16efe524d49275d),
+	W64LIT(0xe340080ba69f65e1), W64LIT(0xebb909486518e789), W64LIT(0x51db3def06f391dd), W64LIT(0xa5b9c1f1822ad2d9),
+	W64LIT(0xd333dd0221a684e9), W64LIT(0x4b3c3862ef9349fc), W64LIT(0x361036abc441205d), W64LIT(0x0f3f03d977373cf3),
+	W64LIT(0x044f7714f8d066c9), W64LIT(0x810d448e49f94118), W64LIT(0x88180153a330f116), W64LIT(0x116fbc03ae13d581),
+	W64LIT(0xc54dbd4156c3e819), W64LIT(0x73140ae6f437fb6f), W64LIT(0xa6b2e1ba6900bafe), W64LIT(0x3d8cb5cedd00caf3),
+	W64LIT(0x79b5fd0628428562), W64LIT(0x56164a2d82b20af5), W64LIT(0x4f7bc75164a36645), W64LIT(0x29b81eeb5028981c),
+};
+
+const ECPCombTable g_ecpCombTables[] = {
+	{"secp256r1", 4, 26, s_secp256r1Curve, s_secp256r1Points},
+	{"secp384r1", 6, 39, s_secp384r1Curve, s_secp384r1Points},
+	{"secp521r1", 9, 53, s_secp521r1Curve, s_secp521r1Points},
+	{"brainpoolP256r1", 4, 26, s_brainpoolP256r1Curve, s_brainpoolP256r1Points},
+	{"brainpoolP384r1", 6, 39, s_brainpoolP384r1Curve, s_brainpoolP384r1Points},
+	{"brainpoolP512r1", 8, 52, s_brainpoolP512r1Curve, s_brainpoolP512r1Points},
+};
+
+const unsigned int g_ecpCombTableCount = sizeof(g_ecpCombTables)/sizeof(g_ecpCombTables[0]);
+
+NAMESPACE_END
+
+#endif
@@ -0,0 +1,603 @@
+// ecpnist.cpp - fixed width arithmetic for NIST P-256 and P-384
+
+#include "pch.h"
+
+#ifndef CRYPTOPP_IMPORTS
+
+#include "ecpnist.h"
+#include "ecp.h"
+#include "ecpcomb.h"
+#include "secblock.h"
+#include "misc.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+#ifdef _MSC_VER
+	typedef __int64 NISTSignedWord;
+#else
+	typedef long long NISTSignedWord;
+#endif
+
+// returns the low word of a*b + c + carry and leaves the high word in carry
+static inline word64 NIST_MultiplyAdd(word64 a, word64 b, word64 c, word64 &carry)
+{
+#if defined(CRYPTOPP_WORD128_AVAILABLE)
+	const word128 p = word128(a) * b + c + carry;
+	carry = word64(p >> 64);
+	return word64(p);
+#else
+	word64 hi, lo;
+#if defined(_MSC_VER) && defined(_M_X64)
+	lo = _umul128(a, b, &hi);
+#else
+	const word64 ll = word64(word32(a)) * word32(b), lh = word64(word32(a)) * word32(b >> 32);
+	const word64 hl = word64(word32(a >> 32)) * word32(b), hh = word64(word32(a >> 32)) * word32(b >> 32);
+	const word64 mid = (ll >> 32) + word32(lh) + word32(hl);
+	hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	lo = (mid << 32) | word32(ll);
+#endif
+	lo += carry;
+	hi += lo < carry;
+	lo += c;
+	hi += lo < c;
+	carry = hi;
+	return lo;
+#endif
+}
+
+static inline word64 NIST_AddWithCarry(word64 a, word64 b, word64 &carry)
+{
+#if defined(CRYPTOPP_WORD128_AVAILABLE)
+	const word128 s = word128(a) + b + carry;
+	carry = word64(s >> 64);
+	return word64(s);
+#else
+	const word64 t = a + carry;
+	carry = t < carry;
+	const word64 s = t + b;
+	carry += s < t;
+	return s;
+#endif
+}
+
+static inline word64 NIST_SubtractWithBorrow(word64 a, word64 b, word64 &borrow)
+{
+#if defined(CRYPTOPP_WORD128_AVAILABLE)
+	const word128 d = word128(a) - b - borrow;
+	borrow = word64(d >> 64) & 1;
+	return word64(d);
+#else
+	const word64 t = a - b;
+	const word64 u = a < b;
+	const word64 d = t - borrow;
+	borrow = u | (t < borrow);
+	return d;
+#endif
+}
+
+// all ones if the N words at a are zero, without branching on the value
+static inline word64 NIST_ZeroMask(const word64 *a, unsigned int N)
+{
+	word64 w = 0;
+	for (unsigned int i=0; i<N; i++)
+		w |= a[i];
+	return 0 - ((~w & (w - 1)) >> 63);
+}
+
+// The reductions write the 32-bit words of the value modulo p as signed sums of the 32-bit words
+// c(i) of the double width product t (FIPS 186-4 D.2). Carrying leaves a small multiple u of 2^(64N),
+// which is folded back in as u*(2^(64N) mod p). Two folds always bring the carry to zero and the
+// value below 2^(64N) < 2p, so the caller finishes with a single conditional subtraction of p.
+// Everything is written out so the accumulators can stay in registers.
+
+#define NIST_MULADD(i, j)	t[i+j] = NIST_MultiplyAdd(a[i], b[j], t[i+j], carry);
+#define NIST_C(i)		NISTSignedWord(word32(t[(i)/2] >> (32*((i)%2))))
+#define NIST_CARRY(a)	a += u; u = a >> 32; a &= 0xffffffff;
+#define NIST_PACK(a, b)	(word64(a) | (word64(b) << 32))
+
+struct NISTP256
+{
+	enum {WORDS = 4};
+	static const word64 P[WORDS];
+	static const char *Modulus() {return "ffffffff00000001000000000000000000000000ffffffffffffffffffffffffh";}
+	static const char *CoefficientB() {return "5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604bh";}
+	static const char *SubgroupOrder() {return "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551h";}
+
+	//! r = a*b mod p, possibly plus p
+	static void Multiply(word64 *r, const word64 *a, const word64 *b)
+	{
+		word64 t[8] = {0}, carry;
+#define NIST_ROW(i)	carry = 0; NIST_MULADD(i, 0) NIST_MULADD(i, 1) NIST_MULADD(i, 2) NIST_MULADD(i, 3) t[i+4] = carry;
+		NIST_ROW(0) NIST_ROW(1) NIST_ROW(2) NIST_ROW(3)
+#undef NIST_ROW
+
+		NISTSignedWord a0 = NIST_C(0) + NIST_C(8) + NIST_C(9) - NIST_C(11) - NIST_C(12) - NIST_C(13) - NIST_C(14);
+		NISTSignedWord a1 = NIST_C(1) + NIST_C(9) + NIST_C(10) - NIST_C(12) - NIST_C(13) - NIST_C(14) - NIST_C(15);
+		NISTSignedWord a2 = NIST_C(2) + NIST_C(10) + NIST_C(11) - NIST_C(13) - NIST_C(14) - NIST_C(15);
+		NISTSignedWord a3 = NIST_C(3) + 2*(NIST_C(11) + NIST_C(12)) + NIST_C(13) - NIST_C(15) - NIST_C(8) - NIST_C(9);
+		NISTSignedWord a4 = NIST_C(4) + 2*(NIST_C(12) + NIST_C(13)) + NIST_C(14) - NIST_C(9) - NIST_C(10);
+		NISTSignedWord a5 = NIST_C(5) + 2*(NIST_C(13) + NIST_C(14)) + NIST_C(15) - NIST_C(10) - NIST_C(11);
+		NISTSignedWord a6 = NIST_C(6) + 3*NIST_C(14) + 2*NIST_C(15) + NIST_C(13) - NIST_C(8) - NIST_C(9);
+		NISTSignedWord a7 = NIST_C(7) + 3*NIST_C(15) + NIST_C(8) - NIST_C(10) - NIST_C(11) - NIST_C(12) - NIST_C(13);
+
+		// 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p
+		NISTSignedWord u;
+#define NIST_PROPAGATE	u = 0; NIST_CARRY(a0) NIST_CARRY(a1) NIST_CARRY(a2) NIST_CARRY(a3) NIST_CARRY(a4) NIST_CARRY(a5) NIST_CARRY(a6) NIST_CARRY(a7)
+		NIST_PROPAGATE a0 += u; a3 -= u; a6 -= u; a7 += u;
+		NIST_PROPAGATE a0 += u; a3 -= u; a6 -= u; a7 += u;
+		NIST_PROPAGATE
+#undef NIST_PROPAGATE
+
+		r[0] = NIST_PACK(a0, a1);
+		r[1] = NIST_PACK(a2, a3);
+		r[2] = NIST_PACK(a4, a5);
+		r[3] = NIST_PACK(a6, a7);
+	}
+};
+
+const word64 NISTP256::P[] = {W64LIT(0xffffffffffffffff), W64LIT(0x00000000ffffffff), 0, W64LIT(0xffffffff00000001)};
+
+struct NISTP384
+{
+	enum {WORDS = 6};
+	static const word64 P[WORDS];
+	static const char *Modulus() {return "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffffh";}
+	static const char *CoefficientB() {return "b3312fa7e23ee7e4988e056be3f82d19181d9c6efe8141120314088f5013875ac656398d8a2ed19d2a85c8edd3ec2aefh";}
+	static const char *SubgroupOrder() {return "ffffffffffffffffffffffffffffffffffffffffffffffffc7634d81f4372ddf581a0db248b0a77aecec196accc52973h";}
+
+	//! r = a*b mod p, possibly plus p
+	static void Multiply(word64 *r, const word64 *a, const word64 *b)
+	{
+		word64 t[12] = {0}, carry;
+#define NIST_ROW(i)	carry = 0; NIST_MULADD(i, 0) NIST_MULADD(i, 1) NIST_MULADD(i, 2) NIST_MULADD(i, 3) NIST_MULADD(i, 4) NIST_MULADD(i, 5) t[i+6] = carry;
+		NIST_ROW(0) NIST_ROW(1) NIST_ROW(2) NIST_ROW(3) NIST_ROW(4) NIST_ROW(5)
+#undef NIST_ROW
+
+		NISTSignedWord a0 = NIST_C(0) + NIST_C(12) + NIST_C(20) + NIST_C(21) - NIST_C(23);
+		NISTSignedWord a1 = NIST_C(1) + NIST_C(13) + NIST_C(22) + NIST_C(23) - NIST_C(12) - NIST_C(20);
+		NISTSignedWord a2 = NIST_C(2) + NIST_C(14) + NIST_C(23) - NIST_C(13) - NIST_C(21);
+		NISTSignedWord a3 = NIST_C(3) + NIST_C(12) + NIST_C(15) + NIST_C(20) + NIST_C(21) - NIST_C(14) - NIST_C(22) - NIST_C(23);
+		NISTSignedWord a4 = NIST_C(4) + NIST_C(12) + NIST_C(13) + NIST_C(16) + NIST_C(20) + 2*NIST_C(21) + NIST_C(22) - NIST_C(15) - 2*NIST_C(23);
+		NISTSignedWord a5 = NIST_C(5) + NIST_C(13) + NIST_C(14) + NIST_C(17) + NIST_C(21) + 2*NIST_C(22) + NIST_C(23) - NIST_C(16);
+		NISTSignedWord a6 = NIST_C(6) + NIST_C(14) + NIST_C(15) + NIST_C(18) + NIST_C(22) + 2*NIST_C(23) - NIST_C(17);
+		NISTSignedWord a7 = NIST_C(7) + NIST_C(15) + NIST_C(16) + NIST_C(19) + NIST_C(23) - NIST_C(18);
+		NISTSignedWord a8 = NIST_C(8) + NIST_C(16) + NIST_C(17) + NIST_C(20) - NIST_C(19);
+		NISTSignedWord a9 = NIST_C(9) + NIST_C(17) + NIST_C(18) + NIST_C(21) - NIST_C(20);
+		NISTSignedWord a10 = NIST_C(10) + NIST_C(18) + NIST_C(19) + NIST_C(22) - NIST_C(21);
+		NISTSignedWord a11 = NIST_C(11) + NIST_C(19) + NIST_C(20) + NIST_C(23) - NIST_C(22);
+
+		// 2^384 = 2^128 + 2^96 - 2^32 + 1 mod p
+		NISTSignedWord u;
+#define NIST_PROPAGATE	u = 0; NIST_CARRY(a0) NIST_CARRY(a1) NIST_CARRY(a2) NIST_CARRY(a3) NIST_CARRY(a4) NIST_CARRY(a5) \
+						NIST_CARRY(a6) NIST_CARRY(a7) NIST_CARRY(a8) NIST_CARRY(a9) NIST_CARRY(a10) NIST_CARRY(a11)
+		NIST_PROPAGATE a0 += u; a1 -= u; a3 += u; a4 += u;
+		NIST_PROPAGATE a0 += u; a1 -= u; a3 += u; a4 += u;
+		NIST_PROPAGATE
+#undef NIST_PROPAGATE
+
+		r[0] = NIST_PACK(a0, a1);
+		r[1] = NIST_PACK(a2, a3);
+		r[2] = NIST_PACK(a4, a5);
+		r[3] = NIST_PACK(a6, a7);
+		r[4] = NIST_PACK(a8, a9);
+		r[5] = NIST_PACK(a10, a11);
+	}
+};
+
+const word64 NISTP384::P[] = {W64LIT(0x00000000ffffffff), W64LIT(0xffffffff00000000), W64LIT(0xfffffffffffffffe), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff), W64LIT(0xffffffffffffffff)};
+
+//! a point is X, Y and Z of N words each, the identity has Z = 0
+template <class C>
+class NISTPrimeCurveImpl : public NISTPrimeCurve
+{
+public:
+	enum {N = C::WORDS, POINT = 3*C::WORDS, WINDOW = 4, TABLE = 1 << WINDOW};
+
+	NISTPrimeCurveImpl()
+		: m_p(C::Modulus()), m_b(C::CoefficientB()), m_n(C::SubgroupOrder())
+	{
+		ToWords(m_bw, m_b);
+	}
+
+	bool Matches(const Integer &p, const Integer &a, const Integer &b) const
+		{return p == m_p && b == m_b && a == m_p - 3;}
+
+	bool ScalarMultiply(ECPPoint &result, const ECPPoint &P, const Integer &k) const
+	{
+		FixedSizeSecBlock<word64, TABLE*POINT> table;
+		if (!BuildTable(table, P))
+			return false;
+
+		FixedSizeSecBlock<word64, N> e;
+		ReduceScalar(e, k);
+
+		FixedSizeSecBlock<word64, POINT> R, T;
+		memset(R, 0, POINT*sizeof(word64));
+		for (int i=64*N/WINDOW-1; i>=0; i--)
+		{
+			for (unsigned int j=0; j<WINDOW; j++)
+				Double(R, R);
+			Select(T, table, word32(e[i/(64/WINDOW)] >> (WINDOW*(i%(64/WINDOW)))) & (TABLE-1));
+			Add(R, R, T);
+		}
+
+		ToAffine(result, R);
+		return true;
+	}
+
+	bool CascadeScalarMultiply(ECPPoint &result, const ECPPoint &P, const Integer &k1, const ECPPoint &Q, const Integer &k2) const
+	{
+		word64 tableP[TABLE*POINT], tableQ[TABLE*POINT];
+		if (!BuildTable(tableP, P) || !BuildTable(tableQ, Q))
+			return false;
+
+		word64 e1[N], e2[N], R[POINT];
+		ReduceScalar(e1, k1);
+		ReduceScalar(e2, k2);
+
+		memset(R, 0, sizeof(R));
+		for (int i=64*N/WINDOW-1; i>=0; i--)
+		{
+			if (!NIST_ZeroMask(R+2*N, N))
+				for (unsigned int j=0; j<WINDOW; j++)
+					Double(R, R);
+			const unsigned int shift = WINDOW*(i%(64/WINDOW));
+			const unsigned int d1 = (unsigned int)(e1[i/(64/WINDOW)] >> shift) & (TABLE-1);
+			const unsigned int d2 = (unsigned int)(e2[i/(64/WINDOW)] >> shift) & (TABLE-1);
+			if (d1)
+				AddVariableTime(R, R, tableP+d1*POINT);
+			if (d2)
+				AddVariableTime(R, R, tableQ+d2*POINT);
+		}
+
+		ToAffine(result, R);
+		return true;
+	}
+
+	bool MultiplyBase(ECPPoint &result, const ECPCombTable &table, const Integer &k) const
+	{
+		if (table.words != N)
+			return false;
+
+		FixedSizeSecBlock<word64, N> e;
+		ReduceScalar(e, k);
+
+		FixedSizeSecBlock<word64, POINT> R, T;
+		memset(R, 0, POINT*sizeof(word64));
+		for (int column=table.spacing-1; column>=0; column--)
+		{
+			Double(R, R);
+			for (unsigned int c=0; c<ECPCombTable::COMBS; c++)
+			{
+				word32 j = 0;
+				for (unsigned int i=0; i<ECPCombTable::TEETH; i++)
+				{
+					const unsigned int bit = (c*ECPCombTable::TEETH+i)*table.spacing + column;
+					if (bit < 64*N)
+						j |= word32(e[bit/64] >> (bit%64) & 1) << i;
+				}
+				SelectAffine(T, table.GetPoint(c, 1), j);
+				Add(R, R, T);
+			}
+		}
+
+		ToAffine(result, R);
+		return true;
+	}
+
+private:
+	// ********************************************************
+
+	static void ToWords(word64 *r, const Integer &x)
+	{
+		for (unsigned int i=0; i<N; i++)
+		{
+			r[i] = 0;
+			for (unsigned int j=0; j<8; j++)
+				r[i] |= word64(x.GetByte(8*i+j)) << (8*j);
+		}
+	}
+
+	static Integer FromWords(const word64 *a)
+	{
+		byte buf[8*N];
+		for (unsigned int i=0; i<N; i++)
+			for (unsigned int j=0; j<8; j++)
+				buf[8*N-1-8*i-j] = byte(a[i] >> (8*j));
+		return Integer(buf, sizeof(buf));
+	}
+
+	// the word loops of the field operations are written out, the compiler drops the last two words for P-256
+#define NIST_UNROLL(M)	M(0) M(1) M(2) M(3) if (N > 4) {M(4) M(5)}
+
+	// r = a - P if that does not borrow, a otherwise
+	static void ConditionalSubtractP(word64 *r, const word64 *a, word64 carry)
+	{
+		word64 d[6], borrow = 0;
+#define NIST_SUB_P(i)	d[i] = NIST_SubtractWithBorrow(a[i], C::P[i], borrow);
+#define NIST_SELECT(i)	r[i] = (a[i] & keep) | (d[i] & ~keep);
+		NIST_UNROLL(NIST_SUB_P)
+		const word64 keep = 0 - (borrow & (carry ^ 1));
+		NIST_UNROLL(NIST_SELECT)
+	}
+
+	static void AddMod(word64 *r, const word64 *a, const word64 *b)
+	{
+		word64 s[6], carry = 0;
+#define NIST_ADD(i)		s[i] = NIST_AddWithCarry(a[i], b[i], carry);
+		NIST_UNROLL(NIST_ADD)
+		ConditionalSubtractP(r, s, carry);
+	}
+
+	static void SubtractMod(word64 *r, const word64 *a, const word64 *b)
+	{
+		word64 d[6], borrow = 0, carry = 0;
+#define NIST_SUB(i)		d[i] = NIST_SubtractWithBorrow(a[i], b[i], borrow);
+#define NIST_ADD_P(i)	r[i] = NIST_AddWithCarry(d[i], C::P[i] & mask, carry);
+		NIST_UNROLL(NIST_SUB)
+		const word64 mask = 0 - borrow;
+		NIST_UNROLL(NIST_ADD_P)
+	}
+
+	static void MultiplyMod(word64 *r, const word64 *a, const word64 *b)
+	{
+		word64 s[N];
+		C::Multiply(s, a, b);
+		ConditionalSubtractP(r, s, 0);
+	}
+
+	static void SquareMod(word64 *r, const word64 *a)
+	{
+		MultiplyMod(r, a, a);
+	}
+
+	// a^(p-2) with a fixed sequence of operations
+	static void InverseMod(word64 *r, const word64 *a)
+	{
+		word64 e[N], t[N], u[N];
+		memcpy(e, C::P, sizeof(e));
+		e[0] -= 2;
+		memcpy(t, a, sizeof(t));
+		for (int i=64*N-2; i>=0; i--)
+		{
+			SquareMod(t, t);
+			MultiplyMod(u, t, a);
+			if ((e[i/64] >> (i%64)) & 1)
+				memcpy(t, u, sizeof(t));
+		}
+		memcpy(r, t, sizeof(t));
+	}
+
+	// ********************************************************
+
+	// dbl-2001-b, a = -3, the identity doubles to itself
+	static void Double(word64 *r, const word64 *p)
+	{
+		const word64 *x = p, *y = p+N, *z = p+2*N;
+		word64 delta[N], gamma[N], beta[N], alpha[N], t[N], u[N];
+
+		SquareMod(delta, z);
+		SquareMod(gamma, y);
+		MultiplyMod(beta, x, gamma);
+		SubtractMod(t, x, delta);
+		AddMod(u, x, delta);
+		MultiplyMod(alpha, t, u);
+		AddMod(t, alpha, alpha);
+		AddMod(alpha, alpha, t);
+
+		AddMod(t, y, z);
+		SquareMod(t, t);
+		SubtractMod(t, t, gamma);
+		SubtractMod(r+2*N, t, delta);
+
+		AddMod(beta, beta, beta);
+		AddMod(beta, beta, beta);
+		SquareMod(t, alpha);
+		AddMod(u, beta, beta);
+		SubtractMod(r, t, u);
+
+		SubtractMod(t, beta, r);
+		MultiplyMod(t, alpha, t);
+		SquareMod(gamma, gamma);
+		AddMod(gamma, gamma, gamma);
+		AddMod(gamma, gamma, gamma);
+		AddMod(gamma, gamma, gamma);
+		SubtractMod(r+N, t, gamma);
+	}
+
+	// add-2007-bl, sets h = U2-U1 and s = S2-S1 so the caller can detect P = Q
+	static void AddGeneric(word64 *r, const word64 *p, const word64 *q, word64 *h, word64 *s)
+	{
+		word64 z1z1[N], z2z2[N], u1[N], u2[N], s1[N], s2[N], i[N], j[N], v[N], x3[N], y3[N], z3[N];
+
+		SquareMod(z1z1, p+2*N);
+		SquareMod(z2z2, q+2*N);
+		MultiplyMod(u1, p, z2z2);
+		MultiplyMod(u2, q, z1z1);
+		MultiplyMod(s1, p+N, q+2*N);
+		MultiplyMod(s1, s1, z2z2);
+		MultiplyMod(s2, q+N, p+2*N);
+		MultiplyMod(s2, s2, z1z1);
+		SubtractMod(h, u2, u1);
+		SubtractMod(s, s2, s1);
+
+		AddMod(i, h, h);
+		SquareMod(i, i);
+		MultiplyMod(j, h, i);
+		AddMod(s2, s, s);
+		MultiplyMod(v, u1, i);
+
+		SquareMod(x3, s2);
+		SubtractMod(x3, x3, j);
+		SubtractMod(x3, x3, v);
+		SubtractMod(x3, x3, v);
+
+		SubtractMod(y3, v, x3);
+		MultiplyMod(y3, y3, s2);
+		MultiplyMod(s1, s1, j);
+		AddMod(s1, s1, s1);
+		SubtractMod(y3, y3, s1);
+
+		AddMod(z3, p+2*N, q+2*N);
+		SquareMod(z3, z3);
+		SubtractMod(z3, z3, z1z1);
+		SubtractMod(z3, z3, z2z2);
+		MultiplyMod(z3, z3, h);
+
+		memcpy(r, x3, sizeof(x3));
+		memcpy(r+N, y3, sizeof(y3));
+		memcpy(r+2*N, z3, sizeof(z3));
+	}
+
+	static void Copy(word64 *r, const word64 *a, word64 mask)
+	{
+		for (unsigned int i=0; i<POINT; i++)
+			r[i] = (a[i] & mask) | (r[i] & ~mask);
+	}
+
+	// P + Q for P != Q, either of them may be the identity
+	static void Add(word64 *r, const word64 *p, const word64 *q)
+	{
+		const word64 pz = NIST_ZeroMask(p+2*N, N), qz = NIST_ZeroMask(q+2*N, N);
+		word64 sum[POINT], pc[POINT], h[N], s[N];
+		memcpy(pc, p, sizeof(pc));
+		AddGeneric(sum, p, q, h, s);
+		Copy(sum, pc, qz);
+		Copy(sum, q, pz);
+		memcpy(r, sum, sizeof(sum));
+	}
+
+	static void AddVariableTime(word64 *r, const word64 *p, const word64 *q)
+	{
+		if (NIST_ZeroMask(p+2*N, N))
+			memcpy(r, q, POINT*sizeof(word64));
+		else if (!NIST_ZeroMask(q+2*N, N))
+		{
+			word64 sum[POINT], h[N], s[N];
+			AddGeneric(sum, p, q, h, s);
+			if (NIST_ZeroMask(h, N))
+			{
+				if (NIST_ZeroMask(s, N))
+					Double(r, q);
+				else
+					memset(r, 0, POINT*sizeof(word64));
+			}
+			else
+				memcpy(r, sum, sizeof(sum));
+		}
+		else if (r != p)
+			memcpy(r, p, POINT*sizeof(word64));
+	}
+
+	// reads every entry so the memory access pattern does not depend on the index
+	static void Select(word64 *r, const word64 *table, word32 index)
+	{
+		memset(r, 0, POINT*sizeof(word64));
+		for (word32 i=0; i<TABLE; i++)
+		{
+			const word64 mask = 0 - word64(((i ^ index) - 1) >> 31);
+			for (unsigned int j=0; j<POINT; j++)
+				r[j] |= table[i*POINT+j] & mask;
+		}
+	}
+
+	// entry index-1 of a table of affine points with Z = 1, or the identity for index 0
+	static void SelectAffine(word64 *r, const word64 *table, word32 index)
+	{
+		memset(r, 0, POINT*sizeof(word64));
+		for (word32 i=1; i<=ECPCombTable::ENTRIES; i++)
+		{
+			const word64 mask = 0 - word64(((i ^ index) - 1) >> 31);
+			for (unsigned int j=0; j<2*N; j++)
+				r[j] |= table[(i-1)*2*N+j] & mask;
+		}
+		r[2*N] = word64((0 - index) >> 31);
+	}
+
+	// ********************************************************
+
+	bool ToJacobian(word64 *r, const ECPPoint &P) const
+	{
+		if (P.x.IsNegative() || P.x >= m_p || P.y.IsNegative() || P.y >= m_p)
+			return false;
+
+		ToWords(r, P.x);
+		ToWords(r+N, P.y);
+		memset(r+2*N, 0, N*sizeof(word64));
+		r[2*N] = 1;
+
+		// y^2 = (x^2 - 3)x + b
+		word64 t[N], u[N], three[N] = {3};
+		SquareMod(t, r);
+		SubtractMod(t, t, three);
+		MultiplyMod(t, t, r);
+		AddMod(t, t, m_bw);
+		SquareMod(u, r+N);
+		return memcmp(t, u, sizeof(t)) == 0;
+	}
+
+	void ToAffine(ECPPoint &result, const word64 *p) const
+	{
+		if (NIST_ZeroMask(p+2*N, N))
+		{
+			result = ECPPoint();
+			return;
+		}
+
+		word64 zi[N], zi2[N], x[N], y[N];
+		InverseMod(zi, p+2*N);
+		SquareMod(zi2, zi);
+		MultiplyMod(x, p, zi2);
+		MultiplyMod(zi2, zi2, zi);
+		MultiplyMod(y, p+N, zi2);
+		result.identity = false;
+		result.x = FromWords(x);
+		result.y = FromWords(y);
+	}
+
+	void ReduceScalar(word64 *r, const Integer &k) const
+	{
+		if (k.IsNegative() || k >= m_n)
+			ToWords(r, k % m_n);
+		else
+			ToWords(r, k);
+	}
+
+	// 0, P, 2P, ..., 15P
+	bool BuildTable(word64 *table, const ECPPoint &P) const
+	{
+		memset(table, 0, TABLE*POINT*sizeof(word64));
+		if (P.identity)
+			return true;
+		if (!ToJacobian(table+POINT, P))
+			return false;
+		Double(table+2*POINT, table+POINT);
+		for (unsigned int i=3; i<TABLE; i++)
+			Add(table+i*POINT, table+(i-1)*POINT, table+POINT);
+		return true;
+	}
+
+	Integer m_p, m_b, m_n;
+	word64 m_bw[N];
+};
+
+const NISTPrimeCurve * NISTPrimeCurve::Find(const Integer &p, const Integer &a, const Integer &b)
+{
+	if (p.BitCount() == 256)
+	{
+		const NISTPrimeCurveImpl<NISTP256> &curve = Singleton<NISTPrimeCurveImpl<NISTP256> >().Ref();
+		if (curve.Matches(p, a, b))
+			return &curve;
+	}
+	else if (p.BitCount() == 384)
+	{
+		const NISTPrimeCurveImpl<NISTP384> &curve = Singleton<NISTPrimeCurveImpl<NISTP384> >().Ref();
+		if (curve.Matches(p, a, b))
+			return &curve;
+	}
+	return NULL;
+}
+
+NAMESPACE_END
+
+#endif
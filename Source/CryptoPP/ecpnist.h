@@ -0,0 +1,36 @@
+#ifndef CRYPTOPP_ECPNIST_H
+#define CRYPTOPP_ECPNIST_H
+
+// implementations are in ecpnist.cpp
+
+#include "integer.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+struct ECPPoint;
+struct ECPCombTable;
+
+//! scalar multiplication on NIST P-256 and P-384 in fixed width 64-bit limbs
+/*! Field elements are 4 or 6 words reduced with the Solinas identities of FIPS 186-4 D.2,
+	points are kept in Jacobian coordinates until the final conversion to affine.
+	ECP uses these for curves with a matching modulus and coefficients.
+	\note both curves have cofactor 1, so scalars are reduced modulo the group order first */
+class CRYPTOPP_DLL CRYPTOPP_NO_VTABLE NISTPrimeCurve
+{
+public:
+	virtual ~NISTPrimeCurve() {}
+
+	//! returns the arithmetic for y^2 = x^3 + ax + b over GF(p) if that is P-256 or P-384, NULL otherwise
+	static const NISTPrimeCurve * Find(const Integer &p, const Integer &a, const Integer &b);
+
+	//! returns k*P computed with a fixed window and constant time table lookups, or false if P is not on the curve
+	virtual bool ScalarMultiply(ECPPoint &result, const ECPPoint &P, const Integer &k) const =0;
+	//! returns k1*P + k2*Q in variable time for public scalars, or false if P or Q is not on the curve
+	virtual bool CascadeScalarMultiply(ECPPoint &result, const ECPPoint &P, const Integer &k1, const ECPPoint &Q, const Integer &k2) const =0;
+	//! returns k*G for the generator G of a comb table of this curve, reading the table with constant time lookups
+	virtual bool MultiplyBase(ECPPoint &result, const ECPCombTable &table, const Integer &k) const =0;
+};
+
+NAMESPACE_END
+
+#endif
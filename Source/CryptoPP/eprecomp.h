@@ -57,7 +57,7 @@ public:
 	Element Exponentiate(const DL_GroupPrecomputation<Element> &group, const Integer &exponent) const;
 	Element CascadeExponentiate(const DL_GroupPrecomputation<Element> &group, const Integer &exponent, const DL_FixedBasePrecomputation<Element> &pc2, const Integer &exponent2) const;
 
-private:
+protected:
 	void PrepareCascade(const DL_GroupPrecomputation<Element> &group, std::vector<BaseAndExponent<Element> > &eb, const Integer &exponent) const;
 
 	Element m_base;
@@ -8,6 +8,15 @@
 
 #include <limits>
 
+#ifdef CRYPTOPP_WIN32_AVAILABLE
+#include <windows.h>
+#elif defined(CRYPTOPP_UNIX_AVAILABLE)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 NAMESPACE_BEGIN(CryptoPP)
 
 using namespace std;
@@ -239,7 +248,7 @@ size_t FileSink::Put2(const byte *inString, size_t length, int messageEnd, bool
 	{
 		std::streamsize size;
 		if (!SafeConvert(length, size))
-			size = numeric_limits<std::streamsize>::max();
+			size = (numeric_limits<std::streamsize>::max)();	// windows.h may define max
 		m_stream->write((const char *)inString, size);
 		inString += size;
 		length -= (size_t)size;
@@ -254,6 +263,67 @@ size_t FileSink::Put2(const byte *inString, size_t length, int messageEnd, bool
 	return 0;
 }
 
+MappedFile::MappedFile(const char *filename)
+	: m_data(NULL), m_size(0)
+{
+#ifdef CRYPTOPP_WIN32_AVAILABLE
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		throw OpenErr(filename);
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || !SafeConvert(size.QuadPart, m_size))
+	{
+		CloseHandle(file);
+		throw MapErr(filename);
+	}
+	if (m_size)
+	{
+		// the view keeps the mapping and the file open after their handles are closed
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping)
+		{
+			m_data = (const byte *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	if (m_size && !m_data)
+		throw MapErr(filename);
+#elif defined(CRYPTOPP_UNIX_AVAILABLE)
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		throw OpenErr(filename);
+	struct stat st;
+	if (fstat(fd, &st) < 0 || !SafeConvert(st.st_size, m_size))
+	{
+		close(fd);
+		throw MapErr(filename);
+	}
+	if (m_size)
+	{
+		void *p = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (p != MAP_FAILED)
+			m_data = (const byte *)p;
+	}
+	close(fd);
+	if (m_size && !m_data)
+		throw MapErr(filename);
+#else
+	throw NotImplemented("MappedFile: memory mapped files are not available on this platform");
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	if (!m_data)
+		return;
+#ifdef CRYPTOPP_WIN32_AVAILABLE
+	UnmapViewOfFile(m_data);
+#elif defined(CRYPTOPP_UNIX_AVAILABLE)
+	munmap((void *)m_data, m_size);
+#endif
+}
+
 NAMESPACE_END
 
 #endif
@@ -107,6 +107,32 @@ private:
 	std::ostream *m_stream;
 };
 
+//! read only memory mapping of a whole file
+/*! The pages belong to the file, so every process that maps it, or is forked after it was
+	mapped, shares one copy of them. The mapping is removed when the object is destroyed. */
+class CRYPTOPP_DLL MappedFile : public NotCopyable
+{
+public:
+	class Err : public Exception
+	{
+	public:
+		Err(const std::string &s) : Exception(IO_ERROR, s) {}
+	};
+	class OpenErr : public Err {public: OpenErr(const std::string &filename) : Err("MappedFile: error opening file for mapping: " + filename) {}};
+	class MapErr : public Err {public: MapErr(const std::string &filename) : Err("MappedFile: error mapping file: " + filename) {}};
+
+	MappedFile(const char *filename);
+	~MappedFile();
+
+	//! the contents of the file, aligned on a page boundary
+	const byte * GetData() const {return m_data;}
+	size_t GetSize() const {return m_size;}
+
+private:
+	const byte *m_data;
+	size_t m_size;
+};
+
 NAMESPACE_END
 
 #endif
@@ -9,6 +9,7 @@
 
 #include "gcm.h"
 #include "cpu.h"
+#include "rijndael.h"
 
 NAMESPACE_BEGIN(CryptoPP)
 
@@ -125,6 +126,150 @@ inline __m128i CLMUL_GF_Mul(const __m128i &x, const __m128i &h, const __m128i &r
 
 	return CLMUL_Reduce(c0, c1, c2, r);
 }
+
+static const unsigned int s_stitchedBlocks = 8;
+
+// adds the product of d with a power of the hash key to c0, c1, c2, c1 uses Karatsuba and needs c0 and c2 added before reduction
+inline void CLMUL_Accumulate(const __m128i &d, const __m128i &h, const __m128i &hk, __m128i &c0, __m128i &c1, __m128i &c2)
+{
+	c0 = _mm_xor_si128(c0, _mm_clmulepi64_si128(d, h, 0));
+	c2 = _mm_xor_si128(c2, _mm_clmulepi64_si128(d, h, 0x11));
+	c1 = _mm_xor_si128(c1, _mm_clmulepi64_si128(_mm_xor_si128(d, _mm_srli_si128(d, 8)), hk, 0));
+}
+
+inline __m128i CLMUL_Reduce_Karatsuba(const __m128i &c0, __m128i c1, const __m128i &c2, const __m128i &r)
+{
+	c1 = _mm_xor_si128(_mm_xor_si128(c1, c0), c2);
+	return CLMUL_Reduce(c0, c1, c2, r);
+}
+
+// the hashed blocks are reversed like the hash buffer, the first block of a group absorbs the previous hash value
+inline __m128i CLMUL_LoadHashBlock(const byte *block, const __m128i &bswapMask)
+{
+	return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), bswapMask);
+}
+
+#define GCM_AESENC_8_BLOCKS(rk)	\
+	b0 = _mm_aesenc_si128(b0, rk); b1 = _mm_aesenc_si128(b1, rk); b2 = _mm_aesenc_si128(b2, rk); b3 = _mm_aesenc_si128(b3, rk);	\
+	b4 = _mm_aesenc_si128(b4, rk); b5 = _mm_aesenc_si128(b5, rk); b6 = _mm_aesenc_si128(b6, rk); b7 = _mm_aesenc_si128(b7, rk);
+
+#define GCM_GHASH_BLOCK(j)	\
+	CLMUL_Accumulate(CLMUL_LoadHashBlock(hashBlocks+16*j, bswapMask), h[7-j], hk[7-j], c0, c1, c2);
+
+#define GCM_STITCHED_ROUND(j)	\
+	rk = subkeys[j+1];	\
+	GCM_AESENC_8_BLOCKS(rk)	\
+	GCM_GHASH_BLOCK(j)
+
+/* Encrypts or decrypts blocks (a multiple of s_stitchedBlocks) in GCM's CTR mode and hashes the ciphertext in the same pass.
+	The multiplications for one group of ciphertext blocks run between the AES rounds of the next group of counter blocks,
+	decryption hashes the group it decrypts, encryption the group it produced in the previous iteration. */
+static void AESNI_CLMUL_GCTR_GHASH(const __m128i *subkeys, unsigned int rounds, byte *counter, const __m128i *mulTable, __m128i *hashBuffer, const byte *inBlocks, byte *outBlocks, size_t blocks, bool encrypting)
+{
+	const __m128i r = s_clmulConstants[0], bswapMask = s_clmulConstants[1];
+
+	// the table stores the low and the high halves of two consecutive powers in two blocks
+	__m128i h[s_stitchedBlocks], hk[s_stitchedBlocks];
+	unsigned int i;
+	for (i=0; i<s_stitchedBlocks; i+=2)
+	{
+		const __m128i t0 = _mm_load_si128(mulTable+i), t1 = _mm_load_si128(mulTable+i+1);
+		h[i] = _mm_unpacklo_epi64(t0, t1);
+		h[i+1] = _mm_unpackhi_epi64(t0, t1);
+	}
+	for (i=0; i<s_stitchedBlocks; i++)
+		hk[i] = _mm_xor_si128(h[i], _mm_srli_si128(h[i], 8));
+
+	__m128i x = _mm_load_si128(hashBuffer), c0, c1, c2, rk;
+	// the last 32 bits of the counter block are a big endian counter, inc32 is done in reversed byte order
+	__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)counter), bswapMask);
+	const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+	const byte *hashBlocks = encrypting ? NULL : inBlocks;
+
+	while (blocks)
+	{
+		__m128i b0 = _mm_shuffle_epi8(ctr, bswapMask);
+		__m128i b1 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		__m128i b2 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		__m128i b3 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		__m128i b4 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		__m128i b5 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		__m128i b6 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		__m128i b7 = _mm_shuffle_epi8(ctr = _mm_add_epi32(ctr, one), bswapMask);
+		ctr = _mm_add_epi32(ctr, one);
+
+		rk = subkeys[0];
+		b0 = _mm_xor_si128(b0, rk); b1 = _mm_xor_si128(b1, rk); b2 = _mm_xor_si128(b2, rk); b3 = _mm_xor_si128(b3, rk);
+		b4 = _mm_xor_si128(b4, rk); b5 = _mm_xor_si128(b5, rk); b6 = _mm_xor_si128(b6, rk); b7 = _mm_xor_si128(b7, rk);
+
+		if (hashBlocks)
+		{
+			// AES has at least 10 rounds, so each of the first 8 hides one multiplication
+			c0 = c1 = c2 = _mm_setzero_si128();
+			rk = subkeys[1];
+			GCM_AESENC_8_BLOCKS(rk)
+			CLMUL_Accumulate(_mm_xor_si128(CLMUL_LoadHashBlock(hashBlocks, bswapMask), x), h[7], hk[7], c0, c1, c2);
+			GCM_STITCHED_ROUND(1)
+			GCM_STITCHED_ROUND(2)
+			GCM_STITCHED_ROUND(3)
+			GCM_STITCHED_ROUND(4)
+			GCM_STITCHED_ROUND(5)
+			GCM_STITCHED_ROUND(6)
+			GCM_STITCHED_ROUND(7)
+			x = CLMUL_Reduce_Karatsuba(c0, c1, c2, r);
+		}
+		else
+		{
+			for (i=1; i<=s_stitchedBlocks; i++)
+			{
+				rk = subkeys[i];
+				GCM_AESENC_8_BLOCKS(rk)
+			}
+		}
+
+		for (i=s_stitchedBlocks+1; i<rounds; i++)
+		{
+			rk = subkeys[i];
+			GCM_AESENC_8_BLOCKS(rk)
+		}
+		rk = subkeys[rounds];
+		_mm_storeu_si128((__m128i *)outBlocks, _mm_xor_si128(_mm_aesenclast_si128(b0, rk), _mm_loadu_si128((const __m128i *)inBlocks)));
+		_mm_storeu_si128((__m128i *)(outBlocks+16), _mm_xor_si128(_mm_aesenclast_si128(b1, rk), _mm_loadu_si128((const __m128i *)(inBlocks+16))));
+		_mm_storeu_si128((__m128i *)(outBlocks+32), _mm_xor_si128(_mm_aesenclast_si128(b2, rk), _mm_loadu_si128((const __m128i *)(inBlocks+32))));
+		_mm_storeu_si128((__m128i *)(outBlocks+48), _mm_xor_si128(_mm_aesenclast_si128(b3, rk), _mm_loadu_si128((const __m128i *)(inBlocks+48))));
+		_mm_storeu_si128((__m128i *)(outBlocks+64), _mm_xor_si128(_mm_aesenclast_si128(b4, rk), _mm_loadu_si128((const __m128i *)(inBlocks+64))));
+		_mm_storeu_si128((__m128i *)(outBlocks+80), _mm_xor_si128(_mm_aesenclast_si128(b5, rk), _mm_loadu_si128((const __m128i *)(inBlocks+80))));
+		_mm_storeu_si128((__m128i *)(outBlocks+96), _mm_xor_si128(_mm_aesenclast_si128(b6, rk), _mm_loadu_si128((const __m128i *)(inBlocks+96))));
+		_mm_storeu_si128((__m128i *)(outBlocks+112), _mm_xor_si128(_mm_aesenclast_si128(b7, rk), _mm_loadu_si128((const __m128i *)(inBlocks+112))));
+
+		hashBlocks = encrypting ? outBlocks : inBlocks+16*s_stitchedBlocks;
+		inBlocks += 16*s_stitchedBlocks;
+		outBlocks += 16*s_stitchedBlocks;
+		blocks -= s_stitchedBlocks;
+	}
+
+	if (encrypting)
+	{
+		// the last group of ciphertext has no AES work left to hide behind
+		c0 = c1 = c2 = _mm_setzero_si128();
+		CLMUL_Accumulate(_mm_xor_si128(CLMUL_LoadHashBlock(hashBlocks, bswapMask), x), h[7], hk[7], c0, c1, c2);
+		GCM_GHASH_BLOCK(1)
+		GCM_GHASH_BLOCK(2)
+		GCM_GHASH_BLOCK(3)
+		GCM_GHASH_BLOCK(4)
+		GCM_GHASH_BLOCK(5)
+		GCM_GHASH_BLOCK(6)
+		GCM_GHASH_BLOCK(7)
+		x = CLMUL_Reduce_Karatsuba(c0, c1, c2, r);
+	}
+
+	_mm_store_si128(hashBuffer, x);
+	_mm_storeu_si128((__m128i *)counter, _mm_shuffle_epi8(ctr, bswapMask));
+}
+
+#undef GCM_AESENC_8_BLOCKS
+#undef GCM_GHASH_BLOCK
+#undef GCM_STITCHED_ROUND
 #endif
 
 void GCM_Base::SetKeyWithoutResync(const byte *userKey, size_t keylength, const NameValuePairs &params)
@@ -336,6 +481,40 @@ unsigned int GCM_Base::OptimalDataAlignment() const
 		GetBlockCipher().OptimalDataAlignment();
 }
 
+void GCM_Base::ProcessData(byte *outString, const byte *inString, size_t length)
+{
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+	const Rijndael::Encryption *aes;
+	if (length >= s_stitchedBlocks*REQUIRED_BLOCKSIZE && HasCLMUL() && HasAESNI()
+		&& (aes = dynamic_cast<const Rijndael::Encryption *>(&GetBlockCipher())) != NULL)
+	{
+		// the base class finishes the header and uses up buffered keystream, after that CTR and GHASH are both at a block boundary
+		size_t len = UnsignedMin(length, m_ctr.GetOptimalNextBlockSize());
+		AuthenticatedSymmetricCipherBase::ProcessData(outString, inString, len);
+		inString += len;
+		outString += len;
+		length -= len;
+
+		len = length - length%(s_stitchedBlocks*REQUIRED_BLOCKSIZE);
+		if (len)
+		{
+			m_totalMessageLength += len;
+			if (m_totalMessageLength > MaxMessageLength())
+				throw InvalidArgument(AlgorithmName() + ": message length exceeds maximum");
+
+			unsigned int rounds;
+			const __m128i *subkeys = (const __m128i *)aes->GetAESNIRoundKeys(rounds);
+			AESNI_CLMUL_GCTR_GHASH(subkeys, rounds, m_ctr.CounterArray(), (const __m128i *)MulTable(), (__m128i *)HashBuffer(), inString, outString, len/REQUIRED_BLOCKSIZE, IsForwardTransformation());
+			inString += len;
+			outString += len;
+			length -= len;
+		}
+	}
+#endif
+
+	AuthenticatedSymmetricCipherBase::ProcessData(outString, inString, length);
+}
+
 #pragma warning(disable: 4731)	// frame pointer register 'ebp' modified by inline assembly code
 
 #endif	// #ifndef CRYPTOPP_GENERATE_X64_MASM
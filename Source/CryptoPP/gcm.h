@@ -41,6 +41,8 @@ public:
 		{return (W64LIT(1)<<61)-1;}
 	lword MaxMessageLength() const
 		{return ((W64LIT(1)<<39)-256)/8;}
+	//! runs CTR and GHASH in one pass for AES on AES-NI and CLMUL hardware
+	void ProcessData(byte *outString, const byte *inString, size_t length);
 
 protected:
 	// AuthenticatedSymmetricCipherBase
@@ -67,6 +69,8 @@ protected:
 
 	class CRYPTOPP_DLL GCTR : public CTR_Mode_ExternalCipher::Encryption
 	{
+	public:
+		byte * CounterArray() {return m_counterArray;}
 	protected:
 		void IncrementCounterBy256();
 	};
@@ -113,10 +113,10 @@ public:
 		{return !operator==(rhs);}
 };
 
-CRYPTOPP_DLL_TEMPLATE_CLASS DL_GroupParameters_IntegerBasedImpl<ModExpPrecomputation>;
+CRYPTOPP_DLL_TEMPLATE_CLASS DL_GroupParameters_IntegerBasedImpl<ModExpPrecomputation, ModExpFixedBasePrecomputation>;
 
 //! GF(p) group parameters
-class CRYPTOPP_DLL DL_GroupParameters_GFP : public DL_GroupParameters_IntegerBasedImpl<ModExpPrecomputation>
+class CRYPTOPP_DLL DL_GroupParameters_GFP : public DL_GroupParameters_IntegerBasedImpl<ModExpPrecomputation, ModExpFixedBasePrecomputation>
 {
 public:
 	// DL_GroupParameters
@@ -133,6 +133,14 @@ public:
 	Element MultiplyElements(const Element &a, const Element &b) const;
 	Element CascadeExponentiate(const Element &element1, const Integer &exponent1, const Element &element2, const Integer &exponent2) const;
 
+	//! writes the precomputation of the generator in the word aligned format of ModExpFixedBasePrecomputation
+	void SaveMappablePrecomputation(BufferedTransformation &storedPrecomputation) const
+		{m_gpc.SaveMappable(GetGroupPrecomputation(), storedPrecomputation);}
+	//! exponentiates the generator with a precomputation written by SaveMappablePrecomputation(), used in place
+	/*! \note data must stay valid, for instance in a MappedFile, while these parameters or copies of them are in use */
+	void LoadMappedPrecomputation(const byte *data, size_t size)
+		{m_gpc.LoadMapped(GetGroupPrecomputation(), data, size); ParametersChanged();}
+
 protected:
 	int GetFieldType() const {return 1;}
 };
@@ -12,6 +12,7 @@
 #include <sys/time.h>
 #include <sys/times.h>
 #include <unistd.h>
+#include <errno.h>
 #endif
 
 #include <assert.h>
@@ -65,6 +66,11 @@ TimerWord Timer::GetCurrentTimerValue()
 	if (!QueryPerformanceCounter(&now))
 		throw Exception(Exception::OTHER_ERROR, "Timer: QueryPerformanceCounter failed with error " + IntToString(GetLastError()));
 	return now.QuadPart;
+#elif defined(CRYPTOPP_UNIX_AVAILABLE) && defined(CLOCK_MONOTONIC)
+	timespec now;
+	if (clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+		throw Exception(Exception::OTHER_ERROR, "Timer: clock_gettime failed with error " + IntToString(errno));
+	return (TimerWord)now.tv_sec * 1000*1000*1000 + now.tv_nsec;
 #elif defined(CRYPTOPP_UNIX_AVAILABLE)
 	timeval now;
 	gettimeofday(&now, NULL);
@@ -85,6 +91,8 @@ TimerWord Timer::TicksPerSecond()
 			throw Exception(Exception::OTHER_ERROR, "Timer: QueryPerformanceFrequency failed with error " + IntToString(GetLastError()));
 	}
 	return freq.QuadPart;
+#elif defined(CRYPTOPP_UNIX_AVAILABLE) && defined(CLOCK_MONOTONIC)
+	return 1000*1000*1000;
 #elif defined(CRYPTOPP_UNIX_AVAILABLE)
 	return 1000000;
 #else
@@ -32,6 +32,12 @@
 
 #define CRYPTOPP_INTEGER_SSE2 (CRYPTOPP_BOOL_SSE2_ASM_AVAILABLE && CRYPTOPP_BOOL_X86)
 
+#if CRYPTOPP_BOOL_X64 && !defined(CRYPTOPP_DISABLE_ADX) && (defined(CRYPTOPP_X64_ASM_AVAILABLE) || (defined(CRYPTOPP_X64_MASM_AVAILABLE) && _MSC_VER >= 1800))
+	#define CRYPTOPP_INTEGER_MULX 1
+#else
+	#define CRYPTOPP_INTEGER_MULX 0
+#endif
+
 NAMESPACE_BEGIN(CryptoPP)
 
 bool AssignIntToInteger(const std::type_info &valueType, void *pInteger, const void *pInt)
@@ -1261,6 +1267,248 @@ void Baseline_MultiplyTop16(word *R, const word *A, const word *B, word L)
 
 // ********************************************************
 
+#if CRYPTOPP_INTEGER_MULX
+
+// MULX doesn't touch the flags, so a row of A[j]*b can add the low halves on the ADCX carry chain
+// and the high halves on the ADOX one. The rows keep a window of n columns in registers, storing
+// the lowest as soon as it is final and reusing its register for the new column at the top.
+
+#ifdef __GNUC__
+
+#define MULX_Load(i)			"movq 8*" #i "(%[b]), %%rdx;"
+// clearing eax also clears CF and OF
+#define MULX_Next(i)			MULX_Load(i) "xorl %%eax, %%eax;"
+#define MULX_Start				"xorl %%eax, %%eax;"
+#define MULX_First(j, L, H)		"mulx 8*" #j "(%[a]), %%" #L ", %%" #H ";"
+#define MULX_Add(j, W, H)		"mulx 8*" #j "(%[a]), %%rax, %%" #H ";" "addq %%rax, %%" #W ";"
+#define MULX_Adc(j, W, H)		"mulx 8*" #j "(%[a]), %%rax, %%" #H ";" "adcq %%rax, %%" #W ";"
+#define MULX_AdcLow(j, W)		"mulx 8*" #j "(%[a]), %%rax, %%rbx;" "adcq %%rax, %%" #W ";"
+#define MULX_Carry(W)			"adcq $0, %%" #W ";"
+#define MULX_Acc(j, W, V)		"mulx 8*" #j "(%[a]), %%rax, %%rbx;" "adcx %%rax, %%" #W ";" "adox %%rbx, %%" #V ";"
+// the top of the row goes straight into a fresh column, which then takes both carries
+#define MULX_AccLast(j, W, V)	"mulx 8*" #j "(%[a]), %%rax, %%" #V ";" "adcx %%rax, %%" #W ";" \
+	"movl $0, %%eax;" "adcx %%rax, %%" #V ";" "adox %%rax, %%" #V ";"
+// for the bottom half, where everything above column n-1 is dropped
+#define MULX_AccLow(j, W)		"mulx 8*" #j "(%[a]), %%rax, %%rbx;" "adcx %%rax, %%" #W ";"
+#define MULX_Save(k, W)			"movq %%" #W ", 8*" #k "(%[r]);"
+#define MULX_Zero(k)			"movq $0, 8*" #k "(%[r]);"
+// the top half keeps column n-1 in r8 and gets only the high halves from column n-2. L, the real
+// word in column n-1, is below r8 exactly when the columns left out carried into it.
+#define MULX_AccHigh(j, V)		"mulx 8*" #j "(%[a]), %%rax, %%rbx;" "adox %%rbx, %%" #V ";"
+#define MULX_TopCarry(W)		"cmpq %%r8, %[l];" "movq %[r], %%rax;" "adcq $0, %%" #W ";"
+#define MULX_TopSave(k, W)		"movq %%" #W ", 8*" #k "(%%rax);"
+// R = 2*R plus A[i]^2 down the diagonal, doubling on the ADCX chain and adding on the ADOX one
+#define MULX_Diag(i)	"movq 8*" #i "(%[a]), %%rdx;" "mulx %%rdx, %%rax, %%rbx;" \
+	"movq 16*" #i "(%[r]), %%r8;" "adcx %%r8, %%r8;" "adox %%rax, %%r8;" "movq %%r8, 16*" #i "(%[r]);" \
+	"movq 16*" #i "+8(%[r]), %%r9;" "adcx %%r9, %%r9;" "adox %%rbx, %%r9;" "movq %%r9, 16*" #i "+8(%[r]);"
+
+#define MULX_Clobbers4	"%rax", "%rbx", "%rdx", "%r8", "%r9", "%r10", "%r11", "cc", "memory"
+#define MULX_Clobbers8	MULX_Clobbers4, "%r12", "%r13", "%r14", "%r15"
+#define MULX_TopClobbers4	MULX_Clobbers4, "%r12"
+#define MULX_TopClobbers8	MULX_Clobbers8, "%rcx"
+
+#define MULX_Mul(n)	\
+	__asm__ __volatile__ (MULX_Mul_##n : : [r] "r" (R), [a] "r" (A), [b] "r" (B) : MULX_Clobbers##n);
+#define MULX_Squ(n)	\
+	__asm__ __volatile__ (MULX_Squ_##n : : [r] "r" (R), [a] "r" (A), [b] "r" (A) : MULX_Clobbers##n);
+#define MULX_Bot(n)	\
+	__asm__ __volatile__ (MULX_Bot_##n : : [r] "r" (R), [a] "r" (A), [b] "r" (B) : MULX_Clobbers##n);
+// R is only needed at the end, so it waits in memory to leave a register for the extra column
+#define MULX_Top(n)	\
+	__asm__ __volatile__ (MULX_Top_##n : : [r] "m" (R), [a] "r" (A), [b] "r" (B), [l] "m" (L) : MULX_TopClobbers##n);
+
+#define MULX_Mul_4 \
+	MULX_Load(0) MULX_First(0, r8, r9) MULX_Save(0, r8) MULX_Add(1, r9, r10) MULX_Adc(2, r10, r11) MULX_Adc(3, r11, r8) MULX_Carry(r8) \
+	MULX_Next(1) MULX_Acc(0, r9, r10) MULX_Save(1, r9) MULX_Acc(1, r10, r11) MULX_Acc(2, r11, r8) MULX_AccLast(3, r8, r9) \
+	MULX_Next(2) MULX_Acc(0, r10, r11) MULX_Save(2, r10) MULX_Acc(1, r11, r8) MULX_Acc(2, r8, r9) MULX_AccLast(3, r9, r10) \
+	MULX_Next(3) MULX_Acc(0, r11, r8) MULX_Save(3, r11) MULX_Acc(1, r8, r9) MULX_Acc(2, r9, r10) MULX_AccLast(3, r10, r11) \
+	MULX_Save(4, r8) MULX_Save(5, r9) MULX_Save(6, r10) MULX_Save(7, r11)
+
+#define MULX_Squ_4 \
+	MULX_Load(0) MULX_First(1, r9, r10) MULX_Add(2, r10, r11) MULX_Adc(3, r11, r8) MULX_Carry(r8) \
+	MULX_Save(1, r9) MULX_Save(2, r10) MULX_Next(1) MULX_Acc(2, r11, r8) MULX_AccLast(3, r8, r9) \
+	MULX_Save(3, r11) MULX_Save(4, r8) MULX_Next(2) MULX_AccLast(3, r9, r10) \
+	MULX_Save(5, r9) MULX_Save(6, r10) \
+	MULX_Zero(0) MULX_Zero(7) MULX_Start \
+	MULX_Diag(0) MULX_Diag(1) MULX_Diag(2) MULX_Diag(3)
+
+#define MULX_Bot_4 \
+	MULX_Load(0) MULX_First(0, r8, r9) MULX_Save(0, r8) MULX_Add(1, r9, r10) MULX_Adc(2, r10, r11) MULX_AdcLow(3, r11) \
+	MULX_Next(1) MULX_Acc(0, r9, r10) MULX_Save(1, r9) MULX_Acc(1, r10, r11) MULX_AccLow(2, r11) \
+	MULX_Next(2) MULX_Acc(0, r10, r11) MULX_Save(2, r10) MULX_AccLow(1, r11) \
+	MULX_Next(3) MULX_AccLow(0, r11) MULX_Save(3, r11)
+
+#define MULX_Mul_8 \
+	MULX_Load(0) MULX_First(0, r8, r9) MULX_Save(0, r8) MULX_Add(1, r9, r10) MULX_Adc(2, r10, r11) MULX_Adc(3, r11, r12) MULX_Adc(4, r12, r13) MULX_Adc(5, r13, r14) MULX_Adc(6, r14, r15) MULX_Adc(7, r15, r8) MULX_Carry(r8) \
+	MULX_Next(1) MULX_Acc(0, r9, r10) MULX_Save(1, r9) MULX_Acc(1, r10, r11) MULX_Acc(2, r11, r12) MULX_Acc(3, r12, r13) MULX_Acc(4, r13, r14) MULX_Acc(5, r14, r15) MULX_Acc(6, r15, r8) MULX_AccLast(7, r8, r9) \
+	MULX_Next(2) MULX_Acc(0, r10, r11) MULX_Save(2, r10) MULX_Acc(1, r11, r12) MULX_Acc(2, r12, r13) MULX_Acc(3, r13, r14) MULX_Acc(4, r14, r15) MULX_Acc(5, r15, r8) MULX_Acc(6, r8, r9) MULX_AccLast(7, r9, r10) \
+	MULX_Next(3) MULX_Acc(0, r11, r12) MULX_Save(3, r11) MULX_Acc(1, r12, r13) MULX_Acc(2, r13, r14) MULX_Acc(3, r14, r15) MULX_Acc(4, r15, r8) MULX_Acc(5, r8, r9) MULX_Acc(6, r9, r10) MULX_AccLast(7, r10, r11) \
+	MULX_Next(4) MULX_Acc(0, r12, r13) MULX_Save(4, r12) MULX_Acc(1, r13, r14) MULX_Acc(2, r14, r15) MULX_Acc(3, r15, r8) MULX_Acc(4, r8, r9) MULX_Acc(5, r9, r10) MULX_Acc(6, r10, r11) MULX_AccLast(7, r11, r12) \
+	MULX_Next(5) MULX_Acc(0, r13, r14) MULX_Save(5, r13) MULX_Acc(1, r14, r15) MULX_Acc(2, r15, r8) MULX_Acc(3, r8, r9) MULX_Acc(4, r9, r10) MULX_Acc(5, r10, r11) MULX_Acc(6, r11, r12) MULX_AccLast(7, r12, r13) \
+	MULX_Next(6) MULX_Acc(0, r14, r15) MULX_Save(6, r14) MULX_Acc(1, r15, r8) MULX_Acc(2, r8, r9) MULX_Acc(3, r9, r10) MULX_Acc(4, r10, r11) MULX_Acc(5, r11, r12) MULX_Acc(6, r12, r13) MULX_AccLast(7, r13, r14) \
+	MULX_Next(7) MULX_Acc(0, r15, r8) MULX_Save(7, r15) MULX_Acc(1, r8, r9) MULX_Acc(2, r9, r10) MULX_Acc(3, r10, r11) MULX_Acc(4, r11, r12) MULX_Acc(5, r12, r13) MULX_Acc(6, r13, r14) MULX_AccLast(7, r14, r15) \
+	MULX_Save(8, r8) MULX_Save(9, r9) MULX_Save(10, r10) MULX_Save(11, r11) MULX_Save(12, r12) MULX_Save(13, r13) MULX_Save(14, r14) MULX_Save(15, r15)
+
+#define MULX_Squ_8 \
+	MULX_Load(0) MULX_First(1, r9, r10) MULX_Add(2, r10, r11) MULX_Adc(3, r11, r12) MULX_Adc(4, r12, r13) MULX_Adc(5, r13, r14) MULX_Adc(6, r14, r15) MULX_Adc(7, r15, r8) MULX_Carry(r8) \
+	MULX_Save(1, r9) MULX_Save(2, r10) MULX_Next(1) MULX_Acc(2, r11, r12) MULX_Acc(3, r12, r13) MULX_Acc(4, r13, r14) MULX_Acc(5, r14, r15) MULX_Acc(6, r15, r8) MULX_AccLast(7, r8, r9) \
+	MULX_Save(3, r11) MULX_Save(4, r12) MULX_Next(2) MULX_Acc(3, r13, r14) MULX_Acc(4, r14, r15) MULX_Acc(5, r15, r8) MULX_Acc(6, r8, r9) MULX_AccLast(7, r9, r10) \
+	MULX_Save(5, r13) MULX_Save(6, r14) MULX_Next(3) MULX_Acc(4, r15, r8) MULX_Acc(5, r8, r9) MULX_Acc(6, r9, r10) MULX_AccLast(7, r10, r11) \
+	MULX_Save(7, r15) MULX_Save(8, r8) MULX_Next(4) MULX_Acc(5, r9, r10) MULX_Acc(6, r10, r11) MULX_AccLast(7, r11, r12) \
+	MULX_Save(9, r9) MULX_Save(10, r10) MULX_Next(5) MULX_Acc(6, r11, r12) MULX_AccLast(7, r12, r13) \
+	MULX_Save(11, r11) MULX_Save(12, r12) MULX_Next(6) MULX_AccLast(7, r13, r14) \
+	MULX_Save(13, r13) MULX_Save(14, r14) \
+	MULX_Zero(0) MULX_Zero(15) MULX_Start \
+	MULX_Diag(0) MULX_Diag(1) MULX_Diag(2) MULX_Diag(3) MULX_Diag(4) MULX_Diag(5) MULX_Diag(6) MULX_Diag(7)
+
+#define MULX_Bot_8 \
+	MULX_Load(0) MULX_First(0, r8, r9) MULX_Save(0, r8) MULX_Add(1, r9, r10) MULX_Adc(2, r10, r11) MULX_Adc(3, r11, r12) MULX_Adc(4, r12, r13) MULX_Adc(5, r13, r14) MULX_Adc(6, r14, r15) MULX_AdcLow(7, r15) \
+	MULX_Next(1) MULX_Acc(0, r9, r10) MULX_Save(1, r9) MULX_Acc(1, r10, r11) MULX_Acc(2, r11, r12) MULX_Acc(3, r12, r13) MULX_Acc(4, r13, r14) MULX_Acc(5, r14, r15) MULX_AccLow(6, r15) \
+	MULX_Next(2) MULX_Acc(0, r10, r11) MULX_Save(2, r10) MULX_Acc(1, r11, r12) MULX_Acc(2, r12, r13) MULX_Acc(3, r13, r14) MULX_Acc(4, r14, r15) MULX_AccLow(5, r15) \
+	MULX_Next(3) MULX_Acc(0, r11, r12) MULX_Save(3, r11) MULX_Acc(1, r12, r13) MULX_Acc(2, r13, r14) MULX_Acc(3, r14, r15) MULX_AccLow(4, r15) \
+	MULX_Next(4) MULX_Acc(0, r12, r13) MULX_Save(4, r12) MULX_Acc(1, r13, r14) MULX_Acc(2, r14, r15) MULX_AccLow(3, r15) \
+	MULX_Next(5) MULX_Acc(0, r13, r14) MULX_Save(5, r13) MULX_Acc(1, r14, r15) MULX_AccLow(2, r15) \
+	MULX_Next(6) MULX_Acc(0, r14, r15) MULX_Save(6, r14) MULX_AccLow(1, r15) \
+	MULX_Next(7) MULX_AccLow(0, r15) MULX_Save(7, r15)
+
+#define MULX_Top_4 \
+	MULX_Load(0) MULX_First(2, rax, r8) MULX_Add(3, r8, r9) MULX_Carry(r9) \
+	MULX_Next(1) MULX_AccHigh(1, r8) MULX_Acc(2, r8, r9) MULX_AccLast(3, r9, r10) \
+	MULX_Next(2) MULX_AccHigh(0, r8) MULX_Acc(1, r8, r9) MULX_Acc(2, r9, r10) MULX_AccLast(3, r10, r11) \
+	MULX_Next(3) MULX_Acc(0, r8, r9) MULX_Acc(1, r9, r10) MULX_Acc(2, r10, r11) MULX_AccLast(3, r11, r12) \
+	MULX_TopCarry(r9) MULX_Carry(r10) MULX_Carry(r11) MULX_Carry(r12) \
+	MULX_TopSave(0, r9) MULX_TopSave(1, r10) MULX_TopSave(2, r11) MULX_TopSave(3, r12)
+
+#define MULX_Top_8 \
+	MULX_Load(0) MULX_First(6, rax, r8) MULX_Add(7, r8, r9) MULX_Carry(r9) \
+	MULX_Next(1) MULX_AccHigh(5, r8) MULX_Acc(6, r8, r9) MULX_AccLast(7, r9, r10) \
+	MULX_Next(2) MULX_AccHigh(4, r8) MULX_Acc(5, r8, r9) MULX_Acc(6, r9, r10) MULX_AccLast(7, r10, r11) \
+	MULX_Next(3) MULX_AccHigh(3, r8) MULX_Acc(4, r8, r9) MULX_Acc(5, r9, r10) MULX_Acc(6, r10, r11) MULX_AccLast(7, r11, r12) \
+	MULX_Next(4) MULX_AccHigh(2, r8) MULX_Acc(3, r8, r9) MULX_Acc(4, r9, r10) MULX_Acc(5, r10, r11) MULX_Acc(6, r11, r12) MULX_AccLast(7, r12, r13) \
+	MULX_Next(5) MULX_AccHigh(1, r8) MULX_Acc(2, r8, r9) MULX_Acc(3, r9, r10) MULX_Acc(4, r10, r11) MULX_Acc(5, r11, r12) MULX_Acc(6, r12, r13) MULX_AccLast(7, r13, r14) \
+	MULX_Next(6) MULX_AccHigh(0, r8) MULX_Acc(1, r8, r9) MULX_Acc(2, r9, r10) MULX_Acc(3, r10, r11) MULX_Acc(4, r11, r12) MULX_Acc(5, r12, r13) MULX_Acc(6, r13, r14) MULX_AccLast(7, r14, r15) \
+	MULX_Next(7) MULX_Acc(0, r8, r9) MULX_Acc(1, r9, r10) MULX_Acc(2, r10, r11) MULX_Acc(3, r11, r12) MULX_Acc(4, r12, r13) MULX_Acc(5, r13, r14) MULX_Acc(6, r14, r15) MULX_AccLast(7, r15, rcx) \
+	MULX_TopCarry(r9) MULX_Carry(r10) MULX_Carry(r11) MULX_Carry(r12) MULX_Carry(r13) MULX_Carry(r14) MULX_Carry(r15) MULX_Carry(rcx) \
+	MULX_TopSave(0, r9) MULX_TopSave(1, r10) MULX_TopSave(2, r11) MULX_TopSave(3, r12) MULX_TopSave(4, r13) MULX_TopSave(5, r14) MULX_TopSave(6, r15) MULX_TopSave(7, rcx)
+
+#else
+// T[0..n] += A[0..n-1]*b, dropping any carry out of T[n]
+static inline void MULX_AddRow(word *T, const word *A, word b, size_t n)
+{
+	unsigned char c = 0, o = 0;
+	word h = 0, l, p;
+	for (size_t j=0; j<n; j++)
+	{
+		l = _mulx_u64(A[j], b, &p);
+		c = _addcarryx_u64(c, l, T[j], &l);
+		o = _addcarryx_u64(o, l, h, &T[j]);
+		h = p;
+	}
+	_addcarryx_u64(o, h, c, &h);
+	T[n] += h;
+}
+
+static inline void MULX_Multiply(word *R, const word *A, const word *B, size_t n)
+{
+	SetWords(R, 0, 2*n);
+	for (size_t i=0; i<n; i++)
+		MULX_AddRow(R+i, A, B[i], n);
+}
+
+static inline void MULX_Square(word *R, const word *A, size_t n)
+{
+	SetWords(R, 0, 2*n);
+	for (size_t i=0; i<n-1; i++)
+		MULX_AddRow(R+2*i+1, A+i+1, A[i], n-1-i);
+
+	unsigned char c = 0, o = 0;
+	word h, l;
+	for (size_t i=0; i<n; i++)
+	{
+		l = _mulx_u64(A[i], A[i], &h);
+		c = _addcarryx_u64(c, R[2*i], R[2*i], &R[2*i]);
+		o = _addcarryx_u64(o, R[2*i], l, &R[2*i]);
+		c = _addcarryx_u64(c, R[2*i+1], R[2*i+1], &R[2*i+1]);
+		o = _addcarryx_u64(o, R[2*i+1], h, &R[2*i+1]);
+	}
+}
+
+static inline void MULX_MultiplyBottom(word *R, const word *A, const word *B, size_t n)
+{
+	SetWords(R, 0, n);
+	for (size_t i=0; i<n-1; i++)
+		MULX_AddRow(R+i, A, B[i], n-1-i);
+
+	// the rows stop below column n-1, whose low words are summed separately
+	word c = 0;
+	for (size_t i=0; i<n; i++)
+		c += A[n-1-i] * B[i];
+	R[n-1] += c;
+}
+
+static inline void MULX_MultiplyTop(word *R, const word *A, const word *B, word L, size_t n)
+{
+	// T gets columns n-2 and up of the products in them and above, which is A*B/2**(WORD_BITS*(n-2))
+	// short by less than n in the word for column n-1, where L tells how much
+	word T[10];
+	SetWords(T, 0, n+2);
+	for (size_t i=0; i<n-1; i++)
+		MULX_AddRow(T, A+n-2-i, B[i], i+2);
+	MULX_AddRow(T+1, A, B[n-1], n);
+	CopyWords(R, T+2, n);
+	Increment(R, n, L < T[1]);
+}
+
+#define MULX_Mul(n)	MULX_Multiply(R, A, B, n);
+#define MULX_Squ(n)	MULX_Square(R, A, n);
+#define MULX_Bot(n)	MULX_MultiplyBottom(R, A, B, n);
+#define MULX_Top(n)	MULX_MultiplyTop(R, A, B, L, n);
+#endif
+
+void MULX_Multiply4(word *R, const word *A, const word *B)
+{
+	MULX_Mul(4)
+}
+
+void MULX_Multiply8(word *R, const word *A, const word *B)
+{
+	MULX_Mul(8)
+}
+
+void MULX_Square4(word *R, const word *A)
+{
+	MULX_Squ(4)
+}
+
+void MULX_Square8(word *R, const word *A)
+{
+	MULX_Squ(8)
+}
+
+void MULX_MultiplyBottom4(word *R, const word *A, const word *B)
+{
+	MULX_Bot(4)
+}
+
+void MULX_MultiplyBottom8(word *R, const word *A, const word *B)
+{
+	MULX_Bot(8)
+}
+
+void MULX_MultiplyTop4(word *R, const word *A, const word *B, word L)
+{
+	MULX_Top(4)
+}
+
+void MULX_MultiplyTop8(word *R, const word *A, const word *B, word L)
+{
+	MULX_Top(8)
+}
+
+#endif	// #if CRYPTOPP_INTEGER_MULX
+
+// ********************************************************
+
 #if CRYPTOPP_INTEGER_SSE2
 
 CRYPTOPP_ALIGN_DATA(16) static const word32 s_maskLow16[4] CRYPTOPP_SECTION_ALIGN16 = {0xffff,0xffff,0xffff,0xffff};
@@ -1944,6 +2192,8 @@ typedef void (* PMulTop)(word *C, const word *A, const word *B, word L);
 #if CRYPTOPP_INTEGER_SSE2
 static PAdd s_pAdd = &Baseline_Add, s_pSub = &Baseline_Sub;
 static size_t s_recursionLimit = 8;
+#elif CRYPTOPP_INTEGER_MULX
+static size_t s_recursionLimit = 16;
 #else
 static const size_t s_recursionLimit = 16;
 #endif
@@ -2013,6 +2263,28 @@ static void SetFunctionPointers()
 		s_pTop[4] = &Baseline_MultiplyTop16;
 #endif
 	}
+
+#if CRYPTOPP_INTEGER_MULX
+	if (HasBMI2() && HasADX())
+	{
+		// Karatsuba over the 8 word kernels beats Comba at 16 words
+		s_recursionLimit = 8;
+
+		s_pMul[1] = &MULX_Multiply4;
+		s_pMul[2] = &MULX_Multiply8;
+
+		s_pBot[1] = &MULX_MultiplyBottom4;
+		s_pBot[2] = &MULX_MultiplyBottom8;
+
+		s_pSqu[1] = &MULX_Square4;
+		s_pSqu[2] = &MULX_Square8;
+
+		s_pTop[1] = &MULX_MultiplyTop4;
+		s_pTop[2] = &MULX_MultiplyTop8;
+	}
+	else
+		s_recursionLimit = 16;
+#endif
 }
 
 inline int Add(word *C, const word *A, const word *B, size_t N)
@@ -2739,6 +3011,11 @@ InitializeInteger::InitializeInteger()
 	}
 }
 
+void SelectIntegerKernels()
+{
+	SetFunctionPointers();
+}
+
 static const unsigned int RoundupSizeTable[] = {2, 2, 2, 4, 4, 8, 8, 8, 8};
 
 static inline size_t RoundupSize(size_t n)
@@ -4241,6 +4518,12 @@ void ModularArithmetic::SimultaneousExponentiate(Integer *results, const Integer
 	if (m_modulus.IsOdd())
 	{
 		MontgomeryRepresentation dr(m_modulus);
+		// the constant time path is for secret exponents, which are about as long as the modulus;
+		// short public ones such as 65537 are much faster with sliding windows
+		if (exponentsCount == 1 && exponents[0].NotNegative() && exponents[0].BitCount() >= m_modulus.BitCount() - m_modulus.BitCount()/8
+			&& dr.FixedWidthExponentiate(results[0], base, exponents[0]))
+			return;
+
 		dr.SimultaneousExponentiate(results, dr.ConvertIn(base), exponents, exponentsCount);
 		for (unsigned int i=0; i<exponentsCount; i++)
 			results[i] = dr.ConvertOut(results[i]);
@@ -4249,6 +4532,20 @@ void ModularArithmetic::SimultaneousExponentiate(Integer *results, const Integer
 		AbstractRing<Integer>::SimultaneousExponentiate(results, base, exponents, exponentsCount);
 }
 
+Integer ModularArithmetic::MultiExponentiate(const Integer *bases, const Integer *exponents, size_t count) const
+{
+	if (m_modulus.IsOdd())
+	{
+		MontgomeryRepresentation dr(m_modulus);
+		std::vector<Integer> converted(count);
+		for (size_t i=0; i<count; i++)
+			converted[i] = dr.ConvertIn(bases[i]);
+		return dr.ConvertOut(dr.MultiExponentiate(count ? &converted[0] : NULL, exponents, count));
+	}
+	else
+		return AbstractRing<Integer>::MultiExponentiate(bases, exponents, count);
+}
+
 MontgomeryRepresentation::MontgomeryRepresentation(const Integer &m)	// modulus must be odd
 	: ModularArithmetic(m),
 	  m_u((word)0, m_modulus.reg.size()),
@@ -4273,6 +4570,36 @@ const Integer& MontgomeryRepresentation::Multiply(const Integer &a, const Intege
 	return m_result;
 }
 
+const Integer& MontgomeryRepresentation::MultiplyElementWords(const Integer &a, const word *b) const
+{
+	word *const T = m_workspace.begin();
+	word *const R = m_result.reg.begin();
+	const size_t N = m_modulus.reg.size();
+	assert(a.reg.size()<=N);
+
+	AsymmetricMultiply(T, T+2*N, a.reg, a.reg.size(), b, N);
+	SetWords(T+a.reg.size()+N, 0, N-a.reg.size());
+	MontgomeryReduce(R, T+2*N, T, m_modulus.reg, m_u.reg, N);
+	return m_result;
+}
+
+void MontgomeryRepresentation::EncodeElementWords(word *output, const Integer &a) const
+{
+	const size_t N = m_modulus.reg.size();
+	const size_t n = a.WordCount();
+	assert(a.NotNegative() && n<=N);
+
+	CopyWords(output, a.reg, n);
+	SetWords(output+n, 0, N-n);
+}
+
+Integer MontgomeryRepresentation::DecodeElementWords(const word *input) const
+{
+	Integer a((word)0, m_modulus.reg.size());
+	CopyWords(a.reg, input, m_modulus.reg.size());
+	return a;
+}
+
 const Integer& MontgomeryRepresentation::Square(const Integer &a) const
 {
 	word *const T = m_workspace.begin();
@@ -4322,6 +4649,188 @@ const Integer& MontgomeryRepresentation::MultiplicativeInverse(const Integer &a)
 	return m_result;
 }
 
+// ********************************************************
+
+// Montgomery arithmetic for the common modulus sizes, with every operand in a fixed array on the stack.
+// A word count that is a power of 2 gets the same multiply and reduce as MontgomeryRepresentation.
+// Any other (3072 bits) is reduced D words at a time as the multiply goes (block CIOS), D being the
+// largest power of 2 that divides it, instead of being padded up to the next power of 2 like Integer.
+
+template <unsigned int BITS>
+class FixedMontgomery
+{
+public:
+	enum {N = BITS/WORD_BITS, D = N & (0-N), K = N/D, WINDOW = BITS <= 512 ? 4 : BITS <= 2048 ? 5 : 6,
+		WORKSPACE = K == 1 ? 5*N : 3*N+6*D};
+
+	FixedMontgomery(const word *m)
+	{
+		FixedSizeSecBlock<word, 2*D> T;
+		CopyWords(m_modulus, m, N);
+		RecursiveInverseModPower2(m_u, T, m_modulus, D);
+		// the blocks add q*M rather than subtracting it, so they want -1/M
+		if (K > 1)
+			TwosComplement(m_u, D);
+	}
+
+	// R = A*B/2**BITS mod M, for A and B below M
+	void Multiply(word *R, word *T, const word *A, const word *B) const;
+	void Square(word *R, word *T, const word *A) const;
+	// R = X**e mod M, with no branch or memory access depending on X or on e beyond its length
+	void Exponentiate(word *R, const word *X, const word *R2, const Integer &e) const;
+
+private:
+	// X[0..N+D] += A*B for one block A of D words
+	void MultiplyBlock(word *X, word *T, const word *A, const word *B) const;
+
+	FixedSizeSecBlock<word, N> m_modulus;
+	FixedSizeSecBlock<word, D> m_u;
+};
+
+template <unsigned int BITS>
+void FixedMontgomery<BITS>::MultiplyBlock(word *X, word *T, const word *A, const word *B) const
+{
+	// the products of the even blocks of B don't overlap, nor do those of the odd ones
+	word *const P = T, *const Q = P+N+D, *const W = Q+N;
+	for (unsigned int j=0; j<K; j++)
+		CryptoPP::Multiply((j%2 ? Q-D : P) + j*D, W, A, B+j*D, D);
+	SetWords(K%2 ? Q+N-D : P+N, 0, D);
+
+	X[N+D] += Add(X, X, P, N+D);
+	X[N+D] += Add(X+D, X+D, Q, N);
+}
+
+template <unsigned int BITS>
+void FixedMontgomery<BITS>::Multiply(word *R, word *T, const word *A, const word *B) const
+{
+	if (K == 1)
+	{
+		CryptoPP::Multiply(T, T+2*N, A, B, N);
+		MontgomeryReduce(R, T+2*N, T, m_modulus, m_u, N);
+		return;
+	}
+
+	word *const X = T, *const U = X+N+2*D, *const W = U+D;
+	SetWords(X, 0, N+2*D);
+	for (unsigned int i=0; i<K; i++)
+	{
+		MultiplyBlock(X, W, A+i*D, B);
+		MultiplyBottom(U, W, X, m_u, D);
+		// this clears the low block, which the shift then drops
+		MultiplyBlock(X, W, U, m_modulus);
+		CopyWords(X, X+D, N+1);
+		SetWords(X+N+1, 0, D);
+	}
+
+	// X is below 2*M, so keep X-M unless it borrowed from a zero top word
+	word borrow = Subtract(W, X, m_modulus, N);
+	word mask = 0 - (borrow & (1 ^ X[N]));
+	for (unsigned int i=0; i<N; i++)
+		R[i] = (X[i] & mask) | (W[i] & ~mask);
+}
+
+template <unsigned int BITS>
+void FixedMontgomery<BITS>::Square(word *R, word *T, const word *A) const
+{
+	if (K == 1)
+	{
+		CryptoPP::Square(T, T+2*N, A, N);
+		MontgomeryReduce(R, T+2*N, T, m_modulus, m_u, N);
+	}
+	else
+		Multiply(R, T, A, A);
+}
+
+template <unsigned int BITS>
+void FixedMontgomery<BITS>::Exponentiate(word *R, const word *X, const word *R2, const Integer &e) const
+{
+	FixedSizeSecBlock<word, (1<<WINDOW)*N> table;
+	FixedSizeSecBlock<word, WORKSPACE> workspace;
+	FixedSizeSecBlock<word, 2*N> buffer;
+	word *const T = workspace, *const A = buffer, *const V = A+N;
+
+	// X**i for every window, in Montgomery form
+	SetWords(V, 0, N);
+	V[0] = 1;
+	Multiply(table, T, R2, V);
+	Multiply(table+N, T, X, R2);
+	for (unsigned int i=2; i<(1<<WINDOW); i++)
+	{
+		if (i%2)
+			Multiply(table+i*N, T, table+(i-1)*N, table+N);
+		else
+			Square(table+i*N, T, table+i/2*N);
+	}
+
+	// read the whole table every time, keeping only the entry wanted
+	const size_t windows = (e.BitCount() + WINDOW - 1) / WINDOW;
+	SetWords(A, 0, N);
+	for (size_t w=windows; w-- > 0;)
+	{
+		const word index = word(e.GetBits(w*WINDOW, WINDOW));
+		for (unsigned int i=0; i<WINDOW && w+1<windows; i++)
+			Square(A, T, A);
+
+		SetWords(V, 0, N);
+		for (unsigned int j=0; j<(1<<WINDOW); j++)
+		{
+			const word d = index ^ j;
+			const word mask = ((d | (0-d)) >> (WORD_BITS-1)) - 1;
+			for (unsigned int i=0; i<N; i++)
+				V[i] |= table[j*N+i] & mask;
+		}
+
+		if (w+1 == windows)
+			CopyWords(A, V, N);
+		else
+			Multiply(A, T, A, V);
+	}
+
+	if (!windows)
+		CopyWords(A, table, N);
+
+	SetWords(V, 0, N);
+	V[0] = 1;
+	Multiply(R, T, A, V);
+}
+
+template <unsigned int BITS>
+static void FixedMontgomeryExponentiate(word *R, const word *M, const word *X, const word *R2, const Integer &e)
+{
+	FixedMontgomery<BITS>(M).Exponentiate(R, X, R2, e);
+}
+
+bool MontgomeryRepresentation::FixedWidthExponentiate(Integer &result, const Integer &base, const Integer &exponent) const
+{
+	unsigned int bits;
+	void (*exponentiate)(word *R, const word *M, const word *X, const word *R2, const Integer &e);
+
+	// 384 bits would go in blocks of 2 words, which is slower than padding to 512
+	switch (m_modulus.WordCount()*WORD_BITS)
+	{
+	case 256:	bits = 256; exponentiate = &FixedMontgomeryExponentiate<256>; break;
+	case 384:
+	case 512:	bits = 512; exponentiate = &FixedMontgomeryExponentiate<512>; break;
+	case 1024:	bits = 1024; exponentiate = &FixedMontgomeryExponentiate<1024>; break;
+	case 2048:	bits = 2048; exponentiate = &FixedMontgomeryExponentiate<2048>; break;
+	case 3072:	bits = 3072; exponentiate = &FixedMontgomeryExponentiate<3072>; break;
+	case 4096:	bits = 4096; exponentiate = &FixedMontgomeryExponentiate<4096>; break;
+	default:	return false;
+	}
+
+	// r is 2**bits here unless Integer pads the modulus, as it does 3072 bits to 4096
+	if (bits == WORD_BITS*m_modulus.reg.size() && m_r2.IsZero())
+		m_r2 = Integer::Power2(2*bits) % m_modulus;
+	const size_t N = bits/WORD_BITS;
+	Integer x = base % m_modulus, r2 = bits == WORD_BITS*m_modulus.reg.size() ? m_r2 : Integer::Power2(2*bits) % m_modulus;
+	x.reg.CleanGrow(N);
+	r2.reg.CleanGrow(N);
+	Integer r((word)0, N);
+	exponentiate(r.reg, m_modulus.reg, x.reg, r2.reg, exponent);
+	result.swap(r);
+	return true;
+}
+
 NAMESPACE_END
 
 #endif
@@ -16,6 +16,9 @@ struct InitializeInteger	// used to initialize static variables
 	InitializeInteger();
 };
 
+//! chooses the multiplication routines again from the flags in cpu.h, after a test changed g_hasBMI2 or g_hasADX
+CRYPTOPP_DLL void CRYPTOPP_API SelectIntegerKernels();
+
 typedef SecBlock<word, AllocatorWithCleanup<word, CRYPTOPP_BOOL_X86> > IntegerSecBlock;
 
 //! multiple precision integer and basic arithmetics
@@ -92,6 +92,8 @@ public:
 
 	void SimultaneousExponentiate(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const;
 
+	Integer MultiExponentiate(const Integer *bases, const Integer *exponents, size_t count) const;
+
 	unsigned int MaxElementBitLength() const
 		{return (m_modulus-1).BitCount();}
 
@@ -148,8 +150,25 @@ public:
 	void SimultaneousExponentiate(Element *results, const Element &base, const Integer *exponents, unsigned int exponentsCount) const
 		{AbstractRing<Integer>::SimultaneousExponentiate(results, base, exponents, exponentsCount);}
 
+	Integer MultiExponentiate(const Integer *bases, const Integer *exponents, size_t count) const
+		{return AbstractRing<Integer>::MultiExponentiate(bases, exponents, count);}
+
+	//! the number of words an element takes in EncodeElementWords() and DecodeElementWords()
+	size_t ElementWordCount() const {return m_modulus.reg.size();}
+	//! writes a in ElementWordCount() native words, least significant first
+	void EncodeElementWords(word *output, const Integer &a) const;
+	//! reads an element written by EncodeElementWords()
+	Integer DecodeElementWords(const word *input) const;
+	//! returns a*b for b stored as by EncodeElementWords(), so that a table of elements can be used in place
+	const Integer& MultiplyElementWords(const Integer &a, const word *b) const;
+
+	//! constant time exponentiation in fixed arrays for moduli of 256, 384, 512, 1024, 2048, 3072 or 4096 bits, returns false for other sizes
+	/*! base and result are not in Montgomery representation */
+	bool FixedWidthExponentiate(Integer &result, const Integer &base, const Integer &exponent) const;
+
 private:
 	Integer m_u;
+	mutable Integer m_r2;	// r*r%n, computed on first use
 	mutable IntegerSecBlock m_workspace;
 };
 
@@ -5,6 +5,9 @@
 #ifndef CRYPTOPP_IMPORTS
 
 #include "modes.h"
+#include "threadpool.h"
+#include "cpu.h"
+#include "rijndael.h"
 
 #ifndef NDEBUG
 #include "des.h"
@@ -240,6 +243,381 @@ void CBC_CTS_Decryption::ProcessLastBlock(byte *outString, const byte *inString,
 	}
 }
 
+void XTS_ModeBase::ResizeBuffers()
+{
+	if (m_cipher->BlockSize() != 16)
+		throw InvalidArgument("XTS_ModeBase: the block size of the underlying cipher must be 16");
+	BlockOrientedCipherModeBase::ResizeBuffers();
+	m_aesniRoundKeys = NULL;
+}
+
+void XTS_ModeBase::UncheckedSetKey(const byte *key, unsigned int length, const NameValuePairs &params)
+{
+	m_cipher->SetKey(key, length/2, params);
+	AccessTweakCipher().SetKey(key+length/2, length/2);
+	ResizeBuffers();
+
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+	if (HasAESNI())
+	{
+		if (const Rijndael::Encryption *aes = dynamic_cast<const Rijndael::Encryption *>(m_cipher))
+			m_aesniRoundKeys = aes->GetAESNIRoundKeys(m_aesniRounds);
+		else if (const Rijndael::Decryption *aes = dynamic_cast<const Rijndael::Decryption *>(m_cipher))
+			m_aesniRoundKeys = aes->GetAESNIRoundKeys(m_aesniRounds);
+	}
+#endif
+
+	ConstByteArrayParameter iv;
+	if (params.GetValue(Name::IV(), iv))
+		Resynchronize(iv.begin(), (int)iv.size());
+	else
+	{
+		memset(m_register, 0, BlockSize());
+		AccessTweakCipher().ProcessBlock(m_register);
+	}
+}
+
+void XTS_ModeBase::Resynchronize(const byte *iv, int length)
+{
+	memcpy_s(m_register, m_register.size(), iv, ThrowIfInvalidIVLength(length));
+	AccessTweakCipher().ProcessBlock(m_register);
+}
+
+// writes the tweaks of the next blocks and advances tweak by multiplying it with x in GF(2^128)
+static inline void XTS_NextTweaks(byte *tweaks, byte *tweak, size_t blocks)
+{
+	word64 low = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, tweak);
+	word64 high = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, tweak+8);
+
+	for (size_t i=0; i<blocks; i++, tweaks+=16)
+	{
+		PutWord(true, LITTLE_ENDIAN_ORDER, tweaks, low);
+		PutWord(true, LITTLE_ENDIAN_ORDER, tweaks+8, high);
+		const word64 carry = high >> 63;
+		high = (high << 1) | (low >> 63);
+		low = (low << 1) ^ (0x87 & (0-carry));
+	}
+
+	PutWord(false, LITTLE_ENDIAN_ORDER, tweak, low);
+	PutWord(false, LITTLE_ENDIAN_ORDER, tweak+8, high);
+}
+
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+static inline __m128i XTS_MulX(const __m128i &tweak)
+{
+	// the carries out of both halves go to bit 64 and, reduced, to the low byte
+	const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);
+	const __m128i carry = _mm_and_si128(_mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), 0x13), poly);
+	return _mm_xor_si128(_mm_add_epi64(tweak, tweak), carry);
+}
+
+#define XTS_AES_ROUND(op, rk)	\
+	block0 = op(block0, rk); block1 = op(block1, rk); block2 = op(block2, rk); block3 = op(block3, rk);	\
+	block4 = op(block4, rk); block5 = op(block5, rk); block6 = op(block6, rk); block7 = op(block7, rk);
+
+// 8 blocks per iteration with the tweaks kept in registers, avoids the separate tweak and xor passes
+template <bool ENCRYPT>
+static void AESNI_XTS_ProcessBlocks(const __m128i *subkeys, unsigned int rounds, __m128i &tweak, const byte *inString, byte *outString, size_t blocks)
+{
+	while (blocks >= 8)
+	{
+		const __m128i tweak0 = tweak, tweak1 = XTS_MulX(tweak0), tweak2 = XTS_MulX(tweak1), tweak3 = XTS_MulX(tweak2);
+		const __m128i tweak4 = XTS_MulX(tweak3), tweak5 = XTS_MulX(tweak4), tweak6 = XTS_MulX(tweak5), tweak7 = XTS_MulX(tweak6);
+		tweak = XTS_MulX(tweak7);
+
+		__m128i rk = subkeys[0];
+		__m128i block0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inString), _mm_xor_si128(tweak0, rk));
+		__m128i block1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+16)), _mm_xor_si128(tweak1, rk));
+		__m128i block2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+32)), _mm_xor_si128(tweak2, rk));
+		__m128i block3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+48)), _mm_xor_si128(tweak3, rk));
+		__m128i block4 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+64)), _mm_xor_si128(tweak4, rk));
+		__m128i block5 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+80)), _mm_xor_si128(tweak5, rk));
+		__m128i block6 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+96)), _mm_xor_si128(tweak6, rk));
+		__m128i block7 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inString+112)), _mm_xor_si128(tweak7, rk));
+
+		for (unsigned int i=1; i<rounds; i++)
+		{
+			rk = subkeys[i];
+			if (ENCRYPT)
+				{XTS_AES_ROUND(_mm_aesenc_si128, rk)}
+			else
+				{XTS_AES_ROUND(_mm_aesdec_si128, rk)}
+		}
+
+		// the output tweak is folded into the last round key
+		rk = subkeys[rounds];
+		if (ENCRYPT)
+		{
+			block0 = _mm_aesenclast_si128(block0, _mm_xor_si128(tweak0, rk));
+			block1 = _mm_aesenclast_si128(block1, _mm_xor_si128(tweak1, rk));
+			block2 = _mm_aesenclast_si128(block2, _mm_xor_si128(tweak2, rk));
+			block3 = _mm_aesenclast_si128(block3, _mm_xor_si128(tweak3, rk));
+			block4 = _mm_aesenclast_si128(block4, _mm_xor_si128(tweak4, rk));
+			block5 = _mm_aesenclast_si128(block5, _mm_xor_si128(tweak5, rk));
+			block6 = _mm_aesenclast_si128(block6, _mm_xor_si128(tweak6, rk));
+			block7 = _mm_aesenclast_si128(block7, _mm_xor_si128(tweak7, rk));
+		}
+		else
+		{
+			block0 = _mm_aesdeclast_si128(block0, _mm_xor_si128(tweak0, rk));
+			block1 = _mm_aesdeclast_si128(block1, _mm_xor_si128(tweak1, rk));
+			block2 = _mm_aesdeclast_si128(block2, _mm_xor_si128(tweak2, rk));
+			block3 = _mm_aesdeclast_si128(block3, _mm_xor_si128(tweak3, rk));
+			block4 = _mm_aesdeclast_si128(block4, _mm_xor_si128(tweak4, rk));
+			block5 = _mm_aesdeclast_si128(block5, _mm_xor_si128(tweak5, rk));
+			block6 = _mm_aesdeclast_si128(block6, _mm_xor_si128(tweak6, rk));
+			block7 = _mm_aesdeclast_si128(block7, _mm_xor_si128(tweak7, rk));
+		}
+
+		_mm_storeu_si128((__m128i *)outString, block0);
+		_mm_storeu_si128((__m128i *)(outString+16), block1);
+		_mm_storeu_si128((__m128i *)(outString+32), block2);
+		_mm_storeu_si128((__m128i *)(outString+48), block3);
+		_mm_storeu_si128((__m128i *)(outString+64), block4);
+		_mm_storeu_si128((__m128i *)(outString+80), block5);
+		_mm_storeu_si128((__m128i *)(outString+96), block6);
+		_mm_storeu_si128((__m128i *)(outString+112), block7);
+
+		inString += 128;
+		outString += 128;
+		blocks -= 8;
+	}
+
+	for (; blocks; blocks--, inString+=16, outString+=16)
+	{
+		__m128i block = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inString), _mm_xor_si128(tweak, subkeys[0]));
+		for (unsigned int i=1; i<rounds; i++)
+			block = ENCRYPT ? _mm_aesenc_si128(block, subkeys[i]) : _mm_aesdec_si128(block, subkeys[i]);
+		const __m128i rk = _mm_xor_si128(tweak, subkeys[rounds]);
+		block = ENCRYPT ? _mm_aesenclast_si128(block, rk) : _mm_aesdeclast_si128(block, rk);
+		_mm_storeu_si128((__m128i *)outString, block);
+		tweak = XTS_MulX(tweak);
+	}
+}
+
+#undef XTS_AES_ROUND
+
+#if CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE && CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE
+// multiplies the tweak in each 128 bit lane with x^16, only needs AVX-512 Foundation
+static inline __m512i XTS_MulX16(const __m512i &tweaks)
+{
+	// the top 16 bits of each half move to the other half, the ones from the high half are reduced with x^7+x^2+x+1
+	const __m512i carry = _mm512_shuffle_epi32(_mm512_srli_epi64(tweaks, 48), _MM_PERM_BADC);
+	const __m512i lowHalves = _mm512_set_epi64(0, -1, 0, -1, 0, -1, 0, -1);
+	const __m512i reduced = _mm512_and_si512(_mm512_xor_si512(_mm512_xor_si512(_mm512_slli_epi64(carry, 1), _mm512_slli_epi64(carry, 2)), _mm512_slli_epi64(carry, 7)), lowHalves);
+	return _mm512_xor_si512(_mm512_xor_si512(_mm512_slli_epi64(tweaks, 16), carry), reduced);
+}
+
+#define XTS_VAES_ROUND(op, rk)	\
+	block0 = op(block0, rk); block1 = op(block1, rk); block2 = op(block2, rk); block3 = op(block3, rk);
+
+// 16 blocks per iteration in ZMM registers, lane j of tweaks<k> is the tweak of block 4k+j
+template <bool ENCRYPT>
+static void VAES_XTS_ProcessBlocks(const __m128i *subkeys, unsigned int rounds, __m128i &tweak, const byte *&inString, byte *&outString, size_t &blocks)
+{
+	if (blocks < 16)
+		return;
+
+	__m128i t[16];
+	t[0] = tweak;
+	for (unsigned int i=1; i<16; i++)
+		t[i] = XTS_MulX(t[i-1]);
+	__m512i tweaks0 = _mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_castsi128_si512(t[0]), t[1], 1), t[2], 2), t[3], 3);
+	__m512i tweaks1 = _mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_castsi128_si512(t[4]), t[5], 1), t[6], 2), t[7], 3);
+	__m512i tweaks2 = _mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_castsi128_si512(t[8]), t[9], 1), t[10], 2), t[11], 3);
+	__m512i tweaks3 = _mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_castsi128_si512(t[12]), t[13], 1), t[14], 2), t[15], 3);
+
+	while (blocks >= 16)
+	{
+		__m512i rk = _mm512_broadcast_i32x4(subkeys[0]);
+		__m512i block0 = _mm512_xor_si512(_mm512_loadu_si512((const void *)inString), _mm512_xor_si512(tweaks0, rk));
+		__m512i block1 = _mm512_xor_si512(_mm512_loadu_si512((const void *)(inString+64)), _mm512_xor_si512(tweaks1, rk));
+		__m512i block2 = _mm512_xor_si512(_mm512_loadu_si512((const void *)(inString+128)), _mm512_xor_si512(tweaks2, rk));
+		__m512i block3 = _mm512_xor_si512(_mm512_loadu_si512((const void *)(inString+192)), _mm512_xor_si512(tweaks3, rk));
+
+		for (unsigned int i=1; i<rounds; i++)
+		{
+			rk = _mm512_broadcast_i32x4(subkeys[i]);
+			if (ENCRYPT)
+				{XTS_VAES_ROUND(_mm512_aesenc_epi128, rk)}
+			else
+				{XTS_VAES_ROUND(_mm512_aesdec_epi128, rk)}
+		}
+
+		rk = _mm512_broadcast_i32x4(subkeys[rounds]);
+		if (ENCRYPT)
+		{
+			block0 = _mm512_aesenclast_epi128(block0, _mm512_xor_si512(tweaks0, rk));
+			block1 = _mm512_aesenclast_epi128(block1, _mm512_xor_si512(tweaks1, rk));
+			block2 = _mm512_aesenclast_epi128(block2, _mm512_xor_si512(tweaks2, rk));
+			block3 = _mm512_aesenclast_epi128(block3, _mm512_xor_si512(tweaks3, rk));
+		}
+		else
+		{
+			block0 = _mm512_aesdeclast_epi128(block0, _mm512_xor_si512(tweaks0, rk));
+			block1 = _mm512_aesdeclast_epi128(block1, _mm512_xor_si512(tweaks1, rk));
+			block2 = _mm512_aesdeclast_epi128(block2, _mm512_xor_si512(tweaks2, rk));
+			block3 = _mm512_aesdeclast_epi128(block3, _mm512_xor_si512(tweaks3, rk));
+		}
+
+		_mm512_storeu_si512((void *)outString, block0);
+		_mm512_storeu_si512((void *)(outString+64), block1);
+		_mm512_storeu_si512((void *)(outString+128), block2);
+		_mm512_storeu_si512((void *)(outString+192), block3);
+
+		tweaks0 = XTS_MulX16(tweaks0);
+		tweaks1 = XTS_MulX16(tweaks1);
+		tweaks2 = XTS_MulX16(tweaks2);
+		tweaks3 = XTS_MulX16(tweaks3);
+
+		inString += 256;
+		outString += 256;
+		blocks -= 16;
+	}
+
+	tweak = _mm512_castsi512_si128(tweaks0);
+}
+
+#undef XTS_VAES_ROUND
+#endif
+#endif
+
+void XTS_ModeBase::ProcessBlocks(byte *outString, const byte *inString, size_t length, byte *tweak) const
+{
+	assert(length%16==0);
+
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+	if (HasAESNI())
+	{
+		const unsigned int rounds = m_aesniRounds;
+		const byte *subkeys = m_aesniRoundKeys;
+		if (subkeys)
+		{
+			const bool encrypt = m_cipher->IsForwardTransformation();
+			size_t blocks = length/16;
+			__m128i tweakBlock = _mm_loadu_si128((const __m128i *)tweak);
+#if CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE && CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE
+			if (HasVAES() && HasAVX512())
+			{
+				if (encrypt)
+					VAES_XTS_ProcessBlocks<true>((const __m128i *)subkeys, rounds, tweakBlock, inString, outString, blocks);
+				else
+					VAES_XTS_ProcessBlocks<false>((const __m128i *)subkeys, rounds, tweakBlock, inString, outString, blocks);
+			}
+#endif
+			if (encrypt)
+				AESNI_XTS_ProcessBlocks<true>((const __m128i *)subkeys, rounds, tweakBlock, inString, outString, blocks);
+			else
+				AESNI_XTS_ProcessBlocks<false>((const __m128i *)subkeys, rounds, tweakBlock, inString, outString, blocks);
+			_mm_storeu_si128((__m128i *)tweak, tweakBlock);
+			return;
+		}
+	}
+#endif
+
+	FixedSizeAlignedSecBlock<byte, 16*TWEAK_BUFFER_BLOCKS> tweaks;
+
+	while (length)
+	{
+		const size_t chunk = STDMIN(length, tweaks.size());
+		XTS_NextTweaks(tweaks, tweak, chunk/16);
+		// the tweaks are xored before and after the block cipher
+		m_cipher->AdvancedProcessBlocks(inString, tweaks, outString, chunk, BlockTransformation::BT_XorInput|BlockTransformation::BT_AllowParallel);
+		xorbuf(outString, tweaks, chunk);
+
+		inString += chunk;
+		outString += chunk;
+		length -= chunk;
+	}
+}
+
+void XTS_ModeBase::ProcessWithStealing(byte *outString, const byte *inString, size_t length, byte *tweak) const
+{
+	if (length < 16)
+		throw InvalidArgument("XTS_ModeBase: message is too short for ciphertext stealing");
+
+	const size_t partial = length%16;
+	if (!partial)
+	{
+		ProcessBlocks(outString, inString, length, tweak);
+		return;
+	}
+
+	const size_t whole = length-partial-16;
+	ProcessBlocks(outString, inString, whole, tweak);
+	outString += whole;
+	inString += whole;
+
+	FixedSizeAlignedSecBlock<byte, 32> tweaks;
+	FixedSizeSecBlock<byte, 16> last, stolen;
+	XTS_NextTweaks(tweaks, tweak, 2);
+
+	// when decrypting, the last whole ciphertext block was made with the second tweak
+	const byte *firstTweak = tweaks, *secondTweak = tweaks+16;
+	if (!m_cipher->IsForwardTransformation())
+		std::swap(firstTweak, secondTweak);
+
+	xorbuf(last, inString, firstTweak, 16);
+	m_cipher->ProcessAndXorBlock(last, firstTweak, last);
+	// the partial block takes the place of the first bytes, they become the short output block
+	memcpy(stolen, last, 16);
+	memcpy(stolen, inString+16, partial);
+	memcpy(outString+16, last, partial);
+
+	xorbuf(stolen, secondTweak, 16);
+	m_cipher->ProcessAndXorBlock(stolen, secondTweak, outString);
+}
+
+void XTS_ModeBase::ProcessData(byte *outString, const byte *inString, size_t length)
+{
+	ProcessBlocks(outString, inString, length, m_register);
+}
+
+void XTS_ModeBase::ProcessLastBlock(byte *outString, const byte *inString, size_t length)
+{
+	ProcessWithStealing(outString, inString, length, m_register);
+}
+
+void XTS_ModeBase::ProcessSectors(byte *outString, const byte *inString, size_t sectorSize, size_t sectorCount, lword firstSector)
+{
+	if (sectorSize < 16)
+		throw InvalidArgument("XTS_ModeBase: sector size must be at least 16");
+
+	// bounds the number of jobs per call, the pool gets enough sectors either way
+	const size_t maxBatch = 4096;
+	ThreadPool &pool = ThreadPool::GetGlobalPool();
+	m_sectorSize = sectorSize;
+	m_firstSectorHigh = 0;
+
+	while (sectorCount)
+	{
+		const size_t batch = STDMIN(sectorCount, maxBatch);
+		m_firstSector = firstSector;
+		if (batch>1 && pool.ShouldParallelize(batch*sectorSize))
+			pool.ParallelFor((unsigned int)batch, this, &XTS_ModeBase::ThreadProcessSector, inString, outString);
+		else
+			for (unsigned int i=0; i<batch; i++)
+				ThreadProcessSector(i, inString, outString);
+
+		inString += batch*sectorSize;
+		outString += batch*sectorSize;
+		firstSector += batch;
+		if (firstSector < batch)
+			m_firstSectorHigh++;
+		sectorCount -= batch;
+	}
+}
+
+void XTS_ModeBase::ThreadProcessSector(unsigned int index, const byte *inString, byte *outString)
+{
+	FixedSizeAlignedSecBlock<byte, 16> tweak;
+	const lword sector = m_firstSector+index;
+	PutWord(true, LITTLE_ENDIAN_ORDER, tweak, word64(sector));
+	PutWord(true, LITTLE_ENDIAN_ORDER, tweak+8, word64(m_firstSectorHigh + (sector < m_firstSector)));
+	AccessTweakCipher().ProcessBlock(tweak);
+	ProcessWithStealing(outString+index*m_sectorSize, inString+index*m_sectorSize, m_sectorSize, tweak);
+}
+
 NAMESPACE_END
 
 #endif
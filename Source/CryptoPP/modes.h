@@ -243,6 +243,65 @@ public:
 	void ProcessLastBlock(byte *outString, const byte *inString, size_t length);
 };
 
+//! XTS mode base, see IEEE P1619 and NIST SP 800-38E
+/*! The key is the data key followed by the tweak key, both of the underlying cipher's key length.
+	The IV is the 16 byte tweak, usually the little endian sector number. If no IV is given the mode starts at sector 0. */
+class CRYPTOPP_DLL CRYPTOPP_NO_VTABLE XTS_ModeBase : public BlockOrientedCipherModeBase
+{
+public:
+	size_t MinKeyLength() const {return 2*m_cipher->MinKeyLength();}
+	size_t MaxKeyLength() const {return 2*m_cipher->MaxKeyLength();}
+	size_t DefaultKeyLength() const {return 2*m_cipher->DefaultKeyLength();}
+	size_t GetValidKeyLength(size_t n) const {return 2*m_cipher->GetValidKeyLength(n/2);}
+	bool IsValidKeyLength(size_t n) const {return n%2 == 0 && m_cipher->IsValidKeyLength(n/2);}
+
+	IV_Requirement IVRequirement() const {return UNIQUE_IV;}
+	bool RequireAlignedInput() const {return false;}
+	unsigned int OptimalBlockSize() const {return BlockSize() * m_cipher->OptimalNumberOfParallelBlocks();}
+	unsigned int MinLastBlockSize() const {return BlockSize()+1;}
+	void Resynchronize(const byte *iv, int length=-1);
+	void ProcessData(byte *outString, const byte *inString, size_t length);
+	//! ciphertext stealing, length has to be at least one block
+	void ProcessLastBlock(byte *outString, const byte *inString, size_t length);
+	static const char * CRYPTOPP_API StaticAlgorithmName() {return "XTS";}
+
+	//! encrypts or decrypts sectorCount consecutive sectors of sectorSize bytes, sector i uses the 16 byte little endian encoding of firstSector+i as IV
+	/*! Sectors are independent, so they are spread over ThreadPool::GetGlobalPool().
+		sectorSize has to be at least one block, other sizes use ciphertext stealing. The current IV isn't changed. */
+	void ProcessSectors(byte *outString, const byte *inString, size_t sectorSize, size_t sectorCount, lword firstSector);
+
+protected:
+	enum {TWEAK_BUFFER_BLOCKS = 64};
+
+	XTS_ModeBase() : m_sectorSize(0), m_firstSector(0), m_firstSectorHigh(0), m_aesniRoundKeys(NULL), m_aesniRounds(0) {}
+
+	void UncheckedSetKey(const byte *key, unsigned int length, const NameValuePairs &params);
+	void ResizeBuffers();
+	virtual BlockCipher & AccessTweakCipher() =0;
+
+	// tweak is the tweak of the first block and is advanced past the last one
+	void ProcessBlocks(byte *outString, const byte *inString, size_t length, byte *tweak) const;
+	void ProcessWithStealing(byte *outString, const byte *inString, size_t length, byte *tweak) const;
+	void ThreadProcessSector(unsigned int index, const byte *inString, byte *outString);
+
+	size_t m_sectorSize;
+	lword m_firstSector;
+	// the sector numbers are 128 bits, this word counts the carries out of m_firstSector
+	word64 m_firstSectorHigh;
+	// set by UncheckedSetKey() if the data cipher is AES and AES-NI is available
+	const byte *m_aesniRoundKeys;
+	unsigned int m_aesniRounds;
+};
+
+//! _
+template <class TWEAK_CIPHER>
+class XTS_TweakCipherHolder : public XTS_ModeBase
+{
+protected:
+	BlockCipher & AccessTweakCipher() {return m_tweakCipher;}
+	TWEAK_CIPHER m_tweakCipher;
+};
+
 //! _
 template <class CIPHER, class BASE>
 class CipherModeFinalTemplate_CipherHolder : protected ObjectHolder<CIPHER>, public AlgorithmImpl<BASE, CipherModeFinalTemplate_CipherHolder<CIPHER, BASE> >
@@ -410,6 +469,14 @@ struct CBC_CTS_Mode_ExternalCipher : public CipherModeDocumentation
 	typedef CipherModeFinalTemplate_ExternalCipher<CBC_CTS_Decryption> Decryption;
 };
 
+//! XTS mode, for ciphers with 16 byte blocks
+template <class CIPHER>
+struct XTS_Mode : public CipherModeDocumentation
+{
+	typedef CipherModeFinalTemplate_CipherHolder<CPP_TYPENAME CIPHER::Encryption, XTS_TweakCipherHolder<CPP_TYPENAME CIPHER::Encryption> > Encryption;
+	typedef CipherModeFinalTemplate_CipherHolder<CPP_TYPENAME CIPHER::Decryption, XTS_TweakCipherHolder<CPP_TYPENAME CIPHER::Encryption> > Decryption;
+};
+
 #ifdef CRYPTOPP_MAINTAIN_BACKWARDS_COMPATIBILITY
 typedef CFB_Mode_ExternalCipher::Encryption CFBEncryption;
 typedef CFB_Mode_ExternalCipher::Decryption CFBDecryption;
@@ -0,0 +1,237 @@
+// modexppc.cpp - fixed base precomputation for ModExpPrecomputation groups
+
+#include "pch.h"
+
+#ifndef CRYPTOPP_IMPORTS
+
+#include "modexppc.h"
+#include "asn.h"
+#include "sha.h"
+#include "filters.h"
+#include <algorithm>
+
+NAMESPACE_BEGIN(CryptoPP)
+
+// header of the mapped format: magic, six word32 fields in native byte order, SHA-256 of the group
+static const byte s_mappedMagic[8] = {'M', 'O', 'D', 'E', 'X', 'P', 'P', 'C'};
+static const word32 s_mappedByteOrderMark = 0x01020304;
+enum {MAPPED_FIELDS_OFFSET = 8, MAPPED_FIELDS = 6, MAPPED_HASH_OFFSET = 32};
+
+static inline const MontgomeryRepresentation & GetMontgomeryRepresentation(const DL_GroupPrecomputation<Integer> &group)
+{
+	const ModExpPrecomputation &precomputation = static_cast<const ModExpPrecomputation &>(group);
+	if (!precomputation.HasModulus())
+		throw InvalidArgument("ModExpFixedBasePrecomputation: the group parameters are not initialized");
+	return precomputation.GetMontgomeryRepresentation();
+}
+
+static void HashGroup(byte *digest, const Integer &modulus, const Integer &base)
+{
+	SHA256 hash;
+	HashFilter filter(hash, new ArraySink(digest, SHA256::DIGESTSIZE));
+	modulus.DEREncode(filter);
+	base.DEREncode(filter);
+	filter.MessageEnd();
+}
+
+void ModExpFixedBasePrecomputation::SetBase(const DL_GroupPrecomputation<Element> &group, const Element &base)
+{
+	// the modulus is set before the base, so a new modulus is seen here even if the base is the same
+	if (m_table && (GetMontgomeryRepresentation(group).GetModulus() != m_tableModulus || !(base == GetBase(group))))
+		m_table = NULL;
+	DL_FixedBasePrecomputationImpl<Integer>::SetBase(group, base);
+}
+
+void ModExpFixedBasePrecomputation::Precompute(const DL_GroupPrecomputation<Element> &group, unsigned int maxExpBits, unsigned int storage)
+{
+	m_table = NULL;
+	DL_FixedBasePrecomputationImpl<Integer>::Precompute(group, maxExpBits, storage);
+}
+
+void ModExpFixedBasePrecomputation::Load(const DL_GroupPrecomputation<Element> &group, BufferedTransformation &bt)
+{
+	m_table = NULL;
+	DL_FixedBasePrecomputationImpl<Integer>::Load(group, bt);
+}
+
+void ModExpFixedBasePrecomputation::Save(const DL_GroupPrecomputation<Element> &group, BufferedTransformation &bt) const
+{
+	if (!m_table)
+	{
+		DL_FixedBasePrecomputationImpl<Integer>::Save(group, bt);
+		return;
+	}
+
+	const MontgomeryRepresentation &mr = GetMontgomeryRepresentation(group);
+	const size_t N = mr.ElementWordCount();
+
+	DERSequenceEncoder seq(bt);
+	DEREncodeUnsigned<word32>(seq, 1);	// version
+	m_exponentBase.DEREncode(seq);
+	for (unsigned int i=0; i<m_tableCount; i++)
+		group.DEREncodeElement(seq, mr.DecodeElementWords(m_table+i*N));
+	seq.MessageEnd();
+}
+
+void ModExpFixedBasePrecomputation::SaveMappable(const DL_GroupPrecomputation<Element> &group, BufferedTransformation &bt) const
+{
+	const MontgomeryRepresentation &mr = GetMontgomeryRepresentation(group);
+	const size_t N = mr.ElementWordCount();
+	const unsigned int count = m_table ? m_tableCount : (unsigned int)m_bases.size();
+	if (!count)
+		throw InvalidArgument("ModExpFixedBasePrecomputation: there is no precomputation to save");
+
+	byte header[MAPPED_HEADER_SIZE];
+	memset(header, 0, sizeof(header));
+	memcpy(header, s_mappedMagic, sizeof(s_mappedMagic));
+	const word32 fields[MAPPED_FIELDS] = {MAPPED_VERSION, WORD_SIZE, s_mappedByteOrderMark, (word32)N, m_windowSize, count};
+	memcpy(header+MAPPED_FIELDS_OFFSET, fields, sizeof(fields));
+	HashGroup(header+MAPPED_HASH_OFFSET, mr.GetModulus(), GetBase(group));
+	bt.Put(header, sizeof(header));
+
+	if (m_table)
+		bt.Put((const byte *)m_table, count*N*WORD_SIZE);
+	else
+	{
+		SecBlock<word> words(N);
+		for (unsigned int i=0; i<count; i++)
+		{
+			mr.EncodeElementWords(words, m_bases[i]);
+			bt.Put((const byte *)words.begin(), N*WORD_SIZE);
+		}
+	}
+}
+
+void ModExpFixedBasePrecomputation::LoadMapped(const DL_GroupPrecomputation<Element> &group, const byte *data, size_t size)
+{
+	const MontgomeryRepresentation &mr = GetMontgomeryRepresentation(group);
+	const size_t N = mr.ElementWordCount();
+
+	if (!IsAligned<word>(data))
+		throw InvalidArgument("ModExpFixedBasePrecomputation: mapped precomputation is not aligned for words");
+	if (size < MAPPED_HEADER_SIZE || memcmp(data, s_mappedMagic, sizeof(s_mappedMagic)) != 0)
+		throw InvalidDataFormat("ModExpFixedBasePrecomputation: not a mapped precomputation");
+
+	word32 fields[MAPPED_FIELDS];
+	memcpy(fields, data+MAPPED_FIELDS_OFFSET, sizeof(fields));
+	if (fields[0] != MAPPED_VERSION)
+		throw InvalidDataFormat("ModExpFixedBasePrecomputation: unsupported version of mapped precomputation");
+	if (fields[1] != WORD_SIZE || fields[2] != s_mappedByteOrderMark || fields[3] != N)
+		throw InvalidDataFormat("ModExpFixedBasePrecomputation: mapped precomputation was written for another word size, byte order or modulus size");
+
+	const unsigned int windowSize = fields[4], count = fields[5];
+	const size_t tableSize = size - MAPPED_HEADER_SIZE;
+	if (count == 0 || (count > 1 && windowSize == 0) || windowSize > 0xffff || tableSize % (N*WORD_SIZE) != 0 || tableSize / (N*WORD_SIZE) != count)
+		throw InvalidDataFormat("ModExpFixedBasePrecomputation: mapped precomputation is damaged");
+
+	const word *table = (const word *)(data + MAPPED_HEADER_SIZE);
+	Integer base = mr.ConvertOut(mr.DecodeElementWords(table));
+	byte digest[SHA256::DIGESTSIZE];
+	HashGroup(digest, mr.GetModulus(), base);
+	if (!VerifyBufsEqual(digest, data+MAPPED_HASH_OFFSET, sizeof(digest)) || (IsInitialized() && !(base == GetBase(group))))
+		throw InvalidDataFormat("ModExpFixedBasePrecomputation: mapped precomputation is for a different group");
+
+	m_base = base;
+	m_bases.assign(1, mr.DecodeElementWords(table));
+	m_windowSize = windowSize;
+	m_exponentBase = count > 1 ? Integer::Power2(windowSize) : Integer::Zero();
+	m_table = table;
+	m_tableCount = count;
+	m_tableModulus = mr.GetModulus();
+}
+
+Integer ModExpFixedBasePrecomputation::MontgomeryExponentiate(const MontgomeryRepresentation &mr, const DL_GroupPrecomputation<Element> &group, const Integer &exponent) const
+{
+	if (!m_table)
+	{
+		std::vector<BaseAndExponent<Integer> > eb;
+		eb.reserve(m_bases.size());
+		PrepareCascade(group, eb, exponent);
+		return GeneralCascadeMultiplication<Integer>(group.GetGroup(), eb.begin(), eb.end());
+	}
+
+	const size_t N = mr.ElementWordCount();
+	const unsigned int w = m_windowSize, count = m_tableCount;
+	if (exponent.IsNegative())
+	{
+		Integer inverse = mr.MultiplicativeInverse(m_bases[0]);
+		return mr.MultiplicativeGroup().ScalarMultiply(inverse, -exponent);
+	}
+	if (exponent.BitCount() > (size_t)w*count)	// beyond the table
+		return mr.MultiplicativeGroup().ScalarMultiply(m_bases[0], exponent);
+
+	// With digits of w bits, Yao's method costs a multiplication per nonzero digit and one per
+	// digit value, and reads the bases in place. A wide window means few bases, which are then
+	// copied out for the same cascade as an unmapped precomputation.
+	if (w > 16 || (lword(1) << w) + count > lword(w) * count / 2)
+	{
+		std::vector<BaseAndExponent<Integer> > eb;
+		eb.reserve(count);
+		Integer r, q, e = exponent;
+		for (unsigned int i=0; i<count; i++)
+		{
+			Integer::DivideByPowerOf2(r, q, e, w);
+			std::swap(q, e);
+			eb.push_back(BaseAndExponent<Integer>(mr.DecodeElementWords(m_table+i*N), r));
+		}
+		return GeneralCascadeMultiplication<Integer>(group.GetGroup(), eb.begin(), eb.end());
+	}
+
+	std::vector<std::pair<word32, word32> > digits;
+	digits.reserve(count);
+	for (unsigned int i=0; i<count; i++)
+	{
+		word32 d = (word32)exponent.GetBits(i*w, w);
+		if (d)
+			digits.push_back(std::make_pair(d, (word32)i));
+	}
+	if (digits.empty())
+		return mr.MultiplicativeIdentity();
+	std::sort(digits.rbegin(), digits.rend());
+
+	// b is the product of the bases whose digit is at least d, a the product of b over all d
+	Integer a, b;
+	size_t k = 0;
+	for (word32 d = digits[0].first; d > 0; d--)
+	{
+		for (; k < digits.size() && digits[k].first == d; k++)
+		{
+			const word *entry = m_table + digits[k].second*N;
+			if (k == 0)
+				b = mr.DecodeElementWords(entry);
+			else
+				b = mr.MultiplyElementWords(b, entry);
+		}
+		if (d == digits[0].first)
+			a = b;
+		else
+			a = mr.Multiply(a, b);
+	}
+	return a;
+}
+
+Integer ModExpFixedBasePrecomputation::Exponentiate(const DL_GroupPrecomputation<Element> &group, const Integer &exponent) const
+{
+	if (!m_table)
+		return DL_FixedBasePrecomputationImpl<Integer>::Exponentiate(group, exponent);
+
+	return group.ConvertOut(MontgomeryExponentiate(GetMontgomeryRepresentation(group), group, exponent));
+}
+
+Integer ModExpFixedBasePrecomputation::CascadeExponentiate(const DL_GroupPrecomputation<Element> &group, const Integer &exponent,
+	const DL_FixedBasePrecomputation<Integer> &i_pc2, const Integer &exponent2) const
+{
+	const ModExpFixedBasePrecomputation &pc2 = static_cast<const ModExpFixedBasePrecomputation &>(i_pc2);
+	if (!m_table && !pc2.m_table)
+		return DL_FixedBasePrecomputationImpl<Integer>::CascadeExponentiate(group, exponent, i_pc2, exponent2);
+
+	// a mapped table is read in place, so the two exponentiations are done apart and multiplied
+	const MontgomeryRepresentation &mr = GetMontgomeryRepresentation(group);
+	Integer x = MontgomeryExponentiate(mr, group, exponent);
+	Integer y = pc2.MontgomeryExponentiate(mr, group, exponent2);
+	return group.ConvertOut(mr.Multiply(x, y));
+}
+
+NAMESPACE_END
+
+#endif
@@ -23,12 +23,55 @@ public:
 
 	// non-inherited
 	void SetModulus(const Integer &v) {m_mr.reset(new MontgomeryRepresentation(v));}
+	bool HasModulus() const {return m_mr.get() != NULL;}
 	const Integer & GetModulus() const {return m_mr->GetModulus();}
+	const MontgomeryRepresentation & GetMontgomeryRepresentation() const {return *m_mr;}
 
 private:
 	value_ptr<MontgomeryRepresentation> m_mr;
 };
 
+//! fixed base precomputation for ModExpPrecomputation that can also run from a table in memory
+/*! Besides the DER format of Save() and Load(), SaveMappable() writes the precomputed bases as
+	native words in Montgomery form, after a header holding the format version, the word and
+	element sizes, the window size and a SHA-256 hash of the modulus and base. LoadMapped()
+	checks the header and then exponentiates reading the bases where they lie, typically in a
+	MappedFile shared by all worker processes, so nothing is parsed or allocated per process.
+	Since the table costs no private memory, it pays to save it with a small window: storage
+	of a base per 8 exponent bits makes Exponentiate() a Yao style product of the table
+	entries with about 250 further multiplications.
+	\note the memory passed to LoadMapped() must outlive this object and every copy of it */
+class CRYPTOPP_DLL ModExpFixedBasePrecomputation : public DL_FixedBasePrecomputationImpl<Integer>
+{
+public:
+	enum {MAPPED_HEADER_SIZE = 64, MAPPED_VERSION = 1};
+
+	ModExpFixedBasePrecomputation() : m_table(NULL), m_tableCount(0) {}
+
+	// DL_FixedBasePrecomputation
+	void SetBase(const DL_GroupPrecomputation<Element> &group, const Element &base);
+	void Precompute(const DL_GroupPrecomputation<Element> &group, unsigned int maxExpBits, unsigned int storage);
+	void Load(const DL_GroupPrecomputation<Element> &group, BufferedTransformation &storedPrecomputation);
+	void Save(const DL_GroupPrecomputation<Element> &group, BufferedTransformation &storedPrecomputation) const;
+	Element Exponentiate(const DL_GroupPrecomputation<Element> &group, const Integer &exponent) const;
+	Element CascadeExponentiate(const DL_GroupPrecomputation<Element> &group, const Integer &exponent, const DL_FixedBasePrecomputation<Element> &pc2, const Integer &exponent2) const;
+
+	// non-inherited
+	//! writes the precomputation in the format LoadMapped() reads
+	void SaveMappable(const DL_GroupPrecomputation<Element> &group, BufferedTransformation &storedPrecomputation) const;
+	//! uses a precomputation written by SaveMappable() in place, data must be aligned for words
+	/*! \throw InvalidDataFormat if the header does not match this platform or group */
+	void LoadMapped(const DL_GroupPrecomputation<Element> &group, const byte *data, size_t size);
+	bool IsMapped() const {return m_table != NULL;}
+
+private:
+	Integer MontgomeryExponentiate(const MontgomeryRepresentation &mr, const DL_GroupPrecomputation<Element> &group, const Integer &exponent) const;
+
+	const word *m_table;		// m_tableCount bases, each in ElementWordCount() words
+	Integer m_tableModulus;		// modulus the table was written for
+	unsigned int m_tableCount;
+};
+
 NAMESPACE_END
 
 #endif
@@ -0,0 +1,507 @@
+// ocb.cpp - offset codebook mode (RFC 7253), placed in the public domain
+
+#include "pch.h"
+
+#ifndef CRYPTOPP_IMPORTS
+
+#include "ocb.h"
+#include "cpu.h"
+#include "rijndael.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! doubling in GF(2^128), the bytes are in big endian order
+static void OCB_Double(byte *out, const byte *in)
+{
+	const byte reduce = byte(0x87 & (0-(in[0] >> 7)));
+	for (unsigned int i=0; i<15; i++)
+		out[i] = byte((in[i] << 1) | (in[i+1] >> 7));
+	out[15] = byte((in[15] << 1) ^ reduce);
+}
+
+//! xors count blocks into the aligned block sum
+static void OCB_XorBlocks(byte *sum, const byte *blocks, size_t count)
+{
+#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+	__m128i s0 = _mm_load_si128((const __m128i *)sum);
+	__m128i s1 = _mm_setzero_si128();
+	for (; count >= 2; count-=2, blocks+=32)
+	{
+		s0 = _mm_xor_si128(s0, _mm_loadu_si128((const __m128i *)blocks));
+		s1 = _mm_xor_si128(s1, _mm_loadu_si128((const __m128i *)(blocks+16)));
+	}
+	if (count)
+		s0 = _mm_xor_si128(s0, _mm_loadu_si128((const __m128i *)blocks));
+	_mm_store_si128((__m128i *)sum, _mm_xor_si128(s0, s1));
+#else
+	for (; count; count--, blocks+=16)
+		xorbuf(sum, blocks, 16);
+#endif
+}
+
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+#define OCB_AES_ROUND(op, rk)	\
+	block0 = op(block0, rk); block1 = op(block1, rk); block2 = op(block2, rk); block3 = op(block3, rk);	\
+	block4 = op(block4, rk); block5 = op(block5, rk); block6 = op(block6, rk); block7 = op(block7, rk);
+
+// 8 blocks per iteration with the offsets and the checksum kept in registers,
+// the offsets are folded into the first and the last round key
+template <bool ENCRYPT>
+static void AESNI_OCB_ProcessBlocks(const __m128i *subkeys, unsigned int rounds, const __m128i *table, __m128i &offsetRef, __m128i &checksumRef, lword &blockIndex, const byte *inString, byte *outString, size_t blocks)
+{
+	__m128i offset = offsetRef, checksum = checksumRef;
+	lword index = blockIndex;
+
+	while (blocks >= 8)
+	{
+		const __m128i offset0 = _mm_xor_si128(offset, table[TrailingZeros(index+1)]);
+		const __m128i offset1 = _mm_xor_si128(offset0, table[TrailingZeros(index+2)]);
+		const __m128i offset2 = _mm_xor_si128(offset1, table[TrailingZeros(index+3)]);
+		const __m128i offset3 = _mm_xor_si128(offset2, table[TrailingZeros(index+4)]);
+		const __m128i offset4 = _mm_xor_si128(offset3, table[TrailingZeros(index+5)]);
+		const __m128i offset5 = _mm_xor_si128(offset4, table[TrailingZeros(index+6)]);
+		const __m128i offset6 = _mm_xor_si128(offset5, table[TrailingZeros(index+7)]);
+		const __m128i offset7 = _mm_xor_si128(offset6, table[TrailingZeros(index+8)]);
+		offset = offset7;
+		index += 8;
+
+		__m128i block0 = _mm_loadu_si128((const __m128i *)inString);
+		__m128i block1 = _mm_loadu_si128((const __m128i *)(inString+16));
+		__m128i block2 = _mm_loadu_si128((const __m128i *)(inString+32));
+		__m128i block3 = _mm_loadu_si128((const __m128i *)(inString+48));
+		__m128i block4 = _mm_loadu_si128((const __m128i *)(inString+64));
+		__m128i block5 = _mm_loadu_si128((const __m128i *)(inString+80));
+		__m128i block6 = _mm_loadu_si128((const __m128i *)(inString+96));
+		__m128i block7 = _mm_loadu_si128((const __m128i *)(inString+112));
+		if (ENCRYPT)
+			checksum = _mm_xor_si128(checksum, _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(block0, block1), _mm_xor_si128(block2, block3)),
+				_mm_xor_si128(_mm_xor_si128(block4, block5), _mm_xor_si128(block6, block7))));
+
+		__m128i rk = subkeys[0];
+		block0 = _mm_xor_si128(block0, _mm_xor_si128(offset0, rk));
+		block1 = _mm_xor_si128(block1, _mm_xor_si128(offset1, rk));
+		block2 = _mm_xor_si128(block2, _mm_xor_si128(offset2, rk));
+		block3 = _mm_xor_si128(block3, _mm_xor_si128(offset3, rk));
+		block4 = _mm_xor_si128(block4, _mm_xor_si128(offset4, rk));
+		block5 = _mm_xor_si128(block5, _mm_xor_si128(offset5, rk));
+		block6 = _mm_xor_si128(block6, _mm_xor_si128(offset6, rk));
+		block7 = _mm_xor_si128(block7, _mm_xor_si128(offset7, rk));
+
+		for (unsigned int i=1; i<rounds; i++)
+		{
+			rk = subkeys[i];
+			if (ENCRYPT)
+				{OCB_AES_ROUND(_mm_aesenc_si128, rk)}
+			else
+				{OCB_AES_ROUND(_mm_aesdec_si128, rk)}
+		}
+
+		rk = subkeys[rounds];
+		if (ENCRYPT)
+		{
+			block0 = _mm_aesenclast_si128(block0, _mm_xor_si128(offset0, rk));
+			block1 = _mm_aesenclast_si128(block1, _mm_xor_si128(offset1, rk));
+			block2 = _mm_aesenclast_si128(block2, _mm_xor_si128(offset2, rk));
+			block3 = _mm_aesenclast_si128(block3, _mm_xor_si128(offset3, rk));
+			block4 = _mm_aesenclast_si128(block4, _mm_xor_si128(offset4, rk));
+			block5 = _mm_aesenclast_si128(block5, _mm_xor_si128(offset5, rk));
+			block6 = _mm_aesenclast_si128(block6, _mm_xor_si128(offset6, rk));
+			block7 = _mm_aesenclast_si128(block7, _mm_xor_si128(offset7, rk));
+		}
+		else
+		{
+			block0 = _mm_aesdeclast_si128(block0, _mm_xor_si128(offset0, rk));
+			block1 = _mm_aesdeclast_si128(block1, _mm_xor_si128(offset1, rk));
+			block2 = _mm_aesdeclast_si128(block2, _mm_xor_si128(offset2, rk));
+			block3 = _mm_aesdeclast_si128(block3, _mm_xor_si128(offset3, rk));
+			block4 = _mm_aesdeclast_si128(block4, _mm_xor_si128(offset4, rk));
+			block5 = _mm_aesdeclast_si128(block5, _mm_xor_si128(offset5, rk));
+			block6 = _mm_aesdeclast_si128(block6, _mm_xor_si128(offset6, rk));
+			block7 = _mm_aesdeclast_si128(block7, _mm_xor_si128(offset7, rk));
+			checksum = _mm_xor_si128(checksum, _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(block0, block1), _mm_xor_si128(block2, block3)),
+				_mm_xor_si128(_mm_xor_si128(block4, block5), _mm_xor_si128(block6, block7))));
+		}
+
+		_mm_storeu_si128((__m128i *)outString, block0);
+		_mm_storeu_si128((__m128i *)(outString+16), block1);
+		_mm_storeu_si128((__m128i *)(outString+32), block2);
+		_mm_storeu_si128((__m128i *)(outString+48), block3);
+		_mm_storeu_si128((__m128i *)(outString+64), block4);
+		_mm_storeu_si128((__m128i *)(outString+80), block5);
+		_mm_storeu_si128((__m128i *)(outString+96), block6);
+		_mm_storeu_si128((__m128i *)(outString+112), block7);
+
+		inString += 128;
+		outString += 128;
+		blocks -= 8;
+	}
+
+	for (; blocks; blocks--, inString+=16, outString+=16)
+	{
+		offset = _mm_xor_si128(offset, table[TrailingZeros(++index)]);
+		__m128i block = _mm_loadu_si128((const __m128i *)inString);
+		if (ENCRYPT)
+			checksum = _mm_xor_si128(checksum, block);
+		block = _mm_xor_si128(block, _mm_xor_si128(offset, subkeys[0]));
+		for (unsigned int i=1; i<rounds; i++)
+			block = ENCRYPT ? _mm_aesenc_si128(block, subkeys[i]) : _mm_aesdec_si128(block, subkeys[i]);
+		const __m128i rk = _mm_xor_si128(offset, subkeys[rounds]);
+		block = ENCRYPT ? _mm_aesenclast_si128(block, rk) : _mm_aesdeclast_si128(block, rk);
+		if (!ENCRYPT)
+			checksum = _mm_xor_si128(checksum, block);
+		_mm_storeu_si128((__m128i *)outString, block);
+	}
+
+	offsetRef = offset;
+	checksumRef = checksum;
+	blockIndex = index;
+}
+
+#undef OCB_AES_ROUND
+
+#if CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE && CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE
+#define OCB_VAES_ROUND(op, rk)	\
+	block0 = op(block0, rk); block1 = op(block1, rk); block2 = op(block2, rk); block3 = op(block3, rk);
+
+// 16 blocks per iteration in ZMM registers, blockIndex must be a multiple of 16 so that the offsets
+// of a run are the offset before it xored with the constant prefixes, only the last one depends on the index
+template <bool ENCRYPT>
+static void VAES_OCB_ProcessBlocks(const __m128i *subkeys, unsigned int rounds, const __m128i *table, const __m128i *prefixes, __m128i &offsetRef, __m128i &checksumRef, lword &blockIndex, const byte *&inString, byte *&outString, size_t &blocks)
+{
+	assert(blockIndex%16 == 0);
+	if (blocks < 16)
+		return;
+
+	const __m512i prefix0 = _mm512_loadu_si512((const void *)prefixes);
+	const __m512i prefix1 = _mm512_loadu_si512((const void *)(prefixes+4));
+	const __m512i prefix2 = _mm512_loadu_si512((const void *)(prefixes+8));
+	const __m512i prefix3 = _mm512_loadu_si512((const void *)(prefixes+12));
+	__m512i offset = _mm512_broadcast_i32x4(offsetRef);
+	__m512i checksum = _mm512_inserti32x4(_mm512_setzero_si512(), checksumRef, 0);
+	lword index = blockIndex;
+
+	while (blocks >= 16)
+	{
+		index += 16;
+		// prefixes[15] assumes L_4 for the last block, the index may have more trailing zeros
+		const __m512i last = _mm512_inserti32x4(_mm512_setzero_si512(), _mm_xor_si128(table[4], table[TrailingZeros(index)]), 3);
+		const __m512i offsets0 = _mm512_xor_si512(offset, prefix0);
+		const __m512i offsets1 = _mm512_xor_si512(offset, prefix1);
+		const __m512i offsets2 = _mm512_xor_si512(offset, prefix2);
+		const __m512i offsets3 = _mm512_xor_si512(_mm512_xor_si512(offset, prefix3), last);
+		offset = _mm512_shuffle_i32x4(offsets3, offsets3, 0xff);
+
+		__m512i block0 = _mm512_loadu_si512((const void *)inString);
+		__m512i block1 = _mm512_loadu_si512((const void *)(inString+64));
+		__m512i block2 = _mm512_loadu_si512((const void *)(inString+128));
+		__m512i block3 = _mm512_loadu_si512((const void *)(inString+192));
+		if (ENCRYPT)
+			checksum = _mm512_xor_si512(checksum, _mm512_xor_si512(_mm512_xor_si512(block0, block1), _mm512_xor_si512(block2, block3)));
+
+		__m512i rk = _mm512_broadcast_i32x4(subkeys[0]);
+		block0 = _mm512_xor_si512(block0, _mm512_xor_si512(offsets0, rk));
+		block1 = _mm512_xor_si512(block1, _mm512_xor_si512(offsets1, rk));
+		block2 = _mm512_xor_si512(block2, _mm512_xor_si512(offsets2, rk));
+		block3 = _mm512_xor_si512(block3, _mm512_xor_si512(offsets3, rk));
+
+		for (unsigned int i=1; i<rounds; i++)
+		{
+			rk = _mm512_broadcast_i32x4(subkeys[i]);
+			if (ENCRYPT)
+				{OCB_VAES_ROUND(_mm512_aesenc_epi128, rk)}
+			else
+				{OCB_VAES_ROUND(_mm512_aesdec_epi128, rk)}
+		}
+
+		rk = _mm512_broadcast_i32x4(subkeys[rounds]);
+		if (ENCRYPT)
+		{
+			block0 = _mm512_aesenclast_epi128(block0, _mm512_xor_si512(offsets0, rk));
+			block1 = _mm512_aesenclast_epi128(block1, _mm512_xor_si512(offsets1, rk));
+			block2 = _mm512_aesenclast_epi128(block2, _mm512_xor_si512(offsets2, rk));
+			block3 = _mm512_aesenclast_epi128(block3, _mm512_xor_si512(offsets3, rk));
+		}
+		else
+		{
+			block0 = _mm512_aesdeclast_epi128(block0, _mm512_xor_si512(offsets0, rk));
+			block1 = _mm512_aesdeclast_epi128(block1, _mm512_xor_si512(offsets1, rk));
+			block2 = _mm512_aesdeclast_epi128(block2, _mm512_xor_si512(offsets2, rk));
+			block3 = _mm512_aesdeclast_epi128(block3, _mm512_xor_si512(offsets3, rk));
+			checksum = _mm512_xor_si512(checksum, _mm512_xor_si512(_mm512_xor_si512(block0, block1), _mm512_xor_si512(block2, block3)));
+		}
+
+		_mm512_storeu_si512((void *)outString, block0);
+		_mm512_storeu_si512((void *)(outString+64), block1);
+		_mm512_storeu_si512((void *)(outString+128), block2);
+		_mm512_storeu_si512((void *)(outString+192), block3);
+
+		inString += 256;
+		outString += 256;
+		blocks -= 16;
+	}
+
+	const __m256i checksum256 = _mm256_xor_si256(_mm512_castsi512_si256(checksum), _mm512_extracti64x4_epi64(checksum, 1));
+	checksumRef = _mm_xor_si128(_mm256_castsi256_si128(checksum256), _mm256_extracti128_si256(checksum256, 1));
+	offsetRef = _mm512_castsi512_si128(offset);
+	blockIndex = index;
+}
+
+#undef OCB_VAES_ROUND
+#endif
+#endif
+
+void OCB_Base::SetKeyWithoutResync(const byte *userKey, size_t keylength, const NameValuePairs &params)
+{
+	BlockCipher &blockCipher = AccessBlockCipher();
+	blockCipher.SetKey(userKey, keylength, params);
+
+	if (blockCipher.BlockSize() != REQUIRED_BLOCKSIZE)
+		throw InvalidArgument(AlgorithmName() + ": block size of underlying block cipher is not 16");
+
+	if (!IsForwardTransformation())
+		AccessDataCipher().SetKey(userKey, keylength, params);
+
+	m_digestSize = params.GetIntValueWithDefault(Name::DigestSize(), DefaultDigestSize());
+	if (m_digestSize < 1 || m_digestSize > REQUIRED_BLOCKSIZE)
+		throw InvalidArgument(AlgorithmName() + ": DigestSize must be between 1 and 16");
+
+	m_buffer.New((10+L_TABLE_SIZE+PREFIX_TABLE_SIZE+OFFSET_BUFFER_BLOCKS)*REQUIRED_BLOCKSIZE);
+
+	byte *lStar = LStar();
+	memset(lStar, 0, REQUIRED_BLOCKSIZE);
+	blockCipher.ProcessBlock(lStar);
+	OCB_Double(LDollar(), lStar);
+
+	byte *table = LTable();
+	OCB_Double(table, LDollar());
+	for (unsigned int i=1; i<L_TABLE_SIZE; i++)
+		OCB_Double(table+i*REQUIRED_BLOCKSIZE, table+(i-1)*REQUIRED_BLOCKSIZE);
+
+	byte *prefixes = PrefixTable();
+	memcpy(prefixes, table, REQUIRED_BLOCKSIZE);
+	for (unsigned int i=1; i<PREFIX_TABLE_SIZE; i++)
+		xorbuf(prefixes+i*REQUIRED_BLOCKSIZE, prefixes+(i-1)*REQUIRED_BLOCKSIZE, table+TrailingZeros(word32(i+1))*REQUIRED_BLOCKSIZE, REQUIRED_BLOCKSIZE);
+
+	m_aesniRoundKeys = NULL;
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+	if (HasAESNI())
+	{
+		if (const Rijndael::Encryption *aes = dynamic_cast<const Rijndael::Encryption *>(&AccessDataCipher()))
+			m_aesniRoundKeys = aes->GetAESNIRoundKeys(m_aesniRounds);
+		else if (const Rijndael::Decryption *aes = dynamic_cast<const Rijndael::Decryption *>(&AccessDataCipher()))
+			m_aesniRoundKeys = aes->GetAESNIRoundKeys(m_aesniRounds);
+	}
+#endif
+
+	// a formatted nonce always has a bit set, so this forces the first Resync to encrypt it
+	memset(NonceBlock(), 0, REQUIRED_BLOCKSIZE);
+}
+
+void OCB_Base::Resync(const byte *iv, size_t len)
+{
+	FixedSizeAlignedSecBlock<byte, REQUIRED_BLOCKSIZE> nonce;
+	memset(nonce, 0, REQUIRED_BLOCKSIZE);
+	nonce[0] = byte((m_digestSize*8 % 128) << 1);
+	nonce[REQUIRED_BLOCKSIZE-1-len] |= 1;
+	memcpy(nonce+REQUIRED_BLOCKSIZE-len, iv, len);
+
+	const unsigned int bottom = nonce[REQUIRED_BLOCKSIZE-1] & 63;
+	nonce[REQUIRED_BLOCKSIZE-1] &= 0xc0;
+
+	// consecutive nonces usually differ only in the bottom bits, so Ktop and the stretch are reused
+	byte *stretch = Stretch();
+	if (memcmp(nonce, NonceBlock(), REQUIRED_BLOCKSIZE) != 0)
+	{
+		memcpy(NonceBlock(), nonce, REQUIRED_BLOCKSIZE);
+		AccessBlockCipher().ProcessBlock(nonce, stretch);
+		for (unsigned int i=0; i<8; i++)
+			stretch[REQUIRED_BLOCKSIZE+i] = stretch[i] ^ stretch[i+1];
+	}
+
+	const byte *s = stretch + bottom/8;
+	const unsigned int shift = bottom%8;
+	byte *offset = Offset();
+	for (unsigned int i=0; i<REQUIRED_BLOCKSIZE; i++)
+		offset[i] = shift ? byte((s[i] << shift) | (s[i+1] >> (8-shift))) : s[i];
+
+	// the checksum, the header offset and the header sum
+	memset(Checksum(), 0, 3*REQUIRED_BLOCKSIZE);
+	m_headerBlocks = m_messageBlocks = 0;
+}
+
+void OCB_Base::NextOffsets(byte *offsets, byte *offset, lword &blockIndex, size_t blocks)
+{
+	const word64 *table = (const word64 *)LTable();
+	word64 *out = (word64 *)offsets;
+	word64 o0 = ((word64 *)offset)[0], o1 = ((word64 *)offset)[1];
+
+	for (size_t i=0; i<blocks; i++)
+	{
+		const word64 *l = table + 2*TrailingZeros(++blockIndex);
+		o0 ^= l[0];
+		o1 ^= l[1];
+		out[2*i] = o0;
+		out[2*i+1] = o1;
+	}
+
+	((word64 *)offset)[0] = o0;
+	((word64 *)offset)[1] = o1;
+}
+
+size_t OCB_Base::AuthenticateBlocks(const byte *data, size_t len)
+{
+	const BlockCipher &cipher = AccessBlockCipher();
+	byte *offsets = OffsetBuffer();
+	size_t blocks = len/REQUIRED_BLOCKSIZE;
+
+	while (blocks)
+	{
+		const size_t chunk = STDMIN(blocks, (size_t)OFFSET_BUFFER_BLOCKS);
+		NextOffsets(offsets, HashOffset(), m_headerBlocks, chunk);
+		cipher.AdvancedProcessBlocks(data, offsets, offsets, chunk*REQUIRED_BLOCKSIZE, BlockTransformation::BT_XorInput|BlockTransformation::BT_AllowParallel);
+		OCB_XorBlocks(HashSum(), offsets, chunk);
+
+		data += chunk*REQUIRED_BLOCKSIZE;
+		blocks -= chunk;
+	}
+
+	return len%REQUIRED_BLOCKSIZE;
+}
+
+void OCB_Base::AuthenticateLastHeaderBlock()
+{
+	if (m_bufferedDataLength > 0)
+	{
+		byte *offset = HashOffset();
+		xorbuf(offset, LStar(), REQUIRED_BLOCKSIZE);
+
+		m_buffer[m_bufferedDataLength] = 0x80;
+		memset(m_buffer+m_bufferedDataLength+1, 0, REQUIRED_BLOCKSIZE-m_bufferedDataLength-1);
+		xorbuf(m_buffer, offset, REQUIRED_BLOCKSIZE);
+		AccessBlockCipher().ProcessBlock(m_buffer);
+		xorbuf(HashSum(), m_buffer, REQUIRED_BLOCKSIZE);
+	}
+}
+
+void OCB_Base::AuthenticateLastFooterBlock(byte *mac, size_t macSize)
+{
+	xorbuf(m_buffer, Checksum(), Offset(), REQUIRED_BLOCKSIZE);
+	xorbuf(m_buffer, LDollar(), REQUIRED_BLOCKSIZE);
+	AccessBlockCipher().ProcessAndXorBlock(m_buffer, HashSum(), m_buffer);
+	memcpy(mac, m_buffer, macSize);
+}
+
+void OCB_Base::ProcessBlocks(byte *outString, const byte *inString, size_t blocks)
+{
+	const BlockCipher &cipher = AccessDataCipher();
+	const bool encrypt = IsForwardTransformation();
+
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+	if (m_aesniRoundKeys)
+	{
+		const __m128i *subkeys = (const __m128i *)m_aesniRoundKeys;
+		const __m128i *table = (const __m128i *)LTable();
+		const unsigned int rounds = m_aesniRounds;
+		__m128i offset = _mm_load_si128((const __m128i *)Offset());
+		__m128i checksum = _mm_load_si128((const __m128i *)Checksum());
+#if CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE && CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE
+		if (HasVAES() && HasAVX512())
+		{
+			// up to the next multiple of 16 blocks first
+			const size_t lead = STDMIN(blocks, size_t(16-m_messageBlocks%16)%16);
+			if (encrypt)
+				AESNI_OCB_ProcessBlocks<true>(subkeys, rounds, table, offset, checksum, m_messageBlocks, inString, outString, lead);
+			else
+				AESNI_OCB_ProcessBlocks<false>(subkeys, rounds, table, offset, checksum, m_messageBlocks, inString, outString, lead);
+			inString += lead*REQUIRED_BLOCKSIZE;
+			outString += lead*REQUIRED_BLOCKSIZE;
+			blocks -= lead;
+
+			if (encrypt)
+				VAES_OCB_ProcessBlocks<true>(subkeys, rounds, table, (const __m128i *)PrefixTable(), offset, checksum, m_messageBlocks, inString, outString, blocks);
+			else
+				VAES_OCB_ProcessBlocks<false>(subkeys, rounds, table, (const __m128i *)PrefixTable(), offset, checksum, m_messageBlocks, inString, outString, blocks);
+		}
+#endif
+		if (encrypt)
+			AESNI_OCB_ProcessBlocks<true>(subkeys, rounds, table, offset, checksum, m_messageBlocks, inString, outString, blocks);
+		else
+			AESNI_OCB_ProcessBlocks<false>(subkeys, rounds, table, offset, checksum, m_messageBlocks, inString, outString, blocks);
+		_mm_store_si128((__m128i *)Offset(), offset);
+		_mm_store_si128((__m128i *)Checksum(), checksum);
+		return;
+	}
+#endif
+
+	byte *offsets = OffsetBuffer();
+	while (blocks)
+	{
+		const size_t chunk = STDMIN(blocks, (size_t)OFFSET_BUFFER_BLOCKS);
+		const size_t len = chunk*REQUIRED_BLOCKSIZE;
+
+		// the checksum is over the plaintext, which may be overwritten when processing in place
+		if (encrypt)
+			OCB_XorBlocks(Checksum(), inString, chunk);
+		NextOffsets(offsets, Offset(), m_messageBlocks, chunk);
+		cipher.AdvancedProcessBlocks(inString, offsets, outString, len, BlockTransformation::BT_XorInput|BlockTransformation::BT_AllowParallel);
+		xorbuf(outString, offsets, len);
+		if (!encrypt)
+			OCB_XorBlocks(Checksum(), outString, chunk);
+
+		inString += len;
+		outString += len;
+		blocks -= chunk;
+	}
+}
+
+void OCB_Base::ProcessData(byte *outString, const byte *inString, size_t length)
+{
+	if (m_state >= State_IVSet && m_totalMessageLength%REQUIRED_BLOCKSIZE != 0 && length > 0)
+		throw InvalidArgument(AlgorithmName() + ": only the last call to ProcessData can have a length that is not a multiple of the block size");
+
+	m_totalMessageLength += length;
+	if (m_state >= State_IVSet && m_totalMessageLength > MaxMessageLength())
+		throw InvalidArgument(AlgorithmName() + ": message length exceeds maximum");
+
+	switch (m_state)
+	{
+	case State_Start:
+	case State_KeySet:
+		throw BadState(AlgorithmName(), "ProcessData", "setting key and IV");
+	case State_AuthFooter:
+		throw BadState(AlgorithmName(), "ProcessData was called after footer input has started");
+	case State_IVSet:
+		AuthenticateLastHeaderBlock();
+		m_bufferedDataLength = 0;
+		m_state = State_AuthUntransformed;
+		break;
+	default:
+		break;
+	}
+
+	const size_t blocks = length/REQUIRED_BLOCKSIZE;
+	ProcessBlocks(outString, inString, blocks);
+	inString += blocks*REQUIRED_BLOCKSIZE;
+	outString += blocks*REQUIRED_BLOCKSIZE;
+	length %= REQUIRED_BLOCKSIZE;
+
+	if (length)
+	{
+		byte *offset = Offset();
+		xorbuf(offset, LStar(), REQUIRED_BLOCKSIZE);
+
+		// the pad is built in the header buffer, which is free once the message has started
+		byte *checksum = Checksum();
+		AccessBlockCipher().ProcessBlock(offset, m_buffer);
+		if (IsForwardTransformation())
+			xorbuf(checksum, inString, length);
+		xorbuf(outString, inString, m_buffer, length);
+		if (!IsForwardTransformation())
+			xorbuf(checksum, outString, length);
+		checksum[length] ^= 0x80;
+	}
+}
+
+NAMESPACE_END
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef CRYPTOPP_OCB_H
+#define CRYPTOPP_OCB_H
+
+#include "authenc.h"
+#include "modes.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! .
+class CRYPTOPP_DLL CRYPTOPP_NO_VTABLE OCB_Base : public AuthenticatedSymmetricCipherBase
+{
+public:
+	OCB_Base()
+		: m_digestSize(0), m_aesniRoundKeys(NULL), m_aesniRounds(0) {}
+
+	// AuthenticatedSymmetricCipher
+	std::string AlgorithmName() const
+		{return GetBlockCipher().AlgorithmName() + std::string("/OCB");}
+	size_t MinKeyLength() const
+		{return GetBlockCipher().MinKeyLength();}
+	size_t MaxKeyLength() const
+		{return GetBlockCipher().MaxKeyLength();}
+	size_t DefaultKeyLength() const
+		{return GetBlockCipher().DefaultKeyLength();}
+	size_t GetValidKeyLength(size_t n) const
+		{return GetBlockCipher().GetValidKeyLength(n);}
+	bool IsValidKeyLength(size_t n) const
+		{return GetBlockCipher().IsValidKeyLength(n);}
+	unsigned int OptimalDataAlignment() const
+		{return GetBlockCipher().OptimalDataAlignment();}
+	IV_Requirement IVRequirement() const
+		{return UNIQUE_IV;}
+	unsigned int IVSize() const
+		{return 12;}
+	unsigned int MinIVLength() const
+		{return 1;}
+	unsigned int MaxIVLength() const
+		{return 15;}
+	unsigned int DigestSize() const
+		{return m_digestSize;}
+	lword MaxHeaderLength() const
+		{return LWORD_MAX;}
+	lword MaxMessageLength() const
+		{return LWORD_MAX;}
+	//! the message is processed in whole blocks, only the last call may pass a partial block
+	unsigned int MandatoryBlockSize() const
+		{return REQUIRED_BLOCKSIZE;}
+	unsigned int MinLastBlockSize() const
+		{return REQUIRED_BLOCKSIZE+1;}
+	bool IsSelfInverting() const
+		{return false;}
+	//! encrypts or decrypts whole blocks with offsets computed in bulk, a partial block ends the message
+	void ProcessData(byte *outString, const byte *inString, size_t length);
+	void ProcessLastBlock(byte *outString, const byte *inString, size_t length)
+		{ProcessData(outString, inString, length);}
+
+protected:
+	// AuthenticatedSymmetricCipherBase
+	bool AuthenticationIsOnPlaintext() const
+		{return true;}
+	unsigned int AuthenticationBlockSize() const
+		{return REQUIRED_BLOCKSIZE;}
+	void SetKeyWithoutResync(const byte *userKey, size_t keylength, const NameValuePairs &params);
+	void Resync(const byte *iv, size_t len);
+	size_t AuthenticateBlocks(const byte *data, size_t len);
+	void AuthenticateLastHeaderBlock();
+	void AuthenticateLastFooterBlock(byte *mac, size_t macSize);
+	//! OCB has no separate stream cipher, ProcessData() does the encryption
+	SymmetricCipher & AccessSymmetricCipher()
+		{throw NotImplemented(AlgorithmName() + ": there is no underlying stream cipher");}
+
+	//! the forward direction of the block cipher, used for the key dependent values, the nonce and the tag
+	virtual BlockCipher & AccessBlockCipher() =0;
+	//! the block cipher in the direction of the message transform
+	virtual BlockCipher & AccessDataCipher() =0;
+	virtual int DefaultDigestSize() const =0;
+
+	const BlockCipher & GetBlockCipher() const {return const_cast<OCB_Base *>(this)->AccessBlockCipher();};
+	byte *Offset() {return m_buffer+REQUIRED_BLOCKSIZE;}
+	byte *Checksum() {return m_buffer+2*REQUIRED_BLOCKSIZE;}
+	byte *HashOffset() {return m_buffer+3*REQUIRED_BLOCKSIZE;}
+	byte *HashSum() {return m_buffer+4*REQUIRED_BLOCKSIZE;}
+	byte *LStar() {return m_buffer+5*REQUIRED_BLOCKSIZE;}
+	byte *LDollar() {return m_buffer+6*REQUIRED_BLOCKSIZE;}
+	byte *NonceBlock() {return m_buffer+7*REQUIRED_BLOCKSIZE;}
+	byte *Stretch() {return m_buffer+8*REQUIRED_BLOCKSIZE;}
+	byte *LTable() {return m_buffer+10*REQUIRED_BLOCKSIZE;}
+	byte *PrefixTable() {return m_buffer+(10+L_TABLE_SIZE)*REQUIRED_BLOCKSIZE;}
+	byte *OffsetBuffer() {return m_buffer+(10+L_TABLE_SIZE+PREFIX_TABLE_SIZE)*REQUIRED_BLOCKSIZE;}
+
+	void NextOffsets(byte *offsets, byte *offset, lword &blockIndex, size_t blocks);
+	void ProcessBlocks(byte *outString, const byte *inString, size_t blocks);
+
+	//! L_i for every i that can occur as the number of trailing zeros of a 64-bit block index,
+	//! and the offset increments within a run of 16 blocks that starts at a multiple of 16
+	enum {REQUIRED_BLOCKSIZE = 16, L_TABLE_SIZE = 64, PREFIX_TABLE_SIZE = 16, OFFSET_BUFFER_BLOCKS = 64};
+	int m_digestSize;
+	lword m_headerBlocks, m_messageBlocks;
+	const byte *m_aesniRoundKeys;
+	unsigned int m_aesniRounds;
+};
+
+//! .
+template <class T_BlockCipher, int T_DefaultDigestSize, bool T_IsEncryption>
+class OCB_Final : public OCB_Base
+{
+public:
+	static std::string StaticAlgorithmName()
+		{return T_BlockCipher::StaticAlgorithmName() + std::string("/OCB");}
+	bool IsForwardTransformation() const
+		{return T_IsEncryption;}
+
+private:
+	BlockCipher & AccessBlockCipher() {return m_cipher;}
+	BlockCipher & AccessDataCipher() {return T_IsEncryption ? static_cast<BlockCipher &>(m_cipher) : static_cast<BlockCipher &>(m_decipher);}
+	int DefaultDigestSize() const {return T_DefaultDigestSize;}
+	typename T_BlockCipher::Encryption m_cipher;
+	// only keyed when decrypting
+	typename T_BlockCipher::Decryption m_decipher;
+};
+
+//! <a href="http://tools.ietf.org/html/rfc7253">OCB</a>, the offset codebook mode from RFC 7253
+template <class T_BlockCipher, int T_DefaultDigestSize = 16>
+struct OCB : public AuthenticatedSymmetricCipherDocumentation
+{
+	typedef OCB_Final<T_BlockCipher, T_DefaultDigestSize, true> Encryption;
+	typedef OCB_Final<T_BlockCipher, T_DefaultDigestSize, false> Decryption;
+};
+
+NAMESPACE_END
+
+#endif
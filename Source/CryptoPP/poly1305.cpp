@@ -0,0 +1,314 @@
+// poly1305.cpp - Poly1305 with 64-bit limbs and a four block AVX2 path
+
+#include "pch.h"
+#include "poly1305.h"
+#include "misc.h"
+#include "cpu.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+// The scalar code keeps the accumulator in three limbs of 44, 44 and 42 bits, so the products
+// of a multiplication modulo 2^130-5 are sums of three 64x64->128 bit multiplications.
+#if defined(CRYPTOPP_WORD128_AVAILABLE)
+	#define DeclareProduct(a)			word128 a
+	#define Multiply(a, x, y)			a = word128(x) * (y)
+	#define MultiplyAdd(a, x, y)		a += word128(x) * (y)
+	#define AddWord(a, w)				a += (w)
+	#define ShiftRight(a, n)			word64((a) >> (n))
+	#define LowWord(a)					word64(a)
+#else
+static inline word64 Poly1305_MultiplyWords(word64 x, word64 y, word64 &hi)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(x, y, &hi);
+#else
+	const word64 ll = word64(word32(x)) * word32(y), lh = word64(word32(x)) * word32(y >> 32);
+	const word64 hl = word64(word32(x >> 32)) * word32(y), hh = word64(word32(x >> 32)) * word32(y >> 32);
+	const word64 mid = (ll >> 32) + word32(lh) + word32(hl);
+	hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	return (mid << 32) | word32(ll);
+#endif
+}
+
+	#define DeclareProduct(a)			word64 a##Lo, a##Hi
+	#define Multiply(a, x, y)			a##Lo = Poly1305_MultiplyWords(x, y, a##Hi)
+	#define MultiplyAdd(a, x, y)		{word64 hi_, lo_ = Poly1305_MultiplyWords(x, y, hi_); a##Lo += lo_; a##Hi += hi_ + (a##Lo < lo_);}
+	#define AddWord(a, w)				{a##Lo += (w); a##Hi += (a##Lo < (w));}
+	#define ShiftRight(a, n)			((a##Lo >> (n)) | (a##Hi << (64-(n))))
+	#define LowWord(a)					a##Lo
+#endif
+
+static const word64 M44 = W64LIT(0xfffffffffff), M42 = W64LIT(0x3ffffffffff), M26 = 0x3ffffff;
+
+// h = h*r mod 2^130-5, partially reduced, the limbs of h may exceed their width by a few bits
+static inline void Poly1305_MultiplyAndReduce(word64 &h0, word64 &h1, word64 &h2, word64 r0, word64 r1, word64 r2, word64 s1, word64 s2)
+{
+	DeclareProduct(d0);
+	DeclareProduct(d1);
+	DeclareProduct(d2);
+
+	Multiply(d0, h0, r0); MultiplyAdd(d0, h1, s2); MultiplyAdd(d0, h2, s1);
+	Multiply(d1, h0, r1); MultiplyAdd(d1, h1, r0); MultiplyAdd(d1, h2, s2);
+	Multiply(d2, h0, r2); MultiplyAdd(d2, h1, r1); MultiplyAdd(d2, h2, r0);
+
+	word64 c = ShiftRight(d0, 44);
+	h0 = LowWord(d0) & M44;
+	AddWord(d1, c);
+	c = ShiftRight(d1, 44);
+	h1 = LowWord(d1) & M44;
+	AddWord(d2, c);
+	c = ShiftRight(d2, 42);
+	h2 = LowWord(d2) & M42;
+	h0 += c * 5;
+	c = h0 >> 44;
+	h0 &= M44;
+	h1 += c;
+}
+
+// brings every limb back to its width, the value stays below 2^130
+static inline void Poly1305_Carry(word64 &h0, word64 &h1, word64 &h2)
+{
+	word64 c;
+	c = h0 >> 44; h0 &= M44; h1 += c;
+	c = h1 >> 44; h1 &= M44; h2 += c;
+	c = h2 >> 42; h2 &= M42; h0 += c * 5;
+	c = h0 >> 44; h0 &= M44; h1 += c;
+	c = h1 >> 44; h1 &= M44; h2 += c;
+}
+
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+// Lane i of every register holds one of four interleaved accumulators in five 26-bit limbs,
+// _mm256_mul_epu32 multiplies the low words of the lanes into 64-bit products. Every step
+// multiplies all four accumulators by r^4 and adds the next four blocks, the last step
+// multiplies lane i by r^(4-i) instead and the lanes are summed into the scalar accumulator.
+
+// d = h*r mod 2^130-5 lane by lane, s holds 5*r
+static inline void Poly1305_MultiplyAVX2(__m256i *h, const __m256i *r, const __m256i *s)
+{
+	__m256i d0, d1, d2, d3, d4, c;
+	const __m256i mask = _mm256_set1_epi64x(M26);
+
+	d0 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[0]), _mm256_mul_epu32(h[1], s[4])), _mm256_mul_epu32(h[2], s[3])), _mm256_mul_epu32(h[3], s[2])), _mm256_mul_epu32(h[4], s[1]));
+	d1 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[1]), _mm256_mul_epu32(h[1], r[0])), _mm256_mul_epu32(h[2], s[4])), _mm256_mul_epu32(h[3], s[3])), _mm256_mul_epu32(h[4], s[2]));
+	d2 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[2]), _mm256_mul_epu32(h[1], r[1])), _mm256_mul_epu32(h[2], r[0])), _mm256_mul_epu32(h[3], s[4])), _mm256_mul_epu32(h[4], s[3]));
+	d3 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[3]), _mm256_mul_epu32(h[1], r[2])), _mm256_mul_epu32(h[2], r[1])), _mm256_mul_epu32(h[3], r[0])), _mm256_mul_epu32(h[4], s[4]));
+	d4 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[4]), _mm256_mul_epu32(h[1], r[3])), _mm256_mul_epu32(h[2], r[2])), _mm256_mul_epu32(h[3], r[1])), _mm256_mul_epu32(h[4], r[0]));
+
+	c = _mm256_srli_epi64(d0, 26); d0 = _mm256_and_si256(d0, mask); d1 = _mm256_add_epi64(d1, c);
+	c = _mm256_srli_epi64(d1, 26); d1 = _mm256_and_si256(d1, mask); d2 = _mm256_add_epi64(d2, c);
+	c = _mm256_srli_epi64(d2, 26); d2 = _mm256_and_si256(d2, mask); d3 = _mm256_add_epi64(d3, c);
+	c = _mm256_srli_epi64(d3, 26); d3 = _mm256_and_si256(d3, mask); d4 = _mm256_add_epi64(d4, c);
+	c = _mm256_srli_epi64(d4, 26); d4 = _mm256_and_si256(d4, mask); d0 = _mm256_add_epi64(d0, _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+	c = _mm256_srli_epi64(d0, 26); d0 = _mm256_and_si256(d0, mask); d1 = _mm256_add_epi64(d1, c);
+
+	h[0] = d0; h[1] = d1; h[2] = d2; h[3] = d3; h[4] = d4;
+}
+
+// adds blocks i of the four at input to lane i of h, whole blocks only
+static inline void Poly1305_AddBlocksAVX2(__m256i *h, const byte *input)
+{
+	const __m256i mask = _mm256_set1_epi64x(M26);
+	const __m256i a = _mm256_loadu_si256((const __m256i *)input);
+	const __m256i b = _mm256_loadu_si256((const __m256i *)(input + 32));
+	const __m256i lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3,1,2,0));
+	const __m256i hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), _MM_SHUFFLE(3,1,2,0));
+
+	h[0] = _mm256_add_epi64(h[0], _mm256_and_si256(lo, mask));
+	h[1] = _mm256_add_epi64(h[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask));
+	h[2] = _mm256_add_epi64(h[2], _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), mask));
+	h[3] = _mm256_add_epi64(h[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask));
+	h[4] = _mm256_add_epi64(h[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), _mm256_set1_epi64x(1 << 24)));
+}
+
+// absorbs Groups times four whole blocks into the radix 2^44 accumulator h
+static void Poly1305_ProcessBlocksAVX2(word64 *h, const word32 *powers, const byte *input, size_t Groups)
+{
+	__m256i acc[5], r4[5], s4[5], r[5], s[5];
+	word64 h0 = h[0], h1 = h[1], h2 = h[2];
+	Poly1305_Carry(h0, h1, h2);
+
+	for( int j = 0; j < 5; ++j )
+	{
+	  r4[j] = _mm256_set1_epi64x( powers[4*j] );
+	  s4[j] = _mm256_add_epi64( r4[j], _mm256_slli_epi64( r4[j], 2 ) );
+	  r[j] = _mm256_cvtepu32_epi64( _mm_load_si128( (const __m128i *)(powers + 4*j) ) );
+	  s[j] = _mm256_add_epi64( r[j], _mm256_slli_epi64( r[j], 2 ) );
+	}
+
+	acc[0] = _mm256_setr_epi64x( h0 & M26, 0, 0, 0 );
+	acc[1] = _mm256_setr_epi64x( ( (h0 >> 26) | (h1 << 18) ) & M26, 0, 0, 0 );
+	acc[2] = _mm256_setr_epi64x( (h1 >> 8) & M26, 0, 0, 0 );
+	acc[3] = _mm256_setr_epi64x( ( (h1 >> 34) | (h2 << 10) ) & M26, 0, 0, 0 );
+	acc[4] = _mm256_setr_epi64x( h2 >> 16, 0, 0, 0 );
+	Poly1305_AddBlocksAVX2( acc, input );
+
+	for( --Groups, input += 64; Groups; --Groups, input += 64 )
+	{
+	  Poly1305_MultiplyAVX2( acc, r4, s4 );
+	  Poly1305_AddBlocksAVX2( acc, input );
+	}
+	Poly1305_MultiplyAVX2( acc, r, s );
+
+	word64 l[5];
+	CRYPTOPP_ALIGN_DATA(16) word64 t[2];
+	for( int j = 0; j < 5; ++j )
+	{
+	  _mm_store_si128( (__m128i *)t, _mm_add_epi64( _mm256_castsi256_si128( acc[j] ), _mm256_extracti128_si256( acc[j], 1 ) ) );
+	  l[j] = t[0] + t[1];
+	}
+	_mm256_zeroupper();
+
+	// the lane sums are a few bits wider than 26 bits, the shifts below can't lose them
+	h0 = l[0] + ( (l[1] & 0x3ffff) << 26 );
+	h1 = (l[1] >> 18) + (l[2] << 8) + ( (l[3] & 0x3ff) << 34 );
+	h2 = (l[3] >> 10) + (l[4] << 16);
+	Poly1305_Carry(h0, h1, h2);
+	h[0] = h0; h[1] = h1; h[2] = h2;
+}
+#endif // CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+
+void Poly1305_Base::UncheckedSetKey(const byte *key, unsigned int length, const NameValuePairs &params)
+{
+	assert(length == 32);
+
+	// r is clamped as the standard requires
+	const word64 t0 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, key);
+	const word64 t1 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, key + 8);
+	m_r[0] = t0 & W64LIT(0xffc0fffffff);
+	m_r[1] = ((t0 >> 44) | (t1 << 20)) & W64LIT(0xfffffc0ffff);
+	m_r[2] = (t1 >> 24) & W64LIT(0x00ffffffc0f);
+	m_pad[0] = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, key + 16);
+	m_pad[1] = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, key + 24);
+
+	// r, r^2, r^3 and r^4 for the lanes of the AVX2 path
+	const word64 s1 = m_r[1] * (5 << 2), s2 = m_r[2] * (5 << 2);
+	word64 p0 = m_r[0], p1 = m_r[1], p2 = m_r[2];
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		if (i > 0)
+			Poly1305_MultiplyAndReduce(p0, p1, p2, m_r[0], m_r[1], m_r[2], s1, s2);
+		Poly1305_Carry(p0, p1, p2);
+		m_powers[4*0 + 3-i] = word32(p0 & M26);
+		m_powers[4*1 + 3-i] = word32(((p0 >> 26) | (p1 << 18)) & M26);
+		m_powers[4*2 + 3-i] = word32((p1 >> 8) & M26);
+		m_powers[4*3 + 3-i] = word32(((p1 >> 34) | (p2 << 10)) & M26);
+		m_powers[4*4 + 3-i] = word32(p2 >> 16);
+	}
+
+	Restart();
+}
+
+void Poly1305_Base::Restart()
+{
+	m_h[0] = m_h[1] = m_h[2] = 0;
+	m_bufferedLength = 0;
+}
+
+void Poly1305_Base::ProcessBlocks(const byte *input, size_t blocks, word64 hibit)
+{
+#if CRYPTOPP_BOOL_AVX2_INTRINSICS_AVAILABLE
+	// two groups at least, so the conversions between the radixes pay off
+	if (blocks >= 8 && hibit && HasAVX2())
+	{
+		Poly1305_ProcessBlocksAVX2(m_h, m_powers, input, blocks / 4);
+		input += (blocks & ~size_t(3)) * BLOCKSIZE;
+		blocks &= 3;
+	}
+#endif
+
+	const word64 r0 = m_r[0], r1 = m_r[1], r2 = m_r[2];
+	const word64 s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+	word64 h0 = m_h[0], h1 = m_h[1], h2 = m_h[2];
+
+	for (; blocks; blocks--, input += BLOCKSIZE)
+	{
+		const word64 t0 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, input);
+		const word64 t1 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, input + 8);
+
+		h0 += t0 & M44;
+		h1 += ((t0 >> 44) | (t1 << 20)) & M44;
+		h2 += ((t1 >> 24) & M42) | hibit;
+
+		Poly1305_MultiplyAndReduce(h0, h1, h2, r0, r1, r2, s1, s2);
+	}
+
+	m_h[0] = h0; m_h[1] = h1; m_h[2] = h2;
+}
+
+void Poly1305_Base::Update(const byte *input, size_t length)
+{
+	const word64 hibit = W64LIT(1) << 40;
+
+	if (m_bufferedLength)
+	{
+		const size_t n = STDMIN(length, size_t(BLOCKSIZE - m_bufferedLength));
+		memcpy(m_data + m_bufferedLength, input, n);
+		m_bufferedLength += (unsigned int)n;
+		input += n;
+		length -= n;
+		if (m_bufferedLength < BLOCKSIZE)
+			return;
+		ProcessBlocks(m_data, 1, hibit);
+		m_bufferedLength = 0;
+	}
+
+	if (length >= BLOCKSIZE)
+	{
+		const size_t blocks = length / BLOCKSIZE;
+		ProcessBlocks(input, blocks, hibit);
+		input += blocks * BLOCKSIZE;
+		length -= blocks * BLOCKSIZE;
+	}
+
+	memcpy(m_data, input, length);
+	m_bufferedLength = (unsigned int)length;
+}
+
+void Poly1305_Base::TruncatedFinal(byte *mac, size_t size)
+{
+	ThrowIfInvalidTruncatedSize(size);
+
+	if (m_bufferedLength)
+	{
+		m_data[m_bufferedLength] = 1;
+		memset(m_data + m_bufferedLength + 1, 0, BLOCKSIZE - m_bufferedLength - 1);
+		ProcessBlocks(m_data, 1, 0);
+	}
+
+	word64 h0 = m_h[0], h1 = m_h[1], h2 = m_h[2];
+	Poly1305_Carry(h0, h1, h2);
+	word64 c = h2 >> 42;
+	h2 &= M42;
+	h0 += c * 5;
+	c = h0 >> 44; h0 &= M44; h1 += c;
+	c = h1 >> 44; h1 &= M44; h2 += c;
+
+	// h-p, taken if it doesn't borrow
+	word64 g0 = h0 + 5;
+	c = g0 >> 44; g0 &= M44;
+	word64 g1 = h1 + c;
+	c = g1 >> 44; g1 &= M44;
+	word64 g2 = h2 + c - (W64LIT(1) << 42);
+
+	const word64 mask = (g2 >> 63) - 1;
+	h0 = (h0 & ~mask) | (g0 & mask);
+	h1 = (h1 & ~mask) | (g1 & mask);
+	h2 = (h2 & ~mask) | (g2 & mask);
+
+	// h+s mod 2^128
+	const word64 t0 = m_pad[0], t1 = m_pad[1];
+	h0 += t0 & M44;
+	c = h0 >> 44; h0 &= M44;
+	h1 += (((t0 >> 44) | (t1 << 20)) & M44) + c;
+	c = h1 >> 44; h1 &= M44;
+	h2 += ((t1 >> 24) & M42) + c;
+
+	byte tag[DIGESTSIZE];
+	PutWord(false, LITTLE_ENDIAN_ORDER, tag, h0 | (h1 << 44));
+	PutWord(false, LITTLE_ENDIAN_ORDER, tag + 8, (h1 >> 20) | (h2 << 24));
+	memcpy(mac, tag, size);
+
+	Restart();
+}
+
+NAMESPACE_END
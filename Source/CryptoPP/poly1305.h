@@ -0,0 +1,50 @@
+#ifndef CRYPTOPP_POLY1305_H
+#define CRYPTOPP_POLY1305_H
+
+#include "seckey.h"
+#include "secblock.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! _
+class CRYPTOPP_NO_VTABLE Poly1305_Base : public MessageAuthenticationCode
+{
+public:
+	Poly1305_Base() : m_bufferedLength(0) {}
+
+	void UncheckedSetKey(const byte *key, unsigned int length, const NameValuePairs &params);
+	void Update(const byte *input, size_t length);
+	void TruncatedFinal(byte *mac, size_t size);
+	void Restart();
+	unsigned int DigestSize() const {return DIGESTSIZE;}
+	unsigned int OptimalBlockSize() const {return BLOCKSIZE;}
+
+	enum {BLOCKSIZE = 16, DIGESTSIZE = 16};
+
+protected:
+	//! hibit is 2^128 in the top limb for whole blocks and 0 for the padded last block
+	void ProcessBlocks(const byte *input, size_t blocks, word64 hibit);
+
+	//! the accumulator and r in radix 2^44
+	FixedSizeSecBlock<word64, 3> m_h, m_r;
+	FixedSizeSecBlock<word64, 2> m_pad;
+	//! limb j of r^(4-i) in radix 2^26 at 4*j+i, for the four block AVX2 path
+	FixedSizeAlignedSecBlock<word32, 20> m_powers;
+	FixedSizeSecBlock<byte, BLOCKSIZE> m_data;
+	unsigned int m_bufferedLength;
+};
+
+/// <a href="http://tools.ietf.org/html/rfc7539">Poly1305</a>, the 32 byte key is r followed by s and authenticates one message only
+class Poly1305 : public MessageAuthenticationCodeImpl<Poly1305_Base, Poly1305>, public FixedKeyLength<32>
+{
+public:
+	Poly1305() {}
+	Poly1305(const byte *key, size_t length=FixedKeyLength<32>::DEFAULT_KEYLENGTH)
+		{this->SetKey(key, length);}
+
+	static std::string StaticAlgorithmName() {return "Poly1305";}
+};
+
+NAMESPACE_END
+
+#endif
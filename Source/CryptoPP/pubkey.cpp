@@ -117,6 +117,67 @@ bool TF_VerifierBase::VerifyAndRestart(PK_MessageAccumulator &messageAccumulator
 	return result;
 }
 
+class TF_VerifierBase::BatchSlices : public ParallelLoopBody
+{
+public:
+	BatchSlices(const TF_VerifierBase &verifier, const SignedMessage *items, size_t count, unsigned int slices, byte *valid)
+		: m_verifier(verifier), m_items(items), m_count(count), m_slices(slices), m_valid(valid) {}
+
+	void operator()(unsigned int index)
+	{
+		const size_t begin = m_count*index/m_slices, end = m_count*(index+1)/m_slices;
+		m_verifier.VerifyBatchSlice(m_items+begin, end-begin, m_valid+begin);
+	}
+
+private:
+	const TF_VerifierBase &m_verifier;
+	const SignedMessage *m_items;
+	size_t m_count;
+	unsigned int m_slices;
+	byte *m_valid;
+};
+
+std::vector<bool> TF_VerifierBase::VerifyBatch(const SignedMessage *items, size_t count, bool parallel) const
+{
+	std::vector<byte> valid(count);
+	unsigned int slices = 1;
+	if (parallel)
+		slices = (unsigned int)STDMIN<size_t>(count, ThreadPool::GetGlobalPool().GetNumberThreads());
+	BatchSlices body(*this, items, count, slices, valid.empty() ? NULL : &valid[0]);
+	ThreadPool::GetGlobalPool().ParallelFor(slices, body);
+	return std::vector<bool>(valid.begin(), valid.end());
+}
+
+void TF_VerifierBase::VerifyBatchSlice(const SignedMessage *items, size_t count, byte *valid) const
+{
+	std::auto_ptr<PK_MessageAccumulator> accumulator(NewVerificationAccumulator());
+	PK_MessageAccumulatorBase &ma = static_cast<PK_MessageAccumulatorBase &>(*accumulator);
+	HashIdentifier id = GetHashIdentifier();
+	const MessageEncodingInterface &encoding = GetMessageEncodingInterface();
+
+	if (MessageRepresentativeBitLength() < encoding.MinRepresentativeBitLength(id.second, ma.AccessHash().DigestSize()))
+		throw PK_SignatureScheme::KeyTooShort();
+
+	// the trapdoor function sets up its per-key state once for the whole slice
+	std::vector<Integer> x(count), y(count);
+	for (size_t i=0; i<count; i++)
+		x[i].Decode(items[i].signature, items[i].signatureLength);
+	if (count)
+		GetTrapdoorFunctionInterface().ApplyFunctionBatch(&x[0], &y[0], count);
+
+	for (size_t i=0; i<count; i++)
+	{
+		// same as InputSignature()
+		ma.m_representative.New(MessageRepresentativeLength());
+		if (y[i].BitCount() > MessageRepresentativeBitLength())
+			y[i] = Integer::Zero();
+		y[i].Encode(ma.m_representative, ma.m_representative.size());
+
+		ma.Update(items[i].message, items[i].messageLength);
+		valid[i] = VerifyAndRestart(ma);
+	}
+}
+
 DecodingResult TF_VerifierBase::RecoverAndRestart(byte *recoveredMessage, PK_MessageAccumulator &messageAccumulator) const
 {
 	PK_MessageAccumulatorBase &ma = static_cast<PK_MessageAccumulatorBase &>(messageAccumulator);
@@ -37,6 +37,7 @@
 #include "eprecomp.h"
 #include "fips140.h"
 #include "argnames.h"
+#include "threadpool.h"
 #include <memory>
 
 // VC60 workaround: this macro is defined in shlobj.h and conflicts with a template parameter used in this file
@@ -73,6 +74,9 @@ public:
 	bool IsRandomized() const {return false;}
 
 	virtual Integer ApplyFunction(const Integer &x) const =0;
+	//! y[i] = ApplyFunction(x[i]) for count inputs, implementations may set up per-key state once for all of them
+	virtual void ApplyFunctionBatch(const Integer *x, Integer *y, size_t count) const
+		{for (size_t i=0; i<count; i++) y[i] = ApplyFunction(x[i]);}
 };
 
 //! _
@@ -346,6 +350,11 @@ public:
 	void InputSignature(PK_MessageAccumulator &messageAccumulator, const byte *signature, size_t signatureLength) const;
 	bool VerifyAndRestart(PK_MessageAccumulator &messageAccumulator) const;
 	DecodingResult RecoverAndRestart(byte *recoveredMessage, PK_MessageAccumulator &recoveryAccumulator) const;
+	std::vector<bool> VerifyBatch(const SignedMessage *items, size_t count, bool parallel=false) const;
+
+private:
+	class BatchSlices;
+	void VerifyBatchSlice(const SignedMessage *items, size_t count, byte *valid) const;
 };
 
 // ********************************************************
@@ -665,6 +674,8 @@ public:
 		const DL_GroupParameters<T> &params = this->GetAbstractGroupParameters();
 		return params.GetBasePrecomputation().CascadeExponentiate(params.GetGroupPrecomputation(), baseExp, GetPublicPrecomputation(), publicExp);
 	}
+	//! returns whether CascadeExponentiateBaseAndPublicElement() gets faster after Precompute()
+	virtual bool UsesPrecomputation() const {return true;}
 
 	virtual const DL_FixedBasePrecomputation<T> & GetPublicPrecomputation() const =0;
 	virtual DL_FixedBasePrecomputation<T> & AccessPublicPrecomputation() =0;
@@ -1089,9 +1100,18 @@ public:
 		const DL_ElgamalLikeSignatureAlgorithm<T> &alg = this->GetSignatureAlgorithm();
 		const DL_GroupParameters<T> &params = this->GetAbstractGroupParameters();
 
-		size_t rLen = alg.RLen(params);
-		ma.m_semisignature.Assign(signature, rLen);
-		ma.m_s.Decode(signature+rLen, alg.SLen(params));
+		size_t rLen = alg.RLen(params), sLen = alg.SLen(params);
+		if (signatureLength >= rLen+sLen)
+		{
+			ma.m_semisignature.Assign(signature, rLen);
+			ma.m_s.Decode(signature+rLen, sLen);
+		}
+		else
+		{
+			// a short signature isn't read, r = s = 0 fails the range checks of Verify()
+			ma.m_semisignature.CleanNew(rLen);
+			ma.m_s = Integer::Zero();
+		}
 
 		this->GetMessageEncodingInterface().ProcessSemisignature(ma.AccessHash(), ma.m_semisignature, ma.m_semisignature.size());
 	}
@@ -1099,21 +1119,22 @@ public:
 	bool VerifyAndRestart(PK_MessageAccumulator &messageAccumulator) const
 	{
 		this->GetMaterial().DoQuickSanityCheck();
+		return VerifyAndRestart(static_cast<PK_MessageAccumulatorBase &>(messageAccumulator), this->GetKeyInterface());
+	}
 
-		PK_MessageAccumulatorBase &ma = static_cast<PK_MessageAccumulatorBase &>(messageAccumulator);
-		const DL_ElgamalLikeSignatureAlgorithm<T> &alg = this->GetSignatureAlgorithm();
-		const DL_GroupParameters<T> &params = this->GetAbstractGroupParameters();
-		const DL_PublicKey<T> &key = this->GetKeyInterface();
-
-		SecByteBlock representative(this->MessageRepresentativeLength());
-		this->GetMessageEncodingInterface().ComputeMessageRepresentative(NullRNG(), ma.m_recoverableMessage, ma.m_recoverableMessage.size(), 
-			ma.AccessHash(), this->GetHashIdentifier(), ma.m_empty,
-			representative, this->MessageRepresentativeBitLength());
-		ma.m_empty = true;
-		Integer e(representative, representative.size());
+	//! items are split into one slice per worker thread, and every slice verifies with its own
+	//! copy of the key, holding precomputed tables for the base and the public element
+	std::vector<bool> VerifyBatch(const PK_Verifier::SignedMessage *items, size_t count, bool parallel=false) const
+	{
+		this->GetMaterial().DoQuickSanityCheck();
 
-		Integer r(ma.m_semisignature, ma.m_semisignature.size());
-		return alg.Verify(params, key, e, r, ma.m_s);
+		std::vector<byte> valid(count);
+		unsigned int slices = 1;
+		if (parallel)
+			slices = (unsigned int)STDMIN<size_t>(count, ThreadPool::GetGlobalPool().GetNumberThreads());
+		BatchSlices body(*this, items, count, slices, valid.empty() ? NULL : &valid[0]);
+		ThreadPool::GetGlobalPool().ParallelFor(slices, body);
+		return std::vector<bool>(valid.begin(), valid.end());
 	}
 
 	DecodingResult RecoverAndRestart(byte *recoveredMessage, PK_MessageAccumulator &messageAccumulator) const
@@ -1144,6 +1165,64 @@ public:
 			ma.m_semisignature, ma.m_semisignature.size(),
 			recoveredMessage);
 	}
+
+protected:
+	//! returns a copy of the key for use by one batch slice, with precomputation if the key uses it
+	virtual DL_PublicKey<T> * NewBatchKey() const =0;
+
+	bool VerifyAndRestart(PK_MessageAccumulatorBase &ma, const DL_PublicKey<T> &key) const
+	{
+		const DL_ElgamalLikeSignatureAlgorithm<T> &alg = this->GetSignatureAlgorithm();
+		const DL_GroupParameters<T> &params = key.GetAbstractGroupParameters();
+
+		SecByteBlock representative(this->MessageRepresentativeLength());
+		this->GetMessageEncodingInterface().ComputeMessageRepresentative(NullRNG(), ma.m_recoverableMessage, ma.m_recoverableMessage.size(), 
+			ma.AccessHash(), this->GetHashIdentifier(), ma.m_empty,
+			representative, this->MessageRepresentativeBitLength());
+		ma.m_empty = true;
+		Integer e(representative, representative.size());
+
+		Integer r(ma.m_semisignature, ma.m_semisignature.size());
+		return alg.Verify(params, key, e, r, ma.m_s);
+	}
+
+	void VerifyBatchSlice(const PK_Verifier::SignedMessage *items, size_t count, byte *valid, bool concurrent) const
+	{
+		// the precomputation pays for itself within a single verification, and a
+		// concurrent slice must not share the mutable group objects of this key
+		std::auto_ptr<DL_PublicKey<T> > batchKey(count > 1 || concurrent ? NewBatchKey() : NULL);
+		const DL_PublicKey<T> &key = batchKey.get() ? *batchKey : this->GetKeyInterface();
+		std::auto_ptr<PK_MessageAccumulator> accumulator(this->NewVerificationAccumulator());
+		PK_MessageAccumulatorBase &ma = static_cast<PK_MessageAccumulatorBase &>(*accumulator);
+
+		for (size_t i=0; i<count; i++)
+		{
+			this->InputSignature(ma, items[i].signature, items[i].signatureLength);
+			ma.Update(items[i].message, items[i].messageLength);
+			valid[i] = VerifyAndRestart(ma, key);
+		}
+	}
+
+private:
+	class BatchSlices : public ParallelLoopBody
+	{
+	public:
+		BatchSlices(const DL_VerifierBase<T> &verifier, const PK_Verifier::SignedMessage *items, size_t count, unsigned int slices, byte *valid)
+			: m_verifier(verifier), m_items(items), m_count(count), m_slices(slices), m_valid(valid) {}
+
+		void operator()(unsigned int index)
+		{
+			const size_t begin = m_count*index/m_slices, end = m_count*(index+1)/m_slices;
+			m_verifier.VerifyBatchSlice(m_items+begin, end-begin, m_valid+begin, m_slices > 1);
+		}
+
+	private:
+		const DL_VerifierBase<T> &m_verifier;
+		const PK_Verifier::SignedMessage *m_items;
+		size_t m_count;
+		unsigned int m_slices;
+		byte *m_valid;
+	};
 };
 
 //! _
@@ -1355,6 +1434,15 @@ public:
 	{
 		return new PK_MessageAccumulatorImpl<CPP_TYPENAME SCHEME_OPTIONS::HashFunction>;
 	}
+
+protected:
+	DL_PublicKey<typename SCHEME_OPTIONS::Element> * NewBatchKey() const
+	{
+		std::auto_ptr<typename SCHEME_OPTIONS::PublicKey> key(new typename SCHEME_OPTIONS::PublicKey(this->GetKey()));
+		if (key->UsesPrecomputation())
+			key->Precompute();
+		return key.release();
+	}
 };
 
 //! _
@@ -92,7 +92,7 @@ public:
 	word64 GetMCostFromPeakNumberBytes(size_t PeakNumberBytes) const {throw(InvalidArgument("mCost is not supported for this function"));}
 	word64 SearchMCost(word64 tCost,double TimeInSeconds,size_t TestDataSetSize=128) const {throw(InvalidArgument("mCost is not supported for this function"));}
 	void DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 tCost, word64 mCost) const
-	{ThrowIfInvalidTCost(tCost);(derived,derivedLen,password,passwordLen,salt,saltLen,tCost);}
+	{ThrowIfInvalidTCost(tCost);DeriveKey(derived,derivedLen,password,passwordLen,salt,saltLen,(unsigned int)tCost);}
 	unsigned int DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, unsigned int iterations, double timeInSeconds=0) const;
 	word64 SearchTCost(word64 mCost,double TimeInSeconds,size_t TestDataSetSize=128) const
 	{
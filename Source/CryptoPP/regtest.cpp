@@ -20,6 +20,8 @@
 #include "pssr.h"
 #include "aes.h"
 #include "salsa.h"
+#include "chacha.h"
+#include "chachapoly.h"
 #include "vmac.h"
 #include "tiger.h"
 #include "md5.h"
@@ -28,6 +30,7 @@
 #include "ccm.h"
 #include "gcm.h"
 #include "eax.h"
+#include "ocb.h"
 #include "twofish.h"
 #include "serpent.h"
 #include "cast.h"
@@ -47,6 +50,8 @@
 #include "crc.h"
 #include "adler32.h"
 #include "sha3.h"
+#include "skein.h"
+#include "Threefish.h"
 
 USING_NAMESPACE(CryptoPP)
 
@@ -77,6 +82,10 @@ void RegisterFactories()
 	RegisterDefaultFactoryFor<HashTransformation, SHA3_256>();
 	RegisterDefaultFactoryFor<HashTransformation, SHA3_384>();
 	RegisterDefaultFactoryFor<HashTransformation, SHA3_512>();
+	RegisterDefaultFactoryFor<HashTransformation, Skein_224>();
+	RegisterDefaultFactoryFor<HashTransformation, Skein_256>();
+	RegisterDefaultFactoryFor<HashTransformation, Skein_384>();
+	RegisterDefaultFactoryFor<HashTransformation, Skein_512>();
 	RegisterDefaultFactoryFor<MessageAuthenticationCode, HMAC<Weak::MD5> >();
 	RegisterDefaultFactoryFor<MessageAuthenticationCode, HMAC<SHA1> >();
 	RegisterDefaultFactoryFor<MessageAuthenticationCode, HMAC<RIPEMD160> >();
@@ -92,6 +101,7 @@ void RegisterFactories()
 	RegisterDefaultFactoryFor<MessageAuthenticationCode, CMAC<AES> >();
 	RegisterDefaultFactoryFor<MessageAuthenticationCode, DMAC<AES> >();
 	RegisterDefaultFactoryFor<MessageAuthenticationCode, CMAC<DES_EDE3> >();
+	RegisterDefaultFactoryFor<MessageAuthenticationCode, Poly1305>();
 	RegisterAsymmetricCipherDefaultFactories<RSAES<OAEP<SHA1> > >("RSA/OAEP-MGF1(SHA-1)");
 	RegisterAsymmetricCipherDefaultFactories<DLIES<> >("DLIES(NoCofactorMultiplication, KDF2(SHA-1), XOR, HMAC(SHA-1), DHAES)");
 	RegisterSignatureSchemeDefaultFactories<DSA>();
@@ -118,8 +128,11 @@ void RegisterFactories()
 	RegisterSymmetricCipherDefaultFactories<CFB_Mode<AES> >();
 	RegisterSymmetricCipherDefaultFactories<OFB_Mode<AES> >();
 	RegisterSymmetricCipherDefaultFactories<CTR_Mode<AES> >();
+	RegisterSymmetricCipherDefaultFactories<XTS_Mode<AES> >();
 	RegisterSymmetricCipherDefaultFactories<Salsa20>();
 	RegisterSymmetricCipherDefaultFactories<XSalsa20>();
+	RegisterSymmetricCipherDefaultFactories<ChaCha20>();
+	RegisterSymmetricCipherDefaultFactories<ChaCha20IETF>();
 	RegisterSymmetricCipherDefaultFactories<Sosemanuk>();
 	RegisterSymmetricCipherDefaultFactories<Weak::MARC4>();
 	RegisterSymmetricCipherDefaultFactories<WAKE_OFB<LittleEndian> >();
@@ -128,6 +141,8 @@ void RegisterFactories()
 	RegisterAuthenticatedSymmetricCipherDefaultFactories<CCM<AES> >();
 	RegisterAuthenticatedSymmetricCipherDefaultFactories<GCM<AES> >();
 	RegisterAuthenticatedSymmetricCipherDefaultFactories<EAX<AES> >();
+	RegisterAuthenticatedSymmetricCipherDefaultFactories<OCB<AES> >();
+	RegisterAuthenticatedSymmetricCipherDefaultFactories<ChaCha20Poly1305>();
 	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Camellia> >();
 	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Twofish> >();
 	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Serpent> >();
@@ -148,6 +163,9 @@ void RegisterFactories()
 	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Blowfish> >();
 	RegisterSymmetricCipherDefaultFactories<ECB_Mode<SEED> >();
 	RegisterSymmetricCipherDefaultFactories<CTR_Mode<SEED> >();
+	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Threefish_256> >();
+	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Threefish_512> >();
+	RegisterSymmetricCipherDefaultFactories<CTR_Mode<Threefish_1024> >();
 
 	s_registered = true;
 }
@@ -1065,10 +1065,239 @@ inline void AESNI_Dec_4_Blocks(__m128i &block0, __m128i &block1, __m128i &block2
 	block3 = _mm_aesdeclast_si128(block3, rk);
 }
 
+inline void AESNI_Enc_8_Blocks(__m128i &block0, __m128i &block1, __m128i &block2, __m128i &block3, __m128i &block4, __m128i &block5, __m128i &block6, __m128i &block7, const __m128i *subkeys, unsigned int rounds)
+{
+	// work on copies, the compiler has to assume the references alias and would keep them in memory
+	__m128i b0 = block0, b1 = block1, b2 = block2, b3 = block3, b4 = block4, b5 = block5, b6 = block6, b7 = block7;
+	__m128i rk = subkeys[0];
+	b0 = _mm_xor_si128(b0, rk);
+	b1 = _mm_xor_si128(b1, rk);
+	b2 = _mm_xor_si128(b2, rk);
+	b3 = _mm_xor_si128(b3, rk);
+	b4 = _mm_xor_si128(b4, rk);
+	b5 = _mm_xor_si128(b5, rk);
+	b6 = _mm_xor_si128(b6, rk);
+	b7 = _mm_xor_si128(b7, rk);
+	for (unsigned int i=1; i<rounds; i++)
+	{
+		rk = subkeys[i];
+		b0 = _mm_aesenc_si128(b0, rk);
+		b1 = _mm_aesenc_si128(b1, rk);
+		b2 = _mm_aesenc_si128(b2, rk);
+		b3 = _mm_aesenc_si128(b3, rk);
+		b4 = _mm_aesenc_si128(b4, rk);
+		b5 = _mm_aesenc_si128(b5, rk);
+		b6 = _mm_aesenc_si128(b6, rk);
+		b7 = _mm_aesenc_si128(b7, rk);
+	}
+	rk = subkeys[rounds];
+	b0 = _mm_aesenclast_si128(b0, rk);
+	b1 = _mm_aesenclast_si128(b1, rk);
+	b2 = _mm_aesenclast_si128(b2, rk);
+	b3 = _mm_aesenclast_si128(b3, rk);
+	b4 = _mm_aesenclast_si128(b4, rk);
+	b5 = _mm_aesenclast_si128(b5, rk);
+	b6 = _mm_aesenclast_si128(b6, rk);
+	b7 = _mm_aesenclast_si128(b7, rk);
+	block0 = b0; block1 = b1; block2 = b2; block3 = b3;
+	block4 = b4; block5 = b5; block6 = b6; block7 = b7;
+}
+
+inline void AESNI_Dec_8_Blocks(__m128i &block0, __m128i &block1, __m128i &block2, __m128i &block3, __m128i &block4, __m128i &block5, __m128i &block6, __m128i &block7, const __m128i *subkeys, unsigned int rounds)
+{
+	// work on copies, the compiler has to assume the references alias and would keep them in memory
+	__m128i b0 = block0, b1 = block1, b2 = block2, b3 = block3, b4 = block4, b5 = block5, b6 = block6, b7 = block7;
+	__m128i rk = subkeys[0];
+	b0 = _mm_xor_si128(b0, rk);
+	b1 = _mm_xor_si128(b1, rk);
+	b2 = _mm_xor_si128(b2, rk);
+	b3 = _mm_xor_si128(b3, rk);
+	b4 = _mm_xor_si128(b4, rk);
+	b5 = _mm_xor_si128(b5, rk);
+	b6 = _mm_xor_si128(b6, rk);
+	b7 = _mm_xor_si128(b7, rk);
+	for (unsigned int i=1; i<rounds; i++)
+	{
+		rk = subkeys[i];
+		b0 = _mm_aesdec_si128(b0, rk);
+		b1 = _mm_aesdec_si128(b1, rk);
+		b2 = _mm_aesdec_si128(b2, rk);
+		b3 = _mm_aesdec_si128(b3, rk);
+		b4 = _mm_aesdec_si128(b4, rk);
+		b5 = _mm_aesdec_si128(b5, rk);
+		b6 = _mm_aesdec_si128(b6, rk);
+		b7 = _mm_aesdec_si128(b7, rk);
+	}
+	rk = subkeys[rounds];
+	b0 = _mm_aesdeclast_si128(b0, rk);
+	b1 = _mm_aesdeclast_si128(b1, rk);
+	b2 = _mm_aesdeclast_si128(b2, rk);
+	b3 = _mm_aesdeclast_si128(b3, rk);
+	b4 = _mm_aesdeclast_si128(b4, rk);
+	b5 = _mm_aesdeclast_si128(b5, rk);
+	b6 = _mm_aesdeclast_si128(b6, rk);
+	b7 = _mm_aesdeclast_si128(b7, rk);
+	block0 = b0; block1 = b1; block2 = b2; block3 = b3;
+	block4 = b4; block5 = b5; block6 = b6; block7 = b7;
+}
+
 static CRYPTOPP_ALIGN_DATA(16) const word32 s_one[] = {0, 0, 0, 1<<24};
 
-template <typename F1, typename F4>
-inline size_t AESNI_AdvancedProcessBlocks(F1 func1, F4 func4, const __m128i *subkeys, unsigned int rounds, const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags)
+// processes groups of whole vectors in place of the 8 block loop, set up by Rijndael::Enc/Dec::AdvancedProcessBlocks
+typedef void (*AESNI_WideFunction)(const __m128i *subkeys, unsigned int rounds, const byte *&inBlocks, const byte *&xorBlocks, byte *&outBlocks, size_t &length, word32 flags);
+
+#if CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE
+//! 2 blocks per YMM register
+struct VAES_256
+{
+	typedef __m256i Vector;
+	enum {BLOCKS = 2};
+	static Vector Load(const byte *p) {return _mm256_loadu_si256((const __m256i *)p);}
+	static void Store(byte *p, const Vector &v) {_mm256_storeu_si256((__m256i *)p, v);}
+	static Vector Xor(const Vector &a, const Vector &b) {return _mm256_xor_si256(a, b);}
+	static Vector Broadcast(const __m128i *p) {return _mm256_broadcastsi128_si256(_mm_load_si128(p));}
+	static Vector Enc(const Vector &a, const Vector &k) {return _mm256_aesenc_epi128(a, k);}
+	static Vector EncLast(const Vector &a, const Vector &k) {return _mm256_aesenclast_epi128(a, k);}
+	static Vector Dec(const Vector &a, const Vector &k) {return _mm256_aesdec_epi128(a, k);}
+	static Vector DecLast(const Vector &a, const Vector &k) {return _mm256_aesdeclast_epi128(a, k);}
+	static Vector Add(const Vector &a, const Vector &b) {return _mm256_add_epi32(a, b);}
+	// the last byte of lane i is increased by i, and by BLOCKS from one vector to the next
+	static Vector LaneCounters(const __m128i &c) {return _mm256_add_epi32(_mm256_broadcastsi128_si256(c), _mm256_set_epi32(1<<24,0,0,0, 0,0,0,0));}
+	static Vector CounterStep() {return _mm256_set_epi32(2<<24,0,0,0, 2<<24,0,0,0);}
+};
+
+#if CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE
+//! 4 blocks per ZMM register
+struct VAES_512
+{
+	typedef __m512i Vector;
+	enum {BLOCKS = 4};
+	static Vector Load(const byte *p) {return _mm512_loadu_si512((const void *)p);}
+	static void Store(byte *p, const Vector &v) {_mm512_storeu_si512((void *)p, v);}
+	static Vector Xor(const Vector &a, const Vector &b) {return _mm512_xor_si512(a, b);}
+	static Vector Broadcast(const __m128i *p) {return _mm512_broadcast_i32x4(_mm_load_si128(p));}
+	static Vector Enc(const Vector &a, const Vector &k) {return _mm512_aesenc_epi128(a, k);}
+	static Vector EncLast(const Vector &a, const Vector &k) {return _mm512_aesenclast_epi128(a, k);}
+	static Vector Dec(const Vector &a, const Vector &k) {return _mm512_aesdec_epi128(a, k);}
+	static Vector DecLast(const Vector &a, const Vector &k) {return _mm512_aesdeclast_epi128(a, k);}
+	static Vector Add(const Vector &a, const Vector &b) {return _mm512_add_epi32(a, b);}
+	static Vector LaneCounters(const __m128i &c) {return _mm512_add_epi32(_mm512_broadcast_i32x4(c), _mm512_set_epi32(3<<24,0,0,0, 2<<24,0,0,0, 1<<24,0,0,0, 0,0,0,0));}
+	static Vector CounterStep() {return _mm512_set_epi32(4<<24,0,0,0, 4<<24,0,0,0, 4<<24,0,0,0, 4<<24,0,0,0);}
+};
+#endif
+
+template <class W, bool ENCRYPT>
+inline void VAES_4_Vectors(typename W::Vector &block0, typename W::Vector &block1, typename W::Vector &block2, typename W::Vector &block3, const __m128i *subkeys, unsigned int rounds)
+{
+	typename W::Vector rk = W::Broadcast(subkeys);
+	block0 = W::Xor(block0, rk);
+	block1 = W::Xor(block1, rk);
+	block2 = W::Xor(block2, rk);
+	block3 = W::Xor(block3, rk);
+	for (unsigned int i=1; i<rounds; i++)
+	{
+		rk = W::Broadcast(subkeys+i);
+		block0 = ENCRYPT ? W::Enc(block0, rk) : W::Dec(block0, rk);
+		block1 = ENCRYPT ? W::Enc(block1, rk) : W::Dec(block1, rk);
+		block2 = ENCRYPT ? W::Enc(block2, rk) : W::Dec(block2, rk);
+		block3 = ENCRYPT ? W::Enc(block3, rk) : W::Dec(block3, rk);
+	}
+	rk = W::Broadcast(subkeys+rounds);
+	block0 = ENCRYPT ? W::EncLast(block0, rk) : W::DecLast(block0, rk);
+	block1 = ENCRYPT ? W::EncLast(block1, rk) : W::DecLast(block1, rk);
+	block2 = ENCRYPT ? W::EncLast(block2, rk) : W::DecLast(block2, rk);
+	block3 = ENCRYPT ? W::EncLast(block3, rk) : W::DecLast(block3, rk);
+}
+
+// the blocks of one group are contiguous, in reverse direction the group ends at the current pointers
+template <class W, bool ENCRYPT>
+void VAES_AdvancedProcessBlocks(const __m128i *subkeys, unsigned int rounds, const byte *&inBlocks, const byte *&xorBlocks, byte *&outBlocks, size_t &length, word32 flags)
+{
+	const size_t blockSize = 16, groupSize = 4*W::BLOCKS*blockSize, vectorSize = W::BLOCKS*blockSize;
+	const bool counter = (flags & BlockTransformation::BT_InBlockIsCounter) != 0;
+	const bool reverse = (flags & BlockTransformation::BT_ReverseDirection) != 0;
+	const size_t groupOffset = reverse ? groupSize-blockSize : 0;
+	const typename W::Vector step = W::CounterStep();
+
+	while (length >= groupSize)
+	{
+		const byte *in = inBlocks - groupOffset, *x = xorBlocks - groupOffset;
+		byte *out = outBlocks - groupOffset;
+		typename W::Vector block0, block1, block2, block3;
+
+		if (counter)
+		{
+			const __m128i c = _mm_loadu_si128((const __m128i *)inBlocks);
+			block0 = W::LaneCounters(c);
+			block1 = W::Add(block0, step);
+			block2 = W::Add(block1, step);
+			block3 = W::Add(block2, step);
+			_mm_storeu_si128((__m128i *)inBlocks, _mm_add_epi32(c, _mm_set_epi32(4*W::BLOCKS<<24, 0, 0, 0)));
+		}
+		else
+		{
+			block0 = W::Load(in);
+			block1 = W::Load(in+vectorSize);
+			block2 = W::Load(in+2*vectorSize);
+			block3 = W::Load(in+3*vectorSize);
+			inBlocks += reverse ? 0-groupSize : groupSize;
+		}
+
+		if (xorBlocks && (flags & BlockTransformation::BT_XorInput))
+		{
+			block0 = W::Xor(block0, W::Load(x));
+			block1 = W::Xor(block1, W::Load(x+vectorSize));
+			block2 = W::Xor(block2, W::Load(x+2*vectorSize));
+			block3 = W::Xor(block3, W::Load(x+3*vectorSize));
+		}
+
+		VAES_4_Vectors<W, ENCRYPT>(block0, block1, block2, block3, subkeys, rounds);
+
+		if (xorBlocks && !(flags & BlockTransformation::BT_XorInput))
+		{
+			block0 = W::Xor(block0, W::Load(x));
+			block1 = W::Xor(block1, W::Load(x+vectorSize));
+			block2 = W::Xor(block2, W::Load(x+2*vectorSize));
+			block3 = W::Xor(block3, W::Load(x+3*vectorSize));
+		}
+
+		W::Store(out, block0);
+		W::Store(out+vectorSize, block1);
+		W::Store(out+2*vectorSize, block2);
+		W::Store(out+3*vectorSize, block3);
+
+		if (xorBlocks)
+			xorBlocks += reverse ? 0-groupSize : groupSize;
+		outBlocks += reverse ? 0-groupSize : groupSize;
+		length -= groupSize;
+	}
+}
+#endif
+
+// returns the widest AES implementation for a call with these flags, NULL if the 8 block loop should be used
+template <bool ENCRYPT>
+inline AESNI_WideFunction AESNI_GetWideFunction(word32 flags)
+{
+#if CRYPTOPP_BOOL_VAES_INTRINSICS_AVAILABLE
+	if ((flags & BlockTransformation::BT_AllowParallel) && !(flags & BlockTransformation::BT_DontIncrementInOutPointers) && HasVAES())
+	{
+#if CRYPTOPP_BOOL_AVX512_INTRINSICS_AVAILABLE
+		if (HasAVX512())
+			return VAES_AdvancedProcessBlocks<VAES_512, ENCRYPT>;
+#endif
+		return VAES_AdvancedProcessBlocks<VAES_256, ENCRYPT>;
+	}
+#endif
+	return NULL;
+}
+
+typedef void (*AESNI_Function1)(__m128i &block, const __m128i *subkeys, unsigned int rounds);
+typedef void (*AESNI_Function4)(__m128i &block0, __m128i &block1, __m128i &block2, __m128i &block3, const __m128i *subkeys, unsigned int rounds);
+typedef void (*AESNI_Function8)(__m128i &block0, __m128i &block1, __m128i &block2, __m128i &block3, __m128i &block4, __m128i &block5, __m128i &block6, __m128i &block7, const __m128i *subkeys, unsigned int rounds);
+
+// the block functions are template arguments so that each direction gets its own copy with direct calls
+template <AESNI_Function1 func1, AESNI_Function4 func4, AESNI_Function8 func8>
+inline size_t AESNI_AdvancedProcessBlocks(AESNI_WideFunction wide, const __m128i *subkeys, unsigned int rounds, const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags)
 {
 	size_t blockSize = 16;
 	size_t inIncrement = (flags & (BlockTransformation::BT_InBlockIsCounter|BlockTransformation::BT_DontIncrementInOutPointers)) ? 0 : blockSize;
@@ -1088,6 +1317,106 @@ inline size_t AESNI_AdvancedProcessBlocks(F1 func1, F4 func4, const __m128i *sub
 
 	if (flags & BlockTransformation::BT_AllowParallel)
 	{
+		if (wide)
+			wide(subkeys, rounds, inBlocks, xorBlocks, outBlocks, length, flags);
+
+		// 8 independent blocks keep the AES unit busy, 4 only cover its latency on older cores
+		while (length >= 8*blockSize)
+		{
+			__m128i block0 = _mm_loadu_si128((const __m128i *)inBlocks), block1, block2, block3, block4, block5, block6, block7;
+			if (flags & BlockTransformation::BT_InBlockIsCounter)
+			{
+				const __m128i be1 = *(const __m128i *)s_one;
+				block1 = _mm_add_epi32(block0, be1);
+				block2 = _mm_add_epi32(block1, be1);
+				block3 = _mm_add_epi32(block2, be1);
+				block4 = _mm_add_epi32(block3, be1);
+				block5 = _mm_add_epi32(block4, be1);
+				block6 = _mm_add_epi32(block5, be1);
+				block7 = _mm_add_epi32(block6, be1);
+				_mm_storeu_si128((__m128i *)inBlocks, _mm_add_epi32(block7, be1));
+			}
+			else
+			{
+				inBlocks += inIncrement;
+				block1 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+				block2 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+				block3 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+				block4 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+				block5 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+				block6 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+				block7 = _mm_loadu_si128((const __m128i *)inBlocks);
+				inBlocks += inIncrement;
+			}
+
+			if (flags & BlockTransformation::BT_XorInput)
+			{
+				block0 = _mm_xor_si128(block0, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block1 = _mm_xor_si128(block1, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block2 = _mm_xor_si128(block2, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block3 = _mm_xor_si128(block3, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block4 = _mm_xor_si128(block4, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block5 = _mm_xor_si128(block5, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block6 = _mm_xor_si128(block6, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block7 = _mm_xor_si128(block7, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+			}
+
+			func8(block0, block1, block2, block3, block4, block5, block6, block7, subkeys, rounds);
+
+			if (xorBlocks && !(flags & BlockTransformation::BT_XorInput))
+			{
+				block0 = _mm_xor_si128(block0, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block1 = _mm_xor_si128(block1, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block2 = _mm_xor_si128(block2, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block3 = _mm_xor_si128(block3, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block4 = _mm_xor_si128(block4, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block5 = _mm_xor_si128(block5, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block6 = _mm_xor_si128(block6, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+				block7 = _mm_xor_si128(block7, _mm_loadu_si128((const __m128i *)xorBlocks));
+				xorBlocks += xorIncrement;
+			}
+
+			_mm_storeu_si128((__m128i *)outBlocks, block0);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block1);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block2);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block3);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block4);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block5);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block6);
+			outBlocks += outIncrement;
+			_mm_storeu_si128((__m128i *)outBlocks, block7);
+			outBlocks += outIncrement;
+
+			length -= 8*blockSize;
+		}
+
 		while (length >= 4*blockSize)
 		{
 			__m128i block0 = _mm_loadu_si128((const __m128i *)inBlocks), block1, block2, block3;
@@ -1180,7 +1509,7 @@ size_t Rijndael::Enc::AdvancedProcessBlocks(const byte *inBlocks, const byte *xo
 {
 #if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
 	if (HasAESNI())
-		return AESNI_AdvancedProcessBlocks(AESNI_Enc_Block, AESNI_Enc_4_Blocks, (const __m128i *)m_key.begin(), m_rounds, inBlocks, xorBlocks, outBlocks, length, flags);
+		return AESNI_AdvancedProcessBlocks<AESNI_Enc_Block, AESNI_Enc_4_Blocks, AESNI_Enc_8_Blocks>(AESNI_GetWideFunction<true>(flags), (const __m128i *)m_key.begin(), m_rounds, inBlocks, xorBlocks, outBlocks, length, flags);
 #endif
 	
 #if CRYPTOPP_BOOL_SSE2_ASM_AVAILABLE || defined(CRYPTOPP_X64_MASM_AVAILABLE)
@@ -1250,7 +1579,7 @@ size_t Rijndael::Enc::AdvancedProcessBlocks(const byte *inBlocks, const byte *xo
 size_t Rijndael::Dec::AdvancedProcessBlocks(const byte *inBlocks, const byte *xorBlocks, byte *outBlocks, size_t length, word32 flags) const
 {
 	if (HasAESNI())
-		return AESNI_AdvancedProcessBlocks(AESNI_Dec_Block, AESNI_Dec_4_Blocks, (const __m128i *)m_key.begin(), m_rounds, inBlocks, xorBlocks, outBlocks, length, flags);
+		return AESNI_AdvancedProcessBlocks<AESNI_Dec_Block, AESNI_Dec_4_Blocks, AESNI_Dec_8_Blocks>(AESNI_GetWideFunction<false>(flags), (const __m128i *)m_key.begin(), m_rounds, inBlocks, xorBlocks, outBlocks, length, flags);
 	
 	return BlockTransformation::AdvancedProcessBlocks(inBlocks, xorBlocks, outBlocks, length, flags);
 }
@@ -22,6 +22,10 @@ class CRYPTOPP_DLL Rijndael : public Rijndael_Info, public BlockCipherDocumentat
 	{
 	public:
 		void UncheckedSetKey(const byte *userKey, unsigned int length, const NameValuePairs &params);
+#if CRYPTOPP_BOOL_AESNI_INTRINSICS_AVAILABLE
+		//! the key schedule for AESENC or AESDEC, only valid if HasAESNI(), used by modes that interleave AES-NI with other work
+		const byte * GetAESNIRoundKeys(unsigned int &rounds) const {rounds = m_rounds; return (const byte *)m_key.begin();}
+#endif
 
 	protected:
 		static void FillEncTable();
@@ -9,6 +9,7 @@
 #include "sha.h"
 #include "algparam.h"
 #include "fips140.h"
+#include "threadpool.h"
 
 #if !defined(NDEBUG) && !defined(CRYPTOPP_IS_DLL)
 #include "pssr.h"
@@ -67,6 +68,15 @@ Integer RSAFunction::ApplyFunction(const Integer &x) const
 	return a_exp_b_mod_c(x, m_e, m_n);
 }
 
+void RSAFunction::ApplyFunctionBatch(const Integer *x, Integer *y, size_t count) const
+{
+	DoQuickSanityCheck();
+	// one Montgomery setup for the batch, and the sliding window suits the short public exponent
+	MontgomeryRepresentation mr(m_n);
+	for (size_t i=0; i<count; i++)
+		y[i] = mr.ConvertOut(mr.Exponentiate(mr.ConvertIn(x[i]), m_e));
+}
+
 bool RSAFunction::Validate(RandomNumberGenerator &rng, unsigned int level) const
 {
 	bool pass = true;
@@ -109,25 +119,75 @@ void InvertibleRSAFunction::GenerateRandom(RandomNumberGenerator &rng, const Nam
 	if (modulusSize < 16)
 		throw InvalidArgument("InvertibleRSAFunction: specified modulus size is too small");
 
+	int primeCount = 2;
+	alg.GetIntValue(Name::NumberOfPrimes(), primeCount);
+
+	if (primeCount < 2 || primeCount > (int)MaxPrimeCount(modulusSize))
+		throw InvalidArgument("InvertibleRSAFunction: invalid number of primes");
+
 	m_e = alg.GetValueWithDefault(Name::PublicExponent(), Integer(17));
 
 	if (m_e < 3 || m_e.IsEven())
 		throw InvalidArgument("InvertibleRSAFunction: invalid public exponent");
 
 	RSAPrimeSelector selector(m_e);
-	AlgorithmParameters primeParam = MakeParametersForTwoPrimesOfEqualSize(modulusSize)
-		(Name::PointerToPrimeSelector(), selector.GetSelectorPointer());
-	m_p.GenerateRandom(rng, primeParam);
-	m_q.GenerateRandom(rng, primeParam);
+	m_otherPrimes.clear();
+	if (primeCount == 2)
+	{
+		AlgorithmParameters primeParam = MakeParametersForTwoPrimesOfEqualSize(modulusSize)
+			(Name::PointerToPrimeSelector(), selector.GetSelectorPointer());
+		m_p.GenerateRandom(rng, primeParam);
+		m_q.GenerateRandom(rng, primeParam);
+		m_n = m_p * m_q;
+	}
+	else
+	{
+		// all but the last prime have the same size, the last one is taken
+		// from the range that makes the modulus exactly modulusSize bits long
+		const unsigned int primeSize = modulusSize / primeCount;
+		std::vector<Integer> primes(primeCount);
+		m_n = Integer::One();
+		for (int i=0; i<primeCount; i++)
+		{
+			Integer minPrime = Integer(3) << (primeSize-2), maxPrime = Integer::Power2(primeSize)-1;
+			if (i == primeCount-1)
+			{
+				minPrime = (Integer::Power2(modulusSize-1) + m_n - 1) / m_n;
+				maxPrime = (Integer::Power2(modulusSize) - 1) / m_n;
+			}
+			AlgorithmParameters primeParam = MakeParameters("RandomNumberType", Integer::PRIME)("Min", minPrime)("Max", maxPrime)
+				(Name::PointerToPrimeSelector(), selector.GetSelectorPointer());
+			do
+				primes[i].GenerateRandom(rng, primeParam);
+			while (std::find(primes.begin(), primes.begin()+i, primes[i]) != primes.begin()+i);
+			m_n *= primes[i];
+		}
+
+		m_p = primes[0];
+		m_q = primes[1];
+		for (int i=2; i<primeCount; i++)
+			m_otherPrimes.push_back(RSAOtherPrimeInfo(primes[i], Integer::Zero(), Integer::Zero()));
+	}
 
-	m_d = m_e.InverseMod(LCM(m_p-1, m_q-1));
+	Integer lambda = LCM(m_p-1, m_q-1);
+	for (size_t i=0; i<m_otherPrimes.size(); i++)
+		lambda = LCM(lambda, m_otherPrimes[i].prime-1);
+	m_d = m_e.InverseMod(lambda);
 	assert(m_d.IsPositive());
 
 	m_dp = m_d % (m_p-1);
 	m_dq = m_d % (m_q-1);
-	m_n = m_p * m_q;
 	m_u = m_q.InverseMod(m_p);
 
+	Integer product = m_p * m_q;
+	for (size_t i=0; i<m_otherPrimes.size(); i++)
+	{
+		RSAOtherPrimeInfo &info = m_otherPrimes[i];
+		info.exponent = m_d % (info.prime-1);
+		info.coefficient = (product % info.prime).InverseMod(info.prime);
+		product *= info.prime;
+	}
+
 	if (FIPS_140_2_ComplianceEnabled())
 	{
 		RSASS<PKCS1v15, SHA>::Signer signer(*this);
@@ -140,9 +200,9 @@ void InvertibleRSAFunction::GenerateRandom(RandomNumberGenerator &rng, const Nam
 	}
 }
 
-void InvertibleRSAFunction::Initialize(RandomNumberGenerator &rng, unsigned int keybits, const Integer &e)
+void InvertibleRSAFunction::Initialize(RandomNumberGenerator &rng, unsigned int keybits, const Integer &e, unsigned int primeCount)
 {
-	GenerateRandom(rng, MakeParameters(Name::ModulusSize(), (int)keybits)(Name::PublicExponent(), e+e.IsEven()));
+	GenerateRandom(rng, MakeParameters(Name::ModulusSize(), (int)keybits)(Name::PublicExponent(), e+e.IsEven())(Name::NumberOfPrimes(), (int)primeCount));
 }
 
 void InvertibleRSAFunction::Initialize(const Integer &n, const Integer &e, const Integer &d)
@@ -153,6 +213,7 @@ void InvertibleRSAFunction::Initialize(const Integer &n, const Integer &e, const
 	m_n = n;
 	m_e = e;
 	m_d = d;
+	m_otherPrimes.clear();
 
 	Integer r = --(d*e);
 	unsigned int s = 0;
@@ -193,7 +254,7 @@ void InvertibleRSAFunction::BERDecodePrivateKey(BufferedTransformation &bt, bool
 {
 	BERSequenceDecoder privateKey(bt);
 		word32 version;
-		BERDecodeUnsigned<word32>(privateKey, version, INTEGER, 0, 0);	// check version
+		BERDecodeUnsigned<word32>(privateKey, version, INTEGER, 0, 1);	// check version, 1 is a multi-prime key
 		m_n.BERDecode(privateKey);
 		m_e.BERDecode(privateKey);
 		m_d.BERDecode(privateKey);
@@ -202,13 +263,31 @@ void InvertibleRSAFunction::BERDecodePrivateKey(BufferedTransformation &bt, bool
 		m_dp.BERDecode(privateKey);
 		m_dq.BERDecode(privateKey);
 		m_u.BERDecode(privateKey);
+		m_otherPrimes.clear();
+		if (version == 1)
+		{
+			BERSequenceDecoder otherPrimeInfos(privateKey);
+			while (!otherPrimeInfos.EndReached())
+			{
+				RSAOtherPrimeInfo info;
+				BERSequenceDecoder otherPrimeInfo(otherPrimeInfos);
+					info.prime.BERDecode(otherPrimeInfo);
+					info.exponent.BERDecode(otherPrimeInfo);
+					info.coefficient.BERDecode(otherPrimeInfo);
+				otherPrimeInfo.MessageEnd();
+				m_otherPrimes.push_back(info);
+			}
+			otherPrimeInfos.MessageEnd();
+			if (m_otherPrimes.empty())
+				BERDecodeError();
+		}
 	privateKey.MessageEnd();
 }
 
 void InvertibleRSAFunction::DEREncodePrivateKey(BufferedTransformation &bt) const
 {
 	DERSequenceEncoder privateKey(bt);
-		DEREncodeUnsigned<word32>(privateKey, 0);	// version
+		DEREncodeUnsigned<word32>(privateKey, m_otherPrimes.empty() ? 0 : 1);	// version
 		m_n.DEREncode(privateKey);
 		m_e.DEREncode(privateKey);
 		m_d.DEREncode(privateKey);
@@ -217,9 +296,48 @@ void InvertibleRSAFunction::DEREncodePrivateKey(BufferedTransformation &bt) cons
 		m_dp.DEREncode(privateKey);
 		m_dq.DEREncode(privateKey);
 		m_u.DEREncode(privateKey);
+		if (!m_otherPrimes.empty())
+		{
+			DERSequenceEncoder otherPrimeInfos(privateKey);
+			for (size_t i=0; i<m_otherPrimes.size(); i++)
+			{
+				DERSequenceEncoder otherPrimeInfo(otherPrimeInfos);
+					m_otherPrimes[i].prime.DEREncode(otherPrimeInfo);
+					m_otherPrimes[i].exponent.DEREncode(otherPrimeInfo);
+					m_otherPrimes[i].coefficient.DEREncode(otherPrimeInfo);
+				otherPrimeInfo.MessageEnd();
+			}
+			otherPrimeInfos.MessageEnd();
+		}
 	privateKey.MessageEnd();
 }
 
+//! computes x^d_i mod r_i for the i-th prime of the key
+class RSAPrimeExponentiation : public ParallelLoopBody
+{
+public:
+	RSAPrimeExponentiation(const InvertibleRSAFunction &key, const Integer &x, Integer *results)
+		: m_key(key), m_x(x), m_results(results) {}
+
+	void operator()(unsigned int index)
+	{
+		if (index == 0)
+			m_results[0] = ModularExponentiation(m_x % m_key.GetPrime1(), m_key.GetModPrime1PrivateExponent(), m_key.GetPrime1());
+		else if (index == 1)
+			m_results[1] = ModularExponentiation(m_x % m_key.GetPrime2(), m_key.GetModPrime2PrivateExponent(), m_key.GetPrime2());
+		else
+		{
+			const RSAOtherPrimeInfo &info = m_key.GetOtherPrimeInfos()[index-2];
+			m_results[index] = ModularExponentiation(m_x % info.prime, info.exponent, info.prime);
+		}
+	}
+
+private:
+	const InvertibleRSAFunction &m_key;
+	const Integer &m_x;
+	Integer *m_results;
+};
+
 Integer InvertibleRSAFunction::CalculateInverse(RandomNumberGenerator &rng, const Integer &x) const 
 {
 	DoQuickSanityCheck();
@@ -231,9 +349,34 @@ Integer InvertibleRSAFunction::CalculateInverse(RandomNumberGenerator &rng, cons
 	} while (rInv.IsZero());
 	Integer re = modn.Exponentiate(r, m_e);
 	re = modn.Multiply(re, x);			// blind
-	// here we follow the notation of PKCS #1 and let u=q inverse mod p
-	// but in ModRoot, u=p inverse mod q, so we reverse the order of p and q
-	Integer y = ModularRoot(re, m_dq, m_dp, m_q, m_p, m_u);
+	Integer y;
+	if (m_otherPrimes.empty() && !m_parallelCRT)
+	{
+		// here we follow the notation of PKCS #1 and let u=q inverse mod p
+		// but in ModRoot, u=p inverse mod q, so we reverse the order of p and q
+		y = ModularRoot(re, m_dq, m_dp, m_q, m_p, m_u);
+	}
+	else
+	{
+		const unsigned int primeCount = GetPrimeCount();
+		std::vector<Integer> results(primeCount);
+		RSAPrimeExponentiation body(*this, re, &results[0]);
+		if (m_parallelCRT)
+			ThreadPool::GetGlobalPool().ParallelFor(primeCount, body);
+		else
+			for (unsigned int i=0; i<primeCount; i++)
+				body(i);
+
+		// CRT recombination of PKCS #1 v2.2 section 5.1.2, step 2.b
+		y = CRT(results[1], m_q, results[0], m_p, m_u);
+		Integer product = m_p * m_q;
+		for (size_t i=0; i<m_otherPrimes.size(); i++)
+		{
+			const RSAOtherPrimeInfo &info = m_otherPrimes[i];
+			y += product * (info.coefficient * ((results[i+2] - y) % info.prime) % info.prime);
+			product *= info.prime;
+		}
+	}
 	y = modn.Multiply(y, rInv);				// unblind
 	if (modn.Exponentiate(y, m_e) != x)		// check
 		throw Exception(Exception::OTHER_ERROR, "InvertibleRSAFunction: computational error during private key operation");
@@ -249,32 +392,63 @@ bool InvertibleRSAFunction::Validate(RandomNumberGenerator &rng, unsigned int le
 	pass = pass && m_dp > Integer::One() && m_dp.IsOdd() && m_dp < m_p;
 	pass = pass && m_dq > Integer::One() && m_dq.IsOdd() && m_dq < m_q;
 	pass = pass && m_u.IsPositive() && m_u < m_p;
+	for (size_t i=0; pass && i<m_otherPrimes.size(); i++)
+	{
+		const RSAOtherPrimeInfo &info = m_otherPrimes[i];
+		pass = pass && info.prime > Integer::One() && info.prime.IsOdd() && info.prime < m_n;
+		pass = pass && info.exponent > Integer::One() && info.exponent.IsOdd() && info.exponent < info.prime;
+		pass = pass && info.coefficient.IsPositive() && info.coefficient < info.prime;
+	}
 	if (level >= 1)
 	{
-		pass = pass && m_p * m_q == m_n;
-		pass = pass && m_e*m_d % LCM(m_p-1, m_q-1) == 1;
+		Integer product = m_p * m_q, lambda = LCM(m_p-1, m_q-1);
+		for (size_t i=0; pass && i<m_otherPrimes.size(); i++)
+		{
+			const RSAOtherPrimeInfo &info = m_otherPrimes[i];
+			pass = pass && info.exponent == m_d%(info.prime-1);
+			pass = pass && info.coefficient * product % info.prime == 1;
+			product *= info.prime;
+			lambda = LCM(lambda, info.prime-1);
+		}
+		pass = pass && product == m_n;
+		pass = pass && m_e*m_d % lambda == 1;
 		pass = pass && m_dp == m_d%(m_p-1) && m_dq == m_d%(m_q-1);
 		pass = pass && m_u * m_q % m_p == 1;
 	}
 	if (level >= 2)
+	{
 		pass = pass && VerifyPrime(rng, m_p, level-2) && VerifyPrime(rng, m_q, level-2);
+		for (size_t i=0; pass && i<m_otherPrimes.size(); i++)
+			pass = pass && VerifyPrime(rng, m_otherPrimes[i].prime, level-2);
+	}
 	return pass;
 }
 
 bool InvertibleRSAFunction::GetVoidValue(const char *name, const std::type_info &valueType, void *pValue) const
 {
-	return GetValueHelper<RSAFunction>(this, name, valueType, pValue).Assignable()
-		CRYPTOPP_GET_FUNCTION_ENTRY(Prime1)
-		CRYPTOPP_GET_FUNCTION_ENTRY(Prime2)
-		CRYPTOPP_GET_FUNCTION_ENTRY(PrivateExponent)
-		CRYPTOPP_GET_FUNCTION_ENTRY(ModPrime1PrivateExponent)
-		CRYPTOPP_GET_FUNCTION_ENTRY(ModPrime2PrivateExponent)
-		CRYPTOPP_GET_FUNCTION_ENTRY(MultiplicativeInverseOfPrime2ModPrime1)
-		;
+	if (strcmp(name, Name::ParallelCRT()) == 0)
+	{
+		this->ThrowIfTypeMismatch(name, typeid(bool), valueType);
+		*reinterpret_cast<bool *>(pValue) = m_parallelCRT;
+		return true;
+	}
+	else
+		return GetValueHelper<RSAFunction>(this, name, valueType, pValue).Assignable()
+			CRYPTOPP_GET_FUNCTION_ENTRY(Prime1)
+			CRYPTOPP_GET_FUNCTION_ENTRY(Prime2)
+			CRYPTOPP_GET_FUNCTION_ENTRY(PrivateExponent)
+			CRYPTOPP_GET_FUNCTION_ENTRY(ModPrime1PrivateExponent)
+			CRYPTOPP_GET_FUNCTION_ENTRY(ModPrime2PrivateExponent)
+			CRYPTOPP_GET_FUNCTION_ENTRY(MultiplicativeInverseOfPrime2ModPrime1)
+			CRYPTOPP_GET_FUNCTION_ENTRY(OtherPrimeInfos)
+			;
 }
 
 void InvertibleRSAFunction::AssignFrom(const NameValuePairs &source)
 {
+	if (source.GetThisObject(*this))
+		return;
+
 	AssignFromHelper<RSAFunction>(this, source)
 		CRYPTOPP_SET_FUNCTION_ENTRY(Prime1)
 		CRYPTOPP_SET_FUNCTION_ENTRY(Prime2)
@@ -283,6 +457,11 @@ void InvertibleRSAFunction::AssignFrom(const NameValuePairs &source)
 		CRYPTOPP_SET_FUNCTION_ENTRY(ModPrime2PrivateExponent)
 		CRYPTOPP_SET_FUNCTION_ENTRY(MultiplicativeInverseOfPrime2ModPrime1)
 		;
+
+	// both are optional, without other primes this is a two-prime key
+	m_otherPrimes.clear();
+	source.GetValue(Name::OtherPrimeInfos(), m_otherPrimes);
+	source.GetValue(Name::ParallelCRT(), m_parallelCRT);
 }
 
 // *****************************************************************************
@@ -293,6 +472,14 @@ Integer RSAFunction_ISO::ApplyFunction(const Integer &x) const
 	return t % 16 == 12 ? t : m_n - t;
 }
 
+void RSAFunction_ISO::ApplyFunctionBatch(const Integer *x, Integer *y, size_t count) const
+{
+	RSAFunction::ApplyFunctionBatch(x, y, count);
+	for (size_t i=0; i<count; i++)
+		if (y[i] % 16 != 12)
+			y[i] = m_n - y[i];
+}
+
 Integer InvertibleRSAFunction_ISO::CalculateInverse(RandomNumberGenerator &rng, const Integer &x) const 
 {
 	Integer t = InvertibleRSAFunction::CalculateInverse(rng, x);
@@ -35,6 +35,7 @@ public:
 
 	// TrapdoorFunction
 	Integer ApplyFunction(const Integer &x) const;
+	void ApplyFunctionBatch(const Integer *x, Integer *y, size_t count) const;
 	Integer PreimageBound() const {return m_n;}
 	Integer ImageBound() const {return m_n;}
 
@@ -49,15 +50,29 @@ protected:
 	Integer m_n, m_e;
 };
 
+//! additional prime of a multi-prime key, as in the OtherPrimeInfo sequence of PKCS #1 v2.2 (RFC 8017)
+struct CRYPTOPP_DLL RSAOtherPrimeInfo
+{
+	RSAOtherPrimeInfo() {}
+	RSAOtherPrimeInfo(const Integer &r, const Integer &d, const Integer &t)
+		: prime(r), exponent(d), coefficient(t) {}
+
+	//! prime r_i, d_i = d mod (r_i-1) and t_i = inverse of r_1*...*r_(i-1) mod r_i
+	Integer prime, exponent, coefficient;
+};
+
 //! _
 class CRYPTOPP_DLL InvertibleRSAFunction : public RSAFunction, public TrapdoorFunctionInverse, public PKCS8PrivateKey
 {
 	typedef InvertibleRSAFunction ThisClass;
 
 public:
-	void Initialize(RandomNumberGenerator &rng, unsigned int modulusBits, const Integer &e = 17);
+	InvertibleRSAFunction() : m_parallelCRT(false) {}
+
+	//! primeCount is 2 for a regular key and 3 up to MaxPrimeCount(modulusBits) for a multi-prime key
+	void Initialize(RandomNumberGenerator &rng, unsigned int modulusBits, const Integer &e = 17, unsigned int primeCount = 2);
 	void Initialize(const Integer &n, const Integer &e, const Integer &d, const Integer &p, const Integer &q, const Integer &dp, const Integer &dq, const Integer &u)
-		{m_n = n; m_e = e; m_d = d; m_p = p; m_q = q; m_dp = dp; m_dq = dq; m_u = u;}
+		{m_n = n; m_e = e; m_d = d; m_p = p; m_q = q; m_dp = dp; m_dq = dq; m_u = u; m_otherPrimes.clear();}
 	//! factor n given private exponent
 	void Initialize(const Integer &n, const Integer &e, const Integer &d);
 
@@ -79,7 +94,7 @@ public:
 
 	// GeneratableCryptoMaterial
 	bool Validate(RandomNumberGenerator &rng, unsigned int level) const;
-	/*! parameters: (ModulusSize, PublicExponent (default 17)) */
+	/*! parameters: (ModulusSize, PublicExponent (default 17), NumberOfPrimes (default 2)) */
 	void GenerateRandom(RandomNumberGenerator &rng, const NameValuePairs &alg);
 	bool GetVoidValue(const char *name, const std::type_info &valueType, void *pValue) const;
 	void AssignFrom(const NameValuePairs &source);
@@ -91,6 +106,12 @@ public:
 	const Integer& GetModPrime1PrivateExponent() const {return m_dp;}
 	const Integer& GetModPrime2PrivateExponent() const {return m_dq;}
 	const Integer& GetMultiplicativeInverseOfPrime2ModPrime1() const {return m_u;}
+	//! primes after the first two, empty for a two-prime key
+	const std::vector<RSAOtherPrimeInfo>& GetOtherPrimeInfos() const {return m_otherPrimes;}
+	unsigned int GetPrimeCount() const {return 2 + (unsigned int)m_otherPrimes.size();}
+	//! the largest number of primes GenerateRandom() accepts, the limits of OpenSSL so that no prime is too small to factor
+	static unsigned int MaxPrimeCount(unsigned int modulusBits)
+		{return modulusBits < 1024 ? 2 : modulusBits < 4096 ? 3 : modulusBits < 8192 ? 4 : 5;}
 
 	void SetPrime1(const Integer &p) {m_p = p;}
 	void SetPrime2(const Integer &q) {m_q = q;}
@@ -98,15 +119,25 @@ public:
 	void SetModPrime1PrivateExponent(const Integer &dp) {m_dp = dp;}
 	void SetModPrime2PrivateExponent(const Integer &dq) {m_dq = dq;}
 	void SetMultiplicativeInverseOfPrime2ModPrime1(const Integer &u) {m_u = u;}
+	void SetOtherPrimeInfos(const std::vector<RSAOtherPrimeInfo> &otherPrimes) {m_otherPrimes = otherPrimes;}
+
+	//! run the exponentiations modulo each prime concurrently on ThreadPool::GetGlobalPool()
+	/*! This lowers the latency of a single private key operation, but the hand-off costs
+		some throughput, so leave it off when many operations already run in parallel. */
+	void SetParallelCRT(bool parallel) {m_parallelCRT = parallel;}
+	bool GetParallelCRT() const {return m_parallelCRT;}
 
 protected:
 	Integer m_d, m_p, m_q, m_dp, m_dq, m_u;
+	std::vector<RSAOtherPrimeInfo> m_otherPrimes;
+	bool m_parallelCRT;
 };
 
 class CRYPTOPP_DLL RSAFunction_ISO : public RSAFunction
 {
 public:
 	Integer ApplyFunction(const Integer &x) const;
+	void ApplyFunctionBatch(const Integer *x, Integer *y, size_t count) const;
 	Integer PreimageBound() const {return ++(m_n>>1);}
 };
 
@@ -3,114 +3,17 @@
 #include "pch.h"
 #include "scrypt.h"
 #include "cpu.h"
-
-#define DISABLE_SSE_LOCALLY
+#include "threadpool.h"
 
 NAMESPACE_BEGIN(CryptoPP)
 
-size_t scrypt_Base::MaxDerivedKeyLength() const
-{
-#if CRYPTOPP_BOOL_X64 == 1
-	return 0xffffffffUI64 * GetHash().DigestSize();
-#else
-	return 0xffffffffU;// should multiply by T::DIGESTSIZE, but gets overflow that way
-#endif
-}
-
-word64 scrypt_Base::MaxTCost() const
-{
-	const word64 Result = (0xffffffffUI64 >> (Log2R + 7)) * GetHash().DigestSize();
-	if(Result > word64((size_t(0)-1))) // prevent integer overflow
-		return word64(0)-1;
-	else
-		return Result;
-}
-
-size_t scrypt_Base::MaxMemoryUsage(word64 mCost) const
-{
-	// needs 128*N*r bits of memory, r=8 --> 1024*N --> 1<<(mCost + 10)
-	if(mCost >= MaxMCost())
-		return size_t(0)-1;
-	else
-		return 1ui64 << (mCost+Log2R+7);
-}
-
-word64 scrypt_Base::GetMCostFromPeakNumberBytes(size_t PeakNumberBytes) const
-{
-	if(PeakNumberBytes<(1ui64 << (Log2R+7)))
-		return 1; // minmal valid mCost
-	
-	word32 NumberShifts=0;
-	PeakNumberBytes>>=Log2R+7; // reduction to only measure log_2(N) and not 128rN
-	while(PeakNumberBytes!=1)
-	{
-		PeakNumberBytes>>=1;
-		NumberShifts++;
-	}
-	return NumberShifts;
-}
-
-word64 scrypt_Base::Integerify(const byte* State,word64 R,word64 N) const
-{
-	/*uint32_t * X = (word32 *)((uintptr_t)(State) + (2 * R - 1) * 64);
-
-	word64 Index = (((uint64_t)(X[1]) << 32) + X[0]);
-
-	return Index & (N-1);*/
-	const size_t AccessIndex = (R<<7)-64;
-	word64 Index = ConditionalByteReverse(LITTLE_ENDIAN_ORDER,*((word64*)(&State[AccessIndex]))) & ConditionalByteReverse(LITTLE_ENDIAN_ORDER,N-1);
-	return ConditionalByteReverse(LITTLE_ENDIAN_ORDER,Index); // revert if it was big-endian, so we get a proper access
-}
-
-void scrypt_Base::BlockMix(byte* Out,const byte* In,word64 R) const
-{
-	FixedSizeSecBlock<byte,64> BlockMixState;
-	memcpy_s(BlockMixState,64,&In[(R<<7)-64],64);
-	for(word64 j=0;j<(R<<1);j+=2) // perform double-rounds
-	{
-		// round 1:
-		xorbuf(BlockMixState,&In[j<<6],64);
-		OptimizedSalsa208Core((word32*)BlockMixState.BytePtr());
-		memcpy_s(&Out[j<<5],64,BlockMixState,64);
-
-		// round 2:
-		xorbuf(BlockMixState,&In[(j|1)<<6],64);
-		OptimizedSalsa208Core((word32*)BlockMixState.BytePtr());
-		memcpy_s(&Out[(j<<5)+(R<<6)],64,BlockMixState,64);
-	}
-}
-
-void scrypt_Base::SMix(byte* Data,size_t Offset,word64 Log2N,word64 R)const
-{
-	const size_t LocalDataLength = R << 7;
-	const word64 Modulus = ConditionalByteReverse(LITTLE_ENDIAN_ORDER,(1ui64<<Log2N)-1);
-
-	SecByteBlock LookupTable((1ui64<<(Log2N+7))*R);
-	SecByteBlock PrimaryState(&Data[Offset],LocalDataLength);
-	SecByteBlock SecondaryState(LocalDataLength);
-
-	for(word64 i=0;i<(1ui64<<Log2N);i+=2)
-	{
-		memcpy(&LookupTable.BytePtr()[i*LocalDataLength],PrimaryState,LocalDataLength);
-		BlockMix(SecondaryState,PrimaryState,R);
-
-		memcpy(&LookupTable.BytePtr()[(i|1)*LocalDataLength],SecondaryState,LocalDataLength);
-		BlockMix(PrimaryState,SecondaryState,R);
-	}
-	for(word64 i=0;i<(1ui64<<Log2N);i+=2)
-	{
-		xorbuf(PrimaryState,&LookupTable.BytePtr()[Integerify(PrimaryState,R,1ui64<<Log2N)*LocalDataLength],LocalDataLength);
-		BlockMix(SecondaryState,PrimaryState,R);
-
-		xorbuf(SecondaryState,&LookupTable.BytePtr()[Integerify(SecondaryState,R,1ui64<<Log2N)*LocalDataLength],LocalDataLength);
-		BlockMix(PrimaryState,SecondaryState,R);
-	}
-	memcpy(&Data[Offset],PrimaryState,LocalDataLength);
-}
-
+#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+// The SSE2 path keeps every 64-byte block in the word order 0,5,10,15, 4,9,14,3, 8,13,2,7, 12,1,6,11
+// Salsa208SSE() works in. The lanes are shuffled once when SMix starts and once when it ends,
+// the lookup table never sees the standard order.
 // the content of the following function has been placed in the public domain by Colin Percival
 // upon request of Jean-Pierre Muench
-void Salsa208SSE(__m128i B[4])
+static inline void Salsa208SSE(__m128i B[4])
 {
 	__m128i X0, X1, X2, X3;
 	__m128i T;
@@ -167,7 +70,74 @@ void Salsa208SSE(__m128i B[4])
 	B[3] = _mm_add_epi32(B[3], X3);
 }
 
-void Salsa208REF(word32* InOut)
+// shuffled word i of a block is standard word 5*i mod 16
+static inline size_t ScryptShuffledWord(size_t i)
+{
+	return (i & ~size_t(15)) | ((5*i) & 15);
+}
+
+// Out = BlockMix(In ^ Xor), Xor is only read if XOR is set
+template <bool XOR>
+static void BlockMixSSE2(__m128i *Out, const __m128i *In, const __m128i *Xor, size_t R)
+{
+	__m128i X[4];
+	for(unsigned int k=0;k<4;++k)
+		X[k] = XOR ? _mm_xor_si128(In[8*R-4+k],Xor[8*R-4+k]) : In[8*R-4+k];
+
+	for(size_t i=0;i<R;++i)
+	{
+		for(unsigned int k=0;k<4;++k)
+			X[k] = _mm_xor_si128(X[k], XOR ? _mm_xor_si128(In[8*i+k],Xor[8*i+k]) : In[8*i+k]);
+		Salsa208SSE(X);
+		for(unsigned int k=0;k<4;++k)
+			Out[4*i+k] = X[k];
+
+		for(unsigned int k=0;k<4;++k)
+			X[k] = _mm_xor_si128(X[k], XOR ? _mm_xor_si128(In[8*i+4+k],Xor[8*i+4+k]) : In[8*i+4+k]);
+		Salsa208SSE(X);
+		for(unsigned int k=0;k<4;++k)
+			Out[4*(R+i)+k] = X[k];
+	}
+}
+
+// in the shuffled order the 64-bit index is made of the words 0 and 13 of the last block
+static inline word64 IntegerifySSE2(const __m128i *State, size_t R, word64 N)
+{
+	const word32 *Words = (const word32 *)&State[8*R-4];
+	return ((word64(Words[13]) << 32) | Words[0]) & (N-1);
+}
+
+// Scratch has to be 16-byte aligned, Data may be unaligned
+static void SMixSSE2(byte* Data, word64 Log2N, size_t R, byte* Scratch)
+{
+	const size_t Blocks = 8*R;
+	const word64 N = 1ui64<<Log2N;
+	__m128i *V = (__m128i *)Scratch;
+	__m128i *X = V+N*Blocks;
+	__m128i *Y = X+Blocks;
+	word32 *XWords = (word32 *)X;
+
+	for(size_t i=0;i<16*2*R;++i)
+		XWords[i] = GetWord<word32>(false,LITTLE_ENDIAN_ORDER,Data+4*ScryptShuffledWord(i));
+
+	// BlockMix writes straight into the next table entry
+	memcpy(V,X,Blocks*sizeof(__m128i));
+	for(word64 i=0;i<N-1;++i)
+		BlockMixSSE2<false>(V+(i+1)*Blocks,V+i*Blocks,NULL,R);
+	BlockMixSSE2<false>(X,V+(N-1)*Blocks,NULL,R);
+
+	for(word64 i=0;i<N;i+=2)
+	{
+		BlockMixSSE2<true>(Y,X,V+IntegerifySSE2(X,R,N)*Blocks,R);
+		BlockMixSSE2<true>(X,Y,V+IntegerifySSE2(Y,R,N)*Blocks,R);
+	}
+
+	for(size_t i=0;i<16*2*R;++i)
+		PutWord<word32>(false,LITTLE_ENDIAN_ORDER,Data+4*ScryptShuffledWord(i),XWords[i]);
+}
+#endif // CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
+
+static void Salsa208REF(word32* InOut)
 {
 #define R(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
    int i;
@@ -194,154 +164,184 @@ void Salsa208REF(word32* InOut)
    }
    for (i = 0;i < 16;++i)
 	   InOut[i] += x[i];
+#undef R
 }
 
-void scrypt_Base::OptimizedSalsa208Core(word32* InOut) const
+byte * ScryptScratchArena::Reserve(size_t Lanes,size_t LaneSize)
 {
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
-	if(HasSSE2())
-	{
-		Salsa208SSE((__m128i*)InOut);
-	}
+	if(LaneSize && Lanes > (size_t(0)-1)/LaneSize)
+		throw(InvalidArgument("scrypt: the lookup tables don't fit into the address space"));
+
+	// New() doesn't clear the memory, SMix writes every byte before reading it
+	if(m_Memory.size() < Lanes*LaneSize)
+		m_Memory.New(Lanes*LaneSize);
+	return m_Memory;
+}
+
+unsigned int scrypt_Base::GetMaxThreads() const
+{
+	const unsigned int PoolThreads = ThreadPool::GetGlobalPool().GetNumberThreads();
+	return (m_MaxThreads && m_MaxThreads < PoolThreads) ? m_MaxThreads : PoolThreads;
+}
+
+size_t scrypt_Base::MaxDerivedKeyLength() const
+{
+#if CRYPTOPP_BOOL_X64 == 1
+	return 0xffffffffUI64 * GetHash().DigestSize();
+#else
+	return 0xffffffffU;// should multiply by T::DIGESTSIZE, but gets overflow that way
+#endif
+}
+
+word64 scrypt_Base::MaxTCost() const
+{
+	const word64 Result = (0xffffffffUI64 >> (Log2R + 7)) * GetHash().DigestSize();
+	if(Result > word64((size_t(0)-1))) // prevent integer overflow
+		return word64(0)-1;
+	else
+		return Result;
+}
+
+size_t scrypt_Base::MaxConcurrentLanes(word64 tCost) const
+{
+	// the global pool may run fewer lanes at once, but its size is a property of the host
+	if(m_MaxThreads && m_MaxThreads < tCost)
+		return m_MaxThreads;
+	return tCost ? (size_t)STDMIN<word64>(tCost,size_t(0)-1) : 1;
+}
+
+size_t scrypt_Base::MaxMemoryUsage(word64 mCost, word64 tCost) const
+{
+	// every running lane needs 128*r*(N+2) bytes: the table of N blocks and two blocks of state, r=8 --> 1024*(N+2)
+	const size_t Threads = MaxConcurrentLanes(tCost);
+	if(mCost >= MaxMCost())
+		return size_t(0)-1;
+	const size_t LaneSize = ((size_t(1) << mCost)+2) << (Log2R+7);
+	if(LaneSize > (size_t(0)-1)/Threads)
+		return size_t(0)-1;
 	else
+		return Threads*LaneSize;
+}
+
+word64 scrypt_Base::GetMCostFromPeakNumberBytes(size_t PeakNumberBytes, word64 tCost) const
+{
+	PeakNumberBytes/=MaxConcurrentLanes(tCost); // every running lane has its own table
+
+	size_t NumberBlocks = PeakNumberBytes>>(Log2R+7); // reduction to N+2 blocks of 128r bytes
+	if(NumberBlocks<(1+2))
+		return 1; // minmal valid mCost
+	
+	NumberBlocks-=2; // the two blocks of state next to the table
+	word32 NumberShifts=0;
+	while(NumberBlocks!=1)
 	{
-#endif
-		Salsa208REF(InOut);
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE && !defined(DISABLE_SSE_LOCALLY)
+		NumberBlocks>>=1;
+		NumberShifts++;
 	}
-#endif
+	return NumberShifts;
 }
 
-/*void scrypt_Base::OptimizedSalsa208Core(word32* InOut) const
+word64 scrypt_Base::Integerify(const byte* State,word64 R,word64 N) const
 {
-#define CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE 1
-#if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
-	if(HasSSE2())
-	{*/
-		// the following function is mainly authored by Colin Percival
-		// He has placed this function in the public domain after request by Jean-Pierre Muench
-/*#define COPY_TO_SSE(k) \
-	__m128i I##k;\
-	I##k.m128i_u32[0]=X##k.m128i_u32[0]=InOut[(k)*4]; \
-	I##k.m128i_u32[1]=X##k.m128i_u32[1]=InOut[(k)*4+1]; \
-	I##k.m128i_u32[2]=X##k.m128i_u32[2]=InOut[(k)*4+2]; \
-	I##k.m128i_u32[3]=X##k.m128i_u32[3]=InOut[(k)*4+3];
-	
+	/*uint32_t * X = (word32 *)((uintptr_t)(State) + (2 * R - 1) * 64);
 
-	COPY_TO_SSE(0)
-	COPY_TO_SSE(1)
-	COPY_TO_SSE(2)
-	COPY_TO_SSE(3)
+	word64 Index = (((uint64_t)(X[1]) << 32) + X[0]);
 
+	return Index & (N-1);*/
+	const size_t AccessIndex = (R<<7)-64;
+	word64 Index = ConditionalByteReverse(LITTLE_ENDIAN_ORDER,*((word64*)(&State[AccessIndex]))) & ConditionalByteReverse(LITTLE_ENDIAN_ORDER,N-1);
+	return ConditionalByteReverse(LITTLE_ENDIAN_ORDER,Index); // revert if it was big-endian, so we get a proper access
+}
 
-#undef COPY_TO_SSE*/
-	/*__m128i* X = (__m128i*) InOut;
-	__m128i X0, X1, X2, X3;
-	__m128i T;
-	size_t i;*/
-	
-	/*X0=*((__m128i*)(&InOut[(0)*4]));
-	X1=*((__m128i*)(&InOut[(1)*4]));
-	X2=*((__m128i*)(&InOut[(2)*4]));
-	X3=*((__m128i*)(&InOut[(3)*4]));*/
-	/*X0=X[0];
-	X1=X[1];
-	X2=X[2];
-	X3=X[3];
-
-	for (i = 0; i < 8; i += 2) {*/
-		/* Operate on "columns". */
-		/*T = _mm_add_epi32(X0, X3);
-		X1 = _mm_xor_si128(X1, _mm_slli_epi32(T, 7));
-		X1 = _mm_xor_si128(X1, _mm_srli_epi32(T, 25));
-		T = _mm_add_epi32(X1, X0);
-		X2 = _mm_xor_si128(X2, _mm_slli_epi32(T, 9));
-		X2 = _mm_xor_si128(X2, _mm_srli_epi32(T, 23));
-		T = _mm_add_epi32(X2, X1);
-		X3 = _mm_xor_si128(X3, _mm_slli_epi32(T, 13));
-		X3 = _mm_xor_si128(X3, _mm_srli_epi32(T, 19));
-		T = _mm_add_epi32(X3, X2);
-		X0 = _mm_xor_si128(X0, _mm_slli_epi32(T, 18));
-		X0 = _mm_xor_si128(X0, _mm_srli_epi32(T, 14));*/
+void scrypt_Base::BlockMix(byte* Out,const byte* In,word64 R) const
+{
+	FixedSizeSecBlock<byte,64> BlockMixState;
+	memcpy_s(BlockMixState,64,&In[(R<<7)-64],64);
+	for(word64 j=0;j<(R<<1);j+=2) // perform double-rounds
+	{
+		// round 1:
+		xorbuf(BlockMixState,&In[j<<6],64);
+		OptimizedSalsa208Core((word32*)BlockMixState.BytePtr());
+		memcpy_s(&Out[j<<5],64,BlockMixState,64);
 
-		/* Rearrange data. */
-		/*X1 = _mm_shuffle_epi32(X1, 0x93);
-		X2 = _mm_shuffle_epi32(X2, 0x4E);
-		X3 = _mm_shuffle_epi32(X3, 0x39);*/
+		// round 2:
+		xorbuf(BlockMixState,&In[(j|1)<<6],64);
+		OptimizedSalsa208Core((word32*)BlockMixState.BytePtr());
+		memcpy_s(&Out[(j<<5)+(R<<6)],64,BlockMixState,64);
+	}
+}
 
-		/* Operate on "rows". */
-		/*T = _mm_add_epi32(X0, X1);
-		X3 = _mm_xor_si128(X3, _mm_slli_epi32(T, 7));
-		X3 = _mm_xor_si128(X3, _mm_srli_epi32(T, 25));
-		T = _mm_add_epi32(X3, X0);
-		X2 = _mm_xor_si128(X2, _mm_slli_epi32(T, 9));
-		X2 = _mm_xor_si128(X2, _mm_srli_epi32(T, 23));
-		T = _mm_add_epi32(X2, X3);
-		X1 = _mm_xor_si128(X1, _mm_slli_epi32(T, 13));
-		X1 = _mm_xor_si128(X1, _mm_srli_epi32(T, 19));
-		T = _mm_add_epi32(X1, X2);
-		X0 = _mm_xor_si128(X0, _mm_slli_epi32(T, 18));
-		X0 = _mm_xor_si128(X0, _mm_srli_epi32(T, 14));*/
+// worker i runs the lanes i, i+Workers, ... in its own part of the arena
+class scrypt_Base::SMixLoop : public ParallelLoopBody
+{
+public:
+	SMixLoop(const scrypt_Base &Parent,byte* Data,byte* Scratch,size_t ScratchSize,word64 Log2N,word64 R,word64 P,unsigned int Workers)
+		: m_Parent(Parent),m_Data(Data),m_Scratch(Scratch),m_ScratchSize(ScratchSize),m_Log2N(Log2N),m_R(R),m_P(P),m_Workers(Workers) {}
 
-		/* Rearrange data. */
-		/*X1 = _mm_shuffle_epi32(X1, 0x39);
-		X2 = _mm_shuffle_epi32(X2, 0x4E);
-		X3 = _mm_shuffle_epi32(X3, 0x93);
-	}*/
-
-	/**((__m128i*)(&InOut[(0)*4])) = _mm_add_epi32(*((__m128i*)(&InOut[(0)*4])), X0);
-	*((__m128i*)(&InOut[(1)*4])) = _mm_add_epi32(*((__m128i*)(&InOut[(1)*4])), X1);
-	*((__m128i*)(&InOut[(2)*4])) = _mm_add_epi32(*((__m128i*)(&InOut[(2)*4])), X2);
-	*((__m128i*)(&InOut[(3)*4])) = _mm_add_epi32(*((__m128i*)(&InOut[(3)*4])), X3);
-	X[0]=_mm_add_epi32(X[0], X0);
-	X[1]=_mm_add_epi32(X[1], X1);
-	X[2]=_mm_add_epi32(X[2], X2);
-	X[3]=_mm_add_epi32(X[3], X3);*/
-
-/*#define GET_FROM_SSE(k) \
-	InOut[(k)*4]=I##k.m128i_u32[0];\
-	InOut[(k)*4+1]=I##k.m128i_u32[1];\
-	InOut[(k)*4+2]=I##k.m128i_u32[2];\
-	InOut[(k)*4+3]=I##k.m128i_u32[3];
-
-	GET_FROM_SSE(0)
-	GET_FROM_SSE(1)
-	GET_FROM_SSE(2)
-	GET_FROM_SSE(3)
-#undef GET_FROM_SSE*/
-	/*}
-	else
+	void operator()(unsigned int Index)
 	{
-#endif
-#define R(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
-	   int i;
-	   word32 x[16];
-	   for (i = 0;i < 16;++i)
-		   x[i] = InOut[i];
-	   for (i = 8;i > 0;i -= 2) {
-		 x[ 4] ^= R(x[ 0]+x[12], 7);  x[ 8] ^= R(x[ 4]+x[ 0], 9);
-		 x[12] ^= R(x[ 8]+x[ 4],13);  x[ 0] ^= R(x[12]+x[ 8],18);
-		 x[ 9] ^= R(x[ 5]+x[ 1], 7);  x[13] ^= R(x[ 9]+x[ 5], 9);
-		 x[ 1] ^= R(x[13]+x[ 9],13);  x[ 5] ^= R(x[ 1]+x[13],18);
-		 x[14] ^= R(x[10]+x[ 6], 7);  x[ 2] ^= R(x[14]+x[10], 9);
-		 x[ 6] ^= R(x[ 2]+x[14],13);  x[10] ^= R(x[ 6]+x[ 2],18);
-		 x[ 3] ^= R(x[15]+x[11], 7);  x[ 7] ^= R(x[ 3]+x[15], 9);
-		 x[11] ^= R(x[ 7]+x[ 3],13);  x[15] ^= R(x[11]+x[ 7],18);
-		 x[ 1] ^= R(x[ 0]+x[ 3], 7);  x[ 2] ^= R(x[ 1]+x[ 0], 9);
-		 x[ 3] ^= R(x[ 2]+x[ 1],13);  x[ 0] ^= R(x[ 3]+x[ 2],18);
-		 x[ 6] ^= R(x[ 5]+x[ 4], 7);  x[ 7] ^= R(x[ 6]+x[ 5], 9);
-		 x[ 4] ^= R(x[ 7]+x[ 6],13);  x[ 5] ^= R(x[ 4]+x[ 7],18);
-		 x[11] ^= R(x[10]+x[ 9], 7);  x[ 8] ^= R(x[11]+x[10], 9);
-		 x[ 9] ^= R(x[ 8]+x[11],13);  x[10] ^= R(x[ 9]+x[ 8],18);
-		 x[12] ^= R(x[15]+x[14], 7);  x[13] ^= R(x[12]+x[15], 9);
-		 x[14] ^= R(x[13]+x[12],13);  x[15] ^= R(x[14]+x[13],18);
-	   }
-	   for (i = 0;i < 16;++i)
-		   InOut[i] += x[i];
-#undef R
+		for(word64 i=Index;i<m_P;i+=m_Workers)
+			m_Parent.SMix(m_Data+i*(m_R<<7),m_Log2N,m_R,m_Scratch+Index*m_ScratchSize);
+	}
+private:
+	const scrypt_Base &m_Parent;
+	byte* m_Data;
+	byte* m_Scratch;
+	size_t m_ScratchSize;
+	word64 m_Log2N,m_R,m_P;
+	unsigned int m_Workers;
+};
+
+void scrypt_Base::SMixLanes(byte* Data,word64 Log2N,word64 R,word64 P,ScryptScratchArena &Arena)const
+{
+	const unsigned int Workers = (unsigned int)STDMIN<word64>(P,GetMaxThreads());
+	const word64 LaneSize = ((1ui64<<Log2N)+2)*(R<<7);
+	if(LaneSize > size_t(0)-1)
+		throw(InvalidArgument("scrypt: the lookup table doesn't fit into the address space"));
+
+	SMixLoop Loop(*this,Data,Arena.Reserve(Workers,(size_t)LaneSize),(size_t)LaneSize,Log2N,R,P,Workers);
+	ThreadPool::GetGlobalPool().ParallelFor(Workers,Loop);
+}
+
+void scrypt_Base::SMix(byte* Data,word64 Log2N,word64 R,byte* Scratch)const
+{
 #if CRYPTOPP_BOOL_SSE2_INTRINSICS_AVAILABLE
-	} // ! HasSSE2()
+	if(HasSSE2())
+	{
+		SMixSSE2(Data,Log2N,(size_t)R,Scratch);
+		return;
+	}
 #endif
-}*/
 
-NAMESPACE_END
\ No newline at end of file
+	const size_t LocalDataLength = R << 7;
+
+	byte* LookupTable = Scratch;
+	byte* PrimaryState = Scratch+(1ui64<<Log2N)*LocalDataLength;
+	byte* SecondaryState = PrimaryState+LocalDataLength;
+	memcpy(PrimaryState,Data,LocalDataLength);
+
+	for(word64 i=0;i<(1ui64<<Log2N);i+=2)
+	{
+		memcpy(&LookupTable[i*LocalDataLength],PrimaryState,LocalDataLength);
+		BlockMix(SecondaryState,PrimaryState,R);
+
+		memcpy(&LookupTable[(i|1)*LocalDataLength],SecondaryState,LocalDataLength);
+		BlockMix(PrimaryState,SecondaryState,R);
+	}
+	for(word64 i=0;i<(1ui64<<Log2N);i+=2)
+	{
+		xorbuf(PrimaryState,&LookupTable[Integerify(PrimaryState,R,1ui64<<Log2N)*LocalDataLength],LocalDataLength);
+		BlockMix(SecondaryState,PrimaryState,R);
+
+		xorbuf(SecondaryState,&LookupTable[Integerify(SecondaryState,R,1ui64<<Log2N)*LocalDataLength],LocalDataLength);
+		BlockMix(PrimaryState,SecondaryState,R);
+	}
+	memcpy(Data,PrimaryState,LocalDataLength);
+}
+
+void scrypt_Base::OptimizedSalsa208Core(word32* InOut) const
+{
+	Salsa208REF(InOut);
+}
+
+NAMESPACE_END
@@ -8,7 +8,24 @@
 
 NAMESPACE_BEGIN(CryptoPP)
 
+//! scratch memory for the lookup tables of scrypt that is kept between derivations
+/*! A server deriving many keys can keep one arena per thread and so skips allocating
+	and wiping megabytes of memory for every derivation. The arena holds sensitive data
+	until it is destroyed or Release() is called. It may only be used by one derivation at a time. */
+class CRYPTOPP_DLL ScryptScratchArena : public NotCopyable
+{
+public:
+	//! returns Lanes consecutive areas of LaneSize bytes each, the contents are undefined
+	byte * Reserve(size_t Lanes,size_t LaneSize);
+	size_t SizeInBytes() const {return m_Memory.size();}
+	//! wipes and frees the memory
+	void Release() {m_Memory.resize(0);}
+private:
+	AlignedSecByteBlock m_Memory;
+};
+
 //! note: tCost = p, mCost = log_2(N) and r=8
+//! the p lanes run on the global ThreadPool, every lane running at the same time needs its own lookup table
 class CRYPTOPP_NO_VTABLE scrypt_Base : public PasswordBasedKeyDerivationFunction
 {
 public:
@@ -17,11 +34,23 @@ public:
 private:
 	CRYPTOPP_COMPILE_ASSERT(R == (1 << Log2R));
 public:
+	scrypt_Base() : m_MaxThreads(0) {}
+
+	//! limits the number of lanes running at the same time, 0 uses all threads of the global pool
+	void SetMaxThreads(unsigned int MaxThreads) {m_MaxThreads=MaxThreads;}
+	//! returns the number of lookup tables a derivation may need at the same time
+	unsigned int GetMaxThreads() const;
+
 	size_t MaxDerivedKeyLength() const;
 	word64 MaxMCost() const {return sizeof(size_t)*8-7-Log2R;} // needs 1024*N bytes, -> can address sizeof(size_t)*8 bytes at max but need those 1024 bytes
 	word64 MaxTCost() const;
-	size_t MaxMemoryUsage(word64 mCost) const;
-	word64 GetMCostFromPeakNumberBytes(size_t PeakNumberBytes) const;
+	//! memory of a derivation with a single lane, see the overload taking tCost
+	size_t MaxMemoryUsage(word64 mCost) const {return MaxMemoryUsage(mCost,1);}
+	//! memory of a derivation with tCost lanes, only SetMaxThreads() limits how many of them count so the result doesn't depend on the host
+	size_t MaxMemoryUsage(word64 mCost, word64 tCost) const;
+	word64 GetMCostFromPeakNumberBytes(size_t PeakNumberBytes) const {return GetMCostFromPeakNumberBytes(PeakNumberBytes,1);}
+	//! inverts MaxMemoryUsage(mCost,tCost)
+	word64 GetMCostFromPeakNumberBytes(size_t PeakNumberBytes, word64 tCost) const;
 	void DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 tCost, word64 mCost) const
 	{
 		DeriveKey(derived,derivedLen,password,passwordLen,salt,saltLen,mCost,R,tCost);
@@ -29,10 +58,18 @@ public:
 protected:
 	virtual void DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 Log2N, word64 R, word64 P) const =0;
 	virtual const HashTransformation& GetHash() const =0;
-	void SMix(byte* Data,size_t Offset,word64 Log2N,word64 R)const;
+	//! runs SMix on all P lanes of Data, the lookup tables are taken from Arena
+	void SMixLanes(byte* Data,word64 Log2N,word64 R,word64 P,ScryptScratchArena &Arena)const;
+	//! Scratch has to hold the lookup table and two states, (N+2)*128*R bytes
+	void SMix(byte* Data,word64 Log2N,word64 R,byte* Scratch)const;
 	void BlockMix(byte* Out,const byte* In,word64 R)const;
 	word64 Integerify(const byte* State,word64 R,word64 N)const;
 	void OptimizedSalsa208Core(word32* InOut) const;
+private:
+	class SMixLoop;
+	//! the number of the tCost lanes that may run at the same time on any host
+	size_t MaxConcurrentLanes(word64 tCost) const;
+	unsigned int m_MaxThreads;
 };
 
 template<class HASH>
@@ -40,8 +77,10 @@ class scrypt : public scrypt_Base
 {
 public:
 	void DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 Log2N, word64 R, word64 P) const;
-	static std::string StaticAlgorithmName() {return std::string("scrypt-HMAC-") + T::StaticAlgorithmName();}
-	std::string AlgorithmName() const {return std::string("scrypt-HMAC-") + m_hash.AlgorithmName();}
+	//! reuses the memory of Arena instead of allocating the lookup tables
+	void DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 Log2N, word64 R, word64 P, ScryptScratchArena &Arena) const;
+	static std::string StaticAlgorithmName() {return std::string("scrypt-HMAC-") + HASH::StaticAlgorithmName();}
+	std::string AlgorithmName() const {return std::string("scrypt-HMAC-") + m_InformationProvider.AlgorithmName();}
 private:
 	HASH m_InformationProvider;
 	const HashTransformation& GetHash() const {return m_InformationProvider;}
@@ -51,6 +90,13 @@ typedef scrypt<SHA256> OriginalScrypt;
 
 template<class HASH>
 void scrypt<HASH>::DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 Log2N, word64 R, word64 P) const
+{
+	ScryptScratchArena Arena;
+	DeriveKey(derived,derivedLen,password,passwordLen,salt,saltLen,Log2N,R,P,Arena);
+}
+
+template<class HASH>
+void scrypt<HASH>::DeriveKey(byte *derived, size_t derivedLen, const byte *password, size_t passwordLen, const byte *salt, size_t saltLen, word64 Log2N, word64 R, word64 P, ScryptScratchArena &Arena) const
 {
 	assert(Log2N!=0 && Log2N<=MaxMCost());
 	assert(R!=0 && R <= (word32(0)-1));
@@ -59,8 +105,7 @@ void scrypt<HASH>::DeriveKey(byte *derived, size_t derivedLen, const byte *passw
 
 	SecByteBlock ProcessingBuffer((P*R)<<7);
 	PKCS5_PBKDF2_HMAC<HASH>().DeriveKey(ProcessingBuffer,ProcessingBuffer.size(),password,passwordLen,salt,saltLen,1);
-	for(word64 i=0;i<P;++i)
-		SMix(ProcessingBuffer,i*(R<<7),Log2N,R);
+	SMixLanes(ProcessingBuffer,Log2N,R,P,Arena);
 	PKCS5_PBKDF2_HMAC<HASH>().DeriveKey(derived,derivedLen,password,passwordLen,ProcessingBuffer,ProcessingBuffer.size(),1);
 }
 
@@ -2,177 +2,293 @@
 
 #include "pch.h"
 #include "skein.h"
-#include "Threefish.h"
+#include "misc.h"
+#include "threadpool.h"
 
 NAMESPACE_BEGIN(CryptoPP)
 
-Skein_Main_Provider::UBI::UBI(unsigned int Blocksize,TypeValues TypeValue,const byte* InitialState) :
-m_TypeValue(TypeValue),m_Blocksize(Blocksize),m_State(InitialState,m_Blocksize),m_LowerCounter(0),m_UpperCounter(0)
+// UBI is Threefish in a Matyas-Meyer-Oseas chain, the chaining value is the key of the next block.
+// Going through Threefish_x::Encryption would mean a virtual SetKey() and byte shuffling for every block,
+// so the key schedule is computed here directly and injected into the registers while the rounds run.
+
+#define KeyScheduleConst W64LIT(0x1BD11BDAA9FC1A22)
+
+#define SKEIN_FIRST_FLAG W64LIT(0x4000000000000000)
+#define SKEIN_FINAL_FLAG W64LIT(0x8000000000000000)
+
+#define SKEIN_MIX(a,b,r) X##a += X##b; X##b = rotlFixed(X##b,r) ^ X##a;
+
+#define SKEIN256_INJECT(s) \
+	X0 += ks[((s)+0)%5]; X1 += ks[((s)+1)%5] + ts[(s)%3]; \
+	X2 += ks[((s)+2)%5] + ts[((s)+1)%3]; X3 += ks[((s)+3)%5] + (s);
+
+#define SKEIN256_8_ROUNDS(s) \
+	SKEIN_MIX(0,1,14) SKEIN_MIX(2,3,16) SKEIN_MIX(0,3,52) SKEIN_MIX(2,1,57) \
+	SKEIN_MIX(0,1,23) SKEIN_MIX(2,3,40) SKEIN_MIX(0,3,5) SKEIN_MIX(2,1,37) \
+	SKEIN256_INJECT((s)+1) \
+	SKEIN_MIX(0,1,25) SKEIN_MIX(2,3,33) SKEIN_MIX(0,3,46) SKEIN_MIX(2,1,12) \
+	SKEIN_MIX(0,1,58) SKEIN_MIX(2,3,22) SKEIN_MIX(0,3,32) SKEIN_MIX(2,1,32) \
+	SKEIN256_INJECT((s)+2)
+
+#define SKEIN512_INJECT(s) \
+	X0 += ks[((s)+0)%9]; X1 += ks[((s)+1)%9]; X2 += ks[((s)+2)%9]; X3 += ks[((s)+3)%9]; \
+	X4 += ks[((s)+4)%9]; X5 += ks[((s)+5)%9] + ts[(s)%3]; \
+	X6 += ks[((s)+6)%9] + ts[((s)+1)%3]; X7 += ks[((s)+7)%9] + (s);
+
+#define SKEIN512_8_ROUNDS(s) \
+	SKEIN_MIX(0,1,46) SKEIN_MIX(2,3,36) SKEIN_MIX(4,5,19) SKEIN_MIX(6,7,37) \
+	SKEIN_MIX(2,1,33) SKEIN_MIX(4,7,27) SKEIN_MIX(6,5,14) SKEIN_MIX(0,3,42) \
+	SKEIN_MIX(4,1,17) SKEIN_MIX(6,3,49) SKEIN_MIX(0,5,36) SKEIN_MIX(2,7,39) \
+	SKEIN_MIX(6,1,44) SKEIN_MIX(0,7,9) SKEIN_MIX(2,5,54) SKEIN_MIX(4,3,56) \
+	SKEIN512_INJECT((s)+1) \
+	SKEIN_MIX(0,1,39) SKEIN_MIX(2,3,30) SKEIN_MIX(4,5,34) SKEIN_MIX(6,7,24) \
+	SKEIN_MIX(2,1,13) SKEIN_MIX(4,7,50) SKEIN_MIX(6,5,10) SKEIN_MIX(0,3,17) \
+	SKEIN_MIX(4,1,25) SKEIN_MIX(6,3,29) SKEIN_MIX(0,5,39) SKEIN_MIX(2,7,43) \
+	SKEIN_MIX(6,1,8) SKEIN_MIX(0,7,35) SKEIN_MIX(2,5,56) SKEIN_MIX(4,3,22) \
+	SKEIN512_INJECT((s)+2)
+
+#define SKEIN1024_INJECT(s) \
+	X0 += ks[((s)+0)%17]; X1 += ks[((s)+1)%17]; X2 += ks[((s)+2)%17]; X3 += ks[((s)+3)%17]; \
+	X4 += ks[((s)+4)%17]; X5 += ks[((s)+5)%17]; X6 += ks[((s)+6)%17]; X7 += ks[((s)+7)%17]; \
+	X8 += ks[((s)+8)%17]; X9 += ks[((s)+9)%17]; X10 += ks[((s)+10)%17]; X11 += ks[((s)+11)%17]; \
+	X12 += ks[((s)+12)%17]; X13 += ks[((s)+13)%17] + ts[(s)%3]; \
+	X14 += ks[((s)+14)%17] + ts[((s)+1)%3]; X15 += ks[((s)+15)%17] + (s);
+
+#define SKEIN1024_8_ROUNDS(s) \
+	SKEIN_MIX(0,1,24) SKEIN_MIX(2,3,13) SKEIN_MIX(4,5,8) SKEIN_MIX(6,7,47) \
+	SKEIN_MIX(8,9,8) SKEIN_MIX(10,11,17) SKEIN_MIX(12,13,22) SKEIN_MIX(14,15,37) \
+	SKEIN_MIX(0,9,38) SKEIN_MIX(2,13,19) SKEIN_MIX(6,11,10) SKEIN_MIX(4,15,55) \
+	SKEIN_MIX(10,7,49) SKEIN_MIX(12,3,18) SKEIN_MIX(14,5,23) SKEIN_MIX(8,1,52) \
+	SKEIN_MIX(0,7,33) SKEIN_MIX(2,5,4) SKEIN_MIX(4,3,51) SKEIN_MIX(6,1,13) \
+	SKEIN_MIX(12,15,34) SKEIN_MIX(14,13,41) SKEIN_MIX(8,11,59) SKEIN_MIX(10,9,17) \
+	SKEIN_MIX(0,15,5) SKEIN_MIX(2,11,20) SKEIN_MIX(6,13,48) SKEIN_MIX(4,9,41) \
+	SKEIN_MIX(14,1,47) SKEIN_MIX(8,5,28) SKEIN_MIX(10,3,16) SKEIN_MIX(12,7,25) \
+	SKEIN1024_INJECT((s)+1) \
+	SKEIN_MIX(0,1,41) SKEIN_MIX(2,3,9) SKEIN_MIX(4,5,37) SKEIN_MIX(6,7,31) \
+	SKEIN_MIX(8,9,12) SKEIN_MIX(10,11,47) SKEIN_MIX(12,13,44) SKEIN_MIX(14,15,30) \
+	SKEIN_MIX(0,9,16) SKEIN_MIX(2,13,34) SKEIN_MIX(6,11,56) SKEIN_MIX(4,15,51) \
+	SKEIN_MIX(10,7,4) SKEIN_MIX(12,3,53) SKEIN_MIX(14,5,42) SKEIN_MIX(8,1,41) \
+	SKEIN_MIX(0,7,31) SKEIN_MIX(2,5,44) SKEIN_MIX(4,3,47) SKEIN_MIX(6,1,46) \
+	SKEIN_MIX(12,15,19) SKEIN_MIX(14,13,42) SKEIN_MIX(8,11,44) SKEIN_MIX(10,9,25) \
+	SKEIN_MIX(0,15,9) SKEIN_MIX(2,11,48) SKEIN_MIX(6,13,35) SKEIN_MIX(4,9,52) \
+	SKEIN_MIX(14,1,23) SKEIN_MIX(8,5,31) SKEIN_MIX(10,3,37) SKEIN_MIX(12,7,20) \
+	SKEIN1024_INJECT((s)+2)
+
+// the tweak counts the bytes processed so far including the current block
+static inline void SkeinIncrementTweak(word64* Tweak,word64 ByteCountAdd)
 {
-	switch (m_Blocksize)
+	Tweak[0] += ByteCountAdd;
+	Tweak[1] += (Tweak[0] < ByteCountAdd);
+}
+
+static void Skein256_ProcessBlocks(word64* Chain,word64* Tweak,const byte* input,size_t Blocks,word64 ByteCountAdd)
+{
+	word64 ks[5],ts[3];
+	word64 w0,w1,w2,w3;
+	word64 X0,X1,X2,X3;
+
+	for(;Blocks;--Blocks,input+=32)
+	{
+		SkeinIncrementTweak(Tweak,ByteCountAdd);
+		ks[0]=Chain[0];ks[1]=Chain[1];ks[2]=Chain[2];ks[3]=Chain[3];
+		ks[4]=KeyScheduleConst^ks[0]^ks[1]^ks[2]^ks[3];
+		ts[0]=Tweak[0];ts[1]=Tweak[1];ts[2]=ts[0]^ts[1];
+
+		w0=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,input);
+		w1=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,input+8);
+		w2=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,input+16);
+		w3=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,input+24);
+
+		X0=w0;X1=w1;X2=w2;X3=w3;
+		SKEIN256_INJECT(0)
+		SKEIN256_8_ROUNDS(0) SKEIN256_8_ROUNDS(2) SKEIN256_8_ROUNDS(4)
+		SKEIN256_8_ROUNDS(6) SKEIN256_8_ROUNDS(8) SKEIN256_8_ROUNDS(10)
+		SKEIN256_8_ROUNDS(12) SKEIN256_8_ROUNDS(14) SKEIN256_8_ROUNDS(16)
+
+		Chain[0]=X0^w0;Chain[1]=X1^w1;Chain[2]=X2^w2;Chain[3]=X3^w3;
+		Tweak[1] &= ~SKEIN_FIRST_FLAG;
+	}
+}
+
+static void Skein512_ProcessBlocks(word64* Chain,word64* Tweak,const byte* input,size_t Blocks,word64 ByteCountAdd)
+{
+	word64 ks[9],ts[3],w[8];
+	word64 X0,X1,X2,X3,X4,X5,X6,X7;
+
+	for(;Blocks;--Blocks,input+=64)
+	{
+		SkeinIncrementTweak(Tweak,ByteCountAdd);
+		ks[8]=KeyScheduleConst;
+		for(unsigned int i=0;i<8;++i)
+		{
+			ks[i]=Chain[i];
+			ks[8]^=ks[i];
+			w[i]=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,input+8*i);
+		}
+		ts[0]=Tweak[0];ts[1]=Tweak[1];ts[2]=ts[0]^ts[1];
+
+		X0=w[0];X1=w[1];X2=w[2];X3=w[3];X4=w[4];X5=w[5];X6=w[6];X7=w[7];
+		SKEIN512_INJECT(0)
+		SKEIN512_8_ROUNDS(0) SKEIN512_8_ROUNDS(2) SKEIN512_8_ROUNDS(4)
+		SKEIN512_8_ROUNDS(6) SKEIN512_8_ROUNDS(8) SKEIN512_8_ROUNDS(10)
+		SKEIN512_8_ROUNDS(12) SKEIN512_8_ROUNDS(14) SKEIN512_8_ROUNDS(16)
+
+		Chain[0]=X0^w[0];Chain[1]=X1^w[1];Chain[2]=X2^w[2];Chain[3]=X3^w[3];
+		Chain[4]=X4^w[4];Chain[5]=X5^w[5];Chain[6]=X6^w[6];Chain[7]=X7^w[7];
+		Tweak[1] &= ~SKEIN_FIRST_FLAG;
+	}
+}
+
+static void Skein1024_ProcessBlocks(word64* Chain,word64* Tweak,const byte* input,size_t Blocks,word64 ByteCountAdd)
+{
+	word64 ks[17],ts[3],w[16];
+	word64 X0,X1,X2,X3,X4,X5,X6,X7,X8,X9,X10,X11,X12,X13,X14,X15;
+
+	for(;Blocks;--Blocks,input+=128)
+	{
+		SkeinIncrementTweak(Tweak,ByteCountAdd);
+		ks[16]=KeyScheduleConst;
+		for(unsigned int i=0;i<16;++i)
+		{
+			ks[i]=Chain[i];
+			ks[16]^=ks[i];
+			w[i]=GetWord<word64>(false,LITTLE_ENDIAN_ORDER,input+8*i);
+		}
+		ts[0]=Tweak[0];ts[1]=Tweak[1];ts[2]=ts[0]^ts[1];
+
+		X0=w[0];X1=w[1];X2=w[2];X3=w[3];X4=w[4];X5=w[5];X6=w[6];X7=w[7];
+		X8=w[8];X9=w[9];X10=w[10];X11=w[11];X12=w[12];X13=w[13];X14=w[14];X15=w[15];
+		SKEIN1024_INJECT(0)
+		SKEIN1024_8_ROUNDS(0) SKEIN1024_8_ROUNDS(2) SKEIN1024_8_ROUNDS(4)
+		SKEIN1024_8_ROUNDS(6) SKEIN1024_8_ROUNDS(8) SKEIN1024_8_ROUNDS(10)
+		SKEIN1024_8_ROUNDS(12) SKEIN1024_8_ROUNDS(14) SKEIN1024_8_ROUNDS(16)
+		SKEIN1024_8_ROUNDS(18)
+
+		Chain[0]=X0^w[0];Chain[1]=X1^w[1];Chain[2]=X2^w[2];Chain[3]=X3^w[3];
+		Chain[4]=X4^w[4];Chain[5]=X5^w[5];Chain[6]=X6^w[6];Chain[7]=X7^w[7];
+		Chain[8]=X8^w[8];Chain[9]=X9^w[9];Chain[10]=X10^w[10];Chain[11]=X11^w[11];
+		Chain[12]=X12^w[12];Chain[13]=X13^w[13];Chain[14]=X14^w[14];Chain[15]=X15^w[15];
+		Tweak[1] &= ~SKEIN_FIRST_FLAG;
+	}
+}
+
+static void Skein_ProcessBlocks(unsigned int Blocksize,word64* Chain,word64* Tweak,const byte* input,size_t Blocks,word64 ByteCountAdd)
+{
+	switch(Blocksize)
 	{
 	case 32:
-		m_Threefish.reset(new Threefish_256::Encryption());
+		Skein256_ProcessBlocks(Chain,Tweak,input,Blocks,ByteCountAdd);
 		break;
 	case 64:
-		m_Threefish.reset(new Threefish_512::Encryption());
+		Skein512_ProcessBlocks(Chain,Tweak,input,Blocks,ByteCountAdd);
 		break;
 	case 128:
-		m_Threefish.reset(new Threefish_1024::Encryption());
+		Skein1024_ProcessBlocks(Chain,Tweak,input,Blocks,ByteCountAdd);
 		break;
 	}
 }
 
+Skein_Main_Provider::UBI::UBI(unsigned int Blocksize,TypeValues TypeValue,const byte* InitialState) :
+m_TypeValue(TypeValue),m_Blocksize(Blocksize)
+{
+	Restart(InitialState);
+}
+
+void Skein_Main_Provider::UBI::ProcessBlocks(const byte* input, size_t Blocks, word64 ByteCountAdd)
+{
+	// only the lower 32 bits of the second tweak word belong to the position
+	const word64 Length = word64(Blocks-1)*m_Blocksize+ByteCountAdd;
+	if(word32(m_Tweak[1])==0xffffffff && m_Tweak[0]+Length<m_Tweak[0])
+		throw(InvalidArgument("input string too long (longer than 96-bits)"));
+
+	Skein_ProcessBlocks(m_Blocksize,m_State,m_Tweak,input,Blocks,ByteCountAdd);
+}
+
 void Skein_Main_Provider::UBI::Update(const byte* input, size_t length)
 {
-	if(m_BufferForNextBlock.SizeInBytes() + length <= m_Blocksize)
-	{
-		if(m_BufferForNextBlock.SizeInBytes() + length <= m_BufferForNextBlock.SizeInBytes()) // counter buffer-/integeroverflows
-			return;
-		const size_t OldSize = m_BufferForNextBlock.SizeInBytes();
-		m_BufferForNextBlock.CleanGrow(OldSize+length);
-		memcpy(&m_BufferForNextBlock.BytePtr()[OldSize],input,length);
+	if(!length)
+		return;
 
+	// the last block is held back, it needs the final flag if no more input follows
+	if(m_BufferLength + length <= m_Blocksize)
+	{
+		memcpy(m_BufferForNextBlock+m_BufferLength,input,length);
+		m_BufferLength += length;
 		return;
 	}
 
-	// process buffered data first
-	SecByteBlock Buffer(m_Blocksize);
-	memcpy(Buffer,m_BufferForNextBlock,m_BufferForNextBlock.SizeInBytes());
-	const size_t ToCopy = m_Blocksize - m_BufferForNextBlock.SizeInBytes();
-	memcpy(&Buffer.BytePtr()[m_BufferForNextBlock.SizeInBytes()],input,m_Blocksize - m_BufferForNextBlock.SizeInBytes());
-	input += m_Blocksize - m_BufferForNextBlock.SizeInBytes();
-	length -= m_Blocksize - m_BufferForNextBlock.SizeInBytes();
-
-	word32 TweakFlags=0;
-	TweakFlags |= word32(m_TypeValue) <<24; // msg flag
-	if(m_LowerCounter==0&&m_UpperCounter==0)
-		TweakFlags |= 1ui32 << 30; // first block flag
-
-	IncrementCounters(m_Blocksize);
-	FixedSizeSecBlock<byte,16> Tweak;
-	memset_z(Tweak,0,16);
-	memcpy(&Tweak.BytePtr()[0],(const byte*)&m_LowerCounter,sizeof(m_LowerCounter));
-	memcpy(&Tweak.BytePtr()[8],(const byte*)&m_UpperCounter,sizeof(m_UpperCounter));
-	memcpy(&Tweak.BytePtr()[12],(const byte*)&TweakFlags,sizeof(TweakFlags));
-	/*ConditionalByteReverse(LITTLE_ENDIAN_ORDER,);
-	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,);
-	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,);*/
-
-	m_Threefish->SetKey(m_State,m_Blocksize);
-	m_Threefish->ProcessAndXorBlockWithTweak(Buffer,Buffer,m_State,Tweak,16);
-
-	while(length > m_Blocksize)
+	if(m_BufferLength)
 	{
-		word32 Flags=0;
-		Flags |= word32(m_TypeValue) <<24; // msg flag
-
-		IncrementCounters(m_Blocksize);
-		FixedSizeSecBlock<byte,16> NewTweak;
-		memset_z(NewTweak,0,16);
-		memcpy(&NewTweak.BytePtr()[0],(const byte*)&m_LowerCounter,sizeof(m_LowerCounter));
-		memcpy(&NewTweak.BytePtr()[8],(const byte*)&m_UpperCounter,sizeof(m_UpperCounter));
-		memcpy(&NewTweak.BytePtr()[12],(const byte*)&Flags,sizeof(Flags));
-		/*ConditionalByteReverse(LITTLE_ENDIAN_ORDER,&NewTweak.BytePtr()[0],(const byte*)&m_LowerCounter,sizeof(m_LowerCounter));
-		ConditionalByteReverse(LITTLE_ENDIAN_ORDER,&NewTweak.BytePtr()[8],(const byte*)&m_UpperCounter,sizeof(m_UpperCounter));
-		ConditionalByteReverse(LITTLE_ENDIAN_ORDER,&NewTweak.BytePtr()[12],(const byte*)&Flags,sizeof(Flags));*/
-
-		m_Threefish->SetKey(m_State,m_Blocksize);
-		m_Threefish->ProcessAndXorBlockWithTweak(input,input,m_State,NewTweak,16);
-
-		input += m_Blocksize;
-		length -= m_Blocksize;
+		const size_t ToCopy = m_Blocksize - m_BufferLength;
+		memcpy(m_BufferForNextBlock+m_BufferLength,input,ToCopy);
+		ProcessBlocks(m_BufferForNextBlock,1,m_Blocksize);
+		input += ToCopy;
+		length -= ToCopy;
+	}
+
+	if(length > m_Blocksize)
+	{
+		const size_t Blocks = (length-1)/m_Blocksize;
+		ProcessBlocks(input,Blocks,m_Blocksize);
+		input += Blocks*m_Blocksize;
+		length -= Blocks*m_Blocksize;
 	}
 
-	m_BufferForNextBlock.CleanNew(length);
 	memcpy(m_BufferForNextBlock,input,length);
+	m_BufferLength = length;
 }
 
 void Skein_Main_Provider::UBI::TruncatedFinal(byte *hash, size_t size)
 {
 	ThrowIfInvalidTruncatedSize(size);
 
-	SecByteBlock LastBlock(m_Blocksize);
-	memset_z(LastBlock,0,m_Blocksize);
-	memcpy_s(LastBlock,m_Blocksize,m_BufferForNextBlock,m_BufferForNextBlock.SizeInBytes());
-
-	word32 TweakFlags=0;
-	TweakFlags |= word32(m_TypeValue) <<24; // msg flag
-	TweakFlags |= 1ui32 << 31; // last block flag
-	if(m_LowerCounter==0&&m_UpperCounter==0)
-		TweakFlags |= 1ui32 << 30; // first block flag
+	memset_z(m_BufferForNextBlock+m_BufferLength,0,m_Blocksize-m_BufferLength);
+	m_Tweak[1] |= SKEIN_FINAL_FLAG;
+	ProcessBlocks(m_BufferForNextBlock,1,m_BufferLength);
 
-	IncrementCounters(m_BufferForNextBlock.SizeInBytes());
-	m_BufferForNextBlock.CleanNew(0);
-
-	FixedSizeSecBlock<byte,16> Tweak;
-	memset_z(Tweak,0,16);
-	memcpy(&Tweak.BytePtr()[0],(const byte*)&m_LowerCounter,sizeof(m_LowerCounter));
-	memcpy(&Tweak.BytePtr()[8],(const byte*)&m_UpperCounter,sizeof(m_UpperCounter));
-	memcpy(&Tweak.BytePtr()[12],(const byte*)&TweakFlags,sizeof(TweakFlags));
-
-	m_Threefish->SetKey(m_State,m_Blocksize);
-	m_Threefish->ProcessAndXorBlockWithTweak(LastBlock,LastBlock,m_State,Tweak,16);
+	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,m_State.data(),m_State.data(),m_Blocksize);
 	memcpy(hash,m_State,size);
 	Restart();
 }
 
 void Skein_Main_Provider::UBI::OutTransformation(byte* OutReceiver,const size_t OutputSize,const byte* State)
 {
-	// output transformation now
+	// output transformation now, every output block is an UBI of its 8-byte counter
+	FixedSizeSecBlock<word64,16> Key;
+	FixedSizeSecBlock<word64,16> Chain;
+	FixedSizeSecBlock<word64,2> Tweak;
+	FixedSizeSecBlock<byte,128> CounterBlock;
 
-	SecByteBlock LocalState(State,m_Blocksize);
-
-	m_Threefish->SetKey(LocalState,m_Blocksize);
-	word32 OutputTweakFlags=0;
-	OutputTweakFlags |= 63ui32 <<24; // out flag
-	OutputTweakFlags |= 1ui32 << 30; // first block flag
-	OutputTweakFlags |= 1ui32 << 31; // last block flag
-	FixedSizeSecBlock<byte,16> OutTweak;
-	memset_z(OutTweak,0,16);
-	
-	SecByteBlock OutputBlock(m_Blocksize);
-	word64 OutputCounter = 0;
+	GetUserKey(LITTLE_ENDIAN_ORDER,Key.data(),m_Blocksize/8,State,m_Blocksize);
+	memset_z(CounterBlock,0,m_Blocksize);
 
-	const word32 OutUBISize = sizeof(OutputCounter);
-	memcpy(&OutTweak.BytePtr()[0],(const byte*)&OutUBISize,sizeof(OutUBISize));
-	memcpy(&OutTweak.BytePtr()[12],(const byte*)&OutputTweakFlags,sizeof(OutputTweakFlags));
-
-	for(word64 i=0;i<(OutputSize/m_Blocksize);++i)
+	for(word64 OutputCounter=0;OutputCounter*m_Blocksize<OutputSize;++OutputCounter)
 	{
-		memset_z(OutputBlock,0,m_Blocksize);
-		ConditionalByteReverse(LITTLE_ENDIAN_ORDER,OutputBlock.BytePtr(),(const byte*)&OutputCounter,sizeof(OutputCounter));
-
-		m_Threefish->ProcessAndXorBlockWithTweak(OutputBlock,NULL,OutReceiver + OutputCounter*m_Blocksize,OutTweak,16);
-		++OutputCounter;
-	}
-	SecByteBlock LastDigestBlockBuffer(m_Blocksize);
+		memcpy(Chain,Key,m_Blocksize);
+		Tweak[0]=0;
+		Tweak[1]=(word64(OUT)<<56)|SKEIN_FIRST_FLAG|SKEIN_FINAL_FLAG;
+		PutWord(false,LITTLE_ENDIAN_ORDER,CounterBlock.data(),OutputCounter);
 
-	memset_z(OutputBlock,0,m_Blocksize);
-	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,OutputBlock.BytePtr(),(const byte*)&OutputCounter,sizeof(OutputCounter));
+		Skein_ProcessBlocks(m_Blocksize,Chain,Tweak,CounterBlock,1,sizeof(OutputCounter));
 
-	m_Threefish->ProcessAndXorBlockWithTweak(OutputBlock,NULL,LastDigestBlockBuffer,OutTweak,16);
-	memcpy(OutReceiver + OutputCounter*m_Blocksize,LastDigestBlockBuffer,OutputSize-OutputCounter*m_Blocksize);
+		ConditionalByteReverse(LITTLE_ENDIAN_ORDER,Chain.data(),Chain.data(),m_Blocksize);
+		memcpy(OutReceiver + OutputCounter*m_Blocksize,Chain,STDMIN<size_t>(m_Blocksize,OutputSize-OutputCounter*m_Blocksize));
+	}
 }
 
 void Skein_Main_Provider::UBI::Restart()
 {
-	m_BufferForNextBlock.CleanNew(0);
-	memset_z(m_State,0,m_State.size());
+	m_BufferLength=0;
+	memset_z(m_State,0,m_State.SizeInBytes());
 
-	m_LowerCounter=0;
-	m_UpperCounter=0;
+	m_Tweak[0]=0;
+	m_Tweak[1]=(word64(m_TypeValue)<<56)|SKEIN_FIRST_FLAG;
 }
 
-void Skein_Main_Provider::UBI::IncrementCounters(size_t n)
+void Skein_Main_Provider::UBI::Restart(const byte* InitialState)
 {
-	const word64 OldLower = m_LowerCounter;
-	const word32 OldUpper = m_UpperCounter;
-	m_LowerCounter+=n;
-	if(m_LowerCounter<OldLower)
-		m_UpperCounter++;
-	if(m_UpperCounter<OldUpper)
-		throw(InvalidArgument("input string too long (longer than 96-bits)"));
+	Restart();
+	GetUserKey(LITTLE_ENDIAN_ORDER,m_State.data(),m_Blocksize/8,InitialState,m_Blocksize);
 }
 
 void Skein_Main_Provider::Skein_Base::KeyUBI(const byte* Key,size_t Keylength)
@@ -188,9 +304,17 @@ void Skein_Main_Provider::Skein_Base::TruncatedFinalMsgUBI(byte *hash, size_t si
 {
 	assert(size<=m_OutputLength);
 	if(m_MsgUBI.get())
+	{
 		m_MsgUBI->Final(m_State);
-	UBI(m_BlockSize,UBI::OUT,m_State).OutTransformation(hash,size,m_State);
-	ApplyAllSettings();
+		m_MsgUBI->OutTransformation(hash,size,m_State);
+		// settings only change on Restart(), so the next message starts from the cached chaining value
+		m_MsgUBI->Restart(m_InitialState);
+	}
+	else
+	{
+		UBI(m_BlockSize,UBI::OUT,m_State).OutTransformation(hash,size,m_State);
+		ApplyAllSettings();
+	}
 }
 
 void Skein_Main_Provider::Skein_Base::RestartUBI()
@@ -217,6 +341,7 @@ void Skein_Main_Provider::Skein_Base::ApplyAllSettings()
 	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,ConfigBlock.BytePtr(),(const byte*)&Literal,sizeof(word32));
 	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,&ConfigBlock.BytePtr()[4],(const byte*)&VersionNumber,sizeof(word16));
 	ConditionalByteReverse(LITTLE_ENDIAN_ORDER,&ConfigBlock.BytePtr()[8],(const byte*)&DigestSize,sizeof(word64));
+	PutWord(false,LITTLE_ENDIAN_ORDER,&ConfigBlock.BytePtr()[16],m_TreeInfo);
 
 	UBI(m_BlockSize,UBI::CFG,m_State).CalculateDigest(m_State,ConfigBlock,ConfigBlock.SizeInBytes());
 	
@@ -225,7 +350,7 @@ void Skein_Main_Provider::Skein_Base::ApplyAllSettings()
 		UBI(m_BlockSize,UBI::PRS,m_State).CalculateDigest(m_State,m_PersonalizationString,m_PersonalizationString.SizeInBytes());
 
 	// incorporate public key
-	if(m_PersonalizationString.SizeInBytes())
+	if(m_PublicKey.SizeInBytes())
 		UBI(m_BlockSize,UBI::PK,m_State).CalculateDigest(m_State,m_PublicKey,m_PublicKey.SizeInBytes());
 
 	// use key identifier
@@ -237,7 +362,11 @@ void Skein_Main_Provider::Skein_Base::ApplyAllSettings()
 		UBI(m_BlockSize,UBI::NON,m_State).CalculateDigest(m_State,m_Nonce,m_Nonce.SizeInBytes());
 
 	// set up messsage UBI instance
-	m_MsgUBI.reset(new UBI(m_BlockSize,UBI::MSG,m_State));
+	memcpy_s(m_InitialState,m_InitialState.SizeInBytes(),m_State,m_BlockSize);
+	if(m_MsgUBI.get())
+		m_MsgUBI->Restart(m_InitialState);
+	else
+		m_MsgUBI.reset(new UBI(m_BlockSize,UBI::MSG,m_InitialState));
 }
 
 Skein_Main_Provider::Hash::Hash(const unsigned int DigestSize,unsigned int BlockSize) :
@@ -317,7 +446,7 @@ Skein_Main_Provider::SignatureHash::SignatureHash(const byte* PublicKey,size_t K
 }
 
 Skein_Main_Provider::KDF::KDF(const byte* Key,size_t keylength,const byte* KeyIdentifier,size_t IDsize,const unsigned int DerivedKeyLen,unsigned int BlockSize) :
-	m_DerivedLength(DerivedKeyLen)
+	m_Blocksize(BlockSize),m_DerivedLength(DerivedKeyLen)
 {
 	if(m_Blocksize!=32 && m_Blocksize!=64 && m_Blocksize!=128)
 		m_Blocksize=0;
@@ -344,6 +473,193 @@ Skein_Main_Provider::KDF::KDF(const byte* Key,size_t keylength,const byte* KeyId
 	ApplyAllSettings();
 }
 
+Skein_Main_Provider::Tree::Tree(const unsigned int DigestSize,byte LeafSize,byte FanOut,byte MaxHeight,unsigned int BlockSize) :
+	m_DigestSize(DigestSize),m_Blocksize(BlockSize),m_LeafSize(LeafSize),m_FanOut(FanOut),m_MaxHeight(MaxHeight)
+{
+	if(!m_LeafSize || m_LeafSize>56 || !m_FanOut || m_FanOut>56 || m_MaxHeight<2)
+		throw(InvalidArgument("Skein-Tree: leaf size and fan-out have to be in [1,56] and the maximum height at least 2"));
+
+	if(m_Blocksize!=32 && m_Blocksize!=64 && m_Blocksize!=128)
+		m_Blocksize=0;
+
+	if(!m_Blocksize)
+	{
+		// use Threefish-256 only for Digests < 256 bits
+		// use Threefish-512 for Digests d with 256 <= d <= 512
+		// use Threefish-1024 for the rest
+		if(m_DigestSize<32)
+			m_Blocksize=32;
+		else if(m_DigestSize<=64)
+			m_Blocksize=64;
+		else
+			m_Blocksize=128;
+	}
+	m_LeafLength = word64(m_Blocksize)<<m_LeafSize;
+
+	ConfigUBI(m_DigestSize,m_Blocksize);
+	ConfigTree(m_LeafSize,m_FanOut,m_MaxHeight);
+
+	Restart();
+}
+
+void Skein_Main_Provider::Tree::Restart()
+{
+	ApplyAllSettings();
+
+	if(m_Leaf.get())
+		m_Leaf->Restart(GetInitialState());
+	else
+		m_Leaf.reset(new UBI(m_Blocksize,UBI::MSG,GetInitialState()));
+	m_Leaf->SetTreePosition(0,1);
+	m_LeafFill=0;
+	m_Leaves=0;
+	m_Levels.clear();
+}
+
+void Skein_Main_Provider::Tree::Update(const byte *input, size_t length)
+{
+	if(m_LeafFill)
+	{
+		const size_t ToCopy = static_cast<size_t>(STDMIN<word64>(m_LeafLength-m_LeafFill,length));
+		m_Leaf->Update(input,ToCopy);
+		m_LeafFill += ToCopy;
+		input += ToCopy;
+		length -= ToCopy;
+		if(m_LeafFill==m_LeafLength)
+			FinishLeaf();
+	}
+
+	if(length>=m_LeafLength)
+	{
+		const size_t Leaves = static_cast<size_t>(length/m_LeafLength);
+		HashLeaves(input,Leaves);
+		input += Leaves*m_LeafLength;
+		length -= static_cast<size_t>(Leaves*m_LeafLength);
+	}
+
+	if(length)
+	{
+		m_Leaf->Update(input,length);
+		m_LeafFill += length;
+	}
+}
+
+void Skein_Main_Provider::Tree::TruncatedFinal(byte *hash, size_t size)
+{
+	ThrowIfInvalidTruncatedSize(size);
+
+	// the empty message still has one (empty) leaf
+	if(m_LeafFill || !m_Leaves)
+		FinishLeaf();
+
+	// nodes that didn't get all of their inputs are closed from the bottom up
+	FixedSizeSecBlock<byte,128> Result;
+	for(unsigned int Height=2;;++Height)
+	{
+		TreeLevel &Level = m_Levels[Height-2];
+		if(Level.Inputs==1)
+		{
+			memcpy(Result,Level.FirstInput,m_Blocksize);
+			break;
+		}
+		if(Height==m_MaxHeight)
+		{
+			Level.Node.Final(Result);
+			break;
+		}
+		if(Level.Inputs & ((word64(1)<<m_FanOut)-1))
+		{
+			FixedSizeSecBlock<byte,128> Output;
+			Level.Node.Final(Output);
+			AppendOutput(Height,Output);
+		}
+	}
+
+	m_Leaf->OutTransformation(hash,size,Result);
+	Restart();
+}
+
+void Skein_Main_Provider::Tree::HashLeaves(const byte* input,size_t Leaves)
+{
+	// bounds the memory for the leaf outputs, the pool gets enough leaves per call either way
+	const size_t MaxBatch = 1024;
+	SecByteBlock Outputs(m_Blocksize*STDMIN(Leaves,MaxBatch));
+	ThreadPool &Pool = ThreadPool::GetGlobalPool();
 
+	while(Leaves)
+	{
+		const size_t Batch = STDMIN(Leaves,MaxBatch);
+		if(Batch>1 && Pool.ShouldParallelize(static_cast<size_t>(Batch*m_LeafLength)))
+			Pool.ParallelFor(static_cast<unsigned int>(Batch),this,&Tree::ThreadHashLeaf,input,Outputs.data());
+		else
+			for(unsigned int i=0;i<Batch;++i)
+				ThreadHashLeaf(i,input,Outputs);
+
+		for(size_t i=0;i<Batch;++i)
+			AppendOutput(1,Outputs+i*m_Blocksize);
+		m_Leaves += Batch;
+		input += Batch*m_LeafLength;
+		Leaves -= Batch;
+	}
+
+	m_Leaf->Restart(GetInitialState());
+	m_Leaf->SetTreePosition(m_Leaves*m_LeafLength,1);
+}
+
+void Skein_Main_Provider::Tree::ThreadHashLeaf(unsigned int Index,const byte* input,byte* output)
+{
+	UBI Leaf(m_Blocksize,UBI::MSG,GetInitialState());
+	Leaf.SetTreePosition((m_Leaves+Index)*m_LeafLength,1);
+	Leaf.Update(input+Index*m_LeafLength,static_cast<size_t>(m_LeafLength));
+	Leaf.Final(output+Index*m_Blocksize);
+}
+
+void Skein_Main_Provider::Tree::FinishLeaf()
+{
+	FixedSizeSecBlock<byte,128> Output;
+	m_Leaf->Final(Output);
+	AppendOutput(1,Output);
+
+	++m_Leaves;
+	m_LeafFill=0;
+	m_Leaf->Restart(GetInitialState());
+	m_Leaf->SetTreePosition(m_Leaves*m_LeafLength,1);
+}
+
+void Skein_Main_Provider::Tree::AppendOutput(unsigned int Height,const byte* Output)
+{
+	if(m_Levels.size()<Height)
+		m_Levels.push_back(TreeLevel(m_Blocksize,GetInitialState()));
+	TreeLevel &Level = m_Levels[Height-1];
+
+	// the nodes of the highest level take every input, the others 2^FanOut
+	const bool Bounded = Height+1<m_MaxHeight;
+	const word64 NodeMask = Bounded ? (word64(1)<<m_FanOut)-1 : ~word64(0);
+
+	if(!Level.Inputs)
+	{
+		memcpy(Level.FirstInput,Output,m_Blocksize);
+		Level.Inputs=1;
+		return;
+	}
+
+	if(Level.Inputs==1 || !(Level.Inputs & NodeMask))
+	{
+		Level.Node.Restart(GetInitialState());
+		Level.Node.SetTreePosition(Level.Inputs==1 ? 0 : Level.Inputs*m_Blocksize,Height+1);
+		if(Level.Inputs==1)
+			Level.Node.Update(Level.FirstInput,m_Blocksize);
+	}
+
+	Level.Node.Update(Output,m_Blocksize);
+	++Level.Inputs;
+
+	if(Bounded && !(Level.Inputs & NodeMask))
+	{
+		FixedSizeSecBlock<byte,128> NodeOutput;
+		Level.Node.Final(NodeOutput);
+		AppendOutput(Height+1,NodeOutput);
+	}
+}
 
 NAMESPACE_END
\ No newline at end of file
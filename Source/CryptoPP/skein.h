@@ -38,19 +38,22 @@ private:
 
 		void Update(const byte *input, size_t length);
 		void Restart();
+		//! restarts the chain from InitialState, which is BlockSize() bytes long
+		void Restart(const byte* InitialState);
+		//! call right after Restart(), Offset is the position of the first input byte within tree level Level
+		void SetTreePosition(word64 Offset,unsigned int Level) {m_Tweak[0]=Offset;m_Tweak[1]|=word64(Level)<<48;}
 		void TruncatedFinal(byte *hash, size_t size);
 
 		void OutTransformation(byte* OutReceiver,const size_t OutputSize,const byte* State);
 	private:
-		std::auto_ptr<TweakableBlockCipher> m_Threefish; // pointer to the underlying Threefish function
 		TypeValues m_TypeValue;
 		unsigned int m_Blocksize;
-		word64 m_LowerCounter;
-		word32 m_UpperCounter;
-		SecByteBlock m_State;
-		SecByteBlock m_BufferForNextBlock;
-	private:	
-		void IncrementCounters(size_t n);
+		FixedSizeSecBlock<word64,16> m_State; // chaining value, is the Threefish key of the next block
+		FixedSizeSecBlock<word64,2> m_Tweak; // 96-bit position, type and first / final flags
+		FixedSizeSecBlock<byte,128> m_BufferForNextBlock; // the last block may only be processed by TruncatedFinal()
+		size_t m_BufferLength;
+	private:
+		void ProcessBlocks(const byte* input, size_t Blocks, word64 ByteCountAdd);
 	};
 	class CRYPTOPP_NO_VTABLE Skein_Base
 	{
@@ -71,12 +74,17 @@ private:
 		void TruncatedFinalMsgUBI(byte *hash, size_t size); // uses output transformation
 	protected:
 		//! call this as very first!
-		void ConfigUBI(word64 OutputLength,unsigned int Blocksize) {m_OutputLength=OutputLength;m_BlockSize=Blocksize;}
+		void ConfigUBI(word64 OutputLength,unsigned int Blocksize) {m_OutputLength=OutputLength;m_BlockSize=Blocksize;m_TreeInfo=0;}
+		//! leaf size, fan-out and maximum height of the tree (Yl,Yf,Ym), call after ConfigUBI()
+		void ConfigTree(byte LeafSize,byte FanOut,byte MaxHeight) {m_TreeInfo=word32(LeafSize)|(word32(FanOut)<<8)|(word32(MaxHeight)<<16);}
+		//! chaining value after all settings
+		const byte* GetInitialState() const {return m_InitialState;}
 		//! call this after keying but before giving to the user
 		void ApplyAllSettings(); // restart calls this generate correct base state
 	private:
 		unsigned int m_BlockSize;
 		FixedSizeSecBlock<byte,128> m_State;
+		FixedSizeSecBlock<byte,128> m_InitialState; // chaining value after all settings, every message starts here
 		std::auto_ptr<UBI> m_MsgUBI; // all other UBIs will be instantiated locally
 		SecByteBlock m_KeyedState; // hides key information from attackers
 		SecByteBlock m_PersonalizationString;
@@ -84,6 +92,7 @@ private:
 		SecByteBlock m_PublicKey;
 		SecByteBlock m_KeyID;
 		word64 m_OutputLength;
+		word32 m_TreeInfo;
 	};
 public:
 	class Hash : public HashTransformation, public Skein_Base
@@ -205,12 +214,68 @@ public:
 		unsigned int m_Blocksize;
 		word64 m_DigestSize;
 	};
+	//! tree hashing mode, leaves of BlockSize*2^LeafSize bytes are hashed in parallel
+	/*! the outputs of 2^FanOut nodes are hashed by one node of the next level,
+		the nodes of level MaxHeight hash all outputs of the level below at once */
+	class Tree : public HashTransformation, public Skein_Base
+	{
+	public:
+		// BlockSize = 0 means "choose based on digest size and some nice rules"
+		// throws InvalidArgument unless LeafSize and FanOut are in [1,56] and MaxHeight is at least 2
+		Tree(const unsigned int DigestSize,byte LeafSize,byte FanOut,byte MaxHeight,unsigned int BlockSize = 0);
+
+		void Update(const byte *input, size_t length);
+		void Restart();
+		void TruncatedFinal(byte *hash, size_t size);
+
+		unsigned int BlockSize() const {return m_Blocksize;}
+		unsigned int DigestSize() const {return static_cast<unsigned int>(m_DigestSize);}
+		std::string AlgorithmName() const {return "Skein-Tree-" + IntToString(m_Blocksize*8) + "-" + IntToString(m_DigestSize*8);}
+
+		byte GetLeafSize() const {return m_LeafSize;}
+		byte GetFanOut() const {return m_FanOut;}
+		byte GetMaxHeight() const {return m_MaxHeight;}
+
+		// following is unsupported by the tree hash function
+		virtual void SetNonce(const byte* Nonce,size_t NonceLength) {}
+		virtual void KeyUBI(const byte* Key,size_t Keylength) {}
+		virtual void SetPublicKey(const byte* PublicKey,size_t Keylength) {}
+		virtual void SetKeyIdentifier(const byte* KeyIdentifier,size_t IDlength) {}
+
+		unsigned int OptimalBlockSize() const {return BlockSize();}
+		unsigned int OptimalDataAlignment() const {return GetAlignmentOf<word64>();}
+	private:
+		// hashes the outputs of level Height-1 into nodes of level Height
+		struct TreeLevel
+		{
+			TreeLevel(unsigned int Blocksize,const byte* InitialState) : Node(Blocksize,UBI::MSG,InitialState),Inputs(0) {}
+			UBI Node;
+			FixedSizeSecBlock<byte,128> FirstInput; // a level with a single input is the result, so its node starts with the second
+			word64 Inputs;
+		};
+
+		unsigned int m_Blocksize;
+		word64 m_DigestSize;
+		byte m_LeafSize,m_FanOut,m_MaxHeight;
+		word64 m_LeafLength;
+		std::auto_ptr<UBI> m_Leaf; // the leaf that Update() fills sequentially
+		word64 m_LeafFill;
+		word64 m_Leaves; // completed leaves
+		std::vector<TreeLevel> m_Levels; // m_Levels[i] builds the nodes of level i+2
+	private:
+		void HashLeaves(const byte* input,size_t Leaves);
+		void ThreadHashLeaf(unsigned int Index,const byte* input,byte* output);
+		void FinishLeaf();
+		//! adds the output of a node of level Height to the level above
+		void AppendOutput(unsigned int Height,const byte* Output);
+	};
 };
 
 typedef Skein_Main_Provider::MAC SkeinMAC;
 typedef Skein_Main_Provider::Hash Skein;
 typedef Skein_Main_Provider::KDF SkeinKDF;
 typedef Skein_Main_Provider::SignatureHash SkeinSignatureHash;
+typedef Skein_Main_Provider::Tree SkeinTree;
 
 class Skein_512 : public Skein
 {
@@ -18,11 +18,13 @@
 #include "factory.h"
 #include "whrlpool.h"
 #include "tiger.h"
+#include "oids.h"
 
 #include "validate.h"
 #include "bench.h"
 
 #include <iostream>
+#include <iomanip>
 #include <time.h>
 
 #ifdef CRYPTOPP_WIN32_AVAILABLE
@@ -87,6 +89,8 @@ void HexDecode(const char *infile, const char *outfile);
 
 void ForwardTcpPort(const char *sourcePort, const char *destinationHost, const char *destinationPort);
 
+void GenerateECPCombTables(const char *filename);
+
 void FIPS140_SampleApplication();
 void FIPS140_GenerateRandomFiles();
 
@@ -305,12 +309,35 @@ int CRYPTOPP_API main(int argc, char *argv[])
 			InformationDisperseFile(atoi(argv[2]), atoi(argv[3]), argv[4]);
 		else if (command == "ir")
 			InformationRecoverFile(argc-3, argv[2], argv+3);
+		else if (command == "ecct")
+			GenerateECPCombTables(argv[2]);
 		else if (command == "v" || command == "vv")
 			return !Validate(argc>2 ? atoi(argv[2]) : 0, argv[1][1] == 'v', argc>3 ? argv[3] : NULL);
 		else if (command == "b")
 			BenchmarkAll(argc<3 ? 1 : atof(argv[2]), argc<4 ? 0 : atof(argv[3])*1e9);
 		else if (command == "b2")
 			BenchmarkAll2(argc<3 ? 1 : atof(argv[2]), argc<4 ? 0 : atof(argv[3])*1e9);
+		else if (command == "bm")
+			BenchmarkMessageSizes(argc<3 ? 1 : atof(argv[2]), argc<4 ? 0 : atof(argv[3])*1e9);
+		else if (command == "bx")
+		{
+			BenchmarkSettings settings;
+			if (argc > 2)
+				settings.format = std::string(argv[2]) == "csv" ? BenchmarkSettings::CSV : BenchmarkSettings::JSON;
+			if (argc > 3)
+				settings.timePerMeasurement = atof(argv[3]);
+			if (argc > 4)
+				settings.hertz = atof(argv[4])*1e9;
+			if (argc > 5)
+				settings.warmUpTime = atof(argv[5]);
+			if (argc > 6)
+				settings.repetitions = atoi(argv[6]);
+			if (argc > 7)
+				settings.maxMessageSize = (size_t)atof(argv[7]);
+			if (argc > 8)
+				settings.filter = argv[8];
+			BenchmarkReport(settings, cout);
+		}
 		else if (command == "z")
 			GzipFile(argv[3], argv[4], argv[2][0]-'0');
 		else if (command == "u")
@@ -760,6 +787,80 @@ void ForwardTcpPort(const char *sourcePortName, const char *destinationHost, con
 #endif
 }
 
+static void WriteWords(ostream &out, const Integer &x, unsigned int words)
+{
+	for (unsigned int i=0; i<words; i++)
+	{
+		word64 w = 0;
+		for (unsigned int j=0; j<8; j++)
+			w |= word64(x.GetByte(8*i+j)) << (8*j);
+		out << (i%4 ? " " : "\t") << "W64LIT(0x" << hex << setw(16) << setfill('0') << w << dec << "),";
+		if (i%4 == 3 || i+1 == words)
+			out << "\n";
+	}
+}
+
+// writes the tables described in ecpcomb.h, computed with the generic curve arithmetic
+void GenerateECPCombTables(const char *filename)
+{
+	const char *names[] = {"secp256r1", "secp384r1", "secp521r1", "brainpoolP256r1", "brainpoolP384r1", "brainpoolP512r1"};
+	const OID oids[] = {ASN1::secp256r1(), ASN1::secp384r1(), ASN1::secp521r1(), ASN1::brainpoolP256r1(), ASN1::brainpoolP384r1(), ASN1::brainpoolP512r1()};
+	const unsigned int count = sizeof(oids)/sizeof(oids[0]);
+	const unsigned int blocks = ECPCombTable::TEETH*ECPCombTable::COMBS;
+	std::vector<unsigned int> words(count), spacing(count);
+
+	std::ofstream out(filename);
+	out << "// ecpcombtab.cpp - generator comb tables for named prime curves, see ecpcomb.h\n";
+	out << "// written by \"cryptest ecct ecpcombtab.cpp\", do not edit\n\n";
+	out << "#include \"pch.h\"\n\n#ifndef CRYPTOPP_IMPORTS\n\n#include \"ecpcomb.h\"\n\nNAMESPACE_BEGIN(CryptoPP)\n";
+
+	for (unsigned int i=0; i<count; i++)
+	{
+		DL_GroupParameters_EC<ECP> params(oids[i]);
+		const ECP &ec = params.GetCurve();
+		const Integer &n = params.GetSubgroupOrder();
+		words[i] = (ec.GetField().GetModulus().BitCount()+63)/64;
+		spacing[i] = (n.BitCount()+blocks-1)/blocks;
+
+		// 2^(m*spacing) G for each block m
+		std::vector<ECP::Point> bases(blocks);
+		bases[0] = params.GetSubgroupGenerator();
+		for (unsigned int m=1; m<blocks; m++)
+			bases[m] = ec.ScalarMultiply(bases[m-1], Integer::Power2(spacing[i]));
+
+		out << "\nstatic const word64 s_" << names[i] << "Curve[] = {\n";
+		WriteWords(out, ec.GetField().GetModulus(), words[i]);
+		WriteWords(out, ec.GetA(), words[i]);
+		WriteWords(out, ec.GetB(), words[i]);
+		WriteWords(out, bases[0].x, words[i]);
+		WriteWords(out, bases[0].y, words[i]);
+		WriteWords(out, n, words[i]);
+		out << "};\n";
+
+		out << "\nstatic const word64 s_" << names[i] << "Points[] = {\n";
+		for (unsigned int c=0; c<ECPCombTable::COMBS; c++)
+		{
+			std::vector<ECP::Point> table(ECPCombTable::ENTRIES+1);
+			for (unsigned int j=1; j<=ECPCombTable::ENTRIES; j++)
+			{
+				unsigned int low = 0;
+				while (!(j >> low & 1))
+					low++;
+				table[j] = ec.Add(table[j & (j-1)], bases[c*ECPCombTable::TEETH+low]);
+				WriteWords(out, table[j].x, words[i]);
+				WriteWords(out, table[j].y, words[i]);
+			}
+		}
+		out << "};\n";
+	}
+
+	out << "\nconst ECPCombTable g_ecpCombTables[] = {\n";
+	for (unsigned int i=0; i<count; i++)
+		out << "\t{\"" << names[i] << "\", " << words[i] << ", " << spacing[i] << ", s_" << names[i] << "Curve, s_" << names[i] << "Points},\n";
+	out << "};\n\nconst unsigned int g_ecpCombTableCount = sizeof(g_ecpCombTables)/sizeof(g_ecpCombTables[0]);\n\nNAMESPACE_END\n\n#endif\n";
+	cout << "Comb tables for " << count << " curves written to " << filename << ".\n";
+}
+
 bool Validate(int alg, bool thorough, const char *seedInput)
 {
 	bool result;
@@ -841,6 +942,8 @@ bool Validate(int alg, bool thorough, const char *seedInput)
 	case 67: result = ValidateCCM(); break;
 	case 68: result = ValidateGCM(); break;
 	case 69: result = ValidateCMAC(); break;
+	case 70: result = ValidateX25519(); break;
+	case 71: result = ValidateEd25519(); break;
 	default: return false;
 	}
 
@@ -0,0 +1,159 @@
+// threadpool.cpp - written and placed in the public domain by Jean-Pierre Muench
+
+#include "pch.h"
+
+#include "threadpool.h"
+
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+#include <exception>
+#include <algorithm>
+#endif
+
+NAMESPACE_BEGIN(CryptoPP)
+
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+struct ThreadPool::Job
+{
+	Job(unsigned int Count,ParallelLoopBody &Body)
+		: m_Body(Body),m_Count(Count),m_NextIndex(0),m_Finished(0) {}
+
+	ParallelLoopBody &m_Body;
+	unsigned int m_Count;
+	unsigned int m_NextIndex;
+	unsigned int m_Finished;
+	std::exception_ptr m_Exception;
+};
+#endif
+
+ThreadPool & ThreadPool::GetGlobalPool()
+{
+	// the workers are only started on the first ParallelFor(), so constructing the singleton is cheap
+	return const_cast<ThreadPool&>(Singleton<ThreadPool>().Ref());
+}
+
+unsigned int ThreadPool::GetHardwareConcurrency()
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	const unsigned int Result = std::thread::hardware_concurrency();
+	return Result ? Result : 1;
+#else
+	return 1;
+#endif
+}
+
+ThreadPool::ThreadPool(unsigned int NumberThreads)
+	: m_NumberThreads(NumberThreads ? NumberThreads : GetHardwareConcurrency()),
+	  m_ParallelThreshold(DEFAULT_PARALLEL_THRESHOLD)
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	  ,m_Stop(false)
+#endif
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	StopWorkers();
+#endif
+}
+
+void ThreadPool::SetNumberThreads(unsigned int NumberThreads)
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	StopWorkers();
+#endif
+	m_NumberThreads = NumberThreads ? NumberThreads : GetHardwareConcurrency();
+}
+
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+
+void ThreadPool::StartWorkers()
+{
+	// the calling thread is the last member of the pool
+	m_Stop = false;
+	m_Workers.reserve(m_NumberThreads-1);
+	for(unsigned int i=1;i<m_NumberThreads;++i)
+		m_Workers.push_back(std::thread(&ThreadPool::WorkerFunction,this));
+}
+
+void ThreadPool::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Stop = true;
+	}
+	m_WorkAvailable.notify_all();
+	for(std::vector<std::thread>::iterator it=m_Workers.begin();it!=m_Workers.end();++it)
+		it->join();
+	m_Workers.clear();
+}
+
+void ThreadPool::RunIndex(Job &CurrentJob,std::unique_lock<std::mutex> &Lock)
+{
+	const unsigned int Index = CurrentJob.m_NextIndex++;
+	if(CurrentJob.m_NextIndex==CurrentJob.m_Count)
+		m_Jobs.erase(std::find(m_Jobs.begin(),m_Jobs.end(),&CurrentJob));
+
+	Lock.unlock();
+	std::exception_ptr Exception;
+	try
+	{
+		CurrentJob.m_Body(Index);
+	}
+	catch(...)
+	{
+		Exception = std::current_exception();
+	}
+	Lock.lock();
+
+	if(Exception && !CurrentJob.m_Exception)
+		CurrentJob.m_Exception = Exception;
+	if(++CurrentJob.m_Finished==CurrentJob.m_Count)
+		m_JobFinished.notify_all();
+}
+
+void ThreadPool::WorkerFunction()
+{
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+	while(true)
+	{
+		while(!m_Stop && m_Jobs.empty())
+			m_WorkAvailable.wait(Lock);
+		if(m_Stop)
+			return;
+		RunIndex(*m_Jobs.front(),Lock);
+	}
+}
+
+#endif
+
+void ThreadPool::ParallelFor(unsigned int Count,ParallelLoopBody &Body)
+{
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	if(m_NumberThreads>1 && Count>1)
+	{
+		Job CurrentJob(Count,Body);
+
+		std::unique_lock<std::mutex> Lock(m_Mutex);
+		if(m_Workers.empty())
+			StartWorkers();
+		m_Jobs.push_back(&CurrentJob);
+		m_WorkAvailable.notify_all();
+
+		// help with our own job until all indices are handed out, then wait for the stragglers
+		while(CurrentJob.m_NextIndex<CurrentJob.m_Count)
+			RunIndex(CurrentJob,Lock);
+		while(CurrentJob.m_Finished<CurrentJob.m_Count)
+			m_JobFinished.wait(Lock);
+		Lock.unlock();
+
+		if(CurrentJob.m_Exception)
+			std::rethrow_exception(CurrentJob.m_Exception);
+		return;
+	}
+#endif
+	for(unsigned int i=0;i<Count;++i)
+		Body(i);
+}
+
+NAMESPACE_END
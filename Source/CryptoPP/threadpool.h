@@ -0,0 +1,109 @@
+// threadpool.h - written and placed in the public domain by Jean-Pierre Muench
+
+#ifndef CRYPTOPP_THREADPOOL_H
+#define CRYPTOPP_THREADPOOL_H
+
+#include "cryptlib.h"
+#include "misc.h"
+
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#endif
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! body of a loop that is run by ThreadPool::ParallelFor()
+class CRYPTOPP_NO_VTABLE ParallelLoopBody
+{
+public:
+	virtual ~ParallelLoopBody() {}
+	//! called exactly once for every index, possibly concurrently for different indices
+	virtual void operator()(unsigned int Index) =0;
+};
+
+//! calls (Object->*Function)(Index,Arg1,Arg2) for every loop index
+template <class T, class A1, class A2>
+class ParallelMemberCall : public ParallelLoopBody
+{
+public:
+	typedef void (T::*MemberFunction)(unsigned int,A1,A2);
+
+	ParallelMemberCall(T *Object,MemberFunction Function,A1 Arg1,A2 Arg2)
+		: m_Object(Object),m_Function(Function),m_Arg1(Arg1),m_Arg2(Arg2) {}
+	void operator()(unsigned int Index) {(m_Object->*m_Function)(Index,m_Arg1,m_Arg2);}
+private:
+	T *m_Object;
+	MemberFunction m_Function;
+	A1 m_Arg1;
+	A2 m_Arg2;
+};
+
+//! pool of worker threads that is started on first use and shared by the whole library
+/*! The thread calling ParallelFor() works on the loop as well, so nested calls
+	from inside a loop body can't dead-lock, they just run with less help.
+	If the library is compiled without thread support everything runs inline. */
+class CRYPTOPP_DLL ThreadPool : public NotCopyable
+{
+public:
+	//! inputs shorter than this are handled inline by default, handing them to workers costs more than it saves
+	CRYPTOPP_CONSTANT(DEFAULT_PARALLEL_THRESHOLD = 32*1024)
+
+	//! the pool used by algorithms of this library
+	static ThreadPool & GetGlobalPool();
+
+	//! NumberThreads counts the calling thread, 0 selects the number of hardware threads
+	explicit ThreadPool(unsigned int NumberThreads=0);
+	~ThreadPool();
+
+	//! stops running workers, new ones are started on the next call to ParallelFor()
+	//! don't call while another thread is inside ParallelFor()
+	void SetNumberThreads(unsigned int NumberThreads);
+	unsigned int GetNumberThreads() const {return m_NumberThreads;}
+
+	void SetParallelThreshold(size_t Threshold) {m_ParallelThreshold=Threshold;}
+	size_t GetParallelThreshold() const {return m_ParallelThreshold;}
+	//! returns whether handing Length bytes of work to the pool is worth it
+	bool ShouldParallelize(size_t Length) const {return m_NumberThreads>1 && Length>=m_ParallelThreshold;}
+
+	//! calls Body(i) for every i in [0,Count) and returns after all calls have finished
+	//! the first exception thrown by a call is rethrown here
+	void ParallelFor(unsigned int Count,ParallelLoopBody &Body);
+
+	template <class T, class A1, class A2>
+	void ParallelFor(unsigned int Count,T *Object,void (T::*Function)(unsigned int,A1,A2),A1 Arg1,A2 Arg2)
+	{
+		ParallelMemberCall<T,A1,A2> Body(Object,Function,Arg1,Arg2);
+		ParallelFor(Count,Body);
+	}
+
+	static unsigned int GetHardwareConcurrency();
+
+private:
+	unsigned int m_NumberThreads;
+	size_t m_ParallelThreshold;
+
+#if CRYPTOPP_BOOL_CPP11_THREAD_SUPPORTED
+	struct Job;
+
+	void StartWorkers();
+	void StopWorkers();
+	void WorkerFunction();
+	// m_Mutex has to be held by the caller, it is released while the body runs
+	void RunIndex(Job &CurrentJob,std::unique_lock<std::mutex> &Lock);
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkAvailable;
+	std::condition_variable m_JobFinished;
+	std::deque<Job*> m_Jobs;
+	std::vector<std::thread> m_Workers;
+	bool m_Stop;
+#endif
+};
+
+NAMESPACE_END
+
+#endif
@@ -119,6 +119,8 @@ bool ValidateAll(bool thorough)
 	pass=ValidateEC2N() && pass;
 	pass=ValidateECDSA() && pass;
 	pass=ValidateESIGN() && pass;
+	pass=ValidateX25519() && pass;
+	pass=ValidateEd25519() && pass;
 
 	if (pass)
 		cout << "\nAll tests passed!\n";
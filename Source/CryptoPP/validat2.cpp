@@ -26,6 +26,7 @@
 #include "oids.h"
 #include "esign.h"
 #include "osrng.h"
+#include "xed25519.h"
 
 #include <iostream>
 #include <iomanip>
@@ -341,13 +342,109 @@ bool ValidateRSA()
 	return pass;
 }
 
+// writes a mappable precomputation to a file and loads it into params through a MappedFile,
+// returns whether it was rejected as InvalidDataFormat
+static bool MappedPrecomputationRejected(const DH::GroupParameters &params, const std::string &data, const char *filename)
+{
+	StringSource(data, true, new FileSink(filename));
+	bool rejected = false;
+	{
+		MappedFile file(filename);
+		DH::GroupParameters loaded(params);
+		try
+		{
+			loaded.LoadMappedPrecomputation(file.GetData(), file.GetSize());
+		}
+		catch (const InvalidDataFormat &)
+		{
+			rejected = true;
+		}
+	}
+	remove(filename);
+	return rejected;
+}
+
 bool ValidateDH()
 {
 	cout << "\nDH validation suite running...\n\n";
 
 	FileSource f("TestData/dh1024.dat", true, new HexDecoder());
 	DH dh(f);
-	return SimpleKeyAgreementValidate(dh);
+	bool pass = SimpleKeyAgreementValidate(dh);
+
+	// the word aligned precomputation, read in place from a file with a narrow (Yao) and a wide window
+	const char *filename = "TestData/dh1024pc.tmp";
+	const DH::GroupParameters &params = dh.GetGroupParameters();
+	bool mappedPass = true;
+	unsigned int storages[] = {128, 8};
+	std::string table;
+	for (unsigned int s=0; s<COUNTOF(storages); s++)
+	{
+		DH::GroupParameters precomputed(params);
+		precomputed.Precompute(storages[s]);
+		table.clear();
+		StringSink sink(table);
+		precomputed.SaveMappablePrecomputation(sink);
+		StringSource(table, true, new FileSink(filename));
+
+		{
+			MappedFile file(filename);
+			DH mapped(dh);
+			mapped.AccessGroupParameters().LoadMappedPrecomputation(file.GetData(), file.GetSize());
+
+			for (unsigned int i=0; i<8; i++)
+			{
+				Integer x(GlobalRNG(), Integer::Zero(), params.GetMaxExponent());
+				mappedPass = mapped.GetGroupParameters().ExponentiateBase(x) == a_exp_b_mod_c(params.GetGenerator(), x, params.GetModulus()) && mappedPass;
+			}
+			mappedPass = mapped.GetGroupParameters().ExponentiateBase(Integer::Zero()) == Integer::One() && mappedPass;
+			pass = SimpleKeyAgreementValidate(mapped) && pass;
+		}
+		remove(filename);
+	}
+	cout << (mappedPass ? "passed" : "FAILED") << "    mapped precomputation" << endl;
+
+	// the format version is the first word32 after the eight byte magic
+	std::string wrongVersion = table;
+	word32 version;
+	memcpy(&version, wrongVersion.data()+8, 4);
+	version++;
+	memcpy(&wrongVersion[8], &version, 4);
+
+	DH::GroupParameters otherGenerator;
+	otherGenerator.Initialize(params.GetModulus(), params.GetSubgroupOrder(), a_exp_b_mod_c(params.GetGenerator(), 2, params.GetModulus()));
+	bool rejectPass = MappedPrecomputationRejected(otherGenerator, table, filename);
+	rejectPass = MappedPrecomputationRejected(params, table.substr(0, table.size()-WORD_SIZE), filename) && rejectPass;
+	rejectPass = MappedPrecomputationRejected(params, table.substr(0, ModExpFixedBasePrecomputation::MAPPED_HEADER_SIZE-1), filename) && rejectPass;
+	rejectPass = MappedPrecomputationRejected(params, wrongVersion, filename) && rejectPass;
+	try
+	{
+		DH::GroupParameters uninitialized;
+		uninitialized.LoadMappedPrecomputation((const byte *)table.data(), table.size());
+		rejectPass = false;
+	}
+	catch (const InvalidArgument &) {}
+	cout << (rejectPass ? "passed" : "FAILED") << "    mapped precomputation with wrong generator, truncated, wrong version or no group rejected" << endl;
+
+	// a new modulus with the same generator drops the mapped table
+	bool reinitPass = true;
+	StringSource(table, true, new FileSink(filename));
+	{
+		MappedFile file(filename);
+		DH::GroupParameters reinitialized(params);
+		reinitialized.LoadMappedPrecomputation(file.GetData(), file.GetSize());
+		const Integer p(GlobalRNG(), Integer::Power2(1535), Integer::Power2(1536)-1, Integer::PRIME);
+		reinitialized.Initialize(p, params.GetGenerator());
+		for (unsigned int i=0; i<4; i++)
+		{
+			Integer x(GlobalRNG(), Integer::Zero(), reinitialized.GetMaxExponent());
+			reinitPass = reinitialized.ExponentiateBase(x) == a_exp_b_mod_c(params.GetGenerator(), x, p) && reinitPass;
+		}
+	}
+	remove(filename);
+	cout << (reinitPass ? "passed" : "FAILED") << "    mapped precomputation dropped for a new modulus" << endl;
+
+	return pass && mappedPass && rejectPass && reinitPass;
 }
 
 bool ValidateMQV()
@@ -1169,3 +1266,99 @@ bool ValidateESIGN()
 
 	return pass;
 }
+
+bool ValidateX25519()
+{
+	cout << "\nX25519 validation suite running...\n\n";
+
+	// from RFC 7748 section 6.1
+	static const char *alicePrivate = "77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a";
+	static const char *alicePublic = "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a";
+	static const char *bobPrivate = "5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb";
+	static const char *bobPublic = "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f";
+	static const char *shared = "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742";
+
+	x25519 x;
+	std::string priv1, pub1, priv2, pub2, expected;
+	StringSource(alicePrivate, true, new HexDecoder(new StringSink(priv1)));
+	StringSource(alicePublic, true, new HexDecoder(new StringSink(pub1)));
+	StringSource(bobPrivate, true, new HexDecoder(new StringSink(priv2)));
+	StringSource(bobPublic, true, new HexDecoder(new StringSink(pub2)));
+	StringSource(shared, true, new HexDecoder(new StringSink(expected)));
+
+	bool pass = true, fail;
+	byte pub[32], val1[32], val2[32];
+
+	x.GeneratePublicKey(GlobalRNG(), (const byte *)priv1.data(), pub);
+	fail = memcmp(pub, pub1.data(), 32) != 0;
+	x.GeneratePublicKey(GlobalRNG(), (const byte *)priv2.data(), pub);
+	fail = fail || memcmp(pub, pub2.data(), 32) != 0;
+	pass = pass && !fail;
+
+	cout << (fail ? "FAILED    " : "passed    ");
+	cout << "public key check against test vector\n";
+
+	fail = !x.Agree(val1, (const byte *)priv1.data(), (const byte *)pub2.data()) || !x.Agree(val2, (const byte *)priv2.data(), (const byte *)pub1.data());
+	fail = fail || memcmp(val1, expected.data(), 32) != 0 || memcmp(val2, expected.data(), 32) != 0;
+	pass = pass && !fail;
+
+	cout << (fail ? "FAILED    " : "passed    ");
+	cout << "agreement check against test vector\n";
+
+	memset(pub, 0, sizeof(pub));
+	fail = x.Agree(val1, (const byte *)priv1.data(), pub);
+	pass = pass && !fail;
+
+	cout << (fail ? "FAILED    " : "passed    ");
+	cout << "rejecting point of small order\n";
+
+	return SimpleKeyAgreementValidate(x) && pass;
+}
+
+bool ValidateEd25519()
+{
+	cout << "\nEd25519 validation suite running...\n\n";
+
+	// from RFC 8032 section 7.1
+	static const struct
+	{
+		const char *secretKey, *publicKey, *message, *signature;
+	} tests[] = {
+		{"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60", "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a", "",
+		"e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"},
+		{"4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb", "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c", "72",
+		"92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"},
+		{"c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7", "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025", "af82",
+		"6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"},
+	};
+
+	bool pass = true, fail;
+
+	for (unsigned int i=0; i<sizeof(tests)/sizeof(tests[0]); i++)
+	{
+		std::string secretKey, publicKey, message, expected;
+		StringSource(tests[i].secretKey, true, new HexDecoder(new StringSink(secretKey)));
+		StringSource(tests[i].publicKey, true, new HexDecoder(new StringSink(publicKey)));
+		StringSource(tests[i].message, true, new HexDecoder(new StringSink(message)));
+		StringSource(tests[i].signature, true, new HexDecoder(new StringSink(expected)));
+
+		ed25519::Signer signer((const byte *)secretKey.data());
+		ed25519::Verifier verifier((const byte *)publicKey.data());
+		byte signature[64];
+
+		fail = memcmp(signer.GetKey().GetPublicKeyBytes(), publicKey.data(), 32) != 0;
+		signer.SignMessage(GlobalRNG(), (const byte *)message.data(), message.size(), signature);
+		fail = fail || memcmp(signature, expected.data(), 64) != 0;
+		fail = fail || !verifier.VerifyMessage((const byte *)message.data(), message.size(), signature, 64);
+		signature[63] ^= 0x10;
+		fail = fail || verifier.VerifyMessage((const byte *)message.data(), message.size(), signature, 64);
+		pass = pass && !fail;
+
+		cout << (fail ? "FAILED    " : "passed    ");
+		cout << "signature and verification check against test vector " << i+1 << "\n";
+	}
+
+	ed25519::Signer signer(GlobalRNG());
+	ed25519::Verifier verifier(signer);
+	return SignatureValidate(signer, verifier) && pass;
+}
@@ -77,6 +77,8 @@ bool ValidateECP();
 bool ValidateEC2N();
 bool ValidateECDSA();
 bool ValidateESIGN();
+bool ValidateX25519();
+bool ValidateEd25519();
 
 CryptoPP::RandomNumberGenerator & GlobalRNG();
 bool RunTestDataFile(const char *filename, const CryptoPP::NameValuePairs &overrideParameters=CryptoPP::g_nullNameValuePairs, bool thorough=true);
@@ -0,0 +1,978 @@
+// xed25519.cpp - X25519 and Ed25519 over radix 2^51 field elements
+
+#include "pch.h"
+
+#ifndef CRYPTOPP_IMPORTS
+
+#include "xed25519.h"
+#include "sha.h"
+#include "misc.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+// ********************************************************
+
+// Elements of GF(2^255-19) are five 51-bit limbs. Multiplication and squaring return limbs below
+// 2^51 + 2^15, Subtract carries as well, Add does not. Every input to Multiply, Square and
+// Subtract is the result of at most one Add of such values, which keeps all column sums below
+// 2^112 and the subtrahend below the 4p that Subtract adds first.
+
+#if defined(CRYPTOPP_WORD128_AVAILABLE)
+typedef word128 X25519Wide;
+static inline X25519Wide X25519_Mul(word64 a, word64 b) {return X25519Wide(a) * b;}
+static inline word64 X25519_Low(const X25519Wide &x) {return word64(x);}
+static inline word64 X25519_Shift51(const X25519Wide &x) {return word64(x >> 51);}
+#else
+struct X25519Wide
+{
+	word64 lo, hi;
+	X25519Wide & operator+=(const X25519Wide &b) {lo += b.lo; hi += b.hi + (lo < b.lo); return *this;}
+	X25519Wide & operator+=(word64 b) {lo += b; hi += lo < b; return *this;}
+};
+static inline X25519Wide operator+(X25519Wide a, const X25519Wide &b) {return a += b;}
+static inline X25519Wide X25519_Mul(word64 a, word64 b)
+{
+	X25519Wide r;
+#if defined(_MSC_VER) && defined(_M_X64)
+	r.lo = _umul128(a, b, &r.hi);
+#else
+	const word64 ll = word64(word32(a)) * word32(b), lh = word64(word32(a)) * word32(b >> 32);
+	const word64 hl = word64(word32(a >> 32)) * word32(b), hh = word64(word32(a >> 32)) * word32(b >> 32);
+	const word64 mid = (ll >> 32) + word32(lh) + word32(hl);
+	r.hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	r.lo = (mid << 32) | word32(ll);
+#endif
+	return r;
+}
+static inline word64 X25519_Low(const X25519Wide &x) {return x.lo;}
+static inline word64 X25519_Shift51(const X25519Wide &x) {return (x.lo >> 51) | (x.hi << 13);}
+#endif
+
+static const word64 MASK51 = (W64LIT(1) << 51) - 1;
+
+struct FieldElement25519
+{
+	word64 v[5];
+};
+
+typedef FieldElement25519 Fe;
+
+static const Fe s_zero = {{0, 0, 0, 0, 0}};
+static const Fe s_one = {{1, 0, 0, 0, 0}};
+// d = -121665/121666, 2d and a square root of -1
+static const Fe s_d = {{W64LIT(0x34dca135978a3), W64LIT(0x1a8283b156ebd), W64LIT(0x5e7a26001c029), W64LIT(0x739c663a03cbb), W64LIT(0x52036cee2b6ff)}};
+static const Fe s_2d = {{W64LIT(0x69b9426b2f159), W64LIT(0x35050762add7a), W64LIT(0x3cf44c0038052), W64LIT(0x6738cc7407977), W64LIT(0x2406d9dc56dff)}};
+static const Fe s_sqrtm1 = {{W64LIT(0x61b274a0ea0b0), W64LIT(0x0d5a5fc8f189d), W64LIT(0x7ef5e9cbd0c60), W64LIT(0x78595a6804c9e), W64LIT(0x2b8324804fc1d)}};
+
+static inline void FeCarry(Fe &r, X25519Wide t0, X25519Wide t1, X25519Wide t2, X25519Wide t3, X25519Wide t4)
+{
+	word64 r0 = X25519_Low(t0) & MASK51;
+	t1 += X25519_Shift51(t0);
+	word64 r1 = X25519_Low(t1) & MASK51;
+	t2 += X25519_Shift51(t1);
+	word64 r2 = X25519_Low(t2) & MASK51;
+	t3 += X25519_Shift51(t2);
+	word64 r3 = X25519_Low(t3) & MASK51;
+	t4 += X25519_Shift51(t3);
+	word64 r4 = X25519_Low(t4) & MASK51;
+	r0 += X25519_Shift51(t4) * 19;
+	r1 += r0 >> 51;
+	r0 &= MASK51;
+	r.v[0] = r0; r.v[1] = r1; r.v[2] = r2; r.v[3] = r3; r.v[4] = r4;
+}
+
+static inline void FeAdd(Fe &r, const Fe &a, const Fe &b)
+{
+	r.v[0] = a.v[0] + b.v[0];
+	r.v[1] = a.v[1] + b.v[1];
+	r.v[2] = a.v[2] + b.v[2];
+	r.v[3] = a.v[3] + b.v[3];
+	r.v[4] = a.v[4] + b.v[4];
+}
+
+// r = a + 4p - b, carried
+static inline void FeSubtract(Fe &r, const Fe &a, const Fe &b)
+{
+	word64 r0 = a.v[0] + W64LIT(0x1fffffffffffb4) - b.v[0];
+	word64 r1 = a.v[1] + W64LIT(0x1ffffffffffffc) - b.v[1];
+	word64 r2 = a.v[2] + W64LIT(0x1ffffffffffffc) - b.v[2];
+	word64 r3 = a.v[3] + W64LIT(0x1ffffffffffffc) - b.v[3];
+	word64 r4 = a.v[4] + W64LIT(0x1ffffffffffffc) - b.v[4];
+	r1 += r0 >> 51; r0 &= MASK51;
+	r2 += r1 >> 51; r1 &= MASK51;
+	r3 += r2 >> 51; r2 &= MASK51;
+	r4 += r3 >> 51; r3 &= MASK51;
+	r0 += (r4 >> 51) * 19; r4 &= MASK51;
+	r.v[0] = r0; r.v[1] = r1; r.v[2] = r2; r.v[3] = r3; r.v[4] = r4;
+}
+
+static inline void FeNegate(Fe &r, const Fe &a)
+{
+	FeSubtract(r, s_zero, a);
+}
+
+static inline void FeMultiply(Fe &r, const Fe &a, const Fe &b)
+{
+	const word64 a0 = a.v[0], a1 = a.v[1], a2 = a.v[2], a3 = a.v[3], a4 = a.v[4];
+	const word64 b0 = b.v[0], b1 = b.v[1], b2 = b.v[2], b3 = b.v[3], b4 = b.v[4];
+	const word64 b1_19 = b1 * 19, b2_19 = b2 * 19, b3_19 = b3 * 19, b4_19 = b4 * 19;
+
+	X25519Wide t0 = X25519_Mul(a0, b0) + X25519_Mul(a1, b4_19) + X25519_Mul(a2, b3_19) + X25519_Mul(a3, b2_19) + X25519_Mul(a4, b1_19);
+	X25519Wide t1 = X25519_Mul(a0, b1) + X25519_Mul(a1, b0) + X25519_Mul(a2, b4_19) + X25519_Mul(a3, b3_19) + X25519_Mul(a4, b2_19);
+	X25519Wide t2 = X25519_Mul(a0, b2) + X25519_Mul(a1, b1) + X25519_Mul(a2, b0) + X25519_Mul(a3, b4_19) + X25519_Mul(a4, b3_19);
+	X25519Wide t3 = X25519_Mul(a0, b3) + X25519_Mul(a1, b2) + X25519_Mul(a2, b1) + X25519_Mul(a3, b0) + X25519_Mul(a4, b4_19);
+	X25519Wide t4 = X25519_Mul(a0, b4) + X25519_Mul(a1, b3) + X25519_Mul(a2, b2) + X25519_Mul(a3, b1) + X25519_Mul(a4, b0);
+
+	FeCarry(r, t0, t1, t2, t3, t4);
+}
+
+static inline void FeSquare(Fe &r, const Fe &a)
+{
+	const word64 a0 = a.v[0], a1 = a.v[1], a2 = a.v[2], a3 = a.v[3], a4 = a.v[4];
+	const word64 a0_2 = a0 * 2, a1_2 = a1 * 2, a3_19 = a3 * 19, a4_19 = a4 * 19;
+
+	X25519Wide t0 = X25519_Mul(a0, a0) + X25519_Mul(a1_2, a4_19) + X25519_Mul(a2 * 2, a3_19);
+	X25519Wide t1 = X25519_Mul(a0_2, a1) + X25519_Mul(a2 * 2, a4_19) + X25519_Mul(a3, a3_19);
+	X25519Wide t2 = X25519_Mul(a0_2, a2) + X25519_Mul(a1, a1) + X25519_Mul(a3 * 2, a4_19);
+	X25519Wide t3 = X25519_Mul(a0_2, a3) + X25519_Mul(a1_2, a2) + X25519_Mul(a4, a4_19);
+	X25519Wide t4 = X25519_Mul(a0_2, a4) + X25519_Mul(a1_2, a3) + X25519_Mul(a2, a2);
+
+	FeCarry(r, t0, t1, t2, t3, t4);
+}
+
+static inline void FeSquareTimes(Fe &r, const Fe &a, unsigned int n)
+{
+	FeSquare(r, a);
+	while (--n)
+		FeSquare(r, r);
+}
+
+// r = a * 121665, (A-2)/4 for Curve25519
+static inline void FeMultiplyA24(Fe &r, const Fe &a)
+{
+	FeCarry(r, X25519_Mul(a.v[0], 121665), X25519_Mul(a.v[1], 121665), X25519_Mul(a.v[2], 121665), X25519_Mul(a.v[3], 121665), X25519_Mul(a.v[4], 121665));
+}
+
+// z11 = z^11 and r = z^(2^250-1), shared by the inversion and square root chains
+static void FePower2250(Fe &r, Fe &z11, const Fe &z)
+{
+	Fe t0, t1, t2;
+	FeSquare(t0, z);				// 2
+	FeSquareTimes(t1, t0, 2);		// 8
+	FeMultiply(t1, t1, z);			// 9
+	FeMultiply(z11, t0, t1);		// 11
+	FeSquare(t0, z11);				// 22
+	FeMultiply(t1, t1, t0);			// 2^5 - 1
+	FeSquareTimes(t0, t1, 5);
+	FeMultiply(t1, t0, t1);			// 2^10 - 1
+	FeSquareTimes(t0, t1, 10);
+	FeMultiply(t0, t0, t1);			// 2^20 - 1
+	FeSquareTimes(t2, t0, 20);
+	FeMultiply(t0, t2, t0);			// 2^40 - 1
+	FeSquareTimes(t0, t0, 10);
+	FeMultiply(t1, t0, t1);			// 2^50 - 1
+	FeSquareTimes(t0, t1, 50);
+	FeMultiply(t0, t0, t1);			// 2^100 - 1
+	FeSquareTimes(t2, t0, 100);
+	FeMultiply(t0, t2, t0);			// 2^200 - 1
+	FeSquareTimes(t0, t0, 50);
+	FeMultiply(r, t0, t1);			// 2^250 - 1
+}
+
+// r = z^(p-2) = 1/z, or 0 for z = 0
+static void FeInvert(Fe &r, const Fe &z)
+{
+	Fe t, z11;
+	FePower2250(t, z11, z);
+	FeSquareTimes(t, t, 5);			// 2^255 - 32
+	FeMultiply(r, t, z11);			// 2^255 - 21
+}
+
+// r = z^((p-5)/8) = z^(2^252-3)
+static void FePower22523(Fe &r, const Fe &z)
+{
+	Fe t, z11;
+	FePower2250(t, z11, z);
+	FeSquareTimes(t, t, 2);			// 2^252 - 4
+	FeMultiply(r, t, z);			// 2^252 - 3
+}
+
+// ignores bit 255, accepts values up to 2^255-1 without reducing them
+static void FeFromBytes(Fe &r, const byte *s)
+{
+	const word64 w0 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, s);
+	const word64 w1 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, s+8);
+	const word64 w2 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, s+16);
+	const word64 w3 = GetWord<word64>(false, LITTLE_ENDIAN_ORDER, s+24);
+	r.v[0] = w0 & MASK51;
+	r.v[1] = ((w0 >> 51) | (w1 << 13)) & MASK51;
+	r.v[2] = ((w1 >> 38) | (w2 << 26)) & MASK51;
+	r.v[3] = ((w2 >> 25) | (w3 << 39)) & MASK51;
+	r.v[4] = (w3 >> 12) & MASK51;
+}
+
+// writes the unique representative below p
+static void FeToBytes(byte *s, const Fe &a)
+{
+	word64 h0 = a.v[0], h1 = a.v[1], h2 = a.v[2], h3 = a.v[3], h4 = a.v[4];
+
+	// two carry passes leave the value below 2^255 + 2^13 < 2p
+	for (unsigned int i=0; i<2; i++)
+	{
+		h1 += h0 >> 51; h0 &= MASK51;
+		h2 += h1 >> 51; h1 &= MASK51;
+		h3 += h2 >> 51; h2 &= MASK51;
+		h4 += h3 >> 51; h3 &= MASK51;
+		h0 += (h4 >> 51) * 19; h4 &= MASK51;
+	}
+
+	// q = 1 if the value is at least p, then subtract q*p by adding 19q and dropping bit 255
+	word64 q = (h0 + 19) >> 51;
+	q = (h1 + q) >> 51;
+	q = (h2 + q) >> 51;
+	q = (h3 + q) >> 51;
+	q = (h4 + q) >> 51;
+
+	h0 += 19 * q;
+	h1 += h0 >> 51; h0 &= MASK51;
+	h2 += h1 >> 51; h1 &= MASK51;
+	h3 += h2 >> 51; h2 &= MASK51;
+	h4 += h3 >> 51; h3 &= MASK51;
+	h4 &= MASK51;
+
+	PutWord(false, LITTLE_ENDIAN_ORDER, s, h0 | (h1 << 51));
+	PutWord(false, LITTLE_ENDIAN_ORDER, s+8, (h1 >> 13) | (h2 << 38));
+	PutWord(false, LITTLE_ENDIAN_ORDER, s+16, (h2 >> 26) | (h3 << 25));
+	PutWord(false, LITTLE_ENDIAN_ORDER, s+24, (h3 >> 39) | (h4 << 12));
+}
+
+static bool FeIsZero(const Fe &a)
+{
+	byte s[32];
+	FeToBytes(s, a);
+	byte b = 0;
+	for (unsigned int i=0; i<32; i++)
+		b |= s[i];
+	return b == 0;
+}
+
+static bool FeIsNegative(const Fe &a)
+{
+	byte s[32];
+	FeToBytes(s, a);
+	return (s[0] & 1) != 0;
+}
+
+// swaps a and b if swap is 1, leaves them alone if it is 0, without branching
+static inline void FeConditionalSwap(Fe &a, Fe &b, word64 swap)
+{
+	const word64 mask = 0 - swap;
+	for (unsigned int i=0; i<5; i++)
+	{
+		const word64 t = mask & (a.v[i] ^ b.v[i]);
+		a.v[i] ^= t;
+		b.v[i] ^= t;
+	}
+}
+
+// r = a if move is 1, without branching
+static inline void FeConditionalMove(Fe &r, const Fe &a, word64 move)
+{
+	const word64 mask = 0 - move;
+	for (unsigned int i=0; i<5; i++)
+		r.v[i] ^= mask & (r.v[i] ^ a.v[i]);
+}
+
+// ********************************************************
+
+// points of edwards25519, -x^2 + y^2 = 1 + d x^2 y^2, in extended coordinates x = X/Z, y = Y/Z, xy = T/Z
+struct EdwardsPoint
+{
+	Fe X, Y, Z, T;
+};
+
+// affine point prepared for mixed addition, (y+x, y-x, 2dxy)
+struct EdwardsNiels
+{
+	Fe YplusX, YminusX, XY2d;
+};
+
+// projective point prepared for addition, (Y+X, Y-X, 2Z, 2dT)
+struct EdwardsCached
+{
+	Fe YplusX, YminusX, Z2, T2d;
+};
+
+static void EdIdentity(EdwardsPoint &r)
+{
+	r.X = s_zero; r.Y = s_one; r.Z = s_one; r.T = s_zero;
+}
+
+// dbl-2008-hwcd with a = -1, 4M + 4S
+static void EdDouble(EdwardsPoint &r, const EdwardsPoint &p)
+{
+	Fe A, B, C, E, F, G, H, t;
+	FeSquare(A, p.X);
+	FeSquare(B, p.Y);
+	FeSquare(C, p.Z);
+	FeAdd(C, C, C);
+	FeAdd(t, p.X, p.Y);
+	FeSquare(E, t);
+	FeSubtract(E, E, A);
+	FeSubtract(E, E, B);
+	FeSubtract(G, B, A);
+	FeSubtract(F, G, C);
+	FeAdd(t, A, B);
+	FeNegate(H, t);
+	FeMultiply(r.X, E, F);
+	FeMultiply(r.Y, G, H);
+	FeMultiply(r.T, E, H);
+	FeMultiply(r.Z, F, G);
+}
+
+// madd-2008-hwcd-3, 7M
+static void EdAdd(EdwardsPoint &r, const EdwardsPoint &p, const EdwardsNiels &q)
+{
+	Fe A, B, C, D, E, F, G, H;
+	FeSubtract(A, p.Y, p.X);
+	FeMultiply(A, A, q.YminusX);
+	FeAdd(B, p.Y, p.X);
+	FeMultiply(B, B, q.YplusX);
+	FeMultiply(C, p.T, q.XY2d);
+	FeAdd(D, p.Z, p.Z);
+	FeSubtract(E, B, A);
+	FeSubtract(F, D, C);
+	FeAdd(G, D, C);
+	FeAdd(H, B, A);
+	FeMultiply(r.X, E, F);
+	FeMultiply(r.Y, G, H);
+	FeMultiply(r.T, E, H);
+	FeMultiply(r.Z, F, G);
+}
+
+// add-2008-hwcd-3, 8M
+static void EdAdd(EdwardsPoint &r, const EdwardsPoint &p, const EdwardsCached &q)
+{
+	Fe A, B, C, D, E, F, G, H;
+	FeSubtract(A, p.Y, p.X);
+	FeMultiply(A, A, q.YminusX);
+	FeAdd(B, p.Y, p.X);
+	FeMultiply(B, B, q.YplusX);
+	FeMultiply(C, p.T, q.T2d);
+	FeMultiply(D, p.Z, q.Z2);
+	FeSubtract(E, B, A);
+	FeSubtract(F, D, C);
+	FeAdd(G, D, C);
+	FeAdd(H, B, A);
+	FeMultiply(r.X, E, F);
+	FeMultiply(r.Y, G, H);
+	FeMultiply(r.T, E, H);
+	FeMultiply(r.Z, F, G);
+}
+
+static void EdToCached(EdwardsCached &r, const EdwardsPoint &p)
+{
+	FeAdd(r.YplusX, p.Y, p.X);
+	FeSubtract(r.YminusX, p.Y, p.X);
+	FeAdd(r.Z2, p.Z, p.Z);
+	FeMultiply(r.T2d, p.T, s_2d);
+}
+
+static void EdToNiels(EdwardsNiels &r, const EdwardsPoint &p)
+{
+	Fe zInv, x, y;
+	FeInvert(zInv, p.Z);
+	FeMultiply(x, p.X, zInv);
+	FeMultiply(y, p.Y, zInv);
+	FeAdd(r.YplusX, y, x);
+	FeSubtract(r.YminusX, y, x);
+	FeMultiply(r.XY2d, x, y);
+	FeMultiply(r.XY2d, r.XY2d, s_2d);
+}
+
+static void EdEncode(byte *s, const EdwardsPoint &p)
+{
+	Fe zInv, x, y;
+	FeInvert(zInv, p.Z);
+	FeMultiply(x, p.X, zInv);
+	FeMultiply(y, p.Y, zInv);
+	FeToBytes(s, y);
+	s[31] |= byte(FeIsNegative(x) << 7);
+}
+
+// RFC 8032 section 5.1.3, rejects non canonical y and encodings that are not on the curve
+static bool EdDecode(EdwardsPoint &r, const byte *s)
+{
+	byte check[32];
+	Fe u, v, v3, x, vxx;
+
+	FeFromBytes(r.Y, s);
+	FeToBytes(check, r.Y);
+	check[31] |= s[31] & 0x80;
+	if (!VerifyBufsEqual(check, s, 32))
+		return false;
+
+	// x^2 = u/v with u = y^2 - 1, v = dy^2 + 1, candidate x = u v^3 (u v^7)^((p-5)/8)
+	FeSquare(u, r.Y);
+	FeMultiply(v, u, s_d);
+	FeSubtract(u, u, s_one);
+	FeAdd(v, v, s_one);
+
+	FeSquare(v3, v);
+	FeMultiply(v3, v3, v);
+	FeSquare(x, v3);
+	FeMultiply(x, x, v);
+	FeMultiply(x, x, u);
+	FePower22523(x, x);
+	FeMultiply(x, x, v3);
+	FeMultiply(x, x, u);
+
+	FeSquare(vxx, x);
+	FeMultiply(vxx, vxx, v);
+	FeSubtract(v, vxx, u);
+	if (!FeIsZero(v))
+	{
+		FeAdd(v, vxx, u);
+		if (!FeIsZero(v))
+			return false;
+		FeMultiply(x, x, s_sqrtm1);
+	}
+
+	const bool sign = (s[31] >> 7) != 0;
+	if (FeIsZero(x) && sign)
+		return false;
+	if (FeIsNegative(x) != sign)
+		FeNegate(x, x);
+
+	r.X = x;
+	r.Z = s_one;
+	FeMultiply(r.T, x, r.Y);
+	return true;
+}
+
+// ********************************************************
+
+// 64 signed radix 16 digits in [-8, 8] of a 256-bit little endian scalar below 2^255
+static void EdRadix16(signed char *e, const byte *a)
+{
+	for (unsigned int i=0; i<32; i++)
+	{
+		e[2*i+0] = a[i] & 15;
+		e[2*i+1] = (a[i] >> 4) & 15;
+	}
+
+	signed char carry = 0;
+	for (unsigned int i=0; i<63; i++)
+	{
+		e[i] += carry;
+		carry = (e[i] + 8) >> 4;
+		e[i] -= carry << 4;
+	}
+	e[63] += carry;
+}
+
+static inline word64 EdEqual(unsigned int a, unsigned int b)
+{
+	return (word64(a ^ b) - 1) >> 63;
+}
+
+// the fixed base tables, m_table[i][j] = (j+1) * 256^i * B
+class Ed25519BaseTable
+{
+public:
+	Ed25519BaseTable()
+	{
+		static const byte encodedBase[32] = {
+			0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+			0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66};
+
+		EdwardsPoint base, p;
+		EdwardsCached c;
+		EdDecode(base, encodedBase);
+
+		for (unsigned int i=0; i<32; i++)
+		{
+			EdToCached(c, base);
+			p = base;
+			for (unsigned int j=0; j<8; j++)
+			{
+				EdToNiels(m_table[i][j], p);
+				EdAdd(p, p, c);
+			}
+			for (unsigned int j=0; j<8; j++)
+				EdDouble(base, base);
+		}
+	}
+
+	// r = e * 256^i * B for e in [-8, 8], scanning the whole row
+	void Select(EdwardsNiels &r, unsigned int i, signed char e) const
+	{
+		const unsigned int negative = (unsigned int)((byte)e >> 7);
+		const unsigned int absolute = (unsigned int)(e - ((-(int)negative & e) << 1));
+
+		r.YplusX = s_one;
+		r.YminusX = s_one;
+		r.XY2d = s_zero;
+		for (unsigned int j=0; j<8; j++)
+		{
+			const word64 move = EdEqual(absolute, j+1);
+			FeConditionalMove(r.YplusX, m_table[i][j].YplusX, move);
+			FeConditionalMove(r.YminusX, m_table[i][j].YminusX, move);
+			FeConditionalMove(r.XY2d, m_table[i][j].XY2d, move);
+		}
+
+		Fe negXY2d;
+		FeNegate(negXY2d, r.XY2d);
+		FeConditionalSwap(r.YplusX, r.YminusX, negative);
+		FeConditionalMove(r.XY2d, negXY2d, negative);
+	}
+
+private:
+	EdwardsNiels m_table[32][8];
+};
+
+// r = a * B for a 256-bit little endian scalar below 2^255, in constant time
+static void EdMultiplyBase(EdwardsPoint &r, const byte *a)
+{
+	const Ed25519BaseTable &table = Singleton<Ed25519BaseTable>().Ref();
+	signed char e[64];
+	EdwardsNiels t;
+	EdRadix16(e, a);
+
+	EdIdentity(r);
+	for (unsigned int i=1; i<64; i+=2)
+	{
+		table.Select(t, i/2, e[i]);
+		EdAdd(r, r, t);
+	}
+
+	EdDouble(r, r);
+	EdDouble(r, r);
+	EdDouble(r, r);
+	EdDouble(r, r);
+
+	for (unsigned int i=0; i<64; i+=2)
+	{
+		table.Select(t, i/2, e[i]);
+		EdAdd(r, r, t);
+	}
+}
+
+// r = a * P for a public scalar below 2^255, in variable time
+static void EdMultiplyVartime(EdwardsPoint &r, const EdwardsPoint &p, const byte *a)
+{
+	EdwardsCached table[8], negative;
+	EdwardsPoint q = p;
+	signed char e[64];
+	EdRadix16(e, a);
+
+	// table[j] = (j+1)*P
+	EdToCached(table[0], p);
+	for (unsigned int j=1; j<8; j++)
+	{
+		EdAdd(q, q, table[0]);
+		EdToCached(table[j], q);
+	}
+
+	EdIdentity(r);
+	for (int i=63; i>=0; i--)
+	{
+		if (i != 63)
+		{
+			EdDouble(r, r);
+			EdDouble(r, r);
+			EdDouble(r, r);
+			EdDouble(r, r);
+		}
+		if (e[i] > 0)
+			EdAdd(r, r, table[e[i]-1]);
+		else if (e[i] < 0)
+		{
+			const EdwardsCached &c = table[-e[i]-1];
+			negative.YplusX = c.YminusX;
+			negative.YminusX = c.YplusX;
+			negative.Z2 = c.Z2;
+			FeNegate(negative.T2d, c.T2d);
+			EdAdd(r, r, negative);
+		}
+	}
+}
+
+// ********************************************************
+
+// Scalars mod l = 2^252 + 27742317777372353535851937790883648493 are signed 21-bit limbs as in
+// the sc_reduce and sc_muladd of the RFC 8032 reference code, so secret scalars are handled in
+// fixed time. Since 2^252 = -(l - 2^252) mod l, a limb i >= 12 is folded into limbs i-12 to i-7
+// with the limbs of 2^252 - l below.
+
+typedef long long Ed25519ScalarLimb;
+
+static const Ed25519ScalarLimb s_ed25519Fold[6] = {666643, 470296, 654183, -997805, 136657, -683901};
+
+// little endian l, for the range check of S
+static const byte s_ed25519GroupOrder[32] = {
+	0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10};
+
+// limb i of a little endian number of length bytes, all its remaining bits if last
+static inline Ed25519ScalarLimb Ed25519LoadLimb(const byte *a, size_t length, unsigned int i, bool last)
+{
+	const unsigned int bit = 21*i;
+	word64 v = 0;
+	for (unsigned int j=0; j<4 && bit/8+j<length; j++)
+		v |= word64(a[bit/8+j]) << (8*j);
+	v >>= bit%8;
+	return Ed25519ScalarLimb(last ? v : v & 0x1fffff);
+}
+
+static inline void Ed25519FoldLimb(Ed25519ScalarLimb *s, unsigned int i)
+{
+	for (unsigned int j=0; j<6; j++)
+		s[i-12+j] += s[i] * s_ed25519Fold[j];
+	s[i] = 0;
+}
+
+// moves limb i above 2^20 in absolute value, rounded, into limb i+1
+static inline void Ed25519CarryRounded(Ed25519ScalarLimb *s, unsigned int i)
+{
+	const Ed25519ScalarLimb carry = (s[i] + (1 << 20)) >> 21;
+	s[i+1] += carry;
+	s[i] -= carry * (Ed25519ScalarLimb(1) << 21);
+}
+
+static inline void Ed25519Carry(Ed25519ScalarLimb *s, unsigned int i)
+{
+	const Ed25519ScalarLimb carry = s[i] >> 21;
+	s[i+1] += carry;
+	s[i] -= carry * (Ed25519ScalarLimb(1) << 21);
+}
+
+// writes s mod l as 32 little endian bytes, for 24 limbs s with the carries the reference code has
+// done at this point
+static void Ed25519ReduceLimbs(byte *r, Ed25519ScalarLimb *s)
+{
+	unsigned int i;
+	for (i=23; i>=18; i--)
+		Ed25519FoldLimb(s, i);
+	for (i=6; i<=16; i+=2)
+		Ed25519CarryRounded(s, i);
+	for (i=7; i<=15; i+=2)
+		Ed25519CarryRounded(s, i);
+
+	for (i=17; i>=12; i--)
+		Ed25519FoldLimb(s, i);
+	for (i=0; i<=10; i+=2)
+		Ed25519CarryRounded(s, i);
+	for (i=1; i<=11; i+=2)
+		Ed25519CarryRounded(s, i);
+
+	Ed25519FoldLimb(s, 12);
+	for (i=0; i<=11; i++)
+		Ed25519Carry(s, i);
+	Ed25519FoldLimb(s, 12);
+	for (i=0; i<=10; i++)
+		Ed25519Carry(s, i);
+
+	word64 bits = 0;
+	unsigned int count = 0, j = 0;
+	for (i=0; i<12; i++)
+	{
+		bits |= word64(s[i]) << count;
+		for (count += 21; count >= 8; count -= 8, bits >>= 8)
+			r[j++] = byte(bits);
+	}
+	r[j] = byte(bits);
+}
+
+// writes a mod l, for a little endian number of 64 bytes, as 32 little endian bytes
+static void Ed25519ReduceScalar(byte *r, const byte *a)
+{
+	FixedSizeSecBlock<Ed25519ScalarLimb, 24> s;
+	for (unsigned int i=0; i<24; i++)
+		s[i] = Ed25519LoadLimb(a, 64, i, i == 23);
+	Ed25519ReduceLimbs(r, s);
+}
+
+// writes a*b + c mod l, for little endian numbers of 32 bytes, as 32 little endian bytes
+static void Ed25519MultiplyAdd(byte *r, const byte *a, const byte *b, const byte *c)
+{
+	FixedSizeSecBlock<Ed25519ScalarLimb, 12> x, y;
+	FixedSizeSecBlock<Ed25519ScalarLimb, 24> s;
+	unsigned int i, j;
+	for (i=0; i<12; i++)
+	{
+		x[i] = Ed25519LoadLimb(a, 32, i, i == 11);
+		y[i] = Ed25519LoadLimb(b, 32, i, i == 11);
+		s[i] = Ed25519LoadLimb(c, 32, i, i == 11);
+		s[i+12] = 0;
+	}
+	for (i=0; i<12; i++)
+		for (j=0; j<12; j++)
+			s[i+j] += x[i] * y[j];
+
+	for (i=0; i<=22; i+=2)
+		Ed25519CarryRounded(s, i);
+	for (i=1; i<=21; i+=2)
+		Ed25519CarryRounded(s, i);
+	Ed25519ReduceLimbs(r, s);
+}
+
+// returns whether a little endian number of 32 bytes is below l
+static bool Ed25519IsReduced(const byte *a)
+{
+	for (unsigned int i=32; i-- > 0; )
+		if (a[i] != s_ed25519GroupOrder[i])
+			return a[i] < s_ed25519GroupOrder[i];
+	return false;
+}
+
+// ********************************************************
+
+void x25519::ClampPrivateKey(byte *privateKey)
+{
+	privateKey[0] &= 248;
+	privateKey[31] &= 127;
+	privateKey[31] |= 64;
+}
+
+void x25519::GeneratePrivateKey(RandomNumberGenerator &rng, byte *privateKey) const
+{
+	rng.GenerateBlock(privateKey, SECRET_KEYLENGTH);
+	ClampPrivateKey(privateKey);
+}
+
+void x25519::GeneratePublicKey(RandomNumberGenerator &rng, const byte *privateKey, byte *publicKey) const
+{
+	FixedSizeSecBlock<byte, SECRET_KEYLENGTH> k;
+	memcpy(k, privateKey, SECRET_KEYLENGTH);
+	ClampPrivateKey(k);
+
+	// u = (1 + y)/(1 - y) = (Z + Y)/(Z - Y) maps the Edwards point to the Montgomery curve
+	EdwardsPoint p;
+	EdMultiplyBase(p, k);
+	Fe n, d;
+	FeAdd(n, p.Z, p.Y);
+	FeSubtract(d, p.Z, p.Y);
+	FeInvert(d, d);
+	FeMultiply(n, n, d);
+	FeToBytes(publicKey, n);
+}
+
+// RFC 7748 section 5
+bool x25519::Agree(byte *agreedValue, const byte *privateKey, const byte *otherPublicKey, bool validateOtherPublicKey) const
+{
+	FixedSizeSecBlock<byte, SECRET_KEYLENGTH> k;
+	memcpy(k, privateKey, SECRET_KEYLENGTH);
+	ClampPrivateKey(k);
+
+	Fe x1, x2 = s_one, z2 = s_zero, x3, z3 = s_one;
+	Fe A, AA, B, BB, E, C, D, DA, CB, t;
+	FeFromBytes(x1, otherPublicKey);
+	x3 = x1;
+
+	word64 swap = 0;
+	for (int i=254; i>=0; i--)
+	{
+		const word64 bit = (k[i/8] >> (i%8)) & 1;
+		swap ^= bit;
+		FeConditionalSwap(x2, x3, swap);
+		FeConditionalSwap(z2, z3, swap);
+		swap = bit;
+
+		FeAdd(A, x2, z2);
+		FeSquare(AA, A);
+		FeSubtract(B, x2, z2);
+		FeSquare(BB, B);
+		FeSubtract(E, AA, BB);
+		FeAdd(C, x3, z3);
+		FeSubtract(D, x3, z3);
+		FeMultiply(DA, D, A);
+		FeMultiply(CB, C, B);
+		FeAdd(t, DA, CB);
+		FeSquare(x3, t);
+		FeSubtract(t, DA, CB);
+		FeSquare(t, t);
+		FeMultiply(z3, x1, t);
+		FeMultiply(x2, AA, BB);
+		FeMultiplyA24(t, E);
+		FeAdd(t, AA, t);
+		FeMultiply(z2, E, t);
+	}
+	FeConditionalSwap(x2, x3, swap);
+	FeConditionalSwap(z2, z3, swap);
+
+	FeInvert(z2, z2);
+	FeMultiply(x2, x2, z2);
+	FeToBytes(agreedValue, x2);
+
+	byte nonzero = 0;
+	for (unsigned int i=0; i<SHARED_KEYLENGTH; i++)
+		nonzero |= agreedValue[i];
+	return nonzero != 0;
+}
+
+// ********************************************************
+
+void ed25519PrivateKey::Initialize(const byte *secretKey)
+{
+	FixedSizeSecBlock<byte, 64> h;
+	memcpy(m_secretKey, secretKey, SECRET_KEYLENGTH);
+	SHA512().CalculateDigest(h, secretKey, SECRET_KEYLENGTH);
+	memcpy(m_scalar, h, 32);
+	memcpy(m_prefix, h+32, 32);
+	x25519::ClampPrivateKey(m_scalar);
+
+	EdwardsPoint A;
+	EdMultiplyBase(A, m_scalar);
+	EdEncode(m_publicKey, A);
+}
+
+void ed25519PrivateKey::GenerateRandom(RandomNumberGenerator &rng, const NameValuePairs &params)
+{
+	FixedSizeSecBlock<byte, SECRET_KEYLENGTH> secretKey;
+	rng.GenerateBlock(secretKey, SECRET_KEYLENGTH);
+	Initialize(secretKey);
+}
+
+void ed25519PrivateKey::AssignFrom(const NameValuePairs &source)
+{
+	if (!source.GetThisObject(*this))
+		throw InvalidArgument("ed25519PrivateKey: source does not contain an Ed25519 private key");
+}
+
+bool ed25519PrivateKey::Validate(RandomNumberGenerator &rng, unsigned int level) const
+{
+	if (level < 1)
+		return true;
+
+	ed25519PrivateKey check;
+	check.Initialize(m_secretKey);
+	return VerifyBufsEqual(check.m_publicKey, m_publicKey, PUBLIC_KEYLENGTH);
+}
+
+void ed25519PublicKey::AssignFrom(const NameValuePairs &source)
+{
+	const ed25519PrivateKey *privateKey = NULL;
+	if (source.GetThisPointer(privateKey))
+		Initialize(privateKey->GetPublicKeyBytes());
+	else if (!source.GetThisObject(*this))
+		throw InvalidArgument("ed25519PublicKey: source does not contain an Ed25519 key");
+}
+
+bool ed25519PublicKey::Validate(RandomNumberGenerator &rng, unsigned int level) const
+{
+	if (level < 1)
+		return true;
+
+	EdwardsPoint A;
+	return EdDecode(A, m_publicKey);
+}
+
+// ********************************************************
+
+// buffers the message, and the signature when verifying
+class ed25519_MessageAccumulator : public PK_MessageAccumulator
+{
+public:
+	ed25519_MessageAccumulator() {memset(m_signature, 0, sizeof(m_signature));}
+
+	void Update(const byte *input, size_t length)
+		{m_message.append((const char *)input, length);}
+	void Restart()
+		{m_message.clear();}
+
+	const byte * GetMessage() const {return (const byte *)m_message.data();}
+	size_t GetMessageLength() const {return m_message.size();}
+
+	std::string m_message;
+	byte m_signature[64];
+};
+
+PK_MessageAccumulator * ed25519Signer::NewSignatureAccumulator(RandomNumberGenerator &rng) const
+{
+	return new ed25519_MessageAccumulator;
+}
+
+// RFC 8032 section 5.1.6
+size_t ed25519Signer::SignAndRestart(RandomNumberGenerator &rng, PK_MessageAccumulator &messageAccumulator, byte *signature, bool restart) const
+{
+	ed25519_MessageAccumulator &ma = static_cast<ed25519_MessageAccumulator &>(messageAccumulator);
+	FixedSizeSecBlock<byte, 64> h;
+	FixedSizeSecBlock<byte, 32> r;
+	SHA512 hash;
+
+	// r = H(prefix || M) mod l, R = rB
+	hash.Update(m_key.GetPrefixBytes(), 32);
+	hash.Update(ma.GetMessage(), ma.GetMessageLength());
+	hash.Final(h);
+	Ed25519ReduceScalar(r, h);
+
+	EdwardsPoint R;
+	EdMultiplyBase(R, r);
+	EdEncode(signature, R);
+
+	// k = H(R || A || M) mod l, S = r + ka mod l
+	hash.Update(signature, 32);
+	hash.Update(m_key.GetPublicKeyBytes(), 32);
+	hash.Update(ma.GetMessage(), ma.GetMessageLength());
+	hash.Final(h);
+
+	FixedSizeSecBlock<byte, 32> k;
+	Ed25519ReduceScalar(k, h);
+	Ed25519MultiplyAdd(signature+32, k, m_key.GetScalarBytes(), r);
+
+	if (restart)
+		ma.Restart();
+	return SIGNATURE_LENGTH;
+}
+
+PK_MessageAccumulator * ed25519Verifier::NewVerificationAccumulator() const
+{
+	return new ed25519_MessageAccumulator;
+}
+
+void ed25519Verifier::InputSignature(PK_MessageAccumulator &messageAccumulator, const byte *signature, size_t signatureLength) const
+{
+	ed25519_MessageAccumulator &ma = static_cast<ed25519_MessageAccumulator &>(messageAccumulator);
+	memset(ma.m_signature, 0xff, SIGNATURE_LENGTH);
+	if (signatureLength == SIGNATURE_LENGTH)
+		memcpy(ma.m_signature, signature, SIGNATURE_LENGTH);
+}
+
+// RFC 8032 section 5.1.7, checks that encode(SB - kA) equals R
+bool ed25519Verifier::VerifyAndRestart(PK_MessageAccumulator &messageAccumulator) const
+{
+	ed25519_MessageAccumulator &ma = static_cast<ed25519_MessageAccumulator &>(messageAccumulator);
+	const byte *signature = ma.m_signature;
+	bool valid = false;
+
+	EdwardsPoint A;
+	if (Ed25519IsReduced(signature+32) && EdDecode(A, m_key.GetPublicKeyBytes()))
+	{
+		byte h[64], k[32], check[32];
+		SHA512 hash;
+		hash.Update(signature, 32);
+		hash.Update(m_key.GetPublicKeyBytes(), 32);
+		hash.Update(ma.GetMessage(), ma.GetMessageLength());
+		hash.Final(h);
+		Ed25519ReduceScalar(k, h);
+
+		EdwardsPoint sB, kA;
+		EdwardsCached c;
+		FeNegate(A.X, A.X);
+		FeNegate(A.T, A.T);
+		EdMultiplyVartime(kA, A, k);
+		EdMultiplyBase(sB, signature+32);
+		EdToCached(c, kA);
+		EdAdd(sB, sB, c);
+		EdEncode(check, sB);
+		valid = VerifyBufsEqual(check, signature, 32);
+	}
+
+	ma.Restart();
+	return valid;
+}
+
+NAMESPACE_END
+
+#endif
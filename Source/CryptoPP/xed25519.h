@@ -0,0 +1,188 @@
+#ifndef CRYPTOPP_XED25519_H
+#define CRYPTOPP_XED25519_H
+
+/** \file
+	X25519 key agreement (RFC 7748) and Ed25519 signatures (RFC 8032)
+*/
+
+#include "cryptlib.h"
+#include "secblock.h"
+#include "algparam.h"
+
+NAMESPACE_BEGIN(CryptoPP)
+
+//! X25519 key agreement over Curve25519, RFC 7748
+/*! Private keys are 32 random bytes, clamped as described in the RFC. Public keys and
+	agreed values are little endian u-coordinates. Agreement runs the constant time
+	Montgomery ladder on radix 2^51 field elements, key generation uses the fixed
+	base tables of Ed25519 and maps the result to the Montgomery curve.
+	\note Agree() returns false if the agreed value is zero, which happens exactly when
+	the other public key is a point of small order */
+class CRYPTOPP_DLL x25519 : public SimpleKeyAgreementDomain, public CryptoParameters
+{
+public:
+	enum {SECRET_KEYLENGTH = 32, PUBLIC_KEYLENGTH = 32, SHARED_KEYLENGTH = 32};
+
+	static std::string CRYPTOPP_API StaticAlgorithmName() {return "X25519";}
+	std::string AlgorithmName() const {return StaticAlgorithmName();}
+
+	CryptoParameters & AccessCryptoParameters() {return *this;}
+
+	// CryptoMaterial, the domain has no parameters
+	bool GetVoidValue(const char *name, const std::type_info &valueType, void *pValue) const
+		{return GetValueHelper(this, name, valueType, pValue).Assignable();}
+	void AssignFrom(const NameValuePairs &source) {}
+	bool Validate(RandomNumberGenerator &rng, unsigned int level) const {return true;}
+
+	unsigned int AgreedValueLength() const {return SHARED_KEYLENGTH;}
+	unsigned int PrivateKeyLength() const {return SECRET_KEYLENGTH;}
+	unsigned int PublicKeyLength() const {return PUBLIC_KEYLENGTH;}
+
+	void GeneratePrivateKey(RandomNumberGenerator &rng, byte *privateKey) const;
+	void GeneratePublicKey(RandomNumberGenerator &rng, const byte *privateKey, byte *publicKey) const;
+	bool Agree(byte *agreedValue, const byte *privateKey, const byte *otherPublicKey, bool validateOtherPublicKey=true) const;
+
+	//! clears bits 0, 1, 2 and 255 and sets bit 254 of a private key
+	static void ClampPrivateKey(byte *privateKey);
+};
+
+//! Ed25519 private key, the 32 byte secret of RFC 8032 together with the values derived from it
+class CRYPTOPP_DLL ed25519PrivateKey : public PrivateKey
+{
+public:
+	enum {SECRET_KEYLENGTH = 32, PUBLIC_KEYLENGTH = 32};
+
+	ed25519PrivateKey() {memset(m_publicKey, 0, sizeof(m_publicKey));}
+
+	//! hashes the secret key and computes the public key
+	void Initialize(const byte *secretKey);
+
+	const byte * GetSecretKeyBytes() const {return m_secretKey;}
+	const byte * GetPublicKeyBytes() const {return m_publicKey;}
+	//! the clamped scalar, little endian
+	const byte * GetScalarBytes() const {return m_scalar;}
+	//! the second half of the hashed secret key, used to derive the per message nonce
+	const byte * GetPrefixBytes() const {return m_prefix;}
+
+	bool GetVoidValue(const char *name, const std::type_info &valueType, void *pValue) const
+		{return GetValueHelper(this, name, valueType, pValue).Assignable();}
+	void AssignFrom(const NameValuePairs &source);
+	bool Validate(RandomNumberGenerator &rng, unsigned int level) const;
+	void GenerateRandom(RandomNumberGenerator &rng, const NameValuePairs &params = g_nullNameValuePairs);
+
+private:
+	FixedSizeSecBlock<byte, SECRET_KEYLENGTH> m_secretKey, m_scalar, m_prefix;
+	byte m_publicKey[PUBLIC_KEYLENGTH];
+};
+
+//! Ed25519 public key, the encoded point A of RFC 8032
+class CRYPTOPP_DLL ed25519PublicKey : public PublicKey
+{
+public:
+	enum {PUBLIC_KEYLENGTH = 32};
+
+	ed25519PublicKey() {memset(m_publicKey, 0, sizeof(m_publicKey));}
+
+	void Initialize(const byte *publicKey) {memcpy(m_publicKey, publicKey, PUBLIC_KEYLENGTH);}
+
+	const byte * GetPublicKeyBytes() const {return m_publicKey;}
+
+	bool GetVoidValue(const char *name, const std::type_info &valueType, void *pValue) const
+		{return GetValueHelper(this, name, valueType, pValue).Assignable();}
+	//! accepts another ed25519PublicKey or an ed25519PrivateKey
+	void AssignFrom(const NameValuePairs &source);
+	//! checks that the key decodes to a point on the curve
+	bool Validate(RandomNumberGenerator &rng, unsigned int level) const;
+
+private:
+	byte m_publicKey[PUBLIC_KEYLENGTH];
+};
+
+//! signer for PureEdDSA over edwards25519 with SHA-512, RFC 8032
+/*! Signing is deterministic and needs the whole message twice, so the accumulator
+	buffers it. Nonces and public keys are computed in constant time with the fixed base
+	tables, and S = r + ka mod l in fixed width limbs. */
+class CRYPTOPP_DLL ed25519Signer : public PK_Signer
+{
+public:
+	enum {SIGNATURE_LENGTH = 64};
+
+	ed25519Signer() {}
+	//! creates a signer from a 32 byte secret key
+	ed25519Signer(const byte *secretKey) {m_key.Initialize(secretKey);}
+	//! creates a signer with a new random key
+	ed25519Signer(RandomNumberGenerator &rng) {m_key.GenerateRandom(rng);}
+
+	static std::string CRYPTOPP_API StaticAlgorithmName() {return "Ed25519";}
+	std::string AlgorithmName() const {return StaticAlgorithmName();}
+
+	PrivateKey & AccessPrivateKey() {return m_key;}
+	const PrivateKey & GetPrivateKey() const {return m_key;}
+	ed25519PrivateKey & AccessKey() {return m_key;}
+	const ed25519PrivateKey & GetKey() const {return m_key;}
+
+	size_t SignatureLength() const {return SIGNATURE_LENGTH;}
+	size_t MaxRecoverableLength() const {return 0;}
+	size_t MaxRecoverableLengthFromSignatureLength(size_t signatureLength) const {return 0;}
+	bool IsProbabilistic() const {return false;}
+	bool AllowNonrecoverablePart() const {return true;}
+	bool RecoverablePartFirst() const {return false;}
+
+	PK_MessageAccumulator * NewSignatureAccumulator(RandomNumberGenerator &rng) const;
+	void InputRecoverableMessage(PK_MessageAccumulator &messageAccumulator, const byte *recoverableMessage, size_t recoverableMessageLength) const
+		{throw NotImplemented("ed25519Signer: this object does not support recoverable messages");}
+	size_t SignAndRestart(RandomNumberGenerator &rng, PK_MessageAccumulator &messageAccumulator, byte *signature, bool restart=true) const;
+
+private:
+	ed25519PrivateKey m_key;
+};
+
+//! verifier for PureEdDSA over edwards25519 with SHA-512, RFC 8032
+/*! Signatures with a non canonical R or an S not below the group order are rejected. */
+class CRYPTOPP_DLL ed25519Verifier : public PK_Verifier
+{
+public:
+	enum {SIGNATURE_LENGTH = 64};
+
+	ed25519Verifier() {}
+	//! creates a verifier from a 32 byte public key
+	ed25519Verifier(const byte *publicKey) {m_key.Initialize(publicKey);}
+	//! creates the verifier matching a signer
+	ed25519Verifier(const ed25519Signer &signer) {m_key.Initialize(signer.GetKey().GetPublicKeyBytes());}
+
+	static std::string CRYPTOPP_API StaticAlgorithmName() {return "Ed25519";}
+	std::string AlgorithmName() const {return StaticAlgorithmName();}
+
+	PublicKey & AccessPublicKey() {return m_key;}
+	const PublicKey & GetPublicKey() const {return m_key;}
+	ed25519PublicKey & AccessKey() {return m_key;}
+	const ed25519PublicKey & GetKey() const {return m_key;}
+
+	size_t SignatureLength() const {return SIGNATURE_LENGTH;}
+	size_t MaxRecoverableLength() const {return 0;}
+	size_t MaxRecoverableLengthFromSignatureLength(size_t signatureLength) const {return 0;}
+	bool IsProbabilistic() const {return false;}
+	bool AllowNonrecoverablePart() const {return true;}
+	bool RecoverablePartFirst() const {return false;}
+
+	PK_MessageAccumulator * NewVerificationAccumulator() const;
+	void InputSignature(PK_MessageAccumulator &messageAccumulator, const byte *signature, size_t signatureLength) const;
+	bool VerifyAndRestart(PK_MessageAccumulator &messageAccumulator) const;
+	DecodingResult RecoverAndRestart(byte *recoveredMessage, PK_MessageAccumulator &messageAccumulator) const
+		{throw NotImplemented("ed25519Verifier: this object does not support message recovery");}
+
+private:
+	ed25519PublicKey m_key;
+};
+
+//! Ed25519 signature scheme, RFC 8032
+struct ed25519
+{
+	static std::string CRYPTOPP_API StaticAlgorithmName() {return "Ed25519";}
+	typedef ed25519Signer Signer;
+	typedef ed25519Verifier Verifier;
+};
+
+NAMESPACE_END
+
+#endif
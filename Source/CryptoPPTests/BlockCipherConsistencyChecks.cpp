@@ -42,6 +42,107 @@ namespace CryptoPPTests
 #undef TEST_MACRO_ECB
 	}
 
+	template<class CIPHER> void RunTweakBatchCheck(const unsigned int BlockCount)
+	{
+		typename CIPHER::Encryption Encryptor;
+		typename CIPHER::Decryption Decryptor;
+		const size_t BlockSize=CIPHER::BLOCKSIZE,TweakLength=CIPHER::TWEAKLENGTH;
+
+		SecByteBlock Key(CIPHER::DEFAULT_KEYLENGTH);
+		SecByteBlock Tweaks(BlockCount*TweakLength);
+		SecByteBlock Counter(TweakLength);
+		SecByteBlock InBuffer(BlockCount*BlockSize);
+		SecByteBlock XorBuffer(BlockCount*BlockSize);
+		SecByteBlock BatchBuffer(BlockCount*BlockSize);
+		SecByteBlock SingleBuffer(BlockCount*BlockSize);
+
+		AutoSeededRandomPool RNG;
+		RNG.GenerateBlock(Key,Key.size());
+		RNG.GenerateBlock(Tweaks,Tweaks.size());
+		RNG.GenerateBlock(InBuffer,InBuffer.size());
+		RNG.GenerateBlock(XorBuffer,XorBuffer.size());
+		Encryptor.SetKey(Key,Key.size());
+		Decryptor.SetKey(Key,Key.size());
+
+		// a tweak per block, with and without xor
+		Encryptor.AdvancedProcessBlocksWithTweaks(InBuffer,XorBuffer,BatchBuffer,InBuffer.size(),0,Tweaks,TweakLength);
+		for(unsigned int i=0;i<BlockCount;++i)
+			Encryptor.ProcessAndXorBlockWithTweak(InBuffer+i*BlockSize,XorBuffer+i*BlockSize,SingleBuffer+i*BlockSize,Tweaks+i*TweakLength,TweakLength);
+		Assert::IsTrue(memcmp(BatchBuffer,SingleBuffer,BatchBuffer.size())==0,L"tweak array",LINE_INFO());
+		Decryptor.AdvancedProcessBlocksWithTweaks(SingleBuffer,XorBuffer,SingleBuffer,SingleBuffer.size(),BlockTransformation::BT_XorInput,Tweaks,TweakLength);
+		Assert::IsTrue(memcmp(InBuffer,SingleBuffer,InBuffer.size())==0,L"tweak array decryption",LINE_INFO());
+
+		// a counter that carries into the upper tweak word
+		memset(Counter,0xff,TweakLength);
+		Counter[8]=0;
+		Encryptor.AdvancedProcessBlocksWithTweakCounter(InBuffer,NULL,BatchBuffer,InBuffer.size(),0,Counter,TweakLength,3);
+		memset(Counter,0xff,TweakLength);
+		Counter[8]=0;
+		for(unsigned int i=0;i<BlockCount;++i)
+		{
+			Encryptor.ProcessAndXorBlockWithTweak(InBuffer+i*BlockSize,NULL,SingleBuffer+i*BlockSize,Counter,TweakLength);
+			word32 Carry=3;
+			for(unsigned int j=0;j<TweakLength;++j)
+			{
+				Carry+=Counter[j];
+				Counter[j]=byte(Carry);
+				Carry>>=8;
+			}
+		}
+		Assert::IsTrue(memcmp(BatchBuffer,SingleBuffer,BatchBuffer.size())==0,L"tweak counter",LINE_INFO());
+	}
+
+	// the whole buffer takes the widest parallel path, chunks of four blocks the narrowest one
+	template<class CIPHER> void RunParallelWidthCheck(const unsigned int Keylength,const unsigned int BlockCount)
+	{
+#define TEST_MACRO_WIDTH(Mode,Name,InPlace) \
+		{\
+			Mode Whole,Chunked;\
+			Whole.SetKeyWithIV(Key,Keylength,IV);\
+			Chunked.SetKeyWithIV(Key,Keylength,IV);\
+			memcpy(WholeBuffer,InBuffer,InBuffer.size());\
+			memcpy(ChunkedBuffer,InBuffer,InBuffer.size());\
+			Whole.ProcessData(WholeBuffer,InPlace ? WholeBuffer : InBuffer,InBuffer.size());\
+			for(size_t i=0;i<InBuffer.size();i+=ChunkSize)\
+				Chunked.ProcessData(ChunkedBuffer+i,(InPlace ? ChunkedBuffer : InBuffer)+i,STDMIN(ChunkSize,InBuffer.size()-i));\
+			Assert::IsTrue(memcmp(WholeBuffer,ChunkedBuffer,InBuffer.size())==0,Name,LINE_INFO());\
+		}
+
+		const size_t BlockSize=CIPHER::BLOCKSIZE,ChunkSize=4*BlockSize;
+		SecByteBlock Key(Keylength);
+		SecByteBlock IV(BlockSize);
+		SecByteBlock InBuffer(BlockCount*BlockSize);
+		SecByteBlock WholeBuffer(InBuffer.size());
+		SecByteBlock ChunkedBuffer(InBuffer.size());
+
+		AutoSeededRandomPool RNG;
+		RNG.GenerateBlock(Key,Key.size());
+		RNG.GenerateBlock(IV,IV.size());
+		RNG.GenerateBlock(InBuffer,InBuffer.size());
+		// the low counter byte wraps in the middle of a wide group
+		IV[BlockSize-1]=0xf5;
+
+		{
+			typename CIPHER::Encryption Whole(Key,Keylength),Chunked(Key,Keylength);
+			Whole.AdvancedProcessBlocks(InBuffer,NULL,WholeBuffer,InBuffer.size(),BlockTransformation::BT_AllowParallel);
+			for(size_t i=0;i<InBuffer.size();i+=ChunkSize)
+				Chunked.AdvancedProcessBlocks(InBuffer+i,NULL,ChunkedBuffer+i,STDMIN(ChunkSize,InBuffer.size()-i),BlockTransformation::BT_AllowParallel);
+			Assert::IsTrue(memcmp(WholeBuffer,ChunkedBuffer,InBuffer.size())==0,L"ECB encryption",LINE_INFO());
+		}
+		{
+			typename CIPHER::Decryption Whole(Key,Keylength),Chunked(Key,Keylength);
+			Whole.AdvancedProcessBlocks(InBuffer,NULL,WholeBuffer,InBuffer.size(),BlockTransformation::BT_AllowParallel);
+			for(size_t i=0;i<InBuffer.size();i+=ChunkSize)
+				Chunked.AdvancedProcessBlocks(InBuffer+i,NULL,ChunkedBuffer+i,STDMIN(ChunkSize,InBuffer.size()-i),BlockTransformation::BT_AllowParallel);
+			Assert::IsTrue(memcmp(WholeBuffer,ChunkedBuffer,InBuffer.size())==0,L"ECB decryption",LINE_INFO());
+		}
+		TEST_MACRO_WIDTH(typename CTR_Mode<CIPHER>::Encryption,L"CTR",false);
+		TEST_MACRO_WIDTH(typename CBC_Mode<CIPHER>::Decryption,L"CBC decryption",false);
+		TEST_MACRO_WIDTH(typename CBC_Mode<CIPHER>::Decryption,L"CBC decryption in place",true);
+
+#undef TEST_MACRO_WIDTH
+	}
+
 	TEST_CLASS(BlockCipherConsistencyChecks)
 	{
 	public:
@@ -52,6 +153,12 @@ namespace CryptoPPTests
 			RunConsistencyCheckBlockCipher<AES>(24,16,1024);
 			RunConsistencyCheckBlockCipher<AES>(32,16,1024);
 		}
+		TEST_METHOD(AESParallelWidthConsistency)
+		{
+			RunParallelWidthCheck<AES>(16,67);
+			RunParallelWidthCheck<AES>(24,67);
+			RunParallelWidthCheck<AES>(32,1000);
+		}
 		TEST_METHOD(SerpentConsistency)
 		{
 			RunConsistencyCheckBlockCipher<Serpent>(16,16,1024);
@@ -133,6 +240,12 @@ namespace CryptoPPTests
 			RunConsistencyCheckBlockCipher<Threefish_512>(64,64,1024);
 			RunConsistencyCheckBlockCipher<Threefish_1024>(128,128,1024);
 		}
+		TEST_METHOD(ThreefishTweakBatchConsistency)
+		{
+			RunTweakBatchCheck<Threefish_256>(11);
+			RunTweakBatchCheck<Threefish_512>(11);
+			RunTweakBatchCheck<Threefish_1024>(11);
+		}
 		/*TEST_METHOD(ThreefishConsistency)
 		{
 			RunConsistencyCheckBlockCipher<Threefish>(32,32,1024,false);
@@ -26,10 +26,595 @@ namespace CryptoPPTests
 		Assert::IsTrue(memcmp(InBuffer,OutBuffer,Decryptor->MaxPlaintextLength(Encryptor->CiphertextLength(BufferSize)))==0,L"",LINE_INFO());
 	}
 
+	// products, squares and Montgomery products of the operand triples A, B, M, the last two use the bottom and top half kernels
+	std::vector<Integer> IntegerKernelResults(const std::vector<Integer>& Operands)
+	{
+		std::vector<Integer> Results;
+		for(size_t i=0;i+2<Operands.size();i+=3)
+		{
+			const Integer &A=Operands[i], &B=Operands[i+1], &M=Operands[i+2];
+			Results.push_back(A*B);
+			Results.push_back(A.Squared());
+
+			MontgomeryRepresentation MR(M);
+			const Integer X=MR.ConvertIn(A%M), Y=MR.ConvertIn(B%M);
+			const Integer Product=MR.Multiply(X,Y), Square=MR.Square(X);
+			Results.push_back(MR.ConvertOut(Product));
+			Results.push_back(MR.ConvertOut(Square));
+			Assert::IsTrue(Results[Results.size()-2]==a_times_b_mod_c(A,B,M),L"Montgomery multiplication differs from a_times_b_mod_c.",LINE_INFO());
+			Assert::IsTrue(Results.back()==a_times_b_mod_c(A,A,M),L"Montgomery squaring differs from a_times_b_mod_c.",LINE_INFO());
+		}
+		return Results;
+	}
+
+	bool SameOtherPrimeInfos(const InvertibleRSAFunction& A,const InvertibleRSAFunction& B)
+	{
+		const std::vector<RSAOtherPrimeInfo> &X=A.GetOtherPrimeInfos(), &Y=B.GetOtherPrimeInfos();
+		if(X.size()!=Y.size())
+			return false;
+		for(size_t i=0;i<X.size();++i)
+			if(X[i].prime!=Y[i].prime || X[i].exponent!=Y[i].exponent || X[i].coefficient!=Y[i].coefficient)
+				return false;
+		return true;
+	}
+
+	void MultiPrimeRSACheck(unsigned int ModulusBits,unsigned int PrimeCount)
+	{
+		AutoSeededRandomPool RNG;
+		RSA::PrivateKey Key;
+		Key.Initialize(RNG,ModulusBits,65537,PrimeCount);
+		Assert::IsTrue(Key.GetPrimeCount()==PrimeCount && Key.Validate(RNG,3),L"Multi-prime RSA key is invalid.",LINE_INFO());
+
+		ByteQueue Queue;
+		Key.DEREncode(Queue);
+		RSA::PrivateKey Decoded;
+		Decoded.BERDecode(Queue);
+		Assert::IsTrue(Decoded.GetModulus()==Key.GetModulus() && Decoded.GetPrivateExponent()==Key.GetPrivateExponent() && SameOtherPrimeInfos(Decoded,Key),L"Multi-prime RSA key changed in the DER round trip.",LINE_INFO());
+
+		// PKCS #1 v1.5 signatures are deterministic, so both CRT variants have to give the same one
+		const byte Message[] = "multi-prime RSA";
+		RSASS<PKCS1v15,SHA256>::Signer Signer(Decoded);
+		RSASS<PKCS1v15,SHA256>::Verifier Verifier(Key);
+		RSAES<OAEP<SHA256> >::Encryptor Encryptor(Key);
+		RSAES<OAEP<SHA256> >::Decryptor Decryptor(Decoded);
+		SecByteBlock Signatures[2],Ciphertext(Encryptor.CiphertextLength(sizeof(Message))),Recovered(Decryptor.MaxPlaintextLength(Ciphertext.size()));
+		for(int Parallel=0;Parallel<2;++Parallel)
+		{
+			Signer.AccessKey().SetParallelCRT(Parallel!=0);
+			Decryptor.AccessKey().SetParallelCRT(Parallel!=0);
+
+			Signatures[Parallel].resize(Signer.MaxSignatureLength());
+			Signatures[Parallel].resize(Signer.SignMessage(RNG,Message,sizeof(Message),Signatures[Parallel]));
+			Assert::IsTrue(Verifier.VerifyMessage(Message,sizeof(Message),Signatures[Parallel],Signatures[Parallel].size()),L"Multi-prime RSA signature doesn't verify.",LINE_INFO());
+
+			Encryptor.Encrypt(RNG,Message,sizeof(Message),Ciphertext);
+			const DecodingResult Result = Decryptor.Decrypt(RNG,Ciphertext,Ciphertext.size(),Recovered);
+			Assert::IsTrue(Result.isValidCoding && Result.messageLength==sizeof(Message) && memcmp(Recovered,Message,sizeof(Message))==0,L"Multi-prime RSA decryption failed.",LINE_INFO());
+		}
+		Assert::IsTrue(Signatures[0]==Signatures[1],L"Parallel CRT gives another signature.",LINE_INFO());
+
+		// assigning by names takes the other primes along, and drops them when there are none
+		AlgorithmParameters Parameters = MakeParameters(Name::Modulus(),Key.GetModulus())(Name::PublicExponent(),Key.GetPublicExponent())
+			(Name::Prime1(),Key.GetPrime1())(Name::Prime2(),Key.GetPrime2())(Name::PrivateExponent(),Key.GetPrivateExponent())
+			(Name::ModPrime1PrivateExponent(),Key.GetModPrime1PrivateExponent())(Name::ModPrime2PrivateExponent(),Key.GetModPrime2PrivateExponent())
+			(Name::MultiplicativeInverseOfPrime2ModPrime1(),Key.GetMultiplicativeInverseOfPrime2ModPrime1());
+		RSA::PrivateKey Assigned;
+		Assigned.AssignFrom(CombinedNameValuePairs(Parameters,MakeParameters(Name::OtherPrimeInfos(),Key.GetOtherPrimeInfos())(Name::ParallelCRT(),true)));
+		Assert::IsTrue(SameOtherPrimeInfos(Assigned,Key) && Assigned.GetParallelCRT() && Assigned.Validate(RNG,3),L"Other primes weren't assigned.",LINE_INFO());
+		Assigned.AssignFrom(Decoded);
+		Assert::IsTrue(SameOtherPrimeInfos(Assigned,Key) && !Assigned.GetParallelCRT(),L"Other primes weren't assigned.",LINE_INFO());
+
+		RSA::PrivateKey TwoPrimeKey;
+		TwoPrimeKey.Initialize(RNG,1024);
+		Assigned.AssignFrom(TwoPrimeKey);
+		Assert::IsTrue(Assigned.GetPrimeCount()==2 && Assigned.Validate(RNG,3),L"Other primes weren't cleared.",LINE_INFO());
+		Assigned.AssignFrom(Key);
+		Assigned.AssignFrom(Parameters);
+		Assert::IsTrue(Assigned.GetPrimeCount()==2 && Assigned.GetParallelCRT()==Key.GetParallelCRT(),L"Other primes weren't cleared.",LINE_INFO());
+
+		// the other primes can be read back by name
+		std::vector<RSAOtherPrimeInfo> OtherPrimes;
+		bool ParallelCRT = true;
+		Assert::IsTrue(Key.GetValue(Name::OtherPrimeInfos(),OtherPrimes) && OtherPrimes.size()==PrimeCount-2 && Key.GetValue(Name::ParallelCRT(),ParallelCRT) && !ParallelCRT,L"Other primes can't be read by name.",LINE_INFO());
+	}
+
+	// batch verification of valid, tampered and wrong length signatures has to agree with VerifyMessage
+	void VerifyBatchCheck(const PK_Signer& Signer,const PK_Verifier& Verifier)
+	{
+		AutoSeededRandomPool RNG;
+		const size_t Count = 30;
+		std::vector<SecByteBlock> Messages(Count),Signatures(Count);
+		std::vector<PK_Verifier::SignedMessage> Items(Count);
+		for(size_t i=0;i<Count;++i)
+		{
+			Messages[i].resize(16+i);
+			RNG.GenerateBlock(Messages[i],Messages[i].size());
+			Signatures[i].resize(Signer.MaxSignatureLength());
+			Signatures[i].resize(Signer.SignMessage(RNG,Messages[i],Messages[i].size(),Signatures[i]));
+			switch(i%6)
+			{
+			case 1:	Messages[i][0]^=1;	break;
+			case 2:	Signatures[i][Signatures[i].size()/2]^=0x80;	break;
+			case 3:	Signatures[i].resize(Signatures[i].size()-1);	break;
+			case 4:	Signatures[i].CleanGrow(Signatures[i].size()+1);	break;
+			case 5:	memset(Signatures[i],0,Signatures[i].size());	break;
+			}
+			Items[i]=PK_Verifier::SignedMessage(Messages[i],Messages[i].size(),Signatures[i],Signatures[i].size());
+		}
+
+		for(int Parallel=0;Parallel<2;++Parallel)
+		{
+			const std::vector<bool> Valid = Verifier.VerifyBatch(&Items[0],Count,Parallel!=0);
+			Assert::IsTrue(Valid.size()==Count,L"VerifyBatch returned the wrong number of results.",LINE_INFO());
+			for(size_t i=0;i<Count;++i)
+			{
+				Assert::IsTrue(Valid[i]==Verifier.VerifyMessage(Items[i].message,Items[i].messageLength,Items[i].signature,Items[i].signatureLength),L"VerifyBatch differs from VerifyMessage.",LINE_INFO());
+				// the DL schemes read r and s from the start of a longer signature
+				if(i%6!=4)
+					Assert::IsTrue(Valid[i]==(i%6==0),L"VerifyBatch result is wrong.",LINE_INFO());
+			}
+		}
+	}
+
+	// k*P with the affine formulas of ECP through AbstractGroup, which never reaches the fixed width arithmetic
+	ECP::Point GenericMultiply(const ECP& Curve,const ECP::Point& P,const Integer& k)
+	{
+		ECP::Point R;
+		const Integer e = k.IsNegative() ? -k : k;
+		Curve.AbstractGroup<ECPPoint>::SimultaneousMultiply(&R,P,&e,1);
+		return k.IsNegative() ? Curve.Inverse(R) : R;
+	}
+
+	void NISTCurveCheck(const OID& CurveID)
+	{
+		AutoSeededRandomPool RNG;
+		ECDSA<ECP,SHA256>::PrivateKey Key;
+		Key.Initialize(RNG,CurveID);
+		ECDSA<ECP,SHA256>::PublicKey PublicKey;
+		Key.MakePublicKey(PublicKey);
+		const DL_GroupParameters_EC<ECP> &Parameters = Key.GetGroupParameters();
+		const ECP &Curve = Parameters.GetCurve();
+		const Integer &n = Parameters.GetSubgroupOrder();
+		const ECP::Point &G = Parameters.GetSubgroupGenerator();
+		Assert::IsTrue(Curve.HasFixedWidthArithmetic(),L"Fixed width arithmetic isn't used.",LINE_INFO());
+
+		const Integer Random(RNG,Integer::One(),n-1);
+		const Integer Scalars[] = {Integer::Zero(),Integer::One(),Integer::Two(),n-1,n,n+1,2*n+5,Integer::Power2(n.BitCount())-1,Integer(-1),-Random,-n,Random,Integer(RNG,Integer::One(),n-1)};
+		const size_t Count = sizeof(Scalars)/sizeof(Scalars[0]);
+		const ECP::Point Q = GenericMultiply(Curve,G,Integer(RNG,Integer::One(),n-1));
+		const ECP::Point Points[] = {G,Q,Curve.Inverse(Q),Curve.Identity()};
+		for(size_t i=0;i<sizeof(Points)/sizeof(Points[0]);++i)
+		{
+			const ECP::Point &P = Points[i];
+			for(size_t j=0;j<Count;++j)
+			{
+				const ECP::Point Expected = GenericMultiply(Curve,P,Scalars[j]);
+				Assert::IsTrue(Curve.ScalarMultiply(P,Scalars[j])==Expected,L"Fixed width scalar multiplication differs.",LINE_INFO());
+				if(i==0)
+				{
+					Assert::IsTrue(Parameters.ExponentiateBase(Scalars[j])==Expected,L"Fixed width base multiplication differs.",LINE_INFO());
+					const ECP::Point Cascade = GenericMultiply(Curve,PublicKey.GetPublicElement(),Scalars[Count-1-j]);
+					Assert::IsTrue(PublicKey.CascadeExponentiateBaseAndPublicElement(Scalars[j],Scalars[Count-1-j])==Curve.Add(Expected,Cascade),L"Fixed width cascade with the public element differs.",LINE_INFO());
+				}
+
+				// P == Q, Q == -P and sums that are the identity
+				const ECP::Point Others[] = {P,Curve.Inverse(P),Q,Curve.Identity()};
+				for(size_t k=0;k<sizeof(Others)/sizeof(Others[0]);++k)
+				{
+					const Integer OtherScalars[] = {Scalars[j],n-Scalars[j],Scalars[Count-1-j]};
+					for(size_t l=0;l<sizeof(OtherScalars)/sizeof(OtherScalars[0]);++l)
+					{
+						const ECP::Point Other = GenericMultiply(Curve,Others[k],OtherScalars[l]);
+						const ECP::Point Sum = Curve.Add(Expected,Other);
+						Assert::IsTrue(Curve.CascadeScalarMultiply(P,Scalars[j],Others[k],OtherScalars[l])==Sum,L"Fixed width cascade differs.",LINE_INFO());
+					}
+				}
+			}
+
+			std::vector<Integer> Positive;
+			for(size_t j=0;j<Count;++j)
+				if(Scalars[j].NotNegative())
+					Positive.push_back(Scalars[j]);
+			std::vector<ECP::Point> Results(Positive.size());
+			Curve.SimultaneousMultiply(&Results[0],P,&Positive[0],(unsigned int)Positive.size());
+			for(size_t j=0;j<Positive.size();++j)
+				Assert::IsTrue(Results[j]==GenericMultiply(Curve,P,Positive[j]),L"Fixed width simultaneous multiplication differs.",LINE_INFO());
+		}
+	}
+
+	void ECPCombTableCheck(const ECPCombTable& Table)
+	{
+		AutoSeededRandomPool RNG;
+		const unsigned int Words=Table.words;
+		const ECP Curve(ECPCombTable::ToInteger(Table.GetModulus(),Words),ECPCombTable::ToInteger(Table.GetA(),Words),ECPCombTable::ToInteger(Table.GetB(),Words));
+		const ECP::Point G(ECPCombTable::ToInteger(Table.GetGeneratorX(),Words),ECPCombTable::ToInteger(Table.GetGeneratorY(),Words));
+		const Integer n=ECPCombTable::ToInteger(Table.GetSubgroupOrder(),Words);
+		const unsigned int Blocks=ECPCombTable::TEETH*ECPCombTable::COMBS;
+		Assert::IsTrue(Curve.VerifyPoint(G) && Curve.HasFixedBaseTable(G),L"The comb table isn't found for its generator.",LINE_INFO());
+		Assert::IsTrue(Table.spacing==(n.BitCount()+Blocks-1)/Blocks,L"The comb spacing is wrong.",LINE_INFO());
+
+		// each entry is the sum of 2^((c*TEETH+i)*spacing) G over the bits i of j, as "cryptest ecct" writes it
+		for(unsigned int c=0;c<ECPCombTable::COMBS;++c)
+			for(unsigned int j=1;j<=ECPCombTable::ENTRIES;++j)
+			{
+				Integer k;
+				for(unsigned int i=0;i<ECPCombTable::TEETH;++i)
+					if(j>>i & 1)
+						k+=Integer::Power2((c*ECPCombTable::TEETH+i)*Table.spacing);
+				const word64* Entry=Table.GetPoint(c,j);
+				const ECP::Point Expected=GenericMultiply(Curve,G,k);
+				Assert::IsTrue(ECP::Point(ECPCombTable::ToInteger(Entry,Words),ECPCombTable::ToInteger(Entry+Words,Words))==Expected,L"A comb table entry is wrong.",LINE_INFO());
+			}
+
+		DL_GroupParameters_EC<ECP> Parameters;
+		Parameters.Initialize(Curve,G,n);
+		const Integer Random(RNG,Integer::One(),n-1);
+		const Integer Scalars[] = {Integer::Zero(),Integer::One(),n-1,n,n+1,2*n+3,Integer(-1),-Random,-n,Random,
+			Integer::Power2(Blocks*Table.spacing)-1,Integer::Power2(Blocks*Table.spacing),Integer(RNG,2*n.BitCount())};
+		for(size_t i=0;i<sizeof(Scalars)/sizeof(Scalars[0]);++i)
+		{
+			const ECP::Point Expected=GenericMultiply(Curve,G,Scalars[i]);
+			ECP::Point Result;
+			Assert::IsTrue(Curve.FixedBaseMultiply(Result,G,Scalars[i]),L"The comb table isn't used.",LINE_INFO());
+			Assert::IsTrue(Result==Expected,L"Comb multiplication failed.",LINE_INFO());
+			Assert::IsTrue(Parameters.ExponentiateBase(Scalars[i])==Expected,L"ExponentiateBase failed.",LINE_INFO());
+			if(Scalars[i].NotNegative())
+				Assert::IsTrue(Curve.ScalarMultiply(G,Scalars[i])==Expected,L"Comb and scalar multiplication differ.",LINE_INFO());
+		}
+	}
+
+	// term counts for the multi-scalar checks, on both sides of the switch from Straus to Pippenger,
+	// which is at about 200 terms for 256 bit scalars with signed digits and 250 for 160 bit exponents
+	const size_t MultiScalarCounts[] = {0,1,2,3,4,8,100,300,500};
+
+	// fills Scalars with full length random values and, term by term, zero, negative and n-1 scalars,
+	// and returns in Kind[i] which of the terms should repeat or invert the previous point
+	void MultiScalarTerms(RandomNumberGenerator& RNG,std::vector<Integer>& Scalars,std::vector<unsigned int>& Kind,size_t Count,unsigned int Bits,const Integer& n)
+	{
+		Scalars.resize(Count);
+		Kind.resize(Count);
+		for(size_t i=0;i<Count;++i)
+		{
+			Kind[i]=i%8;
+			Scalars[i]=Integer(RNG,Bits);
+			Scalars[i].SetBit(Bits-1);
+			if(Kind[i]==1)
+				Scalars[i]=Integer::Zero();
+			else if(Kind[i]==3)
+				Scalars[i].SetNegative();
+			else if((Kind[i]==4 || Kind[i]==5) && i>0)
+				Scalars[i]=Scalars[i-1];
+			else if(Kind[i]==6 && n.NotZero())
+				Scalars[i]=n-1;
+		}
+	}
+
+	void MultiScalarCheck(const OID& CurveID)
+	{
+		AutoSeededRandomPool RNG;
+		const DL_GroupParameters_EC<ECP> Parameters(CurveID);
+		const ECP &Curve = Parameters.GetCurve();
+		const Integer &n = Parameters.GetSubgroupOrder();
+		const ECP::Point &G = Parameters.GetSubgroupGenerator();
+		std::vector<Integer> Scalars;
+		std::vector<unsigned int> Kind;
+
+		for(size_t c=0;c<sizeof(MultiScalarCounts)/sizeof(MultiScalarCounts[0]);++c)
+		{
+			const size_t Count=MultiScalarCounts[c];
+			MultiScalarTerms(RNG,Scalars,Kind,Count,n.BitCount(),n);
+			std::vector<ECP::Point> Points(Count);
+			ECP::Point Expected=Curve.Identity();
+			for(size_t i=0;i<Count;++i)
+			{
+				if(Kind[i]==2)
+					Points[i]=Curve.Identity();
+				else if(Kind[i]==4 && i>0)
+					Points[i]=Curve.Inverse(Points[i-1]);
+				else if(Kind[i]==5 && i>0)
+					Points[i]=Points[i-1];
+				else
+					Points[i]=Curve.ScalarMultiply(G,Integer(RNG,Integer::One(),n-1));
+				// ECP::ScalarMultiply takes nonnegative scalars only on curves without fixed width arithmetic
+				ECP::Point Term=Curve.ScalarMultiply(Points[i],Scalars[i].AbsoluteValue());
+				if(Scalars[i].IsNegative())
+					Term=Curve.Inverse(Term);
+				Expected=Curve.Add(Expected,Term);
+			}
+
+			const ECP::Point *P = Count ? &Points[0] : NULL;
+			const Integer *k = Count ? &Scalars[0] : NULL;
+			Assert::IsTrue(Curve.MultiScalarMultiply(P,k,Count)==Expected,L"ECP multi-scalar multiplication failed.",LINE_INFO());
+			Assert::IsTrue(Curve.AbstractGroup<ECPPoint>::MultiScalarMultiply(P,k,Count)==Expected,L"Generic multi-scalar multiplication failed.",LINE_INFO());
+
+			if(Count)
+			{
+				const std::vector<Integer> Zeros(Count);
+				Assert::IsTrue(Curve.MultiScalarMultiply(P,&Zeros[0],Count)==Curve.Identity(),L"Zero scalars didn't give the identity.",LINE_INFO());
+				const std::vector<ECP::Point> Identities(Count,Curve.Identity());
+				Assert::IsTrue(Curve.MultiScalarMultiply(&Identities[0],k,Count)==Curve.Identity(),L"Identity points didn't give the identity.",LINE_INFO());
+			}
+		}
+	}
+
+	void MultiExponentiationCheck(const Integer& Modulus)
+	{
+		AutoSeededRandomPool RNG;
+		const ModularArithmetic MA(Modulus);
+		std::vector<Integer> Exponents;
+		std::vector<unsigned int> Kind;
+
+		for(size_t c=0;c<sizeof(MultiScalarCounts)/sizeof(MultiScalarCounts[0]);++c)
+		{
+			const size_t Count=MultiScalarCounts[c];
+			MultiScalarTerms(RNG,Exponents,Kind,Count,160,Integer::Zero());
+			std::vector<Integer> Bases(Count);
+			Integer Expected=Integer::One();
+			for(size_t i=0;i<Count;++i)
+			{
+				if(Kind[i]==2)
+					Bases[i]=Integer::One();
+				else if(Kind[i]==4 && i>0)
+					Bases[i]=Bases[i-1].InverseMod(Modulus);
+				else if(Kind[i]==5 && i>0)
+					Bases[i]=Bases[i-1];
+				else
+				{
+					do
+						Bases[i]=Integer(RNG,Integer::Two(),Modulus-1);
+					while(Integer::Gcd(Bases[i],Modulus)!=Integer::One());
+				}
+				const Integer Base=Exponents[i].IsNegative() ? Bases[i].InverseMod(Modulus) : Bases[i];
+				Expected=MA.Multiply(Expected,a_exp_b_mod_c(Base,Exponents[i].AbsoluteValue(),Modulus));
+			}
+
+			const Integer Result=MA.MultiExponentiate(Count ? &Bases[0] : NULL,Count ? &Exponents[0] : NULL,Count);
+			Assert::IsTrue(Result==Expected,L"Multi-exponentiation failed.",LINE_INFO());
+		}
+	}
+
+	// little endian bytes as an Integer
+	Integer LittleEndianInteger(const byte *Bytes,size_t Length)
+	{
+		SecByteBlock Reversed(Length);
+		for(size_t i=0;i<Length;++i)
+			Reversed[i]=Bytes[Length-1-i];
+		return Integer(Reversed,Length);
+	}
+
+	void Ed25519Check(RandomNumberGenerator& RNG,const ed25519Signer& Signer)
+	{
+		const ed25519Verifier Verifier(Signer);
+		const Integer Order=Integer::Power2(252)+Integer("0x14def9dea2f79cd65812631a5cf5d3ed");
+		for(size_t Length=0;Length<=256;Length+=32)
+		{
+			SecByteBlock Message(Length),Signature(ed25519Signer::SIGNATURE_LENGTH),Again(ed25519Signer::SIGNATURE_LENGTH);
+			RNG.GenerateBlock(Message,Length);
+			Signer.SignMessage(RNG,Message,Length,Signature);
+			Signer.SignMessage(RNG,Message,Length,Again);
+			Assert::IsTrue(Signature==Again,L"Ed25519 signatures aren't deterministic.",LINE_INFO());
+
+			// S = r + ka mod l is computed in fixed width limbs, it has to be reduced and verify
+			const Integer S=LittleEndianInteger(Signature+32,32);
+			Assert::IsTrue(S<Order,L"Ed25519 signature S isn't reduced.",LINE_INFO());
+			Assert::IsTrue(Verifier.VerifyMessage(Message,Length,Signature,Signature.size()),L"Ed25519 signature didn't verify.",LINE_INFO());
+
+			// S + l is the same scalar but must be rejected
+			const Integer Unreduced=S+Order;
+			for(size_t i=0;i<32;++i)
+				Again[32+i]=Unreduced.GetByte(i);
+			Assert::IsTrue(!Verifier.VerifyMessage(Message,Length,Again,Again.size()),L"Ed25519 signature with S not below l verified.",LINE_INFO());
+
+			Signature[RNG.GenerateWord32(0,ed25519Signer::SIGNATURE_LENGTH-1)]^=byte(1<<RNG.GenerateWord32(0,7));
+			Assert::IsTrue(!Verifier.VerifyMessage(Message,Length,Signature,Signature.size()),L"Tampered Ed25519 signature verified.",LINE_INFO());
+			if(Length)
+			{
+				Signature=Again;
+				Message[0]^=1;
+				Signer.SignMessage(RNG,Message,Length,Signature);
+				Assert::IsTrue(Signature!=Again,L"Different messages gave the same Ed25519 signature.",LINE_INFO());
+				Message[0]^=1;
+				Assert::IsTrue(!Verifier.VerifyMessage(Message,Length,Signature,Signature.size()),L"Ed25519 signature verified for another message.",LINE_INFO());
+			}
+		}
+	}
+
 	TEST_CLASS(PublicKeyConsistencyChecks)
 	{
 	public:
 		
+		TEST_METHOD(IntegerKernelChecks)
+		{
+			// the MULX/ADX kernels take 4 and 8 words, 16 and 32 words are Karatsuba over them
+			AutoSeededRandomPool RNG;
+			std::vector<Integer> Operands;
+			const size_t WordCounts[] = {4,8,16,32};
+			for(size_t i=0;i<sizeof(WordCounts)/sizeof(WordCounts[0]);++i)
+			{
+				const size_t Bits = WordCounts[i]*WORD_BITS;
+				const Integer AllOnes = Integer::Power2(Bits)-1;
+				for(size_t j=0;j<64;++j)
+				{
+					// the first eight triples have all ones operands, they give the longest carry chains
+					for(size_t k=0;k<3;++k)
+					{
+						Integer X(RNG,Bits);
+						X.SetBit(Bits-1);
+						if(j<8 && ((j>>k)&1))
+							X=AllOnes;
+						Operands.push_back(X);
+					}
+					Operands.back().SetBit(0);
+				}
+			}
+
+			// without BMI2 or without ADX the baseline kernels are chosen, on CPUs with both the first results come from MULX
+			const bool HadBMI2 = HasBMI2(), HadADX = HasADX();
+			const std::vector<Integer> Results = IntegerKernelResults(Operands);
+			g_hasBMI2 = false;
+			SelectIntegerKernels();
+			const std::vector<Integer> NoBMI2Results = IntegerKernelResults(Operands);
+			g_hasBMI2 = HadBMI2;
+			g_hasADX = false;
+			SelectIntegerKernels();
+			const std::vector<Integer> NoADXResults = IntegerKernelResults(Operands);
+			g_hasADX = HadADX;
+			SelectIntegerKernels();
+
+			Assert::IsTrue(Results==NoBMI2Results,L"MULX kernels differ from the baseline kernels.",LINE_INFO());
+			Assert::IsTrue(Results==NoADXResults,L"MULX kernels differ from the baseline kernels.",LINE_INFO());
+			Assert::IsTrue(Results==IntegerKernelResults(Operands),L"Integer kernels weren't restored.",LINE_INFO());
+		}
+
+		TEST_METHOD(FixedWidthExponentiationChecks)
+		{
+			// a_exp_b_mod_c takes the fixed width path for odd moduli of these sizes and exponents of about their length,
+			// MontgomeryRepresentation::Exponentiate never does
+			AutoSeededRandomPool RNG;
+			const size_t ModulusBits[] = {256,384,512,1024,2048,3072,4096};
+			for(size_t i=0;i<sizeof(ModulusBits)/sizeof(ModulusBits[0]);++i)
+			{
+				const size_t Bits = ModulusBits[i];
+				Integer M(RNG,Bits);
+				M.SetBit(Bits-1);
+				M.SetBit(0);
+				MontgomeryRepresentation MR(M);
+
+				const Integer Bases[] = {Integer::Zero(),Integer::One(),Integer(RNG,Integer::One(),M-1),M-1,M,M+Integer(RNG,Bits),Integer(RNG,2*Bits)};
+				const Integer Exponents[] = {Integer::Zero(),Integer::One(),Integer(65537),Integer(RNG,Bits),Integer::Power2(Bits)-1,Integer::Power2(Bits-Bits/8)};
+				for(size_t j=0;j<sizeof(Bases)/sizeof(Bases[0]);++j)
+					for(size_t k=0;k<sizeof(Exponents)/sizeof(Exponents[0]);++k)
+					{
+						const Integer Expected = MR.ConvertOut(MR.Exponentiate(MR.ConvertIn(Bases[j]%M),Exponents[k]));
+						Assert::IsTrue(a_exp_b_mod_c(Bases[j],Exponents[k],M)==Expected,L"Modular exponentiation differs from MontgomeryRepresentation.",LINE_INFO());
+						Integer Result;
+						Assert::IsTrue(MR.FixedWidthExponentiate(Result,Bases[j],Exponents[k]) && Result==Expected,L"Fixed width exponentiation differs from MontgomeryRepresentation.",LINE_INFO());
+					}
+			}
+		}
+
+		TEST_METHOD(MultiPrimeRSAChecks)
+		{
+			MultiPrimeRSACheck(2048,3);
+			MultiPrimeRSACheck(4096,4);
+
+			// more primes than OpenSSL allows for the modulus size
+			const unsigned int ModulusBits[] = {512,1023,1024,4095,4096,8191,8192,16384};
+			for(size_t i=0;i<sizeof(ModulusBits)/sizeof(ModulusBits[0]);++i)
+			{
+				const unsigned int PrimeCount = InvertibleRSAFunction::MaxPrimeCount(ModulusBits[i])+1;
+				Assert::IsTrue(PrimeCount==(ModulusBits[i]<1024 ? 3U : ModulusBits[i]<4096 ? 4U : ModulusBits[i]<8192 ? 5U : 6U),L"Unexpected prime count limit.",LINE_INFO());
+				bool Thrown = false;
+				try
+				{
+					AutoSeededRandomPool RNG;
+					RSA::PrivateKey Key;
+					Key.Initialize(RNG,ModulusBits[i],65537,PrimeCount);
+				}
+				catch(const InvalidArgument&)
+				{
+					Thrown = true;
+				}
+				Assert::IsTrue(Thrown,L"Too many RSA primes were accepted.",LINE_INFO());
+			}
+		}
+
+		TEST_METHOD(VerifyBatchChecks)
+		{
+			AutoSeededRandomPool RNG;
+			RSA::PrivateKey RSAKey;
+			RSAKey.Initialize(RNG,2048);
+			VerifyBatchCheck(RSASS<PKCS1v15,SHA256>::Signer(RSAKey),RSASS<PKCS1v15,SHA256>::Verifier(RSAKey));
+			VerifyBatchCheck(RSASS<PSS,SHA256>::Signer(RSAKey),RSASS<PSS,SHA256>::Verifier(RSAKey));
+
+			DSA::PrivateKey DSAKey;
+			DSAKey.GenerateRandomWithKeySize(RNG,1024);
+			DSA::Signer DSASigner(DSAKey);
+			VerifyBatchCheck(DSASigner,DSA::Verifier(DSASigner));
+
+			const OID Curves[] = {ASN1::secp256r1(),ASN1::secp384r1(),ASN1::secp521r1()};
+			for(size_t i=0;i<sizeof(Curves)/sizeof(Curves[0]);++i)
+			{
+				ECDSA<ECP,SHA256>::PrivateKey ECDSAKey;
+				ECDSAKey.Initialize(RNG,Curves[i]);
+				ECDSA<ECP,SHA256>::Signer Signer(ECDSAKey);
+				ECDSA<ECP,SHA256>::PublicKey PublicKey;
+				ECDSAKey.MakePublicKey(PublicKey);
+				// P-256 and P-384 have fixed width arithmetic, the batch keys skip the precomputation there
+				Assert::IsTrue(PublicKey.UsesPrecomputation()==(i==2),L"Unexpected precomputation use of the key.",LINE_INFO());
+				VerifyBatchCheck(Signer,ECDSA<ECP,SHA256>::Verifier(Signer));
+			}
+
+			// a SHA-512 digest info doesn't fit a 512 bit modulus, neither for VerifyMessage nor for VerifyBatch
+			RSA::PrivateKey ShortKey;
+			ShortKey.Initialize(RNG,512);
+			RSASS<PKCS1v15,SHA512>::Verifier ShortVerifier(ShortKey);
+			const byte Signature[64] = {1};
+			const PK_Verifier::SignedMessage Item(Signature,sizeof(Signature),Signature,sizeof(Signature));
+			for(int Parallel=0;Parallel<2;++Parallel)
+			{
+				bool Thrown = false;
+				try
+				{
+					ShortVerifier.VerifyBatch(&Item,1,Parallel!=0);
+				}
+				catch(const PK_SignatureScheme::KeyTooShort&)
+				{
+					Thrown = true;
+				}
+				Assert::IsTrue(Thrown,L"VerifyBatch accepted a key that is too short.",LINE_INFO());
+			}
+		}
+
+		TEST_METHOD(NISTCurveChecks)
+		{
+			NISTCurveCheck(ASN1::secp256r1());
+			NISTCurveCheck(ASN1::secp384r1());
+		}
+
+		TEST_METHOD(ECPCombTableChecks)
+		{
+			const OID Curves[] = {ASN1::secp256r1(),ASN1::secp384r1(),ASN1::secp521r1(),ASN1::brainpoolP256r1(),ASN1::brainpoolP384r1(),ASN1::brainpoolP512r1()};
+			Assert::IsTrue(g_ecpCombTableCount==sizeof(Curves)/sizeof(Curves[0]),L"Unexpected number of comb tables.",LINE_INFO());
+			for(unsigned int i=0;i<g_ecpCombTableCount;++i)
+			{
+				const DL_GroupParameters_EC<ECP> Parameters(Curves[i]);
+				const ECP &Curve=Parameters.GetCurve();
+				Assert::IsTrue(ECPCombTable::Find(Curve.GetField().GetModulus(),Curve.GetA(),Curve.GetB())==&g_ecpCombTables[i],L"The comb table is for another curve.",LINE_INFO());
+				Assert::IsTrue(Curve.HasFixedBaseTable(Parameters.GetSubgroupGenerator()),L"The named curve doesn't use its comb table.",LINE_INFO());
+				ECPCombTableCheck(g_ecpCombTables[i]);
+			}
+		}
+
+		TEST_METHOD(MultiScalarChecks)
+		{
+			MultiScalarCheck(ASN1::secp256r1());
+			MultiScalarCheck(ASN1::secp256k1());
+
+			AutoSeededRandomPool RNG;
+			Integer Modulus(RNG,512);
+			Modulus.SetBit(511);
+			Modulus.SetBit(0);
+			MultiExponentiationCheck(Modulus);
+			MultiExponentiationCheck(Modulus+1);
+		}
+
+		TEST_METHOD(Curve25519Checks)
+		{
+			AutoSeededRandomPool RNG;
+			x25519 Domain;
+			for(size_t i=0;i<16;++i)
+			{
+				SecByteBlock PrivateA(Domain.PrivateKeyLength()),PublicA(Domain.PublicKeyLength()),PrivateB(Domain.PrivateKeyLength()),PublicB(Domain.PublicKeyLength());
+				SecByteBlock AgreedA(Domain.AgreedValueLength()),AgreedB(Domain.AgreedValueLength());
+				Domain.GenerateKeyPair(RNG,PrivateA,PublicA);
+				Domain.GenerateKeyPair(RNG,PrivateB,PublicB);
+				Assert::IsTrue(Domain.Agree(AgreedA,PrivateA,PublicB) && Domain.Agree(AgreedB,PrivateB,PublicA) && AgreedA==AgreedB,L"X25519 agreement failed.",LINE_INFO());
+
+				Ed25519Check(RNG,ed25519Signer(RNG));
+			}
+		}
+
 		TEST_METHOD(ECIESChecks)
 		{
 			ECIESCheck<ECP,NoCofactorMultiplication,SHA1,P1363_KDF2<SHA1>,true>(ASN1::secp256r1());
@@ -1,10 +1,39 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
 
+using namespace CryptoPP;
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace CryptoPPTests
 {
+	// deterministic ECDSA vectors of RFC 6979 A.2, all for the message "sample"
+	template<class HASH> void ECDSATestVectorCheck(const OID& CurveID,const char* x,const char* Ux,const char* Uy,const char* k,const char* r,const char* s)
+	{
+		const std::string Message("sample");
+		typename ECDSA<ECP,HASH>::PrivateKey PrivateKey;
+		PrivateKey.Initialize(CurveID,Integer(x));
+		typename ECDSA<ECP,HASH>::PublicKey PublicKey;
+		PrivateKey.MakePublicKey(PublicKey);
+		Assert::IsTrue(PublicKey.GetPublicElement()==ECP::Point(Integer(Ux),Integer(Uy)),L"public key failed",LINE_INFO());
+
+		byte Digest[HASH::DIGESTSIZE];
+		HASH().CalculateDigest(Digest,(const byte*)Message.data(),Message.size());
+		typename ECDSA<ECP,HASH>::Signer Signer(PrivateKey);
+		Integer R,S;
+		Signer.RawSign(Integer(k),Integer(Digest,sizeof(Digest)),R,S);
+		Assert::IsTrue(R==Integer(r),L"r failed",LINE_INFO());
+		Assert::IsTrue(S==Integer(s),L"s failed",LINE_INFO());
+
+		typename ECDSA<ECP,HASH>::Verifier Verifier(PublicKey);
+		const size_t Length=PrivateKey.GetGroupParameters().GetSubgroupOrder().ByteCount();
+		SecByteBlock Signature(2*Length);
+		R.Encode(Signature,Length);
+		S.Encode(Signature+Length,Length);
+		Assert::IsTrue(Verifier.VerifyMessage((const byte*)Message.data(),Message.size(),Signature,Signature.size()),L"verification failed",LINE_INFO());
+		Signature[Length-1]^=1;
+		Assert::IsFalse(Verifier.VerifyMessage((const byte*)Message.data(),Message.size(),Signature,Signature.size()),L"tampered signature verified",LINE_INFO());
+	}
+
 	TEST_CLASS(PublicKeyTestVectorChecks)
 	{
 	public:
@@ -14,5 +43,28 @@ namespace CryptoPPTests
 			
 		}
 
+		TEST_METHOD(ECDSATestVectorChecks)
+		{
+			const char P256x[]="C9AFA9D845BA75166B5C215767B1D6934E50C3DB36E89B127B8A622B120F6721h";
+			const char P256Ux[]="60FED4BA255A9D31C961EB74C6356D68C049B8923B61FA6CE669622E60F29FB6h";
+			const char P256Uy[]="7903FE1008B8BC99A41AE9E95628BC64F2F1B20C2D7E9F5177A3C294D4462299h";
+			ECDSATestVectorCheck<SHA256>(ASN1::secp256r1(),P256x,P256Ux,P256Uy,
+				"A6E3C57DD01ABE90086538398355DD4C3B17AA873382B0F24D6129493D8AAD60h",
+				"EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716h",
+				"F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8h");
+
+			const char P384x[]="6B9D3DAD2E1B8C1C05B19875B6659F4DE23C3B667BF297BA9AA47740787137D896D5724E4C70A825F872C9EA60D2EDF5h";
+			const char P384Ux[]="EC3A4E415B4E19A4568618029F427FA5DA9A8BC4AE92E02E06AAE5286B300C64DEF8F0EA9055866064A254515480BC13h";
+			const char P384Uy[]="8015D9B72D7D57244EA8EF9AC0C621896708A59367F9DFB9F54CA84B3F1C9DB1288B231C3AE0D4FE7344FD2533264720h";
+			ECDSATestVectorCheck<SHA256>(ASN1::secp384r1(),P384x,P384Ux,P384Uy,
+				"180AE9F9AEC5438A44BC159A1FCB277C7BE54FA20E7CF404B490650A8ACC414E375572342863C899F9F2EDF9747A9B60h",
+				"21B13D1E013C7FA1392D03C5F99AF8B30C570C6F98D4EA8E354B63A21D3DAA33BDE1E888E63355D92FA2B3C36D8FB2CDh",
+				"F3AA443FB107745BF4BD77CB3891674632068A10CA67E3D45DB2266FA7D1FEEBEFDC63ECCD1AC42EC0CB8668A4FA0AB0h");
+			ECDSATestVectorCheck<SHA384>(ASN1::secp384r1(),P384x,P384Ux,P384Uy,
+				"94ED910D1A099DAD3254E9242AE85ABDE4BA15168EAF0CA87A555FD56D10FBCA2907E3E83BA95368623B8C4686915CF9h",
+				"94EDBB92A5ECB8AAD4736E56C691916B3F88140666CE9FA73D64C4EA95AD133C81A648152E44ACF96E36DD1E80FABE46h",
+				"99EF4AEB15F178CEA1FE40DB2603138F130E740A19624526203B6351D0A3A94FA329C145786E679E7B82C71A38628AC8h");
+		}
+
 	};
 }
\ No newline at end of file
@@ -6,6 +6,26 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace CryptoPPTests
 {
+	// hashes random messages with the reference compression function and with Impl and compares the digests
+	template<class HASH,class IMPLEMENTATION> void RunImplementationCheck(HASH& Hasher,IMPLEMENTATION Reference,IMPLEMENTATION Impl,const wchar_t* Message)
+	{
+		AutoSeededRandomPool RNG;
+		SecByteBlock Data(4096);
+		SecByteBlock Digest1(Hasher.DigestSize());
+		SecByteBlock Digest2(Hasher.DigestSize());
+		RNG.GenerateBlock(Data,Data.size());
+
+		for(unsigned int i=0;i<64;++i)
+		{
+			const size_t Length=RNG.GenerateWord32(0,(word32)Data.size());
+			Hasher.SetImplementation(Reference);
+			Hasher.CalculateDigest(Digest1,Data,Length);
+			Hasher.SetImplementation(Impl);
+			Hasher.CalculateDigest(Digest2,Data,Length);
+			Assert::IsTrue(Digest1==Digest2,Message,LINE_INFO());
+		}
+	}
+
 	TEST_CLASS(SymmetricTestVectorChecks)
 	{
 	public:
@@ -290,6 +310,63 @@ namespace CryptoPPTests
 			Assert::IsTrue(Hasher.VerifyDigest(TestVectorResult3,TestData3,256),L"Skein-1024-1024 check failed.",LINE_INFO());
 		}
 
+		TEST_METHOD(SkeinUBIChecks)
+		{
+			FixedSizeSecBlock<byte,128> TestData;
+			for(unsigned int i=0;i<128;++i)
+				TestData[i]=static_cast<byte>(0xFF-i);
+
+			Skein Hasher(64,32); // Skein-256-512, the output spans two blocks
+			const byte TestVectorResult[] = {
+			0x1A, 0xED, 0xAB, 0x6F, 0xD2, 0x8F, 0xD0, 0xED, 0x62, 0xB8, 0x2A, 0x6D, 0x22, 0xFA, 0x3C, 0x6A,
+			0x71, 0xAF, 0xF4, 0x92, 0x05, 0x74, 0xA0, 0xD9, 0x0F, 0x4D, 0x90, 0xA3, 0xB6, 0xFF, 0x96, 0xF4,
+			0x36, 0xA0, 0xAB, 0xDF, 0x54, 0x84, 0x0F, 0x33, 0x6D, 0xF7, 0xD7, 0x90, 0xA2, 0x18, 0x5F, 0x61,
+			0x1E, 0x46, 0x3F, 0x40, 0xB3, 0x40, 0xBE, 0x82, 0x11, 0x06, 0x27, 0xFB, 0x25, 0xB8, 0x02, 0xAF};
+			Assert::IsTrue(Hasher.VerifyDigest(TestVectorResult,TestData,128),L"Skein-256-512 check failed.",LINE_INFO());
+
+			// uneven pieces have to hold back the same last block, the second message starts from the cached state
+			for(unsigned int Round=0;Round<2;++Round)
+			{
+				Hasher.Update(TestData,1);
+				Hasher.Update(TestData+1,31);
+				Hasher.Update(TestData+32,33);
+				Hasher.Update(TestData+65,63);
+				Assert::IsTrue(Hasher.Verify(TestVectorResult),L"Skein-256-512 piecewise check failed.",LINE_INFO());
+			}
+		}
+
+		TEST_METHOD(SkeinTreeChecks)
+		{
+			SecByteBlock TestData(1024);
+			for(unsigned int i=0;i<TestData.size();++i)
+				TestData[i]=static_cast<byte>(0xFF-i);
+
+			// Skein-512-512 with 128 byte leaves, binary nodes and a maximum height of 3: 8 leaves, 4 nodes, one root
+			SkeinTree Hasher(64,1,1,3,64);
+			const byte TestVectorResult[] = {
+			0x9C, 0xCC, 0xAE, 0xA1, 0x85, 0x00, 0xBC, 0xED, 0x2F, 0x7F, 0x8B, 0x2C, 0xA5, 0x46, 0x05, 0x8F,
+			0x07, 0xC0, 0x97, 0xAA, 0xCC, 0x80, 0x90, 0x4B, 0x97, 0x95, 0x15, 0xB1, 0x05, 0x3D, 0x68, 0xD0,
+			0x50, 0x62, 0x81, 0xAC, 0xA2, 0x06, 0xF6, 0x47, 0x7D, 0x90, 0x36, 0x2E, 0xF8, 0x2B, 0xD0, 0x5B,
+			0x95, 0x8F, 0x8D, 0x7F, 0x9D, 0x68, 0xFF, 0x85, 0x1E, 0xB5, 0x9E, 0x9C, 0xD6, 0x20, 0x03, 0xB4};
+			Assert::IsTrue(Hasher.VerifyDigest(TestVectorResult,TestData,TestData.size()),L"Skein-Tree-512-512 check failed.",LINE_INFO());
+
+			// pieces that split leaves have to give the same digest
+			Hasher.Update(TestData,100);
+			Hasher.Update(TestData+100,300);
+			Hasher.Update(TestData+400,624);
+			Assert::IsTrue(Hasher.Verify(TestVectorResult),L"Skein-Tree-512-512 piecewise check failed.",LINE_INFO());
+
+			// the leaves are hashed by the workers
+			ThreadPool &Pool = ThreadPool::GetGlobalPool();
+			const unsigned int OldNumberThreads = Pool.GetNumberThreads();
+			const size_t OldThreshold = Pool.GetParallelThreshold();
+			Pool.SetNumberThreads(4);
+			Pool.SetParallelThreshold(0);
+			Assert::IsTrue(Hasher.VerifyDigest(TestVectorResult,TestData,TestData.size()),L"Skein-Tree-512-512 parallel check failed.",LINE_INFO());
+			Pool.SetParallelThreshold(OldThreshold);
+			Pool.SetNumberThreads(OldNumberThreads);
+		}
+
 		TEST_METHOD(ScryptTestVectorChecks)
 		{
 			OriginalScrypt Instance;
@@ -339,6 +416,104 @@ namespace CryptoPPTests
 			Assert::IsTrue(memcmp(Compare4,TestVector4,64)==0,L"scrypt test 4 failed.",LINE_INFO());
 		}
 
+		TEST_METHOD(ScryptParallelChecks)
+		{
+			OriginalScrypt Instance;
+			ScryptScratchArena Arena;
+			ThreadPool &Pool = ThreadPool::GetGlobalPool();
+			const unsigned int OldNumberThreads = Pool.GetNumberThreads();
+			Pool.SetNumberThreads(4);
+
+			const byte TestVector2[]=
+			{
+				0xfd, 0xba, 0xbe, 0x1c, 0x9d, 0x34, 0x72, 0x00, 0x78, 0x56, 0xe7, 0x19, 0x0d, 0x01, 0xe9, 0xfe,
+				0x7c, 0x6a, 0xd7, 0xcb, 0xc8, 0x23, 0x78, 0x30, 0xe7, 0x73, 0x76, 0x63, 0x4b, 0x37, 0x31, 0x62,
+				0x2e, 0xaf, 0x30, 0xd9, 0x2e, 0x22, 0xa3, 0x88, 0x6f, 0xf1, 0x09, 0x27, 0x9d, 0x98, 0x30, 0xda,
+				0xc7, 0x27, 0xaf, 0xb9, 0x4a, 0x83, 0xee, 0x6d, 0x83, 0x60, 0xcb, 0xdf, 0xa2, 0xcc, 0x06, 0x40
+			};
+			FixedSizeSecBlock<byte,64> Compare;
+			const char TestStringPassword[]="password",TestStringSalt[]="NaCl";
+
+			// 16 lanes on 4 workers, then again with the memory the first run left in the arena
+			Instance.DeriveKey(Compare,64,(byte*)TestStringPassword,8,(byte*)TestStringSalt,4,10,8,16,Arena);
+			Assert::IsTrue(memcmp(Compare,TestVector2,64)==0,L"scrypt with four threads failed.",LINE_INFO());
+			Assert::IsTrue(Arena.SizeInBytes()==4*((1024+2)*1024),L"scrypt arena has the wrong size.",LINE_INFO());
+			// the estimates depend on the lanes and SetMaxThreads() only, not on the size of the pool
+			Assert::IsTrue(Instance.MaxMemoryUsage(10,16)==16*((1024+2)*1024) && Instance.MaxMemoryUsage(10)==(1024+2)*1024,L"scrypt reports the wrong memory usage.",LINE_INFO());
+			Assert::IsTrue(Instance.GetMCostFromPeakNumberBytes(16*((1024+2)*1024),16)==10 && Instance.GetMCostFromPeakNumberBytes((1024+2)*1024)==10,L"scrypt maps the peak memory to the wrong mCost.",LINE_INFO());
+			Instance.SetMaxThreads(4);
+			Assert::IsTrue(Instance.MaxMemoryUsage(10,16)==Arena.SizeInBytes() && Instance.MaxMemoryUsage(10,2)==2*((1024+2)*1024),L"scrypt reports the wrong memory usage.",LINE_INFO());
+			Assert::IsTrue(Instance.GetMCostFromPeakNumberBytes(Arena.SizeInBytes(),16)==10,L"scrypt maps the peak memory to the wrong mCost.",LINE_INFO());
+			Assert::IsTrue(Instance.GetMCostFromPeakNumberBytes(Arena.SizeInBytes()-1,16)==9,L"scrypt maps the peak memory to the wrong mCost.",LINE_INFO());
+			memset(Compare,0,64);
+			Instance.DeriveKey(Compare,64,(byte*)TestStringPassword,8,(byte*)TestStringSalt,4,10,8,16,Arena);
+			Assert::IsTrue(memcmp(Compare,TestVector2,64)==0,L"scrypt with a reused arena failed.",LINE_INFO());
+
+			Instance.SetMaxThreads(1);
+			Assert::IsTrue(Instance.MaxMemoryUsage(10,16)==(1024+2)*1024,L"scrypt reports the wrong memory usage.",LINE_INFO());
+			Instance.DeriveKey(Compare,64,(byte*)TestStringPassword,8,(byte*)TestStringSalt,4,10,8,16);
+			Assert::IsTrue(memcmp(Compare,TestVector2,64)==0,L"scrypt with one thread failed.",LINE_INFO());
+
+			Pool.SetNumberThreads(OldNumberThreads);
+		}
+
+		TEST_METHOD(FortunaConcurrencyChecks)
+		{
+			// four threads draw blocks while another one keeps adding entropy, until the pools were harvested a few times
+			OriginalFortuna Generator;
+			AutoSeededRandomPool RNG;
+			SecByteBlock Seed(Fortuna_Base::NUM_POOLS*Fortuna_Base::MIN_POOL_SIZE);
+			RNG.GenerateBlock(Seed,Seed.size());
+			Generator.IncorporateEntropy(Seed,Seed.size());
+
+			const unsigned int NumberThreads=4;
+			const word64 Reseeds=4;
+			const std::chrono::steady_clock::time_point Deadline=std::chrono::steady_clock::now()+std::chrono::seconds(10);
+			std::atomic<unsigned int> Running(NumberThreads);
+			std::future<void> Feeder=std::async(std::launch::async,[&]()
+			{
+				AutoSeededRandomPool FeederRNG;
+				byte Event[Fortuna_Base::MAX_EVENT_SIZE];
+				while(Running>0)
+				{
+					FeederRNG.GenerateBlock(Event,sizeof(Event));
+					Generator.IncorporateEntropy(Event,sizeof(Event));
+					std::this_thread::yield();
+				}
+			});
+
+			std::vector<std::future<std::vector<std::string> > > Drawers;
+			for(unsigned int i=0;i<NumberThreads;++i)
+				Drawers.push_back(std::async(std::launch::async,[&]()
+				{
+					std::vector<std::string> Blocks;
+					byte Block[16];
+					while(Generator.GetReseedCount()<Reseeds && std::chrono::steady_clock::now()<Deadline)
+					{
+						for(unsigned int j=0;j<64;++j)
+						{
+							Generator.GenerateBlock(Block,sizeof(Block));
+							Blocks.push_back(std::string((const char*)Block,sizeof(Block)));
+						}
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					}
+					--Running;
+					return Blocks;
+				}));
+
+			std::vector<std::string> All;
+			for(unsigned int i=0;i<NumberThreads;++i)
+			{
+				const std::vector<std::string> Blocks=Drawers[i].get();
+				All.insert(All.end(),Blocks.begin(),Blocks.end());
+			}
+			Feeder.get();
+
+			Assert::IsTrue(Generator.GetReseedCount()>=Reseeds,L"Fortuna didn't reseed while it was used from several threads.",LINE_INFO());
+			std::sort(All.begin(),All.end());
+			Assert::IsTrue(std::adjacent_find(All.begin(),All.end())==All.end(),L"Fortuna gave the same block to several requests.",LINE_INFO());
+		}
+
 		/*TEST_METHOD(ScryptDebugChecks)
 		{
 			OriginalScrypt TestInstance;
@@ -546,5 +721,570 @@ namespace CryptoPPTests
 			Assert::IsTrue(Hasher.VerifyDigest(TestVectorResult1,nullptr,0),L"BLAKE2sp test one failed.",LINE_INFO());
 			Assert::IsTrue(Hasher.VerifyDigest(TestVectorResult2,TestData2,1),L"BLAKE2sp test two failed.",LINE_INFO());
 		}
+
+		TEST_METHOD(BLAKE2ParallelConsistencyChecks)
+		{
+			ThreadPool &Pool = ThreadPool::GetGlobalPool();
+			const unsigned int OldNumberThreads = Pool.GetNumberThreads();
+			Pool.SetNumberThreads(4);
+
+			SecByteBlock TestData(1024*1024+77);
+			for(size_t i=0;i<TestData.size();++i)
+				TestData[i]=byte(i*7+(i>>8));
+
+			// the whole message is handed to the pool, the small chunks stay below the threshold
+			BLAKE2bp Whole2bp(64),Chunked2bp(64);
+			BLAKE2sp Whole2sp(32),Chunked2sp(32);
+			Whole2bp.Update(TestData,TestData.size());
+			Whole2sp.Update(TestData,TestData.size());
+			for(size_t i=0;i<TestData.size();i+=1000)
+			{
+				Chunked2bp.Update(TestData+i,STDMIN<size_t>(1000,TestData.size()-i));
+				Chunked2sp.Update(TestData+i,STDMIN<size_t>(1000,TestData.size()-i));
+			}
+
+			SecByteBlock Digest1(64),Digest2(64);
+			Whole2bp.Final(Digest1);
+			Chunked2bp.Final(Digest2);
+			Assert::IsTrue(Digest1==Digest2,L"BLAKE2bp parallel and inline hashing differ.",LINE_INFO());
+			Whole2sp.Final(Digest1);
+			Chunked2sp.Final(Digest2);
+			Assert::IsTrue(memcmp(Digest1,Digest2,32)==0,L"BLAKE2sp parallel and inline hashing differ.",LINE_INFO());
+
+			Pool.SetNumberThreads(OldNumberThreads);
+		}
+
+		TEST_METHOD(BLAKE2ImplementationChecks)
+		{
+			const byte Key[]="BLAKE2 implementation check key!";
+
+			const BLAKE2b::Implementation BImplementations[]={BLAKE2b::SSSE3_IMPLEMENTATION,BLAKE2b::SSE41_IMPLEMENTATION,BLAKE2b::AVX2_IMPLEMENTATION};
+			for(unsigned int i=0;i<sizeof(BImplementations)/sizeof(BImplementations[0]);++i)
+			{
+				if(!BLAKE2b::IsImplementationAvailable(BImplementations[i]))
+					continue;
+				BLAKE2b Hasher(64);
+				BLAKE2bMAC MAC(64,Key,32);
+				RunImplementationCheck(Hasher,BLAKE2b::REFERENCE_IMPLEMENTATION,BImplementations[i],L"BLAKE2b implementations differ.");
+				RunImplementationCheck(MAC,BLAKE2b::REFERENCE_IMPLEMENTATION,BImplementations[i],L"BLAKE2b-MAC implementations differ.");
+			}
+
+			const BLAKE2s::Implementation SImplementations[]={BLAKE2s::SSSE3_IMPLEMENTATION,BLAKE2s::SSE41_IMPLEMENTATION,BLAKE2s::AVX2_IMPLEMENTATION};
+			for(unsigned int i=0;i<sizeof(SImplementations)/sizeof(SImplementations[0]);++i)
+			{
+				if(!BLAKE2s::IsImplementationAvailable(SImplementations[i]))
+					continue;
+				BLAKE2s Hasher(32);
+				BLAKE2sMAC MAC(32,Key,32);
+				RunImplementationCheck(Hasher,BLAKE2s::REFERENCE_IMPLEMENTATION,SImplementations[i],L"BLAKE2s implementations differ.");
+				RunImplementationCheck(MAC,BLAKE2s::REFERENCE_IMPLEMENTATION,SImplementations[i],L"BLAKE2s-MAC implementations differ.");
+			}
+		}
+		TEST_METHOD(BLAKE2TreeLaneChecks)
+		{
+			// a single thread keeps the pool out of the way, so the stripes go through the lane kernels
+			ThreadPool &Pool = ThreadPool::GetGlobalPool();
+			const unsigned int OldNumberThreads = Pool.GetNumberThreads();
+			Pool.SetNumberThreads(1);
+
+			const byte TestVectorResultBP[64] = {
+				0x1c,0xe5,0xb8,0xd6,0xf6,0xfc,0xc8,0x9f,0xcb,0x6e,0xd2,0x9f,0x12,0x79,0x6c,0xc2,
+				0x10,0xa0,0x3f,0x47,0x63,0xe5,0x28,0xcb,0x2c,0x0e,0x1b,0x4b,0x12,0x55,0xd6,0xae,
+				0x86,0xc7,0x93,0x32,0x52,0x9f,0x63,0x68,0xd0,0xbc,0xfe,0x9d,0x31,0x6a,0x5f,0x99,
+				0x9a,0x53,0xaf,0x47,0xa8,0xf0,0xec,0x44,0x12,0xce,0x19,0x15,0x6b,0xba,0xfd,0x04
+			};
+			const byte TestVectorResultSP[32] = {
+				0x7e,0x28,0x30,0xf7,0x4f,0xc7,0xc4,0xd2,0x24,0xa2,0x01,0xb4,0x6f,0x95,0xe3,0x7e,
+				0xbb,0xfb,0x56,0xdd,0xdc,0x49,0x2f,0x82,0x27,0xe4,0xd9,0x05,0x20,0x17,0x34,0xb8
+			};
+			byte TestData[1000];
+			for(size_t i=0;i<sizeof(TestData);++i)
+				TestData[i]=byte(i);
+
+			BLAKE2bp Hasher2bp(64);
+			BLAKE2sp Hasher2sp(32);
+			Assert::IsTrue(Hasher2bp.VerifyDigest(TestVectorResultBP,TestData,sizeof(TestData)),L"BLAKE2bp test one failed.",LINE_INFO());
+			Assert::IsTrue(Hasher2sp.VerifyDigest(TestVectorResultSP,TestData,sizeof(TestData)),L"BLAKE2sp test one failed.",LINE_INFO());
+
+			const byte Key[]="BLAKE2 implementation check key!";
+			if(BLAKE2b::IsImplementationAvailable(BLAKE2b::AVX2_IMPLEMENTATION))
+			{
+				BLAKE2bpMAC MAC(64,Key,32);
+				RunImplementationCheck(Hasher2bp,BLAKE2b::REFERENCE_IMPLEMENTATION,BLAKE2b::AVX2_IMPLEMENTATION,L"BLAKE2bp lanes differ from the reference.");
+				RunImplementationCheck(MAC,BLAKE2b::REFERENCE_IMPLEMENTATION,BLAKE2b::AVX2_IMPLEMENTATION,L"BLAKE2bp-MAC lanes differ from the reference.");
+			}
+			if(BLAKE2s::IsImplementationAvailable(BLAKE2s::AVX2_IMPLEMENTATION))
+			{
+				BLAKE2spMAC MAC(32,Key,32);
+				RunImplementationCheck(Hasher2sp,BLAKE2s::REFERENCE_IMPLEMENTATION,BLAKE2s::AVX2_IMPLEMENTATION,L"BLAKE2sp lanes differ from the reference.");
+				RunImplementationCheck(MAC,BLAKE2s::REFERENCE_IMPLEMENTATION,BLAKE2s::AVX2_IMPLEMENTATION,L"BLAKE2sp-MAC lanes differ from the reference.");
+			}
+
+			Pool.SetNumberThreads(OldNumberThreads);
+		}
+
+		TEST_METHOD(GCMStitchedChecks)
+		{
+			// computed with the separate CTR and GHASH passes
+			const byte TestVectorTag128[16] = {
+				0x4b,0x4d,0x06,0x00,0xa3,0x22,0xc3,0x03,0xd8,0xbf,0x48,0x1b,0x83,0x76,0xd8,0x07
+			};
+			const byte TestVectorTag256[16] = {
+				0xc1,0x6c,0x44,0xad,0x3e,0x66,0x09,0x58,0x77,0x3f,0xee,0xf6,0x46,0xe0,0x17,0xd8
+			};
+			byte Key[32],IV[12],Header[20],Plaintext[1000],Ciphertext[1000],Tag[16];
+			for(size_t i=0;i<sizeof(Key);++i)
+				Key[i]=byte(i);
+			for(size_t i=0;i<sizeof(IV);++i)
+				IV[i]=byte(0xa0+i);
+			for(size_t i=0;i<sizeof(Header);++i)
+				Header[i]=byte(0x50+i);
+			for(size_t i=0;i<sizeof(Plaintext);++i)
+				Plaintext[i]=byte(i);
+
+			GCM<AES>::Encryption Encryptor;
+			Encryptor.SetKeyWithIV(Key,16,IV,sizeof(IV));
+			Encryptor.Update(Header,sizeof(Header));
+			Encryptor.ProcessData(Ciphertext,Plaintext,sizeof(Plaintext));
+			Encryptor.Final(Tag);
+			Assert::IsTrue(memcmp(Tag,TestVectorTag128,16)==0,L"AES-128/GCM test one failed.",LINE_INFO());
+			Encryptor.SetKeyWithIV(Key,32,IV,sizeof(IV));
+			Encryptor.Update(Header,sizeof(Header));
+			Encryptor.ProcessData(Ciphertext,Plaintext,sizeof(Plaintext));
+			Encryptor.Final(Tag);
+			Assert::IsTrue(memcmp(Tag,TestVectorTag256,16)==0,L"AES-256/GCM test one failed.",LINE_INFO());
+
+			// pieces below 128 bytes never take the stitched path, odd offsets leave keystream buffered
+			AutoSeededRandomPool RNG;
+			SecByteBlock Message(5000),Whole(5000),Pieces(5000),Recovered(5000);
+			SecByteBlock Tag1(16),Tag2(16);
+			RNG.GenerateBlock(Message,Message.size());
+			for(unsigned int i=0;i<32;++i)
+			{
+				const size_t Length=RNG.GenerateWord32(0,(word32)Message.size());
+				const size_t KeyLength=16+8*(i%3);
+				RNG.GenerateBlock(IV,sizeof(IV));
+
+				GCM<AES>::Encryption Encryptor1,Encryptor2;
+				Encryptor1.SetKeyWithIV(Key,KeyLength,IV,sizeof(IV));
+				Encryptor2.SetKeyWithIV(Key,KeyLength,IV,sizeof(IV));
+				for(size_t Done=0;Done<Length;)
+				{
+					const size_t Piece=STDMIN<size_t>(Length-Done,RNG.GenerateWord32(1,127));
+					Encryptor1.ProcessData(Pieces+Done,Message+Done,Piece);
+					Done+=Piece;
+				}
+				for(size_t Done=0;Done<Length;)
+				{
+					const size_t Piece=STDMIN<size_t>(Length-Done,RNG.GenerateWord32(1,3000));
+					Encryptor2.ProcessData(Whole+Done,Message+Done,Piece);
+					Done+=Piece;
+				}
+				Encryptor1.Final(Tag1);
+				Encryptor2.Final(Tag2);
+				Assert::IsTrue(memcmp(Pieces,Whole,Length)==0 && Tag1==Tag2,L"GCM stitched encryption differs.",LINE_INFO());
+
+				GCM<AES>::Decryption Decryptor;
+				Decryptor.SetKeyWithIV(Key,KeyLength,IV,sizeof(IV));
+				memcpy(Recovered,Whole,Length);
+				Decryptor.ProcessData(Recovered,Recovered,Length);
+				Decryptor.Final(Tag2);
+				Assert::IsTrue(memcmp(Recovered,Message,Length)==0 && Tag1==Tag2,L"GCM stitched decryption differs.",LINE_INFO());
+			}
+		}
+
+		TEST_METHOD(OCBTestVectorChecks)
+		{
+			// samples from RFC 7253 with nonce BBAA9988776655443322110D and A = P = 00..27
+			const byte TestVectorCipher1[56] = {
+				0xd5,0xca,0x91,0x74,0x84,0x10,0xc1,0x75,0x1f,0xf8,0xa2,0xf6,0x18,0x25,0x5b,0x68,
+				0xa0,0xa1,0x2e,0x09,0x3f,0xf4,0x54,0x60,0x6e,0x59,0xf9,0xc1,0xd0,0xdd,0xc5,0x4b,
+				0x65,0xe8,0x62,0x8e,0x56,0x8b,0xad,0x7a,0xed,0x07,0xba,0x06,0xa4,0xa6,0x94,0x83,
+				0xa7,0x03,0x54,0x90,0xc5,0x76,0x9e,0x60
+			};
+			const byte TestVectorCipher2[52] = {
+				0x17,0x92,0xa4,0xe3,0x1e,0x07,0x55,0xfb,0x03,0xe3,0x1b,0x22,0x11,0x6e,0x6c,0x2d,
+				0xdf,0x9e,0xfd,0x6e,0x33,0xd5,0x36,0xf1,0xa0,0x12,0x4b,0x0a,0x55,0xba,0xe8,0x84,
+				0xed,0x93,0x48,0x15,0x29,0xc7,0x6b,0x6a,0xd0,0xc5,0x15,0xf4,0xd1,0xcd,0xd4,0xfd,
+				0xac,0x4f,0x02,0xaa
+			};
+			// the iterated test of RFC 7253 appendix A for AEAD_AES_128_OCB_TAGLEN128
+			const byte TestVectorIterated[16] = {
+				0x67,0xe9,0x44,0xd2,0x32,0x56,0xc5,0xe0,0xb6,0xc6,0x1f,0xa2,0x2f,0xdf,0x1e,0xa2
+			};
+			byte Key[16],Nonce[12],Data[40],Ciphertext[56],Recovered[40];
+			for(size_t i=0;i<sizeof(Key);++i)
+				Key[i]=byte(i);
+			const byte NonceBytes[12] = {0xbb,0xaa,0x99,0x88,0x77,0x66,0x55,0x44,0x33,0x22,0x11,0x0d};
+			memcpy(Nonce,NonceBytes,sizeof(Nonce));
+			for(size_t i=0;i<sizeof(Data);++i)
+				Data[i]=byte(i);
+
+			OCB<AES>::Encryption Encryptor;
+			Encryptor.SetKeyWithIV(Key,16,Nonce,sizeof(Nonce));
+			Encryptor.EncryptAndAuthenticate(Ciphertext,Ciphertext+40,16,Nonce,sizeof(Nonce),Data,40,Data,40);
+			Assert::IsTrue(memcmp(Ciphertext,TestVectorCipher1,56)==0,L"AES-128/OCB test one failed.",LINE_INFO());
+			OCB<AES>::Decryption Decryptor;
+			Decryptor.SetKeyWithIV(Key,16,Nonce,sizeof(Nonce));
+			Assert::IsTrue(Decryptor.DecryptAndVerify(Recovered,Ciphertext+40,16,Nonce,sizeof(Nonce),Data,40,Ciphertext,40) && memcmp(Recovered,Data,40)==0,L"AES-128/OCB decryption one failed.",LINE_INFO());
+			Ciphertext[17]^=1;
+			Assert::IsTrue(!Decryptor.DecryptAndVerify(Recovered,Ciphertext+40,16,Nonce,sizeof(Nonce),Data,40,Ciphertext,40),L"AES-128/OCB accepted a modified ciphertext.",LINE_INFO());
+
+			for(size_t i=0;i<sizeof(Key);++i)
+				Key[i]=byte(15-i);
+			OCB<AES,12>::Encryption Encryptor96;
+			Encryptor96.SetKeyWithIV(Key,16,Nonce,sizeof(Nonce));
+			Encryptor96.EncryptAndAuthenticate(Ciphertext,Ciphertext+40,12,Nonce,sizeof(Nonce),Data,40,Data,40);
+			Assert::IsTrue(memcmp(Ciphertext,TestVectorCipher2,52)==0,L"AES-128/OCB test two failed.",LINE_INFO());
+
+			memset(Key,0,sizeof(Key));
+			Key[15]=128;
+			std::string Iterated;
+			SecByteBlock Zeros(128),Output(128+16);
+			memset(Zeros,0,Zeros.size());
+			memset(Nonce,0,sizeof(Nonce));
+			Encryptor.SetKeyWithIV(Key,16,Nonce,sizeof(Nonce));
+			for(unsigned int i=0;i<128;++i)
+			{
+				PutWord(false,BIG_ENDIAN_ORDER,Nonce+8,word32(3*i+1));
+				Encryptor.EncryptAndAuthenticate(Output,Output+i,16,Nonce,sizeof(Nonce),Zeros,i,Zeros,i);
+				Iterated.append((const char *)Output.begin(),i+16);
+				PutWord(false,BIG_ENDIAN_ORDER,Nonce+8,word32(3*i+2));
+				Encryptor.EncryptAndAuthenticate(Output,Output+i,16,Nonce,sizeof(Nonce),NULL,0,Zeros,i);
+				Iterated.append((const char *)Output.begin(),i+16);
+				PutWord(false,BIG_ENDIAN_ORDER,Nonce+8,word32(3*i+3));
+				Encryptor.EncryptAndAuthenticate(Output,Output,16,Nonce,sizeof(Nonce),Zeros,i,NULL,0);
+				Iterated.append((const char *)Output.begin(),16);
+			}
+			PutWord(false,BIG_ENDIAN_ORDER,Nonce+8,word32(385));
+			Encryptor.EncryptAndAuthenticate(Output,Output,16,Nonce,sizeof(Nonce),(const byte *)Iterated.data(),Iterated.size(),NULL,0);
+			Assert::IsTrue(memcmp(Output,TestVectorIterated,16)==0,L"AES-128/OCB iterated test failed.",LINE_INFO());
+
+			// whole blocks in pieces against one call, pieces start off a multiple of 16 blocks for the VAES path
+			AutoSeededRandomPool RNG;
+			SecByteBlock Message(5000),Whole(5000),Pieces(5000),Tag1(16),Tag2(16);
+			RNG.GenerateBlock(Message,Message.size());
+			for(unsigned int i=0;i<32;++i)
+			{
+				const size_t Length=RNG.GenerateWord32(0,(word32)Message.size());
+				const size_t KeyLength=16+8*(i%3);
+				SecByteBlock LongKey(KeyLength);
+				RNG.GenerateBlock(LongKey,KeyLength);
+				RNG.GenerateBlock(Nonce,sizeof(Nonce));
+
+				OCB<AES>::Encryption Encryptor1,Encryptor2;
+				Encryptor1.SetKeyWithIV(LongKey,KeyLength,Nonce,sizeof(Nonce));
+				Encryptor2.SetKeyWithIV(LongKey,KeyLength,Nonce,sizeof(Nonce));
+				Encryptor1.Update(Message,i);
+				Encryptor2.Update(Message,i);
+				for(size_t Done=0;Done<Length;)
+				{
+					size_t Piece=16*RNG.GenerateWord32(1,40);
+					if(Piece>=Length-Done)
+						Piece=Length-Done;
+					Encryptor1.ProcessData(Pieces+Done,Message+Done,Piece);
+					Done+=Piece;
+				}
+				Encryptor2.ProcessData(Whole,Message,Length);
+				Encryptor1.Final(Tag1);
+				Encryptor2.Final(Tag2);
+				Assert::IsTrue(memcmp(Pieces,Whole,Length)==0 && Tag1==Tag2,L"OCB encryption in pieces differs.",LINE_INFO());
+
+				OCB<AES>::Decryption Decryptor1;
+				Decryptor1.SetKeyWithIV(LongKey,KeyLength,Nonce,sizeof(Nonce));
+				Decryptor1.Update(Message,i);
+				Decryptor1.ProcessData(Whole,Whole,Length);
+				Assert::IsTrue(Decryptor1.Verify(Tag1) && memcmp(Whole,Message,Length)==0,L"OCB decryption failed.",LINE_INFO());
+			}
+		}
+
+		TEST_METHOD(XTSTestVectorChecks)
+		{
+			// vectors 1 and 2 of IEEE P1619
+			const byte TestVectorCipher1[32] = {
+				0x91,0x7c,0xf6,0x9e,0xbd,0x68,0xb2,0xec,0x9b,0x9f,0xe9,0xa3,0xea,0xdd,0xa6,0x92,
+				0xcd,0x43,0xd2,0xf5,0x95,0x98,0xed,0x85,0x8c,0x02,0xc2,0x65,0x2f,0xbf,0x92,0x2e
+			};
+			const byte TestVectorCipher2[32] = {
+				0xc4,0x54,0x18,0x5e,0x6a,0x16,0x93,0x6e,0x39,0x33,0x40,0x38,0xac,0xef,0x83,0x8b,
+				0xfb,0x18,0x6f,0xff,0x74,0x80,0xad,0xc4,0x28,0x93,0x82,0xec,0xd6,0xd3,0x94,0xf0
+			};
+			// ciphertext stealing and the SHA-256 of longer ciphertexts, computed with OpenSSL
+			const byte TestVectorCipher3[17] = {
+				0x64,0x16,0x10,0x67,0x9d,0xcb,0xf9,0x2e,0x50,0x5c,0x41,0x33,0x3f,0xb0,0x6c,0x2a,0x95
+			};
+			const byte TestVectorHash128[32] = {
+				0x88,0xaf,0xfa,0x23,0x1d,0x70,0x06,0x30,0x31,0x39,0x4c,0xd4,0x51,0x9e,0x0a,0xa8,
+				0xd0,0x1a,0x3d,0xf3,0xf2,0xf4,0xc0,0x47,0xb1,0x57,0xbb,0x5b,0x58,0x5d,0x0b,0xdd
+			};
+			const byte TestVectorHash256[32] = {
+				0xc4,0xca,0x92,0x43,0xa2,0x4e,0x22,0x29,0x0a,0x2c,0xf0,0xc9,0x9b,0x59,0x8e,0x8c,
+				0xb7,0xb2,0x15,0x44,0xfd,0x9f,0xcc,0x9c,0xe5,0x81,0xc0,0xf8,0xd7,0x02,0xff,0xef
+			};
+			byte Key[64],IV[16],Plaintext[1000],Ciphertext[1000],Recovered[1000],Hash[32];
+
+			memset(Key,0,32);
+			memset(IV,0,16);
+			memset(Plaintext,0,32);
+			XTS_Mode<AES>::Encryption Encryptor(Key,32,IV);
+			Encryptor.ProcessData(Ciphertext,Plaintext,32);
+			Assert::IsTrue(memcmp(Ciphertext,TestVectorCipher1,32)==0,L"AES-128/XTS test one failed.",LINE_INFO());
+
+			memset(Key,0x11,16);
+			memset(Key+16,0x22,16);
+			memset(IV,0x33,5);
+			memset(Plaintext,0x44,32);
+			Encryptor.SetKeyWithIV(Key,32,IV);
+			Encryptor.ProcessData(Ciphertext,Plaintext,32);
+			Assert::IsTrue(memcmp(Ciphertext,TestVectorCipher2,32)==0,L"AES-128/XTS test two failed.",LINE_INFO());
+
+			for(size_t i=0;i<16;++i)
+			{
+				Key[i]=byte(0xff-i);
+				Key[16+i]=byte(0xbf-i);
+			}
+			memset(IV,0,16);
+			IV[0]=0x12; IV[1]=0x34; IV[2]=0x56; IV[3]=0x78; IV[4]=0x9a;
+			for(size_t i=0;i<17;++i)
+				Plaintext[i]=byte(i);
+			Encryptor.SetKeyWithIV(Key,32,IV);
+			Encryptor.ProcessLastBlock(Ciphertext,Plaintext,17);
+			Assert::IsTrue(memcmp(Ciphertext,TestVectorCipher3,17)==0,L"AES-128/XTS stealing test failed.",LINE_INFO());
+			XTS_Mode<AES>::Decryption Decryptor(Key,32,IV);
+			Decryptor.ProcessLastBlock(Recovered,Ciphertext,17);
+			Assert::IsTrue(memcmp(Recovered,Plaintext,17)==0,L"AES-128/XTS stealing decryption failed.",LINE_INFO());
+
+			// long enough for the interleaved AES-NI and VAES paths, 1000 isn't a multiple of the block size
+			for(size_t i=0;i<sizeof(Key);++i)
+				Key[i]=byte(i);
+			for(size_t i=0;i<sizeof(IV);++i)
+				IV[i]=byte(0xa0+i);
+			for(size_t i=0;i<sizeof(Plaintext);++i)
+				Plaintext[i]=byte(i);
+			for(size_t KeyLength=32;KeyLength<=64;KeyLength+=32)
+			{
+				Encryptor.SetKeyWithIV(Key,KeyLength,IV);
+				Encryptor.ProcessData(Ciphertext,Plaintext,976);
+				Encryptor.ProcessLastBlock(Ciphertext+976,Plaintext+976,24);
+				SHA256().CalculateDigest(Hash,Ciphertext,sizeof(Ciphertext));
+				Assert::IsTrue(memcmp(Hash,KeyLength==32 ? TestVectorHash128 : TestVectorHash256,32)==0,L"AES/XTS long message test failed.",LINE_INFO());
+
+				Decryptor.SetKeyWithIV(Key,KeyLength,IV);
+				memcpy(Recovered,Ciphertext,sizeof(Recovered));
+				Decryptor.ProcessData(Recovered,Recovered,976);
+				Decryptor.ProcessLastBlock(Recovered+976,Recovered+976,24);
+				Assert::IsTrue(memcmp(Recovered,Plaintext,sizeof(Recovered))==0,L"AES/XTS long message decryption failed.",LINE_INFO());
+			}
+		}
+
+		TEST_METHOD(XTSSectorChecks)
+		{
+			ThreadPool &Pool = ThreadPool::GetGlobalPool();
+			const unsigned int OldNumberThreads = Pool.GetNumberThreads();
+			const size_t OldThreshold = Pool.GetParallelThreshold();
+			Pool.SetNumberThreads(4);
+			Pool.SetParallelThreshold(0);
+
+			AutoSeededRandomPool RNG;
+			SecByteBlock Key(64),Message(37*4096),Sectors(Message.size()),Single(Message.size());
+			RNG.GenerateBlock(Key,Key.size());
+			RNG.GenerateBlock(Message,Message.size());
+
+			// 520 byte sectors end with a partial block, the sector numbers carry into the second word
+			// after 16 sectors or after three quarters of them, for 16 byte sectors in the second batch of 4096
+			const size_t SectorSizes[] = {16,520,4096};
+			for(size_t j=0;j<sizeof(SectorSizes)/sizeof(SectorSizes[0])*2;++j)
+			{
+				const size_t SectorSize = SectorSizes[j/2], SectorCount = Message.size()/SectorSize;
+				const lword FirstSector = j%2 ? lword(0)-(SectorCount-SectorCount/4) : W64LIT(0xfffffffffffffff0);
+				XTS_Mode<AES>::Encryption Encryptor(Key,64);
+				XTS_Mode<AES>::Decryption Decryptor(Key,64);
+				Encryptor.ProcessSectors(Sectors,Message,SectorSize,SectorCount,FirstSector);
+
+				// the sector number is a 128 bit little endian counter
+				byte IV[16] = {0};
+				PutWord(false,LITTLE_ENDIAN_ORDER,IV,word64(FirstSector));
+				for(size_t i=0;i<SectorCount;++i)
+				{
+					Encryptor.Resynchronize(IV);
+					const size_t Whole = SectorSize%16 ? SectorSize-SectorSize%16-16 : SectorSize;
+					Encryptor.ProcessData(Single+i*SectorSize,Message+i*SectorSize,Whole);
+					if(Whole<SectorSize)
+						Encryptor.ProcessLastBlock(Single+i*SectorSize+Whole,Message+i*SectorSize+Whole,SectorSize-Whole);
+					for(size_t k=0;k<16 && ++IV[k]==0;++k);
+				}
+				Assert::IsTrue(IV[8]==1,L"XTS sector numbers didn't carry.",LINE_INFO());
+				Assert::IsTrue(memcmp(Sectors,Single,SectorSize*SectorCount)==0,L"XTS sector encryption differs.",LINE_INFO());
+
+				Decryptor.ProcessSectors(Sectors,Sectors,SectorSize,SectorCount,FirstSector);
+				Assert::IsTrue(memcmp(Sectors,Message,SectorSize*SectorCount)==0,L"XTS sector decryption failed.",LINE_INFO());
+			}
+
+			Pool.SetNumberThreads(OldNumberThreads);
+			Pool.SetParallelThreshold(OldThreshold);
+		}
+
+		TEST_METHOD(ChaCha20TestVectorChecks)
+		{
+			// the keystream for the all zero key and nonce
+			const byte TestVectorKeystream[64] = {
+				0x76,0xb8,0xe0,0xad,0xa0,0xf1,0x3d,0x90,0x40,0x5d,0x6a,0xe5,0x53,0x86,0xbd,0x28,
+				0xbd,0xd2,0x19,0xb8,0xa0,0x8d,0xed,0x1a,0xa8,0x36,0xef,0xcc,0x8b,0x77,0x0d,0xc7,
+				0xda,0x41,0x59,0x7c,0x51,0x57,0x48,0x8d,0x77,0x24,0xe0,0x3f,0xb8,0xd8,0x4a,0x37,
+				0x6a,0x43,0xb8,0xf4,0x15,0x18,0xa1,0x1c,0xc3,0x87,0xb6,0x69,0xb2,0xee,0x65,0x86
+			};
+			// the sunscreen example of RFC 7539 section 2.4.2, it starts at block 1
+			const byte TestVectorCipher[114] = {
+				0x6e,0x2e,0x35,0x9a,0x25,0x68,0xf9,0x80,0x41,0xba,0x07,0x28,0xdd,0x0d,0x69,0x81,
+				0xe9,0x7e,0x7a,0xec,0x1d,0x43,0x60,0xc2,0x0a,0x27,0xaf,0xcc,0xfd,0x9f,0xae,0x0b,
+				0xf9,0x1b,0x65,0xc5,0x52,0x47,0x33,0xab,0x8f,0x59,0x3d,0xab,0xcd,0x62,0xb3,0x57,
+				0x16,0x39,0xd6,0x24,0xe6,0x51,0x52,0xab,0x8f,0x53,0x0c,0x35,0x9f,0x08,0x61,0xd8,
+				0x07,0xca,0x0d,0xbf,0x50,0x0d,0x6a,0x61,0x56,0xa3,0x8e,0x08,0x8a,0x22,0xb6,0x5e,
+				0x52,0xbc,0x51,0x4d,0x16,0xcc,0xf8,0x06,0x81,0x8c,0xe9,0x1a,0xb7,0x79,0x37,0x36,
+				0x5a,0xf9,0x0b,0xbf,0x74,0xa3,0x5b,0xe6,0xb4,0x0b,0x8e,0xed,0xf2,0x78,0x5e,0x42,
+				0x87,0x4d
+			};
+			const char *Plaintext = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+			const byte Nonce[12] = {0,0,0,0,0,0,0,0x4a,0,0,0,0};
+			byte Key[32],Output[114];
+
+			memset(Key,0,sizeof(Key));
+			memset(Output,0,sizeof(Output));
+			ChaCha20::Encryption Original(Key,32,Key);
+			Original.ProcessString(Output,64);
+			Assert::IsTrue(memcmp(Output,TestVectorKeystream,64)==0,L"ChaCha20 keystream test failed.",LINE_INFO());
+
+			for(size_t i=0;i<sizeof(Key);++i)
+				Key[i]=byte(i);
+			ChaCha20IETF::Encryption IETF(Key,32,Nonce);
+			IETF.Seek(64);
+			IETF.ProcessData(Output,(const byte *)Plaintext,114);
+			Assert::IsTrue(memcmp(Output,TestVectorCipher,114)==0,L"ChaCha20IETF test failed.",LINE_INFO());
+
+			// the last block the 32-bit counter can reach works, the one after it throws
+			IETF.Seek(W64LIT(0xffffffff)*64);
+			IETF.ProcessString(Output,64);
+			bool Threw=false;
+			try
+			{
+				IETF.ProcessString(Output,1);
+			}
+			catch(const InvalidArgument&)
+			{
+				Threw=true;
+			}
+			Assert::IsTrue(Threw,L"ChaCha20IETF counter wrapped into the nonce.",LINE_INFO());
+
+			// the multi-block keystream in one call against small pieces and seeks, the counter carries into word 13
+			AutoSeededRandomPool RNG;
+			SecByteBlock Message(5000),Whole(5000),Pieces(5000);
+			RNG.GenerateBlock(Message,Message.size());
+			for(unsigned int i=0;i<32;++i)
+			{
+				const size_t Length=RNG.GenerateWord32(0,(word32)Message.size());
+				const size_t KeyLength=(i&1) ? 32 : 16;
+				const int Rounds=(i%3==0) ? 8 : (i%3==1) ? 12 : 20;
+				const lword Start=(i&2) ? W64LIT(0xfffffff0)*64 : 0;
+				byte IV[8];
+				RNG.GenerateBlock(Key,KeyLength);
+				RNG.GenerateBlock(IV,sizeof(IV));
+
+				ChaCha20::Encryption Encryptor1,Encryptor2;
+				Encryptor1.SetKey(Key,KeyLength,MakeParameters(Name::IV(),ConstByteArrayParameter(IV,sizeof(IV)))(Name::Rounds(),Rounds));
+				Encryptor2.SetKey(Key,KeyLength,MakeParameters(Name::IV(),ConstByteArrayParameter(IV,sizeof(IV)))(Name::Rounds(),Rounds));
+				Encryptor1.Seek(Start);
+				Encryptor2.Seek(Start);
+				Encryptor2.ProcessData(Whole,Message,Length);
+				for(size_t Done=0;Done<Length;)
+				{
+					size_t Piece=RNG.GenerateWord32(1,100);
+					if(Piece>=Length-Done)
+						Piece=Length-Done;
+					Encryptor1.ProcessData(Pieces+Done,Message+Done,Piece);
+					Done+=Piece;
+				}
+				Assert::IsTrue(memcmp(Pieces,Whole,Length)==0,L"ChaCha20 encryption in pieces differs.",LINE_INFO());
+
+				const size_t Offset=RNG.GenerateWord32(0,(word32)Length);
+				Encryptor1.Seek(Start+Offset);
+				Encryptor1.ProcessData(Pieces,Whole+Offset,Length-Offset);
+				Assert::IsTrue(memcmp(Pieces,Message+Offset,Length-Offset)==0,L"ChaCha20 decryption after a seek failed.",LINE_INFO());
+			}
+		}
+		TEST_METHOD(ChaCha20Poly1305TestVectorChecks)
+		{
+			// the Poly1305 example of RFC 7539 section 2.5.2
+			const byte TestVectorMACKey[32] = {
+				0x85,0xd6,0xbe,0x78,0x57,0x55,0x6d,0x33,0x7f,0x44,0x52,0xfe,0x42,0xd5,0x06,0xa8,
+				0x01,0x03,0x80,0x8a,0xfb,0x0d,0xb2,0xfd,0x4a,0xbf,0xf6,0xaf,0x41,0x49,0xf5,0x1b
+			};
+			const byte TestVectorMAC[16] = {
+				0xa8,0x06,0x1d,0xc1,0x30,0x51,0x36,0xc6,0xc2,0x2b,0x8b,0xaf,0x0c,0x01,0x27,0xa9
+			};
+			// the AEAD example of RFC 7539 section 2.8.2
+			const byte TestVectorCipher[114+16] = {
+				0xd3,0x1a,0x8d,0x34,0x64,0x8e,0x60,0xdb,0x7b,0x86,0xaf,0xbc,0x53,0xef,0x7e,0xc2,
+				0xa4,0xad,0xed,0x51,0x29,0x6e,0x08,0xfe,0xa9,0xe2,0xb5,0xa7,0x36,0xee,0x62,0xd6,
+				0x3d,0xbe,0xa4,0x5e,0x8c,0xa9,0x67,0x12,0x82,0xfa,0xfb,0x69,0xda,0x92,0x72,0x8b,
+				0x1a,0x71,0xde,0x0a,0x9e,0x06,0x0b,0x29,0x05,0xd6,0xa5,0xb6,0x7e,0xcd,0x3b,0x36,
+				0x92,0xdd,0xbd,0x7f,0x2d,0x77,0x8b,0x8c,0x98,0x03,0xae,0xe3,0x28,0x09,0x1b,0x58,
+				0xfa,0xb3,0x24,0xe4,0xfa,0xd6,0x75,0x94,0x55,0x85,0x80,0x8b,0x48,0x31,0xd7,0xbc,
+				0x3f,0xf4,0xde,0xf0,0x8e,0x4b,0x7a,0x9d,0xe5,0x76,0xd2,0x65,0x86,0xce,0xc6,0x4b,
+				0x61,0x16,
+				0x1a,0xe1,0x0b,0x59,0x4f,0x09,0xe2,0x6a,0x7e,0x90,0x2e,0xcb,0xd0,0x60,0x06,0x91
+			};
+			const char *Message = "Cryptographic Forum Research Group";
+			const char *Plaintext = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+			const byte Nonce[12] = {0x07,0x00,0x00,0x00,0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47};
+			const byte Header[12] = {0x50,0x51,0x52,0x53,0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7};
+			byte Key[32],MAC[16],Ciphertext[114+16],Recovered[114];
+
+			Poly1305 Authenticator(TestVectorMACKey);
+			Authenticator.CalculateDigest(MAC,(const byte *)Message,strlen(Message));
+			Assert::IsTrue(memcmp(MAC,TestVectorMAC,16)==0,L"Poly1305 test failed.",LINE_INFO());
+
+			for(size_t i=0;i<sizeof(Key);++i)
+				Key[i]=byte(0x80+i);
+			ChaCha20Poly1305::Encryption Encryptor;
+			Encryptor.SetKeyWithIV(Key,32,Nonce,sizeof(Nonce));
+			Encryptor.EncryptAndAuthenticate(Ciphertext,Ciphertext+114,16,Nonce,sizeof(Nonce),Header,sizeof(Header),(const byte *)Plaintext,114);
+			Assert::IsTrue(memcmp(Ciphertext,TestVectorCipher,sizeof(Ciphertext))==0,L"ChaCha20/Poly1305 test failed.",LINE_INFO());
+			ChaCha20Poly1305::Decryption Decryptor;
+			Decryptor.SetKeyWithIV(Key,32,Nonce,sizeof(Nonce));
+			Assert::IsTrue(Decryptor.DecryptAndVerify(Recovered,Ciphertext+114,16,Nonce,sizeof(Nonce),Header,sizeof(Header),Ciphertext,114) && memcmp(Recovered,Plaintext,114)==0,L"ChaCha20/Poly1305 decryption failed.",LINE_INFO());
+			Ciphertext[50]^=1;
+			Assert::IsTrue(!Decryptor.DecryptAndVerify(Recovered,Ciphertext+114,16,Nonce,sizeof(Nonce),Header,sizeof(Header),Ciphertext,114),L"ChaCha20/Poly1305 accepted a modified ciphertext.",LINE_INFO());
+
+			// the multi-block Poly1305 path must agree with feeding the message in small pieces
+			AutoSeededRandomPool RNG;
+			SecByteBlock Data(3000);
+			RNG.GenerateBlock(Data,Data.size());
+			RNG.GenerateBlock(Key,sizeof(Key));
+			for(unsigned int i=0;i<16;++i)
+			{
+				const size_t Length=RNG.GenerateWord32(0,(word32)Data.size());
+				byte Whole[16],Pieces[16];
+				Poly1305 MAC1(Key),MAC2(Key);
+				MAC1.CalculateDigest(Whole,Data,Length);
+				for(size_t Done=0;Done<Length;)
+				{
+					size_t Piece=RNG.GenerateWord32(1,50);
+					if(Piece>=Length-Done)
+						Piece=Length-Done;
+					MAC2.Update(Data+Done,Piece);
+					Done+=Piece;
+				}
+				MAC2.Final(Pieces);
+				Assert::IsTrue(memcmp(Pieces,Whole,16)==0,L"Poly1305 in pieces differs.",LINE_INFO());
+			}
+
+			std::string Encrypted,Decrypted;
+			Encryptor.Resynchronize(Nonce,sizeof(Nonce));
+			Decryptor.Resynchronize(Nonce,sizeof(Nonce));
+			StringSource(Plaintext,true,new AuthenticatedEncryptionFilter(Encryptor,new StringSink(Encrypted)));
+			Assert::IsTrue(Encrypted.size()==sizeof(TestVectorCipher) && memcmp(Encrypted.data(),TestVectorCipher,114)==0,L"ChaCha20/Poly1305 filter encryption failed.",LINE_INFO());
+			StringSource(Encrypted,true,new AuthenticatedDecryptionFilter(Decryptor,new StringSink(Decrypted)));
+			Assert::IsTrue(Decrypted==Plaintext,L"ChaCha20/Poly1305 filter decryption failed.",LINE_INFO());
+		}
 	};
 }
\ No newline at end of file
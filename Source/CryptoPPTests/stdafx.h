@@ -7,6 +7,9 @@
 
 #include <memory>
 #include <future>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 #include "targetver.h"
 
@@ -29,15 +32,25 @@
 #include "..\CryptoPP\skipjack.h"
 #include "..\CryptoPP\shacal2.h"
 #include "..\CryptoPP\osrng.h"
+#include "..\CryptoPP\Fortuna.h"
 #include "..\CryptoPP\rsa.h"
+#include "..\CryptoPP\pssr.h"
 #include "..\CryptoPP\sha.h"
 #include "..\CryptoPP\oids.h"
 #include "..\CryptoPP\eccrypto.h"
+#include "..\CryptoPP\ecpcomb.h"
+#include "..\CryptoPP\xed25519.h"
 #include "..\CryptoPP\threefish.h"
 #include "..\CryptoPP\skein.h"
 #include "..\CryptoPP\scrypt.h"
 #include "..\CryptoPP\vmac.h"
 #include "..\CryptoPP\blake2b.h"
 #include "..\CryptoPP\blake2s.h"
+#include "..\CryptoPP\threadpool.h"
+#include "..\CryptoPP\gcm.h"
+#include "..\CryptoPP\ocb.h"
+#include "..\CryptoPP\chacha.h"
+#include "..\CryptoPP\chachapoly.h"
+#include "..\CryptoPP\cpu.h"
 
 // TODO: Hier auf zustzliche Header, die das Programm erfordert, verweisen.